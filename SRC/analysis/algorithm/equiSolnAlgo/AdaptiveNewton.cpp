@@ -0,0 +1,214 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Implementation of AdaptiveNewton.
+//
+// Written: cmp
+//
+#include <AdaptiveNewton.h>
+#include <AnalysisModel.h>
+#include <IncrementalIntegrator.h>
+#include <LinearSOE.h>
+#include <ConvergenceTest.h>
+#include <Domain.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Channel.h>
+#include <Logging.h>
+#include <Profiler.h>
+#include <math.h>
+
+
+AdaptiveNewton::AdaptiveNewton(double rate, int stepIter)
+:EquiSolnAlgo(EquiALGORITHM_TAGS_AdaptiveNewton),
+ maxRate(rate), maxStepIter(stepIter),
+ haveTangent(false), domainStamp(-1), lastDt(0.0),
+ lastIntegrator(nullptr), lastSOE(nullptr), lastStepIter(0),
+ numIterations(0), numFactorizations(0), numSteps(0)
+{
+
+}
+
+AdaptiveNewton::~AdaptiveNewton()
+{
+
+}
+
+
+int
+AdaptiveNewton::formTangent(IncrementalIntegrator &theIntegrator)
+{
+  // forming the tangent zeroes A, so the SOE factors it on the next solve
+  Profiler::Scope scope("formTangent");
+  if (theIntegrator.formTangent(CURRENT_TANGENT) < 0) {
+    opserr << "WARNING AdaptiveNewton::solveCurrentStep() - ";
+    opserr << "the Integrator failed in formTangent()\n";
+    haveTangent = false;
+    return -1;
+  }
+  haveTangent = true;
+  numFactorizations++;
+  return 0;
+}
+
+
+int
+AdaptiveNewton::solveCurrentStep(void)
+{
+  AnalysisModel *theAnaModel = this->getAnalysisModelPtr();
+  IncrementalIntegrator *theIntegrator = this->getIncrementalIntegratorPtr();
+  LinearSOE *theSOE = this->getLinearSOEptr();
+  ConvergenceTest *theTest = this->getConvergenceTest();
+
+  if ((theAnaModel == nullptr) || (theIntegrator == nullptr) || (theSOE == nullptr)
+      || (theTest == nullptr)) {
+    opserr << "WARNING AdaptiveNewton::solveCurrentStep() - setLinks() has";
+    opserr << " not been called - or no ConvergenceTest has been set\n";
+    return -5;
+  }
+
+  if (theIntegrator->formUnbalance() < 0) {
+    opserr << "WARNING AdaptiveNewton::solveCurrentStep() - ";
+    opserr << "the Integrator failed in formUnbalance()\n";
+    return -2;
+  }
+
+  // A tangent kept from an earlier step is only valid for the same
+  // system of equations, integrator and time step, and is not worth
+  // keeping if that step was slow
+  Domain *theDomain = theAnaModel->getDomainPtr();
+  const int stamp = theDomain != nullptr ? theDomain->hasDomainChanged() : domainStamp;
+  if (stamp != domainStamp) {
+    domainStamp = stamp;
+    haveTangent = false;
+  }
+  if (theIntegrator != lastIntegrator || theSOE != lastSOE) {
+    lastIntegrator = theIntegrator;
+    lastSOE = theSOE;
+    haveTangent = false;
+  }
+  if (theDomain != nullptr) {
+    // the factors of the dynamic terms of the tangent depend on dt
+    const double dt = theDomain->getCurrentTime() - theDomain->getCommittedTime();
+    if (fabs(dt - lastDt) > 1.0e-12*fabs(lastDt))
+      haveTangent = false;
+    lastDt = dt;
+  }
+  if (lastStepIter > maxStepIter)
+    haveTangent = false;
+
+  if (!haveTangent && this->formTangent(*theIntegrator) < 0)
+    return -1;
+
+  theTest->setEquiSolnAlgo(*this);
+  if (theTest->start() < 0) {
+    opserr << "AdaptiveNewton::solveCurrentStep() - ";
+    opserr << "the ConvergenceTest object failed in start()\n";
+    return -3;
+  }
+
+  double lastNorm = theSOE->getB().Norm();
+
+  int result = -1;
+  numIterations = 0;
+  do {
+    if (theSOE->solve() < 0) {
+      opserr << "WARNING AdaptiveNewton::solveCurrentStep() - ";
+      opserr << "the LinearSysOfEqn failed in solve()\n";
+      haveTangent = false;
+      return -3;
+    }
+
+    // after a failed update the state the tangent was formed at is
+    // reverted, so the next attempt starts from a new tangent
+    int status;
+    {
+      Profiler::Scope scope("update");
+      status = theIntegrator->update(theSOE->getX());
+    }
+    if (status < 0) {
+      opserr << "WARNING AdaptiveNewton::solveCurrentStep() - ";
+      opserr << "the Integrator failed in update()\n";
+      haveTangent = false;
+      return -4;
+    }
+
+    {
+      Profiler::Scope scope("formUnbalance");
+      status = theIntegrator->formUnbalance();
+    }
+    if (status < 0) {
+      opserr << "WARNING AdaptiveNewton::solveCurrentStep() - ";
+      opserr << "the Integrator failed in formUnbalance()\n";
+      haveTangent = false;
+      return -2;
+    }
+
+    this->record(numIterations);
+
+    {
+      Profiler::Scope scope("test");
+      result = theTest->test();
+    }
+    numIterations++;
+
+    if (result == -1) {
+      // refactor when the current tangent no longer contracts fast enough
+      const double norm = theSOE->getB().Norm();
+      if (lastNorm > 0.0 && norm > maxRate*lastNorm)
+        if (this->formTangent(*theIntegrator) < 0)
+          return -1;
+      lastNorm = norm;
+    }
+
+  } while (result == -1);
+
+  lastStepIter = numIterations;
+  numSteps++;
+
+  if (result == -2) {
+    opserr << "AdaptiveNewton::solveCurrentStep() - ";
+    opserr << "the ConvergenceTest object failed in test()\n";
+    // start the next attempt from a current tangent
+    haveTangent = false;
+    return -3;
+  }
+
+  return result;
+}
+
+
+int
+AdaptiveNewton::sendSelf(int cTag, Channel &theChannel)
+{
+  static Vector data(2);
+  data(0) = maxRate;
+  data(1) = maxStepIter;
+  return theChannel.sendVector(this->getDbTag(), cTag, data);
+}
+
+int
+AdaptiveNewton::recvSelf(int cTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
+{
+  static Vector data(2);
+  if (theChannel.recvVector(this->getDbTag(), cTag, data) < 0)
+    return -1;
+
+  maxRate     = data(0);
+  maxStepIter = (int)data(1);
+  haveTangent = false;
+  return 0;
+}
+
+
+void
+AdaptiveNewton::Print(OPS_Stream &s, int flag)
+{
+  s << "AdaptiveNewton\n";
+  s << "\tmaximum contraction rate: " << maxRate << "\n";
+  s << "\tmaximum iterations before a new step tangent: " << maxStepIter << "\n";
+  s << "\tsteps: " << numSteps << ", factorizations: " << numFactorizations << "\n";
+}
@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: AdaptiveNewton is a modified Newton algorithm that keeps
+// the factored tangent across iterations and across steps for as long
+// as it continues to reduce the unbalance quickly. After every iteration
+// the contraction rate |R_k|/|R_{k-1}| is measured; when it exceeds
+// maxRate the tangent is formed (and factored) again. A new tangent is
+// also formed at the start of a step when the domain, the integrator,
+// the system of equations or the time increment has changed, when the
+// previous step needed more than maxStepIter iterations, and after a
+// failed update.
+//
+// With maxRate = 0 it behaves as Newton-Raphson; with a large maxRate it
+// behaves as ModifiedNewton with the tangent kept across steps.
+//
+// Written: cmp
+//
+#ifndef AdaptiveNewton_h
+#define AdaptiveNewton_h
+
+#include <EquiSolnAlgo.h>
+class IncrementalIntegrator;
+class LinearSOE;
+
+#ifndef EquiALGORITHM_TAGS_AdaptiveNewton
+#define EquiALGORITHM_TAGS_AdaptiveNewton 1001
+#endif
+
+class AdaptiveNewton: public EquiSolnAlgo
+{
+  public:
+    AdaptiveNewton(double maxRate = 0.5, int maxStepIter = 4);
+    ~AdaptiveNewton();
+
+    int solveCurrentStep(void);
+
+    int getNumFactorizations(void) {return numFactorizations;}
+    int getNumIterations(void)     {return numIterations;}
+
+    virtual int sendSelf(int commitTag, Channel &theChannel);
+    virtual int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
+    void Print(OPS_Stream &s, int flag =0);
+
+  private:
+    int formTangent(IncrementalIntegrator &theIntegrator);
+
+    double maxRate;         // largest contraction rate for which the tangent is kept
+    int    maxStepIter;     // form a new tangent after a step that took longer
+
+    bool   haveTangent;     // the SOE holds a factorable tangent
+    int    domainStamp;
+    double lastDt;          // time increment the tangent was formed for
+    IncrementalIntegrator *lastIntegrator;
+    LinearSOE *lastSOE;
+    int    lastStepIter;
+
+    int    numIterations;        // in the last step
+    int    numFactorizations;    // since construction
+    int    numSteps;
+};
+
+#endif
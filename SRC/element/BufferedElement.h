@@ -0,0 +1,41 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: BufferedElement is implemented by elements that can write
+// their tangent, resisting force and mass into storage owned by the
+// caller. The Element accessors return references to storage kept by the
+// class, so two elements of the same class cannot be evaluated at once
+// through them; with these methods and one set of buffers per thread
+// they can, provided the element state and materials allow it, which
+// isReentrant reports.
+//
+// The buffers must be sized to the number of element DOFs. The legacy
+// accessors of an element that implements this interface call it with
+// buffers of their own.
+//
+// Written: cmp
+//
+#ifndef BufferedElement_h
+#define BufferedElement_h
+
+class Matrix;
+class Vector;
+
+class BufferedElement
+{
+  public:
+    virtual ~BufferedElement() {}
+
+    virtual int formTangentStiff(Matrix &K) = 0;
+    virtual int formResistingForce(Vector &P) = 0;
+    virtual int formMass(Matrix &M) = 0;
+
+    // true if the materials of the element may be updated concurrently
+    // with those of other elements
+    virtual bool isReentrant(void) const = 0;
+};
+
+#endif
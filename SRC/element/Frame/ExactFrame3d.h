@@ -11,6 +11,8 @@
 #include <array>
 #include <Flag.h>
 #include <Element.h>
+#include <TangentProduct.h>
+#include <BufferedElement.h>
 #include <VectorND.h>
 #include <MatrixND.h>
 
@@ -24,7 +26,9 @@ namespace OpenSees {
 
 template<std::size_t nen, int nwm=0>
 class ExactFrame3d: 
-  public FiniteElement<nen, 3, 6+nwm>
+  public FiniteElement<nen, 3, 6+nwm>,
+  public TangentProduct,
+  public BufferedElement
 {
 public:
   enum Logarithm {
@@ -52,6 +56,11 @@ public:
   virtual const Matrix &getTangentStiff();
   virtual const Matrix &getMass();
   virtual const Matrix &getInitialStiff();
+  int formResistingForce(Vector &P) final;
+  int formTangentStiff(Matrix &K) final;
+  int formMass(Matrix &M) final;
+  bool isReentrant() const final;
+  int addTangentProduct(const double *x, double *y, double cK, double cM) final;
 
   virtual int update() final;
   virtual int addLoad(ElementalLoad* , double scale) override final;
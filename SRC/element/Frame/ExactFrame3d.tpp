@@ -35,6 +35,7 @@
 // Claudio M. Perez
 //
 #include <cstddef>
+#include <cassert>
 #include <ExactFrame3d.h>
 #include <Flag.h>
 #include <Node.h>
@@ -435,6 +436,67 @@ ExactFrame3d<nen,nwm>::getTangentStiff()
   return wrapper;
 }
 
+//
+// The state is formed by update(), so these copy it into the buffers
+// given; the accessors above return views of it instead.
+//
+template<std::size_t nen, int nwm>
+int
+ExactFrame3d<nen,nwm>::formResistingForce(Vector &P)
+{
+  assert(P.Size() == nen*ndf);
+  for (int i=0; i<nen*ndf; i++)
+    P(i) = p[i];
+  return 0;
+}
+
+template<std::size_t nen, int nwm>
+int
+ExactFrame3d<nen,nwm>::formTangentStiff(Matrix &Kt)
+{
+  assert(Kt.noRows() == nen*ndf && Kt.noCols() == nen*ndf);
+  for (int j=0; j<nen*ndf; j++)
+    for (int i=0; i<nen*ndf; i++)
+      Kt(i,j) = K(i,j);
+  return 0;
+}
+
+template<std::size_t nen, int nwm>
+int
+ExactFrame3d<nen,nwm>::formMass(Matrix &M)
+{
+  // TODO: see getMass
+  M.Zero();
+  return 0;
+}
+
+template<std::size_t nen, int nwm>
+bool
+ExactFrame3d<nen,nwm>::isReentrant() const
+{
+  for (const GaussPoint& point : pres)
+    if (point.material == nullptr || !point.material->isReentrant())
+      return false;
+  return true;
+}
+
+template<std::size_t nen, int nwm>
+int
+ExactFrame3d<nen,nwm>::addTangentProduct(const double *x, double *y, double cK, double cM)
+{
+  // K is formed by update(); the mass is not implemented (see getMass)
+  if (cK == 0.0)
+    return 0;
+
+  for (int i=0; i<nen*ndf; i++) {
+    double yi = 0.0;
+    for (int j=0; j<nen*ndf; j++)
+      yi += K(i,j)*x[j];
+    y[i] += cK*yi;
+  }
+  return 0;
+}
+
 template<std::size_t nen, int nwm>
 const Matrix &
 ExactFrame3d<nen,nwm>::getInitialStiff()
@@ -12,8 +12,11 @@
 #define LagrangeQuad_h
 
 #include <array>
+#include <memory>
 #include <Mate.h>
 #include <Element.h>
+#include <TangentProduct.h>
+#include <BufferedElement.h>
 #include <Matrix.h>
 #include <Vector.h>
 #include <ID.h>
@@ -27,7 +30,8 @@ class Response;
 namespace OpenSees {
 
 template<int NEN, bool enhanced=false>
-class LagrangeQuad : public Element, protected GaussLegendre<2, 4> {
+class LagrangeQuad : public Element, public TangentProduct, public BufferedElement,
+                     protected GaussLegendre<2, 4> {
 public:
   LagrangeQuad(int tag, const std::array<int, NEN>& nodes, 
                Mate<2>& m,  
@@ -53,6 +57,11 @@ public:
   int getNumDOF();
   void setDomain(Domain* theDomain);
 
+  // Keep the shape functions and Jacobian of each integration point,
+  // formed at setDomain, instead of recomputing them at every call.
+  // They are formed again at update if the nodes have moved since.
+  void setGeometryCache(bool cache);
+
   // public methods to set the state of the element
   int commitState();
   int revertToLastCommit();
@@ -63,6 +72,10 @@ public:
   const Matrix& getTangentStiff();
   const Matrix& getInitialStiff();
   const Matrix& getMass();
+  int formTangentStiff(Matrix& K);
+  int formMass(Matrix& M);
+  bool isReentrant() const;
+  int addTangentProduct(const double* x, double* y, double cK, double cM);
 
   void zeroLoad();
   int addLoad(ElementalLoad* theLoad, double loadFactor);
@@ -70,6 +83,7 @@ public:
 
   const Vector& getResistingForce();
   const Vector& getResistingForceIncInertia();
+  int formResistingForce(Vector& P);
 
   // Public methods for element output
 
@@ -104,6 +118,9 @@ private:
   // private member functions
   // - only objects of this class can call these
   double shapeFunction(double xi, double eta);
+  double shapeFunction(int ip);  // from the cache, if any
+  void formGeometry();
+  bool hasGeometryMoved() const;
   void setPressureLoadAtNodes();
 
   //
@@ -133,6 +150,17 @@ private:
   double rho;
   double shp[3][NEN]; // shape functions and derivatives
 
+  struct PointGeometry {
+    double shp[3][NEN];
+    double detJ;
+  };
+  struct Geometry {
+    double crds[NEN][NDM]; // nodal coordinates the points were formed from
+    std::array<PointGeometry, NIP> points;
+  };
+  std::unique_ptr<Geometry> geometry;
+  bool cacheGeometry;
+
   int parameterID;
 };
 } // namespace OpenSees
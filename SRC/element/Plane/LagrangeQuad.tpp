@@ -49,7 +49,8 @@ LagrangeQuad<NEN,enh>::LagrangeQuad(int tag,
    applyLoad(0),
    pressure(p),
    rho(r),
-   Ki(0)
+   Ki(0),
+   cacheGeometry(false)
 {
 
   // Body forces
@@ -85,7 +86,8 @@ LagrangeQuad<NEN,enh>::LagrangeQuad()
    thickness(0.0),
    applyLoad(0),
    pressure(0.0),
-   Ki(nullptr)
+   Ki(nullptr),
+   cacheGeometry(false)
 {
   for (int i = 0; i < NEN; i++)
     theNodes[i] = nullptr;
@@ -146,6 +148,9 @@ template <int NEN, bool enh>
 void
 LagrangeQuad<NEN,enh>::setDomain(Domain* theDomain)
 {
+  // The cached geometry belongs to the previous nodes
+  geometry.reset();
+
   // Check Domain is not null. This happens when element is removed from a domain.
   // In this case just set null pointers to null and return.
   if (theDomain == nullptr) {
@@ -173,6 +178,61 @@ LagrangeQuad<NEN,enh>::setDomain(Domain* theDomain)
 
   // Compute consistent nodal loads due to pressure
   this->setPressureLoadAtNodes();
+
+  if (cacheGeometry)
+    this->formGeometry();
+}
+
+
+template <int NEN, bool enh>
+void
+LagrangeQuad<NEN,enh>::setGeometryCache(bool cache)
+{
+  cacheGeometry = cache;
+
+  if (!cache)
+    geometry.reset();
+  else if (this->getDomain() != nullptr)
+    this->formGeometry();
+}
+
+
+template <int NEN, bool enh>
+void
+LagrangeQuad<NEN,enh>::formGeometry()
+{
+  if (geometry == nullptr)
+    geometry.reset(new Geometry);
+
+  for (int a = 0; a < NEN; a++) {
+    const Vector& crds = theNodes[a]->getCrds();
+    for (int j = 0; j < NDM; j++)
+      geometry->crds[a][j] = crds(j);
+  }
+
+  for (int i = 0; i < nip; i++) {
+    PointGeometry& point = geometry->points[i];
+    point.detJ = this->shapeFunction(pts[i][0], pts[i][1]);
+    memcpy(point.shp, shp, sizeof(shp));
+  }
+}
+
+
+//
+// True if a node has been moved (e.g., by setNodeCoord or an updated
+// Lagrangian step) since the cached geometry was formed
+//
+template <int NEN, bool enh>
+bool
+LagrangeQuad<NEN,enh>::hasGeometryMoved() const
+{
+  for (int a = 0; a < NEN; a++) {
+    const Vector& crds = theNodes[a]->getCrds();
+    for (int j = 0; j < NDM; j++)
+      if (crds(j) != geometry->crds[a][j])
+        return true;
+  }
+  return false;
 }
 
 
@@ -226,6 +286,9 @@ template <int NEN, bool enh>
 int
 LagrangeQuad<NEN,enh>::update()
 {
+  if (geometry != nullptr && this->hasGeometryMoved())
+    this->formGeometry();
+
   // Collect displacements at each node into a local array
   double u[NDM][NEN];
 
@@ -241,7 +304,7 @@ LagrangeQuad<NEN,enh>::update()
   // Loop over the integration points
   for (int i = 0; i < nip; i++) {
     // Determine Jacobian for this integration point
-    this->shapeFunction(pts[i][0], pts[i][1]);
+    this->shapeFunction(i);
 
     // Interpolate strains
     //   eps = B*u;
@@ -265,8 +328,18 @@ template <int NEN, bool enh>
 const Matrix&
 LagrangeQuad<NEN,enh>::getTangentStiff()
 {
-  static MatrixND<NDF*NEN,NEN*NDF> K;
-  K.zero();
+  thread_local Matrix K(NEN*NDF, NEN*NDF);
+  this->formTangentStiff(K);
+  return K;
+}
+
+
+template <int NEN, bool enh>
+int
+LagrangeQuad<NEN,enh>::formTangentStiff(Matrix& K)
+{
+  assert(K.noRows() == NEN*NDF && K.noCols() == NEN*NDF);
+  K.Zero();
 
   double DB[3][2];
 
@@ -274,7 +347,7 @@ LagrangeQuad<NEN,enh>::getTangentStiff()
   for (int i = 0; i < nip; i++) {
 
     // Determine Jacobian for this integration point
-    double dvol = this->shapeFunction(pts[i][0], pts[i][1]);
+    double dvol = this->shapeFunction(i);
     dvol *= (thickness * wts[i]);
 
     // Get the material tangent
@@ -310,8 +383,7 @@ LagrangeQuad<NEN,enh>::getTangentStiff()
     }
   }
 
-  static Matrix Wrapper(K);
-  return Wrapper;
+  return 0;
 }
 
 
@@ -333,7 +405,7 @@ LagrangeQuad<NEN,enh>::getInitialStiff()
 
     // Determine Jacobian for this integration point
     double dvol;
-    dvol = this->shapeFunction(pts[i][0], pts[i][1]);
+    dvol = this->shapeFunction(i);
     dvol *= (thickness * wts[i]);
 
     // Get the material tangent
@@ -370,10 +442,31 @@ template <int NEN, bool enh>
 const Matrix&
 LagrangeQuad<NEN,enh>::getMass()
 {
-  static MatrixND<NEN*NDF, NEN*NDF> M;
-  M.zero();
+  thread_local Matrix M(NEN*NDF, NEN*NDF);
+  this->formMass(M);
+  return M;
+}
+
 
-  static double rhoi[4];
+template <int NEN, bool enh>
+bool
+LagrangeQuad<NEN,enh>::isReentrant() const
+{
+  for (int i = 0; i < NIP; i++)
+    if (theMaterial[i] == nullptr || !theMaterial[i]->isReentrant())
+      return false;
+  return true;
+}
+
+
+template <int NEN, bool enh>
+int
+LagrangeQuad<NEN,enh>::formMass(Matrix& M)
+{
+  assert(M.noRows() == NEN*NDF && M.noCols() == NEN*NDF);
+  M.Zero();
+
+  double rhoi[nip];
   double sum = 0.0;
   for (int i = 0; i < nip; i++) {
     if (rho == 0)
@@ -384,12 +477,12 @@ LagrangeQuad<NEN,enh>::getMass()
   }
 
   if (sum == 0.0)
-    return M;
+    return 0;
 
   // Compute a lumped mass matrix
   for (int i = 0; i < nip; i++) {
     // Determine Jacobian for this integration point
-    double rhodvol = this->shapeFunction(pts[i][0], pts[i][1]);
+    double rhodvol = this->shapeFunction(i);
 
     // Element plus material density ... MAY WANT TO REMOVE ELEMENT DENSITY
     rhodvol *= (rhoi[i] * thickness * wts[i]);
@@ -402,8 +495,55 @@ LagrangeQuad<NEN,enh>::getMass()
     }
   }
 
-  static Matrix Wrapper(M);
-  return Wrapper;
+  return 0;
+}
+
+
+template <int NEN, bool enh>
+int
+LagrangeQuad<NEN,enh>::addTangentProduct(const double* x, double* y, double cK, double cM)
+{
+  // Loop over the integration points
+  for (int i = 0; i < nip; i++) {
+
+    // Determine Jacobian for this integration point
+    double dvol = this->shapeFunction(i);
+    dvol *= (thickness * wts[i]);
+
+    // y += B^ D B x * dvol, without forming B^ D B
+    if (cK != 0.0) {
+      double e[3] = {0.0, 0.0, 0.0};
+      for (int alpha = 0, ia = 0; alpha < NEN; alpha++, ia += 2) {
+        e[0] += shp[0][alpha] * x[ia];
+        e[1] += shp[1][alpha] * x[ia + 1];
+        e[2] += shp[1][alpha] * x[ia] + shp[0][alpha] * x[ia + 1];
+      }
+
+      const MatrixSD<3> D = theMaterial[i]->getTangent();
+      double s[3];
+      for (int k = 0; k < 3; k++)
+        s[k] = cK * dvol * (D(k,0) * e[0] + D(k,1) * e[1] + D(k,2) * e[2]);
+
+      for (int alpha = 0, ia = 0; alpha < NEN; alpha++, ia += 2) {
+        y[ia]     += shp[0][alpha] * s[0] + shp[1][alpha] * s[2];
+        y[ia + 1] += shp[1][alpha] * s[1] + shp[0][alpha] * s[2];
+      }
+    }
+
+    // Lumped mass, as in getMass
+    if (cM != 0.0) {
+      double rhoi = (rho == 0) ? theMaterial[i]->getDensity() : rho;
+      if (rhoi == 0.0)
+        continue;
+      for (int alpha = 0, ia = 0; alpha < NEN; alpha++, ia += 2) {
+        double Nrho = cM * shp[2][alpha] * rhoi * dvol;
+        y[ia]     += Nrho * x[ia];
+        y[ia + 1] += Nrho * x[ia + 1];
+      }
+    }
+  }
+
+  return 0;
 }
 
 
@@ -483,15 +623,25 @@ template <int NEN, bool enh>
 const Vector&
 LagrangeQuad<NEN,enh>::getResistingForce()
 {
-  thread_local VectorND<NEN*NDF> P;
-  P.zero();
+  thread_local Vector P(NEN*NDF);
+  this->formResistingForce(P);
+  return P;
+}
+
+
+template <int NEN, bool enh>
+int
+LagrangeQuad<NEN,enh>::formResistingForce(Vector& P)
+{
+  assert(P.Size() == NEN*NDF);
+  P.Zero();
 
 
   // Loop over the integration points
   for (int i = 0; i < nip; i++) {
     // Determine Jacobian for this integration point
     double dvol;
-    dvol = this->shapeFunction(pts[i][0], pts[i][1]);
+    dvol = this->shapeFunction(i);
     dvol *= (thickness * wts[i]);
 
     // Get material stress response
@@ -525,17 +675,17 @@ LagrangeQuad<NEN,enh>::getResistingForce()
 
   // Subtract other external nodal loads ... P_res = P_int - P_ext
   // P = P - Q;
-  P.addVector(1.0, Q, -1.0);
+  for (int i = 0; i < NEN*NDF; i++)
+    P(i) -= Q[i];
 
-  thread_local Vector wrapper(P);
-  return wrapper;
+  return 0;
 }
 
 template <int NEN, bool enh>
 const Vector&
 LagrangeQuad<NEN,enh>::getResistingForceIncInertia()
 {
-  static Vector P(NEN*NDF);
+  thread_local Vector P(NEN*NDF);
 
   double rhoi[nip];
   double sum = 0.0;
@@ -545,7 +695,7 @@ LagrangeQuad<NEN,enh>::getResistingForceIncInertia()
   }
 
   // Compute the current resisting force
-  P = this->getResistingForce();
+  this->formResistingForce(P);
 
   // if no mass terms .. just add damping terms
   if (sum == 0.0) {
@@ -1107,7 +1257,7 @@ LagrangeQuad<NEN,enh>::commitSensitivity(int gradNumber, int numGrads)
   for (int i = 0; i < NIP; i++) {
 
     // Determine Jacobian for this integration point
-    this->shapeFunction(pts[i][0], pts[i][1]);
+    this->shapeFunction(i);
 
     // Interpolate strains
     //eps = B*u;
@@ -1138,7 +1288,7 @@ LagrangeQuad<NEN,enh>::getResistingForceSensitivity(int gradNumber)
   for (int i = 0; i < NIP; i++) {
 
     // Determine Jacobian for this integration point
-    double dvol = this->shapeFunction(pts[i][0], pts[i][1]);
+    double dvol = this->shapeFunction(i);
     dvol *= (thickness * wts[i]);
 
     // Get material stress response
@@ -1157,6 +1307,19 @@ LagrangeQuad<NEN,enh>::getResistingForceSensitivity(int gradNumber)
 
 #endif
 
+template <int NEN, bool enh>
+double
+LagrangeQuad<NEN,enh>::shapeFunction(int ip)
+{
+  if (geometry == nullptr)
+    return this->shapeFunction(pts[ip][0], pts[ip][1]);
+
+  const PointGeometry& point = geometry->points[ip];
+  memcpy(shp, point.shp, sizeof(shp));
+  return point.detJ;
+}
+
+
 template <int NEN, bool enh>
 double
 LagrangeQuad<NEN,enh>::shapeFunction(double xi, double eta)
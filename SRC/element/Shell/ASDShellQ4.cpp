@@ -264,7 +264,9 @@ struct AGQIParams
 /** \brief ASDShellQ4Globals
  *
  * This singleton class stores some data for the shell calculations that
- * can be statically instantiated to avoid useless re-allocations
+ * can be statically instantiated to avoid useless re-allocations.
+ * There is one instance per thread, so that different elements can be
+ * computed concurrently.
  *
  */
 class ASDShellQ4Globals
@@ -311,7 +313,7 @@ public:
 
 public:
     static ASDShellQ4Globals& instance() {
-        static ASDShellQ4Globals _instance;
+        static thread_local ASDShellQ4Globals _instance;
         return _instance;
     }
 };
@@ -498,7 +500,7 @@ void computeBMatrix(
     // shear ***************************************************************************************************
 
     // MITC modified shape functions
-    static Matrix MITCShapeFunctions(2, 4);
+    static thread_local Matrix MITCShapeFunctions(2, 4);
     MITCShapeFunctions.Zero();
     MITCShapeFunctions(1, 0) = 1.0 - xi;
     MITCShapeFunctions(0, 1) = 1.0 - eta;
@@ -508,7 +510,7 @@ void computeBMatrix(
     // strain displacement matrix in natural coordinate system.
     // interpolate the shear strains given in MITC4Params
     // using the modified shape function
-    static Matrix BN(2, 24);
+    static thread_local Matrix BN(2, 24);
     BN.addMatrixProduct(0.0, MITCShapeFunctions, mitc.shearStrains, 1.0);
 
     // Modify the shear strain intensity in the tying points
@@ -530,7 +532,7 @@ void computeBMatrix(
 
     // transform the strain-displacement matrix from natural
     // to local coordinate system taking into account the element distortion
-    static Matrix TBN(2, 24);
+    static thread_local Matrix TBN(2, 24);
     TBN.addMatrixProduct(0.0, mitc.transformation, BN, 1.0);
     for (int i = 0; i < 2; i++)
         for (int j = 0; j < 24; j++)
@@ -943,11 +945,16 @@ int ASDShellQ4::update()
 const Matrix& ASDShellQ4::getTangentStiff()
 {
     auto& LHS = ASDShellQ4Globals::instance().LHS;
-    auto& RHS = ASDShellQ4Globals::instance().RHS;
-    calculateAll(LHS, RHS, (OPT_LHS));
+    formTangentStiff(LHS);
     return LHS;
 }
 
+int ASDShellQ4::formTangentStiff(Matrix& K)
+{
+    auto& RHS = ASDShellQ4Globals::instance().RHS;
+    return calculateAll(K, RHS, (OPT_LHS));
+}
+
 const Matrix& ASDShellQ4::getInitialStiff()
 {
     auto& LHS = ASDShellQ4Globals::instance().LHS_initial;
@@ -958,8 +965,14 @@ const Matrix& ASDShellQ4::getInitialStiff()
 
 const Matrix& ASDShellQ4::getMass()
 {
-    // Output matrix
     auto& LHS = ASDShellQ4Globals::instance().LHS_mass;
+    formMass(LHS);
+    return LHS;
+}
+
+int ASDShellQ4::formMass(Matrix& LHS)
+{
+    // Output matrix
     LHS.Zero();
 
     // Compute the reference coordinate system
@@ -999,7 +1012,41 @@ const Matrix& ASDShellQ4::getMass()
             // Rotational mass neglected for the moment ...
         }
     }
-    return LHS;
+    return 0;
+}
+
+bool ASDShellQ4::isReentrant() const
+{
+    // The scratch storage of the element is per thread, so only the
+    // sections can be shared
+    for (int i = 0; i < 4; i++)
+        if (m_sections[i] == nullptr || !m_sections[i]->isReentrant())
+            return false;
+    return true;
+}
+
+int ASDShellQ4::addTangentProduct(const double* x, double* y, double cK, double cM)
+{
+    // The local tangent is formed in the storage of the calling thread
+    // and applied to x, without being returned
+    if (cK != 0.0) {
+        auto& LHS = ASDShellQ4Globals::instance().LHS;
+        formTangentStiff(LHS);
+        for (int i = 0; i < 24; i++) {
+            double yi = 0.0;
+            for (int j = 0; j < 24; j++)
+                yi += LHS(i, j) * x[j];
+            y[i] += cK * yi;
+        }
+    }
+
+    // The mass is lumped
+    if (cM != 0.0) {
+        const Matrix& M = getMass();
+        for (int i = 0; i < 24; i++)
+            y[i] += cM * M(i, i) * x[i];
+    }
+    return 0;
 }
 
 void  ASDShellQ4::zeroLoad()
@@ -1040,17 +1087,21 @@ ASDShellQ4::addInertiaLoadToUnbalance(const Vector& accel)
 const Vector&
 ASDShellQ4::getResistingForce()
 {
-    auto& LHS = ASDShellQ4Globals::instance().LHS;
     auto& RHS = ASDShellQ4Globals::instance().RHS;
-    calculateAll(LHS, RHS, (OPT_RHS));
+    formResistingForce(RHS);
     return RHS;
 }
 
-const Vector& ASDShellQ4::getResistingForceIncInertia()
+int ASDShellQ4::formResistingForce(Vector& P)
 {
     auto& LHS = ASDShellQ4Globals::instance().LHS;
+    return calculateAll(LHS, P, (OPT_RHS));
+}
+
+const Vector& ASDShellQ4::getResistingForceIncInertia()
+{
     auto& RHS = ASDShellQ4Globals::instance().RHS_winertia;
-    calculateAll(LHS, RHS, (OPT_RHS));
+    formResistingForce(RHS);
 
     // Add damping terms
     if (alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
@@ -1765,9 +1816,9 @@ int ASDShellQ4::calculateAll(Matrix& LHS, Vector& RHS, int options)
     shapeFunctions(0.0, 0.0, N);
     shapeFunctionsNaturalDerivatives(0.0, 0.0, dN);
     computeBdrilling(reference_cs, 0.0, 0.0, jac, agq, N, dN, Bd0, m_eas);
-    static Vector drill_dstrain(8);
-    static Vector drill_dstress(8);
-    static Vector drill_dstress_el(8);
+    static thread_local Vector drill_dstrain(8);
+    static thread_local Vector drill_dstress(8);
+    static thread_local Vector drill_dstress_el(8);
 
     // Gauss loop
     for (int igauss = 0; igauss < 4; igauss++) {
@@ -1925,8 +1976,8 @@ int ASDShellQ4::calculateAll(Matrix& LHS, Vector& RHS, int options)
     // AGQI: static condensation
     if (((options & OPT_RHS) || (options & OPT_LHS)) && m_eas)
     {
-        static Matrix KQQ = Matrix(4, 4);
-        static Matrix KUQ_KQQ_inv = Matrix(24, 4);
+        static thread_local Matrix KQQ = Matrix(4, 4);
+        static thread_local Matrix KUQ_KQQ_inv = Matrix(24, 4);
         KQQ = m_eas->KQQ_inv;
         int inv_res = KQQ.Invert(m_eas->KQQ_inv);
         KUQ_KQQ_inv.addMatrixProduct(0.0, m_eas->KUQ, m_eas->KQQ_inv, 1.0);
@@ -1969,7 +2020,7 @@ void ASDShellQ4::AGQIinitialize()
 void ASDShellQ4::AGQIupdate(const Vector& UL)
 {
     // Compute incremental displacements
-    static Vector dUL(24);
+    static thread_local Vector dUL(24);
     dUL = UL;
     dUL.addVector(1.0, m_eas->U, -1.0);
 
@@ -1977,7 +2028,7 @@ void ASDShellQ4::AGQIupdate(const Vector& UL)
     m_eas->U = UL;
 
     // Update internal DOFs
-    static Vector temp(4);
+    static thread_local Vector temp(4);
     temp.addMatrixVector(0.0, m_eas->KQU, dUL, 1.0);
     temp.addVector(1.0, m_eas->Q_residual, -1.0);
     m_eas->Q.addMatrixVector(1.0, m_eas->KQQ_inv, temp, -1.0);
@@ -79,6 +79,8 @@
 #define ASDShellQ4_h
 
 #include <Element.h>
+#include <TangentProduct.h>
+#include <BufferedElement.h>
 #include <ID.h>
 #include <Vector.h>
 #include <Matrix.h>
@@ -91,7 +93,7 @@ class ASDShellQ4Transformation;
 class ASDShellQ4LocalCoordinateSystem;
 
 namespace OpenSees {
-class ASDShellQ4 : public Element
+class ASDShellQ4 : public Element, public TangentProduct, public BufferedElement
 {
 public:
     enum DrillingDOFMode {
@@ -164,6 +166,14 @@ public:
     const Matrix& getInitialStiff();
     const Matrix& getMass();
 
+    // the same, written into caller-owned storage
+    int formTangentStiff(Matrix& K);
+    int formMass(Matrix& M);
+    bool isReentrant() const;
+
+    // applies the tangent and mass to a vector, for matrix-free solvers
+    int addTangentProduct(const double* x, double* y, double cK, double cM);
+
     // methods for applying loads
     void zeroLoad();
     int addLoad(ElementalLoad* theLoad, double loadFactor);
@@ -172,6 +182,7 @@ public:
     // methods for obtaining resisting force (force includes elemental loads)
     const Vector& getResistingForce();
     const Vector& getResistingForceIncInertia();
+    int formResistingForce(Vector& P);
 
     // public methods for element output
     int sendSelf(int commitTag, Channel& theChannel);
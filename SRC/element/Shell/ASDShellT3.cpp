@@ -223,7 +223,9 @@ namespace
     /** \brief ASDShellT3Globals
      *
      * This singleton class stores some data for the shell calculations that
-     * can be statically instantiated to avoid useless re-allocations
+     * can be statically instantiated to avoid useless re-allocations.
+     * There is one instance per thread, so that different elements can be
+     * computed concurrently.
      *
      */
     class ASDShellT3Globals
@@ -282,7 +284,7 @@ namespace
 
     public:
         static ASDShellT3Globals& instance() {
-            static ASDShellT3Globals _instance;
+            static thread_local ASDShellT3Globals _instance;
             return _instance;
         }
     };
@@ -894,13 +896,18 @@ int ASDShellT3::update()
 
 const Matrix& ASDShellT3::getTangentStiff()
 {
-    // calculate
     auto& LHS = ASDShellT3Globals::instance().LHS;
-    auto& RHS = ASDShellT3Globals::instance().RHS;
-    calculateAll(LHS, RHS, (OPT_LHS));
+    formTangentStiff(LHS);
     return LHS;
 }
 
+int ASDShellT3::formTangentStiff(Matrix& K)
+{
+    // calculate
+    auto& RHS = ASDShellT3Globals::instance().RHS;
+    return calculateAll(K, RHS, (OPT_LHS));
+}
+
 const Matrix& ASDShellT3::getInitialStiff()
 {
     // calculate
@@ -912,8 +919,14 @@ const Matrix& ASDShellT3::getInitialStiff()
 
 const Matrix& ASDShellT3::getMass()
 {
-    // Output matrix
     auto& LHS = ASDShellT3Globals::instance().LHS_mass;
+    formMass(LHS);
+    return LHS;
+}
+
+int ASDShellT3::formMass(Matrix& LHS)
+{
+    // Output matrix
     LHS.Zero();
 
     // Compute the reference coordinate system
@@ -940,7 +953,15 @@ const Matrix& ASDShellT3::getMass()
     }
 
     // Done
-    return LHS;
+    return 0;
+}
+
+bool ASDShellT3::isReentrant() const
+{
+    for (int i = 0; i < 3; i++)
+        if (m_sections[i] == nullptr || !m_sections[i]->isReentrant())
+            return false;
+    return true;
 }
 
 void  ASDShellT3::zeroLoad()
@@ -982,19 +1003,23 @@ ASDShellT3::addInertiaLoadToUnbalance(const Vector& accel)
 
 const Vector& ASDShellT3::getResistingForce()
 {
-    // calculate
-    auto& LHS = ASDShellT3Globals::instance().LHS;
     auto& RHS = ASDShellT3Globals::instance().RHS;
-    calculateAll(LHS, RHS, (OPT_RHS));
+    formResistingForce(RHS);
     return RHS;
 }
 
-const Vector& ASDShellT3::getResistingForceIncInertia()
+int ASDShellT3::formResistingForce(Vector& P)
 {
     // calculate
     auto& LHS = ASDShellT3Globals::instance().LHS;
+    return calculateAll(LHS, P, (OPT_RHS));
+}
+
+const Vector& ASDShellT3::getResistingForceIncInertia()
+{
+    // calculate
     auto& RHS = ASDShellT3Globals::instance().RHS_winertia;
-    calculateAll(LHS, RHS, (OPT_RHS));
+    formResistingForce(RHS);
 
     // Add damping terms
     if (alphaM != 0.0 || betaK != 0.0 || betaK0 != 0.0 || betaKc != 0.0)
@@ -1632,9 +1657,9 @@ int ASDShellT3::calculateAll(Matrix& LHS, Vector& RHS, int options)
     m_transformation->calculateLocalDisplacements(local_cs, UG, UL);
 
     // Drilling data for drilling damage (optional)
-    static Vector drill_dstrain(8);
-    static Vector drill_dstress(8);
-    static Vector drill_dstress_el(8);
+    static thread_local Vector drill_dstrain(8);
+    static thread_local Vector drill_dstress(8);
+    static thread_local Vector drill_dstress_el(8);
 
     // Stenberg shear stabilization coefficient
     // to avoid shear oscillations in the thin limit
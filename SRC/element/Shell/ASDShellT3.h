@@ -50,6 +50,7 @@
 #define ASDShellT3_h
 
 #include <Element.h>
+#include <BufferedElement.h>
 #include <ID.h>
 #include <Vector.h>
 #include <Matrix.h>
@@ -59,7 +60,7 @@ class SectionForceDeformation;
 class ASDShellT3Transformation;
 class ASDShellT3LocalCoordinateSystem;
 
-class ASDShellT3 : public Element
+class ASDShellT3 : public Element, public BufferedElement
 {
 public:
     enum DrillingDOFMode {
@@ -118,6 +119,11 @@ public:
     const Matrix& getInitialStiff();
     const Matrix& getMass();
 
+    // the same, written into caller-owned storage
+    int formTangentStiff(Matrix& K);
+    int formMass(Matrix& M);
+    bool isReentrant() const;
+
     // methods for applying loads
     void zeroLoad();
     int addLoad(ElementalLoad* theLoad, double loadFactor);
@@ -126,6 +132,7 @@ public:
     // methods for obtaining resisting force (force includes elemental loads)
     const Vector& getResistingForce();
     const Vector& getResistingForceIncInertia();
+    int formResistingForce(Vector& P);
 
     // public methods for element output
     int sendSelf(int commitTag, Channel& theChannel);
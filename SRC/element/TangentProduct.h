@@ -0,0 +1,33 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: TangentProduct is implemented by elements that can apply
+// their stiffness and mass to a vector without returning the matrices.
+// A matrix-free system of equations uses it to form A*p element by
+// element; elements that do not implement it are multiplied with the
+// tangent of their FE_Element instead.
+//
+// addTangentProduct is called concurrently for different elements when
+// the element is also a reentrant BufferedElement, so it may only modify
+// state owned by the element.
+//
+// Written: cmp
+//
+#ifndef TangentProduct_h
+#define TangentProduct_h
+
+class TangentProduct
+{
+  public:
+    virtual ~TangentProduct() {}
+
+    // y += cK*K*x + cM*M*x, where K is the current tangent stiffness and M
+    // the mass, and x and y are ordered as the element DOFs
+    virtual int addTangentProduct(const double *x, double *y,
+                                  double cK, double cM = 0.0) = 0;
+};
+
+#endif
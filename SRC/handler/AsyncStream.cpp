@@ -0,0 +1,415 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Implementation of AsyncStream.
+//
+// Written: cmp
+//
+#include <AsyncStream.h>
+#include <Vector.h>
+#include <Logging.h>
+#include <cstdlib>
+#include <set>
+
+//
+// Streams that are alive, so that rows still in a ring are written
+// when the process exits without the recorders being destroyed. These
+// are never destroyed, so they remain valid in the atexit handler.
+//
+static std::mutex &
+liveMutex()
+{
+  static std::mutex *m = new std::mutex;
+  return *m;
+}
+
+static std::set<AsyncStream*> &
+liveStreams()
+{
+  static std::set<AsyncStream*> *streams = new std::set<AsyncStream*>;
+  return *streams;
+}
+
+void
+AsyncStream::flushAll()
+{
+  std::lock_guard<std::mutex> lock(liveMutex());
+  for (AsyncStream *stream : liveStreams())
+    stream->flush();
+}
+
+
+AsyncStream::AsyncStream(OPS_Stream *stream, int capacity)
+ : OPS_Stream(OPS_STREAM_TAGS_AsyncStream),
+   theStream(stream),
+   rows(capacity > 0 ? capacity : 1),
+   head(0), tail(0), count(0),
+   error(0),
+   stopping(false)
+{
+  {
+    std::lock_guard<std::mutex> lock(liveMutex());
+    static bool registered = false;
+    if (!registered) {
+      std::atexit(AsyncStream::flushAll);
+      registered = true;
+    }
+    liveStreams().insert(this);
+  }
+
+  writer = std::thread(&AsyncStream::writerLoop, this);
+}
+
+AsyncStream::~AsyncStream()
+{
+  {
+    std::lock_guard<std::mutex> lock(liveMutex());
+    liveStreams().erase(this);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(ringMutex);
+    stopping = true;
+  }
+  rowReady.notify_one();
+  // the writer empties the ring before it returns
+  writer.join();
+
+  delete theStream;
+}
+
+
+void
+AsyncStream::writerLoop()
+{
+  std::unique_lock<std::mutex> lock(ringMutex);
+  while (true) {
+    rowReady.wait(lock, [this]{return stopping || count > 0;});
+    if (count == 0)
+      break;
+
+    std::vector<double> &row = rows[tail];
+    lock.unlock();
+    // formatting and file I/O happen here, off the analysis thread
+    Vector data(row.data(), (int)row.size());
+    int result = theStream->write(data);
+    lock.lock();
+
+    if (result < 0)
+      error = result;
+    tail = (tail + 1) % (int)rows.size();
+    count--;
+    rowDone.notify_all();
+  }
+}
+
+void
+AsyncStream::drain()
+{
+  std::unique_lock<std::mutex> lock(ringMutex);
+  rowDone.wait(lock, [this]{return count == 0;});
+}
+
+
+int
+AsyncStream::write(Vector &data)
+{
+  std::unique_lock<std::mutex> lock(ringMutex);
+  // back-pressure: wait for the writer when the ring is full
+  rowDone.wait(lock, [this]{return count < (int)rows.size();});
+  const int slot = head;
+  int result = error;
+  error = 0;
+  lock.unlock();
+
+  // only the writer reads queued slots, and this one is not queued yet
+  const int n = data.Size();
+  std::vector<double> &row = rows[slot];
+  row.resize(n);
+  for (int i=0; i<n; i++)
+    row[i] = data(i);
+
+  lock.lock();
+  head = (head + 1) % (int)rows.size();
+  count++;
+  lock.unlock();
+  rowReady.notify_one();
+
+  return result;
+}
+
+int
+AsyncStream::flush()
+{
+  this->drain();
+
+  int result;
+  {
+    std::lock_guard<std::mutex> lock(ringMutex);
+    result = error;
+    error = 0;
+  }
+
+  if (theStream->flush() < 0)
+    result = -1;
+  return result;
+}
+
+//
+// Everything else goes to the wrapped stream, in order
+//
+int
+AsyncStream::setPrecision(int precision)
+{
+  this->drain();
+  return theStream->setPrecision(precision);
+}
+
+int
+AsyncStream::setFloatField(floatField field)
+{
+  this->drain();
+  return theStream->setFloatField(field);
+}
+
+int
+AsyncStream::setOrder(const ID &order)
+{
+  this->drain();
+  return theStream->setOrder(order);
+}
+
+int
+AsyncStream::setAddCommon(int addCommon)
+{
+  this->drain();
+  return theStream->setAddCommon(addCommon);
+}
+
+int
+AsyncStream::tag(const char *name)
+{
+  this->drain();
+  return theStream->tag(name);
+}
+
+int
+AsyncStream::tag(const char *name, const char *value)
+{
+  this->drain();
+  return theStream->tag(name, value);
+}
+
+int
+AsyncStream::endTag()
+{
+  this->drain();
+  return theStream->endTag();
+}
+
+int
+AsyncStream::attr(const char *name, int value)
+{
+  this->drain();
+  return theStream->attr(name, value);
+}
+
+int
+AsyncStream::attr(const char *name, double value)
+{
+  this->drain();
+  return theStream->attr(name, value);
+}
+
+int
+AsyncStream::attr(const char *name, const char *value)
+{
+  this->drain();
+  return theStream->attr(name, value);
+}
+
+OPS_Stream&
+AsyncStream::write(const char *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::write(const unsigned char *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::write(const signed char *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::write(const void *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::write(const double *s, int n)
+{
+  this->drain();
+  theStream->write(s, n);
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(char c)
+{
+  this->drain();
+  *theStream << c;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(unsigned char c)
+{
+  this->drain();
+  *theStream << c;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(signed char c)
+{
+  this->drain();
+  *theStream << c;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(const char *s)
+{
+  this->drain();
+  *theStream << s;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(const unsigned char *s)
+{
+  this->drain();
+  *theStream << s;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(const signed char *s)
+{
+  this->drain();
+  *theStream << s;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(const void *p)
+{
+  this->drain();
+  *theStream << p;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(int n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(unsigned int n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(long n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(unsigned long n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(short n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(unsigned short n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(bool b)
+{
+  this->drain();
+  *theStream << b;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(double n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+OPS_Stream&
+AsyncStream::operator<<(float n)
+{
+  this->drain();
+  *theStream << n;
+  return *this;
+}
+
+
+int
+AsyncStream::sendSelf(int commitTag, Channel &theChannel)
+{
+  opserr << "AsyncStream::sendSelf() - not available in parallel\n";
+  return -1;
+}
+
+int
+AsyncStream::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
+{
+  opserr << "AsyncStream::recvSelf() - not available in parallel\n";
+  return -1;
+}
@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: AsyncStream wraps another OPS_Stream so that the rows a
+// recorder writes after each commit are formatted and written on a
+// background thread. write(Vector&) only copies the values into a
+// fixed-size ring of rows; when the ring is full the analysis waits for
+// the writer (back-pressure), so memory use is bounded by the capacity.
+//
+// Everything other than row data (tags, attributes, text) is forwarded
+// to the wrapped stream on the calling thread after the rows already
+// queued have been written, so the output is identical to writing to
+// the wrapped stream directly. flush() drains the ring; the destructor
+// (run when a recorder is removed or the model is wiped) drains it and
+// deletes the wrapped stream, and streams still alive at exit are
+// drained from an atexit handler.
+//
+// Written: cmp
+//
+#ifndef AsyncStream_h
+#define AsyncStream_h
+
+#include <OPS_Stream.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#ifndef OPS_STREAM_TAGS_AsyncStream
+#define OPS_STREAM_TAGS_AsyncStream 1003
+#endif
+
+class ID;
+
+class AsyncStream : public OPS_Stream
+{
+  public:
+    // takes ownership of theStream
+    AsyncStream(OPS_Stream *theStream, int capacity = 256);
+    ~AsyncStream();
+
+    int flush();
+
+    int setPrecision(int precision);
+    int setFloatField(floatField);
+    int setOrder(const ID &order);
+    int setAddCommon(int addCommon);
+
+    // xml stuff
+    int tag(const char *);
+    int tag(const char *, const char *);
+    int endTag();
+    int attr(const char *name, int value);
+    int attr(const char *name, double value);
+    int attr(const char *name, const char *value);
+    int write(Vector &data);
+
+    // regular stuff
+    OPS_Stream& write(const char *s, int n);
+    OPS_Stream& write(const unsigned char *s, int n);
+    OPS_Stream& write(const signed char *s, int n);
+    OPS_Stream& write(const void *s, int n);
+    OPS_Stream& write(const double *s, int n);
+    OPS_Stream& operator<<(char c);
+    OPS_Stream& operator<<(unsigned char c);
+    OPS_Stream& operator<<(signed char c);
+    OPS_Stream& operator<<(const char *s);
+    OPS_Stream& operator<<(const unsigned char *s);
+    OPS_Stream& operator<<(const signed char *s);
+    OPS_Stream& operator<<(const void *p);
+    OPS_Stream& operator<<(int n);
+    OPS_Stream& operator<<(unsigned int n);
+    OPS_Stream& operator<<(long n);
+    OPS_Stream& operator<<(unsigned long n);
+    OPS_Stream& operator<<(short n);
+    OPS_Stream& operator<<(unsigned short n);
+    OPS_Stream& operator<<(bool b);
+    OPS_Stream& operator<<(double n);
+    OPS_Stream& operator<<(float n);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
+
+    // drain every AsyncStream that is still alive
+    static void flushAll();
+
+  private:
+    void drain();
+    void writerLoop();
+
+    OPS_Stream *theStream;
+
+    // ring of rows; rows [tail, tail+count) are waiting to be written
+    std::vector<std::vector<double>> rows;
+    int head, tail, count;
+    int error;
+
+    std::thread writer;
+    std::mutex  ringMutex;
+    std::condition_variable rowReady;   // signals the writer
+    std::condition_variable rowDone;    // signals the producer
+    bool stopping;
+};
+
+#endif
@@ -0,0 +1,490 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Implementation of ColumnarFileStream; see the header for
+// the file layout.
+//
+// Written: cmp
+//
+#include <ColumnarFileStream.h>
+#include <Vector.h>
+#include <Logging.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+// Chunks held by the background writer before record() has to wait
+static constexpr int MaxQueuedChunks = 4;
+
+// Target size of one chunk when the number of rows is not given
+static constexpr int DefaultChunkBytes = 1 << 20;
+
+static std::string
+quote(const std::string &s)
+{
+  std::string out = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      out += '\\';
+    out += c;
+  }
+  out += '"';
+  return out;
+}
+
+
+ColumnarFileStream::ColumnarFileStream(const char *file, openMode mode,
+                                       int width, int rows, bool writerThread)
+ : OPS_Stream(OPS_STREAM_TAGS_ColumnarFileStream),
+   theOpenMode(mode),
+   fileOpen(false),
+   inData(false),
+   bytesPerValue(width == 4 ? 4 : 8),
+   rowsPerChunk(rows),
+   numColumns(0),
+   numRows(0),
+   useThread(writerThread),
+   pending(0),
+   stopping(false)
+{
+  this->setFile(file, mode);
+}
+
+ColumnarFileStream::~ColumnarFileStream()
+{
+  this->close();
+}
+
+int
+ColumnarFileStream::setFile(const char *name, openMode mode)
+{
+  if (name == nullptr) {
+    opserr << "ColumnarFileStream::setFile() - no name passed\n";
+    return -1;
+  }
+
+  // the rows of the old file are written out before it is closed, and
+  // the new file gets its own header
+  this->close();
+  numColumns = 0;
+
+  fileName    = name;
+  theOpenMode = mode;
+  return 0;
+}
+
+int
+ColumnarFileStream::open()
+{
+  if (fileOpen)
+    return 0;
+
+  if (fileName.empty()) {
+    opserr << "ColumnarFileStream::open() - no file name has been set\n";
+    return -1;
+  }
+
+  if (theOpenMode == openMode::OVERWRITE)
+    theFile.open(fileName.c_str(), std::ios::out | std::ios::binary);
+  else
+    theFile.open(fileName.c_str(), std::ios::out | std::ios::app | std::ios::binary);
+
+  if (!theFile.is_open() || theFile.bad()) {
+    opserr << "WARNING - ColumnarFileStream::open()";
+    opserr << " - could not open file " << fileName.c_str() << "\n";
+    return -1;
+  }
+
+  // later opens of the same stream must not truncate what was written
+  theOpenMode = openMode::APPEND;
+  fileOpen = true;
+  return 0;
+}
+
+int
+ColumnarFileStream::close()
+{
+  // the writer must be done with the file before it is closed
+  this->flush();
+  this->stopWriter();
+
+  if (fileOpen)
+    theFile.close();
+  fileOpen = false;
+  return 0;
+}
+
+int
+ColumnarFileStream::flush()
+{
+  if (numRows > 0)
+    this->packChunk();
+
+  if (useThread && writer.joinable()) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueSpace.wait(lock, [this]{return pending == 0;});
+  }
+
+  if (fileOpen)
+    theFile.flush();
+
+  return 0;
+}
+
+
+int
+ColumnarFileStream::setPrecision(int)
+{
+  // the width of a value is fixed by the constructor
+  return 0;
+}
+
+int
+ColumnarFileStream::setFloatField(floatField)
+{
+  return 0;
+}
+
+//
+// Schema
+//
+int
+ColumnarFileStream::tag(const char *name)
+{
+  if (inData)
+    return 0;
+
+  if (strcmp(name, "Data") == 0) {
+    inData = true;
+    stack.clear();
+    return 0;
+  }
+
+  stack.push_back(Element{name, {}});
+  return 0;
+}
+
+int
+ColumnarFileStream::tag(const char *name, const char *value)
+{
+  if (inData)
+    return 0;
+
+  // every ResponseType names one column of the data
+  if (strcmp(name, "ResponseType") == 0)
+    columns.push_back(Column{value, stack});
+  else
+    this->addAttr(name, quote(value));
+
+  return 0;
+}
+
+int
+ColumnarFileStream::endTag()
+{
+  if (!inData && !stack.empty())
+    stack.pop_back();
+  return 0;
+}
+
+void
+ColumnarFileStream::addAttr(const char *name, const std::string &value)
+{
+  if (inData || stack.empty())
+    return;
+  stack.back().attrs.emplace_back(name, value);
+}
+
+int
+ColumnarFileStream::attr(const char *name, int value)
+{
+  this->addAttr(name, std::to_string(value));
+  return 0;
+}
+
+int
+ColumnarFileStream::attr(const char *name, double value)
+{
+  std::ostringstream s;
+  s << std::setprecision(17) << value;
+  this->addAttr(name, s.str());
+  return 0;
+}
+
+int
+ColumnarFileStream::attr(const char *name, const char *value)
+{
+  this->addAttr(name, quote(value));
+  return 0;
+}
+
+int
+ColumnarFileStream::writeHeader(int n)
+{
+  // appending to an existing file adds chunks after its header
+  if (theOpenMode == openMode::APPEND) {
+    int found = this->readHeader(n);
+    if (found < 0)
+      return -1;
+    if (found > 0) {
+      if (this->open() != 0)
+        return -1;
+      return this->startWriter(n);
+    }
+  }
+
+  if (this->open() != 0)
+    return -1;
+
+  // Recorders describe the time column only when run in parallel, so
+  // a single missing column is the leading time of -time. A recorder
+  // that does not describe its output, or describes it inconsistently,
+  // gets generic column names
+  if ((int)columns.size() + 1 == n)
+    columns.insert(columns.begin(), Column{"time", {}});
+
+  if ((int)columns.size() != n) {
+    columns.clear();
+    for (int i=0; i<n; i++)
+      columns.push_back(Column{"c" + std::to_string(i+1), {}});
+  }
+
+  std::ostringstream schema;
+  schema << "[";
+  for (int i=0; i<n; i++) {
+    const Column &column = columns[i];
+    schema << (i ? ",\n " : "") << "{\"name\":" << quote(column.response);
+    schema << ",\"path\":[";
+    for (std::size_t j=0; j<column.path.size(); j++)
+      schema << (j ? "," : "") << quote(column.path[j].name);
+    schema << "],\"attrs\":{";
+    bool first = true;
+    for (const Element &element : column.path)
+      for (const auto &attr : element.attrs) {
+        schema << (first ? "" : ",") << quote(attr.first) << ":" << attr.second;
+        first = false;
+      }
+    schema << "}}";
+  }
+  schema << "]";
+
+  if (rowsPerChunk <= 0)
+    rowsPerChunk = n > 0 ? std::max(1, DefaultChunkBytes/(n*bytesPerValue)) : 1;
+
+  const std::string text = schema.str();
+  const char magic[8] = {'X','A','R','A','C','O','L','\0'};
+  const std::uint32_t head[4] = {1u, (std::uint32_t)bytesPerValue,
+                                 (std::uint32_t)n, (std::uint32_t)rowsPerChunk};
+  const std::uint64_t length = text.size();
+
+  theFile.write(magic, sizeof(magic));
+  theFile.write((const char*)head, sizeof(head));
+  theFile.write((const char*)&length, sizeof(length));
+  theFile.write(text.data(), text.size());
+
+  if (theFile.bad())
+    return -1;
+
+  return this->startWriter(n);
+}
+
+//
+// Check the header of an existing file before appending to it. Returns
+// 0 if the file is missing or empty, 1 if its header matches the stream,
+// and -1 if it does not.
+//
+int
+ColumnarFileStream::readHeader(int n)
+{
+  std::ifstream in(fileName.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+  if (!in.is_open() || in.tellg() <= 0)
+    return 0;
+  in.seekg(0);
+
+  char magic[8];
+  std::uint32_t head[4];
+  in.read(magic, sizeof(magic));
+  in.read((char*)head, sizeof(head));
+  if (!in || std::memcmp(magic, "XARACOL", 8) != 0 || head[0] != 1u) {
+    opserr << "WARNING - ColumnarFileStream - cannot append to " << fileName.c_str()
+           << "; it is not a columnar file\n";
+    return -1;
+  }
+
+  if ((int)head[1] != bytesPerValue || (int)head[2] != n) {
+    opserr << "WARNING - ColumnarFileStream - cannot append to " << fileName.c_str()
+           << "; it holds " << (int)head[2] << " columns of " << (int)head[1]
+           << " bytes but " << n << " columns of " << bytesPerValue
+           << " bytes are recorded\n";
+    return -1;
+  }
+
+  // the chunks may not be larger than the header says
+  if (rowsPerChunk <= 0 || rowsPerChunk > (int)head[3])
+    rowsPerChunk = head[3];
+
+  return 1;
+}
+
+int
+ColumnarFileStream::startWriter(int n)
+{
+  numColumns = n;
+  rowData.reserve((std::size_t)rowsPerChunk*n);
+
+  if (useThread && !writer.joinable()) {
+    stopping = false;
+    writer = std::thread(&ColumnarFileStream::writerLoop, this);
+  }
+
+  return 0;
+}
+
+//
+// Data
+//
+int
+ColumnarFileStream::write(Vector &data)
+{
+  const int n = data.Size();
+  if (n == 0)
+    return 0;
+
+  if (numColumns == 0 && this->writeHeader(n) != 0)
+    return -1;
+
+  if (n != numColumns) {
+    opserr << "ColumnarFileStream::write() - expected " << numColumns
+           << " values but received " << n << "\n";
+    return -1;
+  }
+
+  for (int i=0; i<n; i++)
+    rowData.push_back(data(i));
+
+  if (++numRows >= rowsPerChunk)
+    this->packChunk();
+
+  return 0;
+}
+
+void
+ColumnarFileStream::packChunk()
+{
+  const std::uint32_t rows = numRows;
+  std::vector<char> chunk(sizeof(rows) + (std::size_t)rows*numColumns*bytesPerValue);
+  std::memcpy(chunk.data(), &rows, sizeof(rows));
+
+  // transpose the buffered rows into columns
+  char *out = chunk.data() + sizeof(rows);
+  for (int j=0; j<numColumns; j++)
+    for (std::uint32_t i=0; i<rows; i++) {
+      const double value = rowData[(std::size_t)i*numColumns + j];
+      if (bytesPerValue == 4) {
+        const float single = (float)value;
+        std::memcpy(out, &single, 4);
+      } else
+        std::memcpy(out, &value, 8);
+      out += bytesPerValue;
+    }
+
+  rowData.clear();
+  numRows = 0;
+
+  if (!writer.joinable()) {
+    this->writeChunk(chunk);
+    return;
+  }
+
+  // hand the chunk to the writer, waiting if it has fallen behind
+  std::unique_lock<std::mutex> lock(queueMutex);
+  queueSpace.wait(lock, [this]{return (int)queue.size() < MaxQueuedChunks;});
+  queue.push_back(std::move(chunk));
+  pending++;
+  lock.unlock();
+  queueReady.notify_one();
+}
+
+void
+ColumnarFileStream::writeChunk(const std::vector<char> &chunk)
+{
+  if (fileOpen)
+    theFile.write(chunk.data(), chunk.size());
+}
+
+void
+ColumnarFileStream::writerLoop()
+{
+  std::unique_lock<std::mutex> lock(queueMutex);
+  while (true) {
+    queueReady.wait(lock, [this]{return stopping || !queue.empty();});
+    if (queue.empty())
+      break;
+
+    std::vector<char> chunk = std::move(queue.front());
+    queue.pop_front();
+    lock.unlock();
+    this->writeChunk(chunk);
+    lock.lock();
+    pending--;
+    queueSpace.notify_all();
+  }
+}
+
+void
+ColumnarFileStream::stopWriter()
+{
+  if (!writer.joinable())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    stopping = true;
+  }
+  queueReady.notify_one();
+  writer.join();
+}
+
+//
+// Text output is not part of the format
+//
+OPS_Stream& ColumnarFileStream::write(const char *, int)          {return *this;}
+OPS_Stream& ColumnarFileStream::write(const unsigned char *, int) {return *this;}
+OPS_Stream& ColumnarFileStream::write(const signed char *, int)   {return *this;}
+OPS_Stream& ColumnarFileStream::write(const void *, int)          {return *this;}
+OPS_Stream& ColumnarFileStream::write(const double *, int)        {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(char)                  {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(unsigned char)         {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(signed char)           {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(const char *)          {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(const unsigned char *) {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(const signed char *)   {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(const void *)          {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(int)                   {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(unsigned int)          {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(long)                  {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(unsigned long)         {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(short)                 {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(unsigned short)        {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(bool)                  {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(double)                {return *this;}
+OPS_Stream& ColumnarFileStream::operator<<(float)                 {return *this;}
+
+
+int
+ColumnarFileStream::sendSelf(int commitTag, Channel &theChannel)
+{
+  opserr << "ColumnarFileStream::sendSelf() - not available in parallel\n";
+  return -1;
+}
+
+int
+ColumnarFileStream::recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker)
+{
+  opserr << "ColumnarFileStream::recvSelf() - not available in parallel\n";
+  return -1;
+}
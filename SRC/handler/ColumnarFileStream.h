@@ -0,0 +1,157 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: ColumnarFileStream writes recorder output as a
+// self-describing binary file. The column schema is taken from the
+// tag/attr calls a recorder makes in its initialize() (e.g., the
+// NodeOutput/nodeTag/ResponseType sequence of a NodeRecorder), so each
+// column carries the node or element tag and the response name it
+// holds. Rows are written as fixed width float32 or float64 values,
+// collected in chunks and stored column-major within each chunk.
+//
+// File layout (native byte order):
+//
+//   char[8]   magic "XARACOL" followed by '\0'
+//   uint32    format version
+//   uint32    bytes per value (4 or 8)
+//   uint32    number of columns
+//   uint32    maximum number of rows per chunk
+//   uint64    length of the schema in bytes
+//   char[]    schema; a JSON array with one object per column
+//
+// followed by any number of chunks
+//
+//   uint32    number of rows in the chunk, n
+//   value[]   n values of column 0, then n values of column 1, ...
+//
+// A stream opened in APPEND mode on a file that is not empty checks its
+// header against the recorded columns and adds chunks after the last.
+//
+// Chunks may optionally be written by a background thread, so that
+// the analysis does not wait on the disk. xara.columnar.read() loads
+// the file into numpy arrays.
+//
+// Written: cmp
+//
+#ifndef ColumnarFileStream_h
+#define ColumnarFileStream_h
+
+#include <OPS_Stream.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Defined here, outside the range of the tags of the other streams,
+// until it is added to classTags.h, which is not in this source tree
+#ifndef OPS_STREAM_TAGS_ColumnarFileStream
+#define OPS_STREAM_TAGS_ColumnarFileStream 1002
+#endif
+
+class ColumnarFileStream : public OPS_Stream
+{
+  public:
+    ColumnarFileStream(const char *fileName,
+                       openMode mode = openMode::OVERWRITE,
+                       int bytesPerValue = 8,
+                       int rowsPerChunk  = 0,
+                       bool writerThread = false);
+    ~ColumnarFileStream();
+
+    int setFile(const char *fileName, openMode mode = openMode::OVERWRITE);
+    int open();
+    int close();
+    int flush();
+
+    int setPrecision(int precision);
+    int setFloatField(floatField);
+
+    // xml stuff
+    int tag(const char *);
+    int tag(const char *, const char *);
+    int endTag();
+    int attr(const char *name, int value);
+    int attr(const char *name, double value);
+    int attr(const char *name, const char *value);
+    int write(Vector &data);
+
+    // regular stuff; text is not part of the format and is discarded
+    OPS_Stream& write(const char *s, int n);
+    OPS_Stream& write(const unsigned char *s, int n);
+    OPS_Stream& write(const signed char *s, int n);
+    OPS_Stream& write(const void *s, int n);
+    OPS_Stream& write(const double *s, int n);
+    OPS_Stream& operator<<(char c);
+    OPS_Stream& operator<<(unsigned char c);
+    OPS_Stream& operator<<(signed char c);
+    OPS_Stream& operator<<(const char *s);
+    OPS_Stream& operator<<(const unsigned char *s);
+    OPS_Stream& operator<<(const signed char *s);
+    OPS_Stream& operator<<(const void *p);
+    OPS_Stream& operator<<(int n);
+    OPS_Stream& operator<<(unsigned int n);
+    OPS_Stream& operator<<(long n);
+    OPS_Stream& operator<<(unsigned long n);
+    OPS_Stream& operator<<(short n);
+    OPS_Stream& operator<<(unsigned short n);
+    OPS_Stream& operator<<(bool b);
+    OPS_Stream& operator<<(double n);
+    OPS_Stream& operator<<(float n);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
+
+  private:
+    struct Element {
+      std::string name;
+      std::vector<std::pair<std::string,std::string>> attrs;
+    };
+    struct Column {
+      std::string response;
+      std::vector<Element> path;
+    };
+
+    void addAttr(const char *name, const std::string &value);
+    int  writeHeader(int numColumns);
+    int  readHeader(int numColumns);
+    int  startWriter(int numColumns);
+    void packChunk();
+    void writeChunk(const std::vector<char> &chunk);
+    void writerLoop();
+    void stopWriter();
+
+    std::string fileName;
+    openMode theOpenMode;
+    std::ofstream theFile;
+    bool fileOpen;
+
+    // schema
+    std::vector<Element> stack;
+    std::vector<Column>  columns;
+    bool inData;
+
+    // data
+    int  bytesPerValue;
+    int  rowsPerChunk;
+    int  numColumns;        // 0 until the header is written
+    int  numRows;           // rows held in rowData
+    std::vector<double> rowData;
+
+    // background writer
+    bool useThread;
+    std::thread writer;
+    std::mutex  queueMutex;
+    std::condition_variable queueReady;   // signals the writer
+    std::condition_variable queueSpace;   // signals the producer
+    std::deque<std::vector<char>> queue;
+    int  pending;           // chunks queued or being written
+    bool stopping;
+};
+
+#endif
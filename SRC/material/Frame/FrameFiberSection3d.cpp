@@ -25,12 +25,19 @@
 #include <SensitiveResponse.h>
 typedef SensitiveResponse<FrameSection> SectionResponse;
 #include <UniaxialMaterial.h>
+#include <UniaxialBatch.h>
 #include <ElasticMaterial.h>
 
 #include "FiberResponse.h"
 
-// #include <threads/thread_pool.hpp>
 // #define N_FIBER_THREADS 6
+#ifdef N_FIBER_THREADS
+#  include <threads/shared_pool.hpp>
+#  ifndef N_FIBER_THREAD_MIN
+     // sections with fewer fibers than this are always integrated serially
+#    define N_FIBER_THREAD_MIN 64
+#  endif
+#endif
 
 ID FrameFiberSection3d::code(4);
 
@@ -38,13 +45,10 @@ FrameFiberSection3d::FrameFiberSection3d(int tag, int num, UniaxialMaterial &tor
                                          double mass, bool use_mass)
   : FrameSection(tag, SEC_TAG_FrameFiberSection3d, mass, use_mass),
     numFibers(0), sizeFibers(num), 
-    theMaterials(nullptr), matData(new double [num*3]{}),
+    theMaterials(nullptr), batchFibers(false), matData(new double [num*3]{}),
     QzBar(0.0), QyBar(0.0), Abar(0.0), 
     yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
     theTorsion(0),
-#ifdef N_FIBER_THREADS
-    pool((void*)new OpenSees::thread_pool{N_FIBER_THREADS}),
-#endif
     e(es), s(sr), K_wrap(ks)
 {
     if (sizeFibers != 0) {
@@ -71,13 +75,10 @@ FrameFiberSection3d::FrameFiberSection3d(int tag, int num, UniaxialMaterial &tor
 FrameFiberSection3d::FrameFiberSection3d():
   FrameSection(0, SEC_TAG_FrameFiberSection3d, 0, false),
   numFibers(0), sizeFibers(0), 
-  theMaterials(0), 
+  theMaterials(0), batchFibers(false),
   matData(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), 
   yBar(0.0), zBar(0.0), computeCentroid(true),
-#ifdef N_FIBER_THREADS
-  pool((void*)new OpenSees::thread_pool{N_FIBER_THREADS}),
-#endif
   e(es), s(sr), K_wrap(ks),
   theTorsion(nullptr)
 {
@@ -225,6 +226,12 @@ FrameFiberSection3d::addFiber(UniaxialMaterial &theMat,
   matData[numFibers*3+2] = Area;
   theMaterials[numFibers] = theMat.getCopy();
 
+  if (theMaterials[numFibers] == nullptr) {
+    opserr << "FrameFiberSection3d::addFiber -- failed to get copy of a Material\n";
+    return -1;
+  }
+
+  OpenSees::setBatchRuns(theMaterials, numFibers, numFibers+1, sameClass);
   numFibers++;
 
   // Recompute centroid
@@ -240,73 +247,23 @@ FrameFiberSection3d::addFiber(UniaxialMaterial &theMat,
   return 0;
 }
 
-
-#ifdef N_FIBER_THREADS
-#include <mutex>
-int
-FrameFiberSection3d::setTrialSectionDeformation(const Vector &deforms)
+void
+FrameFiberSection3d::setBatchUpdate(bool batch)
 {
-  e = deforms;
- 
-  sr.zero();
-  ks.zero();
-
-  const double e0 = deforms(0), // u'
-               e1 = deforms(1),
-               e2 = deforms(2),
-               e3 = deforms(3);
-
-  int res = 0;
-  std::mutex resp_mutex;
-
-  ((OpenSees::thread_pool*)pool)->submit_loop<unsigned int>(0, numFibers,
-  [&,e0,e1,e2](int i){
-    int res = 0;
-
-    const double y  = matData[3*i]   - yBar;
-    const double z  = matData[3*i+1] - zBar;
-    const double A  = matData[3*i+2];
-
-    // determine material strain and set it
-    const double strain = e0 - y*e1 + z*e2;
-    double tangent, stress;
-    res += theMaterials[i]->setTrial(strain, stress, tangent);
-
-    const double EA = tangent * A;
-
-    const std::lock_guard<std::mutex> lock(resp_mutex);
-    ks(0, 0) +=     EA;
-    ks(0, 1) +=  -y*EA;
-    ks(0, 2) +=   z*EA;
-
-    ks(1, 1) +=  y*y*EA;
-    ks(2, 2) +=  z*z*EA; 
-    ks(1, 2) += -y*z*EA;
-
-    double fs0 = stress * A;
-    sr[ 0] +=    fs0;  // N
-    sr[ 1] += -y*fs0;  // Mz
-    sr[ 2] +=  z*fs0;  // My
-
-    return res;
-  }).wait();
+  batchFibers = batch;
+  OpenSees::setBatchRuns(theMaterials, 0, numFibers, sameClass);
+}
 
-  ks(1, 0) = ks(0, 1);
-  ks(2, 0) = ks(0, 2);
-  ks(2, 1) = ks(1, 2);
- 
-  if (theTorsion != nullptr) {
-    double stress, tangent;
-    res += theTorsion->setTrial(e3, stress, tangent);
-    sr[ 3] = stress;
-    ks(3, 3) = tangent;
-  }
 
-  return res;
+namespace {
+// Partial stress resultants and stiffness of a block of fibers
+struct FiberBlock3d {
+  double k[6];  // k00, k01, k02, k11, k12, k22
+  double s[3];  // N, Mz, My
+  int    res;
+};
 }
 
-#else
-
 int
 FrameFiberSection3d::setTrialSectionDeformation(const Vector &deforms)
 {
@@ -320,38 +277,64 @@ FrameFiberSection3d::setTrialSectionDeformation(const Vector &deforms)
                k2 = deforms(2),
                e3 = deforms(3);
 
-  int res = 0;
-  for (int i = 0; i < numFibers; i++) {
-
-    const double y  = matData[3*i]   - yBar;
-    const double z  = matData[3*i+1] - zBar;
-    const double A  = matData[3*i+2];
-
-    // Determine material strain and set it
-    double strain = e0 - y*k1 + z*k2;
-    double tangent, stress;
-    res += theMaterials[i]->setTrial(strain, stress, tangent);
-
-    double EA     = tangent * A;
+  // Integrate fibers [first, last) into a block-local sum; blocks
+  // never write to shared data, so no lock is needed when threaded
+  auto block = [&,e0,k1,k2](unsigned int first, unsigned int last) {
+    FiberBlock3d sum{};
+    // Determine material strains and set them
+    auto strain = [&](int i) {
+      return e0 - (matData[3*i] - yBar)*k1 + (matData[3*i+1] - zBar)*k2;
+    };
+    auto accumulate = [&](int i, double stress, double tangent) {
+      const double y  = matData[3*i]   - yBar;
+      const double z  = matData[3*i+1] - zBar;
+      const double A  = matData[3*i+2];
+
+      const double EA = tangent * A;
+
+      sum.k[0] +=     EA;
+      sum.k[1] +=  -y*EA;
+      sum.k[2] +=   z*EA;
+      sum.k[3] +=  y*y*EA;
+      sum.k[4] += -y*z*EA;
+      sum.k[5] +=  z*z*EA;
+
+      const double fs0 = stress * A;
+      sum.s[0] +=    fs0;  // N
+      sum.s[1] += -y*fs0;  // Mz
+      sum.s[2] +=  z*fs0;  // My
+    };
+    if (batchFibers)
+      sum.res = OpenSees::setTrialBatch(theMaterials, sameClass, first, last, strain, accumulate);
+    else
+      sum.res = OpenSees::setTrialEach(theMaterials, first, last, strain, accumulate);
+    return sum;
+  };
 
-    ks( 0, 0) +=     EA;
-    ks( 0, 1) +=  -y*EA;
-    ks( 0, 2) +=   z*EA;
-//  ks( 0, 2) +=   z*EA;
+#ifdef N_FIBER_THREADS
+  const FiberBlock3d sum = OpenSees::reduce_blocks<FiberBlock3d>(numFibers, 
+      N_FIBER_THREAD_MIN, N_FIBER_THREADS, block,
+      [](FiberBlock3d& total, const FiberBlock3d& part) {
+        for (int j=0; j<6; j++) total.k[j] += part.k[j];
+        for (int j=0; j<3; j++) total.s[j] += part.s[j];
+        total.res += part.res;
+  });
+#else
+  const FiberBlock3d sum = block(0, numFibers);
+#endif
 
-    ks( 1, 1) +=  y*y*EA; // 5
-    ks( 2, 2) +=  z*z*EA; // 10
-    ks( 1, 2) += -y*z*EA;
+  int res = sum.res;
 
-    double fs0 = stress * A;
-    sr[0] +=    fs0;  // N
-    sr[1] += -y*fs0;  // Mz
-    sr[2] +=  z*fs0;  // My
-  }
+  ks(0, 0) = sum.k[0];
+  ks(0, 1) = ks(1, 0) = sum.k[1];
+  ks(0, 2) = ks(2, 0) = sum.k[2];
+  ks(1, 1) = sum.k[3];
+  ks(1, 2) = ks(2, 1) = sum.k[4];
+  ks(2, 2) = sum.k[5];
 
-  ks(1, 0) = ks(0, 1);
-  ks(2, 0) = ks(0, 2);
-  ks(2, 1) = ks(1, 2);
+  sr[0] = sum.s[0];
+  sr[1] = sum.s[1];
+  sr[2] = sum.s[2];
  
   if (theTorsion != nullptr) {
     double stress, tangent;
@@ -362,7 +345,6 @@ FrameFiberSection3d::setTrialSectionDeformation(const Vector &deforms)
 
   return res;
 }
-#endif
 
 
 
@@ -431,7 +413,6 @@ FrameFiberSection3d::getFrameCopy()
   theCopy->setTag(this->getTag());
   theCopy->numFibers  = numFibers;
   theCopy->sizeFibers = numFibers;
-  theCopy->pool       = pool;
 
   if (numFibers != 0) {
     theCopy->theMaterials = new UniaxialMaterial *[numFibers];
@@ -446,7 +427,9 @@ FrameFiberSection3d::getFrameCopy()
         return nullptr;
       }
     }    
+    theCopy->sameClass = sameClass;
   }
+  theCopy->batchFibers = batchFibers;
 
   theCopy->e = e;
   theCopy->sr = sr;
@@ -683,6 +666,7 @@ FrameFiberSection3d::recvSelf(int commitTag, Channel &theChannel,
       theMaterials[i]->setDbTag(dbTag);
       res += theMaterials[i]->recvSelf(commitTag, theChannel, theBroker);
     }
+    OpenSees::setBatchRuns(theMaterials, 0, numFibers, sameClass);
 
     QzBar = 0.0;
     QyBar = 0.0;
@@ -22,6 +22,7 @@
 #include <Matrix.h>
 #include <VectorND.h>
 #include <memory>
+#include <vector>
 
 class Response;
 class UniaxialMaterial;
@@ -64,6 +65,10 @@ class FrameFiberSection3d : public FrameSection
     int getResponse(int responseID, Information &info);
 
     int addFiber(UniaxialMaterial &theMat, const double area, const double y, const double z);
+
+    // Update runs of fibers of the same material class with one call
+    // to UniaxialMaterial::setTrialBatch; off by default
+    void setBatchUpdate(bool batch);
 //  int setField(const char**, int, double);
 
     int setParameter(const char **argv, int argc, Parameter &param);
@@ -92,6 +97,8 @@ class FrameFiberSection3d : public FrameSection
 
     int numFibers, sizeFibers;         // number of fibers in the section
     UniaxialMaterial **theMaterials;   // array of pointers to materials
+    std::vector<char> sameClass;       // runs of fibers of the same material class
+    bool batchFibers;                  // update the runs in sameClass together
     std::shared_ptr<double[]> matData; // data for the materials [yloc, zloc, and area]
 
     OpenSees::MatrixND<nsr,nsr> ks;
@@ -109,7 +116,6 @@ class FrameFiberSection3d : public FrameSection
     Vector  s;         // section resisting forces  (axial force, bending moment)
 
     UniaxialMaterial *theTorsion;
-    void *pool;        // thread pool
 };
 
 #endif
@@ -19,6 +19,7 @@ class ElasticIsotropic : public Mate<ndim> {
   virtual const char* getClassType() const final;
 
   virtual int revertToStart() final;
+  virtual bool isReentrant() const final {return true;}
 
 //virtual MatrixND<ndim,ndim> getStress_matrix() final;
   virtual const MatrixSD<ndim>& getStress() final;
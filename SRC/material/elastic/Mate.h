@@ -48,6 +48,12 @@ class Mate : public TaggedObject {
     return 0.0;
   }
 
+  // true if different instances may be updated on different threads at once
+  virtual bool isReentrant() const
+  {
+    return false;
+  }
+
   virtual MatrixSD<ne> getTangent() = 0;
   virtual MatrixSD<ne> getInitialTangent() = 0;
 
@@ -126,6 +126,14 @@ public:
                             typename PlasticFlowType::internal_variables_t >;
     using iv_storage_t = utuple_storage<iv_concat_types>;
 
+    // Unknowns of the backward Euler step: stress, internal variables and
+    // plastic multiplier
+    static constexpr int n_iv_components = InternalVariableComponents<iv_concat_types>::value;
+    static constexpr int n_backward_euler = 6 + n_iv_components + 1;
+    using iv_vector_t = Eigen::Matrix<double, n_iv_components, 1>;
+    using be_vector_t = Eigen::Matrix<double, n_backward_euler, 1>;
+    using be_matrix_t = Eigen::Matrix<double, n_backward_euler, n_backward_euler>;
+
     // Concatenate the model parameters into the parameters storage
     using extracted_parameters_t = utuple_concat_unique_type <
                                    ExtractNestedParameterTypes_t<typename YieldFunctionType::internal_variables_t>,
@@ -148,14 +156,14 @@ public:
     //==================================================================================================
 
     ASDPlasticMaterial( )
-        : NDMaterial(0, thisClassTag)
+        : NDMaterial(0, thisClassTag), tangent_matrix(6, 6)
     {
-
+        Stiffness.setZero();
     }
 
 
     ASDPlasticMaterial(int tag)
-        : NDMaterial(tag, thisClassTag)
+        : NDMaterial(tag, thisClassTag), tangent_matrix(6, 6)
     {
 
 
@@ -165,6 +173,11 @@ public:
         CommitStrain *= 0;
         TrialPlastic_Strain *= 0;
         CommitPlastic_Strain *= 0;
+        dsigma.setZero();
+        depsilon_elpl.setZero();
+        intersection_stress.setZero();
+        intersection_strain.setZero();
+        Stiffness.setZero();
 
         first_step = true;
     }
@@ -311,43 +324,7 @@ public:
         }
         // ==========================================
 
-        switch (INT_OPT_constitutive_integration_method[this->getTag()])
-        {
-        case ASDPlasticMaterial_Constitutive_Integration_Method::Not_Set :
-            exitflag = -1;
-            cerr << "CEP::setTrialStrainIncr - Integration method not set!\n" ;
-            break;
-        case ASDPlasticMaterial_Constitutive_Integration_Method::Forward_Euler :
-            exitflag = this->Forward_Euler(strain_increment);
-            break;
-        // case ASDPlasticMaterial_Constitutive_Integration_Method::Forward_Euler_Subincrement :
-        //     exitflag = this->Forward_Euler_Subincrement(strain_increment);
-        //     break;
-        // case ASDPlasticMaterial_Constitutive_Integration_Method::Backward_Euler :
-        //     exitflag = this->Backward_Euler(strain_increment);;
-        //     break;
-        // case ASDPlasticMaterial_Constitutive_Integration_Method::Backward_Euler_ddlambda :
-        //     exitflag = this->Backward_Euler_ddlambda(strain_increment);;
-        //     break;
-        // case ASDPlasticMaterial_Constitutive_Integration_Method::Backward_Euler_ddlambda_Subincrement :
-        //     exitflag = this->Backward_Euler_ddlambda_Subincrement(strain_increment);;
-        //     break;
-        // case ASDPlasticMaterial_Constitutive_Integration_Method::Forward_Euler_Crisfield :
-        //     exitflag = this->Forward_Euler(strain_increment, true);
-        //     break;
-        // case ASDPlasticMaterial_Constitutive_Integration_Method::Multistep_Forward_Euler_Crisfield :
-        //     exitflag = this->Multistep_Forward_Euler(strain_increment, true);
-        //     break;
-        // case ASDPlasticMaterial_Constitutive_Integration_Method::Modified_Euler_Error_Control :
-        //     exitflag = this->Modified_Euler_Error_Control(strain_increment);
-        //     break;
-        case ASDPlasticMaterial_Constitutive_Integration_Method::Runge_Kutta_45_Error_Control :
-            exitflag = this->Runge_Kutta_45_Error_Control(strain_increment);;
-            break;
-        default:
-            cerr << "ASDPlasticMaterial::setTrialStrainIncr - Integration method not available!\n" ;
-            exitflag = -1;
-        }
+        exitflag = (this->*integrate)(strain_increment);
 
         return exitflag;
     }
@@ -482,61 +459,66 @@ public:
 
     void ComputeTangentStiffness()
     {
-        if (INT_OPT_tangent_operator_type[this->getTag()] == ASDPlasticMaterial_Tangent_Operator_Type::Elastic)
+        (this->*compute_tangent)();
+    }
+
+    template <ASDPlasticMaterial_Tangent_Operator_Type tangent_type>
+    void ComputeTangentStiffness()
+    {
+        if constexpr (tangent_type == ASDPlasticMaterial_Tangent_Operator_Type::Elastic)
         {
             VoigtMatrix Eelastic = et(CommitStress, parameters_storage);
             Stiffness = Eelastic;
         }
-        // else if (INT_OPT_tangent_operator_type[this->getTag()] == ASDPlasticMaterial_Tangent_Operator_Type::Continuum)
-        // {
-
-        //     VoigtMatrix Eelastic = et(TrialStress, parameters_storage);
-        //     const VoigtVector& n = yf.df_dsigma_ij(TrialStress, iv_storage, parameters_storage);
-        //     const VoigtVector& m = pf(depsilon_elpl, TrialStress, iv_storage, parameters_storage);
-
-        //     double xi_star_h_star = yf.xi_star_h_star( depsilon_elpl, m,  TrialStress, iv_storage, parameters_storage);
-
-        //     double den_after_corrector = n.transpose() * Eelastic * m - xi_star_h_star;
+        else if constexpr (tangent_type == ASDPlasticMaterial_Tangent_Operator_Type::Secant)
+        {
+            VoigtMatrix Eelastic = et(TrialStress, parameters_storage);
+            Stiffness = (Continuum_Stiffness() + Eelastic) / 2;
+        }
+        else
+        {
+            // The explicit integrators have no algorithmic tangent of their
+            // own, Algorithmic falls back to the continuum operator here.
+            Stiffness = Continuum_Stiffness();
+        }
+    }
 
-        //     VoigtMatrix Econtinuum = Eelastic - Eelastic * m * (n.transpose() * Eelastic) / den_after_corrector;
-        //     Stiffness = Econtinuum;
-        // }
-        // else if (INT_OPT_tangent_operator_type[this->getTag()] == ASDPlasticMaterial_Tangent_Operator_Type::Secant)
-        // {
+    VoigtMatrix Continuum_Stiffness()
+    {
+        using namespace ASDPlasticMaterialGlobals;
 
-        //     VoigtMatrix Eelastic = et(TrialStress, parameters_storage);
-        //     const VoigtVector& n = yf.df_dsigma_ij(TrialStress, iv_storage, parameters_storage);
-        //     const VoigtVector& m = pf(depsilon_elpl, TrialStress, iv_storage, parameters_storage);
+        VoigtMatrix Eelastic = et(TrialStress, parameters_storage);
+        VoigtVector n = yf.df_dsigma_ij(TrialStress, iv_storage, parameters_storage);
+        VoigtVector m = pf(depsilon_elpl, TrialStress, iv_storage, parameters_storage);
 
-        //     double xi_star_h_star = yf.xi_star_h_star( depsilon_elpl, m,  TrialStress, iv_storage, parameters_storage);
+        double xi_star_h_star = yf.xi_star_h_star( depsilon_elpl, m,  TrialStress, iv_storage, parameters_storage);
 
-        //     double den_after_corrector = n.transpose() * Eelastic * m - xi_star_h_star;
+        double den = n.transpose() * Eelastic * m - xi_star_h_star;
+        if (abs(den) < MACHINE_EPSILON)
+        {
+            return Eelastic;
+        }
 
-        //     VoigtMatrix Econtinuum = Eelastic - Eelastic * m * (n.transpose() * Eelastic) / den_after_corrector;
-        //     Stiffness = (Econtinuum + Eelastic)/2;
-        // }
+        VoigtMatrix Econtinuum = Eelastic - Eelastic * m * (n.transpose() * Eelastic) / den;
+        return Econtinuum;
     }
 
     const Matrix& getTangent()
     {
-        static Matrix return_matrix(6, 6);
+        copyToMatrixReference(Stiffness, tangent_matrix);
 
-        copyToMatrixReference(Stiffness, return_matrix);
-
-        return return_matrix;
+        return tangent_matrix;
     }
 
 
     const Matrix& getInitialTangent()
     {
-        static Matrix return_matrix(6, 6);
-
         VoigtMatrix Eelastic = et(CommitStress, parameters_storage);
         Stiffness = Eelastic;
 
-        copyToMatrixReference(this->Stiffness, return_matrix);
+        copyToMatrixReference(this->Stiffness, tangent_matrix);
 
-        return return_matrix;
+        return tangent_matrix;
     }
 
 
@@ -617,8 +599,10 @@ public:
         newmaterial->CommitStress = this->CommitStress;
         newmaterial->CommitStrain = this->CommitStrain;
         newmaterial->CommitPlastic_Strain = this->CommitPlastic_Strain;
+        newmaterial->Stiffness = this->Stiffness;
         newmaterial->iv_storage = this->iv_storage;
         newmaterial->parameters_storage = this->parameters_storage;
+        newmaterial->copy_integration_options(*this);
 
         return newmaterial;
     }
@@ -639,8 +623,10 @@ public:
             newmaterial->CommitStress = this->CommitStress;
             newmaterial->CommitStrain = this->CommitStrain;
             newmaterial->CommitPlastic_Strain = this->CommitPlastic_Strain;
+            newmaterial->Stiffness = this->Stiffness;
             newmaterial->iv_storage = this->iv_storage;
             newmaterial->parameters_storage = this->parameters_storage;
+            newmaterial->copy_integration_options(*this);
 
             return newmaterial;
         } else
@@ -793,13 +779,14 @@ public:
                 || method == (int) ASDPlasticMaterial_Constitutive_Integration_Method::Backward_Euler_ddlambda_Subincrement
                 || method == (int) ASDPlasticMaterial_Constitutive_Integration_Method::Full_Backward_Euler)
         {
-            int tag = this->getTag();
-            INT_OPT_constitutive_integration_method[tag] = (ASDPlasticMaterial_Constitutive_Integration_Method) method ;
-            INT_OPT_tangent_operator_type[tag] = (ASDPlasticMaterial_Tangent_Operator_Type) tangent ;
-            INT_OPT_f_relative_tol[tag] = f_relative_tol ;
-            INT_OPT_stress_relative_tol[tag] = stress_relative_tol ;
-            INT_OPT_n_max_iterations[tag] = n_max_iterations ;
-            INT_OPT_return_to_yield_surface[tag] = return_to_yield_surface ;
+            INT_OPT_constitutive_integration_method = (ASDPlasticMaterial_Constitutive_Integration_Method) method ;
+            INT_OPT_tangent_operator_type = (ASDPlasticMaterial_Tangent_Operator_Type) tangent ;
+            INT_OPT_f_relative_tol = f_relative_tol ;
+            INT_OPT_stress_relative_tol = stress_relative_tol ;
+            INT_OPT_n_max_iterations = n_max_iterations ;
+            INT_OPT_return_to_yield_surface = return_to_yield_surface ;
+
+            resolve_integration_options();
 
             cout << "set_constitutive_integration_method:" << endl;
             cout << "   method = " << method << endl;
@@ -819,6 +806,91 @@ public:
 
 protected:
 
+    // Copies the options of other together with the integrator and tangent
+    // operator already bound to them
+    void copy_integration_options(const ASDPlasticMaterial & other)
+    {
+        INT_OPT_constitutive_integration_method = other.INT_OPT_constitutive_integration_method;
+        INT_OPT_tangent_operator_type = other.INT_OPT_tangent_operator_type;
+        INT_OPT_f_relative_tol = other.INT_OPT_f_relative_tol;
+        INT_OPT_stress_relative_tol = other.INT_OPT_stress_relative_tol;
+        INT_OPT_n_max_iterations = other.INT_OPT_n_max_iterations;
+        INT_OPT_return_to_yield_surface = other.INT_OPT_return_to_yield_surface;
+        integrate = other.integrate;
+        compute_tangent = other.compute_tangent;
+    }
+
+    // Binds the integrator and tangent operator selected by the options to
+    // their compile-time specializations, so that setTrialStrainIncr and
+    // ComputeTangentStiffness do not branch on the options at every call.
+    void resolve_integration_options()
+    {
+        using Method = ASDPlasticMaterial_Constitutive_Integration_Method;
+        using Tangent = ASDPlasticMaterial_Tangent_Operator_Type;
+
+        switch (INT_OPT_constitutive_integration_method)
+        {
+        case Method::Not_Set :
+            integrate = &ASDPlasticMaterial::Integrate<Method::Not_Set>;
+            break;
+        case Method::Forward_Euler :
+            integrate = &ASDPlasticMaterial::Integrate<Method::Forward_Euler>;
+            break;
+        case Method::Runge_Kutta_45_Error_Control :
+            integrate = &ASDPlasticMaterial::Integrate<Method::Runge_Kutta_45_Error_Control>;
+            break;
+        case Method::Backward_Euler :
+            integrate = &ASDPlasticMaterial::Integrate<Method::Backward_Euler>;
+            break;
+        case Method::Full_Backward_Euler :
+            integrate = &ASDPlasticMaterial::Integrate<Method::Full_Backward_Euler>;
+            break;
+        default:
+            integrate = &ASDPlasticMaterial::Integrate<Method::Forward_Euler_Subincrement>;
+        }
+
+        switch (INT_OPT_tangent_operator_type)
+        {
+        case Tangent::Continuum :
+            compute_tangent = &ASDPlasticMaterial::ComputeTangentStiffness<Tangent::Continuum>;
+            break;
+        case Tangent::Secant :
+            compute_tangent = &ASDPlasticMaterial::ComputeTangentStiffness<Tangent::Secant>;
+            break;
+        case Tangent::Algorithmic :
+        case Tangent::Numerical_Algorithmic :
+            compute_tangent = &ASDPlasticMaterial::ComputeTangentStiffness<Tangent::Algorithmic>;
+            break;
+        default:
+            compute_tangent = &ASDPlasticMaterial::ComputeTangentStiffness<Tangent::Elastic>;
+        }
+    }
+
+    template <ASDPlasticMaterial_Constitutive_Integration_Method method>
+    int Integrate(const VoigtVector & strain_increment)
+    {
+        using Method = ASDPlasticMaterial_Constitutive_Integration_Method;
+
+        if constexpr (method == Method::Forward_Euler)
+            return this->Forward_Euler(strain_increment);
+        else if constexpr (method == Method::Runge_Kutta_45_Error_Control)
+            return this->Runge_Kutta_45_Error_Control(strain_increment);
+        else if constexpr (method == Method::Backward_Euler)
+            return this->Backward_Euler(strain_increment, false);
+        else if constexpr (method == Method::Full_Backward_Euler)
+            return this->Backward_Euler(strain_increment, true);
+        else if constexpr (method == Method::Not_Set)
+        {
+            cerr << "CEP::setTrialStrainIncr - Integration method not set!\n" ;
+            return -1;
+        }
+        else
+        {
+            cerr << "ASDPlasticMaterial::setTrialStrainIncr - Integration method not available!\n" ;
+            return -1;
+        }
+    }
+
     void setTrialPlastic_Strain(const VoigtVector & strain)
     {
         using namespace ASDPlasticMaterialGlobals;
@@ -872,9 +944,7 @@ private:
 
         int errorcode = -1;
 
-        static VoigtVector depsilon;
-        depsilon *= 0;
-        depsilon = strain_incr;
+        const VoigtVector depsilon = strain_incr;
 
         const VoigtVector& sigma = CommitStress;
         const VoigtVector& epsilon = CommitStrain;
@@ -1007,7 +1077,7 @@ private:
             // This algorithm is based on Crisfield(1996). Page 171. Section 6.6.3
             // After this step, the TrialStress(solution), TrialPlastic_Strain, and Stiffness will be updated to the yield surface.
             // ============================================================================================
-            if (INT_OPT_return_to_yield_surface[this->getTag()])
+            if (INT_OPT_return_to_yield_surface)
             {
                 // In the evolve function, only dLambda and m are used. Other arguments are not used at all.
                 // Make surface the internal variables are already updated. And then, return to the yield surface.
@@ -1121,9 +1191,7 @@ private:
 
         int errorcode = -1;
 
-        static VoigtVector depsilon;
-        depsilon *= 0;
-        depsilon = strain_incr;
+        const VoigtVector depsilon = strain_incr;
 
 
         iv_storage.revert_all();
@@ -1170,7 +1238,7 @@ private:
             }
 
             TrialStress = intersection_stress;
-            double T = 0.0, dT = 1.0, dT_min = 1e-3, TolE = this->INT_OPT_stress_relative_tol[this->getTag()];
+            double T = 0.0, dT = 1.0, dT_min = 1e-3, TolE = this->INT_OPT_stress_relative_tol;
 
 
             VoigtVector next_Sigma = TrialStress;
@@ -1391,7 +1459,7 @@ private:
             // This algorithm is based on Crisfield(1996). Page 171. Section 6.6.3
             // After this step, the TrialStress(solution), TrialPlastic_Strain, and Stiffness will be updated to the yield surface.
             // ============================================================================================
-            if (INT_OPT_return_to_yield_surface[this->getTag()])
+            if (INT_OPT_return_to_yield_surface)
             {
                 // In the evolve function, only dLambda and m are used. Other arguments are not used at all.
                 // Make surface the internal variables are already updated. And then, return to the yield surface.
@@ -1438,1048 +1506,301 @@ private:
         return 0;
     }
 
-    // int Backward_Euler(const VoigtVector &strain_incr, bool debugrun = false, int NSteps = 1)
-    // {
-    //     using namespace ASDPlasticMaterialGlobals;
-    //     int errorcode = 0;
-    //     // // =====Sub-increments =====
-    //     // // Problem is in the stiffness
-    //     // double max_comp = Max_abs_Component(strain_incr)/ (double)NSteps;
-    //     // double allowed_increment_magnitude = 1E-5;
-    //     // if(max_comp > allowed_increment_magnitude){
-    //     //     int required_Nstep = (int)(max_comp/ allowed_increment_magnitude)+1 ;
-    //     //     Backward_Euler(strain_incr, false, required_Nstep);
-    //     //     return 0;
-    //     // }
-    //     // // =====Sub-increments =====END
-    //     internal_variables.revert();
-    //     internal_variables.commit_tmp();
-    //     static VoigtVector depsilon(3, 3, 0);
-    //     static VoigtVector PredictorStress(3, 3, 0);
-    //     const VoigtVector& sigma = CommitStress;
-    //     depsilon(i, j) = strain_incr(i, j) / NSteps;
-    //     TrialStress(i, j) = sigma(i, j);
-    //     TrialStrain(i, j) = CommitStrain(i, j) + depsilon(i, j);
-    //     TrialPlastic_Strain(i, j) = CommitPlastic_Strain(i, j);
-
-    //     // Uncomment next line to enable the subincrement in Backward_Euler.
-    //     // for (int step = 0; step < NSteps; step++)
-    //     {
-    //         VoigtMatrix& Eelastic = et(sigma);
-    //         Stiffness(i, j, k, l) = Eelastic(i, j, k, l);
-
-    //         dsigma(i, j) = Eelastic(i, j, k, l) * depsilon(k, l);
-
-    //         TrialStress(i, j) +=  dsigma(i, j);
-    //         PredictorStress(i, j) = TrialStress(i, j);
-
-    //         double yf_val_start = yf(sigma);
-    //         double yf_val_end = yf(PredictorStress);
-
-    //         // printTensor (" CommitStress       " , CommitStress);
-    //         // printTensor (" depsilon           " , depsilon);
-    //         // printTensor (" dsigma             " , dsigma);
-    //         // printTensor (" PredictorStress    " , PredictorStress);
-    //         // cout <<      " yf_val_start        = " << yf_val_start << endl;
-    //         // cout <<      " yf_val_end          = " << yf_val_end << endl;
-    //         // printTensor (" TrialStress        " , TrialStress);
-
-    //         if ((yf_val_start <= 0.0 && yf_val_end <= 0.0) || yf_val_start > yf_val_end) //Elasticity
-    //         {
-    //             VoigtMatrix& Eelastic = et(TrialStress);
-    //             Stiffness(i, j, k, l) = Eelastic(i, j, k, l);
-    //         }
-    //         else  //Plasticity
-    //         {
-    //             static VoigtVector ResidualStress(3, 3, 0);
-    //             static VoigtVector TrialStress_prev(3, 3, 0);
-    //             ResidualStress *= 0;
-    //             TrialStress_prev *= 0;
-    //             double normResidualStress = -1;
-    //             double stress_relative_error = this->stress_relative_tol * 10; //
-    //             double dLambda = 0;
-    //             double denominator = 0;
-    //             int iteration_count = 0;
-
-    //             double yf_PredictorStress = yf(PredictorStress);
-    //             double yf_TrialStress = yf(TrialStress);
-
-    //             // vonMises does NOT enter this part.
-    //             // DruckerPrager requries this part.
-    //             if (yf.hasCorner() && yf.in_Apex(PredictorStress))
-    //             {
-    //                 static VoigtVector small_stress(3, 3, 0.0);
-    //                 small_stress *= 0;
-    //                 // The small value 50*Pa refers to the lowest confinement test:
-    //                 // http://science.nasa.gov/science-news/science-at-nasa/1998/msad27may98_2/
-    //                 double DP_k = yf.get_k();
-    //                 double DP_p = 50 ;
-    //                 // To make it on the yield surface, the q is equal to k*p.
-    //                 double DP_q = DP_k * DP_p ;
-    //                 // Assume the triaxial conditions sigma_2 = sigma_3.
-    //                 small_stress(0, 0) = DP_p + 2. / 3.0 * DP_q;
-    //                 small_stress(1, 1) = DP_p - 1. / 3.0 * DP_q;
-    //                 small_stress(2, 2) = DP_p - 1. / 3.0 * DP_q;
-
-    //                 // (1) Update the trial stress
-    //                 TrialStress(i, j) = small_stress(i, j);
-    //                 // (2) Update the trial plastic strain
-    //                 const VoigtVector& n = yf.df_dsigma_ij(small_stress);
-    //                 const VoigtVector& m = pf(depsilon, small_stress);
-    //                 const double xi_star_h_star = yf.xi_star_h_star( depsilon, m,  small_stress);
-    //                 double denominator = n(p, q) * Eelastic(p, q, r, s) * m(r, s) - xi_star_h_star;
-    //                 double dLambda = yf_PredictorStress / denominator;
-    //                 TrialPlastic_Strain(i, j) += dLambda * m(i, j);
-    //                 // (3) Update the internal variables
-    //                 internal_variables.evolve(dLambda, depsilon, m, TrialStress);
-    //                 internal_variables.commit_tmp();
-    //                 // (4) Update the stiffness.
-    //                 // Backward_Euler use the inconsistent stiffness.
-    //                 // Full_Backward_Euler use the consistent stiffness.
-    //                 Stiffness(i, j, k, l) = Eelastic(i, j, k, l) - (Eelastic(i, j, p, q) * m(p, q)) * (n(r, s) * Eelastic(r, s, k, l) ) / denominator;
-
-    //                 // // ===================================================================
-    //                 // // Working on consistent stiffness
-    //                 // // ===================================================================
-    //                 // // Construct the Tensor T
-    //                 static VoigtMatrix IdentityTensor4(3, 3, 3, 3, 0);
-    //                 IdentityTensor4(i, j, k, l) = kronecker_delta(i, j) * kronecker_delta(k, l);
-
-    //                 static VoigtMatrix dm_dsigma(3, 3, 3, 3, 0.0);
-    //                 dm_dsigma = pf.dm_over_dsigma(TrialStress);
-    //                 static VoigtMatrix Ts(3, 3, 3, 3, 0.0);
-    //                 Ts(i, j, k, l) = IdentityTensor4(i, k, j, l) + dLambda * Eelastic(i, j, p, q) * dm_dsigma(p, q, k, l);
-
-    //                 // // ===================================================================
-    //                 // // Construct the Tensor H
-    //                 static VoigtVector dm_dq_star_h_star(3, 3, 0.0);
-    //                 dm_dq_star_h_star = pf.dm_over_dq_start_h_star(depsilon, m, TrialStress);
-    //                 static VoigtVector H(3, 3, 0.0);
-    //                 H(k, l) = m(k, l) + dLambda * dm_dq_star_h_star(k, l);
-
-    //                 static VoigtMatrix invT(3, 3, 3, 3, 0.0);
-    //                 // // If cannot inverse T, return directly with the inconsistent stiffness tensor.
-    //                 if ( !inverse4thTensor(Ts, invT) )
-    //                 {
-    //                     return 0;
-    //                 }
-    //                 static VoigtMatrix R(3, 3, 3, 3, 0.0);
-    //                 R(p, q, r, s) = invT(k, l, p, q) * Eelastic(k, l, r, s);
-
-    //                 // // ===================================================================
-    //                 // // Construct the consistent stiffness
-    //                 double denomin{0.0};
-    //                 denomin = n(p, q) * R(p, q, r, s) * H(r, s) - xi_star_h_star ;
-    //                 Stiffness(i, j, k, l) = R(i, j, k, l) - ((R(i, j, p, q) * H(p, q)) * (n(r, s) * R(r, s, k, l))) / denomin;
-    //                 // // ===================================================================
-    //                 // // consistent stiffness  END
-    //                 // // ===================================================================
-
-    //                 // Skip the following iteration procedures.
-    //                 return 0;
-    //             }
-
-    //             double f_relative_error = this->f_relative_tol * 10;
-
-    //             while ((stress_relative_error > this-> stress_relative_tol ||
-    //                     f_relative_error > this->f_relative_tol) &&
-    //                     iteration_count < this->n_max_iterations
-    //                   )
-    //             {
-    //                 iteration_count++;
-    //                 // In this approach, we always start from
-    //                 // PredictorStress and the initial committed internal variables.
-    //                 internal_variables.revert_tmp();
-
-    //                 const VoigtVector& n = yf.df_dsigma_ij(TrialStress);
-    //                 const VoigtVector& m = pf(depsilon, TrialStress);
-    //                 double xi_star_h_star = yf.xi_star_h_star( depsilon, m,  TrialStress);
-    //                 denominator = n(p, q) * Eelastic(p, q, r, s) * m(r, s) - xi_star_h_star;
-
-    //                 //Compute the plastic multiplier
-    //                 // if (abs(denominator) < MACHINE_EPSILON)
-    //                 // {
-    //                 //     cout << "CEP - denominator of plastic multiplier n(p, q) * Eelastic(p, q, r, s) * m(r, s) - xi_star_h_star = 0\n";
-    //                 //     printTensor("m", m);
-    //                 //     printTensor("n", n);
-    //                 //     cout << "xi_star_h_star" << xi_star_h_star << endl;
-    //                 //     cout << "denominator" << denominator << endl;
-    //                 //     printTensor("depsilon", depsilon);
-    //                 //     return -1;
-    //                 // }
-    //                 dLambda =  yf_PredictorStress / denominator;
-
-    //                 TrialStress_prev(i, j) = TrialStress(i, j);
-
-    //                 TrialStress(i, j) = PredictorStress(i, j) - dLambda * Eelastic(i, j, k, l) * m(k, l);
-    //                 internal_variables.evolve(dLambda, depsilon, m, TrialStress);
-    //                 // // ============================================================
-    //                 // // Line search in the constitutive level
-    //                 // // ============================================================
-    //                 double subdLambda = dLambda;
-    //                 while (yf(TrialStress) > yf_PredictorStress && subdLambda > MACHINE_EPSILON * 10)
-    //                 {
-    //                     internal_variables.revert_tmp();
-    //                     subdLambda *= 0.5;
-    //                     TrialStress(i, j) = PredictorStress(i, j) - subdLambda * Eelastic(i, j, k, l) * m(k, l);
-    //                     // Internal variable should be updated with subdLambda.
-    //                     // The condition in while-loop will use the internal variables.
-    //                     internal_variables.evolve(subdLambda, depsilon, m, TrialStress);
-    //                 }
-    //                 // ============================================================
-    //                 dLambda = subdLambda ;
-    //                 yf_TrialStress = yf(TrialStress);
-
-    //                 ResidualStress(i, j) = TrialStress(i, j) - TrialStress_prev(i, j);
-
-    //                 normResidualStress = sqrt(ResidualStress(i, j) * ResidualStress(i, j));
-
-    //                 // update the stress and f relative error.
-    //                 stress_relative_error = normResidualStress / sqrt(TrialStress(i, j) * TrialStress(i, j));
-    //                 f_relative_error = abs(yf_TrialStress / yf_PredictorStress);
-
-    //                 double norm_trial_stress = TrialStress(i, j) * TrialStress(i, j);
-    //                 if (norm_trial_stress != norm_trial_stress || debugrun) //check for nan
-    //                 {
-    //                     cout << "=============================================================" << endl;
-    //                     cout << "\nIteration # " << iteration_count <<  endl;
-    //                     printTensor (" CommitStress       " , CommitStress);
-    //                     double p, q, theta;
-    //                     std::tie(p, q, theta) = getpqtheta(CommitStress);
-    //                     fprintf(stderr, "CommitStress_p    = %16.8f\n"  , p );
-    //                     fprintf(stderr, "CommitStress_q    = %16.8f\n"  , q );
-    //                     fprintf(stderr, "CommitStress_theta= %16.8f\n"  , theta );
-    //                     printTensor (" depsilon           " , depsilon);
-    //                     printTensor (" dsigma             " , dsigma);
-    //                     printTensor (" PredictorStress    " , PredictorStress);
-    //                     std::tie(p, q, theta) = getpqtheta(PredictorStress);
-    //                     fprintf(stderr, "PredictorStress_p    = %16.8f\n"  , p );
-    //                     fprintf(stderr, "PredictorStress_q    = %16.8f\n"  , q );
-    //                     fprintf(stderr, "PredictorStress_theta= %16.8f\n"  , theta );
-    //                     cout <<      " yf_val_start        = " << yf_val_start << endl;
-    //                     cout <<      " yf_val_end          = " << yf_val_end << endl;
-    //                     printTensor (" n                  " , n );
-    //                     printTensor (" m                  " , m );
-    //                     cout <<      " xi_star_h_star      = " << xi_star_h_star << endl;
-    //                     cout <<      " denominator         = " << denominator << endl;
-    //                     cout <<      " dLambda             = " << dLambda << endl;
-    //                     printTensor (" TrialStress        " , TrialStress);
-    //                     std::tie(p, q, theta) = getpqtheta(TrialStress);
-    //                     fprintf(stderr, "TrialStress_p    = %16.8f\n"  , p );
-    //                     fprintf(stderr, "TrialStress_q    = %16.8f\n"  , q );
-    //                     fprintf(stderr, "TrialStress_theta= %16.8f\n"  , theta );
-
-    //                     printTensor (" TrialStress_prev   " , TrialStress_prev);
-    //                     std::tie(p, q, theta) = getpqtheta(TrialStress_prev);
-    //                     fprintf(stderr, "TrialStress_prev_p    = %16.8f\n"  , p );
-    //                     fprintf(stderr, "TrialStress_prev_q    = %16.8f\n"  , q );
-    //                     fprintf(stderr, "TrialStress_prev_theta= %16.8f\n"  , theta );
-
-    //                     printTensor (" ResidualStress     " , ResidualStress );
-    //                     cout <<      " normResidualStress  = " << normResidualStress << endl;
-    //                     cout <<      " stress_relative_error      = " << stress_relative_error << endl;
-    //                     cout <<      " f_relative_error      = " << f_relative_error << endl;
-    //                     cout <<      " iteration_count     = " << iteration_count << endl;
-    //                     cout <<      " .........................................................." << endl;
-    //                     cout <<      "  Internal variables:" << endl;
-    //                     printTensor (" back_stress (alpha)      " , yf.get_alpha() );
-    //                     cout <<      " DP_k or VM_radius      " << yf.get_k() << endl;
-    //                     cout << "back_stress(0,1) = " << (yf.get_alpha())(0, 1) << endl ;
-    //                     cout << "PredictorStress(0,1) = " << PredictorStress(0, 1) << endl ;
-    //                     cout << "===============================================END===========" << endl;
-    //                     cout << endl << endl;
-    //                 }
-
-    //             } // while for el-pl this step
-
-    //             //Update the trial plastic strain.
-    //             const VoigtVector& n = yf.df_dsigma_ij(TrialStress);
-    //             const VoigtVector& m = pf(depsilon, TrialStress);
-    //             const double xi_star_h_star = yf.xi_star_h_star( depsilon, m,  TrialStress);
-
-    //             denominator = n(p, q) * Eelastic(p, q, r, s) * m(r, s) - xi_star_h_star;
-    //             TrialPlastic_Strain(i, j) += dLambda * m(i, j);
-    //             internal_variables.commit_tmp();
-
-    //             Stiffness(i, j, k, l) = Eelastic(i, j, k, l) - (Eelastic(i, j, p, q) * m(p, q)) * (n(r, s) * Eelastic(r, s, k, l) ) / denominator;
-
-    //             // ===================================================================
-    //             // Working on consistent stiffness
-    //             // ===================================================================
-    //             // Update the m and n:
-    //             static VoigtVector nf(3, 3, 0.0);
-    //             nf = yf.df_dsigma_ij(TrialStress);
-    //             static VoigtVector mf(3, 3, 0.0);
-    //             mf = pf(depsilon, TrialStress);
-    //             // Construct the Tensor T
-    //             static VoigtMatrix IdentityTensor4(3, 3, 3, 3, 0);
-    //             IdentityTensor4(i, j, k, l) = kronecker_delta(i, j) * kronecker_delta(k, l);
-
-    //             static VoigtMatrix dm_dsigma(3, 3, 3, 3, 0.0);
-    //             dm_dsigma = pf.dm_over_dsigma(TrialStress);
-    //             static VoigtMatrix Ts(3, 3, 3, 3, 0.0);
-    //             Ts(i, j, k, l) = IdentityTensor4(i, k, j, l) + dLambda * Eelastic(i, j, p, q) * dm_dsigma(p, q, k, l);
-
-    //             // ===================================================================
-    //             // Construct the Tensor H
-    //             static VoigtVector dm_dq_star_h_star(3, 3, 0.0);
-    //             dm_dq_star_h_star = pf.dm_over_dq_start_h_star(depsilon, mf, TrialStress);
-    //             static VoigtVector H(3, 3, 0.0);
-    //             H(k, l) = mf(k, l) + dLambda * dm_dq_star_h_star(k, l);
-
-    //             static VoigtMatrix invT(3, 3, 3, 3, 0.0);
-    //             // If cannot inverse T, return directly.
-    //             // So "Stiffness" is the inconsistent stiffness tensor.
-    //             if ( !inverse4thTensor(Ts, invT) )
-    //             {
-    //                 return 0;
-    //             }
-    //             static VoigtMatrix R(3, 3, 3, 3, 0.0);
-    //             R(p, q, r, s) = invT(k, l, p, q) * Eelastic(k, l, r, s);
+    // Implicit backward Euler (closest-point projection) return mapping.
+    // The unknowns x = [sigma, q, dLambda] solve
+    //
+    //     r_sigma = sigma - sigma_pred + dLambda * E * m(sigma, q)  = 0
+    //     r_q     = q - q_n - dLambda * h(sigma, q)                 = 0
+    //     r_f     = f(sigma, q)                                     = 0
+    //
+    // Yield functions, flow directions and hardening laws of this family do
+    // not provide second derivatives, so the Jacobian of the residual is built
+    // by forward differences. Only sigma_pred depends on the strain, hence the
+    // algorithmic tangent is the stress block of J^-1 [E; 0; 0].
+    //
+    // If Newton fails on the whole increment it is retried on 2, 4, ...
+    // sub-increments, in which case the continuum tangent is returned.
+    int Backward_Euler(const VoigtVector & strain_incr, bool consistent_tangent)
+    {
+        using namespace ASDPlasticMaterialGlobals;
 
-    //             // ===================================================================
-    //             // Construct the consistent stiffness
-    //             double denomin{0.0};
-    //             double const& xi_star_h_star_f = yf.xi_star_h_star( depsilon, mf,  TrialStress);
-    //             denomin = nf(p, q) * R(p, q, r, s) * H(r, s) - xi_star_h_star_f ;
+        constexpr int max_subincrements = 64;
 
-    //             Stiffness(i, j, k, l) = R(i, j, k, l) - ((R(i, j, p, q) * H(p, q)) * (nf(r, s) * R(r, s, k, l))) / denomin;
+        ASDPlasticMaterial_Tangent_Operator_Type tangent_type = INT_OPT_tangent_operator_type;
+        consistent_tangent = consistent_tangent
+                             || tangent_type == ASDPlasticMaterial_Tangent_Operator_Type::Algorithmic
+                             || tangent_type == ASDPlasticMaterial_Tangent_Operator_Type::Numerical_Algorithmic;
 
-    //             // ===================================================================
-    //             // Working on consistent stiffness  END
-    //             // ===================================================================
+        const VoigtVector depsilon = strain_incr;
+        depsilon_elpl = strain_incr;
 
-    //         } //else  //Plasticity
-    //         internal_variables.commit_tmp();
-    //     } //End the loop for (int step = 0; step < NSteps; step++)
-    //     return errorcode;
-    // }
+        TrialStrain = CommitStrain + depsilon;
 
-    // int Backward_Euler_ddlambda(const VoigtVector &strain_incr, bool debugrun = false)
-    // {
-    //     using namespace ASDPlasticMaterialGlobals;
-    //     int errorcode = 0;
+        for (int nsub = 1; nsub <= max_subincrements; nsub *= 2)
+        {
+            iv_storage.revert_all();
+            TrialStress = CommitStress;
+            TrialPlastic_Strain = CommitPlastic_Strain;
+
+            VoigtVector dEPS = depsilon / nsub;
+            bool plastic = false;
+            int status = 0;
+            for (int step = 0; step < nsub && status >= 0; ++step)
+            {
+                status = Backward_Euler_Step(dEPS, consistent_tangent && nsub == 1);
+                plastic = plastic || status == 1;
+            }
 
-    //     internal_variables.revert();
-    //     internal_variables.commit_tmp();
-    //     static VoigtVector depsilon(3, 3, 0);
-    //     static VoigtVector PredictorStress(3, 3, 0);
-    //     const VoigtVector& sigma = CommitStress;
-    //     depsilon(i, j) = strain_incr(i, j) ;
-    //     TrialStress(i, j) = sigma(i, j);
-    //     TrialStrain(i, j) = CommitStrain(i, j) + depsilon(i, j);
-    //     TrialPlastic_Strain(i, j) = CommitPlastic_Strain(i, j);
+            if (status < 0)
+                continue;
 
-    //     VoigtMatrix& Eelastic = et(sigma);
-    //     Stiffness(i, j, k, l) = Eelastic(i, j, k, l);
+            if (plastic && !(consistent_tangent && nsub == 1))
+            {
+                if (consistent_tangent)
+                    Stiffness = Continuum_Stiffness();
+                else
+                    ComputeTangentStiffness();
+            }
 
-    //     dsigma(i, j) = Eelastic(i, j, k, l) * depsilon(k, l);
+            return 0;
+        }
 
-    //     TrialStress(i, j) +=  dsigma(i, j);
-    //     PredictorStress(i, j) = TrialStress(i, j);
+        cerr << "ASDPlasticMaterial::Backward_Euler - Newton iterations did not converge after "
+             << max_subincrements << " sub-increments\n";
+        printTensor("CommitStress = " , CommitStress);
+        printTensor("depsilon = " , depsilon);
 
-    //     double yf_val_start = yf(sigma);
-    //     double yf_val_end = yf(PredictorStress);
+        iv_storage.revert_all();
+        TrialStress = CommitStress;
+        TrialPlastic_Strain = CommitPlastic_Strain;
 
-    //     // printTensor (" CommitStress       " , CommitStress);
-    //     // printTensor (" depsilon           " , depsilon);
-    //     // printTensor (" dsigma             " , dsigma);
-    //     // printTensor (" PredictorStress    " , PredictorStress);
-    //     // cout <<      " yf_val_start        = " << yf_val_start << endl;
-    //     // cout <<      " yf_val_end          = " << yf_val_end << endl;
-    //     // printTensor (" TrialStress        " , TrialStress);
+        return -1;
+    }
 
-    //     if ((yf_val_start <= 0.0 && yf_val_end <= 0.0) || yf_val_start > yf_val_end) //Elasticity
-    //     {
-    //         VoigtMatrix& Eelastic = et(TrialStress);
-    //         Stiffness(i, j, k, l) = Eelastic(i, j, k, l);
-    //     }
-    //     else  //Plasticity
-    //     {
-    //         static VoigtVector ResidualStress(3, 3, 0);
-    //         static VoigtVector TrialStress_prev(3, 3, 0);
-    //         ResidualStress *= 0;
-    //         TrialStress_prev *= 0;
-    //         double normResidualStress = -1;
-    //         double stress_relative_error = this->stress_relative_tol * 10; //
-    //         double dLambda = 0;
-    //         double denominator = 0;
-    //         int iteration_count = 0;
-
-    //         double yf_PredictorStress = yf(PredictorStress);
-    //         double yf_TrialStress = yf(TrialStress);
-    //         // vonMises does NOT enter this part.
-    //         // DruckerPrager requries this part.
-    //         if (yf.hasCorner() && yf.in_Apex(PredictorStress))
-    //         {
-    //             static VoigtVector small_stress(3, 3, 0.0);
-    //             small_stress *= 0;
-    //             // The small value 50*Pa refers to the lowest confinement test:
-    //             // http://science.nasa.gov/science-news/science-at-nasa/1998/msad27may98_2/
-    //             double DP_k = yf.get_k();
-    //             double DP_p = 50 ;
-    //             // To make it on the yield surface, the q is equal to k*p.
-    //             double DP_q = DP_k * DP_p ;
-    //             // Assume the triaxial conditions sigma_2 = sigma_3.
-    //             small_stress(0, 0) = DP_p + 2. / 3.0 * DP_q;
-    //             small_stress(1, 1) = DP_p - 1. / 3.0 * DP_q;
-    //             small_stress(2, 2) = DP_p - 1. / 3.0 * DP_q;
-
-    //             // (1) Update the trial stress
-    //             TrialStress(i, j) = small_stress(i, j);
-    //             // (2) Update the trial plastic strain
-    //             const VoigtVector& n = yf.df_dsigma_ij(small_stress);
-    //             const VoigtVector& m = pf(depsilon, small_stress);
-    //             const double xi_star_h_star = yf.xi_star_h_star( depsilon, m,  small_stress);
-    //             double denominator = n(p, q) * Eelastic(p, q, r, s) * m(r, s) - xi_star_h_star;
-    //             double dLambda = yf_PredictorStress / denominator;
-    //             TrialPlastic_Strain(i, j) += dLambda * m(i, j);
-    //             // (3) Update the internal variables
-    //             internal_variables.evolve(dLambda, depsilon, m, TrialStress);
-    //             internal_variables.commit_tmp();
-    //             // (4) Update the stiffness.
-    //             Stiffness(i, j, k, l) = Eelastic(i, j, k, l) - (Eelastic(i, j, p, q) * m(p, q)) * (n(r, s) * Eelastic(r, s, k, l) ) / denominator;
-
-    //             // // =========================================================
-    //             // // Working on consistent stiffness
-    //             // // ========================================================
-    //             // // Construct the Tensor T
-    //             static VoigtMatrix IdentityTensor4(3, 3, 3, 3, 0);
-    //             IdentityTensor4(i, j, k, l) = kronecker_delta(i, j) * kronecker_delta(k, l);
-
-    //             static VoigtMatrix dm_dsigma(3, 3, 3, 3, 0.0);
-    //             dm_dsigma = pf.dm_over_dsigma(TrialStress);
-    //             static VoigtMatrix Ts(3, 3, 3, 3, 0.0);
-    //             Ts(i, j, k, l) = IdentityTensor4(i, k, j, l) + dLambda * Eelastic(i, j, p, q) * dm_dsigma(p, q, k, l);
-
-    //             // // Construct the Tensor H
-    //             static VoigtVector dm_dq_star_h_star(3, 3, 0.0);
-    //             dm_dq_star_h_star = pf.dm_over_dq_start_h_star(depsilon, m, TrialStress);
-    //             static VoigtVector H(3, 3, 0.0);
-    //             H(k, l) = m(k, l) + dLambda * dm_dq_star_h_star(k, l);
-
-    //             static VoigtMatrix invT(3, 3, 3, 3, 0.0);
-    //             // // If cannot inverse T, return directly with the inconsistent stiffness tensor.
-    //             if ( !inverse4thTensor(Ts, invT) )
-    //             {
-    //                 return 0;
-    //             }
-    //             static VoigtMatrix R(3, 3, 3, 3, 0.0);
-    //             R(p, q, r, s) = invT(k, l, p, q) * Eelastic(k, l, r, s);
+    // One backward Euler step of size dEPS from the current trial state.
+    // Returns 0 for an elastic step, 1 for a converged plastic step and -1 if
+    // the Newton iterations fail. On return the trial state holds the result.
+    int Backward_Euler_Step(const VoigtVector & dEPS, bool algorithmic_tangent)
+    {
+        using namespace ASDPlasticMaterialGlobals;
 
-    //             // // =======================================================
-    //             // // Construct the consistent stiffness
-    //             double denomin{0.0};
-    //             denomin = n(p, q) * R(p, q, r, s) * H(r, s) - xi_star_h_star ;
-    //             Stiffness(i, j, k, l) = R(i, j, k, l) - ((R(i, j, p, q) * H(p, q)) * (n(r, s) * R(r, s, k, l))) / denomin;
+        constexpr int max_line_search = 8;
 
-    //             // // =====================================================
-    //             // // Working on consistent stiffness  END
-    //             // // =====================================================
+        VoigtMatrix Eelastic = et(TrialStress, parameters_storage);
 
-    //             // skip the following iteration
-    //             return 0;
-    //         }//END yield surface APEX check
+        VoigtVector sigma_pred;
+        sigma_pred = TrialStress + Eelastic * dEPS;
 
-    //         double f_relative_error = this->f_relative_tol * 10;
+        double yf_pred = yf(sigma_pred, iv_storage, parameters_storage);
+        if (yf_pred <= 0.0)
+        {
+            TrialStress = sigma_pred;
+            Stiffness = Eelastic;
+            return 0;
+        }
 
-    //         while ((stress_relative_error > this-> stress_relative_tol ||
-    //                 f_relative_error > this->f_relative_tol) &&
-    //                 iteration_count < this->n_max_iterations
-    //               )
-    //         {
-    //             iteration_count++;
-    //             internal_variables.revert_tmp();
+        constexpr int n_iv = n_iv_components;
+        constexpr int n = n_backward_euler;
 
-    //             const VoigtVector& n = yf.df_dsigma_ij(TrialStress);
-    //             const VoigtVector& m = pf(depsilon, TrialStress);
-    //             double xi_star_h_star = yf.xi_star_h_star( depsilon, m,  TrialStress);
-    //             denominator = n(p, q) * Eelastic(p, q, r, s) * m(r, s) - xi_star_h_star;
-    //             if (abs(denominator) < MACHINE_EPSILON)
-    //             {
-    //                 cout << "CEP - denominator of plastic multiplier  \
-    //                            n(p, q) * Eelastic(p, q, r, s) * m(r, s) - xi_star_h_star = 0\n";
-    //                 printTensor("m", m);
-    //                 printTensor("n", n);
-    //                 cout << "xi_star_h_star" << xi_star_h_star << endl;
-    //                 cout << "denominator" << denominator << endl;
-    //                 printTensor("depsilon", depsilon);
-    //                 return -1;
-    //             }
-    //             // The first dLambda is based on the elastic predictor. The next dLambda's are updated by ddlambda
-    //             TrialStress_prev(i, j) = TrialStress(i, j);
-
-    //             dLambda =  yf_PredictorStress / denominator;
-    //             TrialStress(i, j) = TrialStress(i, j) - dLambda * Eelastic(i, j, k, l) * m(k, l);
-    //             internal_variables.evolve(dLambda, depsilon, m, TrialStress);
-
-    //             // In the first step, TrialStress is the predictor stress.
-    //             // =======Line Search ====
-    //             // // Zeta is the cooefficent for line search.
-    //             double subdLambda = dLambda;
-    //             while (yf(TrialStress) > yf_PredictorStress && subdLambda > MACHINE_EPSILON * 10)
-    //             {
-    //                 internal_variables.revert_tmp();
-    //                 subdLambda *= 0.5;
-    //                 TrialStress(i, j) = PredictorStress(i, j) - subdLambda * Eelastic(i, j, k, l) * m(k, l);
-    //                 // update the internal variables with subdLambda and commit to update yield surface.
-    //                 internal_variables.evolve(subdLambda, depsilon, m, TrialStress);
-    //             }
-    //             dLambda = subdLambda;
-    //             ResidualStress(i, j) =  TrialStress(i, j) - TrialStress_prev(i, j);
-    //             // ==========================================
-    //             // Works to calculate the ddlambda
-    //             // ==========================================
-    //             // Update the m and n:
-    //             static VoigtVector n_new(3, 3, 0.0);
-    //             n_new = yf.df_dsigma_ij(TrialStress);
-    //             static VoigtVector m_new(3, 3, 0.0);
-    //             m_new = pf(depsilon, TrialStress);
-    //             // Construct the Tensor T
-    //             static VoigtMatrix IdentityTensor4(3, 3, 3, 3, 0.0);
-    //             IdentityTensor4(i, j, k, l) = kronecker_delta(i, j) * kronecker_delta(k, l);
-
-    //             static VoigtMatrix dm_dsigma(3, 3, 3, 3, 0.0);
-    //             dm_dsigma = pf.dm_over_dsigma(TrialStress);
-    //             static VoigtMatrix T_new(3, 3, 3, 3, 0.0);
-    //             T_new(i, j, k, l) = IdentityTensor4(i, k, j, l) + dLambda * Eelastic(i, j, p, q) * dm_dsigma(p, q, k, l);
-
-    //             static VoigtMatrix invTnew(3, 3, 3, 3, 0.0);
-    //             if ( !inverse4thTensor(T_new, invTnew) )
-    //             {
-    //                 // cout<<"Singularity. Cannot inverse tensor T! "<<endl;
-    //                 return 0;
-    //             }
+        iv_vector_t q_n;
+        be_vector_t x, x_trial, dx, r, r_trial;
+        be_matrix_t J;
 
-    //             static VoigtVector dm_dq_star_h_star(3, 3, 0.0);
-    //             dm_dq_star_h_star = pf.dm_over_dq_start_h_star(depsilon, m_new, TrialStress);
-    //             static VoigtVector H_new(3, 3, 0.0);
-    //             H_new(k, l) = m_new(k, l) + dLambda * dm_dq_star_h_star(k, l);
+        getInternalVariableComponents(q_n, 0);
 
-    //             double const& xi_star_h_star_new = yf.xi_star_h_star( depsilon, m_new,  TrialStress);
+        // Initial guess: predictor stress, start-of-step internal variables
+        // and the multiplier of a forward Euler step from the predictor.
+        for (int i = 0; i < 6; ++i)
+            x(i) = sigma_pred(i);
+        x.segment(6, n_iv) = q_n;
+        {
+            VoigtVector n0 = yf.df_dsigma_ij(sigma_pred, iv_storage, parameters_storage);
+            VoigtVector m0 = pf(dEPS, sigma_pred, iv_storage, parameters_storage);
+            double xi_star_h_star = yf.xi_star_h_star(dEPS, m0, sigma_pred, iv_storage, parameters_storage);
+            double den = n0.transpose() * Eelastic * m0 - xi_star_h_star;
+            x(n - 1) = den > 0 ? yf_pred / den : 0.0;
+        }
 
-    //             double denomina_ddlambda = 0.0;
-    //             static VoigtVector E_times_H (3, 3, 0.0);
-    //             Eelastic = et(TrialStress);
-    //             E_times_H(i, j) = Eelastic(i, j, k, l) * H_new(k, l);
-    //             denomina_ddlambda = n_new(r, s) * (E_times_H(p, q) * invTnew(p, q, r, s)) - xi_star_h_star_new ;
-    //             double numerator_ddlambda = 0.0;
-    //             numerator_ddlambda = yf(TrialStress) - n_new(r, s) * (ResidualStress(i, j) * invTnew(i, j, r, s)) ;
-    //             double ddlambda =   numerator_ddlambda / denomina_ddlambda ;
-    //             static VoigtVector dSigma_(3, 3, 0.0);
-    //             dSigma_(r, s) = -
-    //                             (
-    //                                 ResidualStress(i, j) + ddlambda * Eelastic(i, j, p, q) * H_new(p, q)
-    //                             )
-    //                             * invTnew(i, j, r, s) ;
-    //             TrialStress_prev(i, j) = TrialStress(i, j) ;
-    //             TrialStress(i, j) =  TrialStress(i, j) + dSigma_(i, j) ;
-    //             double yf_TrialStress_prev = yf(TrialStress_prev) ;
-    //             internal_variables.evolve(ddlambda, depsilon, m_new, TrialStress);
-
-    //             // =======Line Search ddlambda (double delta ) =======
-    //             double subddlambda = ddlambda;
-    //             double zeta = 1.0;
-    //             while (yf(TrialStress) > yf_TrialStress_prev && subddlambda > MACHINE_EPSILON * 10)
-    //             {
-    //                 internal_variables.revert_tmp();
-    //                 subddlambda *= 0.5 ;
-    //                 zeta *= 0.5 ;
-    //                 TrialStress(i, j) = TrialStress(i, j) + zeta * dSigma_(i, j) ;
-    //                 // Internal variable should be updated with subddlambda.
-    //                 // The condition in while-loop will use the internal variables.
-    //                 internal_variables.evolve(subddlambda, depsilon, m, TrialStress);
-    //             }
+        // Residual norms relative to the tolerances, converged when <= 1
+        double sigma_ref = sigma_pred.norm();
+        double q_ref = fmax(q_n.norm(), 1.0);
+        double f_ref = yf_pred;
+        double stol = INT_OPT_stress_relative_tol;
+        double ftol = INT_OPT_f_relative_tol;
+        if (sigma_ref == 0)
+            sigma_ref = 1.0;
 
-    //             dLambda = dLambda + subddlambda ;
+        auto error = [&](const be_vector_t & res)
+        {
+            double e = res.head(6).norm() / (sigma_ref * stol);
+            if (n_iv > 0)
+                e = fmax(e, res.segment(6, n_iv).norm() / (q_ref * stol));
+            return fmax(e, abs(res(n - 1)) / (f_ref * ftol));
+        };
 
-    //             yf_TrialStress = yf(TrialStress);
+        Backward_Euler_Residual(x, sigma_pred, q_n, Eelastic, dEPS, r);
+        double err = error(r);
 
-    //             ResidualStress(i, j) = TrialStress(i, j) - TrialStress_prev(i, j);
+        int iter = 0;
+        int max_iter = INT_OPT_n_max_iterations;
+        while (!(err <= 1.0) && iter < max_iter)
+        {
+            Backward_Euler_Jacobian(x, sigma_pred, q_n, Eelastic, dEPS, sigma_ref, q_ref, r, J);
+            dx = J.partialPivLu().solve(-r);
+            if (!dx.allFinite())
+                break;
+
+            // Backtracking on the residual norm
+            double alpha = 1.0;
+            double err_trial = err;
+            for (int ls = 0; ls <= max_line_search; ++ls)
+            {
+                x_trial = x + alpha * dx;
+                Backward_Euler_Residual(x_trial, sigma_pred, q_n, Eelastic, dEPS, r_trial);
+                err_trial = error(r_trial);
+                if (err_trial < err)
+                    break;
+                alpha *= 0.5;
+            }
 
-    //             normResidualStress = sqrt(ResidualStress(i, j) * ResidualStress(i, j));
+            x = x_trial;
+            r = r_trial;
+            err = err_trial;
+            ++iter;
+        }
 
-    //             stress_relative_error = normResidualStress / sqrt(TrialStress(i, j) * TrialStress(i, j));
-    //             f_relative_error = abs(yf_TrialStress / yf_PredictorStress);
-    //             debugrun = true;
-    //             if (normResidualStress != normResidualStress || debugrun)  // check for NAN
-    //             {
-    //                 cout << "=============================================================" << endl;
-    //                 cout << "\nIteration # " << iteration_count <<  endl;
-    //                 printTensor (" CommitStress       " , CommitStress);
-    //                 double p, q, theta;
-    //                 std::tie(p, q, theta) = getpqtheta(CommitStress);
-    //                 fprintf(stderr, "CommitStress_p    = %16.8f\n"  , p );
-    //                 fprintf(stderr, "CommitStress_q    = %16.8f\n"  , q );
-    //                 fprintf(stderr, "CommitStress_theta= %16.8f\n"  , theta );
-    //                 printTensor (" depsilon           " , depsilon);
-    //                 printTensor (" dsigma             " , dsigma);
-    //                 printTensor (" PredictorStress    " , PredictorStress);
-    //                 std::tie(p, q, theta) = getpqtheta(PredictorStress);
-    //                 fprintf(stderr, "PredictorStress_p    = %16.8f\n"  , p );
-    //                 fprintf(stderr, "PredictorStress_q    = %16.8f\n"  , q );
-    //                 fprintf(stderr, "PredictorStress_theta= %16.8f\n"  , theta );
-    //                 cout <<      " yf_val_start        = " << yf_val_start << endl;
-    //                 cout <<      " yf_val_end          = " << yf_val_end << endl;
-    //                 printTensor (" n                  " , n );
-    //                 printTensor (" m                  " , m );
-    //                 cout <<      " xi_star_h_star      = " << xi_star_h_star << endl;
-    //                 cout <<      " denominator         = " << denominator << endl;
-    //                 cout <<      " dLambda             = " << dLambda << endl;
-    //                 printTensor (" TrialStress        " , TrialStress);
-    //                 std::tie(p, q, theta) = getpqtheta(TrialStress);
-    //                 fprintf(stderr, "TrialStress_p    = %16.8f\n"  , p );
-    //                 fprintf(stderr, "TrialStress_q    = %16.8f\n"  , q );
-    //                 fprintf(stderr, "TrialStress_theta= %16.8f\n"  , theta );
-
-    //                 printTensor (" TrialStress_prev   " , TrialStress_prev);
-    //                 std::tie(p, q, theta) = getpqtheta(TrialStress_prev);
-    //                 fprintf(stderr, "TrialStress_prev_p    = %16.8f\n"  , p );
-    //                 fprintf(stderr, "TrialStress_prev_q    = %16.8f\n"  , q );
-    //                 fprintf(stderr, "TrialStress_prev_theta= %16.8f\n"  , theta );
-
-    //                 printTensor (" ResidualStress     " , ResidualStress );
-    //                 cout <<      " normResidualStress  = " << normResidualStress << endl;
-    //                 cout <<      " stress_relative_error      = " << stress_relative_error << endl;
-    //                 cout <<      " f_relative_error      = " << f_relative_error << endl;
-    //                 cout <<      " iteration_count     = " << iteration_count << endl;
-    //                 cout <<      " .........................................................." << endl;
-    //                 cout <<      "  Internal variables:" << endl;
-    //                 printTensor (" back_stress (alpha)      " , yf.get_alpha() );
-    //                 cout <<      " DP_k or VM_radius      " << yf.get_k() << endl;
-    //                 cout << "back_stress(0,1) = " << (yf.get_alpha())(0, 1) << endl ;
-    //                 cout << "PredictorStress(0,1) = " << PredictorStress(0, 1) << endl ;
-    //                 cout << "===============================================END===========" << endl;
-    //                 cout << endl << endl;
-    //             }
+        double dLambda = x(n - 1);
+        if (!(err <= 1.0) || dLambda < 0)
+            return -1;
 
-    //         } // while for el-pl this step
-
-
-    //         // ===============================================
-    //         // Start working on the stiffness
-    //         // ===============================================
-    //         // Inconsistent stiffness
-    //         //Update the trial plastic strain. and internal variables
-    //         const VoigtVector& n = yf.df_dsigma_ij(TrialStress);
-    //         const VoigtVector& m = pf(depsilon, TrialStress);
-    //         const double xi_star_h_star = yf.xi_star_h_star( depsilon, m,  TrialStress);
-
-    //         denominator = n(p, q) * Eelastic(p, q, r, s) * m(r, s) - xi_star_h_star;
-    //         TrialPlastic_Strain(i, j) += dLambda * m(i, j);
-
-    //         Stiffness(i, j, k, l) = Eelastic(i, j, k, l) - (Eelastic(i, j, p, q) * m(p, q)) * (n(r, s) * Eelastic(r, s, k, l) ) / denominator;
-
-    //         // ===================================================================
-    //         // Working on consistent stiffness
-    //         // ===================================================================
-    //         // Update the m and n:
-    //         static VoigtVector nf(3, 3, 0.0);
-    //         nf = yf.df_dsigma_ij(TrialStress);
-    //         static VoigtVector mf(3, 3, 0.0);
-    //         mf = pf(depsilon, TrialStress);
-    //         // Construct the Tensor T
-    //         static VoigtMatrix IdentityTensor4(3, 3, 3, 3, 0);
-    //         IdentityTensor4(i, j, k, l) = kronecker_delta(i, j) * kronecker_delta(k, l);
-
-    //         static VoigtMatrix dm_dsigma(3, 3, 3, 3, 0.0);
-    //         dm_dsigma = pf.dm_over_dsigma(TrialStress);
-    //         static VoigtMatrix Ts(3, 3, 3, 3, 0.0);
-    //         Ts(i, j, k, l) = IdentityTensor4(i, k, j, l) + dLambda * Eelastic(i, j, p, q) * dm_dsigma(p, q, k, l);
-
-    //         // Construct the Tensor H
-    //         static VoigtVector dm_dq_star_h_star(3, 3, 0.0);
-    //         dm_dq_star_h_star = pf.dm_over_dq_start_h_star(depsilon, mf, TrialStress);
-    //         static VoigtVector H(3, 3, 0.0);
-    //         H(k, l) = mf(k, l) + dLambda * dm_dq_star_h_star(k, l);
-
-    //         static VoigtMatrix invT(3, 3, 3, 3, 0.0);
-    //         // If cannot inverse T, return directly.
-    //         // So "Stiffness" is the inconsistent stiffness tensor.
-    //         if ( !inverse4thTensor(Ts, invT) )
-    //         {
-    //             return 0;
-    //         }
-    //         static VoigtMatrix R(3, 3, 3, 3, 0.0);
-    //         R(p, q, r, s) = invT(k, l, p, q) * Eelastic(k, l, r, s);
-
-    //         // ===================================================================
-    //         // Construct the consistent stiffness
-    //         double denomin{0.0};
-    //         double const& xi_star_h_star_f = yf.xi_star_h_star( depsilon, mf,  TrialStress);
-    //         denomin = nf(p, q) * R(p, q, r, s) * H(r, s) - xi_star_h_star_f ;
-
-    //         Stiffness(i, j, k, l) = R(i, j, k, l) - ((R(i, j, p, q) * H(p, q)) * (nf(r, s) * R(r, s, k, l))) / denomin;
-    //         // ===================================================================
-    //         // Working on consistent stiffness  END
-    //         // ===================================================================
-
-    //     } //else  //Plasticity
-    //     internal_variables.commit();
-    //     return errorcode;
-    // }
+        // The internal variables already hold q(x) from the last residual
+        for (int i = 0; i < 6; ++i)
+            TrialStress(i) = x(i);
 
+        VoigtVector m = pf(dEPS, TrialStress, iv_storage, parameters_storage);
+        TrialPlastic_Strain += dLambda * m;
 
-    // int Backward_Euler_ddlambda_Subincrement(const VoigtVector &strain_incr, bool debugrun = false)
-    // {
-    //     using namespace ASDPlasticMaterialGlobals;
-    //     int errorcode = 0;
+        if (algorithmic_tangent)
+        {
+            Backward_Euler_Jacobian(x, sigma_pred, q_n, Eelastic, dEPS, sigma_ref, q_ref, r, J);
 
-    //     internal_variables.revert();
-    //     internal_variables.commit_tmp();
-    //     static VoigtVector depsilon(3, 3, 0);
-    //     static VoigtVector PredictorStress(3, 3, 0);
-    //     const VoigtVector& sigma = CommitStress;
-    //     depsilon(i, j) = strain_incr(i, j) ;
-    //     TrialStress(i, j) = sigma(i, j);
-    //     TrialStrain(i, j) = CommitStrain(i, j) + depsilon(i, j);
-    //     TrialPlastic_Strain(i, j) = CommitPlastic_Strain(i, j);
+            Eigen::Matrix<double, n, 6> B = Eigen::Matrix<double, n, 6>::Zero();
+            for (int i = 0; i < 6; ++i)
+                for (int j = 0; j < 6; ++j)
+                    B(i, j) = Eelastic(i, j);
 
-    //     VoigtMatrix& Eelastic = et(sigma);
-    //     Stiffness(i, j, k, l) = Eelastic(i, j, k, l);
+            Eigen::Matrix<double, n, 6> dx_depsilon = J.partialPivLu().solve(B);
+            if (!dx_depsilon.allFinite())
+            {
+                Stiffness = Continuum_Stiffness();
+                return 1;
+            }
 
-    //     dsigma(i, j) = Eelastic(i, j, k, l) * depsilon(k, l);
+            for (int i = 0; i < 6; ++i)
+                for (int j = 0; j < 6; ++j)
+                    Stiffness(i, j) = dx_depsilon(i, j);
+        }
 
-    //     TrialStress(i, j) +=  dsigma(i, j);
-    //     PredictorStress(i, j) = TrialStress(i, j);
+        return 1;
+    }
 
-    //     double yf_val_start = yf(sigma);
-    //     double yf_val_end = yf(PredictorStress);
+    // Residual of the backward Euler step at x = [sigma, q, dLambda]. Leaves
+    // the trial internal variables set to q.
+    void Backward_Euler_Residual(const be_vector_t & x,
+                                 const VoigtVector & sigma_pred,
+                                 const iv_vector_t & q_n,
+                                 const VoigtMatrix & Eelastic,
+                                 const VoigtVector & dEPS,
+                                 be_vector_t & r)
+    {
+        constexpr int n_iv = n_iv_components;
+        const double dLambda = x(6 + n_iv);
 
-    //     // printTensor (" CommitStress       " , CommitStress);
-    //     // printTensor (" depsilon           " , depsilon);
-    //     // printTensor (" dsigma             " , dsigma);
-    //     // printTensor (" PredictorStress    " , PredictorStress);
-    //     // cout <<      " yf_val_start        = " << yf_val_start << endl;
-    //     // cout <<      " yf_val_end          = " << yf_val_end << endl;
-    //     // printTensor (" TrialStress        " , TrialStress);
+        VoigtVector sigma;
+        for (int i = 0; i < 6; ++i)
+            sigma(i) = x(i);
 
-    //     if ((yf_val_start <= 0.0 && yf_val_end <= 0.0) || yf_val_start > yf_val_end) //Elasticity
-    //     {
-    //         VoigtMatrix& Eelastic = et(TrialStress);
-    //         Stiffness(i, j, k, l) = Eelastic(i, j, k, l);
-    //     }
-    //     else  //Plasticity
-    //     {
-    //         static VoigtVector ResidualStress(3, 3, 0);
-    //         static VoigtVector TrialStress_prev(3, 3, 0);
-    //         ResidualStress *= 0;
-    //         TrialStress_prev *= 0;
-    //         double normResidualStress = -1;
-    //         double stress_relative_error = this->stress_relative_tol * 10; //
-    //         double dLambda = 0;
-    //         double denominator = 0;
-    //         int iteration_count = 0;
-
-    //         double yf_PredictorStress = yf(PredictorStress);
-    //         double yf_TrialStress = yf(TrialStress);
-    //         // vonMises does NOT enter this part.
-    //         // DruckerPrager requries this part.
-    //         if (yf.hasCorner() && yf.in_Apex(PredictorStress))
-    //         {
-    //             static VoigtVector small_stress(3, 3, 0.0);
-    //             small_stress *= 0;
-    //             // The small value 50*Pa refers to the lowest confinement test:
-    //             // http://science.nasa.gov/science-news/science-at-nasa/1998/msad27may98_2/
-    //             double DP_k = yf.get_k();
-    //             double DP_p = 50 ;
-    //             // To make it on the yield surface, the q is equal to k*p.
-    //             double DP_q = DP_k * DP_p ;
-    //             // Assume the triaxial conditions sigma_2 = sigma_3.
-    //             small_stress(0, 0) = DP_p + 2. / 3.0 * DP_q;
-    //             small_stress(1, 1) = DP_p - 1. / 3.0 * DP_q;
-    //             small_stress(2, 2) = DP_p - 1. / 3.0 * DP_q;
-
-    //             // (1) Update the trial stress
-    //             TrialStress(i, j) = small_stress(i, j);
-    //             // (2) Update the trial plastic strain
-    //             const VoigtVector& n = yf.df_dsigma_ij(small_stress);
-    //             const VoigtVector& m = pf(depsilon, small_stress);
-    //             const double xi_star_h_star = yf.xi_star_h_star( depsilon, m,  small_stress);
-    //             double denominator = n(p, q) * Eelastic(p, q, r, s) * m(r, s) - xi_star_h_star;
-    //             double dLambda = yf_PredictorStress / denominator;
-    //             TrialPlastic_Strain(i, j) += dLambda * m(i, j);
-    //             // (3) Update the internal variables
-    //             internal_variables.evolve(dLambda, depsilon, m, TrialStress);
-    //             internal_variables.commit_tmp();
-    //             // (4) Update the stiffness.
-    //             Stiffness(i, j, k, l) = Eelastic(i, j, k, l) - (Eelastic(i, j, p, q) * m(p, q)) * (n(r, s) * Eelastic(r, s, k, l) ) / denominator;
-
-    //             // // =========================================================
-    //             // // Working on consistent stiffness
-    //             // // ========================================================
-    //             // // Construct the Tensor T
-    //             static VoigtMatrix IdentityTensor4(3, 3, 3, 3, 0);
-    //             IdentityTensor4(i, j, k, l) = kronecker_delta(i, j) * kronecker_delta(k, l);
-
-    //             static VoigtMatrix dm_dsigma(3, 3, 3, 3, 0.0);
-    //             dm_dsigma = pf.dm_over_dsigma(TrialStress);
-    //             static VoigtMatrix Ts(3, 3, 3, 3, 0.0);
-    //             Ts(i, j, k, l) = IdentityTensor4(i, k, j, l) + dLambda * Eelastic(i, j, p, q) * dm_dsigma(p, q, k, l);
-
-    //             // // Construct the Tensor H
-    //             static VoigtVector dm_dq_star_h_star(3, 3, 0.0);
-    //             dm_dq_star_h_star = pf.dm_over_dq_start_h_star(depsilon, m, TrialStress);
-    //             static VoigtVector H(3, 3, 0.0);
-    //             H(k, l) = m(k, l) + dLambda * dm_dq_star_h_star(k, l);
-
-    //             static VoigtMatrix invT(3, 3, 3, 3, 0.0);
-    //             // // If cannot inverse T, return directly with the inconsistent stiffness tensor.
-    //             if ( !inverse4thTensor(Ts, invT) )
-    //             {
-    //                 return 0;
-    //             }
-    //             static VoigtMatrix R(3, 3, 3, 3, 0.0);
-    //             R(p, q, r, s) = invT(k, l, p, q) * Eelastic(k, l, r, s);
-
-    //             // // =======================================================
-    //             // // Construct the consistent stiffness
-    //             double denomin{0.0};
-    //             denomin = n(p, q) * R(p, q, r, s) * H(r, s) - xi_star_h_star ;
-    //             Stiffness(i, j, k, l) = R(i, j, k, l) - ((R(i, j, p, q) * H(p, q)) * (n(r, s) * R(r, s, k, l))) / denomin;
-
-    //             // // =====================================================
-    //             // // Working on consistent stiffness  END
-    //             // // =====================================================
-
-    //             // skip the following iterations
-    //             return 0;
-    //         }//END yield surface APEX check
-
-    //         // ==================================================================
-    //         // From the start point(elastic predictor) to the first plastic corrector.
-    //         // ==================================================================
-    //         yf_PredictorStress = yf(PredictorStress);
-    //         const VoigtVector& n = yf.df_dsigma_ij(PredictorStress);
-    //         const VoigtVector& m = pf(depsilon, PredictorStress);
-    //         double xi_star_h_star = yf.xi_star_h_star( depsilon, m,  PredictorStress);
-    //         denominator = n(p, q) * Eelastic(p, q, r, s) * m(r, s) - xi_star_h_star;
-
-    //         dLambda =  yf_PredictorStress / denominator;
-
-    //         TrialStress_prev(i, j) = TrialStress(i, j);
-
-    //         TrialStress(i, j) = PredictorStress(i, j) - dLambda * Eelastic(i, j, k, l) * m(k, l);
-    //         internal_variables.evolve(dLambda, depsilon, m, TrialStress);
-    //         // // ============================================================
-    //         // // Line search in dlambda
-    //         // // ============================================================
-    //         double subdLambda = dLambda;
-    //         while (yf(TrialStress) > yf_PredictorStress && subdLambda > MACHINE_EPSILON * 10)
-    //         {
-    //             internal_variables.revert_tmp();
-    //             subdLambda *= 0.5;
-    //             TrialStress(i, j) = PredictorStress(i, j) - subdLambda * Eelastic(i, j, k, l) * m(k, l);
-    //             // Internal variable should be updated with subdLambda.
-    //             // The condition in while-loop will use the internal variables.
-    //             internal_variables.evolve(subdLambda, depsilon, m, TrialStress);
-    //         }
-    //         // ============================================================
-    //         dLambda = subdLambda;
-    //         ResidualStress(i, j) =  TrialStress(i, j) - TrialStress_prev(i, j);
+        setInternalVariableComponents(x, 6);
 
-    //         double f_relative_error = this->f_relative_tol * 10;
+        VoigtVector m = pf(dEPS, sigma, iv_storage, parameters_storage);
+        VoigtVector Em;
+        Em = Eelastic * m;
 
-    //         // Iteration over the ddlambda
-    //         while ((stress_relative_error > this-> stress_relative_tol ||
-    //                 f_relative_error > this->f_relative_tol) &&
-    //                 iteration_count < this->n_max_iterations
-    //               )
-    //         {
-    //             iteration_count++;
-
-    //             // ==========================================
-    //             // Works to calculate the ddlambda
-    //             // ==========================================
-    //             // Update the m and n:
-    //             static VoigtVector n_new(3, 3, 0.0);
-    //             n_new = yf.df_dsigma_ij(TrialStress);
-    //             static VoigtVector m_new(3, 3, 0.0);
-    //             m_new = pf(depsilon, TrialStress);
-    //             // Construct the Tensor T
-    //             static VoigtMatrix IdentityTensor4(3, 3, 3, 3, 0.0);
-    //             IdentityTensor4(i, j, k, l) = kronecker_delta(i, j) * kronecker_delta(k, l);
-
-    //             static VoigtMatrix dm_dsigma(3, 3, 3, 3, 0.0);
-    //             dm_dsigma = pf.dm_over_dsigma(TrialStress);
-    //             static VoigtMatrix T_new(3, 3, 3, 3, 0.0);
-    //             T_new(i, j, k, l) = IdentityTensor4(i, k, j, l) + dLambda * Eelastic(i, j, p, q) * dm_dsigma(p, q, k, l);
-
-    //             static VoigtMatrix invTnew(3, 3, 3, 3, 0.0);
-    //             if ( !inverse4thTensor(T_new, invTnew) )
-    //             {
-    //                 // cout<<"Singularity. Cannot inverse tensor T! "<<endl;
-    //                 return 0;
-    //             }
+        for (int i = 0; i < 6; ++i)
+            r(i) = sigma(i) - sigma_pred(i) + dLambda * Em(i);
 
-    //             static VoigtVector dm_dq_star_h_star(3, 3, 0.0);
-    //             dm_dq_star_h_star = pf.dm_over_dq_start_h_star(depsilon, m_new, TrialStress);
-    //             static VoigtVector H_new(3, 3, 0.0);
-    //             H_new(k, l) = m_new(k, l) + dLambda * dm_dq_star_h_star(k, l);
+        int pos = 6;
+        iv_storage.apply([&pos, &r, &q_n, &dLambda, &dEPS, &m, &sigma, this](auto & internal_variable)
+        {
+            auto h = internal_variable.hardening_function(dEPS, m, sigma, parameters_storage);
+            for (int i = 0; i < h.size(); ++i, ++pos)
+            {
+                r(pos) = internal_variable.trial_value(i) - q_n(pos - 6) - dLambda * h(i);
+            }
+        });
 
-    //             double const& xi_star_h_star_new = yf.xi_star_h_star( depsilon, m_new,  TrialStress);
+        r(6 + n_iv) = yf(sigma, iv_storage, parameters_storage);
+    }
 
-    //             double denomina_ddlambda = 0.0;
-    //             static VoigtVector E_times_H (3, 3, 0.0);
-    //             Eelastic = et(TrialStress);
-    //             E_times_H(i, j) = Eelastic(i, j, k, l) * H_new(k, l);
-    //             denomina_ddlambda = n_new(r, s) * (E_times_H(p, q) * invTnew(p, q, r, s)) - xi_star_h_star_new ;
-    //             double numerator_ddlambda = 0.0;
-    //             numerator_ddlambda = yf(TrialStress) - n_new(r, s) * (ResidualStress(i, j) * invTnew(i, j, r, s)) ;
-    //             double ddlambda =   numerator_ddlambda / denomina_ddlambda ;
-
-    //             static VoigtVector dSigma_(3, 3, 0.0);
-    //             dSigma_(r, s) = -
-    //                             (
-    //                                 ResidualStress(i, j) + ddlambda * Eelastic(i, j, p, q) * H_new(p, q)
-    //                             )
-    //                             * invTnew(i, j, r, s) ;
-
-    //             TrialStress_prev(i, j) = TrialStress(i, j) ;
-    //             TrialStress(i, j) =  TrialStress(i, j) + dSigma_(i, j) ;
-    //             double yf_TrialStress_prev = yf(TrialStress_prev) ;
-    //             internal_variables.evolve(ddlambda, depsilon, m_new, TrialStress);
-
-    //             // =======Line Search ddlambda (double delta ) =======
-    //             double subddlambda = ddlambda;
-    //             double zeta = 1.0;
-    //             while (yf(TrialStress) > yf_TrialStress_prev && subddlambda > MACHINE_EPSILON * 10)
-    //             {
-    //                 internal_variables.revert_tmp();
-    //                 subddlambda *= 0.5 ;
-    //                 zeta *= 0.5 ;
-    //                 TrialStress(i, j) = TrialStress(i, j) + zeta * dSigma_(i, j) ;
-    //                 // Internal variable should be updated with subddlambda.
-    //                 // The condition in while-loop will use the internal variables.
-    //                 internal_variables.evolve(subddlambda, depsilon, m, TrialStress);
-    //             }
+    // Forward-difference Jacobian of Backward_Euler_Residual at x, given the
+    // residual r already evaluated there.
+    void Backward_Euler_Jacobian(be_vector_t & x,
+                                 const VoigtVector & sigma_pred,
+                                 const iv_vector_t & q_n,
+                                 const VoigtMatrix & Eelastic,
+                                 const VoigtVector & dEPS,
+                                 double sigma_ref,
+                                 double q_ref,
+                                 const be_vector_t & r,
+                                 be_matrix_t & J)
+    {
+        using namespace ASDPlasticMaterialGlobals;
 
-    //             dLambda = dLambda + subddlambda ;
-    //             yf_TrialStress = yf(TrialStress);
+        static const double sqrt_eps = sqrt(MACHINE_EPSILON);
 
-    //             ResidualStress(i, j) = TrialStress(i, j) - TrialStress_prev(i, j);
+        constexpr int n = n_backward_euler;
+        constexpr int n_iv = n_iv_components;
+        const double lambda_ref = fmax(dEPS.norm(), MACHINE_EPSILON);
 
-    //             normResidualStress = sqrt(ResidualStress(i, j) * ResidualStress(i, j));
+        be_vector_t r_pert;
+        for (int j = 0; j < n; ++j)
+        {
+            double typical = j < 6 ? sigma_ref : (j < 6 + n_iv ? q_ref : lambda_ref);
+            double xj = x(j);
+            double h = sqrt_eps * fmax(abs(xj), typical);
+
+            x(j) = xj + h;
+            Backward_Euler_Residual(x, sigma_pred, q_n, Eelastic, dEPS, r_pert);
+            J.col(j) = (r_pert - r) / h;
+            x(j) = xj;
+        }
 
-    //             stress_relative_error = normResidualStress / sqrt(TrialStress(i, j) * TrialStress(i, j));
-    //             f_relative_error = abs(yf_TrialStress / yf_PredictorStress);
-    //             // debugrun = true;
-    //             if (normResidualStress != normResidualStress || debugrun)  // check for NAN
-    //             {
-    //                 cout << "=============================================================" << endl;
-    //                 cout << "\nIteration # " << iteration_count <<  endl;
-    //                 printTensor (" CommitStress       " , CommitStress);
-    //                 double p, q, theta;
-    //                 std::tie(p, q, theta) = getpqtheta(CommitStress);
-    //                 fprintf(stderr, "CommitStress_p    = %16.8f\n"  , p );
-    //                 fprintf(stderr, "CommitStress_q    = %16.8f\n"  , q );
-    //                 fprintf(stderr, "CommitStress_theta= %16.8f\n"  , theta );
-    //                 printTensor (" depsilon           " , depsilon);
-    //                 printTensor (" dsigma             " , dsigma);
-    //                 printTensor (" PredictorStress    " , PredictorStress);
-    //                 std::tie(p, q, theta) = getpqtheta(PredictorStress);
-    //                 fprintf(stderr, "PredictorStress_p    = %16.8f\n"  , p );
-    //                 fprintf(stderr, "PredictorStress_q    = %16.8f\n"  , q );
-    //                 fprintf(stderr, "PredictorStress_theta= %16.8f\n"  , theta );
-    //                 cout <<      " yf_val_start        = " << yf_val_start << endl;
-    //                 cout <<      " yf_val_end          = " << yf_val_end << endl;
-    //                 printTensor (" n                  " , n );
-    //                 printTensor (" m                  " , m );
-    //                 cout <<      " xi_star_h_star      = " << xi_star_h_star << endl;
-    //                 cout <<      " denominator         = " << denominator << endl;
-    //                 cout <<      " dLambda             = " << dLambda << endl;
-    //                 printTensor (" TrialStress        " , TrialStress);
-    //                 std::tie(p, q, theta) = getpqtheta(TrialStress);
-    //                 fprintf(stderr, "TrialStress_p    = %16.8f\n"  , p );
-    //                 fprintf(stderr, "TrialStress_q    = %16.8f\n"  , q );
-    //                 fprintf(stderr, "TrialStress_theta= %16.8f\n"  , theta );
-
-    //                 printTensor (" TrialStress_prev   " , TrialStress_prev);
-    //                 std::tie(p, q, theta) = getpqtheta(TrialStress_prev);
-    //                 fprintf(stderr, "TrialStress_prev_p    = %16.8f\n"  , p );
-    //                 fprintf(stderr, "TrialStress_prev_q    = %16.8f\n"  , q );
-    //                 fprintf(stderr, "TrialStress_prev_theta= %16.8f\n"  , theta );
-
-    //                 printTensor (" ResidualStress     " , ResidualStress );
-    //                 cout <<      " normResidualStress  = " << normResidualStress << endl;
-    //                 cout <<      " stress_relative_error      = " << stress_relative_error << endl;
-    //                 cout <<      " f_relative_error      = " << f_relative_error << endl;
-    //                 cout <<      " iteration_count     = " << iteration_count << endl;
-    //                 cout <<      " .........................................................." << endl;
-    //                 cout <<      "  Internal variables:" << endl;
-    //                 printTensor (" back_stress (alpha)      " , yf.get_alpha() );
-    //                 cout <<      " DP_k or VM_radius      " << yf.get_k() << endl;
-    //                 cout << "back_stress(0,1) = " << (yf.get_alpha())(0, 1) << endl ;
-    //                 cout << "PredictorStress(0,1) = " << PredictorStress(0, 1) << endl ;
-    //                 cout << "===============================================END===========" << endl;
-    //                 cout << endl << endl;
-    //             }
+        setInternalVariableComponents(x, 6);
+    }
 
-    //         } // while for el-pl this step
-
-
-    //         // ===============================================
-    //         // Start working on the stiffness
-    //         // ===============================================
-    //         // Inconsistent stiffness
-    //         //Update the trial plastic strain. and internal variables
-    //         const VoigtVector& n_ = yf.df_dsigma_ij(TrialStress);
-    //         const VoigtVector& m_ = pf(depsilon, TrialStress);
-    //         const double xi_star_h_star_ = yf.xi_star_h_star( depsilon, m_,  TrialStress);
-
-    //         denominator = n_(p, q) * Eelastic(p, q, r, s) * m_(r, s) - xi_star_h_star_;
-
-    //         Stiffness(i, j, k, l) = Eelastic(i, j, k, l) - (Eelastic(i, j, p, q) * m_(p, q)) * (n_(r, s) * Eelastic(r, s, k, l) ) / denominator;
-
-    //         // ===================================================================
-    //         // Working on consistent stiffness
-    //         // ===================================================================
-    //         // Update the m and n:
-    //         static VoigtVector nf(3, 3, 0.0);
-    //         nf = yf.df_dsigma_ij(TrialStress);
-    //         static VoigtVector mf(3, 3, 0.0);
-    //         mf = pf(depsilon, TrialStress);
-    //         // Construct the Tensor T
-    //         static VoigtMatrix IdentityTensor4(3, 3, 3, 3, 0);
-    //         IdentityTensor4(i, j, k, l) = kronecker_delta(i, j) * kronecker_delta(k, l);
-
-    //         static VoigtMatrix dm_dsigma(3, 3, 3, 3, 0.0);
-    //         dm_dsigma = pf.dm_over_dsigma(TrialStress);
-    //         static VoigtMatrix Ts(3, 3, 3, 3, 0.0);
-    //         Ts(i, j, k, l) = IdentityTensor4(i, k, j, l) + dLambda * Eelastic(i, j, p, q) * dm_dsigma(p, q, k, l);
-
-    //         // Construct the Tensor H
-    //         static VoigtVector dm_dq_star_h_star(3, 3, 0.0);
-    //         dm_dq_star_h_star = pf.dm_over_dq_start_h_star(depsilon, mf, TrialStress);
-    //         static VoigtVector H(3, 3, 0.0);
-    //         H(k, l) = mf(k, l) + dLambda * dm_dq_star_h_star(k, l);
-
-    //         static VoigtMatrix invT(3, 3, 3, 3, 0.0);
-    //         // If cannot inverse T, return directly.
-    //         // So "Stiffness" is the inconsistent stiffness tensor.
-    //         if ( !inverse4thTensor(Ts, invT) )
-    //         {
-    //             return 0;
-    //         }
-    //         static VoigtMatrix R(3, 3, 3, 3, 0.0);
-    //         R(p, q, r, s) = invT(k, l, p, q) * Eelastic(k, l, r, s);
-
-    //         // ===================================================================
-    //         // Construct the consistent stiffness
-    //         double denomin{0.0};
-    //         double const& xi_star_h_star_f = yf.xi_star_h_star( depsilon, mf,  TrialStress);
-    //         denomin = nf(p, q) * R(p, q, r, s) * H(r, s) - xi_star_h_star_f ;
-
-    //         Stiffness(i, j, k, l) = R(i, j, k, l) - ((R(i, j, p, q) * H(p, q)) * (nf(r, s) * R(r, s, k, l))) / denomin;
-    //         // ===================================================================
-    //         // Working on consistent stiffness  END
-    //         // ===================================================================
-
-    //     } //else  //Plasticity
-    //     internal_variables.commit();
-    //     return errorcode;
-    // }
+    // Copy the trial internal variables into q, starting at q(offset)
+    template <class VectorType>
+    void getInternalVariableComponents(VectorType & q, int offset)
+    {
+        int pos = offset;
+        iv_storage.apply([&pos, &q](auto & internal_variable)
+        {
+            for (int i = 0; i < internal_variable.size(); ++i, ++pos)
+                q(pos) = internal_variable.trial_value(i);
+        });
+    }
 
+    // Set the trial internal variables from q, starting at q(offset)
+    template <class VectorType>
+    void setInternalVariableComponents(const VectorType & q, int offset)
+    {
+        int pos = offset;
+        iv_storage.apply([&pos, &q](auto & internal_variable)
+        {
+            for (int i = 0; i < internal_variable.size(); ++i, ++pos)
+                internal_variable.trial_value(i) = q(pos);
+        });
+    }
 
     // // The algorithm below Modified_Euler_Error_Control was implemented by Jose. 18Sep2016
     // int Modified_Euler_Error_Control(const VoigtVector &strain_incr)
@@ -3058,52 +2379,31 @@ protected:
 
 protected:
 
-    static std::map<int, ASDPlasticMaterial_Constitutive_Integration_Method> INT_OPT_constitutive_integration_method;     //
-    static std::map<int, ASDPlasticMaterial_Tangent_Operator_Type> INT_OPT_tangent_operator_type;     //
-    static std::map<int, double> INT_OPT_f_relative_tol;
-    static std::map<int, double> INT_OPT_stress_relative_tol;
-    static std::map<int, int> INT_OPT_n_max_iterations;
-    static std::map<int, int> INT_OPT_return_to_yield_surface;
-
-    bool first_step;
-
-    static VoigtVector dsigma;
-    static VoigtVector depsilon_elpl;    //Elastoplastic strain increment : For a strain increment that causes first yield, the step is divided into an elastic one (until yield) and an elastoplastic one.
-    static VoigtVector intersection_stress;
-    static VoigtVector intersection_strain;
-    static VoigtMatrix Stiffness;
-
-
-};
+    // Integration options of this instance, copied along by getCopy
+    ASDPlasticMaterial_Constitutive_Integration_Method INT_OPT_constitutive_integration_method = ASDPlasticMaterial_Constitutive_Integration_Method::Not_Set;
+    ASDPlasticMaterial_Tangent_Operator_Type INT_OPT_tangent_operator_type = ASDPlasticMaterial_Tangent_Operator_Type::Elastic;
+    double INT_OPT_f_relative_tol = 1e-6;
+    double INT_OPT_stress_relative_tol = 1e-6;
+    int INT_OPT_n_max_iterations = 100;
+    int INT_OPT_return_to_yield_surface = 1;
 
-template < class E, class Y, class P, int tag>
-std::map<int, ASDPlasticMaterial_Constitutive_Integration_Method> ASDPlasticMaterial< E,  Y,  P,  tag>::INT_OPT_constitutive_integration_method;
-template < class E, class Y, class P, int tag>
-std::map<int, ASDPlasticMaterial_Tangent_Operator_Type> ASDPlasticMaterial< E,  Y,  P,  tag>::INT_OPT_tangent_operator_type;
-template < class E, class Y, class P, int tag>
-std::map<int, double> ASDPlasticMaterial< E,  Y,  P,  tag>::INT_OPT_f_relative_tol;
-template < class E, class Y, class P, int tag>
-std::map<int, double> ASDPlasticMaterial< E,  Y,  P,  tag>::INT_OPT_stress_relative_tol;
-template < class E, class Y, class P, int tag>
-std::map<int, int> ASDPlasticMaterial< E,  Y,  P,  tag>::INT_OPT_n_max_iterations;
-template < class E, class Y, class P, int tag>
-std::map<int, int> ASDPlasticMaterial< E,  Y,  P,  tag>::INT_OPT_return_to_yield_surface;
+    // Resolved from the options by resolve_integration_options
+    int (ASDPlasticMaterial::*integrate)(const VoigtVector &) = &ASDPlasticMaterial::Integrate<ASDPlasticMaterial_Constitutive_Integration_Method::Not_Set>;
+    void (ASDPlasticMaterial::*compute_tangent)() = &ASDPlasticMaterial::ComputeTangentStiffness<ASDPlasticMaterial_Tangent_Operator_Type::Elastic>;
 
+    bool first_step;
 
-template < class E, class Y, class P, int tag>
-VoigtVector ASDPlasticMaterial< E,  Y,  P,  tag>::dsigma;
-
-template < class E, class Y, class P, int tag>
-VoigtVector ASDPlasticMaterial< E,  Y,  P,  tag>::depsilon_elpl;  //Used to compute the yield surface intersection.
+    VoigtVector dsigma;
+    VoigtVector depsilon_elpl;    //Elastoplastic strain increment : For a strain increment that causes first yield, the step is divided into an elastic one (until yield) and an elastoplastic one.
+    VoigtVector intersection_stress;
+    VoigtVector intersection_strain;
+    VoigtMatrix Stiffness;
 
-template < class E, class Y, class P, int tag>
-VoigtVector ASDPlasticMaterial< E,  Y,  P,  tag >::intersection_stress;  //Used to compute the yield surface intersection.
+    // Returned by getTangent and getInitialTangent
+    Matrix tangent_matrix;
 
-template < class E, class Y, class P, int tag>
-VoigtVector ASDPlasticMaterial< E,  Y,  P,  tag>::intersection_strain;  //Used to compute the yield surface intersection.
 
-template < class E, class Y, class P, int tag>
-VoigtMatrix ASDPlasticMaterial< E,  Y,  P,  tag>::Stiffness;  //Used to compute the yield surface intersection.
+};
 
 
 #endif
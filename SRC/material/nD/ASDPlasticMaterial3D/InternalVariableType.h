@@ -3,6 +3,7 @@
 template <class EvolvingVariableType, class HardeningType, class NAMER>
 struct InternalVariableType {
     static constexpr const char* NAME = NAMER::name;
+    static constexpr int SIZE = EvolvingVariableType::SizeAtCompileTime;
     EvolvingVariableType trial_value;
     EvolvingVariableType committed_value;
     InternalVariableType() = default;
@@ -51,3 +52,14 @@ std::ostream& operator<<(std::ostream& os, const InternalVariableType<EvolvingVa
     // os << "   HardeningType::parameters --> " << typeid(typename InternalVariableType<EvolvingVariableType, HardeningType, NAMER>::parameters_t).name() << endl;
     return os;
 }
+
+
+// Number of scalar components of a tuple of internal variables
+template <class T>
+struct InternalVariableComponents;
+
+template <class... InternalVariables>
+struct InternalVariableComponents<std::tuple<InternalVariables...>>
+{
+    static constexpr int value = (0 + ... + InternalVariables::SIZE);
+};
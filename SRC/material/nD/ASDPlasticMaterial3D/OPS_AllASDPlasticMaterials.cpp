@@ -71,7 +71,8 @@ void print_usage(void)
        "    stress_relative_tol (double value)\\ \n"
        "    n_max_iterations (int value)\\ \n"
        "    return_to_yield_surface (0 or 1)\\ \n"
-       "    method (string) : Forward_Euler | Runge_Kutta_45_Error_Control\\ \n"
+       "    method (string) : Forward_Euler | Runge_Kutta_45_Error_Control | Backward_Euler | Full_Backward_Euler\\ \n"
+       "    tangent_type (string) : Elastic | Continuum | Secant | Algorithmic\\ \n"
        "End_Integration_Options \\ \n"
        "\n";
 }
@@ -361,6 +362,10 @@ void populate_ASDPlasticMaterial(T* instance)
                         method = (int) ASDPlasticMaterial_Constitutive_Integration_Method::Forward_Euler;
                     else if (std::strcmp(method_name, "Runge_Kutta_45_Error_Control") == 0)
                         method = (int) ASDPlasticMaterial_Constitutive_Integration_Method::Runge_Kutta_45_Error_Control;
+                    else if (std::strcmp(method_name, "Backward_Euler") == 0)
+                        method = (int) ASDPlasticMaterial_Constitutive_Integration_Method::Backward_Euler;
+                    else if (std::strcmp(method_name, "Full_Backward_Euler") == 0)
+                        method = (int) ASDPlasticMaterial_Constitutive_Integration_Method::Full_Backward_Euler;
                     else
                     {
                         cout << "WARNING! Unrecognised ASDPlasticMaterial_Constitutive_Integration_Method name " << method_name << endl;
@@ -380,6 +385,8 @@ void populate_ASDPlasticMaterial(T* instance)
                         tangent = (int) ASDPlasticMaterial_Tangent_Operator_Type::Continuum;
                     else if (std::strcmp(tangent_type_name, "Secant") == 0)
                         tangent = (int) ASDPlasticMaterial_Tangent_Operator_Type::Secant;
+                    else if (std::strcmp(tangent_type_name, "Algorithmic") == 0)
+                        tangent = (int) ASDPlasticMaterial_Tangent_Operator_Type::Algorithmic;
                     else
                     {
                         cout << "WARNING! Unrecognised ASDPlasticMaterial_Tangent_Operator_Type name " << tangent_type_name << endl;
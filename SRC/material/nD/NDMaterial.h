@@ -85,6 +85,9 @@ class NDMaterial : // public Material
 
     virtual const char *getType(void) const = 0;
     virtual int getOrder(void) const {return 0;};  //??
+    // true when distinct instances may be updated concurrently, i.e. the
+    // class keeps no scratch storage shared between threads
+    virtual bool isReentrant(void) const {return false;}
 
     virtual Response *setResponse (const char **argv, int argc, OPS_Stream &s);
     virtual int getResponse (int responseID, Information &matInformation);
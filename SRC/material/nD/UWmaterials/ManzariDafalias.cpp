@@ -29,6 +29,10 @@
 #include <MaterialResponse.h>
 
 #include <string.h>
+#include <atomic>
+
+using OpenSees::VectorND;
+using OpenSees::MatrixND;
 
 #if defined(_WIN32) || defined(_WIN64)
 #include <algorithm>
@@ -67,6 +71,40 @@ Matrix              ManzariDafalias::mIIdevMix(6,6);
 Matrix              ManzariDafalias::mIIdevCo(6,6);
 ManzariDafalias::initTensors ManzariDafalias::initTensorOps;
 
+// second-order identity tensor of the fixed-size kernels
+static const VectorND<6> I1 {1.0, 1.0, 1.0, 0.0, 0.0, 0.0};
+
+// copy between the Vector/Matrix state and the fixed-size kernels
+static inline void
+assign(VectorND<6>& a, const Vector& v)
+{
+    for (int i = 0; i < 6; i++)
+        a[i] = v(i);
+}
+
+static inline void
+assign(Vector& v, const VectorND<6>& a)
+{
+    for (int i = 0; i < 6; i++)
+        v(i) = a[i];
+}
+
+static inline void
+assign(MatrixND<6,6>& a, const Matrix& m)
+{
+    for (int j = 0; j < 6; j++)
+        for (int i = 0; i < 6; i++)
+            a(i,j) = m(i,j);
+}
+
+static inline void
+assign(Matrix& m, const MatrixND<6,6>& a)
+{
+    for (int j = 0; j < 6; j++)
+        for (int i = 0; i < 6; i++)
+            m(i,j) = a(i,j);
+}
+
 static int numManzariDafaliasMaterials = 0;
 
 void * OPS_ADD_RUNTIME_VPV(OPS_ManzariDafaliasMaterial)
@@ -364,10 +402,10 @@ ManzariDafalias::getCopy(const char *type)
       }
 }
 
-int 
+int
 ManzariDafalias::commitState(void)
 {
-    Vector n(6), d(6), b(6), R(6);
+    VectorND<6> sigma, alpha, fabric, alpha_in, n, d, b, R;
     double cos3Theta, h, psi, aB, aD, b0, A, D, B, C;
 
     mAlpha_in_n = mAlpha_in;
@@ -381,7 +419,8 @@ ManzariDafalias::commitState(void)
     mVoidRatio  = m_e_init - (1 + m_e_init) * GetTrace(mEpsilon);
 
 	// This is needed for the ManzariDafaliasRO subclass
-    GetStateDependent(mSigma, mAlpha, mFabric, mVoidRatio, mAlpha_in, 
+    assign(sigma, mSigma); assign(alpha, mAlpha); assign(fabric, mFabric); assign(alpha_in, mAlpha_in);
+    GetStateDependent(sigma, alpha, fabric, mVoidRatio, alpha_in,
               n, d, b, cos3Theta, h, psi, aB, aD, b0, A, D, B, C, R);
     this->GetElasticModuli(mSigma, mVoidRatio, mK, mG, D);
 
@@ -860,14 +899,18 @@ void ManzariDafalias::integrate()
 	// I assume full elastic step and check if the new stress direction is "dramatically" 
 	// different from the stress path (in reference to the center of the yield surface). 
 	// Another method is to use the change in the stress direction.
-    Vector trialDirection(6), tmp(6);
+    VectorND<6> trialDirection, tmp;
+    MatrixND<6,6> Ce;
 	// trialDirection = GetNormalToYield(mSigma_n + mCe*(mEpsilon - mEpsilon_n), mAlpha_n);
 	// trialDirection = mCe * (mEpsilon - mEpsilon_n);
-	tmp = mEpsilon; tmp -= mEpsilon_n;
-	trialDirection = mCe * tmp;
+	for (int i = 0; i < 6; i++)
+		tmp[i] = mEpsilon(i) - mEpsilon_n(i);
+	assign(Ce, mCe);
+	trialDirection = DoubleDot4_2(Ce, tmp);
 
     // if (DoubleDot2_2_Contr(mAlpha_n - mAlpha_in_n, trialDirection) < 0.0)
-	tmp = mAlpha_n; tmp -= mAlpha_in_n;
+	for (int i = 0; i < 6; i++)
+		tmp[i] = mAlpha_n(i) - mAlpha_in_n(i);
 	if (DoubleDot2_2_Contr(tmp, trialDirection) < 0.0)
         mAlpha_in = mAlpha_n;
     else
@@ -896,24 +939,33 @@ void ManzariDafalias::integrate()
 void ManzariDafalias::elastic_integrator(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
         const Vector& NextStrain, Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha,
         double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) 
-{    
-    Vector dStrain(6);
-    
+{
+    VectorND<6> dStrain, dSigma, sigma;
+    MatrixND<6,6> C;
+
     // calculate elastic response
     // dStrain               = NextStrain - CurStrain;
-	dStrain = NextStrain; dStrain -= CurStrain;
+	for (int i = 0; i < 6; i++)
+		dStrain[i] = NextStrain(i) - CurStrain(i);
     NextVoidRatio         = m_e_init - (1 + m_e_init) * GetTrace(NextStrain);
     // NextElasticStrain     = CurElasticStrain + dStrain;
 	NextElasticStrain = CurElasticStrain; NextElasticStrain += dStrain;
-    GetElasticModuli(CurStress, NextVoidRatio, K, G); 
-    aCep_Consistent       = aCep = aC = GetStiffness(K, G);
+    GetElasticModuli(CurStress, NextVoidRatio, K, G);
+    // aCep_Consistent       = aCep = aC = GetStiffness(K, G);
+    GetStiffness(K, G, C);
+    assign(aC, C); aCep = aC; aCep_Consistent = aC;
     // NextStress            = CurStress + DoubleDot4_2(aC,dStrain);
-	NextStress = CurStress; NextStress += DoubleDot4_2(aC, dStrain);
+	dSigma = DoubleDot4_2(C, dStrain);
+	NextStress = CurStress; NextStress += dSigma;
 
     //update State variables
     double p = one3 * GetTrace(NextStress)+ m_Presidual;
-    if (p > small)
-        NextAlpha = GetDevPart(NextStress) / p;
+    if (p > small) {
+        // NextAlpha = GetDevPart(NextStress) / p;
+        assign(sigma, NextStress);
+        sigma = GetDevPart(sigma); sigma /= p;
+        assign(NextAlpha, sigma);
+    }
     return;
 }
 
@@ -921,12 +973,49 @@ void ManzariDafalias::elastic_integrator(const Vector& CurStress, const Vector&
 void ManzariDafalias::explicit_integrator(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
         const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
         Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) 
+        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent)
+{
+    VectorND<6> curStress, curStrain, curElasticStrain, curAlpha, curFabric, alphaIn, nextStrain;
+    VectorND<6> nextElasticStrain, nextStress, nextAlpha, nextFabric;
+    MatrixND<6,6> C, Cep, Cep_Consistent;
+
+    assign(curStress, CurStress);
+    assign(curStrain, CurStrain);
+    assign(curElasticStrain, CurElasticStrain);
+    assign(curAlpha, CurAlpha);
+    assign(curFabric, CurFabric);
+    assign(alphaIn, alpha_in);
+    assign(nextStrain, NextStrain);
+    assign(nextElasticStrain, NextElasticStrain);
+    assign(nextStress, NextStress);
+    assign(nextAlpha, NextAlpha);
+    assign(nextFabric, NextFabric);
+    assign(C, aC);
+    assign(Cep, aCep);
+    assign(Cep_Consistent, aCep_Consistent);
+
+    explicit_integrator(curStress, curStrain, curElasticStrain, curAlpha, curFabric, alphaIn, nextStrain,
+        nextElasticStrain, nextStress, nextAlpha, nextFabric, NextDGamma, NextVoidRatio, G, K, C, Cep, Cep_Consistent);
+
+    assign(NextElasticStrain, nextElasticStrain);
+    assign(NextStress, nextStress);
+    assign(NextAlpha, nextAlpha);
+    assign(NextFabric, nextFabric);
+    assign(aC, C);
+    assign(aCep, Cep);
+    assign(aCep_Consistent, Cep_Consistent);
+}
+
+
+void ManzariDafalias::explicit_integrator(const VectorND<6>& CurStress, const VectorND<6>& CurStrain, const VectorND<6>& CurElasticStrain,
+        const VectorND<6>& CurAlpha, const VectorND<6>& CurFabric, const VectorND<6>& alpha_in, const VectorND<6>& NextStrain,
+        VectorND<6>& NextElasticStrain, VectorND<6>& NextStress, VectorND<6>& NextAlpha, VectorND<6>& NextFabric,
+        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, MatrixND<6,6>& aC, MatrixND<6,6>& aCep, MatrixND<6,6>& aCep_Consistent)
 {    
     // function pointer to the integration scheme
-    void (ManzariDafalias::*exp_int) (const Vector& , const Vector& , const Vector& , const Vector& , const Vector& , const Vector& , 
-        const Vector& ,    Vector& , Vector& , Vector& , Vector& , double& , double& ,  double& , double& , 
-        Matrix& , Matrix& , Matrix& ) ;
+    void (ManzariDafalias::*exp_int) (const VectorND<6>& , const VectorND<6>& , const VectorND<6>& , const VectorND<6>& , const VectorND<6>& , const VectorND<6>& , 
+        const VectorND<6>& , VectorND<6>& , VectorND<6>& , VectorND<6>& , VectorND<6>& , double& , double& ,  double& , double& , 
+        MatrixND<6,6>& , MatrixND<6,6>& , MatrixND<6,6>& ) ;
     
     switch (mScheme) {
         case INT_ForwardEuler     :    // Forward Euler
@@ -962,7 +1051,8 @@ void ManzariDafalias::explicit_integrator(const Vector& CurStress, const Vector&
             break;
     }
     double elasticRatio, p, pn, f, fn;
-    Vector dSigma(6), dStrain(6), dElasStrain(6);
+    VectorND<6> dSigma, dStrain, dElasStrain;
+    VectorND<6> startStress, startStrain, startElasticStrain;
     bool   p_tr_pos = true;
 
     NextVoidRatio          = m_e_init - (1 + m_e_init) * GetTrace(NextStrain);
@@ -970,7 +1060,7 @@ void ManzariDafalias::explicit_integrator(const Vector& CurStress, const Vector&
 	dStrain = NextStrain; dStrain -= CurStrain;
 	// NextElasticStrain     = CurElasticStrain + dStrain;
 	NextElasticStrain = CurElasticStrain; NextElasticStrain += dStrain;
-    aC                     = GetStiffness(K, G);
+    GetStiffness(K, G, aC);
     dSigma                 = DoubleDot4_2(aC, dStrain);
     // NextStress             = CurStress + dSigma;
 	NextStress = CurStress; NextStress += dSigma;
@@ -995,20 +1085,23 @@ void ManzariDafalias::explicit_integrator(const Vector& CurStress, const Vector&
         pn = one3 * GetTrace(CurStress) + m_Presidual;
         if (pn < m_Presidual)
         {
-            if (debugFlag) 
+            if (debugFlag)
                 opserr << "Manzari Dafalias (tag = " << this->getTag() << ") : p_n < 0, This should have not happened!" << endln;
-            NextStress = m_Pmin * mI1;
-            NextAlpha.Zero();
+            // NextStress = m_Pmin * mI1;
+            NextStress.zero();
+            for (int i = 0; i < 3; i++)
+                NextStress[i] = m_Pmin;
+            NextAlpha.zero();
             return;
         }
-        
+
         if (fn > mTolF)
         {
             // This is an illegal stress state! This shouldn't happen.
             if (debugFlag) opserr << "stress state outside the yield surface!" << endln;
             if (debugFlag) opserr << "ManzariDafalias : Encountered an illegal stress state! Tag: " << this->getTag() << endln;
             if (debugFlag) opserr << "                  f = " << GetF(CurStress, CurAlpha) << endln;
-            (this->*exp_int)(CurStress, CurStrain, CurElasticStrain, CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain, NextStress, NextAlpha, 
+            (this->*exp_int)(CurStress, CurStrain, CurElasticStrain, CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain, NextStress, NextAlpha,
                     NextFabric, NextDGamma, NextVoidRatio, G, K, aC, aCep, aCep_Consistent);
 
         } else if (fn < -mTolF) {
@@ -1020,7 +1113,10 @@ void ManzariDafalias::explicit_integrator(const Vector& CurStress, const Vector&
             // (this->*exp_int)(CurStress + dSigma, CurStrain + elasticRatio*(NextStrain - CurStrain), CurElasticStrain + elasticRatio*(NextStrain - CurStrain),
             //     CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain, NextStress, NextAlpha, NextFabric, NextDGamma, NextVoidRatio,
             //     G, K, aC, aCep, aCep_Consistent);
-			(this->*exp_int)(CurStress + dSigma, CurStrain + dElasStrain, CurElasticStrain + dElasStrain,
+			startStress = CurStress; startStress += dSigma;
+			startStrain = CurStrain; startStrain += dElasStrain;
+			startElasticStrain = CurElasticStrain; startElasticStrain += dElasStrain;
+			(this->*exp_int)(startStress, startStrain, startElasticStrain,
 				CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain, NextStress, NextAlpha, NextFabric, NextDGamma, NextVoidRatio,
 				G, K, aC, aCep, aCep_Consistent);
 
@@ -1028,7 +1124,7 @@ void ManzariDafalias::explicit_integrator(const Vector& CurStress, const Vector&
 
             if (DoubleDot2_2_Contr(GetNormalToYield(CurStress, CurAlpha),dSigma)/(GetNorm_Contr(dSigma) == 0 ? 1.0 : GetNorm_Contr(dSigma)) > (- sqrt(mTolF))) {
                 // This is a pure plastic step
-                (this->*exp_int)(CurStress, CurStrain, CurElasticStrain, CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain, NextStress, NextAlpha, 
+                (this->*exp_int)(CurStress, CurStrain, CurElasticStrain, CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain, NextStress, NextAlpha,
                     NextFabric, NextDGamma, NextVoidRatio, G, K, aC, aCep, aCep_Consistent);
             } else {
                 // This is an elastic unloding followed by plastic loading
@@ -1039,7 +1135,10 @@ void ManzariDafalias::explicit_integrator(const Vector& CurStress, const Vector&
                 // (this->*exp_int)(CurStress + dSigma, CurStrain + elasticRatio*(NextStrain - CurStrain), CurElasticStrain + elasticRatio*(NextStrain - CurStrain),
                 //     CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain, NextStress, NextAlpha, NextFabric, NextDGamma, NextVoidRatio,
                 //     G, K, aC, aCep, aCep_Consistent);
-				(this->*exp_int)(CurStress + dSigma, CurStrain + dElasStrain, CurElasticStrain + dElasStrain,
+				startStress = CurStress; startStress += dSigma;
+				startStrain = CurStrain; startStrain += dElasStrain;
+				startElasticStrain = CurElasticStrain; startElasticStrain += dElasStrain;
+				(this->*exp_int)(startStress, startStrain, startElasticStrain,
 					CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain, NextStress, NextAlpha, NextFabric, NextDGamma, NextVoidRatio,
 					G, K, aC, aCep, aCep_Consistent);
             }
@@ -1048,15 +1147,15 @@ void ManzariDafalias::explicit_integrator(const Vector& CurStress, const Vector&
 }
 
 
-void ManzariDafalias::MaxStrainInc(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-        const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
-        Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric, 
-        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) 
+void ManzariDafalias::MaxStrainInc(const VectorND<6>& CurStress, const VectorND<6>& CurStrain, const VectorND<6>& CurElasticStrain,
+        const VectorND<6>& CurAlpha, const VectorND<6>& CurFabric, const VectorND<6>& alpha_in, const VectorND<6>& NextStrain,
+        VectorND<6>& NextElasticStrain, VectorND<6>& NextStress, VectorND<6>& NextAlpha, VectorND<6>& NextFabric, 
+        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, MatrixND<6,6>& aC, MatrixND<6,6>& aCep, MatrixND<6,6>& aCep_Consistent) 
 {        
     // function pointer to the integration scheme
-    void (ManzariDafalias::*exp_int) (const Vector& , const Vector& , const Vector& , const Vector& , const Vector& , const Vector& , 
-        const Vector& ,    Vector& , Vector& , Vector& , Vector& , double& , double& ,  double& , double& , 
-        Matrix& , Matrix& , Matrix& ) ;
+    void (ManzariDafalias::*exp_int) (const VectorND<6>& , const VectorND<6>& , const VectorND<6>& , const VectorND<6>& , const VectorND<6>& , const VectorND<6>& , 
+        const VectorND<6>& , VectorND<6>& , VectorND<6>& , VectorND<6>& , VectorND<6>& , double& , double& ,  double& , double& , 
+        MatrixND<6,6>& , MatrixND<6,6>& , MatrixND<6,6>& ) ;
     
     switch (mScheme) {
         case INT_MAXSTR_FE    : // Forward Euler constraining maximum strain increment
@@ -1070,19 +1169,22 @@ void ManzariDafalias::MaxStrainInc(const Vector& CurStress, const Vector& CurStr
     
     NextDGamma = 0;
 
-    Vector StrainInc(6); StrainInc = NextStrain - CurStrain;
-    double maxInc = StrainInc(0);
+    // StrainInc = NextStrain - CurStrain;
+    VectorND<6> StrainInc;
+    StrainInc = NextStrain; StrainInc -= CurStrain;
+    double maxInc = StrainInc[0];
     for(int ii=1; ii < 6; ii++)
-        if(fabs(StrainInc(ii)) > fabs(maxInc)) 
-            maxInc = StrainInc(ii);
+        if(fabs(StrainInc[ii]) > fabs(maxInc)) 
+            maxInc = StrainInc[ii];
     if (fabs(maxInc) > maxStrainInc){
         int numSteps = (int)floor(fabs(maxInc) / maxStrainInc) + 1;
-        StrainInc = (NextStrain - CurStrain) / numSteps;    
+        // StrainInc = (NextStrain - CurStrain) / numSteps;    
+        StrainInc /= numSteps;
     
-        Vector cStress(6), cStrain(6), cAlpha(6), cFabric(6), cAlpha_in(6), cEStrain(6);
-        Vector nStrain(6) ,nEStrain(6), nStress(6), nAlpha(6), nFabric(6), nAlpha_in(6);
-        Matrix nCe(6,6), nCep(6,6), nCepC(6,6);
-        double nDGamma, nVoidRatio, nG, nK;
+        VectorND<6> cStress, cStrain, cAlpha, cFabric, cAlpha_in, cEStrain;
+        VectorND<6> nStrain, nEStrain, nStress, nAlpha, nFabric;
+        MatrixND<6,6> nCe, nCep, nCepC;
+        double nDGamma, nVoidRatio, nG = G, nK = K;
                 
         // create temporary variables
         cStress = CurStress; cStrain = CurStrain; cAlpha = CurAlpha; cFabric = CurFabric;
@@ -1091,7 +1193,8 @@ void ManzariDafalias::MaxStrainInc(const Vector& CurStress, const Vector& CurStr
         
         for(int ii = 1; ii <= numSteps; ii++)
         {
-            nStrain = cStrain + StrainInc;
+            // nStrain = cStrain + StrainInc;
+            nStrain = cStrain; nStrain += StrainInc;
 
             (this->*exp_int)(cStress, cStrain, cEStrain, cAlpha, cFabric, cAlpha_in, nStrain, 
             nEStrain, nStress, nAlpha, nFabric, nDGamma, nVoidRatio, nG, nK, nCe, nCep, nCepC);
@@ -1104,16 +1207,18 @@ void ManzariDafalias::MaxStrainInc(const Vector& CurStress, const Vector& CurStr
         NextAlpha            = nAlpha;
         NextFabric            = nFabric;
 
-        Vector n(6), d(6), b(6), R(6), dPStrain(6); 
+        VectorND<6> n, d, b, R, dPStrain; 
         double Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, B, C, D;
         GetStateDependent(NextStress, NextAlpha, NextFabric, NextVoidRatio, alpha_in, n, d, b, Cos3Theta, h, psi, alphaBtheta, 
                 alphaDtheta, b0,A, D, B, C, R);
     
-        dPStrain     = CurElasticStrain + (NextStrain - CurStrain) - NextElasticStrain;
-        NextDGamma   = dPStrain.Norm() / R.Norm();
+        // dPStrain     = CurElasticStrain + (NextStrain - CurStrain) - NextElasticStrain;
+        for (int i = 0; i < 6; i++)
+            dPStrain[i] = CurElasticStrain[i] + (NextStrain[i] - CurStrain[i]) - NextElasticStrain[i];
+        NextDGamma   = dPStrain.norm() / R.norm();
 
         aC    = nCe;
-        aCep  = GetElastoPlasticTangent(NextStress, NextDGamma, CurStrain, NextStrain, G, K, B, C, D, h, n, d, b);
+        GetElastoPlasticTangent(NextStress, NextDGamma, G, K, B, C, D, h, n, b, aCep);
         aCep_Consistent = aCep;
 
     } else {
@@ -1124,15 +1229,15 @@ void ManzariDafalias::MaxStrainInc(const Vector& CurStress, const Vector& CurStr
 }
 
 
-void ManzariDafalias::MaxEnergyInc(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-        const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
-        Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) 
+void ManzariDafalias::MaxEnergyInc(const VectorND<6>& CurStress, const VectorND<6>& CurStrain, const VectorND<6>& CurElasticStrain,
+        const VectorND<6>& CurAlpha, const VectorND<6>& CurFabric, const VectorND<6>& alpha_in, const VectorND<6>& NextStrain,
+        VectorND<6>& NextElasticStrain, VectorND<6>& NextStress, VectorND<6>& NextAlpha, VectorND<6>& NextFabric,
+        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, MatrixND<6,6>& aC, MatrixND<6,6>& aCep, MatrixND<6,6>& aCep_Consistent) 
 {    
     // function pointer to the integration scheme
-    void (ManzariDafalias::*exp_int) (const Vector& , const Vector& , const Vector& , const Vector& , const Vector& , const Vector& , 
-        const Vector& ,    Vector& , Vector& , Vector& , Vector& , double& , double& ,  double& , double& , 
-        Matrix& , Matrix& , Matrix& ) ;
+    void (ManzariDafalias::*exp_int) (const VectorND<6>& , const VectorND<6>& , const VectorND<6>& , const VectorND<6>& , const VectorND<6>& , const VectorND<6>& , 
+        const VectorND<6>& , VectorND<6>& , VectorND<6>& , VectorND<6>& , VectorND<6>& , double& , double& ,  double& , double& , 
+        MatrixND<6,6>& , MatrixND<6,6>& , MatrixND<6,6>& ) ;
     
     switch (mScheme) {
         case INT_MAXENE_FE    : // Forward Euler constraining maximum energy increment
@@ -1158,21 +1263,20 @@ void ManzariDafalias::MaxEnergyInc(const Vector& CurStress, const Vector& CurStr
             NextElasticStrain, NextStress, NextAlpha, NextFabric, NextDGamma, NextVoidRatio, 
             G, K, aC, aCep, aCep_Consistent);
     
-    
-    
+    VectorND<6> StrainInc, StressInc;
+    StrainInc = NextStrain; StrainInc -= CurStrain;
+    StressInc = NextStress; StressInc -= CurStress;
 
-    if ((DoubleDot2_2_Mixed(NextStrain - CurStrain, NextStress - CurStress) > TolE))     // || (DoubleDot2_2_Mixed(NextStress - CurStress, NextStress - CurStress) > TolE))
+    if ((DoubleDot2_2_Mixed(StrainInc, StressInc) > TolE))     // || (DoubleDot2_2_Mixed(NextStress - CurStress, NextStress - CurStress) > TolE))
     {
         if (debugFlag) opserr << "******* Energy Inc > tol --> use sub-stepping" << endln;
-        Vector StrainInc(6); StrainInc = NextStrain - CurStrain;
-        StrainInc = (NextStrain - CurStrain) / 2;    
+        // StrainInc = (NextStrain - CurStrain) / 2;    
+        StrainInc /= 2;
     
-        Vector cStress(6), cStrain(6), cAlpha(6), cFabric(6), cAlpha_in(6), cEStrain(6);
-        Vector nStrain(6) ,nEStrain(6), nStress(6), nAlpha(6), nFabric(6), nAlpha_in(6);
-        Matrix nCe(6,6), nCep(6,6), nCepC(6,6);
-        double nDGamma, nVoidRatio, nG, nK;
-        Vector n(6), d(6), b(6), R(6), dPStrain(6); 
-        //double Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, B, C, D;
+        VectorND<6> cStress, cStrain, cAlpha, cFabric, cAlpha_in, cEStrain;
+        VectorND<6> nStrain, nEStrain, nStress, nAlpha, nFabric;
+        MatrixND<6,6> nCe, nCep, nCepC;
+        double nDGamma, nVoidRatio, nG = G, nK = K;
                 
         // create temporary variables
         cStress = CurStress; cStrain = CurStrain; cAlpha = CurAlpha; cFabric = CurFabric;
@@ -1181,7 +1285,8 @@ void ManzariDafalias::MaxEnergyInc(const Vector& CurStress, const Vector& CurStr
         
         for(int ii=1; ii <= 2; ii++)
         {
-            nStrain = cStrain + StrainInc;
+            // nStrain = cStrain + StrainInc;
+            nStrain = cStrain; nStrain += StrainInc;
 
             (this->*exp_int)(cStress, cStrain, cEStrain, cAlpha, cFabric, cAlpha_in, nStrain, 
             nEStrain, nStress, nAlpha, nFabric, nDGamma, nVoidRatio, nG, nK, nCe, nCep, nCepC);
@@ -1194,15 +1299,6 @@ void ManzariDafalias::MaxEnergyInc(const Vector& CurStress, const Vector& CurStr
         NextAlpha            = nAlpha;
         NextFabric            = nFabric;
         
-        //GetStateDependent(NextStress, NextAlpha, NextFabric, NextVoidRatio, alpha_in, n, d, b, Cos3Theta, h, psi, alphaBtheta, 
-        //        alphaDtheta, b0, A, D, B, C, R);
-        //
-        //dPStrain     = CurElasticStrain + (NextStrain - CurStrain) - NextElasticStrain;
-        //NextDGamma   = dPStrain.Norm() / (R.Norm() == 0 ? 1.0 : R.Norm());
-        //GetElasticModuli(NextStress, NextVoidRatio, K, G);
-        //aC = GetStiffness(K, G);
-        //aCep = GetElastoPlasticTangent(NextStress, NextDGamma, CurStrain, NextStrain, G, K, B, C, D, h, n, d, b);
-        //aCep_Consistent = aCep;
         aC = nCe;
         aCep = nCep;
         aCep_Consistent = nCepC;
@@ -1215,76 +1311,122 @@ void ManzariDafalias::ForwardEuler(const Vector& CurStress, const Vector& CurStr
         Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
         double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) 
 {    
+    VectorND<6> curStress, curStrain, curElasticStrain, curAlpha, curFabric, alphaIn, nextStrain;
+    VectorND<6> nextElasticStrain, nextStress, nextAlpha, nextFabric;
+    MatrixND<6,6> C, Cep, Cep_Consistent;
+
+    assign(curStress, CurStress);
+    assign(curStrain, CurStrain);
+    assign(curElasticStrain, CurElasticStrain);
+    assign(curAlpha, CurAlpha);
+    assign(curFabric, CurFabric);
+    assign(alphaIn, alpha_in);
+    assign(nextStrain, NextStrain);
+
+    ForwardEuler(curStress, curStrain, curElasticStrain, curAlpha, curFabric, alphaIn, nextStrain,
+        nextElasticStrain, nextStress, nextAlpha, nextFabric, NextDGamma, NextVoidRatio, G, K, C, Cep, Cep_Consistent);
+
+    assign(NextElasticStrain, nextElasticStrain);
+    assign(NextStress, nextStress);
+    assign(NextAlpha, nextAlpha);
+    assign(NextFabric, nextFabric);
+    assign(aC, C);
+    assign(aCep, Cep);
+    assign(aCep_Consistent, Cep_Consistent);
+}
+
+
+void ManzariDafalias::ForwardEuler(const VectorND<6>& CurStress, const VectorND<6>& CurStrain, const VectorND<6>& CurElasticStrain,
+        const VectorND<6>& CurAlpha, const VectorND<6>& CurFabric, const VectorND<6>& alpha_in, const VectorND<6>& NextStrain,
+        VectorND<6>& NextElasticStrain, VectorND<6>& NextStress, VectorND<6>& NextAlpha, VectorND<6>& NextFabric,
+        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, MatrixND<6,6>& aC, MatrixND<6,6>& aCep, MatrixND<6,6>& aCep_Consistent) 
+{    
+    VectorND<6> n, d, b, R, r, nn, dStrain, dDevStrain, cDevStrain, cR, temp2, temp3;
+    double Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, B, C, D;
+
     double CurVoidRatio = m_e_init - (1 + m_e_init) * GetTrace(CurStrain);
     NextVoidRatio     = m_e_init - (1 + m_e_init) * GetTrace(NextStrain);
-    NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain);
-    aC = GetStiffness(K, G);
-    Vector n(6), d(6), b(6), R(6), dPStrain(6); 
-    double Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, B, C, D;
+    dStrain = NextStrain; dStrain -= CurStrain;
+    GetStiffness(K, G, aC);
     GetStateDependent(CurStress, CurAlpha, CurFabric, CurVoidRatio, alpha_in, n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0,
         A, D, B, C, R);
-    double dVolStrain = GetTrace(NextStrain - CurStrain);
-    Vector dDevStrain = GetDevPart(NextStrain - CurStrain);
+    double dVolStrain = GetTrace(dStrain);
+    dDevStrain = GetDevPart(dStrain);
     double p = one3 * GetTrace(CurStress) + m_Presidual;
 
-    Vector r(6);
-    if (p > small)
-        Vector r = GetDevPart(CurStress) / p;
+    // the Vector form declared r a second time inside "if (p > small)",
+    // so the stress ratio has always entered this scheme as zero
+    r.zero();
 
     double Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
     
-    double temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n)))) 
+    nn = SingleDot(n, n);
+    double temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,nn))) 
         - K*D*DoubleDot2_2_Contr(n,r));
 
     // TODO: if temp4 == 0, the whole step is plastic. Take correct steps here.
     if (fabs(temp4) < small) temp4 = small;
 
     NextDGamma      = (2.0*G*DoubleDot2_2_Mixed(n,dDevStrain) - K*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
-    Vector dSigma   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1 - Macauley(NextDGamma)*
-              (2.0*G*(B*n-C*(SingleDot(n,n)-one3*mI1)) + K*D*mI1);
-    Vector dAlpha   = Macauley(NextDGamma) * two3 * h * b;
-    Vector dFabric  = -1.0 * Macauley(NextDGamma) * m_cz * Macauley(-1.0*D) * (m_z_max * n + CurFabric);
-           dPStrain = NextDGamma * ToCovariant(R);
 
-    Matrix temp1 = 2.0*G*mIIdevMix + K*mIIvol;
-    Vector temp2 = 2.0*G*n - DoubleDot2_2_Contr(n,r)*mI1;
-    Vector temp3 = 2.0*G*(B*n-C*(SingleDot(n,n)-one3*mI1)) + K*D*mI1;
+    // dSigma   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1 - Macauley(NextDGamma)*
+    //           (2.0*G*(B*n-C*(SingleDot(n,n)-one3*mI1)) + K*D*mI1);
+    // dAlpha   = Macauley(NextDGamma) * two3 * h * b;
+    // dFabric  = -1.0 * Macauley(NextDGamma) * m_cz * Macauley(-1.0*D) * (m_z_max * n + CurFabric);
+    // dPStrain = NextDGamma * ToCovariant(R);
+    const double mac = Macauley(NextDGamma);
+    const double fab = -1.0 * mac * m_cz * Macauley(-1.0*D);
+    const double nr  = DoubleDot2_2_Contr(n,r);
+    cDevStrain = ToContraviant(dDevStrain);
+    cR = ToCovariant(R);
+    for (int i = 0; i < 6; i++) {
+        temp2[i] = 2.0*G*n[i] - nr*I1[i];
+        temp3[i] = 2.0*G*(B*n[i]-C*(nn[i]-one3*I1[i])) + K*D*I1[i];
+
+        NextElasticStrain[i] = CurElasticStrain[i] + dStrain[i] - NextDGamma * cR[i];
+        NextStress[i] = CurStress[i] + (2.0*G*cDevStrain[i] + K*dVolStrain*I1[i] - mac*temp3[i]);
+        NextAlpha[i]  = CurAlpha[i]  + mac * two3 * h * b[i];
+        NextFabric[i] = CurFabric[i] + fab * (m_z_max * n[i] + CurFabric[i]);
+    }
 
-    aCep = temp1 - MacauleyIndex(NextDGamma) * Dyadic2_2(temp3, temp2) / temp4;
+    // aCep = 2.0*G*mIIdevMix + K*mIIvol - MacauleyIndex(NextDGamma) * Dyadic2_2(temp3, temp2) / temp4;
+    const double macIndex = MacauleyIndex(NextDGamma);
+    for (int j = 0; j < 6; j++)
+        for (int i = 0; i < 6; i++)
+            aCep(i,j) = (2.0*G*mIIdevMix(i,j) + K*mIIvol(i,j)) - macIndex*(temp3[i]*temp2[j]) * (1.0/temp4);
     aCep_Consistent = aCep;
 
-    NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain) - dPStrain;
-    NextStress = CurStress + dSigma;
-    NextAlpha  = CurAlpha  + dAlpha;
-    NextFabric = CurFabric + dFabric;
-
     return;
 }
 
 
-void ManzariDafalias::ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-        const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
-        Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) 
-{    
+void ManzariDafalias::ModifiedEuler(const VectorND<6>& CurStress, const VectorND<6>& CurStrain, const VectorND<6>& CurElasticStrain,
+        const VectorND<6>& CurAlpha, const VectorND<6>& CurFabric, const VectorND<6>& alpha_in, const VectorND<6>& NextStrain,
+        VectorND<6>& NextElasticStrain, VectorND<6>& NextStress, VectorND<6>& NextAlpha, VectorND<6>& NextFabric,
+        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, MatrixND<6,6>& aC, MatrixND<6,6>& aCep, MatrixND<6,6>& aCep_Consistent)
+{
     double dVolStrain;
-    Vector n(6), d(6), b(6), R(6), dDevStrain(6), r(6), dStrain(6), tmp0(6), tmp1(6), tmp2(6), tmp3(6);
+    VectorND<6> n, d, b, R, dDevStrain, r, dStrain, tmp0, tmp1, tmp2, tmp3;
     double Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0,A, B, C, D, p, Kp;
 
     double T = 0.0, dT = 1.0, dT_min = 1e-6 , TolE = 1e-4;
-    
-    Vector nStress(6), nAlpha(6), nFabric(6), ndPStrain(6);
-    Vector dSigma1(6), dSigma2(6), dAlpha1(6), dAlpha2(6), dFabric1(6), dFabric2(6),
-           dPStrain1(6), dPStrain2(6);
-    Matrix aCep1(6,6), aCep2(6,6), aCep_thisStep(6,6), aD(6,6);
+
+    VectorND<6> nStress, nAlpha, nFabric;
+    VectorND<6> dSigma1, dSigma2, dAlpha1, dAlpha2, dFabric1, dFabric2,
+           dPStrain1, dPStrain2;
+    MatrixND<6,6> aCep1, aCep2, aCep_thisStep, aD, aTmp;
     double temp4, curStepError, q = 1.0;
 
+    // aCep1 is not updated by a neutral first step
+    aCep1.zero();
+    aCep2.zero();
+
     // NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain);
 	dStrain = NextStrain; dStrain -= CurStrain;
 	NextElasticStrain = CurElasticStrain; NextElasticStrain += dStrain;
 
-    aC = GetStiffness(K, G);
-    aD = GetCompliance(K, G);
+    GetStiffness(K, G, aC);
+    GetCompliance(K, G, aD);
 
     NextStress = CurStress;
     NextAlpha = CurAlpha;
@@ -1294,65 +1436,75 @@ void ManzariDafalias::ModifiedEuler(const Vector& CurStress, const Vector& CurSt
     if (p < m_Pmin + m_Presidual)
     {
         if (debugFlag)
-            opserr << "Tag = " << this->getTag() << " : I have a problem (p < 0) - This should not happen!!!" << endln;        
-        NextStress = GetDevPart(NextStress) + m_Pmin * mI1;
+            opserr << "Tag = " << this->getTag() << " : I have a problem (p < 0) - This should not happen!!!" << endln;
+        // NextStress = GetDevPart(NextStress) + m_Pmin * mI1;
+		NextStress = GetDevPart(NextStress);
+		for (int i = 0; i < 3; i++)
+			NextStress[i] += m_Pmin;
 		p = m_Pmin;
     }
     // Set aCep_Consistent to zero for substepping process
-    aCep_Consistent.Zero();
+    aCep_Consistent.zero();
 
     while (T < 1.0)
     {
         // NextVoidRatio     = m_e_init - (1 + m_e_init) * GetTrace(NextStrain + T * (NextStrain - CurStrain));
 		tmp0 = dStrain; tmp0 *= T; tmp0 += NextStrain;
 		NextVoidRatio = m_e_init - (1 + m_e_init) * GetTrace(tmp0);
-        
+
         // dVolStrain = dT * GetTrace(NextStrain - CurStrain);
         // dDevStrain = dT * GetDevPart(NextStrain - CurStrain);
 		dVolStrain = dT * GetTrace(dStrain);
-		dDevStrain = dT * GetDevPart(dStrain);
+		dDevStrain = GetDevPart(dStrain); dDevStrain *= dT;
 
         // Calc Delta 1
         p = one3 * GetTrace(NextStress) + m_Presidual;
-        GetStateDependent(NextStress, NextAlpha, NextFabric, NextVoidRatio, alpha_in, n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, 
+        GetStateDependent(NextStress, NextAlpha, NextFabric, NextVoidRatio, alpha_in, n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta,
                 b0, A, D, B, C, R);
 
         // r = GetDevPart(NextStress) / p;
 		r = GetDevPart(NextStress); r /= p;
         Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
 
-        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n)))) 
+        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n))))
             - K*D*DoubleDot2_2_Contr(n,r));
 
-        if (fabs(temp4) < small) 
+        if (fabs(temp4) < small)
         {
             // Neutral loading
-            dSigma1.Zero();
-            dAlpha1.Zero();
-            dFabric1.Zero();
-            dPStrain1 = dDevStrain + dVolStrain*mI1;
-            
+            dSigma1.zero();
+            dAlpha1.zero();
+            dFabric1.zero();
+            // dPStrain1 = dDevStrain + dVolStrain*mI1;
+			dPStrain1 = I1; dPStrain1 *= dVolStrain; dPStrain1 += dDevStrain;
+
         } else {
             NextDGamma      = (2.0*G*DoubleDot2_2_Mixed(n,dDevStrain) - K*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
-             
+
             if (NextDGamma < -small)
             {
                if (debugFlag)
                     opserr << "dGamma cannot be negative! This should not happen. Setting dGamma = 0." << endln;
                 NextDGamma = 0.0;
-                dSigma1   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1;
-                dAlpha1   = 3.0*(GetDevPart(NextStress + dSigma1) / GetTrace(NextStress + dSigma1) - GetDevPart(NextStress) / GetTrace(NextStress)) ;
-                dFabric1.Zero();
-                dPStrain1.Zero();
+                // dSigma1   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1;
+				dSigma1 = ToContraviant(dDevStrain); dSigma1 *= (2.0 * G);
+				tmp0 = I1; tmp0 *= (K * dVolStrain); dSigma1 += tmp0;
+                // dAlpha1   = 3.0*(GetDevPart(NextStress + dSigma1) / GetTrace(NextStress + dSigma1) - GetDevPart(NextStress) / GetTrace(NextStress)) ;
+				tmp0 = NextStress; tmp0 += dSigma1;
+				dAlpha1 = GetDevPart(tmp0); dAlpha1 /= GetTrace(tmp0);
+				tmp1 = GetDevPart(NextStress); tmp1 /= GetTrace(NextStress);
+				dAlpha1 -= tmp1; dAlpha1 *= 3.0;
+                dFabric1.zero();
+                dPStrain1.zero();
                 mUseElasticTan = true;
             } else {
                 // dSigma1   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1 - Macauley(NextDGamma)*
                 //   (2.0*G*(B*n-C*(SingleDot(n,n)-1.0/3.0*mI1)) + K*D*mI1);
-				tmp0 = mI1; tmp0 *= (K * dVolStrain);
+				tmp0 = I1; tmp0 *= (K * dVolStrain);
 				tmp1 = n; tmp1 *= B;
-				tmp2 = mI1; tmp2 *= (-1.0 / 3.0); tmp2 += SingleDot(n, n); tmp2 *= C;
+				tmp2 = I1; tmp2 *= (-1.0 / 3.0); tmp2 += SingleDot(n, n); tmp2 *= C;
 				tmp1 -= tmp2; tmp1 *= (2.0 *G);
-				tmp3 = mI1; tmp3 *= (K * D); tmp1 += tmp3; tmp1 *= (-Macauley(NextDGamma));
+				tmp3 = I1; tmp3 *= (K * D); tmp1 += tmp3; tmp1 *= (-Macauley(NextDGamma));
 				dSigma1 = ToContraviant(dDevStrain); dSigma1 *= (2.0 * G);
 				dSigma1 += tmp0; dSigma1 += tmp1;
 
@@ -1366,7 +1518,9 @@ void ManzariDafalias::ModifiedEuler(const Vector& CurStress, const Vector& CurSt
                 // dPStrain1 = NextDGamma * ToCovariant(R);
 				dPStrain1 = ToCovariant(R); dPStrain1 *= NextDGamma;
             }
-            aCep1 = GetElastoPlasticTangent(NextStress + dSigma1, NextDGamma, CurStrain, NextStrain, G, K, B, C, D, h, n, d, b);
+            // aCep1 = GetElastoPlasticTangent(NextStress + dSigma1, NextDGamma, CurStrain, NextStrain, G, K, B, C, D, h, n, d, b);
+			tmp0 = NextStress; tmp0 += dSigma1;
+			GetElastoPlasticTangent(tmp0, NextDGamma, G, K, B, C, D, h, n, b, aCep1);
         }
 
         // Calc Delta 2
@@ -1381,28 +1535,29 @@ void ManzariDafalias::ModifiedEuler(const Vector& CurStress, const Vector& CurSt
             dT = fmax(0.1 * dT, dT_min);
             continue;
         }
-            
+
         // GetStateDependent(NextStress + dSigma1, NextAlpha + dAlpha1, NextFabric + dFabric1, NextVoidRatio, alpha_in, n, d, b,
         //         Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, D, B, C, R);
-		tmp1.Zero();  tmp1 += NextAlpha; tmp1 += dAlpha1;  // tmp1 is NextAlpha + dAlpha1 until calculating dSigma2
-		tmp2.Zero();  tmp2 += NextFabric; tmp2 += dFabric1;  // tmp2 is NextFabric + dFabric1 until calculating dSigma2
+		tmp1 = NextAlpha; tmp1 += dAlpha1;  // tmp1 is NextAlpha + dAlpha1 until calculating dSigma2
+		tmp2 = NextFabric; tmp2 += dFabric1;  // tmp2 is NextFabric + dFabric1 until calculating dSigma2
 		GetStateDependent(tmp0, tmp1, tmp2, NextVoidRatio, alpha_in, n, d, b,
 			Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, D, B, C, R);
         // r = GetDevPart(NextStress + dSigma1) / p;
 		r = GetDevPart(tmp0); r /= p;
         Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
-        
-        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n)))) 
+
+        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n))))
             - K*D*DoubleDot2_2_Contr(n,r));
 
-        if (fabs(temp4) < small) 
+        if (fabs(temp4) < small)
         {
             // Neutral loading
-            dSigma2.Zero();
-            dAlpha2.Zero();
-            dFabric2.Zero();
-            dPStrain2 = dDevStrain + dVolStrain*mI1;
-        
+            dSigma2.zero();
+            dAlpha2.zero();
+            dFabric2.zero();
+            // dPStrain2 = dDevStrain + dVolStrain*mI1;
+			dPStrain2 = I1; dPStrain2 *= dVolStrain; dPStrain2 += dDevStrain;
+
         } else {
 
             NextDGamma      = (2.0*G*DoubleDot2_2_Mixed(n,dDevStrain) - K*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
@@ -1410,19 +1565,25 @@ void ManzariDafalias::ModifiedEuler(const Vector& CurStress, const Vector& CurSt
             if (NextDGamma < 0.0)
             {
                 NextDGamma = 0.0;
-                dSigma2   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1;
-                dAlpha2   = 3.0*(GetDevPart(NextStress + dSigma2) / GetTrace(NextStress + dSigma2) - GetDevPart(NextStress) / GetTrace(NextStress)) ;
-                dFabric2.Zero();
-                dPStrain2.Zero();
+                // dSigma2   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1;
+				dSigma2 = ToContraviant(dDevStrain); dSigma2 *= (2.0 * G);
+				tmp0 = I1; tmp0 *= (K * dVolStrain); dSigma2 += tmp0;
+                // dAlpha2   = 3.0*(GetDevPart(NextStress + dSigma2) / GetTrace(NextStress + dSigma2) - GetDevPart(NextStress) / GetTrace(NextStress)) ;
+				tmp0 = NextStress; tmp0 += dSigma2;
+				dAlpha2 = GetDevPart(tmp0); dAlpha2 /= GetTrace(tmp0);
+				tmp1 = GetDevPart(NextStress); tmp1 /= GetTrace(NextStress);
+				dAlpha2 -= tmp1; dAlpha2 *= 3.0;
+                dFabric2.zero();
+                dPStrain2.zero();
                 mUseElasticTan = true;
             } else {
                 // dSigma2   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1 - Macauley(NextDGamma)*
                 //   (2.0*G*(B*n-C*(SingleDot(n,n)-1.0/3.0*mI1)) + K*D*mI1);
-				tmp0 = mI1; tmp0 *= (K * dVolStrain);
+				tmp0 = I1; tmp0 *= (K * dVolStrain);
 				tmp1 = n; tmp1 *= B;
-				tmp2 = mI1; tmp2 *= (-1.0 / 3.0); tmp2 += SingleDot(n, n); tmp2 *= C;
+				tmp2 = I1; tmp2 *= (-1.0 / 3.0); tmp2 += SingleDot(n, n); tmp2 *= C;
 				tmp1 -= tmp2; tmp1 *= (2.0 *G);
-				tmp3 = mI1; tmp3 *= (K * D); tmp1 += tmp3; tmp1 *= (-Macauley(NextDGamma));
+				tmp3 = I1; tmp3 *= (K * D); tmp1 += tmp3; tmp1 *= (-Macauley(NextDGamma));
 				dSigma2 = ToContraviant(dDevStrain); dSigma2 *= (2.0 * G);
 				dSigma2 += tmp0; dSigma2 += tmp1;
 
@@ -1438,8 +1599,10 @@ void ManzariDafalias::ModifiedEuler(const Vector& CurStress, const Vector& CurSt
 				dPStrain2 = ToCovariant(R);  dPStrain2 *= NextDGamma;
             }
         }
-        
-        aCep2 = GetElastoPlasticTangent(NextStress + dSigma1, NextDGamma, CurStrain, NextStrain, G, K, B, C, D, h, n, d, b);
+
+        // aCep2 = GetElastoPlasticTangent(NextStress + dSigma1, NextDGamma, CurStrain, NextStrain, G, K, B, C, D, h, n, d, b);
+		tmp0 = NextStress; tmp0 += dSigma1;
+		GetElastoPlasticTangent(tmp0, NextDGamma, G, K, B, C, D, h, n, b, aCep2);
 
         // nStress = NextStress + 0.5 * (dSigma1 + dSigma2);
         // nAlpha  = NextAlpha  + 0.5 * (dAlpha1 + dAlpha2);
@@ -1458,7 +1621,7 @@ void ManzariDafalias::ModifiedEuler(const Vector& CurStress, const Vector& CurSt
 		nAlpha += NextAlpha;
 
         p = one3 * GetTrace(nStress) + m_Presidual;
-        
+
         if (p < m_Presidual)
         {
             if (dT == dT_min)
@@ -1472,15 +1635,15 @@ void ManzariDafalias::ModifiedEuler(const Vector& CurStress, const Vector& CurSt
             if (stressNorm < 0.5)
                 // curStepError = GetNorm_Contr(dSigma2 - dSigma1);
 				curStepError = GetNorm_Contr(tmp0);
-            else 
+            else
                 // curStepError = GetNorm_Contr(dSigma2 - dSigma1) / (2 * stressNorm);
 				curStepError = GetNorm_Contr(tmp0) / (2 * stressNorm);
-        
+
         if (curStepError > TolE)
         {
-            if (debugFlag) 
+            if (debugFlag)
                 opserr << "--- Unsuccessful increment (tag = " << this->getTag() << "): Error =  " << curStepError << endln;
-            if (debugFlag) 
+            if (debugFlag)
                 opserr << "                           T = " << T << ", dT = " << dT << endln;
             q = fmax(0.8 * sqrt(TolE / curStepError), 0.1);
 
@@ -1492,16 +1655,24 @@ void ManzariDafalias::ModifiedEuler(const Vector& CurStress, const Vector& CurSt
 				NextElasticStrain -= tmp0;
                 NextStress = nStress;
                 double eta = sqrt(13.5) * GetNorm_Contr(GetDevPart(NextStress)) / GetTrace(NextStress);
-                if (eta > m_Mc)
-                    NextStress = one3 * GetTrace(NextStress) * mI1 + m_Mc / eta * GetDevPart(NextStress);
-                NextAlpha  = CurAlpha + 3.0 * (GetDevPart(NextStress)/GetTrace(NextStress) - GetDevPart(CurStress)/GetTrace(CurStress));
-                
+                if (eta > m_Mc) {
+                    // NextStress = one3 * GetTrace(NextStress) * mI1 + m_Mc / eta * GetDevPart(NextStress);
+					tmp0 = GetDevPart(NextStress); tmp0 *= (m_Mc / eta);
+					tmp1 = I1; tmp1 *= (one3 * GetTrace(NextStress));
+					NextStress = tmp1; NextStress += tmp0;
+                }
+                // NextAlpha  = CurAlpha + 3.0 * (GetDevPart(NextStress)/GetTrace(NextStress) - GetDevPart(CurStress)/GetTrace(CurStress));
+				tmp0 = GetDevPart(NextStress); tmp0 /= GetTrace(NextStress);
+				tmp1 = GetDevPart(CurStress); tmp1 /= GetTrace(CurStress);
+				tmp0 -= tmp1; tmp0 *= 3.0;
+				NextAlpha = CurAlpha; NextAlpha += tmp0;
+
                 T += dT;
             }
             dT = fmax(q * dT, dT_min);
         } else {
-            
-            if (debugFlag) 
+
+            if (debugFlag)
                 opserr << "+++ Successful increment: T = " << T << ", dT = " << dT << endln;
 
 			// NextElasticStrain -= 0.5* (dPStrain1 + dPStrain2);
@@ -1513,14 +1684,28 @@ void ManzariDafalias::ModifiedEuler(const Vector& CurStress, const Vector& CurSt
 
             Stress_Correction(CurStress, CurStrain, CurElasticStrain, CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain, NextStress,
                 NextAlpha, NextFabric, NextDGamma, NextVoidRatio, G, K, aC, aCep, aCep_Consistent);
-            
+
             T += dT;
 
             // aCep_thisStep = 0.5 * (aCep1 + aCep2);
 			aCep_thisStep = aCep1; aCep_thisStep += aCep2;
 			aCep_thisStep *= 0.5;
-            aCep_Consistent = aCep_thisStep * (aD * aCep_Consistent + T * mIImix);
-        
+            // aCep_Consistent = aCep_thisStep * (aD * aCep_Consistent + T * mIImix);
+			for (int j = 0; j < 6; j++)
+				for (int i = 0; i < 6; i++) {
+					double sum = T * mIImix(i,j);
+					for (int k = 0; k < 6; k++)
+						sum += aD(i,k) * aCep_Consistent(k,j);
+					aTmp(i,j) = sum;
+				}
+			for (int j = 0; j < 6; j++)
+				for (int i = 0; i < 6; i++) {
+					double sum = 0.0;
+					for (int k = 0; k < 6; k++)
+						sum += aCep_thisStep(i,k) * aTmp(k,j);
+					aCep_Consistent(i,j) = sum;
+				}
+
             q = fmax(0.8 * sqrt(TolE / curStepError), 0.5);
             dT = fmax(q * dT, dT_min);
             dT = fmin(dT, 1 - T);
@@ -1530,29 +1715,31 @@ void ManzariDafalias::ModifiedEuler(const Vector& CurStress, const Vector& CurSt
 }
 
 
-void ManzariDafalias::RungeKutta4(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-        const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
-        Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) 
+void ManzariDafalias::RungeKutta4(const VectorND<6>& CurStress, const VectorND<6>& CurStrain, const VectorND<6>& CurElasticStrain,
+        const VectorND<6>& CurAlpha, const VectorND<6>& CurFabric, const VectorND<6>& alpha_in, const VectorND<6>& NextStrain,
+        VectorND<6>& NextElasticStrain, VectorND<6>& NextStress, VectorND<6>& NextAlpha, VectorND<6>& NextFabric,
+        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, MatrixND<6,6>& aC, MatrixND<6,6>& aCep, MatrixND<6,6>& aCep_Consistent) 
 {    
     double CurVoidRatio, dVolStrain;
-    Vector n(6), d(6), b(6), R(6), dDevStrain(6), r(6); 
+    VectorND<6> n, d, b, R, dStrain, dDevStrain, cDevStrain, r, nn, cR, tmp0;
     double Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0,A, B, C, D, p, Kp;
 
     double T = 0.0, dT = 1.0;
-    Vector nStress(6), nAlpha(6), nFabric(6), ndPStrain(6);
-    Vector dSigma1(6), dSigma2(6), dSigma3(6), dSigma4(6), dSigma(6), 
-        dAlpha1(6), dAlpha2(6), dAlpha3(6), dAlpha4(6), dAlpha(6), 
-        dFabric1(6), dFabric2(6), dFabric3(6), dFabric4(6), dFabric(6),
-        dPStrain1(6), dPStrain2(6), dPStrain3(6), dPStrain4(6), dPStrain(6);
-    double temp4, q;
+    VectorND<6> thisSigma, thisAlpha, thisFabric;
+    VectorND<6> dSigma1, dSigma2, dSigma3, dSigma4,
+        dAlpha1, dAlpha2, dAlpha3, dAlpha4,
+        dFabric1, dFabric2, dFabric3, dFabric4,
+        dPStrain1, dPStrain2, dPStrain3, dPStrain4;
+    double temp4, q, mac, fab;
     
     CurVoidRatio      = m_e_init - (1 + m_e_init) * GetTrace(CurStrain);
     NextVoidRatio     = m_e_init - (1 + m_e_init) * GetTrace(NextStrain);
-    NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain);
+    // NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain);
+    dStrain = NextStrain; dStrain -= CurStrain;
+    NextElasticStrain = CurElasticStrain; NextElasticStrain += dStrain;
 
     GetElasticModuli(CurStress, CurVoidRatio, K, G);
-    aC = GetStiffness(K, G);
+    GetStiffness(K, G, aC);
 
     NextStress = CurStress;
     NextAlpha = CurAlpha;
@@ -1560,141 +1747,149 @@ void ManzariDafalias::RungeKutta4(const Vector& CurStress, const Vector& CurStra
 
     while (T < 1.0)
     {
-        NextVoidRatio     = m_e_init - (1 + m_e_init) * GetTrace(NextStrain + T * (NextStrain - CurStrain));
-        
-        dVolStrain = dT * GetTrace(NextStrain - CurStrain);
-        dDevStrain = dT * GetDevPart(NextStrain - CurStrain);
+        // NextVoidRatio     = m_e_init - (1 + m_e_init) * GetTrace(NextStrain + T * (NextStrain - CurStrain));
+        tmp0 = dStrain; tmp0 *= T; tmp0 += NextStrain;
+        NextVoidRatio     = m_e_init - (1 + m_e_init) * GetTrace(tmp0);
+
+        // the four stages start from the state at the beginning of the
+        // step and span the whole strain increment
+        dVolStrain = GetTrace(dStrain);
+        dDevStrain = GetDevPart(dStrain);
+        cDevStrain = ToContraviant(dDevStrain);
 
         // Calc Delta 1
         GetStateDependent(CurStress, CurAlpha, CurFabric , CurVoidRatio, alpha_in, n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, 
             b0, A, D, B, C, R);
-        dVolStrain = GetTrace(NextStrain - CurStrain);
-        dDevStrain = GetDevPart(NextStrain - CurStrain);
         p = one3 * GetTrace(CurStress) + m_Presidual;
         p = p < small ? small : p;
-        r = GetDevPart(CurStress) / p;
+        r = GetDevPart(CurStress); r /= p;
         Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
         
-        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n)))) 
+        nn = SingleDot(n, n);
+        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,nn))) 
             - K*D*DoubleDot2_2_Contr(n,r));
         if (fabs(temp4) < small) temp4 = small;
 
         NextDGamma      = (2.0*G*DoubleDot2_2_Mixed(n,dDevStrain) - K*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
-        dSigma1   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1 - Macauley(NextDGamma)*
-             (2.0*G*(B*n-C*(SingleDot(n,n)-1.0/3.0*mI1)) + K*D*mI1);
-        dAlpha1   = Macauley(NextDGamma) * two3 * h * b;
-        dFabric1  = -1.0 * Macauley(NextDGamma) * m_cz * Macauley(-1.0*D) * (m_z_max * n + CurFabric);
-        dPStrain1 = NextDGamma * ToCovariant(R);
+        mac = Macauley(NextDGamma);
+        fab = -1.0 * mac * m_cz * Macauley(-1.0*D);
+        cR = ToCovariant(R);
+        for (int i = 0; i < 6; i++) {
+            dSigma1[i]   = 2.0*G*cDevStrain[i] + K*dVolStrain*I1[i] - mac*
+                 (2.0*G*(B*n[i]-C*(nn[i]-1.0/3.0*I1[i])) + K*D*I1[i]);
+            dAlpha1[i]   = mac * two3 * h * b[i];
+            dFabric1[i]  = fab * (m_z_max * n[i] + CurFabric[i]);
+            dPStrain1[i] = NextDGamma * cR[i];
+        }
 
         // Calc Delta 2
-        GetElasticModuli(CurStress + 0.5 * dSigma1, CurVoidRatio, K, G);
-        aC = GetStiffness(K, G);
-        GetStateDependent(CurStress + 0.5 * dSigma1, CurAlpha + 0.5 * dAlpha1, CurFabric + 0.5 * dFabric1, CurVoidRatio, alpha_in, 
+        for (int i = 0; i < 6; i++) {
+            thisSigma[i]  = CurStress[i] + 0.5 * dSigma1[i];
+            thisAlpha[i]  = CurAlpha[i]  + 0.5 * dAlpha1[i];
+            thisFabric[i] = CurFabric[i] + 0.5 * dFabric1[i];
+        }
+        GetElasticModuli(thisSigma, CurVoidRatio, K, G);
+        GetStiffness(K, G, aC);
+        GetStateDependent(thisSigma, thisAlpha, thisFabric, CurVoidRatio, alpha_in, 
             n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, D, B, C, R);
-        p = one3 * GetTrace(CurStress + 0.5 * dSigma1) + m_Presidual;
+        p = one3 * GetTrace(thisSigma) + m_Presidual;
         p = p < small ? small : p;
-        r = GetDevPart(CurStress + 0.5 * dSigma1) / p;
+        r = GetDevPart(thisSigma); r /= p;
         Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
         
-        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n)))) 
+        nn = SingleDot(n, n);
+        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,nn))) 
             - K*D*DoubleDot2_2_Contr(n,r));
         if (fabs(temp4) < small) temp4 = small;
 
-        NextDGamma      = (2.0*G*DoubleDot2_2_Mixed(n,0.5*dDevStrain) - K*0.5*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
-        dSigma2   = 2.0*G*0.5* ToContraviant(dDevStrain) + K*0.5*dVolStrain*mI1 - Macauley(NextDGamma)*
-              (2.0*G*(B*n-C*(SingleDot(n,n)-1.0/3.0*mI1)) + K*D*mI1);
-        dAlpha2   = Macauley(NextDGamma) * two3 * h * b;
-        dFabric2  = -1.0 * Macauley(NextDGamma) * m_cz * Macauley(-1.0*D) * (m_z_max * n + CurFabric + 0.5 * dFabric1);
-        dPStrain2 = NextDGamma * ToCovariant(R);
+        NextDGamma      = (2.0*G*0.5*DoubleDot2_2_Mixed(n,dDevStrain) - K*0.5*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
+        mac = Macauley(NextDGamma);
+        fab = -1.0 * mac * m_cz * Macauley(-1.0*D);
+        cR = ToCovariant(R);
+        for (int i = 0; i < 6; i++) {
+            dSigma2[i]   = 2.0*G*0.5*cDevStrain[i] + K*0.5*dVolStrain*I1[i] - mac*
+                 (2.0*G*(B*n[i]-C*(nn[i]-1.0/3.0*I1[i])) + K*D*I1[i]);
+            dAlpha2[i]   = mac * two3 * h * b[i];
+            dFabric2[i]  = fab * (m_z_max * n[i] + CurFabric[i] + 0.5 * dFabric1[i]);
+            dPStrain2[i] = NextDGamma * cR[i];
+        }
 
         // Calc Delta 3
-        GetElasticModuli(CurStress + 0.5 * dSigma2, CurVoidRatio, K, G);
-        aC = GetStiffness(K, G);
-        GetStateDependent(CurStress + 0.5 * dSigma2, CurAlpha + 0.5 * dAlpha2, CurFabric + 0.5 * dFabric2, CurVoidRatio, alpha_in, 
+        for (int i = 0; i < 6; i++) {
+            thisSigma[i]  = CurStress[i] + 0.5 * dSigma2[i];
+            thisAlpha[i]  = CurAlpha[i]  + 0.5 * dAlpha2[i];
+            thisFabric[i] = CurFabric[i] + 0.5 * dFabric2[i];
+        }
+        GetElasticModuli(thisSigma, CurVoidRatio, K, G);
+        GetStiffness(K, G, aC);
+        GetStateDependent(thisSigma, thisAlpha, thisFabric, CurVoidRatio, alpha_in, 
             n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, D, B, C, R);
-        p = one3 * GetTrace(CurStress + 0.5 * dSigma2) + m_Presidual;
+        p = one3 * GetTrace(thisSigma) + m_Presidual;
         p = p < small ? small : p;
-        r = GetDevPart(CurStress + 0.5 * dSigma2) / p;
+        r = GetDevPart(thisSigma); r /= p;
         Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
         
-        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n)))) 
+        nn = SingleDot(n, n);
+        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,nn))) 
             - K*D*DoubleDot2_2_Contr(n,r));
         if (fabs(temp4) < small) temp4 = small;
 
-        NextDGamma      = (2.0*G*DoubleDot2_2_Mixed(n,0.5*dDevStrain) - K*0.5*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
-        dSigma3   = 2.0*G*0.5* ToContraviant(dDevStrain) + K*0.5*dVolStrain*mI1 - Macauley(NextDGamma)*
-             (2.0*G*(B*n-C*(SingleDot(n,n)-1.0/3.0*mI1)) + K*D*mI1);
-        dAlpha3   = Macauley(NextDGamma) * two3 * h * b;
-        dFabric3  = -1.0 * Macauley(NextDGamma) * m_cz * Macauley(-1.0*D) * (m_z_max * n + CurFabric + 0.5 * dFabric2);
-        dPStrain3 = NextDGamma * ToCovariant(R);
+        NextDGamma      = (2.0*G*0.5*DoubleDot2_2_Mixed(n,dDevStrain) - K*0.5*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
+        mac = Macauley(NextDGamma);
+        fab = -1.0 * mac * m_cz * Macauley(-1.0*D);
+        cR = ToCovariant(R);
+        for (int i = 0; i < 6; i++) {
+            dSigma3[i]   = 2.0*G*0.5*cDevStrain[i] + K*0.5*dVolStrain*I1[i] - mac*
+                 (2.0*G*(B*n[i]-C*(nn[i]-1.0/3.0*I1[i])) + K*D*I1[i]);
+            dAlpha3[i]   = mac * two3 * h * b[i];
+            dFabric3[i]  = fab * (m_z_max * n[i] + CurFabric[i] + 0.5 * dFabric2[i]);
+            dPStrain3[i] = NextDGamma * cR[i];
+        }
 
         // Calc Delta 4
-        GetElasticModuli(CurStress + dSigma3, CurVoidRatio, K, G);
-        aC = GetStiffness(K, G);
-        GetStateDependent(CurStress + dSigma3, CurAlpha + dAlpha3, CurFabric + dFabric3, CurVoidRatio, alpha_in, 
+        for (int i = 0; i < 6; i++) {
+            thisSigma[i]  = CurStress[i] + dSigma3[i];
+            thisAlpha[i]  = CurAlpha[i]  + dAlpha3[i];
+            thisFabric[i] = CurFabric[i] + dFabric3[i];
+        }
+        GetElasticModuli(thisSigma, CurVoidRatio, K, G);
+        GetStiffness(K, G, aC);
+        GetStateDependent(thisSigma, thisAlpha, thisFabric, CurVoidRatio, alpha_in, 
             n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, D, B, C, R);
-        p = one3 * GetTrace(CurStress + dSigma3) + m_Presidual;
+        p = one3 * GetTrace(thisSigma) + m_Presidual;
         p = p < small ? small : p;
-        r = GetDevPart(CurStress + dSigma3) / p;
+        r = GetDevPart(thisSigma); r /= p;
         Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
         
-        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n)))) 
+        nn = SingleDot(n, n);
+        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,nn))) 
             - K*D*DoubleDot2_2_Contr(n,r));
         if (fabs(temp4) < small) temp4 = small;
 
         NextDGamma      = (2.0*G*DoubleDot2_2_Mixed(n,dDevStrain) - K*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
-        dSigma4   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1 - Macauley(NextDGamma)*
-             (2.0*G*(B*n-C*(SingleDot(n,n)-1.0/3.0*mI1)) + K*D*mI1);
-        dAlpha4   = Macauley(NextDGamma) * two3 * h * b;
-        dFabric4  = -1.0 * Macauley(NextDGamma) * m_cz * Macauley(-1.0*D) * (m_z_max * n + CurFabric + dFabric3);
-        dPStrain4 = NextDGamma * ToCovariant(R);
+        mac = Macauley(NextDGamma);
+        fab = -1.0 * mac * m_cz * Macauley(-1.0*D);
+        cR = ToCovariant(R);
+        for (int i = 0; i < 6; i++) {
+            dSigma4[i]   = 2.0*G*cDevStrain[i] + K*dVolStrain*I1[i] - mac*
+                 (2.0*G*(B*n[i]-C*(nn[i]-1.0/3.0*I1[i])) + K*D*I1[i]);
+            dAlpha4[i]   = mac * two3 * h * b[i];
+            dFabric4[i]  = fab * (m_z_max * n[i] + CurFabric[i] + dFabric3[i]);
+            dPStrain4[i] = NextDGamma * cR[i];
+        }
         
         // RK
-        dSigma = (dSigma1 + dSigma4 + 2.0 * (dSigma2 + dSigma3)) / 6.0;
-        dAlpha = (dAlpha1 + dAlpha4 + 2.0 * (dAlpha2 + dAlpha3)) / 6.0;
-        dFabric = (dFabric1 + dFabric4 + 2.0 * (dFabric2 + dFabric3)) / 6.0;
-        dPStrain = (dPStrain1 + dPStrain4 + 2.0 * (dPStrain2 + dPStrain3)) / 6.0;
-
-        nStress = NextStress + dSigma;
-        nAlpha  = NextAlpha  + dAlpha;
-        nFabric = NextFabric + dFabric;
-
-
-        if (false){ // Add a condition to make an adaptive integration increment
-            //if (debugFlag) opserr << "---Unsuccessful increment: Error =  " << curStepError << endln;
-            //if (debugFlag) opserr << "                           T = " << T << ", dT = " << dT << endln;
-            q = 0.5;
-            if (dT == 1e-4) {
-                NextElasticStrain -= dPStrain;
-                NextStress = nStress;
-                NextAlpha  = nAlpha;
-                NextFabric = nFabric;
-
-                
-                //Stress_Correction(CurStress, CurStrain, CurElasticStrain, CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain, NextStress,
-                //    NextAlpha, NextFabric, NextAlpha_in, NextDGamma, NextVoidRatio, G, K, aC, aCep, aCep_Consistent);
-
-                T += dT;
-            }
-            dT = fmax(q * dT, 1e-4);
-        } else {
-            
-            //if (debugFlag) opserr << "+++Successful increment: T = " << T << ", dT = " << dT << endln;
-            NextElasticStrain -= dPStrain;
-            NextStress = nStress;
-            NextAlpha  = nAlpha;
-            NextFabric = nFabric;
-
-            
-            //Stress_Correction(CurStress, CurStrain, CurElasticStrain, CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain, NextStress,
-            //    NextAlpha, NextFabric, NextAlpha_in, NextDGamma, NextVoidRatio, G, K, aC, aCep, aCep_Consistent);
-        
-            q = 1.1;
-            T += dT;
-            dT = fmax(q * dT, 1e-4);
-            dT = fmin(dT, 1 - T);
+        for (int i = 0; i < 6; i++) {
+            NextElasticStrain[i] -= (dPStrain1[i] + dPStrain4[i] + 2.0 * (dPStrain2[i] + dPStrain3[i])) / 6.0;
+            NextStress[i] += (dSigma1[i] + dSigma4[i] + 2.0 * (dSigma2[i] + dSigma3[i])) / 6.0;
+            NextAlpha[i]  += (dAlpha1[i] + dAlpha4[i] + 2.0 * (dAlpha2[i] + dAlpha3[i])) / 6.0;
+            NextFabric[i] += (dFabric1[i] + dFabric4[i] + 2.0 * (dFabric2[i] + dFabric3[i])) / 6.0;
         }
-        
+
+        q = 1.1;
+        T += dT;
+        dT = fmax(q * dT, 1e-4);
+        dT = fmin(dT, 1 - T);
     }
     return;
 }
@@ -1707,52 +1902,47 @@ void ManzariDafalias::RungeKutta4(const Vector& CurStress, const Vector& CurStra
 // Sloan, S. W., Abbo, A. J., & Sheng, D. (2001). 
 //  " Refined explicit integration of elastoplastic models with automatic error control. ""
 //  Engineering Computations, 18(1/2), 121–194. https://doi.org/10.1108/02644400110365842
-void ManzariDafalias::RungeKutta45(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-        const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
-        Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) 
+void ManzariDafalias::RungeKutta45(const VectorND<6>& CurStress, const VectorND<6>& CurStrain, const VectorND<6>& CurElasticStrain,
+        const VectorND<6>& CurAlpha, const VectorND<6>& CurFabric, const VectorND<6>& alpha_in, const VectorND<6>& NextStrain,
+        VectorND<6>& NextElasticStrain, VectorND<6>& NextStress, VectorND<6>& NextAlpha, VectorND<6>& NextFabric,
+        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, MatrixND<6,6>& aC, MatrixND<6,6>& aCep, MatrixND<6,6>& aCep_Consistent) 
 {    
-    static bool do_once = true;
+    static std::atomic<bool> done_once{false};
 
-    if (do_once) {
+    if (!done_once.exchange(true)) {
         opserr << 
         "ManzariDafalias::RungeKutta45 - RK45 integrator added by Jose Abell @ UANDES. (www.joseabell.com). \n\
                                          Theory by Scott Sloan. " << endln;
-        do_once = false;
     }
 
     double CurVoidRatio, dVolStrain;
     double T = 0.0, dT = 1.0, dT_min = 1e-3 , TolE = mTolR;
     double Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0,A, B, C, D, p, Kp;
-    double temp4, q;
-
-    //Static allocation so we can avoid mallocs and get maximum speed. This is not thread-safe
-    static Vector n(6), d(6), b(6), R(6), dDevStrain(6), r(6); 
-    static Vector nStress(6), nAlpha(6), nFabric(6), ndPStrain(6);
-    static Vector dSigma1(6), dSigma2(6), dSigma3(6), dSigma4(6), dSigma5(6), dSigma6(6), dSigma(6), 
-        dAlpha1(6), dAlpha2(6), dAlpha3(6), dAlpha4(6), dAlpha5(6), dAlpha6(6), dAlpha(6), 
-        dFabric1(6), dFabric2(6), dFabric3(6), dFabric4(6), dFabric5(6), dFabric6(6), dFabric(6),
-        dPStrain1(6), dPStrain2(6), dPStrain3(6), dPStrain4(6), dPStrain5(6), dPStrain6(6), dPStrain(6);
-    static Matrix aCep1(6,6), aCep2(6,6), aCep3(6,6), aCep4(6,6), aCep5(6,6), aCep6(6,6), aCep_thisStep(6,6), aD(6,6);
-    static Vector thisSigma(6), thisAlpha(6), thisFabric(6);    
-    
-    // Zero everything out for good measure. 
-    n.Zero(); d.Zero(); b.Zero(); R.Zero(); dDevStrain.Zero(); r.Zero();
-    nStress.Zero(); nAlpha.Zero(); nFabric.Zero(); ndPStrain.Zero();
-    dSigma1.Zero(); dSigma2.Zero(); dSigma3.Zero(); dSigma4.Zero(); dSigma5.Zero(); dSigma6.Zero(); dSigma.Zero(); 
-    dAlpha1.Zero(); dAlpha2.Zero(); dAlpha3.Zero(); dAlpha4.Zero(); dAlpha5.Zero(); dAlpha6.Zero(); dAlpha.Zero(); 
-    dFabric1.Zero(); dFabric2.Zero(); dFabric3.Zero(); dFabric4.Zero(); dFabric5.Zero(); dFabric6.Zero(); dFabric.Zero();
-    dPStrain1.Zero(); dPStrain2.Zero(); dPStrain3.Zero(); dPStrain4.Zero(); dPStrain5.Zero(); dPStrain6.Zero(); dPStrain.Zero();
-    aCep1.Zero(); aCep2.Zero(); aCep3.Zero(); aCep4.Zero(); aCep5.Zero(); aCep6.Zero(); aCep_thisStep.Zero(); aD.Zero();
-    thisSigma.Zero(); thisAlpha.Zero(); thisFabric.Zero();    
+    double temp4, q, mac, fab;
+
+    VectorND<6> n, d, b, R, dStrain, dDevStrain, cDevStrain, r, nn, cR, tmp0, tmp1;
+    VectorND<6> nStress, nAlpha, nFabric, dPStrain;
+    VectorND<6> dSigma1, dSigma2, dSigma3, dSigma4, dSigma5, dSigma6,
+        dAlpha1, dAlpha2, dAlpha3, dAlpha4, dAlpha5, dAlpha6,
+        dFabric1, dFabric2, dFabric3, dFabric4, dFabric5, dFabric6,
+        dPStrain1, dPStrain2, dPStrain3, dPStrain4, dPStrain5, dPStrain6;
+    MatrixND<6,6> aCep1, aCep2, aCep3, aCep4, aCep5, aCep6, aCep_thisStep, aD, aTmp;
+    VectorND<6> thisSigma, thisAlpha, thisFabric;    
+
+    // the third and fourth stages do not update alpha
+    dAlpha3.zero();
+    dAlpha4.zero();
+    aCep_thisStep.zero();
     
     CurVoidRatio      = m_e_init - (1 + m_e_init) * GetTrace(CurStrain);
     NextVoidRatio     = m_e_init - (1 + m_e_init) * GetTrace(NextStrain);
-    NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain);
+    // NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain);
+    dStrain = NextStrain; dStrain -= CurStrain;
+    NextElasticStrain = CurElasticStrain; NextElasticStrain += dStrain;
 
     GetElasticModuli(CurStress, CurVoidRatio, K, G);
-    aC = GetStiffness(K, G);
-    aD = GetCompliance(K, G);
+    GetStiffness(K, G, aC);
+    GetCompliance(K, G, aD);
 
     NextStress = CurStress;
     NextAlpha = CurAlpha;
@@ -1763,19 +1953,25 @@ void ManzariDafalias::RungeKutta45(const Vector& CurStress, const Vector& CurStr
     {
         if (debugFlag)
             opserr << "ManzariDafalias::RungeKutta45() - Tag = " << this->getTag() << " : I have a problem (p < 0) - This should not happen!!!" << endln;        
-        NextStress = GetDevPart(NextStress) + m_Pmin * mI1;
+        // NextStress = GetDevPart(NextStress) + m_Pmin * mI1;
+        NextStress = GetDevPart(NextStress);
+        for (int i = 0; i < 3; i++)
+            NextStress[i] += m_Pmin;
         p = one3 * GetTrace(NextStress);
     }
 
     // Set aCep_Consistent to zero for substepping process
-    aCep_Consistent.Zero();
+    aCep_Consistent.zero();
 
     while (T < 1.0)
     {
-        NextVoidRatio     = m_e_init - (1 + m_e_init) * GetTrace(NextStrain + T * (NextStrain - CurStrain));
+        // NextVoidRatio     = m_e_init - (1 + m_e_init) * GetTrace(NextStrain + T * (NextStrain - CurStrain));
+        tmp0 = dStrain; tmp0 *= T; tmp0 += NextStrain;
+        NextVoidRatio     = m_e_init - (1 + m_e_init) * GetTrace(tmp0);
         
-        dVolStrain = dT * GetTrace(NextStrain - CurStrain);
-        dDevStrain = dT * GetDevPart(NextStrain - CurStrain);
+        dVolStrain = dT * GetTrace(dStrain);
+        dDevStrain = GetDevPart(dStrain); dDevStrain *= dT;
+        cDevStrain = ToContraviant(dDevStrain);
 
 
         // Calc Delta 1
@@ -1786,136 +1982,180 @@ void ManzariDafalias::RungeKutta45(const Vector& CurStress, const Vector& CurStr
         GetStateDependent(thisSigma, thisAlpha, thisFabric,  NextVoidRatio, alpha_in, n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, D, B, C, R);
         GetElasticModuli(thisSigma , NextVoidRatio, K, G);
 
-        r = GetDevPart(NextStress) / p;
+        r = GetDevPart(NextStress); r /= p;
         Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
-        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n)))) 
+        nn = SingleDot(n, n);
+        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,nn))) 
             - K*D*DoubleDot2_2_Contr(n,r));
         if (fabs(temp4) < small) temp4 = small;
         NextDGamma      = (2.0*G*DoubleDot2_2_Mixed(n,dDevStrain) - K*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
-        dSigma1   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1 - Macauley(NextDGamma)*
-             (2.0*G*(B*n-C*(SingleDot(n,n)-1.0/3.0*mI1)) + K*D*mI1);
-        dAlpha1   = Macauley(NextDGamma) * two3 * h * b;
-        dFabric1   = -1.0 * Macauley(NextDGamma) * m_cz * Macauley(-1.0*D) * (m_z_max * n + thisFabric);
-        dPStrain1 = NextDGamma * ToCovariant(R);
+        mac = Macauley(NextDGamma);
+        fab = -1.0 * mac * m_cz * Macauley(-1.0*D);
+        cR = ToCovariant(R);
+        for (int i = 0; i < 6; i++) {
+            dSigma1[i]   = 2.0*G*cDevStrain[i] + K*dVolStrain*I1[i] - mac*
+                 (2.0*G*(B*n[i]-C*(nn[i]-1.0/3.0*I1[i])) + K*D*I1[i]);
+            dAlpha1[i]   = mac * two3 * h * b[i];
+            dFabric1[i]  = fab * (m_z_max * n[i] + thisFabric[i]);
+            dPStrain1[i] = NextDGamma * cR[i];
+        }
         
-        aCep1 = GetElastoPlasticTangent(thisSigma, NextDGamma, CurStrain, NextStrain, G, K, B, C, D, h, n, d, b);
+        GetElastoPlasticTangent(thisSigma, NextDGamma, G, K, B, C, D, h, n, b, aCep1);
 
 
 
         // Calc Delta 2
-        thisSigma = NextStress  + 0.5*dSigma1;
-        thisAlpha = NextAlpha   + 0.5*dAlpha1;
-        thisFabric = NextFabric + 0.5*dFabric1;
+        for (int i = 0; i < 6; i++) {
+            thisSigma[i]  = NextStress[i] + 0.5*dSigma1[i];
+            thisAlpha[i]  = NextAlpha[i]  + 0.5*dAlpha1[i];
+            thisFabric[i] = NextFabric[i] + 0.5*dFabric1[i];
+        }
 
         GetStateDependent(thisSigma, thisAlpha, thisFabric, NextVoidRatio,  alpha_in,  n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, D, B, C, R);
-        r = GetDevPart(NextStress) / p;
+        r = GetDevPart(NextStress); r /= p;
         Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
-        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n)))) 
+        nn = SingleDot(n, n);
+        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,nn))) 
             - K*D*DoubleDot2_2_Contr(n,r));
         if (fabs(temp4) < small) temp4 = small;
         NextDGamma      = (2.0*G*DoubleDot2_2_Mixed(n,dDevStrain) - K*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
-        dSigma2   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1 - Macauley(NextDGamma)*
-             (2.0*G*(B*n-C*(SingleDot(n,n)-1.0/3.0*mI1)) + K*D*mI1);
-        dAlpha2   = Macauley(NextDGamma) * two3 * h * b;
-        dFabric2   = -1.0 * Macauley(NextDGamma) * m_cz * Macauley(-1.0*D) * (m_z_max * n + thisFabric);
-        dPStrain2 = NextDGamma * ToCovariant(R);
+        mac = Macauley(NextDGamma);
+        fab = -1.0 * mac * m_cz * Macauley(-1.0*D);
+        cR = ToCovariant(R);
+        for (int i = 0; i < 6; i++) {
+            dSigma2[i]   = 2.0*G*cDevStrain[i] + K*dVolStrain*I1[i] - mac*
+                 (2.0*G*(B*n[i]-C*(nn[i]-1.0/3.0*I1[i])) + K*D*I1[i]);
+            dAlpha2[i]   = mac * two3 * h * b[i];
+            dFabric2[i]  = fab * (m_z_max * n[i] + thisFabric[i]);
+            dPStrain2[i] = NextDGamma * cR[i];
+        }
 
-        aCep2 = GetElastoPlasticTangent(thisSigma, NextDGamma, CurStrain, NextStrain, G, K, B, C, D, h, n, d, b);
+        GetElastoPlasticTangent(thisSigma, NextDGamma, G, K, B, C, D, h, n, b, aCep2);
 
 
         // Calc Delta 3
-        thisSigma = NextStress  + 0.25*(dSigma1  + dSigma2);
-        thisAlpha = NextAlpha   + 0.25*(dAlpha1  + dAlpha2);
-        thisFabric = NextFabric + 0.25*(dFabric1 + dFabric2);
+        for (int i = 0; i < 6; i++) {
+            thisSigma[i]  = NextStress[i] + 0.25*(dSigma1[i]  + dSigma2[i]);
+            thisAlpha[i]  = NextAlpha[i]  + 0.25*(dAlpha1[i]  + dAlpha2[i]);
+            thisFabric[i] = NextFabric[i] + 0.25*(dFabric1[i] + dFabric2[i]);
+        }
         GetElasticModuli(thisSigma , NextVoidRatio, K, G);
         GetStateDependent(thisSigma, thisAlpha, thisFabric, NextVoidRatio,  alpha_in,  n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, D, B, C, R);
-        r = GetDevPart(NextStress) / p;
+        r = GetDevPart(NextStress); r /= p;
         Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
-        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n)))) 
+        nn = SingleDot(n, n);
+        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,nn))) 
             - K*D*DoubleDot2_2_Contr(n,r));
         if (fabs(temp4) < small) temp4 = small;
         NextDGamma      = (2.0*G*DoubleDot2_2_Mixed(n,dDevStrain) - K*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
-        dSigma3   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1 - Macauley(NextDGamma)*
-             (2.0*G*(B*n-C*(SingleDot(n,n)-1.0/3.0*mI1)) + K*D*mI1);
-        dFabric3   = -1.0 * Macauley(NextDGamma) * m_cz * Macauley(-1.0*D) * (m_z_max * n + thisFabric);
-        dPStrain3 = NextDGamma * ToCovariant(R);
+        mac = Macauley(NextDGamma);
+        fab = -1.0 * mac * m_cz * Macauley(-1.0*D);
+        cR = ToCovariant(R);
+        for (int i = 0; i < 6; i++) {
+            dSigma3[i]   = 2.0*G*cDevStrain[i] + K*dVolStrain*I1[i] - mac*
+                 (2.0*G*(B*n[i]-C*(nn[i]-1.0/3.0*I1[i])) + K*D*I1[i]);
+            dFabric3[i]  = fab * (m_z_max * n[i] + thisFabric[i]);
+            dPStrain3[i] = NextDGamma * cR[i];
+        }
 
-        aCep3 = GetElastoPlasticTangent(thisSigma, NextDGamma, CurStrain, NextStrain, G, K, B, C, D, h, n, d, b);
+        GetElastoPlasticTangent(thisSigma, NextDGamma, G, K, B, C, D, h, n, b, aCep3);
 
 
         // Calc Delta 4
-        thisSigma = NextStress  - dSigma2  + 2*dSigma3;
-        thisAlpha = NextAlpha   - dAlpha2  + 2*dAlpha3;
-        thisFabric = NextFabric - dFabric2 + 2*dFabric3;
+        for (int i = 0; i < 6; i++) {
+            thisSigma[i]  = NextStress[i] - dSigma2[i]  + 2*dSigma3[i];
+            thisAlpha[i]  = NextAlpha[i]  - dAlpha2[i]  + 2*dAlpha3[i];
+            thisFabric[i] = NextFabric[i] - dFabric2[i] + 2*dFabric3[i];
+        }
         GetElasticModuli(thisSigma , NextVoidRatio, K, G);
         GetStateDependent(thisSigma, thisAlpha, thisFabric, NextVoidRatio,  alpha_in,  n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, D, B, C, R);
-        r = GetDevPart(NextStress) / p;
+        r = GetDevPart(NextStress); r /= p;
         Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
-        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n)))) 
+        nn = SingleDot(n, n);
+        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,nn))) 
             - K*D*DoubleDot2_2_Contr(n,r));
         if (fabs(temp4) < small) temp4 = small;
         NextDGamma      = (2.0*G*DoubleDot2_2_Mixed(n,dDevStrain) - K*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
-        dSigma4   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1 - Macauley(NextDGamma)*
-             (2.0*G*(B*n-C*(SingleDot(n,n)-1.0/3.0*mI1)) + K*D*mI1);
-        dFabric4   = -1.0 * Macauley(NextDGamma) * m_cz * Macauley(-1.0*D) * (m_z_max * n + thisFabric);
-        dPStrain4 = NextDGamma * ToCovariant(R);
+        mac = Macauley(NextDGamma);
+        fab = -1.0 * mac * m_cz * Macauley(-1.0*D);
+        cR = ToCovariant(R);
+        for (int i = 0; i < 6; i++) {
+            dSigma4[i]   = 2.0*G*cDevStrain[i] + K*dVolStrain*I1[i] - mac*
+                 (2.0*G*(B*n[i]-C*(nn[i]-1.0/3.0*I1[i])) + K*D*I1[i]);
+            dFabric4[i]  = fab * (m_z_max * n[i] + thisFabric[i]);
+            dPStrain4[i] = NextDGamma * cR[i];
+        }
 
-        aCep4 = GetElastoPlasticTangent(thisSigma, NextDGamma, CurStrain, NextStrain, G, K, B, C, D, h, n, d, b);
+        GetElastoPlasticTangent(thisSigma, NextDGamma, G, K, B, C, D, h, n, b, aCep4);
 
 
         // Calc Delta 5
-        thisSigma = NextStress  + (7*dSigma1  + 10*dSigma2  + dSigma4)/27;
-        thisAlpha = NextAlpha   + (7*dAlpha1  + 10*dAlpha2  + dAlpha4)/27;
-        thisFabric = NextFabric + (7*dFabric1 + 10*dFabric2 + dFabric4)/27;
+        for (int i = 0; i < 6; i++) {
+            thisSigma[i]  = NextStress[i] + (7*dSigma1[i]  + 10*dSigma2[i]  + dSigma4[i])/27;
+            thisAlpha[i]  = NextAlpha[i]  + (7*dAlpha1[i]  + 10*dAlpha2[i]  + dAlpha4[i])/27;
+            thisFabric[i] = NextFabric[i] + (7*dFabric1[i] + 10*dFabric2[i] + dFabric4[i])/27;
+        }
         GetElasticModuli(thisSigma , NextVoidRatio, K, G);
         GetStateDependent(thisSigma, thisAlpha, thisFabric, NextVoidRatio,  alpha_in,  n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, D, B, C, R);
-        r = GetDevPart(NextStress) / p;
+        r = GetDevPart(NextStress); r /= p;
         Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
-        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n)))) 
+        nn = SingleDot(n, n);
+        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,nn))) 
             - K*D*DoubleDot2_2_Contr(n,r));
         if (fabs(temp4) < small) temp4 = small;
         NextDGamma      = (2.0*G*DoubleDot2_2_Mixed(n,dDevStrain) - K*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
-        dSigma5   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1 - Macauley(NextDGamma)*
-             (2.0*G*(B*n-C*(SingleDot(n,n)-1.0/3.0*mI1)) + K*D*mI1);
-        dAlpha5   = Macauley(NextDGamma) * two3 * h * b;
-        dFabric5   =  -1.0 * Macauley(NextDGamma) * m_cz * Macauley(-1.0*D) * (m_z_max * n + thisFabric);
-        dPStrain5 = NextDGamma * ToCovariant(R);
+        mac = Macauley(NextDGamma);
+        fab = -1.0 * mac * m_cz * Macauley(-1.0*D);
+        cR = ToCovariant(R);
+        for (int i = 0; i < 6; i++) {
+            dSigma5[i]   = 2.0*G*cDevStrain[i] + K*dVolStrain*I1[i] - mac*
+                 (2.0*G*(B*n[i]-C*(nn[i]-1.0/3.0*I1[i])) + K*D*I1[i]);
+            dAlpha5[i]   = mac * two3 * h * b[i];
+            dFabric5[i]  = fab * (m_z_max * n[i] + thisFabric[i]);
+            dPStrain5[i] = NextDGamma * cR[i];
+        }
    
-        aCep5 = GetElastoPlasticTangent(thisSigma, NextDGamma, CurStrain, NextStrain, G, K, B, C, D, h, n, d, b);
+        GetElastoPlasticTangent(thisSigma, NextDGamma, G, K, B, C, D, h, n, b, aCep5);
 
 
         // Calc Delta 6
-        thisSigma = NextStress  + (28*dSigma1  - 125*dSigma2  + 546*dSigma3  + 54*dSigma4  - 378*dSigma5)/625;
-        thisAlpha = NextAlpha   + (28*dAlpha1  - 125*dAlpha2  + 546*dAlpha3  + 54*dAlpha4  - 378*dAlpha5)/625;
-        thisFabric = NextFabric + (28*dFabric1 - 125*dFabric2 + 546*dFabric3 + 54*dFabric4 - 378*dFabric5)/625;
+        for (int i = 0; i < 6; i++) {
+            thisSigma[i]  = NextStress[i] + (28*dSigma1[i]  - 125*dSigma2[i]  + 546*dSigma3[i]  + 54*dSigma4[i]  - 378*dSigma5[i])/625;
+            thisAlpha[i]  = NextAlpha[i]  + (28*dAlpha1[i]  - 125*dAlpha2[i]  + 546*dAlpha3[i]  + 54*dAlpha4[i]  - 378*dAlpha5[i])/625;
+            thisFabric[i] = NextFabric[i] + (28*dFabric1[i] - 125*dFabric2[i] + 546*dFabric3[i] + 54*dFabric4[i] - 378*dFabric5[i])/625;
+        }
         GetElasticModuli(thisSigma , NextVoidRatio, K, G);
         GetStateDependent(thisSigma, thisAlpha, thisFabric, NextVoidRatio,  alpha_in,  n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0, A, D, B, C, R);
-        r = GetDevPart(NextStress) / p;
+        r = GetDevPart(NextStress); r /= p;
         Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
-        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,SingleDot(n,n)))) 
+        nn = SingleDot(n, n);
+        temp4 = (Kp + 2.0*G*(B-C*GetTrace(SingleDot(n,nn))) 
             - K*D*DoubleDot2_2_Contr(n,r));
         if (fabs(temp4) < small) temp4 = small;
         NextDGamma      = (2.0*G*DoubleDot2_2_Mixed(n,dDevStrain) - K*dVolStrain*DoubleDot2_2_Contr(n,r))/temp4;
-        dSigma6   = 2.0*G* ToContraviant(dDevStrain) + K*dVolStrain*mI1 - Macauley(NextDGamma)*
-             (2.0*G*(B*n-C*(SingleDot(n,n)-1.0/3.0*mI1)) + K*D*mI1);
-        dAlpha6   = Macauley(NextDGamma) * two3 * h * b;
-        dFabric6   =  -1.0 * Macauley(NextDGamma) * m_cz * Macauley(-1.0*D) * (m_z_max * n + thisFabric);
-        dPStrain6 = NextDGamma * ToCovariant(R);
+        mac = Macauley(NextDGamma);
+        fab = -1.0 * mac * m_cz * Macauley(-1.0*D);
+        cR = ToCovariant(R);
+        for (int i = 0; i < 6; i++) {
+            dSigma6[i]   = 2.0*G*cDevStrain[i] + K*dVolStrain*I1[i] - mac*
+                 (2.0*G*(B*n[i]-C*(nn[i]-1.0/3.0*I1[i])) + K*D*I1[i]);
+            dAlpha6[i]   = mac * two3 * h * b[i];
+            dFabric6[i]  = fab * (m_z_max * n[i] + thisFabric[i]);
+            dPStrain6[i] = NextDGamma * cR[i];
+        }
 
-        aCep6 = GetElastoPlasticTangent(thisSigma, NextDGamma, CurStrain, NextStrain, G, K, B, C, D, h, n, d, b);
+        GetElastoPlasticTangent(thisSigma, NextDGamma, G, K, B, C, D, h, n, b, aCep6);
 
 
 
 
         // Update
-        dSigma =   ( 14*dSigma1   + 35*dSigma4   + 162*dSigma5   + 125*dSigma6   ) / 336;
-        dAlpha =   ( 14*dAlpha1   + 35*dAlpha4   + 162*dAlpha5   + 125*dAlpha6   ) / 336;
-        dFabric =  ( 14*dFabric1  + 35*dFabric4  + 162*dFabric5  + 125*dFabric6  ) / 336;
-        dPStrain = ( 14*dPStrain1 + 35*dPStrain4 + 162*dPStrain5 + 125*dPStrain6 ) / 336;
-
-        nStress = NextStress + dSigma;
-        nAlpha  = NextAlpha  + dAlpha;
-        nFabric  = NextFabric  + dFabric;
+        for (int i = 0; i < 6; i++) {
+            dPStrain[i] = ( 14*dPStrain1[i] + 35*dPStrain4[i] + 162*dPStrain5[i] + 125*dPStrain6[i] ) / 336;
+            nStress[i]  = NextStress[i] + ( 14*dSigma1[i]   + 35*dSigma4[i]   + 162*dSigma5[i]   + 125*dSigma6[i]   ) / 336;
+            nAlpha[i]   = NextAlpha[i]  + ( 14*dAlpha1[i]   + 35*dAlpha4[i]   + 162*dAlpha5[i]   + 125*dAlpha6[i]   ) / 336;
+            nFabric[i]  = NextFabric[i] + ( 14*dFabric1[i]  + 35*dFabric4[i]  + 162*dFabric5[i]  + 125*dFabric6[i]  ) / 336;
+        }
 
         // Compute the error 
         p = one3 * GetTrace(nStress);
@@ -1931,10 +2171,15 @@ void ManzariDafalias::RungeKutta45(const Vector& CurStress, const Vector& CurStr
         double stressNorm = GetNorm_Contr(NextStress);
         double alphaNorm = GetNorm_Contr(NextAlpha);
 
-        double curStepError1 = GetNorm_Contr(-42*dSigma1 - 224*dSigma3 - 21*dSigma4 + 162*dSigma5 + 125*dSigma6 )/336;
+        for (int i = 0; i < 6; i++) {
+            tmp0[i] = -42*dSigma1[i] - 224*dSigma3[i] - 21*dSigma4[i] + 162*dSigma5[i] + 125*dSigma6[i];
+            tmp1[i] = -42*dAlpha1[i] - 224*dAlpha3[i] - 21*dAlpha4[i] + 162*dAlpha5[i] + 125*dAlpha6[i];
+        }
+
+        double curStepError1 = GetNorm_Contr(tmp0)/336;
         if (stressNorm >= 0.5) {curStepError1 /= (2 * stressNorm);}
     
-        double curStepError2 = GetNorm_Contr(-42*dAlpha1 - 224*dAlpha3 - 21*dAlpha4 + 162*dAlpha5 + 125*dAlpha6 )/336;
+        double curStepError2 = GetNorm_Contr(tmp1)/336;
         if (alphaNorm >= 0.5) {curStepError2 /=  (2 * alphaNorm);}
     
         double curStepError = fmax(curStepError1, curStepError2);
@@ -1957,9 +2202,17 @@ void ManzariDafalias::RungeKutta45(const Vector& CurStress, const Vector& CurStr
                 NextElasticStrain -= dPStrain;// 0.5* (dPStrain1 + dPStrain2);
                 NextStress = nStress;
                 double eta = sqrt(13.5) * GetNorm_Contr(GetDevPart(NextStress)) / GetTrace(NextStress);
-                if (eta > m_Mc)
-                    NextStress = one3 * GetTrace(NextStress) * mI1 + m_Mc / eta * GetDevPart(NextStress);
-                NextAlpha  = CurAlpha + 3.0 * (GetDevPart(NextStress)/GetTrace(NextStress) - GetDevPart(CurStress)/GetTrace(CurStress));
+                if (eta > m_Mc) {
+                    // NextStress = one3 * GetTrace(NextStress) * mI1 + m_Mc / eta * GetDevPart(NextStress);
+                    tmp0 = GetDevPart(NextStress); tmp0 *= (m_Mc / eta);
+                    tmp1 = I1; tmp1 *= (one3 * GetTrace(NextStress));
+                    NextStress = tmp1; NextStress += tmp0;
+                }
+                // NextAlpha  = CurAlpha + 3.0 * (GetDevPart(NextStress)/GetTrace(NextStress) - GetDevPart(CurStress)/GetTrace(CurStress));
+                tmp0 = GetDevPart(NextStress); tmp0 /= GetTrace(NextStress);
+                tmp1 = GetDevPart(CurStress); tmp1 /= GetTrace(CurStress);
+                tmp0 -= tmp1; tmp0 *= 3.0;
+                NextAlpha = CurAlpha; NextAlpha += tmp0;
                 
                 // ++N_nonconverged;
                 // max_error = fmax(max_error, curStepError);
@@ -1977,13 +2230,27 @@ void ManzariDafalias::RungeKutta45(const Vector& CurStress, const Vector& CurStr
             NextAlpha  = nAlpha;
             NextFabric = nFabric;
 
-            // Stress_Correction(CurStress, CurStrain, CurElasticStrain, CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain, NextStress,
-            //     NextAlpha, NextFabric, NextDGamma, NextVoidRatio, G, K, aC, aCep, aCep_Consistent);
-
             T += dT;
 
-            aCep_thisStep =   ( 14*aCep1 + 35*aCep4 + 162*aCep5 + 125*aCep6 ) /336;
-            aCep_Consistent = aCep_thisStep * (aD * aCep_Consistent + T * mIImix);
+            // aCep_thisStep =   ( 14*aCep1 + 35*aCep4 + 162*aCep5 + 125*aCep6 ) /336;
+            for (int j = 0; j < 6; j++)
+                for (int i = 0; i < 6; i++)
+                    aCep_thisStep(i,j) = ( 14*aCep1(i,j) + 35*aCep4(i,j) + 162*aCep5(i,j) + 125*aCep6(i,j) ) * (1.0/336);
+            // aCep_Consistent = aCep_thisStep * (aD * aCep_Consistent + T * mIImix);
+            for (int j = 0; j < 6; j++)
+                for (int i = 0; i < 6; i++) {
+                    double sum = T * mIImix(i,j);
+                    for (int k = 0; k < 6; k++)
+                        sum += aD(i,k) * aCep_Consistent(k,j);
+                    aTmp(i,j) = sum;
+                }
+            for (int j = 0; j < 6; j++)
+                for (int i = 0; i < 6; i++) {
+                    double sum = 0.0;
+                    for (int k = 0; k < 6; k++)
+                        sum += aCep_thisStep(i,k) * aTmp(k,j);
+                    aCep_Consistent(i,j) = sum;
+                }
         
             if(curStepError == 0)
                 dT = 1 - T;
@@ -2283,31 +2550,51 @@ int ManzariDafalias::BackwardEuler_CPPM(const Vector& CurStress, const Vector& C
 
 
 double
-ManzariDafalias::IntersectionFactor(const Vector& CurStress, const Vector& CurStrain, const Vector& NextStrain, const Vector& CurAlpha, 
+ManzariDafalias::IntersectionFactor(const Vector& CurStress, const Vector& CurStrain, const Vector& NextStrain, const Vector& CurAlpha,
     double a0, double a1)
+{
+    VectorND<6> curStress, curStrain, nextStrain, curAlpha;
+    assign(curStress, CurStress);
+    assign(curStrain, CurStrain);
+    assign(nextStrain, NextStrain);
+    assign(curAlpha, CurAlpha);
+    return IntersectionFactor(curStress, curStrain, nextStrain, curAlpha, a0, a1);
+}
+
+
+double
+ManzariDafalias::IntersectionFactor(const VectorND<6>& CurStress, const VectorND<6>& CurStrain, const VectorND<6>& NextStrain,
+    const VectorND<6>& CurAlpha, double a0, double a1)
 {
     double a = a0;
     double G, K, vR, f, f0, f1;
-    Vector dSigma(6), dSigma0(6), dSigma1(6), strainInc(6);
+    VectorND<6> dSigma, strainInc, tmp;
+    MatrixND<6,6> aC;
 
-    strainInc = NextStrain - CurStrain;
+    strainInc = NextStrain; strainInc -= CurStrain;
 
-    vR      = m_e_init - (1 + m_e_init) * GetTrace(CurStrain + a0 * strainInc);
+    // vR      = m_e_init - (1 + m_e_init) * GetTrace(CurStrain + a0 * strainInc);
+    tmp = strainInc; tmp *= a0; tmp += CurStrain;
+    vR      = m_e_init - (1 + m_e_init) * GetTrace(tmp);
     GetElasticModuli(CurStress, vR, K, G);
-    dSigma0 = a0 * DoubleDot4_2(GetStiffness(K, G), strainInc);
-    f0 = GetF(CurStress + dSigma0, CurAlpha);
+    GetStiffness(K, G, aC);
+    // f0 = GetF(CurStress + a0 * DoubleDot4_2(GetStiffness(K, G), strainInc), CurAlpha);
+    dSigma = DoubleDot4_2(aC, strainInc); dSigma *= a0; dSigma += CurStress;
+    f0 = GetF(dSigma, CurAlpha);
 
-    vR      = m_e_init - (1 + m_e_init) * GetTrace(CurStrain + a1 * strainInc);
+    tmp = strainInc; tmp *= a1; tmp += CurStrain;
+    vR      = m_e_init - (1 + m_e_init) * GetTrace(tmp);
     GetElasticModuli(CurStress, vR, K, G);
-    dSigma1 = a1 * DoubleDot4_2(GetStiffness(K, G), strainInc);
-    f1 = GetF(CurStress + dSigma1, CurAlpha);
+    GetStiffness(K, G, aC);
+    dSigma = DoubleDot4_2(aC, strainInc); dSigma *= a1; dSigma += CurStress;
+    f1 = GetF(dSigma, CurAlpha);
 
     for (int i = 1; i <= 10; i++)
     {
         a    = a1 - f1 * (a1-a0)/(f1-f0);
-        dSigma = a * DoubleDot4_2(GetStiffness(K, G), strainInc);
-        f    = GetF(CurStress + dSigma, CurAlpha);
-        if (fabs(f) < mTolF) 
+        dSigma = DoubleDot4_2(aC, strainInc); dSigma *= a; dSigma += CurStress;
+        f    = GetF(dSigma, CurAlpha);
+        if (fabs(f) < mTolF)
         {
             if (debugFlag) opserr << "Found alpha in " << i << " steps" << ", alpha = " << a << endln;
             break;
@@ -2322,7 +2609,7 @@ ManzariDafalias::IntersectionFactor(const Vector& CurStress, const Vector& CurSt
             f0 = f;
         }
 
-        if (i == 10) 
+        if (i == 10)
         {
             if (debugFlag) opserr << "Didn't find alpha!" << endln;
             a = 0;
@@ -2337,24 +2624,41 @@ ManzariDafalias::IntersectionFactor(const Vector& CurStress, const Vector& CurSt
 
 double
 ManzariDafalias::IntersectionFactor_Unloading(const Vector& CurStress, const Vector& CurStrain, const Vector& NextStrain, const Vector& CurAlpha)
+{
+    VectorND<6> curStress, curStrain, nextStrain, curAlpha;
+    assign(curStress, CurStress);
+    assign(curStrain, CurStrain);
+    assign(nextStrain, NextStrain);
+    assign(curAlpha, CurAlpha);
+    return IntersectionFactor_Unloading(curStress, curStrain, nextStrain, curAlpha);
+}
+
+
+double
+ManzariDafalias::IntersectionFactor_Unloading(const VectorND<6>& CurStress, const VectorND<6>& CurStrain, const VectorND<6>& NextStrain,
+    const VectorND<6>& CurAlpha)
 {
     double a = 0.0, a0 = 0.0 , a1 = 1.0, da;
     double G, K, vR, f;
     int nSub = 20;
-    Vector dSigma(6), dSigma0(6), dSigma1(6), strainInc(6);
+    VectorND<6> dSigma, strainInc, tmp;
+    MatrixND<6,6> aC;
 
-    strainInc = NextStrain - CurStrain;
-    
-    
-    vR    = m_e_init - (1 + m_e_init) * GetTrace(CurStrain ); 
+    strainInc = NextStrain; strainInc -= CurStrain;
+
+
+    vR    = m_e_init - (1 + m_e_init) * GetTrace(CurStrain );
     GetElasticModuli(CurStress, vR, K, G);
-    dSigma = DoubleDot4_2(GetStiffness(K, G), strainInc);
+    GetStiffness(K, G, aC);
+    dSigma = DoubleDot4_2(aC, strainInc);
 
     for (int i = 1; i < nSub; i++)
     {
         da = (a1 - a0)/2.0;
         a = a1 - da;
-        f    = GetF(CurStress + a * dSigma, CurAlpha);
+        // f    = GetF(CurStress + a * dSigma, CurAlpha);
+        tmp = dSigma; tmp *= a; tmp += CurStress;
+        f    = GetF(tmp, CurAlpha);
         if (f > mTolF)
         {
             a1 = a;
@@ -2362,24 +2666,24 @@ ManzariDafalias::IntersectionFactor_Unloading(const Vector& CurStress, const Vec
             a0 = a;
             break;
         } else {
-            if (debugFlag) 
+            if (debugFlag)
                 opserr << "Found alpha - Unloading" << ", a = " << a << endln;
             return a;
         }
 
         if (i == nSub) {
-            if (debugFlag) 
+            if (debugFlag)
                 opserr << "Didn't find alpha! - Unloading" << ", a0 = " << a0 << ", a1 = " << a1 << endln;
             return 0.0;
         }
-    } 
-    if (debugFlag) 
+    }
+    if (debugFlag)
         opserr << "Found alpha - Unloading" << ", a0 = " << a0 << ", a1 = " << a1 << endln;
     return IntersectionFactor(CurStress, CurStrain, NextStrain, CurAlpha, a0, a1);
 }
 
 
-void    
+void
 ManzariDafalias::Stress_Correction(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
         const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
         Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
@@ -2387,8 +2691,48 @@ ManzariDafalias::Stress_Correction(const Vector& CurStress, const Vector& CurStr
 {
     if (!mStressCorrectionInUse) return;
 
-    Vector n(6), d(6), b(6), dPStrain(6), R(6), devStress(6), dSigma(6), dAlpha(6), dSigmaP(6), aBar(6), zBar(6);
-    Vector r(6), dfrOverdSigma(6), dfrOverdAlpha(6);
+    VectorND<6> curStress, curStrain, curElasticStrain, curAlpha, curFabric, alphaIn, nextStrain;
+    VectorND<6> nextElasticStrain, nextStress, nextAlpha, nextFabric;
+    MatrixND<6,6> C, Cep, Cep_Consistent;
+
+    assign(curStress, CurStress);
+    assign(curStrain, CurStrain);
+    assign(curElasticStrain, CurElasticStrain);
+    assign(curAlpha, CurAlpha);
+    assign(curFabric, CurFabric);
+    assign(alphaIn, alpha_in);
+    assign(nextStrain, NextStrain);
+    assign(nextElasticStrain, NextElasticStrain);
+    assign(nextStress, NextStress);
+    assign(nextAlpha, NextAlpha);
+    assign(nextFabric, NextFabric);
+    assign(C, aC);
+    assign(Cep, aCep);
+    assign(Cep_Consistent, aCep_Consistent);
+
+    Stress_Correction(curStress, curStrain, curElasticStrain, curAlpha, curFabric, alphaIn, nextStrain,
+        nextElasticStrain, nextStress, nextAlpha, nextFabric, NextDGamma, NextVoidRatio, G, K, C, Cep, Cep_Consistent);
+
+    assign(NextElasticStrain, nextElasticStrain);
+    assign(NextStress, nextStress);
+    assign(NextAlpha, nextAlpha);
+    assign(NextFabric, nextFabric);
+    assign(aC, C);
+    assign(aCep, Cep);
+    assign(aCep_Consistent, Cep_Consistent);
+}
+
+
+void
+ManzariDafalias::Stress_Correction(const VectorND<6>& CurStress, const VectorND<6>& CurStrain, const VectorND<6>& CurElasticStrain,
+        const VectorND<6>& CurAlpha, const VectorND<6>& CurFabric, const VectorND<6>& alpha_in, const VectorND<6>& NextStrain,
+        VectorND<6>& NextElasticStrain, VectorND<6>& NextStress, VectorND<6>& NextAlpha, VectorND<6>& NextFabric,
+        double& NextDGamma, double& NextVoidRatio,  double& G, double& K, MatrixND<6,6>& aC, MatrixND<6,6>& aCep, MatrixND<6,6>& aCep_Consistent)
+{
+    if (!mStressCorrectionInUse) return;
+
+    VectorND<6> n, d, b, R, devStress, dSigmaP, aBar;
+    VectorND<6> r, dfrOverdSigma, dfrOverdAlpha, tmp0, tmp1;
     double Cos3Theta, h, psi, alphaBtheta, alphaDtheta, b0;
     double A, B, C, D, p, fr, lambda, NextDLambda;
     int maxIter = 50;
@@ -2404,38 +2748,52 @@ ManzariDafalias::Stress_Correction(const Vector& CurStress, const Vector& CurStr
         if (fr < mTolF)
         {
             NextDLambda = (m_Pmin - p) / K;
-            NextElasticStrain += one3 * NextDLambda * mI1;
-            NextStress += K * NextDLambda * mI1;
+            for (int i = 0; i < 3; i++) {
+                NextElasticStrain[i] += one3 * NextDLambda;
+                NextStress[i] += K * NextDLambda;
+            }
             NextDGamma = 0.0;
-            aCep_Consistent = aCep = aC = GetStiffness(K, G);
+            GetStiffness(K, G, aC);
+            aCep = aC;
+            aCep_Consistent = aC;
 
         } else {
 
             // Do Newton iterations to find NextDGamma
-            GetStateDependent(NextStress, NextAlpha, NextFabric, NextVoidRatio, alpha_in, n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, 
+            GetStateDependent(NextStress, NextAlpha, NextFabric, NextVoidRatio, alpha_in, n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta,
                     b0, A, D, B, C, R);
             R = GetDevPart(R);
             NextDGamma  = 0.0;
             NextDLambda = 0.0;
 
-            Vector N(6); N = GetDevPart(NextStress) - p*NextAlpha;
+            VectorND<6> N = GetDevPart(NextStress);
+            for (int i = 0; i < 6; i++)
+                N[i] -= p*NextAlpha[i];
             double fr1  = GetNorm_Contr(N)-root23*m_m*p;
             double fr2  = m_Pmin - p;
             double J11, J12, J21, J22;
 
             for (int i = 1; i <= maxIter; i++)
             {
-                J11 = DoubleDot2_2_Contr(N/GetNorm_Contr(N),-2.0*G*R+K*D*NextAlpha)+root23*m_m*K*D;
-                J12 = DoubleDot2_2_Contr(N/GetNorm_Contr(N),-K*NextAlpha)-root23*m_m*K;
+                const double normN = GetNorm_Contr(N);
+                J11 = J12 = 0.0;
+                for (int j = 0; j < 6; j++) {
+                    J11 += N[j]/normN * (-2.0*G*R[j]+K*D*NextAlpha[j]) * (j > 2 ? 2.0 : 1.0);
+                    J12 += N[j]/normN * (-K*NextAlpha[j]) * (j > 2 ? 2.0 : 1.0);
+                }
+                J11 += root23*m_m*K*D;
+                J12 -= root23*m_m*K;
                 J21 = K*D;
                 J22 = -K;
-                
+
                 double det = 1.0 / (J11*J22-J12*J21);
 
                 NextDGamma  -= det * (J22*fr1-J12*fr2);
                 NextDLambda -= det * (J11*fr2-J21*fr1);
 
-                N = GetDevPart(NextStress) - p*NextAlpha - 2.0*G*NextDGamma*R + K*(D*NextDGamma-NextDLambda)*NextAlpha;
+                N = GetDevPart(NextStress);
+                for (int j = 0; j < 6; j++)
+                    N[j] += - p*NextAlpha[j] - 2.0*G*NextDGamma*R[j] + K*(D*NextDGamma-NextDLambda)*NextAlpha[j];
 
                 fr1  = GetNorm_Contr(N)-root23*m_m*(p-K*(D*NextDGamma-NextDLambda));
                 fr2  = m_Pmin - p + K*(D*NextDGamma-NextDLambda);
@@ -2446,70 +2804,87 @@ ManzariDafalias::Stress_Correction(const Vector& CurStress, const Vector& CurStr
 
                 if(i == maxIter)
                 {
-                    if (debugFlag) 
+                    if (debugFlag)
                         opserr << "Still outside with f =  " << fr << endln;
-                    NextStress = m_Pmin * mI1;
-                    NextAlpha.Zero();
+                    NextStress = I1; NextStress *= m_Pmin;
+                    NextAlpha.zero();
                     return;
                 }
-                
+
             }
 
             p = one3 * GetTrace(NextStress) + m_Presidual;
 
-            Vector dPStrain(6);
-            dPStrain = ToCovariant(NextDGamma * R + one3*(NextDGamma*D - NextDLambda) * mI1);
+            // dPStrain = ToCovariant(NextDGamma * R + one3*(NextDGamma*D - NextDLambda) * mI1);
+            VectorND<6> dPStrain = R;
+            dPStrain *= NextDGamma;
+            for (int i = 0; i < 3; i++)
+                dPStrain[i] += one3*(NextDGamma*D - NextDLambda);
+            dPStrain = ToCovariant(dPStrain);
             NextElasticStrain -= dPStrain;
-            NextStress -= aC * dPStrain;
+            NextStress -= DoubleDot4_2(aC, dPStrain);
         }
 
     }
-        NextStress = p * mI1;
-        NextAlpha.Zero();
+        NextStress = I1; NextStress *= p;
+        NextAlpha.zero();
         return;
     } else {
-    
+
         // See if NextStress is outside yield surface
         fr = GetF(NextStress, NextAlpha);
 
         if (fabs(fr) < mTolF)
         {
-            if (debugFlag) 
+            if (debugFlag)
                 opserr << "ManzariDafalias::StressCorrection() Stress state inside yield surface." << endln;
             return;
         } else {
-            Vector nStress = NextStress;
-            Vector nAlpha  = NextAlpha;
+            VectorND<6> nStress = NextStress;
+            VectorND<6> nAlpha  = NextAlpha;
             for (int i = 1; i <= maxIter; i++)
             {
-                if (debugFlag) 
+                if (debugFlag)
                     opserr << "ManzariDafalias::StressCorrection() Stress state outside yield surface. Correction step =  " << i << ", f = " << fr << endln;
-                
+
                 devStress = GetDevPart(nStress);
-            
+
                 // do I need to update G and K? check this!
                 // GetElasticModuli(CurStress, CurVoidRatio, K, G);
 
-                aC = GetStiffness(K, G);
+                GetStiffness(K, G, aC);
 
-                GetStateDependent(nStress, nAlpha, NextFabric, NextVoidRatio, alpha_in, n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta, 
+                GetStateDependent(nStress, nAlpha, NextFabric, NextVoidRatio, alpha_in, n, d, b, Cos3Theta, h, psi, alphaBtheta, alphaDtheta,
                     b0, A, D, B, C, R);
 
                 dSigmaP = DoubleDot4_2(aC, ToCovariant(R));
-                aBar = two3 * h * b;
-                r = devStress / p ;
-                dfrOverdSigma = n - one3 * DoubleDot2_2_Contr(n, r) * mI1;
-                dfrOverdAlpha = - p * n;
+                // aBar = two3 * h * b;
+                aBar = b; aBar *= (two3 * h);
+                // r = devStress / p ;
+                r = devStress; r /= p;
+                // dfrOverdSigma = n - one3 * DoubleDot2_2_Contr(n, r) * mI1;
+                dfrOverdSigma = n;
+                for (int j = 0; j < 3; j++)
+                    dfrOverdSigma[j] -= one3 * DoubleDot2_2_Contr(n, r);
+                // dfrOverdAlpha = - p * n;
+                dfrOverdAlpha = n; dfrOverdAlpha *= -p;
                 lambda = fr / (DoubleDot2_2_Contr(dfrOverdSigma, dSigmaP)-DoubleDot2_2_Contr(dfrOverdAlpha, aBar));
 
-                if (fabs(GetF(nStress - lambda * dSigmaP, nAlpha + lambda * aBar)) < fabs(fr))
+                // if (fabs(GetF(nStress - lambda * dSigmaP, nAlpha + lambda * aBar)) < fabs(fr))
+                for (int j = 0; j < 6; j++) {
+                    tmp0[j] = nStress[j] - lambda * dSigmaP[j];
+                    tmp1[j] = nAlpha[j] + lambda * aBar[j];
+                }
+                if (fabs(GetF(tmp0, tmp1)) < fabs(fr))
                 {
-                    nStress -= lambda * dSigmaP;
-                    nAlpha  += lambda * aBar;
+                    nStress = tmp0;
+                    nAlpha  = tmp1;
                 } else {
                     lambda = fr / DoubleDot2_2_Contr(dfrOverdSigma, dfrOverdSigma);
-                    if (fabs(GetF(nStress - lambda * dfrOverdSigma, nAlpha)) < fabs(fr))
-                        nStress -= lambda * dfrOverdSigma;
+                    for (int j = 0; j < 6; j++)
+                        tmp0[j] = nStress[j] - lambda * dfrOverdSigma[j];
+                    if (fabs(GetF(tmp0, nAlpha)) < fabs(fr))
+                        nStress = tmp0;
                     else
                     {
                         if (debugFlag)
@@ -2517,7 +2892,7 @@ ManzariDafalias::Stress_Correction(const Vector& CurStress, const Vector& CurStr
                         return;
                     }
                 }
-                
+
                 fr = GetF(nStress, nAlpha);
                 if (fabs(fr) < mTolF)
                 {
@@ -2528,15 +2903,17 @@ ManzariDafalias::Stress_Correction(const Vector& CurStress, const Vector& CurStr
 
                 if(i == maxIter)
                 {
-                    if (debugFlag) 
+                    if (debugFlag)
                         opserr << "Still outside with f =  " << fr << endln;
                     if (GetF(CurStress, NextAlpha) < mTolF)
                     {
-                        Vector dSigma = NextStress - CurStress;
+                        VectorND<6> dSigma = NextStress; dSigma -= CurStress;
                         double alpha_up = 1.0;
                         double alpha_mid = 0.5;
                         double alpha_down = 0.0;
-                        double fr_old = GetF(CurStress + alpha_mid * dSigma, NextAlpha);
+                        for (int j = 0; j < 6; j++)
+                            tmp0[j] = CurStress[j] + alpha_mid * dSigma[j];
+                        double fr_old = GetF(tmp0, NextAlpha);
                         for (int jj = 0; jj < maxIter; jj++)
                         {
                             if (fr_old < 0.0)
@@ -2546,17 +2923,19 @@ ManzariDafalias::Stress_Correction(const Vector& CurStress, const Vector& CurStr
                             } else {
                                alpha_up = alpha_mid;
                                alpha_mid = 0.5 * (alpha_down + alpha_mid);
-                            } 
+                            }
 
-                            fr_old = GetF(CurStress + alpha_mid * dSigma, NextAlpha);
+                            for (int j = 0; j < 6; j++)
+                                tmp0[j] = CurStress[j] + alpha_mid * dSigma[j];
+                            fr_old = GetF(tmp0, NextAlpha);
 
                             if (fabs(fr_old) < mTolF)
                             {
-                                NextStress = CurStress + alpha_mid * dSigma;
+                                NextStress = tmp0;
                                 break;
-                            }       
+                            }
                             if(jj == maxIter)
-                                //if (debugFlag) 
+                                //if (debugFlag)
                                     opserr << "Still outside with f =  " << fr_old << endln;
                         }
                     } else {
@@ -2565,11 +2944,15 @@ ManzariDafalias::Stress_Correction(const Vector& CurStress, const Vector& CurStr
                         NextFabric = CurFabric;
                     }
                 }
-                
+
                 p = one3 * GetTrace(NextStress) + m_Presidual;
             }
-            NextElasticStrain = CurElasticStrain + DoubleDot4_2(GetCompliance(K, G), NextStress - CurStress);
-            aCep = GetElastoPlasticTangent(NextStress, NextDGamma, CurStrain, NextStrain, G, K, B, C, D, h, n, d, b);
+            // NextElasticStrain = CurElasticStrain + DoubleDot4_2(GetCompliance(K, G), NextStress - CurStress);
+            MatrixND<6,6> aD;
+            GetCompliance(K, G, aD);
+            tmp0 = NextStress; tmp0 -= CurStress;
+            NextElasticStrain = CurElasticStrain; NextElasticStrain += DoubleDot4_2(aD, tmp0);
+            GetElastoPlasticTangent(NextStress, NextDGamma, G, K, B, C, D, h, n, b, aCep);
             aCep_Consistent = aCep;
         }
     }
@@ -2592,13 +2975,13 @@ ManzariDafalias::NewtonIter(const Vector& xo, const Vector& inVar, Vector& x, Ma
     bool jacoFlag = true;
     Matrix (ManzariDafalias::*jacoFunc)(const Vector&, const Vector&);
     // Declare variables to be used
-    static Vector sol(ResSize);
-    static Vector R(ResSize), R2(ResSize);
-    static Vector dX(ResSize);
-    static Vector norms(ResSize+1);
-	static Vector aux;
-    static Matrix jaco(ResSize,ResSize);
-    static Matrix jInv(ResSize,ResSize);
+    static thread_local Vector sol(ResSize);
+    static thread_local Vector R(ResSize), R2(ResSize);
+    static thread_local Vector dX(ResSize);
+    static thread_local Vector norms(ResSize+1);
+	static thread_local Vector aux;
+    static thread_local Matrix jaco(ResSize,ResSize);
+    static thread_local Matrix jInv(ResSize,ResSize);
     double normR1, alpha;
     double aNormR1, aNormR2;
 
@@ -4462,13 +4845,24 @@ ManzariDafalias::g(const double cos3theta, const double c)
 }
 
 
-double 
+double
 ManzariDafalias::GetF(const Vector& nStress, const Vector& nAlpha)
+{
+    VectorND<6> stress, alpha;
+    assign(stress, nStress);
+    assign(alpha, nAlpha);
+    return GetF(stress, alpha);
+}
+
+
+double
+ManzariDafalias::GetF(const VectorND<6>& nStress, const VectorND<6>& nAlpha)
 {
     // Manzari's yield function
-    Vector s(6); s = GetDevPart(nStress);
+    VectorND<6> s = GetDevPart(nStress);
     double p = one3 * GetTrace(nStress) + m_Presidual;
-    s -= p * nAlpha;
+    for (int i = 0; i < 6; i++)
+        s[i] -= p * nAlpha[i];
     return GetNorm_Contr(s) - root23 * m_m * p;
 }
 
@@ -4483,6 +4877,16 @@ ManzariDafalias::GetPSI(const double& e, const double& p)
 double 
 ManzariDafalias::GetLodeAngle(const Vector& n)
 // Returns cos(3*theta)
+{
+    VectorND<6> nn;
+    assign(nn, n);
+    return GetLodeAngle(nn);
+}
+
+
+double
+ManzariDafalias::GetLodeAngle(const VectorND<6>& n)
+// Returns cos(3*theta)
 {
     double Cos3Theta = sqrt(6.0) * GetTrace(SingleDot(n,SingleDot(n,n)));
     Cos3Theta = Cos3Theta > 1 ? 1 : Cos3Theta;
@@ -4540,11 +4944,21 @@ ManzariDafalias::GetElasticModuli(const Vector& sigma, const double& en, double
 void
 ManzariDafalias::GetElasticModuli(const Vector& sigma, const double& en, double &K, double &G)
 // Calculates G, K
+{
+    VectorND<6> stress;
+    assign(stress, sigma);
+    GetElasticModuli(stress, en, K, G);
+}
+
+
+void
+ManzariDafalias::GetElasticModuli(const VectorND<6>& sigma, const double& en, double &K, double &G)
+// Calculates G, K
 {
     double pn = one3 * GetTrace(sigma);
     pn = (pn <= m_Pmin) ? m_Pmin : pn;
 
-    if (mElastFlag == 0) 
+    if (mElastFlag == 0)
         G = m_G0 * m_P_atm * pow((2.97 - m_e_init),2) / (1 + m_e_init);
     else
         G = m_G0 * m_P_atm * pow((2.97 - m_e_init),2) / (1 + m_e_init) * sqrt(pn / m_P_atm);
@@ -4556,14 +4970,26 @@ Matrix
 ManzariDafalias::GetStiffness(const double& K, const double& G)
 // returns the stiffness matrix in its contravarinat-contravariant form
 {
-    Matrix C(6,6);
+    MatrixND<6,6> C;
+    GetStiffness(K, G, C);
+
+    Matrix aC(6,6);
+    assign(aC, C);
+    return aC;
+}
+
+
+void
+ManzariDafalias::GetStiffness(const double& K, const double& G, MatrixND<6,6>& C)
+// fills C with the stiffness matrix in its contravarinat-contravariant form
+{
+    C.zero();
     double a = K + 4.0*one3 * G;
     double b = K - 2.0*one3 * G;
     C(0,0) = C(1,1) = C(2,2) = a;
     C(3,3) = C(4,4) = C(5,5) = G;
     C(0,1) = C(0,2) = C(1,2) = b;
     C(1,0) = C(2,0) = C(2,1) = b;
-    return C;
 }
 
 
@@ -4571,7 +4997,20 @@ Matrix
 ManzariDafalias::GetCompliance(const double& K, const double& G)
 // returns the compliance matrix in its covariant-covariant form
 {
-    Matrix D(6,6);
+    MatrixND<6,6> D;
+    GetCompliance(K, G, D);
+
+    Matrix aD(6,6);
+    assign(aD, D);
+    return aD;
+}
+
+
+void
+ManzariDafalias::GetCompliance(const double& K, const double& G, MatrixND<6,6>& D)
+// fills D with the compliance matrix in its covariant-covariant form
+{
+    D.zero();
     double a = 1 / (9*K) + 1 / (3*G);
     double b = 1 / (9*K) - 1 / (6*G);
     double c = 1 / G;
@@ -4579,62 +5018,95 @@ ManzariDafalias::GetCompliance(const double& K, const double& G)
     D(3,3) = D(4,4) = D(5,5) = c;
     D(0,1) = D(0,2) = D(1,2) = b;
     D(1,0) = D(2,0) = D(2,1) = b;
-    return D;
 }
 
 
 Matrix
-ManzariDafalias::GetElastoPlasticTangent(const Vector& NextStress, const double& NextDGamma, 
+ManzariDafalias::GetElastoPlasticTangent(const Vector& NextStress, const double& NextDGamma,
                     const Vector& CurStrain, const Vector& NextStrain,
-                    const double& G, const double& K, const double& B, 
-                    const double& C,const double& D, const double& h, 
-                    const Vector& n, const Vector& d, const Vector& b) 
-{    
+                    const double& G, const double& K, const double& B,
+                    const double& C,const double& D, const double& h,
+                    const Vector& n, const Vector& d, const Vector& b)
+{
+    VectorND<6> stress, nn, bb;
+    MatrixND<6,6> Cep;
+    assign(stress, NextStress);
+    assign(nn, n);
+    assign(bb, b);
+    GetElastoPlasticTangent(stress, NextDGamma, G, K, B, C, D, h, nn, bb, Cep);
+
+    Matrix aCep(6,6);
+    assign(aCep, Cep);
+    return aCep;
+}
+
+
+void
+ManzariDafalias::GetElastoPlasticTangent(const VectorND<6>& NextStress, const double& NextDGamma,
+                    const double& G, const double& K, const double& B,
+                    const double& C,const double& D, const double& h,
+                    const VectorND<6>& n, const VectorND<6>& b, MatrixND<6,6>& aCep)
+{
     double p = one3 * GetTrace(NextStress) + m_Presidual;
     p = (p < small + m_Presidual) ? small + m_Presidual : p;
     // Vector r = GetDevPart(NextStress) / p;
-	Vector r = GetDevPart(NextStress); r /= p;
+	VectorND<6> r = GetDevPart(NextStress); r /= p;
     double Kp = two3 * p * h * DoubleDot2_2_Contr(b, n);
-    
-    Matrix aC(6,6), aCep(6,6);
-    Vector temp0(6), temp1(6), temp2(6), R(6);
+
+    MatrixND<6,6> aC;
+    VectorND<6> temp0, temp1, temp2, R;
     double temp3;
 
-    aC  = GetStiffness(K, G);
+    GetStiffness(K, G, aC);
     // R = ToCovariant((B * n ) - (C * (SingleDot(n,n)-one3*mI1)) + (one3 * D * mI1));
 	temp0 = n; temp0 *= B;
-	temp1 = mI1; temp1 *= (-1.0 * one3); temp1 += SingleDot(n, n); temp1 *= C;
-	temp2 = mI1; temp2 *= (one3 * D);
+	temp1 = I1; temp1 *= (-1.0 * one3); temp1 += SingleDot(n, n); temp1 *= C;
+	temp2 = I1; temp2 *= (one3 * D);
 	temp0 -= temp1; temp0 += temp2;
 	R = ToCovariant(temp0);
 
     temp1 = DoubleDot4_2(aC, ToCovariant(R));
     // temp2 = DoubleDot2_4(ToCovariant(n - one3 * DoubleDot2_2_Contr(n,r) * mI1), aC);
-	temp0 = mI1; temp0 *= (-1.0 * one3 * DoubleDot2_2_Contr(n, r)); temp0 += n;
+	temp0 = I1; temp0 *= (-1.0 * one3 * DoubleDot2_2_Contr(n, r)); temp0 += n;
 	temp0 = ToCovariant(temp0);
 	temp2 = DoubleDot2_4(temp0, aC);
     temp3 = DoubleDot2_2_Contr(temp2, R) + Kp;
-    if (fabs(temp3) < small) return aC;
-    
+    if (fabs(temp3) < small) {
+        aCep = aC;
+        return;
+    }
+
     // aCep = (aC - (MacauleyIndex(NextDGamma) / temp3 * (Dyadic2_2(temp1, temp2))));
-	aCep = Dyadic2_2(temp1, temp2);
-	aCep *= (-1.0 * MacauleyIndex(NextDGamma) / temp3);
-	aCep += aC;
-    return aCep;
+    const double factor = -1.0 * MacauleyIndex(NextDGamma) / temp3;
+    for (int j = 0; j < 6; j++)
+        for (int i = 0; i < 6; i++)
+            aCep(i,j) = temp1[i] * temp2[j] * factor + aC(i,j);
 }
 
 
 Vector
 ManzariDafalias::GetNormalToYield(const Vector &stress, const Vector &alpha)
 {
-    // Vector devStress(6); devStress = GetDevPart(stress);
+    VectorND<6> sigma, a;
+    assign(sigma, stress);
+    assign(a, alpha);
+    VectorND<6> nn = GetNormalToYield(sigma, a);
+
+    Vector n(6);
+    assign(n, nn);
+    return n;
+}
 
+
+VectorND<6>
+ManzariDafalias::GetNormalToYield(const VectorND<6> &stress, const VectorND<6> &alpha)
+{
     double p = one3 * GetTrace(stress) + m_Presidual;
 
-    Vector n(6); 
+    VectorND<6> n;
     if (fabs(p) < small)
     {
-        n.Zero();
+        n.zero();
     } else {
         // n = devStress - p * alpha;
         // double normN = GetNorm_Contr(n);
@@ -4681,14 +5153,37 @@ ManzariDafalias::Check(const Vector& TrialStress, const Vector& stress, const Ve
 }
 
 
-void 
+void
 ManzariDafalias::GetStateDependent(const Vector &stress, const Vector &alpha, const Vector &fabric
                 , const double &e, const Vector &alpha_in, Vector &n, Vector &d, Vector &b
                 , double &cos3Theta, double &h, double &psi, double &alphaBtheta
                 , double &alphaDtheta, double &b0, double& A, double& D, double& B
                 , double& C, Vector& R)
 {
-	Vector tmp0(6), tmp1(6);
+    VectorND<6> sigma, a, z, a_in, nn, dd, bb, RR;
+    assign(sigma, stress);
+    assign(a, alpha);
+    assign(z, fabric);
+    assign(a_in, alpha_in);
+
+    GetStateDependent(sigma, a, z, e, a_in, nn, dd, bb, cos3Theta, h, psi, alphaBtheta, alphaDtheta,
+                b0, A, D, B, C, RR);
+
+    assign(n, nn);
+    assign(d, dd);
+    assign(b, bb);
+    assign(R, RR);
+}
+
+
+void
+ManzariDafalias::GetStateDependent(const VectorND<6> &stress, const VectorND<6> &alpha, const VectorND<6> &fabric
+                , const double &e, const VectorND<6> &alpha_in, VectorND<6> &n, VectorND<6> &d, VectorND<6> &b
+                , double &cos3Theta, double &h, double &psi, double &alphaBtheta
+                , double &alphaDtheta, double &b0, double& A, double& D, double& B
+                , double& C, VectorND<6>& R)
+{
+	VectorND<6> tmp0, tmp1;
     double D_factor = 1.0;
     double p = one3 * GetTrace(stress) + m_Presidual;
     p = (p < small) ? small : p;
@@ -4705,16 +5200,16 @@ ManzariDafalias::GetStateDependent(const Vector &stress, const Vector &alpha, co
     cos3Theta = GetLodeAngle(n);
 
     alphaBtheta = g(cos3Theta, m_c) * m_Mc * exp(-1.0 * m_nb * psi) - m_m;
-    
+
     alphaDtheta = g(cos3Theta, m_c) * m_Mc * exp(m_nd * psi) - m_m;
 
     b0 = m_G0 * m_h0 * (1.0 - m_ch * e) / sqrt(p / m_P_atm);
-    
+
     // d    = root23 * alphaDtheta * n - alpha;
 	d = n; d *= (root23 * alphaDtheta); d -= alpha;
     // b    = root23 * alphaBtheta * n - alpha;
 	b = n; b *= (root23 * alphaBtheta); b -= alpha;
-        
+
 	if (fabs(AlphaAlphaInDotN) < small)
 		h = 1.0e10;
 	else
@@ -4740,8 +5235,8 @@ ManzariDafalias::GetStateDependent(const Vector &stress, const Vector &alpha, co
 
     // R = B * n - C * (SingleDot(n,n) - one3 * mI1) + one3 * D * mI1;
 	R = n; R *= B;
-	tmp0 = mI1; tmp0 *= (-1.0 * one3); tmp0 += SingleDot(n, n); tmp0 *= C;
-	tmp1 = mI1; tmp1 *= (one3 * D);
+	tmp0 = I1; tmp0 *= (-1.0 * one3); tmp0 += SingleDot(n, n); tmp0 *= C;
+	tmp1 = I1; tmp1 *= (one3 * D);
 	R -= tmp0; R += tmp1;
 }
 
@@ -4831,13 +5326,11 @@ ManzariDafalias::GetDevPart(const Vector& aV)
     if (aV.Size() != 6)
         opserr << "\n ERROR! ManzariDafalias::GetDevPart requires vector of size(6)!" << endln;
 
-    Vector result(6);
-    double p = GetTrace(aV);
-    result = aV;
-    result(0) -= one3 * p;
-    result(1) -= one3 * p;
-    result(2) -= one3 * p;
+    VectorND<6> v;
+    assign(v, aV);
 
+    Vector result(6);
+    assign(result, GetDevPart(v));
     return result;
 }
 
@@ -4848,13 +5341,12 @@ ManzariDafalias::SingleDot(const Vector& v1, const Vector& v2)
     if ((v1.Size() != 6) || (v2.Size() != 6))
         opserr << "\n ERROR! ManzariDafalias::SingleDot requires vector of size(6)!" << endln;
 
+    VectorND<6> a, b;
+    assign(a, v1);
+    assign(b, v2);
+
     Vector result(6);
-    result(0) = v1(0)*v2(0) + v1(3)*v2(3) + v1(5)*v2(5);
-    result(1) = v1(3)*v2(3) + v1(1)*v2(1) + v1(4)*v2(4);
-    result(2) = v1(5)*v2(5) + v1(4)*v2(4) + v1(2)*v2(2);
-    result(3) = 0.5*(v1(0)*v2(3) + v1(3)*v2(0) + v1(3)*v2(1) + v1(1)*v2(3) + v1(5)*v2(4) + v1(4)*v2(5));
-    result(4) = 0.5*(v1(3)*v2(5) + v1(5)*v2(3) + v1(1)*v2(4) + v1(4)*v2(1) + v1(4)*v2(2) + v1(2)*v2(4));
-    result(5) = 0.5*(v1(0)*v2(5) + v1(5)*v2(0) + v1(3)*v2(4) + v1(4)*v2(3) + v1(5)*v2(2) + v1(2)*v2(5));
+    assign(result, SingleDot(a, b));
     return result;
 }
 
@@ -4864,13 +5356,11 @@ ManzariDafalias::DoubleDot2_2_Contr(const Vector& v1, const Vector& v2)
 {
     if ((v1.Size() != 6) || (v2.Size() != 6))
         opserr << "\n ERROR! ManzariDafalias::DoubleDot2_2_Contr requires vector of size(6)!" << endln;
-    
-    double result = 0.0;
-    for (int i = 0; i < v1.Size(); i++) {
-        result += v1(i) * v2(i) + (i>2) * v1(i) * v2(i);
-    }
 
-    return result;
+    VectorND<6> a, b;
+    assign(a, v1);
+    assign(b, v2);
+    return DoubleDot2_2_Contr(a, b);
 }
 
 double
@@ -4894,13 +5384,11 @@ ManzariDafalias::DoubleDot2_2_Mixed(const Vector& v1, const Vector& v2)
 {
     if ((v1.Size() != 6) || (v2.Size() != 6))
         opserr << "\n ERROR! ManzariDafalias::DoubleDot2_2_Mixed requires vector of size(6)!" << endln;
-    
-    double result = 0.0;
-    for (int i = 0; i < v1.Size(); i++) {
-        result += v1(i) * v2(i);
-    }
 
-    return result;
+    VectorND<6> a, b;
+    assign(a, v1);
+    assign(b, v2);
+    return DoubleDot2_2_Mixed(a, b);
 }
 
 double
@@ -5154,6 +5642,112 @@ Matrix ManzariDafalias::ToCovariant(const Matrix& m1)
     return res;
 }
 
+
+// Fixed-size forms of the operations above
+
+double
+ManzariDafalias::GetTrace(const VectorND<6>& v)
+{
+    return (v[0] + v[1] + v[2]);
+}
+
+VectorND<6>
+ManzariDafalias::GetDevPart(const VectorND<6>& aV)
+{
+    VectorND<6> result = aV;
+    double p = GetTrace(aV);
+    result[0] -= one3 * p;
+    result[1] -= one3 * p;
+    result[2] -= one3 * p;
+
+    return result;
+}
+
+VectorND<6>
+ManzariDafalias::SingleDot(const VectorND<6>& v1, const VectorND<6>& v2)
+{
+    VectorND<6> result;
+    result[0] = v1[0]*v2[0] + v1[3]*v2[3] + v1[5]*v2[5];
+    result[1] = v1[3]*v2[3] + v1[1]*v2[1] + v1[4]*v2[4];
+    result[2] = v1[5]*v2[5] + v1[4]*v2[4] + v1[2]*v2[2];
+    result[3] = 0.5*(v1[0]*v2[3] + v1[3]*v2[0] + v1[3]*v2[1] + v1[1]*v2[3] + v1[5]*v2[4] + v1[4]*v2[5]);
+    result[4] = 0.5*(v1[3]*v2[5] + v1[5]*v2[3] + v1[1]*v2[4] + v1[4]*v2[1] + v1[4]*v2[2] + v1[2]*v2[4]);
+    result[5] = 0.5*(v1[0]*v2[5] + v1[5]*v2[0] + v1[3]*v2[4] + v1[4]*v2[3] + v1[5]*v2[2] + v1[2]*v2[5]);
+    return result;
+}
+
+double
+ManzariDafalias::DoubleDot2_2_Contr(const VectorND<6>& v1, const VectorND<6>& v2)
+{
+    double result = 0.0;
+    for (int i = 0; i < 6; i++)
+        result += v1[i] * v2[i] + (i>2) * v1[i] * v2[i];
+
+    return result;
+}
+
+double
+ManzariDafalias::DoubleDot2_2_Mixed(const VectorND<6>& v1, const VectorND<6>& v2)
+{
+    double result = 0.0;
+    for (int i = 0; i < 6; i++)
+        result += v1[i] * v2[i];
+
+    return result;
+}
+
+double
+ManzariDafalias::GetNorm_Contr(const VectorND<6>& v)
+{
+    return sqrt(DoubleDot2_2_Contr(v,v));
+}
+
+VectorND<6>
+ManzariDafalias::DoubleDot4_2(const MatrixND<6,6>& m1, const VectorND<6>& v1)
+{
+    VectorND<6> result;
+    result.zero();
+    for (int j = 0; j < 6; j++)
+        for (int i = 0; i < 6; i++)
+            result[i] += m1(i,j) * v1[j];
+
+    return result;
+}
+
+VectorND<6>
+ManzariDafalias::DoubleDot2_4(const VectorND<6>& v1, const MatrixND<6,6>& m1)
+{
+    VectorND<6> result;
+    result.zero();
+    for (int j = 0; j < 6; j++)
+        for (int i = 0; i < 6; i++)
+            result[j] += m1(i,j) * v1[i];
+
+    return result;
+}
+
+VectorND<6>
+ManzariDafalias::ToContraviant(const VectorND<6>& v1)
+{
+    VectorND<6> res = v1;
+    res[3] *= 0.5;
+    res[4] *= 0.5;
+    res[5] *= 0.5;
+
+    return res;
+}
+
+VectorND<6>
+ManzariDafalias::ToCovariant(const VectorND<6>& v1)
+{
+    VectorND<6> res = v1;
+    res[3] *= 2.0;
+    res[4] *= 2.0;
+    res[5] *= 2.0;
+
+    return res;
+}
+
 // send back the strain
 const Vector& 
 ManzariDafalias::getEStrain() 
@@ -5166,7 +5760,7 @@ const Vector&
 ManzariDafalias::getPStrain() 
 {
     opserr << "ManzariDafalias::getPStrain - base class function called. This is an error\n ";
-    static Vector result(6);
+    static thread_local Vector result(6);
     result = mEpsilon - mEpsilonE;
     return result; 
 } 
@@ -35,6 +35,8 @@
 #include <NDMaterial.h>
 #include <Matrix.h>
 #include <Vector.h>
+#include <VectorND.h>
+#include <MatrixND.h>
 
 #include <Information.h>
 //#include <MaterialResponse.h>
@@ -77,6 +79,7 @@ class ManzariDafalias : public NDMaterial
     NDMaterial *getCopy(void);
     const char *getType(void) const;
     int        getOrder(void) const;
+    bool       isReentrant(void) const {return true;}
 
 	// Recorder functions
 	virtual const Vector& getStressToRecord() {return mSigma;};
@@ -231,30 +234,10 @@ class ManzariDafalias : public NDMaterial
 					const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
 					Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
 					double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) ;
-	void	MaxEnergyInc(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-					const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
-					Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-					double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) ;
-	void	MaxStrainInc(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-					const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
-					Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-					double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) ;
 	void	ForwardEuler(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
 					const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
 					Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric, 
 					double& NextDGamma, double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) ;
-	void	ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-					const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
-					Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-					double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) ;
-	void	RungeKutta4(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-					const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
-					Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-					double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) ;
-	void	RungeKutta45(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-					const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
-					Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-					double& NextDGamma, double& NextVoidRatio,  double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent) ;  // By J.Abell @ UANDES - After Sloan
 	int		BackwardEuler_CPPM(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
 					const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& NextStrain,
 					Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
@@ -336,6 +319,82 @@ class ManzariDafalias : public NDMaterial
 	Matrix ToContraviant(const Matrix& m1);
 	Matrix ToCovariant(const Matrix& m1);
 
+	// Fixed-size forms of the explicit integration. All temporaries are
+	// kept on the stack so that setTrialStrain does not allocate; the
+	// Vector forms of explicit_integrator, ForwardEuler, Stress_Correction,
+	// GetStateDependent and GetElastoPlasticTangent copy their arguments
+	// and call these. BackwardEuler_CPPM and its Newton iterations remain
+	// on Vector and Matrix.
+	void	explicit_integrator(const OpenSees::VectorND<6>& CurStress, const OpenSees::VectorND<6>& CurStrain, const OpenSees::VectorND<6>& CurElasticStrain,
+					const OpenSees::VectorND<6>& CurAlpha, const OpenSees::VectorND<6>& CurFabric, const OpenSees::VectorND<6>& alpha_in, const OpenSees::VectorND<6>& NextStrain,
+					OpenSees::VectorND<6>& NextElasticStrain, OpenSees::VectorND<6>& NextStress, OpenSees::VectorND<6>& NextAlpha, OpenSees::VectorND<6>& NextFabric,
+					double& NextDGamma, double& NextVoidRatio,  double& G, double& K,
+					OpenSees::MatrixND<6,6>& aC, OpenSees::MatrixND<6,6>& aCep, OpenSees::MatrixND<6,6>& aCep_Consistent);
+	void	MaxEnergyInc(const OpenSees::VectorND<6>& CurStress, const OpenSees::VectorND<6>& CurStrain, const OpenSees::VectorND<6>& CurElasticStrain,
+					const OpenSees::VectorND<6>& CurAlpha, const OpenSees::VectorND<6>& CurFabric, const OpenSees::VectorND<6>& alpha_in, const OpenSees::VectorND<6>& NextStrain,
+					OpenSees::VectorND<6>& NextElasticStrain, OpenSees::VectorND<6>& NextStress, OpenSees::VectorND<6>& NextAlpha, OpenSees::VectorND<6>& NextFabric,
+					double& NextDGamma, double& NextVoidRatio,  double& G, double& K,
+					OpenSees::MatrixND<6,6>& aC, OpenSees::MatrixND<6,6>& aCep, OpenSees::MatrixND<6,6>& aCep_Consistent);
+	void	MaxStrainInc(const OpenSees::VectorND<6>& CurStress, const OpenSees::VectorND<6>& CurStrain, const OpenSees::VectorND<6>& CurElasticStrain,
+					const OpenSees::VectorND<6>& CurAlpha, const OpenSees::VectorND<6>& CurFabric, const OpenSees::VectorND<6>& alpha_in, const OpenSees::VectorND<6>& NextStrain,
+					OpenSees::VectorND<6>& NextElasticStrain, OpenSees::VectorND<6>& NextStress, OpenSees::VectorND<6>& NextAlpha, OpenSees::VectorND<6>& NextFabric,
+					double& NextDGamma, double& NextVoidRatio,  double& G, double& K,
+					OpenSees::MatrixND<6,6>& aC, OpenSees::MatrixND<6,6>& aCep, OpenSees::MatrixND<6,6>& aCep_Consistent);
+	void	ForwardEuler(const OpenSees::VectorND<6>& CurStress, const OpenSees::VectorND<6>& CurStrain, const OpenSees::VectorND<6>& CurElasticStrain,
+					const OpenSees::VectorND<6>& CurAlpha, const OpenSees::VectorND<6>& CurFabric, const OpenSees::VectorND<6>& alpha_in, const OpenSees::VectorND<6>& NextStrain,
+					OpenSees::VectorND<6>& NextElasticStrain, OpenSees::VectorND<6>& NextStress, OpenSees::VectorND<6>& NextAlpha, OpenSees::VectorND<6>& NextFabric,
+					double& NextDGamma, double& NextVoidRatio,  double& G, double& K,
+					OpenSees::MatrixND<6,6>& aC, OpenSees::MatrixND<6,6>& aCep, OpenSees::MatrixND<6,6>& aCep_Consistent);
+	void	ModifiedEuler(const OpenSees::VectorND<6>& CurStress, const OpenSees::VectorND<6>& CurStrain, const OpenSees::VectorND<6>& CurElasticStrain,
+					const OpenSees::VectorND<6>& CurAlpha, const OpenSees::VectorND<6>& CurFabric, const OpenSees::VectorND<6>& alpha_in, const OpenSees::VectorND<6>& NextStrain,
+					OpenSees::VectorND<6>& NextElasticStrain, OpenSees::VectorND<6>& NextStress, OpenSees::VectorND<6>& NextAlpha, OpenSees::VectorND<6>& NextFabric,
+					double& NextDGamma, double& NextVoidRatio,  double& G, double& K,
+					OpenSees::MatrixND<6,6>& aC, OpenSees::MatrixND<6,6>& aCep, OpenSees::MatrixND<6,6>& aCep_Consistent);
+	void	RungeKutta4(const OpenSees::VectorND<6>& CurStress, const OpenSees::VectorND<6>& CurStrain, const OpenSees::VectorND<6>& CurElasticStrain,
+					const OpenSees::VectorND<6>& CurAlpha, const OpenSees::VectorND<6>& CurFabric, const OpenSees::VectorND<6>& alpha_in, const OpenSees::VectorND<6>& NextStrain,
+					OpenSees::VectorND<6>& NextElasticStrain, OpenSees::VectorND<6>& NextStress, OpenSees::VectorND<6>& NextAlpha, OpenSees::VectorND<6>& NextFabric,
+					double& NextDGamma, double& NextVoidRatio,  double& G, double& K,
+					OpenSees::MatrixND<6,6>& aC, OpenSees::MatrixND<6,6>& aCep, OpenSees::MatrixND<6,6>& aCep_Consistent);
+	void	RungeKutta45(const OpenSees::VectorND<6>& CurStress, const OpenSees::VectorND<6>& CurStrain, const OpenSees::VectorND<6>& CurElasticStrain,
+					const OpenSees::VectorND<6>& CurAlpha, const OpenSees::VectorND<6>& CurFabric, const OpenSees::VectorND<6>& alpha_in, const OpenSees::VectorND<6>& NextStrain,
+					OpenSees::VectorND<6>& NextElasticStrain, OpenSees::VectorND<6>& NextStress, OpenSees::VectorND<6>& NextAlpha, OpenSees::VectorND<6>& NextFabric,
+					double& NextDGamma, double& NextVoidRatio,  double& G, double& K,
+					OpenSees::MatrixND<6,6>& aC, OpenSees::MatrixND<6,6>& aCep, OpenSees::MatrixND<6,6>& aCep_Consistent);
+	void	Stress_Correction(const OpenSees::VectorND<6>& CurStress, const OpenSees::VectorND<6>& CurStrain, const OpenSees::VectorND<6>& CurElasticStrain,
+					const OpenSees::VectorND<6>& CurAlpha, const OpenSees::VectorND<6>& CurFabric, const OpenSees::VectorND<6>& alpha_in, const OpenSees::VectorND<6>& NextStrain,
+					OpenSees::VectorND<6>& NextElasticStrain, OpenSees::VectorND<6>& NextStress, OpenSees::VectorND<6>& NextAlpha, OpenSees::VectorND<6>& NextFabric,
+					double& NextDGamma, double& NextVoidRatio,  double& G, double& K,
+					OpenSees::MatrixND<6,6>& aC, OpenSees::MatrixND<6,6>& aCep, OpenSees::MatrixND<6,6>& aCep_Consistent);
+	double	IntersectionFactor(const OpenSees::VectorND<6>& CurStress, const OpenSees::VectorND<6>& CurStrain, const OpenSees::VectorND<6>& NextStrain,
+				const OpenSees::VectorND<6>& CurAlpha, double a0, double a1);
+	double	IntersectionFactor_Unloading(const OpenSees::VectorND<6>& CurStress, const OpenSees::VectorND<6>& CurStrain, const OpenSees::VectorND<6>& NextStrain,
+				const OpenSees::VectorND<6>& CurAlpha);
+	double	GetF(const OpenSees::VectorND<6>& nStress, const OpenSees::VectorND<6>& nAlpha);
+	double	GetLodeAngle(const OpenSees::VectorND<6>& n);
+	void	GetElasticModuli(const OpenSees::VectorND<6>& sigma, const double& en, double &K, double &G);
+	void	GetStiffness(const double& K, const double& G, OpenSees::MatrixND<6,6>& C);
+	void	GetCompliance(const double& K, const double& G, OpenSees::MatrixND<6,6>& D);
+	void	GetStateDependent(const OpenSees::VectorND<6> &stress, const OpenSees::VectorND<6> &alpha, const OpenSees::VectorND<6> &fabric
+				, const double &e, const OpenSees::VectorND<6> &alpha_in, OpenSees::VectorND<6> &n, OpenSees::VectorND<6> &d, OpenSees::VectorND<6> &b
+				, double &cos3Theta, double &h, double &psi, double &alphaBtheta
+				, double &alphaDtheta, double &b0, double& A, double& D, double& B
+				, double& C, OpenSees::VectorND<6>& R);
+	void	GetElastoPlasticTangent(const OpenSees::VectorND<6>& NextStress, const double& NextDGamma,
+				const double& G, const double& K, const double& B, const double& C,const double& D, const double& h, 
+				const OpenSees::VectorND<6>& n, const OpenSees::VectorND<6>& b, OpenSees::MatrixND<6,6>& aCep);
+	OpenSees::VectorND<6>	GetNormalToYield(const OpenSees::VectorND<6> &stress, const OpenSees::VectorND<6> &alpha);
+
+	double GetTrace(const OpenSees::VectorND<6>& v);
+	OpenSees::VectorND<6> GetDevPart(const OpenSees::VectorND<6>& aV);
+	OpenSees::VectorND<6> SingleDot(const OpenSees::VectorND<6>& v1, const OpenSees::VectorND<6>& v2);
+	double DoubleDot2_2_Contr(const OpenSees::VectorND<6>& v1, const OpenSees::VectorND<6>& v2);
+	double DoubleDot2_2_Mixed(const OpenSees::VectorND<6>& v1, const OpenSees::VectorND<6>& v2);
+	double GetNorm_Contr(const OpenSees::VectorND<6>& v);
+	OpenSees::VectorND<6> DoubleDot4_2(const OpenSees::MatrixND<6,6>& m1, const OpenSees::VectorND<6>& v1);
+	OpenSees::VectorND<6> DoubleDot2_4(const OpenSees::VectorND<6>& v1, const OpenSees::MatrixND<6,6>& m1);
+	OpenSees::VectorND<6> ToContraviant(const OpenSees::VectorND<6>& v1);
+	OpenSees::VectorND<6> ToCovariant(const OpenSees::VectorND<6>& v1);
+
 };
 
 #endif
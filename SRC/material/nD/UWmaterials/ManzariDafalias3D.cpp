@@ -24,8 +24,8 @@
 
 #include "ManzariDafalias3D.h"
 
-Vector ManzariDafalias3D::mEpsilon_M(6);
-Vector ManzariDafalias3D::mSigma_M(6);
+thread_local Vector ManzariDafalias3D::mEpsilon_M(6);
+thread_local Vector ManzariDafalias3D::mSigma_M(6);
 
 // full constructor
 ManzariDafalias3D::ManzariDafalias3D(int tag, double G0, double nu, double e_init, double Mc, double c, double lambda_c, double e0, double ksi,
@@ -77,7 +77,7 @@ ManzariDafalias3D::getOrder() const
 int 
 ManzariDafalias3D::setTrialStrain(const Vector &strain_from_element) 
 {
-	mEpsilon = -1.0 * strain_from_element; // -1.0 is for geotechnical sign convention
+	mEpsilon.addVector(0.0, strain_from_element, -1.0); // -1.0 is for geotechnical sign convention
 	this->integrate();
 
 	return 0 ;
@@ -94,7 +94,7 @@ ManzariDafalias3D::setTrialStrain(const Vector &v, const Vector &r)
 const Vector& 
 ManzariDafalias3D::getStrain() 
 {
-	mEpsilon_M = -1.0 * mEpsilon;
+	mEpsilon_M.addVector(0.0, mEpsilon, -1.0);
 	return mEpsilon_M; // -1.0 is for geotechnical sign convention
 } 
 
@@ -102,14 +102,15 @@ ManzariDafalias3D::getStrain()
 const Vector& 
 ManzariDafalias3D::getEStrain() 
 {
-	mEpsilon_M = -1.0 * mEpsilonE;
+	mEpsilon_M.addVector(0.0, mEpsilonE, -1.0);
 	return mEpsilon_M; // -1.0 is for geotechnical sign convention
 } 
 
 const Vector& 
 ManzariDafalias3D::getPStrain() 
 {
-	mEpsilon_M = -1.0 * (mEpsilon - mEpsilonE);
+	mEpsilon_M = mEpsilonE;
+	mEpsilon_M.addVector(1.0, mEpsilon, -1.0);
 	return mEpsilon_M; // -1.0 is for geotechnical sign convention
 } 
 
@@ -119,7 +120,7 @@ const Vector&
 ManzariDafalias3D::getStress() 
 {
 	// this->integrate();
-	mSigma_M = -1.0 * mSigma;
+	mSigma_M.addVector(0.0, mSigma, -1.0);
  	return mSigma_M; // -1.0 is for geotechnical sign convention
 }
 
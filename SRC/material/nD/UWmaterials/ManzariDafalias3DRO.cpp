@@ -24,8 +24,8 @@
 
 #include "ManzariDafalias3DRO.h"
 
-Vector ManzariDafalias3DRO::mEpsilon_M(6);
-Vector ManzariDafalias3DRO::mSigma_M(6);
+thread_local Vector ManzariDafalias3DRO::mEpsilon_M(6);
+thread_local Vector ManzariDafalias3DRO::mSigma_M(6);
 
 // full constructor
 ManzariDafalias3DRO::ManzariDafalias3DRO(int tag, double G0, double nu, double B, double a1, double gamma1, double e_init, double Mc, double c, 
@@ -76,7 +76,7 @@ ManzariDafalias3DRO::getOrder() const
 int 
 ManzariDafalias3DRO::setTrialStrain(const Vector &strain_from_element) 
 {
-	mEpsilon = -1.0 * strain_from_element; // -1.0 is for geotechnical sign convention
+	mEpsilon.addVector(0.0, strain_from_element, -1.0); // -1.0 is for geotechnical sign convention
 
 	this->integrate();
 
@@ -94,7 +94,7 @@ ManzariDafalias3DRO::setTrialStrain(const Vector &v, const Vector &r)
 const Vector& 
 ManzariDafalias3DRO::getStrain() 
 {
-	mEpsilon_M = -1.0 * mEpsilon;
+	mEpsilon_M.addVector(0.0, mEpsilon, -1.0);
 	return mEpsilon_M; // -1.0 is for geotechnical sign convention
 } 
 
@@ -102,7 +102,7 @@ ManzariDafalias3DRO::getStrain()
 const Vector& 
 ManzariDafalias3DRO::getStress() 
 {
-	mSigma_M = -1.0 * mSigma;
+	mSigma_M.addVector(0.0, mSigma, -1.0);
  	return mSigma_M; // -1.0 is for geotechnical sign convention
 }
 
@@ -39,6 +39,8 @@
 #include <NDMaterial.h>
 #include <Matrix.h>
 #include <Vector.h>
+#include <VectorND.h>
+#include <MatrixND.h>
 
 #include <Information.h>
 //#include <MaterialResponse.h>
@@ -89,6 +91,7 @@ public:
 	NDMaterial *getCopy(void);
 	const char *getType(void) const;
 	int        getOrder(void) const;
+	bool       isReentrant(void) const {return true;}
 
 	// Recorder functions
 	virtual const Vector& getStressToRecord() { return mSigma; };
@@ -260,65 +263,65 @@ protected:
 											 //Member Functions specific for PM4Sand model
 											 //void	initialize();
 	void	integrate();
-	void	elastic_integrator(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-		const Vector& NextStrain, Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha,
+	void	elastic_integrator(const OpenSees::VectorND<3>& CurStress, const OpenSees::VectorND<3>& CurStrain, const OpenSees::VectorND<3>& CurElasticStrain,
+		const OpenSees::VectorND<3>& NextStrain, OpenSees::VectorND<3>& NextElasticStrain, OpenSees::VectorND<3>& NextStress, OpenSees::VectorND<3>& NextAlpha,
 		double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent);
-	void	explicit_integrator(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-		const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& alpha_in_p, const Vector& NextStrain,
-		Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-		double& NextDGamma, double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent);
-	void	ForwardEuler(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-		const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& alpha_in_p, const Vector& NextStrain,
-		Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-		double& NextDGamma, double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent);
-	void	ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-		const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& alpha_in_p, const Vector& NextStrain,
-		Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-		double& NextDGamma, double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent);
-	void	RungeKutta4(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-		const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& alpha_in_p, const Vector& NextStrain,
-		Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-		double& NextDGamma, double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent);
-	void	MaxStrainInc(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-		const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& alpha_in_p, const Vector& NextStrain,
-		Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
+	void	explicit_integrator(const OpenSees::VectorND<3>& CurStress, const OpenSees::VectorND<3>& CurStrain, const OpenSees::VectorND<3>& CurElasticStrain,
+		const OpenSees::VectorND<3>& CurAlpha, const OpenSees::VectorND<3>& CurFabric, const OpenSees::VectorND<3>& alpha_in, const OpenSees::VectorND<3>& alpha_in_p, const OpenSees::VectorND<3>& NextStrain,
+		OpenSees::VectorND<3>& NextElasticStrain, OpenSees::VectorND<3>& NextStress, OpenSees::VectorND<3>& NextAlpha, OpenSees::VectorND<3>& NextFabric,
 		double& NextDGamma, double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent);
+	void	ForwardEuler(const OpenSees::VectorND<3>& CurStress, const OpenSees::VectorND<3>& CurStrain, const OpenSees::VectorND<3>& CurElasticStrain,
+		const OpenSees::VectorND<3>& CurAlpha, const OpenSees::VectorND<3>& CurFabric, const OpenSees::VectorND<3>& alpha_in, const OpenSees::VectorND<3>& alpha_in_p, const OpenSees::VectorND<3>& NextStrain,
+		OpenSees::VectorND<3>& NextElasticStrain, OpenSees::VectorND<3>& NextStress, OpenSees::VectorND<3>& NextAlpha, OpenSees::VectorND<3>& NextFabric,
+		double& NextDGamma, double& NextVoidRatio, double& G, double& K);
+	void	ModifiedEuler(const OpenSees::VectorND<3>& CurStress, const OpenSees::VectorND<3>& CurStrain, const OpenSees::VectorND<3>& CurElasticStrain,
+		const OpenSees::VectorND<3>& CurAlpha, const OpenSees::VectorND<3>& CurFabric, const OpenSees::VectorND<3>& alpha_in, const OpenSees::VectorND<3>& alpha_in_p, const OpenSees::VectorND<3>& NextStrain,
+		OpenSees::VectorND<3>& NextElasticStrain, OpenSees::VectorND<3>& NextStress, OpenSees::VectorND<3>& NextAlpha, OpenSees::VectorND<3>& NextFabric,
+		double& NextDGamma, double& NextVoidRatio, double& G, double& K);
+	void	RungeKutta4(const OpenSees::VectorND<3>& CurStress, const OpenSees::VectorND<3>& CurStrain, const OpenSees::VectorND<3>& CurElasticStrain,
+		const OpenSees::VectorND<3>& CurAlpha, const OpenSees::VectorND<3>& CurFabric, const OpenSees::VectorND<3>& alpha_in, const OpenSees::VectorND<3>& alpha_in_p, const OpenSees::VectorND<3>& NextStrain,
+		OpenSees::VectorND<3>& NextElasticStrain, OpenSees::VectorND<3>& NextStress, OpenSees::VectorND<3>& NextAlpha, OpenSees::VectorND<3>& NextFabric,
+		double& NextDGamma, double& NextVoidRatio, double& G, double& K);
+	void	MaxStrainInc(const OpenSees::VectorND<3>& CurStress, const OpenSees::VectorND<3>& CurStrain, const OpenSees::VectorND<3>& CurElasticStrain,
+		const OpenSees::VectorND<3>& CurAlpha, const OpenSees::VectorND<3>& CurFabric, const OpenSees::VectorND<3>& alpha_in, const OpenSees::VectorND<3>& alpha_in_p, const OpenSees::VectorND<3>& NextStrain,
+		OpenSees::VectorND<3>& NextElasticStrain, OpenSees::VectorND<3>& NextStress, OpenSees::VectorND<3>& NextAlpha, OpenSees::VectorND<3>& NextFabric,
+		double& NextDGamma, double& NextVoidRatio, double& G, double& K);
 
-	double	IntersectionFactor(const Vector& CurStress, const Vector& CurStrain, const Vector& NextStrain, const Vector& CurAlpha,
+	double	IntersectionFactor(const OpenSees::VectorND<3>& CurStress, const OpenSees::VectorND<3>& CurStrain, const OpenSees::VectorND<3>& NextStrain, const OpenSees::VectorND<3>& CurAlpha,
 		double a0, double a1);
-	double	IntersectionFactor_Unloading(const Vector& CurStress, const Vector& CurStrain, const Vector& NextStrain, const Vector& CurAlpha);
-	void Stress_Correction(Vector& NextStress, Vector& NextAlpha, const Vector& alpha_in, const Vector& alpha_in_p, const Vector& CurFabric, double& NextVoidRatio);
-	void Stress_Correction(Vector& NextStress, Vector& NextAlpha, const Vector& dAlpha, const double m, const Vector& R, const Vector& n, const Vector& r);
+	double	IntersectionFactor_Unloading(const OpenSees::VectorND<3>& CurStress, const OpenSees::VectorND<3>& CurStrain, const OpenSees::VectorND<3>& NextStrain, const OpenSees::VectorND<3>& CurAlpha);
+	void Stress_Correction(OpenSees::VectorND<3>& NextStress, OpenSees::VectorND<3>& NextAlpha, const OpenSees::VectorND<3>& alpha_in, const OpenSees::VectorND<3>& alpha_in_p, const OpenSees::VectorND<3>& CurFabric, double& NextVoidRatio);
 	// Material Specific Methods
 	double	Macauley(double x);
 	double	MacauleyIndex(double x);
-	double	GetF(const Vector& nStress, const Vector& nAlpha);
+	double	GetF(const OpenSees::VectorND<3>& nStress, const OpenSees::VectorND<3>& nAlpha);
 	double	GetKsi(const double& e, const double& p);
-	void	GetElasticModuli(const Vector& sigma, double &K, double &G);
-	void	GetElasticModuli(const Vector& sigma, double &K, double &G, double &Mcur, const double& zcum);
-	Matrix	GetStiffness(const double& K, const double& G);
+	void	GetElasticModuli(const OpenSees::VectorND<3>& sigma, double &K, double &G);
+	void	GetElasticModuli(const OpenSees::VectorND<3>& sigma, double &K, double &G, double &Mcur, const double& zcum);
+	void	GetStiffness(const double& K, const double& G, OpenSees::MatrixND<3,3>& C);
 	Matrix	GetCompliance(const double& K, const double& G);
-	void	GetStateDependent(const Vector &stress, const Vector &alpha, const Vector &alpha_in, const Vector& alpha_in_p
-		, const Vector &fabric, const Vector &fabric_in, const double &G, const double &zcum, const double &zpeak
-		, const double &pzp, const double &Mcur, const double &dr, Vector &n, double &D, Vector &R, double &K_p
-		, Vector &alphaD, double &Cka, double &h, Vector &b, double &AlphaAlphaBDotN);
-	Matrix	GetElastoPlasticTangent(const Vector& NextStress, const Matrix& aCe, const Vector& R, const Vector& n, const double K_p);
-	Vector	GetNormalToYield(const Vector &stress, const Vector &alpha);
+	void	GetStateDependent(const OpenSees::VectorND<3> &stress, const OpenSees::VectorND<3> &alpha, const OpenSees::VectorND<3> &alpha_in, const OpenSees::VectorND<3>& alpha_in_p
+		, const OpenSees::VectorND<3> &fabric, const OpenSees::VectorND<3> &fabric_in, const double &G, const double &zcum, const double &zpeak
+		, const double &pzp, const double &Mcur, const double &dr, OpenSees::VectorND<3> &n, double &D, OpenSees::VectorND<3> &R, double &K_p
+		, OpenSees::VectorND<3> &alphaD, double &Cka, double &h, OpenSees::VectorND<3> &b, double &AlphaAlphaBDotN);
+	void	GetElastoPlasticTangent(const OpenSees::VectorND<3>& NextStress, const OpenSees::MatrixND<3,3>& aCe, const OpenSees::VectorND<3>& R,
+		const OpenSees::VectorND<3>& n, const double K_p, OpenSees::MatrixND<3,3>& aCep);
+	OpenSees::VectorND<3>	GetNormalToYield(const OpenSees::VectorND<3> &stress, const OpenSees::VectorND<3> &alpha);
 	int	Check(const Vector& TrialStress, const Vector& stress, const Vector& CurAlpha, const Vector& NextAlpha);
 
 	// Symmetric Tensor Operations
-	double GetTrace(const Vector& v);
-	Vector GetDevPart(const Vector& aV);
-	double DoubleDot2_2_Contr(const Vector& v1, const Vector& v2);
+	double GetTrace(const OpenSees::VectorND<3>& v);
+	OpenSees::VectorND<3> GetDevPart(const OpenSees::VectorND<3>& aV);
+	double DoubleDot2_2_Contr(const OpenSees::VectorND<3>& v1, const OpenSees::VectorND<3>& v2);
 	double DoubleDot2_2_Cov(const Vector& v1, const Vector& v2);
-	double DoubleDot2_2_Mixed(const Vector& v1, const Vector& v2);
-	double GetNorm_Contr(const Vector& v);
+	double DoubleDot2_2_Mixed(const OpenSees::VectorND<3>& v1, const OpenSees::VectorND<3>& v2);
+	double GetNorm_Contr(const OpenSees::VectorND<3>& v);
 	double GetNorm_Cov(const Vector& v);
 	Matrix Dyadic2_2(const Vector& v1, const Vector& v2);
-	Vector DoubleDot4_2(const Matrix& m1, const Vector& v1);
-	Vector DoubleDot2_4(const Vector& v1, const Matrix& m1);
+	OpenSees::VectorND<3> DoubleDot4_2(const OpenSees::MatrixND<3,3>& m1, const OpenSees::VectorND<3>& v1);
+	OpenSees::VectorND<3> DoubleDot2_4(const OpenSees::VectorND<3>& v1, const OpenSees::MatrixND<3,3>& m1);
 	Matrix DoubleDot4_4(const Matrix& m1, const Matrix& m2);
-	Vector ToContraviant(const Vector& v1);
-	Vector ToCovariant(const Vector& v1);
+	OpenSees::VectorND<3> ToContraviant(const OpenSees::VectorND<3>& v1);
+	OpenSees::VectorND<3> ToCovariant(const OpenSees::VectorND<3>& v1);
 };
 #endif
@@ -32,6 +32,9 @@
 #include <PM4Silt.h>
 #include <MaterialResponse.h>
 
+using OpenSees::VectorND;
+using OpenSees::MatrixND;
+
 // #include <string.h>
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -66,6 +69,40 @@ Matrix 			PM4Silt::mIIdevMix(3, 3);
 Matrix 			PM4Silt::mIIdevCo(3, 3);
 PM4Silt::initTensors PM4Silt::initTensorOps;
 
+// second-order identity tensor of the fixed-size kernels
+static const VectorND<3> I1 {1.0, 1.0, 0.0};
+
+// copy between the Vector/Matrix state and the fixed-size kernels
+static inline void
+assign(VectorND<3>& a, const Vector& v)
+{
+	for (int i = 0; i < 3; i++)
+		a[i] = v(i);
+}
+
+static inline void
+assign(Vector& v, const VectorND<3>& a)
+{
+	for (int i = 0; i < 3; i++)
+		v(i) = a[i];
+}
+
+static inline void
+assign(MatrixND<3,3>& a, const Matrix& m)
+{
+	for (int j = 0; j < 3; j++)
+		for (int i = 0; i < 3; i++)
+			a(i,j) = m(i,j);
+}
+
+static inline void
+assign(Matrix& m, const MatrixND<3,3>& a)
+{
+	for (int j = 0; j < 3; j++)
+		for (int i = 0; i < 3; i++)
+			m(i,j) = a(i,j);
+}
+
 static int numPM4SiltMaterials = 0;
 
 void * OPS_ADD_RUNTIME_VPV(OPS_PM4SiltMaterial)
@@ -396,16 +433,25 @@ PM4Silt::getCopy(const char *type)
 int
 PM4Silt::commitState(void)
 {
-	Vector n(3), R(3), dFabric(3);
-	this->GetElasticModuli(mSigma, mK, mG, mMcur, mzcum);
+	VectorND<3> n, R, dFabric, sigma, r, fabric, strain;
+	MatrixND<3,3> Ce, Cep;
+	n.zero();
+	R.zero();
+	assign(sigma, mSigma);
+	this->GetElasticModuli(sigma, mK, mG, mMcur, mzcum);
 
 	// Bounding surface correction for non K0 condition
 	if (mMcur > mMb && me2p && fabs(mSigma(1) - mSigma(0)) < 1e-5) {
 	// if (mMcur > mMb && me2p) {
-		double p = 0.5 * GetTrace(mSigma);
-		Vector r = (mSigma - p * mI1) * (mMb / mMcur / p);
-		mSigma = p * mI1 + r * p;
-		mAlpha = r * (mMb - m_m) / mMb;
+		double p = 0.5 * GetTrace(sigma);
+		// Vector r = (mSigma - p * mI1) * (mMb / mMcur / p);
+		// mSigma = p * mI1 + r * p;
+		// mAlpha = r * (mMb - m_m) / mMb;
+		for (int i = 0; i < 3; i++) {
+			r[i] = (mSigma(i) - p * I1[i]) * (mMb / mMcur / p);
+			mSigma(i) = p * I1[i] + r[i] * p;
+			mAlpha(i) = r[i] * (mMb - m_m) / mMb;
+		}
 	}
 
 	mAlpha_in_n = mAlpha_in;
@@ -417,17 +463,26 @@ PM4Silt::commitState(void)
 	mSigma_n = mSigma;
 	mEpsilon_n = mEpsilon;
 	mEpsilonE_n = mEpsilonE;
-	dFabric = mFabric - mFabric_n;
+	// dFabric = mFabric - mFabric_n;
+	for (int i = 0; i < 3; i++)
+		dFabric[i] = mFabric(i) - mFabric_n(i);
 	// update cumulated fabric
 	mzcum = mzcum + sqrt(DoubleDot2_2_Contr(dFabric, dFabric) / 2.0);
-	mzpeak = fmax(sqrt(DoubleDot2_2_Contr(mFabric, mFabric) / 2.0), mzpeak);
+	assign(fabric, mFabric);
+	mzpeak = fmax(sqrt(DoubleDot2_2_Contr(fabric, fabric) / 2.0), mzpeak);
 	mFabric_n = mFabric;
 	mFabric_in_n = mFabric_in;
 	mDGamma_n = mDGamma;
-	mVoidRatio = m_e_init - (1 + m_e_init) * GetTrace(mEpsilon);
-
-	mCe = GetStiffness(mK, mG);
-	mCep = GetElastoPlasticTangent(mSigma_n, mCe, R, n, mKp);
+	assign(strain, mEpsilon);
+	mVoidRatio = m_e_init - (1 + m_e_init) * GetTrace(strain);
+
+	// mCe = GetStiffness(mK, mG);
+	// mCep = GetElastoPlasticTangent(mSigma_n, mCe, R, n, mKp);
+	GetStiffness(mK, mG, Ce);
+	assign(mCe, Ce);
+	assign(sigma, mSigma_n);
+	GetElastoPlasticTangent(sigma, Ce, R, n, mKp, Cep);
+	assign(mCep, Cep);
 	mCep_Consistent = mCe;
 	return 0;
 }
@@ -793,14 +848,18 @@ PM4Silt::updateParameter(int responseID, Information &info)
 	}
 	// called update voidRatio
 	else if (responseID == 9) {
-		double eps_v = GetTrace(mEpsilon);
+		VectorND<3> strain;
+		assign(strain, mEpsilon);
+		double eps_v = GetTrace(strain);
 		m_e_init = (info.theDouble + eps_v) / (1 - eps_v);
 	}
 	// called PostShake
 	else if (responseID == 13) {
 		m_PostShake = 1;
 		// mElastFlag = 1;
-		GetElasticModuli(mSigma, mK, mG, mMcur, mzcum);
+		VectorND<3> sigma;
+		assign(sigma, mSigma);
+		GetElasticModuli(sigma, mK, mG, mMcur, mzcum);
 		opserr << this->getTag() << " activate post shaking reconsolidation" << endln;
 	}
 	// update undrained shear strength reduction factor Fsu
@@ -817,8 +876,11 @@ PM4Silt::updateParameter(int responseID, Information &info)
 int
 PM4Silt::initialize(Vector initStress)
 {
+	VectorND<3> sigma0, sigma, alpha;
+	MatrixND<3,3> Ce;
 	double p0;
-	p0 = 0.5 * GetTrace(initStress);
+	assign(sigma0, initStress);
+	p0 = 0.5 * GetTrace(sigma0);
 	// check secondary input parameters, use default values if negative values are assigned
 	if (m_Fsu <= 0.0) m_Fsu = 1.0;
 	if (m_h0 < 0.0) m_h0 = 0.5;
@@ -850,7 +912,9 @@ PM4Silt::initialize(Vector initStress)
 	else {
 		mSigma_n = initStress;
 		mSigma_b.Zero();
-		mAlpha_n = GetDevPart(initStress) / p0;
+		// mAlpha_n = GetDevPart(initStress) / p0;
+		alpha = GetDevPart(sigma0); alpha /= p0;
+		assign(mAlpha_n, alpha);
 	}
 	if (m_Su <= 0.0) {
 		m_Su = m_Su_rate * initStress(1);
@@ -895,7 +959,8 @@ PM4Silt::initialize(Vector initStress)
 
 	// check if initial stresses are inside bounding/dilatancy surface 
 	double Mcut = fmax(mMb, mMd);
-	double Mfin = sqrt(2.0) * GetNorm_Contr(GetDevPart(mSigma_n));
+	assign(sigma, mSigma_n);
+	double Mfin = sqrt(2.0) * GetNorm_Contr(GetDevPart(sigma));
 	Mfin = Mfin / p0;
 	if (Mfin > Mcut)
 	{
@@ -905,8 +970,12 @@ PM4Silt::initialize(Vector initStress)
 		mAlpha_n = r * (Mcut - m_m) / Mcut;
 	}
 	mzcum = 0.0;
-	GetElasticModuli(mSigma_n, mK, mG, mMcur, mzcum);
-	mCe = mCep = mCep_Consistent = GetStiffness(mK, mG);
+	assign(sigma, mSigma_n);
+	GetElasticModuli(sigma, mK, mG, mMcur, mzcum);
+	// mCe = mCep = mCep_Consistent = GetStiffness(mK, mG);
+	GetStiffness(mK, mG, Ce);
+	assign(mCe, Ce);
+	mCep = mCep_Consistent = mCe;
 	mKp = 100 * mG;
 	mAlpha = mAlpha_n;
 	mAlpha_in_n = mAlpha_n;
@@ -936,7 +1005,8 @@ int
 PM4Silt::initialize()
 {
 	// set Initial parameters with p = p_atm
-	Vector mSig(3);
+	VectorND<3> mSig;
+	MatrixND<3,3> Ce;
 	m_Pmin = m_P_atm / 200.0;
 	mSig(0) = m_P_atm;
 	mSig(1) = m_P_atm;
@@ -945,7 +1015,10 @@ PM4Silt::initialize()
 	mzcum = 0.0;
 	mzpeak = m_z_max / 100000.0;
 	GetElasticModuli(mSig, mK, mG);
-	mCe = mCep = mCep_Consistent = GetStiffness(mK, mG);
+	// mCe = mCep = mCep_Consistent = GetStiffness(mK, mG);
+	GetStiffness(mK, mG, Ce);
+	assign(mCe, Ce);
+	mCep = mCep_Consistent = mCe;
 
 	return 0;
 }
@@ -1080,30 +1153,39 @@ void PM4Silt::integrate()
 	mFabric = mFabric_n;
 	mFabric_in = mFabric_in_n;
 
-	Vector n_tr(3), tmp0(3), tmp1(3), mAlpha_mAlpha_in_true(3);
+	VectorND<3> n_tr, tmp0, tmp1, mAlpha_mAlpha_in_true;
+	MatrixND<3,3> Ce;
 	// n_tr = GetNormalToYield(mSigma_n + mCe*(mEpsilon - mEpsilon_n), mAlpha);
-	tmp0 += mSigma_n; tmp1 = mEpsilon; tmp1 -= mEpsilon_n;
-	tmp0 += (mCe * tmp1);
-	n_tr = GetNormalToYield(tmp0, mAlpha);
+	for (int i = 0; i < 3; i++)
+		tmp1[i] = mEpsilon(i) - mEpsilon_n(i);
+	assign(Ce, mCe);
+	tmp0 = DoubleDot4_2(Ce, tmp1);
+	for (int i = 0; i < 3; i++)
+		tmp0[i] += mSigma_n(i);
+	assign(tmp1, mAlpha);
+	n_tr = GetNormalToYield(tmp0, tmp1);
 	// n_tr = GetNormalToYield(mSigma_n, mAlpha);
 
 	// if ((DoubleDot2_2_Contr(mAlpha - mAlpha_in_true, n_tr) < 0.0) && me2p) {
-	mAlpha_mAlpha_in_true = mAlpha; mAlpha_mAlpha_in_true -= mAlpha_in_true;
+	for (int i = 0; i < 3; i++)
+		mAlpha_mAlpha_in_true[i] = mAlpha(i) - mAlpha_in_true(i);
 	if ((DoubleDot2_2_Contr(mAlpha_mAlpha_in_true, n_tr) < 0.0) && me2p) {
 		mAlpha_in_p = mAlpha_in;
 		mAlpha_in_true = mAlpha;
 		mFabric_in = mFabric;
 		// This is a loading reversal
 		// update pzp
-		double p = 0.5 * GetTrace(mSigma_n);
+		assign(tmp0, mSigma_n);
+		double p = 0.5 * GetTrace(tmp0);
 		p = (p <= m_Pmin) ? (m_Pmin) : p;
-		double zxpTemp = GetNorm_Contr(mFabric_n) * p;
+		assign(tmp1, mFabric_n);
+		double zxpTemp = GetNorm_Contr(tmp1) * p;
 		if (((zxpTemp > mzxp) && (p > mpzp)) || m_pzpFlag) {
 			mzxp = zxpTemp;
 			mpzp = p;
 			m_pzpFlag = false;
 		}
-		// track initial back-stress ratio history 
+		// track initial back-stress ratio history
 		for (int ii = 0; ii < 3; ii++) {
 			if (mAlpha_in(ii) > 0.0)
 				// minimum positive value
@@ -1126,42 +1208,61 @@ void PM4Silt::integrate()
 			mAlpha_in = mAlpha;
 	}
 
+	// the integrators work on fixed-size copies of the state
+	VectorND<3> curStress, curStrain, curElasticStrain, curAlpha, curFabric, alphaIn, alphaInP, nextStrain;
+	VectorND<3> nextElasticStrain, nextStress, nextAlpha, nextFabric;
+	assign(curStress, mSigma_n);
+	assign(curStrain, mEpsilon_n);
+	assign(curElasticStrain, mEpsilonE_n);
+	assign(nextStrain, mEpsilon);
+	assign(nextAlpha, mAlpha);
+
 	// Force elastic response
 	if (me2p == 0) {
-		elastic_integrator(mSigma_n, mEpsilon_n, mEpsilonE_n, mEpsilon, mEpsilonE, mSigma, mAlpha,
+		elastic_integrator(curStress, curStrain, curElasticStrain, nextStrain, nextElasticStrain, nextStress, nextAlpha,
 			mVoidRatio, mG, mK, mCe, mCep, mCep_Consistent);
 	}
 	// ElastoPlastic response
 	else {
+		assign(curAlpha, mAlpha_n);
+		assign(curFabric, mFabric_n);
+		assign(alphaIn, mAlpha_in);
+		assign(alphaInP, mAlpha_in_p);
 		// explicit schemes
-		explicit_integrator(mSigma_n, mEpsilon_n, mEpsilonE_n, mAlpha_n, mFabric_n, mAlpha_in,
-			mAlpha_in_p, mEpsilon, mEpsilonE, mSigma, mAlpha, mFabric, mDGamma, mVoidRatio, mG,
+		explicit_integrator(curStress, curStrain, curElasticStrain, curAlpha, curFabric, alphaIn,
+			alphaInP, nextStrain, nextElasticStrain, nextStress, nextAlpha, nextFabric, mDGamma, mVoidRatio, mG,
 			mK, mCe, mCep, mCep_Consistent);
+		assign(mFabric, nextFabric);
 	}
-
+	assign(mEpsilonE, nextElasticStrain);
+	assign(mSigma, nextStress);
+	assign(mAlpha, nextAlpha);
 }
 // -------------------------------------------------------------------------------------------------------
 /*************************************************************/
 // Elastic Integrator
 /*************************************************************/
-void PM4Silt::elastic_integrator(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-	const Vector& NextStrain, Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha,
+void PM4Silt::elastic_integrator(const VectorND<3>& CurStress, const VectorND<3>& CurStrain, const VectorND<3>& CurElasticStrain,
+	const VectorND<3>& NextStrain, VectorND<3>& NextElasticStrain, VectorND<3>& NextStress, VectorND<3>& NextAlpha,
 	double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent)
 {
-	Vector dStrain(3);
+	VectorND<3> dStrain;
+	MatrixND<3,3> C;
 
 	// calculate elastic response
-	// dStrain = NextStrain - CurStrain;
 	dStrain = NextStrain; dStrain -= CurStrain;
 	NextVoidRatio = m_e_init - (1 + m_e_init) * GetTrace(NextStrain);
 	// NextElasticStrain = CurElasticStrain + dStrain;
 	NextElasticStrain = CurElasticStrain; NextElasticStrain += dStrain;
-	aCep_Consistent = aCep = aC = GetStiffness(K, G);
+	// aCep_Consistent = aCep = aC = GetStiffness(K, G);
+	GetStiffness(K, G, C);
+	assign(aC, C); aCep = aC; aCep_Consistent = aC;
 	// NextStress = CurStress + DoubleDot4_2(aC, dStrain);
-	NextStress = CurStress; NextStress += DoubleDot4_2(aC, dStrain);
+	NextStress = CurStress; NextStress += DoubleDot4_2(C, dStrain);
 	double p = 0.5 * GetTrace(NextStress);
 	if (p > m_Pmin) {
-		NextAlpha = GetDevPart(NextStress) / p;
+		// NextAlpha = GetDevPart(NextStress) / p;
+		NextAlpha = GetDevPart(NextStress); NextAlpha /= p;
 	}
 
 }
@@ -1169,15 +1270,15 @@ void PM4Silt::elastic_integrator(const Vector& CurStress, const Vector& CurStrai
 /*************************************************************/
 // Explicit Integrator
 /*************************************************************/
-void PM4Silt::explicit_integrator(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-	const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& alpha_in_p, const Vector& NextStrain,
-	Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
+void PM4Silt::explicit_integrator(const VectorND<3>& CurStress, const VectorND<3>& CurStrain, const VectorND<3>& CurElasticStrain,
+	const VectorND<3>& CurAlpha, const VectorND<3>& CurFabric, const VectorND<3>& alpha_in, const VectorND<3>& alpha_in_p, const VectorND<3>& NextStrain,
+	VectorND<3>& NextElasticStrain, VectorND<3>& NextStress, VectorND<3>& NextAlpha, VectorND<3>& NextFabric,
 	double& NextL, double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent)
 {
 	// function pointer to the integration scheme
-	void (PM4Silt::*exp_int) (const Vector&, const Vector&, const Vector&, const Vector&, const Vector&, const Vector&,
-		const Vector&, const Vector&, Vector&, Vector&, Vector&, Vector&, double&, double&, double&, double&,
-		Matrix&, Matrix&, Matrix&);
+	void (PM4Silt::*exp_int) (const VectorND<3>&, const VectorND<3>&, const VectorND<3>&, const VectorND<3>&, const VectorND<3>&,
+		const VectorND<3>&, const VectorND<3>&, const VectorND<3>&, VectorND<3>&, VectorND<3>&, VectorND<3>&, VectorND<3>&,
+		double&, double&, double&, double&);
 
 	switch (mScheme) {
 	case INT_ForwardEuler:	// Forward Euler
@@ -1201,7 +1302,9 @@ void PM4Silt::explicit_integrator(const Vector& CurStress, const Vector& CurStra
 	}
 
 	double elasticRatio, f, fn, dVolStrain;
-	Vector dStrain(3), dSigma(3), dDevStrain(3), n(3), tmp(3), dElasStrain(3);
+	VectorND<3> dStrain, dSigma, dDevStrain, n, tmp, dElasStrain;
+	VectorND<3> startStress, startStrain, startElasticStrain;
+	MatrixND<3,3> C;
 
 	// NextElasticStrain = CurElasticStrain + NextStrain - CurStrain;
 	// dVolStrain = GetTrace(NextStrain - CurStrain);
@@ -1209,12 +1312,13 @@ void PM4Silt::explicit_integrator(const Vector& CurStress, const Vector& CurStra
 	dStrain = NextStrain; dStrain -= CurStrain;
 	NextElasticStrain = CurElasticStrain; NextElasticStrain += dStrain;
 	dVolStrain = GetTrace(dStrain);
-	dDevStrain += mI1; dDevStrain *= (-1.0 * dVolStrain / 3.0); dDevStrain += dStrain;
+	dDevStrain = I1; dDevStrain *= (-1.0 * dVolStrain / 3.0); dDevStrain += dStrain;
 
-	aC = GetStiffness(K, G);
+	GetStiffness(K, G, C);
+	assign(aC, C);
 	// dSigma = 2 * mG * ToContraviant(dDevStrain) + mK * dVolStrain * mI1;
 	tmp = ToContraviant(dDevStrain); tmp *= (2 * mG);
-	dSigma = mI1; dSigma *= (mK * dVolStrain); dSigma += tmp;
+	dSigma = I1; dSigma *= (mK * dVolStrain); dSigma += tmp;
 	// NextStress = CurStress + dSigma;
 	NextStress = CurStress; NextStress += dSigma;
 
@@ -1231,7 +1335,7 @@ void PM4Silt::explicit_integrator(const Vector& CurStress, const Vector& CurStra
 		NextFabric = CurFabric;
 		NextL = 0;
 		aCep_Consistent = aCep = aC;
-		// Stress_Correction(CurStress, CurStrain, CurElasticStrain, CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain, 
+		// Stress_Correction(CurStress, CurStrain, CurElasticStrain, CurAlpha, CurFabric, alpha_in, NextStrain, NextElasticStrain,
 		// NextStress, NextAlpha, NextFabric, NextL, NextVoidRatio, G, K , aC, aCep, aCep_Consistent);
 
 		return;
@@ -1242,13 +1346,16 @@ void PM4Silt::explicit_integrator(const Vector& CurStress, const Vector& CurStra
 		elasticRatio = IntersectionFactor(CurStress, CurStrain, NextStrain, CurAlpha, 0.0, 1.0);
 		// dSigma = DoubleDot4_2(aC, elasticRatio*(dStrain));
 		dElasStrain = dStrain; dElasStrain *= elasticRatio;
-		dSigma = DoubleDot4_2(aC, dElasStrain);
+		dSigma = DoubleDot4_2(C, dElasStrain);
 		// (this->*exp_int)(CurStress + dSigma, CurStrain + elasticRatio*(NextStrain - CurStrain), CurElasticStrain + elasticRatio*(NextStrain - CurStrain),
 		// 	CurAlpha, CurFabric, alpha_in, alpha_in_p, NextStrain, NextElasticStrain, NextStress, NextAlpha, NextFabric, NextL, NextVoidRatio,
 		// 	G, K, aC, aCep, aCep_Consistent);
-		(this->*exp_int)(CurStress + dSigma, CurStrain + dElasStrain, CurElasticStrain + dElasStrain,
+		startStress = CurStress; startStress += dSigma;
+		startStrain = CurStrain; startStrain += dElasStrain;
+		startElasticStrain = CurElasticStrain; startElasticStrain += dElasStrain;
+		(this->*exp_int)(startStress, startStrain, startElasticStrain,
 			CurAlpha, CurFabric, alpha_in, alpha_in_p, NextStrain, NextElasticStrain, NextStress, NextAlpha, NextFabric, NextL, NextVoidRatio,
-			G, K, aC, aCep, aCep_Consistent);
+			G, K);
 
 		return;
 	}
@@ -1256,7 +1363,7 @@ void PM4Silt::explicit_integrator(const Vector& CurStress, const Vector& CurStra
 		if (DoubleDot2_2_Contr(GetNormalToYield(CurStress, CurAlpha), dSigma) / (GetNorm_Contr(dSigma) == 0 ? 1.0 : GetNorm_Contr(dSigma)) > (-sqrt(mTolF))) {
 			// This is a pure plastic step
 			(this->*exp_int)(CurStress, CurStrain, CurElasticStrain, CurAlpha, CurFabric, alpha_in, alpha_in_p, NextStrain, NextElasticStrain, NextStress, NextAlpha,
-				NextFabric, NextL, NextVoidRatio, G, K, aC, aCep, aCep_Consistent);
+				NextFabric, NextL, NextVoidRatio, G, K);
 
 			return;
 		}
@@ -1265,10 +1372,13 @@ void PM4Silt::explicit_integrator(const Vector& CurStress, const Vector& CurStra
 			elasticRatio = IntersectionFactor_Unloading(CurStress, CurStrain, NextStrain, CurAlpha);
 			// dSigma = DoubleDot4_2(aC, elasticRatio*(NextStrain - CurStrain));
 			dElasStrain = dStrain; dElasStrain *= elasticRatio;
-			dSigma = DoubleDot4_2(aC, dElasStrain);
-			(this->*exp_int)(CurStress + dSigma, CurStrain + dElasStrain, CurElasticStrain + dElasStrain,
+			dSigma = DoubleDot4_2(C, dElasStrain);
+			startStress = CurStress; startStress += dSigma;
+			startStrain = CurStrain; startStrain += dElasStrain;
+			startElasticStrain = CurElasticStrain; startElasticStrain += dElasStrain;
+			(this->*exp_int)(startStress, startStrain, startElasticStrain,
 				CurAlpha, CurFabric, alpha_in, alpha_in_p, NextStrain, NextElasticStrain, NextStress, NextAlpha, NextFabric, NextL, NextVoidRatio,
-				G, K, aC, aCep, aCep_Consistent);
+				G, K);
 
 			return;
 		}
@@ -1278,7 +1388,7 @@ void PM4Silt::explicit_integrator(const Vector& CurStress, const Vector& CurStra
 		if (debugFlag) opserr << "PM4Silt : Encountered an illegal stress state! Tag: " << this->getTag() << endln;
 		if (debugFlag) opserr << "                  f = " << GetF(CurStress, CurAlpha) << endln;
 		(this->*exp_int)(CurStress, CurStrain, CurElasticStrain, CurAlpha, CurFabric, alpha_in, alpha_in_p, NextStrain, NextElasticStrain, NextStress, NextAlpha,
-			NextFabric, NextL, NextVoidRatio, G, K, aC, aCep, aCep_Consistent);
+			NextFabric, NextL, NextVoidRatio, G, K);
 		return;
 	}
 }
@@ -1287,14 +1397,17 @@ void PM4Silt::explicit_integrator(const Vector& CurStress, const Vector& CurStra
 /*************************************************************/
 // Forward-Euler Integrator
 /*************************************************************/
-void PM4Silt::ForwardEuler(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-	const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& alpha_in_p, const Vector& NextStrain,
-	Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-	double& NextL, double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent)
+void PM4Silt::ForwardEuler(const VectorND<3>& CurStress, const VectorND<3>& CurStrain, const VectorND<3>& CurElasticStrain,
+	const VectorND<3>& CurAlpha, const VectorND<3>& CurFabric, const VectorND<3>& alpha_in, const VectorND<3>& alpha_in_p, const VectorND<3>& NextStrain,
+	VectorND<3>& NextElasticStrain, VectorND<3>& NextStress, VectorND<3>& NextAlpha, VectorND<3>& NextFabric,
+	double& NextL, double& NextVoidRatio, double& G, double& K)
 {
 	double CurVoidRatio, Cka, h, p, dVolStrain, D, AlphaAlphaBDotN;
-	Vector n(3), R(3), alphaD(3), dPStrain(3), b(3), dDevStrain(3), r(3), dStrain(3);
-	Vector dSigma(3), dAlpha(3), dFabric(3);
+	VectorND<3> n, R, alphaD, dPStrain, b, dDevStrain, r, dStrain, fabricIn;
+	VectorND<3> dSigma, dAlpha, dFabric, tmp0, tmp1, tmp2;
+
+	dFabric.zero();
+	assign(fabricIn, mFabric_in);
 
 	this->GetElasticModuli(NextStress, K, G, mMcur, mzcum);
 	CurVoidRatio = m_e_init - (1 + m_e_init) * GetTrace(CurStrain);
@@ -1305,17 +1418,17 @@ void PM4Silt::ForwardEuler(const Vector& CurStress, const Vector& CurStrain, con
 	dStrain = NextStrain; dStrain -= CurStrain;
 	NextElasticStrain = CurElasticStrain; NextElasticStrain += dStrain;
 	// using NextStress instead of CurStress to get correct n
-	GetStateDependent(NextStress, CurAlpha, alpha_in, alpha_in_p, CurFabric, mFabric_in, mG, mzcum,
+	GetStateDependent(NextStress, CurAlpha, alpha_in, alpha_in_p, CurFabric, fabricIn, mG, mzcum,
 		mzpeak, mpzp, mMcur, CurVoidRatio, n, D, R, mKp, alphaD, Cka, h, b, AlphaAlphaBDotN);
 	// dVolStrain = GetTrace(NextStrain - CurStrain);
 	dVolStrain = GetTrace(dStrain);
 	// dDevStrain = (NextStrain - CurStrain) - dVolStrain / 3.0 * mI1;
-	dDevStrain = mI1;
+	dDevStrain = I1;
 	dDevStrain *= (-1.0 * dVolStrain / 3.0);
 	dDevStrain += dStrain;
 	// r = GetDevPart(CurStress) / p;
 	r = GetDevPart(NextStress);  r /= p;
-	double temp4 = mKp + 2 * G - K* D *DoubleDot2_2_Contr(n, r);
+	double temp4 = mKp + 2 * G - K * D * DoubleDot2_2_Contr(n, r);
 	// if (temp4 < 0.0) {
 	// 	mKp = -0.5 * (2 * G - K* D *DoubleDot2_2_Contr(n, r));
 	// 	temp4 = mKp + 2 * G - K* D *DoubleDot2_2_Contr(n, r);
@@ -1323,9 +1436,9 @@ void PM4Silt::ForwardEuler(const Vector& CurStress, const Vector& CurStrain, con
 	// }
 	if (fabs(temp4) < small) {
 		// Neutral loading
-		dSigma.Zero();
-		dAlpha.Zero();
-		dFabric.Zero();
+		dSigma.zero();
+		dAlpha.zero();
+		dFabric.zero();
 		// dPStrain = dDevStrain + dVolStrain * mI1;
 		dPStrain = dStrain;
 	}
@@ -1337,24 +1450,26 @@ void PM4Silt::ForwardEuler(const Vector& CurStress, const Vector& CurStrain, con
 				opserr << "NextL is smaller than 0\n";
 				opserr << "NextL = " << NextL << endln;
 			}
-			dSigma = 2 * G * ToContraviant(dDevStrain) + K * dVolStrain * mI1;
-			// dAlpha = GetDevPart(NextStress + dSigma) / (0.5 * GetTrace(NextStress + dSigma))
-			// 	- GetDevPart(NextStress) / (0.5 * GetTrace(NextStress));
-			dAlpha.Zero();
-			dFabric.Zero();
-			dPStrain.Zero();
+			// dSigma = 2 * G * ToContraviant(dDevStrain) + K * dVolStrain * mI1;
+			tmp2 = I1; tmp2 *= (K * dVolStrain);
+			dSigma = ToContraviant(dDevStrain); dSigma *= (2 * G);
+			dSigma += tmp2;
+			dAlpha.zero();
+			dFabric.zero();
+			dPStrain.zero();
 		}
 		else {
 			// dSigma = 2.0*mG*mIIcon*dDevStrain + mK*dVolStrain*mI1 - Macauley(NextL)*
 			// 	(2.0 * mG * n + mK * D * mI1);
-			Vector tmp0(n), tmp1(mI1), tmp2(mI1);
-			tmp0 *= (2.0 * G);
-			tmp1 *= (K * D); tmp1 += tmp0; tmp1 *= (-Macauley(NextL));
-			tmp2 *= (K * dVolStrain);
+			tmp0 = n; tmp0 *= (2.0 * G);
+			tmp1 = I1; tmp1 *= (K * D); tmp1 += tmp0; tmp1 *= (-Macauley(NextL));
+			tmp2 = I1; tmp2 *= (K * dVolStrain);
 			dSigma = ToContraviant(dDevStrain); dSigma *= (2.0 * G);
 			dSigma += tmp2; dSigma += tmp1;
 			// update fabric
-			if (DoubleDot2_2_Contr(alphaD - CurAlpha, n) < 0.0) {
+			// if (DoubleDot2_2_Contr(alphaD - CurAlpha, n) < 0.0) {
+			tmp0 = alphaD; tmp0 -= CurAlpha;
+			if (DoubleDot2_2_Contr(tmp0, n) < 0.0) {
 				// dFabric = m_cz / (1 + Macauley(mzcum / 2.0 / m_z_max - 1.0)) * Macauley(NextL)*MacauleyIndex(-D)*(m_z_max * n + CurFabric);
 				dFabric = n;
 				dFabric *= m_z_max;
@@ -1384,15 +1499,15 @@ void PM4Silt::ForwardEuler(const Vector& CurStress, const Vector& CurStrain, con
 /*************************************************************/
 // Integrator Constraining Maximum Strain Increment
 /*************************************************************/
-void PM4Silt::MaxStrainInc(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-	const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& alpha_in_p, const Vector& NextStrain,
-	Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-	double& NextL, double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent)
+void PM4Silt::MaxStrainInc(const VectorND<3>& CurStress, const VectorND<3>& CurStrain, const VectorND<3>& CurElasticStrain,
+	const VectorND<3>& CurAlpha, const VectorND<3>& CurFabric, const VectorND<3>& alpha_in, const VectorND<3>& alpha_in_p, const VectorND<3>& NextStrain,
+	VectorND<3>& NextElasticStrain, VectorND<3>& NextStress, VectorND<3>& NextAlpha, VectorND<3>& NextFabric,
+	double& NextL, double& NextVoidRatio, double& G, double& K)
 {
 	// function pointer to the integration scheme
-	void (PM4Silt::*exp_int) (const Vector&, const Vector&, const Vector&, const Vector&, const Vector&, const Vector&,
-		const Vector&, const Vector&, Vector&, Vector&, Vector&, Vector&, double&, double&, double&, double&,
-		Matrix&, Matrix&, Matrix&);
+	void (PM4Silt::*exp_int) (const VectorND<3>&, const VectorND<3>&, const VectorND<3>&, const VectorND<3>&, const VectorND<3>&,
+		const VectorND<3>&, const VectorND<3>&, const VectorND<3>&, VectorND<3>&, VectorND<3>&, VectorND<3>&, VectorND<3>&,
+		double&, double&, double&, double&);
 
 	switch (mScheme)
 	{
@@ -1406,7 +1521,7 @@ void PM4Silt::MaxStrainInc(const Vector& CurStress, const Vector& CurStrain, con
 		exp_int = &PM4Silt::ModifiedEuler;
 		break;
 	}
-	Vector StrainInc(3); StrainInc = NextStrain;  StrainInc -= CurStrain;
+	VectorND<3> StrainInc = NextStrain; StrainInc -= CurStrain;
 	double maxInc = StrainInc(0);
 
 	for (int ii = 1; ii < 3; ii++)
@@ -1415,12 +1530,10 @@ void PM4Silt::MaxStrainInc(const Vector& CurStress, const Vector& CurStrain, con
 
 	if (fabs(maxInc) > maxStrainInc) {
 		int numSteps = (int)floor(fabs(maxInc) / maxStrainInc) + 1;
-		// StrainInc = (NextStrain - CurStrain) / (double)numSteps;
-		StrainInc = NextStrain; StrainInc -= CurStrain; StrainInc /= (double)numSteps;
+		StrainInc /= (double)numSteps;
 
-		Vector cStress(3), cStrain(3), cAlpha(3), cFabric(3), cAlpha_in(3), cAlpha_in_p(3), cEStrain(3);
-		Vector nStrain(3);
-		Matrix nCe(3, 3), nCep(3, 3), nCepC(3, 3);
+		VectorND<3> cStress, cStrain, cAlpha, cFabric, cAlpha_in, cAlpha_in_p, cEStrain;
+		VectorND<3> nStrain;
 		double nL, nVoidRatio, nG, nK;
 
 		// create temporary variables
@@ -1430,10 +1543,10 @@ void PM4Silt::MaxStrainInc(const Vector& CurStress, const Vector& CurStrain, con
 
 		for (int ii = 1; ii <= numSteps; ii++)
 		{
-			nStrain = cStrain + StrainInc;
+			nStrain = cStrain; nStrain += StrainInc;
 
 			(this->*exp_int)(cStress, cStrain, cEStrain, cAlpha, cFabric, cAlpha_in, cAlpha_in_p, nStrain, NextElasticStrain, NextStress, NextAlpha,
-				NextFabric, nL, nVoidRatio, nG, nK, nCe, nCep, nCepC);
+				NextFabric, nL, nVoidRatio, nG, nK);
 
 			cStress = NextStress; cStrain = nStrain; cEStrain = NextElasticStrain;  cAlpha = NextAlpha; cFabric = NextFabric;
 		}
@@ -1441,7 +1554,7 @@ void PM4Silt::MaxStrainInc(const Vector& CurStress, const Vector& CurStrain, con
 	}
 	else {
 		(this->*exp_int)(CurStress, CurStrain, CurElasticStrain, CurAlpha, CurFabric, alpha_in, alpha_in_p, NextStrain, NextElasticStrain, NextStress, NextAlpha,
-			NextFabric, NextL, NextVoidRatio, G, K, aC, aCep, aCep_Consistent);
+			NextFabric, NextL, NextVoidRatio, G, K);
 	}
 	return;
 }
@@ -1449,17 +1562,22 @@ void PM4Silt::MaxStrainInc(const Vector& CurStress, const Vector& CurStrain, con
 /*************************************************************/
 // Modified-Euler Integrator
 /*************************************************************/
-void PM4Silt::ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-	const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& alpha_in_p, const Vector& NextStrain,
-	Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-	double& NextL, double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent)
+void PM4Silt::ModifiedEuler(const VectorND<3>& CurStress, const VectorND<3>& CurStrain, const VectorND<3>& CurElasticStrain,
+	const VectorND<3>& CurAlpha, const VectorND<3>& CurFabric, const VectorND<3>& alpha_in, const VectorND<3>& alpha_in_p, const VectorND<3>& NextStrain,
+	VectorND<3>& NextElasticStrain, VectorND<3>& NextStress, VectorND<3>& NextAlpha, VectorND<3>& NextFabric,
+	double& NextL, double& NextVoidRatio, double& G, double& K)
 {
 	double dVolStrain, p, Cka, temp4, curStepError, q, stressNorm, h, D, AlphaAlphaBDotN;
-	Vector n(3), R1(3), R2(3), alphaD(3), dDevStrain(3), r(3), b(3), tmp0(3), tmp1(3), tmp2(3), alphaD_NextAlpha(3);
-	Vector nStress(3), nAlpha(3), nFabric(3);
-	Vector dSigma1(3), dSigma2(3), dAlpha1(3), dAlpha2(3), dFabric1(3), dFabric2(3), dPStrain1(3), dPStrain2(3);
+	VectorND<3> n, R1, R2, alphaD, dDevStrain, r, b, tmp0, tmp1, tmp2, alphaD_NextAlpha;
+	VectorND<3> nStress, nAlpha, nFabric, fabricIn;
+	VectorND<3> dSigma1, dSigma2, dAlpha1, dAlpha2, dFabric1, dFabric2, dPStrain1, dPStrain2;
 	double T = 0.0, dT = 1.0, dT_min = 1e-4, TolE = 1e-5;
 
+	// the fabric increments are only updated when loading towards the dilatancy surface
+	dFabric1.zero();
+	dFabric2.zero();
+	assign(fabricIn, mFabric_in);
+
 	// NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain);
 	NextElasticStrain = CurElasticStrain; NextElasticStrain += NextStrain; NextElasticStrain -= CurStrain;
 	NextStress = CurStress;
@@ -1473,7 +1591,10 @@ void PM4Silt::ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, co
 	{
 		if (debugFlag)
 			opserr << "Tag = " << this->getTag() << " : p < pmin / 5, should not happen" << endln;
-		NextStress = GetDevPart(NextStress) + m_Pmin / 5.0 * mI1;
+		// NextStress = GetDevPart(NextStress) + m_Pmin / 5.0 * mI1;
+		NextStress = GetDevPart(NextStress);
+		for (int i = 0; i < 2; i++)
+			NextStress[i] += m_Pmin / 5.0;
 	}
 	while (T < 1.0)
 	{
@@ -1484,14 +1605,14 @@ void PM4Silt::ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, co
 		tmp0 = NextStrain; tmp0 -= CurStrain;
 		dVolStrain = dT * GetTrace(tmp0);
 		// dDevStrain = dT * (NextStrain - CurStrain)-dVolStrain / 3.0 * mI1;
-		dDevStrain = mI1;
+		dDevStrain = I1;
 		dDevStrain *= (-1.0 * dVolStrain / 3.0);
 		tmp0 *= dT;
 		dDevStrain += tmp0;
 
 		p = 0.5 * GetTrace(NextStress);
 		// Calc Delta 1
-		GetStateDependent(NextStress, NextAlpha, alpha_in, alpha_in_p, NextFabric, mFabric_in, G, mzcum
+		GetStateDependent(NextStress, NextAlpha, alpha_in, alpha_in_p, NextFabric, fabricIn, G, mzcum
 			, mzpeak, mpzp, mMcur, NextVoidRatio, n, D, R1, mKp, alphaD, Cka, h, b, AlphaAlphaBDotN);
 
 		// r += GetDevPart(NextStress) / p;
@@ -1500,9 +1621,9 @@ void PM4Silt::ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, co
 		temp4 = mKp + 2 * G - K * D *DoubleDot2_2_Contr(n, r);
 		if (fabs(temp4) < small) {
 			// neutral loading
-			dSigma1.Zero();
-			dAlpha1.Zero();
-			dFabric1.Zero();
+			dSigma1.zero();
+			dAlpha1.zero();
+			dFabric1.zero();
 			// dPStrain1 = dDevStrain + dVolStrain * mI1;
 			dPStrain1 = tmp0;
 		}
@@ -1514,19 +1635,19 @@ void PM4Silt::ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, co
 					opserr << "NextL = " << NextL << endln;
 				}
 				// dSigma1 = 2 * G * ToContraviant(dDevStrain) + K * dVolStrain * mI1;
-				tmp2 = mI1; tmp2 *= (K * dVolStrain);
+				tmp2 = I1; tmp2 *= (K * dVolStrain);
 				dSigma1 = ToContraviant(dDevStrain); dSigma1 *= (2.0 * G);
 				dSigma1 += tmp2;
 				// dAlpha1 = 2.0*(GetDevPart(NextStress + dSigma1) / GetTrace(NextStress + dSigma1) - GetDevPart(NextStress) / GetTrace(NextStress));
-				dAlpha1.Zero();
-				dFabric1.Zero();
-				dPStrain1.Zero();
+				dAlpha1.zero();
+				dFabric1.zero();
+				dPStrain1.zero();
 			}
 			else {
 				// dSigma1 = 2.0 * G * mIIcon * dDevStrain + K*dVolStrain*mI1 - Macauley(NextL) * (2.0 * G * n + K * D * mI1);
 				tmp0 = n; tmp0 *= (2.0 * G);
-				tmp1 = mI1; tmp1 *= (K * D); tmp1 += tmp0; tmp1 *= (-Macauley(NextL));
-				tmp2 = mI1; tmp2 *= (K * dVolStrain);
+				tmp1 = I1; tmp1 *= (K * D); tmp1 += tmp0; tmp1 *= (-Macauley(NextL));
+				tmp2 = I1; tmp2 *= (K * dVolStrain);
 				dSigma1 = ToContraviant(dDevStrain); dSigma1 *= (2.0 * G);
 				dSigma1 += tmp2; dSigma1 += tmp1;
 				// update fabric
@@ -1553,7 +1674,9 @@ void PM4Silt::ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, co
 			if (dT == dT_min) {
 				if (debugFlag)
 					opserr << "Delta 1: p < 0";
-				NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain);
+				// NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain);
+				tmp0 = NextStrain; tmp0 -= CurStrain;
+				NextElasticStrain = CurElasticStrain; NextElasticStrain += tmp0;
 				NextStress = CurStress;
 				NextAlpha = CurAlpha;
 				NextFabric = CurFabric;
@@ -1565,9 +1688,9 @@ void PM4Silt::ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, co
 
 		// GetStateDependent(NextStress + dSigma1, NextAlpha + dAlpha1, alpha_in, alpha_in_p, NextFabric + dFabric1, mFabric_in, G, mzcum
 		// 	, mzpeak, mpzp, mMcur, NextVoidRatio, n, D, R2, mKp, alphaD, Cka, h, b, AlphaAlphaBDotN);
-		tmp1.Zero();  tmp1 += NextAlpha; tmp1 += dAlpha1;  // tmp1 is NextAlpha + dAlpha1
-		tmp2.Zero();  tmp2 += NextFabric; tmp2 += dFabric1;  // tmp2 is NextFabric + dFabric1
-		GetStateDependent(tmp0, tmp1, alpha_in, alpha_in_p, tmp2, mFabric_in, G, mzcum
+		tmp1.zero();  tmp1 += NextAlpha; tmp1 += dAlpha1;  // tmp1 is NextAlpha + dAlpha1
+		tmp2.zero();  tmp2 += NextFabric; tmp2 += dFabric1;  // tmp2 is NextFabric + dFabric1
+		GetStateDependent(tmp0, tmp1, alpha_in, alpha_in_p, tmp2, fabricIn, G, mzcum
 			, mzpeak, mpzp, mMcur, NextVoidRatio, n, D, R2, mKp, alphaD, Cka, h, b, AlphaAlphaBDotN);
 		// r = GetDevPart(NextStress + dSigma1) / p;
 		r = GetDevPart(tmp0); r /= p;
@@ -1575,9 +1698,9 @@ void PM4Silt::ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, co
 		temp4 = mKp + 2 * G - K * D * DoubleDot2_2_Contr(n, r);
 		if (fabs(temp4) < small) {
 			// neutral loading
-			dSigma2.Zero();
-			dAlpha2.Zero();
-			dFabric2.Zero();
+			dSigma2.zero();
+			dAlpha2.zero();
+			dFabric2.zero();
 			// dPStrain2 = dDevStrain + dVolStrain * mI1;
 			dPStrain2 = dPStrain1;
 		}
@@ -1591,20 +1714,20 @@ void PM4Silt::ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, co
 					opserr << "NextL = " << NextL << endln;
 				}
 				// dSigma2 = 2 * G * ToContraviant(dDevStrain) + K * dVolStrain * mI1;
-				tmp2 = mI1; tmp2 *= (K * dVolStrain);
+				tmp2 = I1; tmp2 *= (K * dVolStrain);
 				dSigma2 = ToContraviant(dDevStrain); dSigma2 *= (2.0 * G);
 				dSigma2 += tmp2;
 				// dAlpha2 = 2.0*(GetDevPart(NextStress + dSigma2) / GetTrace(NextStress + dSigma2) - GetDevPart(NextStress) / GetTrace(NextStress));
-				dAlpha2.Zero();
-				dFabric2.Zero();
-				dPStrain2.Zero();
+				dAlpha2.zero();
+				dFabric2.zero();
+				dPStrain2.zero();
 			}
 			else {
 				// dSigma2 = 2.0 * G * mIIcon * dDevStrain + K*dVolStrain*mI1 - Macauley(NextL)*
 				// 	(2.0 * G * n + K * D * mI1);
 				tmp0 = n; tmp0 *= (2.0 * G);
-				tmp1 = mI1; tmp1 *= (K * D); tmp1 += tmp0; tmp1 *= (-Macauley(NextL));
-				tmp2 = mI1; tmp2 *= (K * dVolStrain);
+				tmp1 = I1; tmp1 *= (K * D); tmp1 += tmp0; tmp1 *= (-Macauley(NextL));
+				tmp2 = I1; tmp2 *= (K * dVolStrain);
 				dSigma2 = ToContraviant(dDevStrain); dSigma2 *= (2.0 * G);
 				dSigma2 += tmp2; dSigma2 += tmp1;
 				// update fabric
@@ -1649,7 +1772,9 @@ void PM4Silt::ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, co
 		{
 			if (dT == dT_min) {
 				opserr << "Delta 2: p < 0";
-				NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain);
+				// NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain);
+				tmp0 = NextStrain; tmp0 -= CurStrain;
+				NextElasticStrain = CurElasticStrain; NextElasticStrain += tmp0;
 				NextStress = CurStress;
 				NextAlpha = CurAlpha;
 				NextFabric = CurFabric;
@@ -1706,20 +1831,30 @@ void PM4Silt::ModifiedEuler(const Vector& CurStress, const Vector& CurStrain, co
 /*************************************************************/
 // Runge-Kutta Integrator
 /*************************************************************/
-void PM4Silt::RungeKutta4(const Vector& CurStress, const Vector& CurStrain, const Vector& CurElasticStrain,
-	const Vector& CurAlpha, const Vector& CurFabric, const Vector& alpha_in, const Vector& alpha_in_p, const Vector& NextStrain,
-	Vector& NextElasticStrain, Vector& NextStress, Vector& NextAlpha, Vector& NextFabric,
-	double& NextL, double& NextVoidRatio, double& G, double& K, Matrix& aC, Matrix& aCep, Matrix& aCep_Consistent)
+void PM4Silt::RungeKutta4(const VectorND<3>& CurStress, const VectorND<3>& CurStrain, const VectorND<3>& CurElasticStrain,
+	const VectorND<3>& CurAlpha, const VectorND<3>& CurFabric, const VectorND<3>& alpha_in, const VectorND<3>& alpha_in_p, const VectorND<3>& NextStrain,
+	VectorND<3>& NextElasticStrain, VectorND<3>& NextStress, VectorND<3>& NextAlpha, VectorND<3>& NextFabric,
+	double& NextL, double& NextVoidRatio, double& G, double& K)
 {
+	// fraction of the previous increment at which each stage is evaluated
+	static const double stageFactor[4] = { 0.0, 0.5, 0.5, 1.0 };
+	static const char* stageName[4] = { "1", "2nd", "3rd", "4th" };
+
 	double dVolStrain, p, Cka, D, K_p, temp4, h, AlphaAlphaBDotN;
-	Vector n(3), R1(3), R2(3), R3(3), R4(3), alphaD(3), dDevStrain(3), r(3), b(3);
-	Vector nStress(3), nAlpha(3), nFabric(3);
-	Vector dSigma1(3), dSigma2(3), dSigma3(3), dSigma4(3), dSigma(3), dAlpha1(3), dAlpha2(3),
-		dAlpha3(3), dAlpha4(3), dAlpha(3), dFabric1(3), dFabric2(3), dFabric3(3), dFabric4(3),
-		dFabric(3), dPStrain1(3), dPStrain2(3), dPStrain3(3), dPStrain4(3), dPStrain(3);
+	VectorND<3> n, R[4], alphaD, dDevStrain, r, b, tmp0, tmp1, fabricIn;
+	VectorND<3> stageStress, stageAlpha, stageFabric;
+	VectorND<3> dSigma[4], dAlpha[4], dFabric[4], dPStrain[4];
+	VectorND<3> dSigmaRK, dAlphaRK, dFabricRK, dPStrainRK;
 	double T = 0.0, dT = 0.5, dT_min = 1.0e-4, TolE = 1.0e-5;
 
-	NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain);
+	// the fabric increments are only updated when loading towards the dilatancy surface
+	for (int k = 0; k < 4; k++)
+		dFabric[k].zero();
+	assign(fabricIn, mFabric_in);
+
+	// NextElasticStrain = CurElasticStrain + (NextStrain - CurStrain);
+	tmp0 = NextStrain; tmp0 -= CurStrain;
+	NextElasticStrain = CurElasticStrain; NextElasticStrain += tmp0;
 	NextStress = CurStress;
 	NextAlpha = CurAlpha;
 	NextFabric = CurFabric;
@@ -1729,197 +1864,113 @@ void PM4Silt::RungeKutta4(const Vector& CurStress, const Vector& CurStrain, cons
 	{
 		if (debugFlag)
 			opserr << "Tag = " << this->getTag() << " : p < pmin / 5, should not happen" << endln;
-		NextStress = GetDevPart(NextStress) + m_Pmin / 5.0 * mI1;
+		// NextStress = GetDevPart(NextStress) + m_Pmin / 5.0 * mI1;
+		NextStress = GetDevPart(NextStress);
+		for (int i = 0; i < 2; i++)
+			NextStress[i] += m_Pmin / 5.0;
 	}
 	while (T < 1.0)
 	{
-		NextVoidRatio = m_e_init - (1 + m_e_init) * GetTrace(CurStrain + T*(NextStrain - CurStrain));
-		dVolStrain = dT * GetTrace(NextStrain - CurStrain);
-		dDevStrain = dT * (NextStrain - CurStrain) - dVolStrain / 3.0 * mI1;
-		p = 0.5 * GetTrace(NextStress);
-		// Calc Delta 1
-		GetStateDependent(NextStress, NextAlpha, alpha_in, alpha_in_p, NextFabric, mFabric_in, mG, mzcum
-			, mzpeak, mpzp, mMcur, NextVoidRatio, n, D, R1, K_p, alphaD, Cka, h, b, AlphaAlphaBDotN);
-
-		r = GetDevPart(NextStress) / p;
-
-		temp4 = K_p + 2 * mG - mK* D *DoubleDot2_2_Contr(n, r);
-		if (temp4 < 0.0) {
-			mKp = -0.5 * (2 * G - K* D *DoubleDot2_2_Contr(n, r));
-			temp4 = mKp + 2 * G - K* D *DoubleDot2_2_Contr(n, r);
-			h = 1.5 * mKp / (p * AlphaAlphaBDotN);
-		}
-		if (fabs(temp4) < small) {
-			// neutral loading
-			dSigma1.Zero();
-			dAlpha1.Zero();
-			dFabric1.Zero();
-			dPStrain1 = dDevStrain + dVolStrain * mI1;
-		}
-		else {
-			NextL = (2 * mG * DoubleDot2_2_Mixed(n, dDevStrain) - DoubleDot2_2_Contr(n, r) * mK * dVolStrain) / temp4;
-			if (NextL < 0) {
-				if (debugFlag) {
-					opserr << "1 NextL is smaller than 0\n";
-					opserr << "NextL = " << NextL << endln;
-				}
-				dSigma1 = 2 * mG * ToContraviant(dDevStrain) + mK * dVolStrain * mI1;
-				// dAlpha1 = GetDevPart(NextStress + dSigma1) / (0.5 * GetTrace(NextStress + dSigma1))
-				//	- GetDevPart(NextStress) / (0.5 * GetTrace(NextStress));
-				dAlpha1.Zero();
-				dFabric1.Zero();
-				dPStrain1.Zero();
+		// NextVoidRatio = m_e_init - (1 + m_e_init) * GetTrace(CurStrain + T*(NextStrain - CurStrain));
+		tmp0 = NextStrain; tmp0 -= CurStrain; tmp0 *= T; tmp0 += CurStrain;
+		NextVoidRatio = m_e_init - (1 + m_e_init) * GetTrace(tmp0);
+		// dVolStrain = dT * GetTrace(NextStrain - CurStrain);
+		// dDevStrain = dT * (NextStrain - CurStrain) - dVolStrain / 3.0 * mI1;
+		tmp0 = NextStrain; tmp0 -= CurStrain;
+		dVolStrain = dT * GetTrace(tmp0);
+		tmp0 *= dT;
+		dDevStrain = I1; dDevStrain *= (-1.0 * dVolStrain / 3.0); dDevStrain += tmp0;
+
+		for (int k = 0; k < 4; k++) {
+			// the state at NextStress + c * dSigma(k-1), CurAlpha + c * dAlpha(k-1), NextFabric + c * dFabric(k-1)
+			stageStress = NextStress;
+			stageAlpha = (k == 0) ? NextAlpha : CurAlpha;
+			stageFabric = NextFabric;
+			if (k > 0) {
+				tmp0 = dSigma[k - 1]; tmp0 *= stageFactor[k]; stageStress += tmp0;
+				tmp0 = dAlpha[k - 1]; tmp0 *= stageFactor[k]; stageAlpha += tmp0;
+				tmp0 = dFabric[k - 1]; tmp0 *= stageFactor[k]; stageFabric += tmp0;
 			}
-			else {
-				dSigma1 = 2.0 * mG * mIIcon * dDevStrain + mK*dVolStrain*mI1 - Macauley(NextL)*
-					(2.0 * mG * n + mK * D * mI1);
-				// update fabric
-				if (DoubleDot2_2_Contr(alphaD - CurAlpha, n) < 0.0) {
-					dFabric1 = -1.0 * m_cz / (1 + Macauley(mzcum / 2.0 / m_z_max - 1.0)) * Macauley(NextL)*MacauleyIndex(-D)*(m_z_max * n + CurFabric);
-				}
-				dPStrain1 = NextL * mIIco * R1;
-				dAlpha1 = two3 * NextL * h * b;
+			p = 0.5 * GetTrace(stageStress);
+
+			GetStateDependent(stageStress, stageAlpha, alpha_in, alpha_in_p, stageFabric, fabricIn, mG, mzcum
+				, mzpeak, mpzp, mMcur, NextVoidRatio, n, D, R[k], K_p, alphaD, Cka, h, b, AlphaAlphaBDotN);
+			// r = GetDevPart(stageStress) / p;
+			r = GetDevPart(stageStress); r /= p;
+
+			temp4 = K_p + 2 * mG - mK * D * DoubleDot2_2_Contr(n, r);
+			if (k == 0 && temp4 < 0.0) {
+				mKp = -0.5 * (2 * G - K * D * DoubleDot2_2_Contr(n, r));
+				temp4 = mKp + 2 * G - K * D * DoubleDot2_2_Contr(n, r);
+				h = 1.5 * mKp / (p * AlphaAlphaBDotN);
 			}
-		}
-		//Calc Delta 2
-		p = 0.5 * GetTrace(NextStress + 0.5 * dSigma1);
-
-		GetStateDependent(NextStress + 0.5 * dSigma1, CurAlpha + 0.5 * dAlpha1, alpha_in, alpha_in_p, NextFabric + 0.5 * dFabric1, mFabric_in, mG, mzcum
-			, mzpeak, mpzp, mMcur, NextVoidRatio, n, D, R2, K_p, alphaD, Cka, h, b, AlphaAlphaBDotN);
-		r = GetDevPart(NextStress + 0.5 * dSigma1) / p;
-
-		temp4 = K_p + 2 * mG - mK* D *DoubleDot2_2_Contr(n, r);
-		if (fabs(temp4) < small) {
-			// neutral loading
-			dSigma2.Zero();
-			dAlpha2.Zero();
-			dFabric2.Zero();
-			dPStrain2 = dDevStrain + dVolStrain * mI1;
-		}
-		else {
-			NextL = (2 * mG * DoubleDot2_2_Mixed(n, dDevStrain) - DoubleDot2_2_Contr(n, r) * mK * dVolStrain) / temp4;
-			if (NextL < 0)
-			{
-				if (debugFlag) {
-					opserr << "2nd NextL is smaller than 0\n";
-					opserr << "NextL = " << NextL << endln;
-				}
-				dSigma2 = 2 * mG * ToContraviant(dDevStrain) + mK * dVolStrain * mI1;
-				// dAlpha2 = GetDevPart(NextStress + dSigma2) / (0.5 * GetTrace(NextStress + dSigma2))
-				// 	- GetDevPart(NextStress) / (0.5 * GetTrace(NextStress));
-				dAlpha2.Zero();
-				dFabric2.Zero();
-				dPStrain2.Zero();
+			if (fabs(temp4) < small) {
+				// neutral loading
+				dSigma[k].zero();
+				dAlpha[k].zero();
+				dFabric[k].zero();
+				// dPStrain = dDevStrain + dVolStrain * mI1;
+				dPStrain[k] = I1; dPStrain[k] *= dVolStrain; dPStrain[k] += dDevStrain;
 			}
 			else {
-				dSigma2 = 2.0 * mG * mIIcon * dDevStrain + mK*dVolStrain*mI1 - Macauley(NextL)*
-					(2.0 * mG * n + mK * D * mI1);
-				// update fabric
-				if (DoubleDot2_2_Contr(alphaD - CurAlpha, n) < 0.0) {
-					dFabric2 = -1.0 * m_cz / (1 + Macauley(mzcum / 2.0 / m_z_max - 1.0)) * Macauley(NextL)*MacauleyIndex(-D)*(m_z_max * n + CurFabric + 0.5 * dFabric1);
+				NextL = (2 * mG * DoubleDot2_2_Mixed(n, dDevStrain) - DoubleDot2_2_Contr(n, r) * mK * dVolStrain) / temp4;
+				if (NextL < 0) {
+					if (debugFlag) {
+						opserr << stageName[k] << " NextL is smaller than 0\n";
+						opserr << "NextL = " << NextL << endln;
+					}
+					// dSigma = 2 * mG * ToContraviant(dDevStrain) + mK * dVolStrain * mI1;
+					tmp1 = I1; tmp1 *= (mK * dVolStrain);
+					dSigma[k] = ToContraviant(dDevStrain); dSigma[k] *= (2 * mG);
+					dSigma[k] += tmp1;
+					dAlpha[k].zero();
+					dFabric[k].zero();
+					dPStrain[k].zero();
 				}
-				dPStrain2 = NextL * mIIco * R2;
-				dAlpha2 = two3 * NextL * h * b;
-			}
-		}
-		//Calc Delta 3
-		p = 0.5 * GetTrace(NextStress + 0.5 * dSigma2);
-
-		GetStateDependent(NextStress + 0.5 * dSigma2, CurAlpha + 0.5 * dAlpha2, alpha_in, alpha_in_p, NextFabric + 0.5 * dFabric2, mFabric_in, mG, mzcum
-			, mzpeak, mpzp, mMcur, NextVoidRatio, n, D, R3, K_p, alphaD, Cka, h, b, AlphaAlphaBDotN);
-		r = GetDevPart(NextStress + 0.5 * dSigma2) / p;
-
-		temp4 = K_p + 2 * mG - mK* D *DoubleDot2_2_Contr(n, r);
-		if (fabs(temp4) < small) {
-			// neutral loading
-			dSigma3.Zero();
-			dAlpha3.Zero();
-			dFabric3.Zero();
-			dPStrain3 = dDevStrain + dVolStrain * mI1;
-		}
-		else {
-			NextL = (2 * mG * DoubleDot2_2_Mixed(n, dDevStrain) - DoubleDot2_2_Contr(n, r) * mK * dVolStrain) / temp4;
-			if (NextL < 0)
-			{
-				if (debugFlag) {
-					opserr << "3rd NextL is smaller than 0\n";
-					opserr << "NextL = " << NextL << endln;
-				}
-				dSigma3 = 2 * mG * ToContraviant(dDevStrain) + mK * dVolStrain * mI1;
-				// dAlpha3 = GetDevPart(NextStress + dSigma3) / (0.5 * GetTrace(NextStress + dSigma3))
-				// 	- GetDevPart(NextStress) / (0.5 * GetTrace(NextStress));
-				dAlpha3.Zero();
-				dFabric3.Zero();
-				dPStrain3.Zero();
-			}
-			else {
-				dSigma3 = 2.0 * mG * mIIcon * dDevStrain + mK*dVolStrain*mI1 - Macauley(NextL)*
-					(2.0 * mG * n + mK * D * mI1);
-				// update fabric
-				if (DoubleDot2_2_Contr(alphaD - CurAlpha, n) < 0.0) {
-					dFabric3 = -1.0 * m_cz / (1 + Macauley(mzcum / 2.0 / m_z_max - 1.0)) * Macauley(NextL)*MacauleyIndex(-D)*(m_z_max * n + CurFabric + 0.5 * dFabric2);
-				}
-				dPStrain3 = NextL * mIIco * R3;
-				dAlpha3 = two3 * NextL * h * b;
-			}
-		}
-		//Calc Delta 4
-		p = 0.5 * GetTrace(NextStress + dSigma3);
-
-		GetStateDependent(NextStress + dSigma3, CurAlpha + dAlpha3, alpha_in, alpha_in_p, NextFabric + dFabric3, mFabric_in, mG, mzcum
-			, mzpeak, mpzp, mMcur, NextVoidRatio, n, D, R4, K_p, alphaD, Cka, h, b, AlphaAlphaBDotN);
-		r = GetDevPart(NextStress + dSigma3) / p;
-
-		temp4 = K_p + 2 * mG - mK* D *DoubleDot2_2_Contr(n, r);
-		if (fabs(temp4) < small) {
-			// neutral loading
-			dSigma4.Zero();
-			dAlpha4.Zero();
-			dFabric4.Zero();
-			dPStrain4 = dDevStrain + dVolStrain * mI1;
-		}
-		else {
-			NextL = (2 * mG * DoubleDot2_2_Mixed(n, dDevStrain) - DoubleDot2_2_Contr(n, r) * mK * dVolStrain) / temp4;
-			if (NextL < 0)
-			{
-				if (debugFlag) {
-					opserr << "4th NextL is smaller than 0\n";
-					opserr << "NextL = " << NextL << endln;
-				}
-				dSigma4 = 2 * mG * ToContraviant(dDevStrain) + mK * dVolStrain * mI1;
-				// dAlpha4 = GetDevPart(NextStress + dSigma4) / (0.5 * GetTrace(NextStress + dSigma4))
-				// 	- GetDevPart(NextStress) / (0.5 * GetTrace(NextStress));
-				dAlpha4.Zero();
-				dFabric4.Zero();
-				dPStrain4.Zero();
-			}
-			else {
-				dSigma4 = 2.0 * mG * mIIcon * dDevStrain + mK*dVolStrain*mI1 - Macauley(NextL)*
-					(2.0 * mG * n + mK * D * mI1);
-				// update fabric
-				if (DoubleDot2_2_Contr(alphaD - CurAlpha, n) < 0.0) {
-					dFabric4 = -1.0 * m_cz / (1 + Macauley(mzcum / 2.0 / m_z_max - 1.0)) * Macauley(NextL)*MacauleyIndex(-D)*(m_z_max * n + CurFabric + dFabric3);
+				else {
+					// dSigma = 2.0 * mG * mIIcon * dDevStrain + mK*dVolStrain*mI1 - Macauley(NextL)*
+					// 	(2.0 * mG * n + mK * D * mI1);
+					tmp0 = n; tmp0 *= (2.0 * mG);
+					tmp1 = I1; tmp1 *= (mK * D); tmp1 += tmp0; tmp1 *= (-Macauley(NextL));
+					tmp0 = I1; tmp0 *= (mK * dVolStrain);
+					dSigma[k] = ToContraviant(dDevStrain); dSigma[k] *= (2.0 * mG);
+					dSigma[k] += tmp0; dSigma[k] += tmp1;
+					// update fabric
+					// if (DoubleDot2_2_Contr(alphaD - CurAlpha, n) < 0.0) {
+					tmp0 = alphaD; tmp0 -= CurAlpha;
+					if (DoubleDot2_2_Contr(tmp0, n) < 0.0) {
+						// dFabric = -1.0 * m_cz / (1 + Macauley(mzcum / 2.0 / m_z_max - 1.0)) * Macauley(NextL)*MacauleyIndex(-D)*(m_z_max * n + CurFabric + c * dFabric(k-1));
+						tmp1 = n; tmp1 *= m_z_max; tmp1 += CurFabric;
+						if (k > 0) {
+							tmp0 = dFabric[k - 1]; tmp0 *= stageFactor[k]; tmp1 += tmp0;
+						}
+						dFabric[k] = tmp1;
+						dFabric[k] *= (-1.0 * m_cz / (1 + Macauley(mzcum / 2.0 / m_z_max - 1.0)) * Macauley(NextL) * MacauleyIndex(-D));
+					}
+					// dPStrain = NextL * mIIco * R;
+					// dAlpha = two3 * NextL * h * b;
+					dPStrain[k] = ToCovariant(R[k]); dPStrain[k] *= NextL;
+					dAlpha[k] = b; dAlpha[k] *= (two3 * NextL * h);
 				}
-				dPStrain4 = NextL * mIIco * R4;
-				dAlpha4 = two3 * NextL * h * b;
 			}
 		}
 
 		// RK4
-		dSigma = (dSigma1 + dSigma4 + 2.0 * (dSigma2 + dSigma3)) / 6.0;
-		dAlpha = (dAlpha1 + dAlpha4 + 2.0 * (dAlpha2 + dAlpha3)) / 6.0;
-		dFabric = (dFabric1 + dFabric4 + 2.0 * (dFabric2 + dFabric3)) / 6.0;
-		dPStrain = (dPStrain1 + dPStrain4 + 2.0 * (dPStrain2 + dPStrain3)) / 6.0;
-
-		nStress = NextStress + dSigma;
-		nAlpha = NextAlpha + dAlpha;
-		nFabric = NextFabric + dFabric;
+		// dSigma = (dSigma1 + dSigma4 + 2.0 * (dSigma2 + dSigma3)) / 6.0;
+		tmp0 = dSigma[1]; tmp0 += dSigma[2]; tmp0 *= 2.0;
+		dSigmaRK = dSigma[0]; dSigmaRK += dSigma[3]; dSigmaRK += tmp0; dSigmaRK /= 6.0;
+		tmp0 = dAlpha[1]; tmp0 += dAlpha[2]; tmp0 *= 2.0;
+		dAlphaRK = dAlpha[0]; dAlphaRK += dAlpha[3]; dAlphaRK += tmp0; dAlphaRK /= 6.0;
+		tmp0 = dFabric[1]; tmp0 += dFabric[2]; tmp0 *= 2.0;
+		dFabricRK = dFabric[0]; dFabricRK += dFabric[3]; dFabricRK += tmp0; dFabricRK /= 6.0;
+		tmp0 = dPStrain[1]; tmp0 += dPStrain[2]; tmp0 *= 2.0;
+		dPStrainRK = dPStrain[0]; dPStrainRK += dPStrain[3]; dPStrainRK += tmp0; dPStrainRK /= 6.0;
 
 		// can add error control here
-		NextElasticStrain -= dPStrain;
-		NextStress = nStress;
-		NextAlpha = nAlpha;
-		NextFabric = nFabric;
+		NextElasticStrain -= dPStrainRK;
+		NextStress += dSigmaRK;
+		NextAlpha += dAlphaRK;
+		NextFabric += dFabricRK;
 		Stress_Correction(NextStress, NextAlpha, alpha_in, alpha_in_p, CurFabric, NextVoidRatio);
 		// Stress_Correction(NextStress, NextAlpha, dAlpha, m_m, (R1 + R4 + 2.0 * (R2 + R3)) / 6, n, r);
 		T += dT;
@@ -1933,37 +1984,42 @@ void PM4Silt::RungeKutta4(const Vector& CurStress, const Vector& CurStrain, cons
 //            Pegasus Iterations                             //
 /*************************************************************/
 double
-PM4Silt::IntersectionFactor(const Vector& CurStress, const Vector& CurStrain, const Vector& NextStrain, const Vector& CurAlpha,
-	double a0 = 0.0, double a1 = 1.0)
+PM4Silt::IntersectionFactor(const VectorND<3>& CurStress, const VectorND<3>& CurStrain, const VectorND<3>& NextStrain, const VectorND<3>& CurAlpha,
+	double a0, double a1)
 {
 	double a = a0;
 	double f, f0, f1;
-	Vector dSigma(3), dSigma0(3), dSigma1(3), strainInc(3), tmp(3);
+	VectorND<3> dSigma, dSigma0, dSigma1, strainInc, tmp;
+	MatrixND<3,3> Ce;
 
 	// strainInc = NextStrain - CurStrain;
-	strainInc += NextStrain;
+	strainInc = NextStrain;
 	strainInc -= CurStrain;
+	assign(Ce, mCe);
 
 	if (a0 < 0.0 || a1 > 1.0) {
 		opserr << "a0 = " << a0 << "a1 = " << a1 << endln;
 	}
 	//GetElasticModuli(CurStress, K, G, mzcum);
-	dSigma0 = a0 * DoubleDot4_2(mCe, strainInc);
+	// dSigma0 = a0 * DoubleDot4_2(mCe, strainInc);
+	dSigma0 = DoubleDot4_2(Ce, strainInc); dSigma0 *= a0;
 	// f0 = GetF(CurStress + dSigma0, CurAlpha);
-	tmp.Zero(); tmp += CurStress; tmp += dSigma0;
+	tmp = CurStress; tmp += dSigma0;
 	f0 = GetF(tmp, CurAlpha);
 
-	dSigma1 = a1 * DoubleDot4_2(mCe, strainInc);
+	// dSigma1 = a1 * DoubleDot4_2(mCe, strainInc);
+	dSigma1 = DoubleDot4_2(Ce, strainInc); dSigma1 *= a1;
 	// f1 = GetF(CurStress + dSigma1, CurAlpha);
-	tmp.Zero(); tmp += CurStress; tmp += dSigma1;
+	tmp = CurStress; tmp += dSigma1;
 	f1 = GetF(tmp, CurAlpha);
 
 	for (int i = 1; i <= 10; i++)
 	{
 		a = a1 - f1 * (a1 - a0) / (f1 - f0);
-		dSigma = a * DoubleDot4_2(mCe, strainInc);
+		// dSigma = a * DoubleDot4_2(mCe, strainInc);
+		dSigma = DoubleDot4_2(Ce, strainInc); dSigma *= a;
 		// f = GetF(CurStress + dSigma, CurAlpha);
-		tmp.Zero(); tmp += CurStress; tmp += dSigma;
+		tmp = CurStress; tmp += dSigma;
 		f = GetF(tmp, CurAlpha);
 		if (fabs(f) < mTolF)
 		{
@@ -2001,22 +2057,24 @@ PM4Silt::IntersectionFactor(const Vector& CurStress, const Vector& CurStrain, co
 //      Pegasus Iterations  (ElastoPlastic Unloading)        //
 /*************************************************************/
 double
-PM4Silt::IntersectionFactor_Unloading(const Vector& CurStress, const Vector& CurStrain, const Vector& NextStrain, const Vector& CurAlpha)
+PM4Silt::IntersectionFactor_Unloading(const VectorND<3>& CurStress, const VectorND<3>& CurStrain, const VectorND<3>& NextStrain, const VectorND<3>& CurAlpha)
 {
 	double a = 0.0, a0 = 0.0, a1 = 1.0, da;
 	double f, f0, f1, fs;
 	int nSub = 20;
-	Vector dSigma(3), dSigma0(3), dSigma1(3), strainInc(3), tmp(3);
+	VectorND<3> dSigma, strainInc, tmp;
+	MatrixND<3,3> Ce;
 	bool flag = false;
 
 	// strainInc = NextStrain - CurStrain;
-	strainInc += NextStrain; strainInc -= CurStrain;
+	strainInc = NextStrain; strainInc -= CurStrain;
+	assign(Ce, mCe);
 
 	f0 = GetF(CurStress, CurAlpha);
 	fs = f0;
 
 	// GetElasticModuli(CurStress, K, G, mzcum);
-	dSigma = DoubleDot4_2(mCe, strainInc);
+	dSigma = DoubleDot4_2(Ce, strainInc);
 
 	for (int i = 1; i < 10; i++)
 	{
@@ -2060,13 +2118,13 @@ PM4Silt::IntersectionFactor_Unloading(const Vector& CurStress, const Vector& Cur
 //            Stress Correction                              //
 /*************************************************************/
 void
-PM4Silt::Stress_Correction(Vector& NextStress, Vector& NextAlpha, const Vector& alpha_in, const Vector& alpha_in_p,
-	const Vector& CurFabric, double& NextVoidRatio)
+PM4Silt::Stress_Correction(VectorND<3>& NextStress, VectorND<3>& NextAlpha, const VectorND<3>& alpha_in, const VectorND<3>& alpha_in_p,
+	const VectorND<3>& CurFabric, double& NextVoidRatio)
 {
-	Vector dSigmaP(3), dfrOverdSigma(3), dfrOverdAlpha(3), n(3), R(3), alphaD(3), b(3), aBar(3), r(3);
-	Vector nAlpha(3), nStress(3), dSigma(3), tmp0(3), tmp1(3);
+	VectorND<3> dSigmaP, dfrOverdSigma, dfrOverdAlpha, n, R, alphaD, b, aBar, r;
+	VectorND<3> nAlpha, nStress, tmp0, tmp1, fabricIn;
 	double lambda, D, K_p, Cka, h, p, fr, AlphaAlphaBDotN;
-	Matrix aC(3, 3);
+	MatrixND<3,3> aC;
 	// Vector CurStress = NextStress;
 
 	int maxIter = 25;
@@ -2075,13 +2133,16 @@ PM4Silt::Stress_Correction(Vector& NextStress, Vector& NextAlpha, const Vector&
 		fr = GetF(NextStress, NextAlpha);
 		if (fr < mTolF) {
 			// stress state inside yield surface
-			NextStress += (m_Pmin / 5.0 - p)  * mI1;
+			// NextStress += (m_Pmin / 5.0 - p)  * mI1;
+			for (int i = 0; i < 2; i++)
+				NextStress[i] += (m_Pmin / 5.0 - p);
 		}
 		else {
 			// stress state outside yield surface
-			NextStress = m_Pmin / 5.0 * mI1;
+			// NextStress = m_Pmin / 5.0 * mI1;
+			NextStress = I1; NextStress *= m_Pmin / 5.0;
 			NextStress(2) = 0.8 * m_Mc * m_Pmin / 5.0;
-			NextAlpha.Zero();
+			NextAlpha.zero();
 			NextAlpha(2) = 0.8 * m_Mc;
 			return;
 		}
@@ -2094,17 +2155,21 @@ PM4Silt::Stress_Correction(Vector& NextStress, Vector& NextAlpha, const Vector&
 		}
 		else {
 			nStress = NextStress;
+			assign(fabricIn, mFabric_in);
 			nAlpha = NextAlpha;
 			for (int i = 1; i <= maxIter; i++) {
 				// r = GetDevPart(nStress) / p;
 				r = GetDevPart(nStress); r /= p;
-				GetStateDependent(nStress, nAlpha, alpha_in, alpha_in_p, CurFabric, mFabric_in, mG, mzcum
+				GetStateDependent(nStress, nAlpha, alpha_in, alpha_in_p, CurFabric, fabricIn, mG, mzcum
 					, mzpeak, mpzp, mMcur, NextVoidRatio, n, D, R, K_p, alphaD, Cka, h, b, AlphaAlphaBDotN);
-				aC = GetStiffness(mK, mG);
-				dSigmaP = DoubleDot4_2(aC, mDGamma * ToCovariant(R));
-				aBar = two3 * h * b;
+				GetStiffness(mK, mG, aC);
+				// dSigmaP = DoubleDot4_2(aC, mDGamma * ToCovariant(R));
+				tmp0 = ToCovariant(R); tmp0 *= mDGamma;
+				dSigmaP = DoubleDot4_2(aC, tmp0);
+				// aBar = two3 * h * b;
+				aBar = b; aBar *= (two3 * h);
 				// dfrOverdSigma = n - 0.5 * DoubleDot2_2_Contr(n, r) * mI1;
-				dfrOverdSigma.Zero(); dfrOverdSigma += mI1;
+				dfrOverdSigma.zero(); dfrOverdSigma += I1;
 				dfrOverdSigma *= (-0.5 * DoubleDot2_2_Contr(n, r));	dfrOverdSigma += n;
 				// dfrOverdAlpha = -p * n;
 				dfrOverdAlpha = n; dfrOverdAlpha *= (-p);
@@ -2139,70 +2204,13 @@ PM4Silt::Stress_Correction(Vector& NextStress, Vector& NextAlpha, const Vector&
 			// }
 			if (debugFlag) {
 				opserr << "Still outside with f =  " << fr << endln;
-				opserr << "NextStress = " << NextStress;
-				opserr << "nStress = " << nStress;
-				opserr << "NextAlpha = " << NextAlpha;
-			}
-
-			Vector dSigma = NextStress - mSigma;
-			double alpha_up = 1.0;
-			double alpha_mid = 0.5;
-			double alpha_down = 0.0;
-			double fr_old = GetF(mSigma + alpha_mid * dSigma, NextAlpha);
-			for (int jj = 0; jj < maxIter; jj++) {
-				if (fr_old < 0.0) {
-					alpha_down = alpha_mid;
-					alpha_mid = 0.5 * (alpha_up + alpha_mid);
-				}
-				else {
-					alpha_up = alpha_mid;
-					alpha_mid = 0.5 * (alpha_down + alpha_mid);
-				}
-
-				// fr_old = GetF(mSigma + alpha_mid * dSigma, NextAlpha);
-				tmp0 = dSigma; tmp0 *= alpha_mid; tmp0 += mSigma;
-				fr_old = GetF(tmp0, NextAlpha);
-				if (fabs(fr_old) < mTolF) {
-					// NextStress = mSigma + alpha_mid * dSigma;
-					NextStress = dSigma; NextStress *= alpha_mid; NextStress += mSigma;
-					break;
-				}
+				opserr << "NextStress = " << Vector(NextStress);
+				opserr << "nStress = " << Vector(nStress);
+				opserr << "NextAlpha = " << Vector(NextAlpha);
 			}
 		}
 	}
 }
-
-/************************************************************/
-/************************************************************/
-void
-PM4Silt::Stress_Correction(Vector& NextStress, Vector& NextAlpha, const Vector& dAlpha,
-	const double m, const Vector& R, const Vector& n, const Vector& r)
-{
-	Vector dfrOverdSigma(3);
-	double lambda;
-	int maxIter = 50;
-	double f = GetF(NextStress, NextAlpha);
-	if (f < mTolF)
-		return;
-	else {
-		// Method C from Potts and Gens 1983. 
-		for (int i = 1; i <= maxIter; i++) {
-			// GetStateDependent(CurStress, CurAlpha, alpha_in, CurFabric, mFabric_in, mG, mzcum
-			// 	, mzpeak, mpzp, mMcur, ksi, CurDr, n, D, R, K_p, alphaD, Cka, h, b);
-			dfrOverdSigma = n - 0.5 * DoubleDot2_2_Contr(n, r)*mI1;
-			lambda = f / DoubleDot2_2_Contr(dfrOverdSigma, R);
-			NextStress = NextStress - R*lambda;
-			NextAlpha = NextAlpha - dAlpha*lambda;
-			f = GetF(NextStress, NextAlpha);
-			if (fabs(f) < mTolF) {
-				break;
-			}
-			if (i == maxIter)
-				if (debugFlag)
-					opserr << "Still outside with f =  " << f << endln;
-		}
-	}
-}
 /*************************************************************/
 /*************************************************************/
 //            MATERIAL SPECIFIC METHODS                      //
@@ -2224,12 +2232,14 @@ double PM4Silt::MacauleyIndex(double x)
 /*************************************************************/
 // GetF() -----------------------------------------------------
 double
-PM4Silt::GetF(const Vector& nStress, const Vector& nAlpha)
+PM4Silt::GetF(const VectorND<3>& nStress, const VectorND<3>& nAlpha)
 {
 	// PM4Silt's yield function
-	Vector s(3); s = GetDevPart(nStress);
+	VectorND<3> s = GetDevPart(nStress);
 	double p = 0.5 * GetTrace(nStress);
-	s -= p * nAlpha;
+	// s = s - p * nAlpha;
+	for (int i = 0; i < 3; i++)
+		s[i] -= p * nAlpha[i];
 	double f = GetNorm_Contr(s) - root12 * m_m * p;
 	return f;
 }
@@ -2246,7 +2256,7 @@ PM4Silt::GetKsi(const double& e, const double& p)
 /*************************************************************/
 // GetElasticModuli() ---------------------------------------------
 void
-PM4Silt::GetElasticModuli(const Vector& sigma, double &K, double &G, double &Mcur, const double& zcum)
+PM4Silt::GetElasticModuli(const VectorND<3>& sigma, double &K, double &G, double &Mcur, const double& zcum)
 // Calculates G, K, including effects of fabric and current stress ratio
 {
 	int msr = 4;
@@ -2274,7 +2284,7 @@ PM4Silt::GetElasticModuli(const Vector& sigma, double &K, double &G, double &Mcu
 	K = two3 * (1 + m_nu) / (1 - 2 * m_nu) * G;
 }
 void
-PM4Silt::GetElasticModuli(const Vector& sigma, double &K, double &G)
+PM4Silt::GetElasticModuli(const VectorND<3>& sigma, double &K, double &G)
 // Calculates G, K
 {
 	double pn = 0.5 * GetTrace(sigma);
@@ -2289,17 +2299,16 @@ PM4Silt::GetElasticModuli(const Vector& sigma, double &K, double &G)
 }
 /*************************************************************/
 // GetStiffness() ---------------------------------------------
-Matrix
-PM4Silt::GetStiffness(const double& K, const double& G)
-// returns the stiffness matrix in its contravarinat-contravariant form
+void
+PM4Silt::GetStiffness(const double& K, const double& G, MatrixND<3,3>& C)
+// fills C with the stiffness matrix in its contravarinat-contravariant form
 {
-	Matrix C(3, 3);
+	C.zero();
 	double a = K + 4.0*one3 * G;
 	double b = K - 2.0*one3 * G;
 	C(0, 0) = C(1, 1) = a;
 	C(2, 2) = G;
 	C(0, 1) = C(1, 0) = b;
-	return C;
 }
 /*************************************************************/
 // GetCompliance() ---------------------------------------------
@@ -2318,50 +2327,47 @@ PM4Silt::GetCompliance(const double& K, const double& G)
 }
 /*************************************************************/
 // GetElastoPlasticTangent()---------------------------------------
-Matrix
-PM4Silt::GetElastoPlasticTangent(const Vector& NextStress, const Matrix& aCe, const Vector& R,
-	const Vector& n, const double K_p)
+void
+PM4Silt::GetElastoPlasticTangent(const VectorND<3>& NextStress, const MatrixND<3,3>& aCe, const VectorND<3>& R,
+	const VectorND<3>& n, const double K_p, MatrixND<3,3>& aCep)
 {
 	double p = 0.5 * GetTrace(NextStress);
 	if (p < m_Pmin) p = m_Pmin;
-	Vector r = GetDevPart(NextStress) / p;
-	Matrix aCep(3, 3);
-	aCep.Zero();
-	Vector temp1 = DoubleDot4_2(aCe, R);
-	Vector temp2 = DoubleDot2_4(n - 1 / 2 * DoubleDot2_2_Contr(n, r)*mI1, aCe*mIIco);
+	VectorND<3> r = GetDevPart(NextStress); r /= p;
+	VectorND<3> temp1 = DoubleDot4_2(aCe, R);
+	// temp2 = DoubleDot2_4(n - 1 / 2 * DoubleDot2_2_Contr(n, r)*mI1, aCe*mIIco);
+	VectorND<3> temp0;
+	for (int i = 0; i < 3; i++)
+		temp0[i] = n[i] - 1 / 2 * DoubleDot2_2_Contr(n, r) * I1[i];
+	MatrixND<3,3> CeIIco;
+	CeIIco.zero();
+	for (int j = 0; j < 3; j++)
+		for (int k = 0; k < 3; k++)
+			for (int i = 0; i < 3; i++)
+				CeIIco(i, j) += aCe(i, k) * mIIco(k, j);
+	VectorND<3> temp2 = DoubleDot2_4(temp0, CeIIco);
 	double temp3 = DoubleDot2_2_Contr(temp2, R) + K_p;
 	if (temp3 < small) {
 		aCep = aCe;
 	}
 	else {
-		aCep = aCe - 1 / temp3 * Dyadic2_2(temp1, temp2);
+		// aCep = aCe - 1 / temp3 * Dyadic2_2(temp1, temp2);
+		for (int j = 0; j < 3; j++)
+			for (int i = 0; i < 3; i++)
+				aCep(i, j) = aCe(i, j) - 1 / temp3 * (temp1[i] * temp2[j]);
 	}
-
-	return aCep;
 }
 /*************************************************************/
 // GetNormalToYield() ----------------------------------------
-Vector
-PM4Silt::GetNormalToYield(const Vector &stress, const Vector &alpha)
-{
-	// Vector devStress(3); devStress = GetDevPart(stress);
-	// double p = 0.5 * GetTrace(stress);
-	// Vector n(3);
-	// if (fabs(p) < small) {
-	// 	n.Zero();
-	// }
-	// else {
-	// 	n = devStress - p * alpha;
-	// 	double normN = GetNorm_Contr(n);
-	// 	normN = (normN < small) ? 1.0 : normN;
-	// 	n = n / normN;
-	// }
-	Vector n(3);
+VectorND<3>
+PM4Silt::GetNormalToYield(const VectorND<3> &stress, const VectorND<3> &alpha)
+{
+	VectorND<3> n;
+	n.zero();
 	double p = 0.5 * GetTrace(stress);
 	if (fabs(p) < small) {
-		// n.Zero();
 		// change loading direction to simple shear when p is small
-		n(2) = root12;
+		n[2] = root12;
 	}
 	else {
 		n = alpha; n *= (-p);
@@ -2383,12 +2389,12 @@ PM4Silt::Check(const Vector& TrialStress, const Vector& stress, const Vector& Cu
 /*************************************************************/
 // GetStateDependent() ----------------------------------------
 void
-PM4Silt::GetStateDependent(const Vector &stress, const Vector &alpha, const Vector &alpha_in, const Vector &alpha_in_p
-	, const Vector &fabric, const Vector &fabric_in, const double &G, const double &zcum, const double &zpeak
-	, const double &pzp, const double &Mcur, const double &CurVoidRatio, Vector &n, double &D, Vector &R, double &K_p
-	, Vector &alphaD, double &Cka, double &h, Vector &b, double &AlphaAlphaBDotN)
+PM4Silt::GetStateDependent(const VectorND<3> &stress, const VectorND<3> &alpha, const VectorND<3> &alpha_in, const VectorND<3> &alpha_in_p
+	, const VectorND<3> &fabric, const VectorND<3> &fabric_in, const double &G, const double &zcum, const double &zpeak
+	, const double &pzp, const double &Mcur, const double &CurVoidRatio, VectorND<3> &n, double &D, VectorND<3> &R, double &K_p
+	, VectorND<3> &alphaD, double &Cka, double &h, VectorND<3> &b, double &AlphaAlphaBDotN)
 {
-	Vector alphaD_alpha(3), alphaDr_alpha(3), alpha_mAlpha_in(3), alpha_mAlpha_in_true(3), alpha_mAlpha_p(3), minusFabric(3);
+	VectorND<3> alphaD_alpha, alphaDr_alpha, alpha_mAlpha_in, alpha_mAlpha_in_true, alpha_mAlpha_p, minusFabric, alphaIn, alphaInTrue;
 	double Czpk1, Czpk2, Cpzp2, Cg1, Ckp, AlphaAlphaInDotN, AlphaAlphaInTrueDotN, Czin1, Crot1, Mdr;
 	double p = 0.5 * GetTrace(stress);
 	if (p <= m_Pmin) p = m_Pmin;
@@ -2404,7 +2410,7 @@ PM4Silt::GetStateDependent(const Vector &stress, const Vector &alpha, const Vect
 		mMb = m_Mc * exp(-1.0 * m_nbwet * ksi / m_lambda);
 	}
 	//Vector alphaB = root12 * (mMb - m_m) * n;
-	Vector alphaB(n);
+	VectorND<3> alphaB = n;
 	alphaB *= (root12 * (mMb - m_m));
 	//alphaD = root12 * (mMd - m_m) * n;
 	alphaD = n; alphaD *= (root12 * (mMd - m_m));
@@ -2419,10 +2425,12 @@ PM4Silt::GetStateDependent(const Vector &stress, const Vector &alpha, const Vect
 	b = alphaB; b -= alpha;
 	AlphaAlphaBDotN = DoubleDot2_2_Contr(b, n);
 	// double AlphaAlphaInDotN = Macauley(DoubleDot2_2_Contr(alpha - mAlpha_in, n));
-	alpha_mAlpha_in = alpha; alpha_mAlpha_in -= mAlpha_in;
+	assign(alphaIn, mAlpha_in);
+	assign(alphaInTrue, mAlpha_in_true);
+	alpha_mAlpha_in = alpha; alpha_mAlpha_in -= alphaIn;
 	AlphaAlphaInDotN = Macauley(DoubleDot2_2_Contr(alpha_mAlpha_in, n));
 	// double AlphaAlphaInTrueDotN = Macauley(DoubleDot2_2_Contr(alpha - mAlpha_in_true, n));
-	alpha_mAlpha_in_true = alpha; alpha_mAlpha_in_true -= mAlpha_in_true;
+	alpha_mAlpha_in_true = alpha; alpha_mAlpha_in_true -= alphaInTrue;
 	AlphaAlphaInTrueDotN = Macauley(DoubleDot2_2_Contr(alpha_mAlpha_in_true, n));
 	Cka = 1.0 + m_Ckaf / (1.0 + pow(2.5*AlphaAlphaInTrueDotN, 2)) * Cpzp2 * Czpk1;
 	// updataed K_p formulation following PM4Silt V1. mAlpha_in is the apparent back-stress ratio.
@@ -2495,7 +2503,8 @@ PM4Silt::GetStateDependent(const Vector &stress, const Vector &alpha, const Vect
 		}
 		D *= C_pmin;
 	}
-	R = n + one3 * D * mI1;
+	// R = n + one3 * D * mI1;
+	R = I1; R *= (one3 * D); R += n;
 	mTracker(1) = D;
 }
 
@@ -2510,44 +2519,33 @@ PM4Silt::GetStateDependent(const Vector &stress, const Vector &alpha, const Vect
 
 //  GetTrace() ---------------------------------------------
 double
-PM4Silt::GetTrace(const Vector& v)
+PM4Silt::GetTrace(const VectorND<3>& v)
 // computes the trace of the input argument
 {
-	if (v.Size() != 3)
-		opserr << "\n ERROR! PM4Silt::GetTrace requires vector of size(3)!" << endln;
-
-	return (v(0) + v(1));
+	return (v[0] + v[1]);
 }
 /*************************************************************/
 //  GetDevPart() ---------------------------------------------
-Vector
-PM4Silt::GetDevPart(const Vector& aV)
+VectorND<3>
+PM4Silt::GetDevPart(const VectorND<3>& aV)
 // computes the deviatoric part of the input tensor
 {
-	if (aV.Size() != 3)
-		opserr << "\n ERROR! PM4Silt::GetDevPart requires vector of size(3)!" << endln;
-
-	Vector result(3);
+	VectorND<3> result = aV;
 	double p = GetTrace(aV);
-	result = aV;
-	result(0) -= 0.5 * p;
-	result(1) -= 0.5 * p;
+	result[0] -= 0.5 * p;
+	result[1] -= 0.5 * p;
 
 	return result;
 }
 /*************************************************************/
 // DoubleDot2_2_Contr() ---------------------------------------
 double
-PM4Silt::DoubleDot2_2_Contr(const Vector& v1, const Vector& v2)
+PM4Silt::DoubleDot2_2_Contr(const VectorND<3>& v1, const VectorND<3>& v2)
 // computes doubledot product for vector-vector arguments, both "contravariant"
 {
-	if ((v1.Size() != 3) || (v2.Size() != 3))
-		opserr << "\n ERROR! PM4Silt::DoubleDot2_2_Contr requires vector of size(3)!" << endln;
-
 	double result = 0.0;
-	for (int i = 0; i < v1.Size(); i++) {
-		result += v1(i) * v2(i) + (i > 1) * v1(i) * v2(i);
-	}
+	for (int i = 0; i < 3; i++)
+		result += v1[i] * v2[i] + (i > 1) * v1[i] * v2[i];
 
 	return result;
 }
@@ -2570,32 +2568,22 @@ PM4Silt::DoubleDot2_2_Cov(const Vector& v1, const Vector& v2)
 /*************************************************************/
 // DoubleDot2_2_Mixed() ---------------------------------------
 double
-PM4Silt::DoubleDot2_2_Mixed(const Vector& v1, const Vector& v2)
+PM4Silt::DoubleDot2_2_Mixed(const VectorND<3>& v1, const VectorND<3>& v2)
 // computes doubledot product for vector-vector arguments, one "covariant" and the other "contravariant"
 {
-	if ((v1.Size() != 3) || (v2.Size() != 3))
-		opserr << "\n ERROR! PM4Silt::DoubleDot2_2_Mixed requires vector of size(3)!" << endln;
-
 	double result = 0.0;
-	for (int i = 0; i < v1.Size(); i++) {
-		result += v1(i) * v2(i);
-	}
+	for (int i = 0; i < 3; i++)
+		result += v1[i] * v2[i];
 
 	return result;
 }
 /*************************************************************/
 // GetNorm_Contr() ---------------------------------------------
 double
-PM4Silt::GetNorm_Contr(const Vector& v)
+PM4Silt::GetNorm_Contr(const VectorND<3>& v)
 // computes contravariant (stress-like) norm of input 6x1 tensor
 {
-	if (v.Size() != 3)
-		opserr << "\n ERROR! PM4Silt::GetNorm_Contr requires vector of size(3)!" << endln;
-
-	double result = 0.0;
-	result = sqrt(DoubleDot2_2_Contr(v, v));
-
-	return result;
+	return sqrt(DoubleDot2_2_Contr(v, v));
 }
 /*************************************************************/
 // GetNorm_Cov() ---------------------------------------------
@@ -2632,39 +2620,41 @@ PM4Silt::Dyadic2_2(const Vector& v1, const Vector& v2)
 }
 /*************************************************************/
 // DoubleDot4_2() ---------------------------------------------
-Vector
-PM4Silt::DoubleDot4_2(const Matrix& m1, const Vector& v1)
+VectorND<3>
+PM4Silt::DoubleDot4_2(const MatrixND<3,3>& m1, const VectorND<3>& v1)
 // computes doubledot product for matrix-vector arguments
 // caution: second coordinate of the matrix should be in opposite variant form of vector
 {
-	if (v1.Size() != 3)
-		opserr << "\n ERROR! PM4Silt::DoubleDot4_2 requires vector of size(3)!" << endln;
-	if ((m1.noCols() != 3) || (m1.noRows() != 3))
-		opserr << "\n ERROR! PM4Silt::DoubleDot4_2 requires 3-by-3 matrix " << endln;
+	VectorND<3> result;
+	result.zero();
+	for (int j = 0; j < 3; j++)
+		for (int i = 0; i < 3; i++)
+			result[i] += m1(i, j) * v1[j];
 
-	return m1*v1;
+	return result;
 }
 /*************************************************************/
 // DoubleDot2_4() ---------------------------------------------
-Vector
-PM4Silt::DoubleDot2_4(const Vector& v1, const Matrix& m1)
+VectorND<3>
+PM4Silt::DoubleDot2_4(const VectorND<3>& v1, const MatrixND<3,3>& m1)
 // computes doubledot product for matrix-vector arguments
-// caution: first coordinate of the matrix should be in opposite 
+// caution: first coordinate of the matrix should be in opposite
 // variant form of vector
 {
-	if (v1.Size() != 3)
-		opserr << "\n ERROR! PM4Silt::DoubleDot2_4 requires vector of size(3)!" << endln;
-	if ((m1.noCols() != 3) || (m1.noRows() != 3))
-		opserr << "\n ERROR! PM4Silt::DoubleDot2_4 requires 3-by-3 matrix " << endln;
+	VectorND<3> result;
+	result.zero();
+	for (int j = 0; j < 3; j++)
+		for (int i = 0; i < 3; i++)
+			result[j] += m1(i, j) * v1[i];
 
-	return  m1^v1;
+	return result;
 }
 /*************************************************************/
 // DoubleDot4_4() ---------------------------------------------
 Matrix
 PM4Silt::DoubleDot4_4(const Matrix& m1, const Matrix& m2)
 // computes doubledot product for matrix-matrix arguments
-// caution: second coordinate of the first matrix should be in opposite 
+// caution: second coordinate of the first matrix should be in opposite
 // variant form of the first coordinate of second matrix
 {
 	if ((m1.noCols() != 3) || (m1.noRows() != 3) || (m2.noCols() != 3) || (m2.noRows() != 3))
@@ -2674,25 +2664,23 @@ PM4Silt::DoubleDot4_4(const Matrix& m1, const Matrix& m2)
 }
 /*************************************************************/
 // ToContraviant() ---------------------------------------------
-Vector PM4Silt::ToContraviant(const Vector& v1)
+VectorND<3>
+PM4Silt::ToContraviant(const VectorND<3>& v1)
 {
-	if (v1.Size() != 3)
-		opserr << "\n ERROR! PM4Silt::ToContraviant requires vector of size(3)!" << endln;
 	// aV(i) -> T(i,j) 1 = 11, 2=22, 3=12
-	Vector res = v1;
-	res(2) *= 0.5;
+	VectorND<3> res = v1;
+	res[2] *= 0.5;
 
 	return res;
 }
 /*************************************************************/
 // ToCovariant() ---------------------------------------------
-Vector PM4Silt::ToCovariant(const Vector& v1)
+VectorND<3>
+PM4Silt::ToCovariant(const VectorND<3>& v1)
 {
-	if (v1.Size() != 3)
-		opserr << "\n ERROR! PM4Silt::ToCovariant requires vector of size(3)!" << endln;
 	// aV(i) -> T(i,j) 1 = 11, 2=22, 3=12
-	Vector res = v1;
-	res(2) *= 2.0;
+	VectorND<3> res = v1;
+	res[2] *= 2.0;
 
 	return res;
 }
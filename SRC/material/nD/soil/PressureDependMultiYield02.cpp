@@ -53,11 +53,11 @@ double* PressureDependMultiYield02::Pvx=0;
 
 double PressureDependMultiYield02::pAtm = 101.;
 
-Matrix PressureDependMultiYield02::theTangent(6,6);
-T2Vector PressureDependMultiYield02::trialStrain;
-T2Vector PressureDependMultiYield02::subStrainRate;
-Vector PressureDependMultiYield02::workV6(6);
-T2Vector PressureDependMultiYield02::workT2V;
+thread_local Matrix PressureDependMultiYield02::theTangent(6,6);
+thread_local T2Vector PressureDependMultiYield02::trialStrain;
+thread_local T2Vector PressureDependMultiYield02::subStrainRate;
+thread_local Vector PressureDependMultiYield02::workV6(6);
+thread_local T2Vector PressureDependMultiYield02::workT2V;
 const	double pi = 3.14159265358979;
 
 //double check;
@@ -705,7 +705,7 @@ const Matrix & PressureDependMultiYield02::getTangent (void)
   if (ndm==3)
     return theTangent;
   else {
-    static Matrix workM(3,3);
+    static thread_local Matrix workM(3,3);
     workM(0,0) = theTangent(0,0);
     workM(0,1) = theTangent(0,1);
     workM(0,2) = 0.;
@@ -769,7 +769,7 @@ const Matrix & PressureDependMultiYield02::getInitialTangent (void)
   if (ndm==3)
     return theTangent;
   else {
-    static Matrix workM(3,3);
+    static thread_local Matrix workM(3,3);
     workM(0,0) = theTangent(0,0);
     workM(0,1) = theTangent(0,1);
     workM(0,2) = 0.;
@@ -889,7 +889,7 @@ const Vector & PressureDependMultiYield02::getStress (void)
   if (ndm==3)
     return trialStress.t2Vector();
   else {
-	static Vector workV(3);
+	static thread_local Vector workV(3);
     workV[0] = trialStress.t2Vector()[0];
     workV[1] = trialStress.t2Vector()[1];
     workV[2] = trialStress.t2Vector()[3];
@@ -1595,7 +1595,7 @@ const Vector & PressureDependMultiYield02::getCommittedStress (void)
 	double scale = currentStress.deviatorRatio(residualPress)/committedSurfaces[numOfSurfaces].size();
 	if (loadStagex[matN] != 1) scale = 0.;
   if (ndm==3) {
-		static Vector temp7(7);
+		static thread_local Vector temp7(7);
 		workV6 = currentStress.t2Vector();
     temp7[0] = workV6[0];
     temp7[1] = workV6[1];
@@ -1617,7 +1617,7 @@ const Vector & PressureDependMultiYield02::getCommittedStress (void)
 	}
 
   else {
-    static Vector temp5(5);
+    static thread_local Vector temp5(5);
 	workV6 = currentStress.t2Vector();
     temp5[0] = workV6[0];
     temp5[1] = workV6[1];
@@ -1647,11 +1647,11 @@ PressureDependMultiYield02::getStressToRecord (int numOutput)
     if (ndmx[matN] == 0) ndm = 2;
 
   if (ndm==3) {
-	static Vector temp7(7);
+	static thread_local Vector temp7(7);
 	temp7 = this->getCommittedStress();
 	if (numOutput == 6)
 	{
-		static Vector temp6(6);
+		static thread_local Vector temp6(6);
 		temp6[0] = temp7[0];
 		temp6[1] = temp7[1];
 		temp6[2] = temp7[2];
@@ -1669,18 +1669,18 @@ PressureDependMultiYield02::getStressToRecord (int numOutput)
   }
 
   else {
-    static Vector temp5(5);
+    static thread_local Vector temp5(5);
 	temp5 = this->getCommittedStress();
 	if (numOutput == 3)
 	{
-		static Vector temp3(3);
+		static thread_local Vector temp3(3);
 		temp3[0] = temp5[0];
 		temp3[1] = temp5[1];
 		temp3[2] = temp5[3];
 		return temp3;
 	} else if (numOutput == 4) 
 	{
-		static Vector temp4(4);
+		static thread_local Vector temp4(4);
 		temp4[0] = temp5[0];
 		temp4[1] = temp5[1];
 		temp4[2] = temp5[2];
@@ -1705,7 +1705,7 @@ const Vector & PressureDependMultiYield02::getCommittedStrain (void)
   if (ndm==3)
     return currentStrain.t2Vector(1);
   else {
-		static Vector workV(3);
+		static thread_local Vector workV(3);
 		workV6 = currentStrain.t2Vector(1);
     workV[0] = workV6[0];
     workV[1] = workV6[1];
@@ -1882,7 +1882,7 @@ void PressureDependMultiYield02::deviatorScaling(T2Vector & stress,
   if ( surfaceNum < numOfSurfaces && diff < 0. ) {
     double sz = -surfaces[surfaceNum].size()*coneHeight;
     double deviaSz = sqrt(sz*sz + diff);
-    static Vector devia(6);
+    static thread_local Vector devia(6);
     devia = stress.deviator();
     workV6 = devia;
     workV6.addVector(1.0, surfaces[surfaceNum].center(), -coneHeight);
@@ -1912,7 +1912,7 @@ void PressureDependMultiYield02::initSurfaceUpdate(void)
   if (committedActiveSurf == 0) return;
 
   double coneHeight = - (currentStress.volume() - residualPress);
-  static Vector devia(6);
+  static thread_local Vector devia(6);
   devia = currentStress.deviator();
   double Ms = sqrt(3./2.*(devia && devia));
 
@@ -2073,7 +2073,7 @@ PressureDependMultiYield02::getContactStress(T2Vector &contactStress)
     double residualPress = residualPressx[matN];
 
   double conHeig = trialStress.volume() - residualPress;
-  static Vector center(6);
+  static thread_local Vector center(6);
   center = theSurfaces[activeSurfaceNum].center();
   //workV6 = trialStress.deviator() - center*conHeig;
   workV6 = trialStress.deviator();
@@ -2110,7 +2110,7 @@ PressureDependMultiYield02::getSurfaceNormal(const T2Vector & stress, T2Vector &
 
   double conHeig = stress.volume() - residualPress;
   workV6 = stress.deviator();
-  static Vector center(6);
+  static thread_local Vector center(6);
   center = theSurfaces[activeSurfaceNum].center();
   double sz = theSurfaces[activeSurfaceNum].size();
   double volume = conHeig*((center && center) - 2./3.*sz*sz) - (workV6 && center);
@@ -2464,9 +2464,9 @@ int PressureDependMultiYield02::stressCorrection(int crossedSurface)
     double refShearModulus = refShearModulusx[matN];
 	double refBulkModulus = refBulkModulusx[matN];
 
-  static T2Vector contactStress;
+  static thread_local T2Vector contactStress;
   getContactStress(contactStress);
-  static T2Vector surfNormal;
+  static thread_local T2Vector surfNormal;
   getSurfaceNormal(contactStress, surfNormal);
   double plasticPotential = getPlasticPotential(contactStress,surfNormal);
   double tVolume = trialStress.volume();
@@ -2514,10 +2514,10 @@ void PressureDependMultiYield02::updateActiveSurface(void)
   if (activeSurfaceNum == numOfSurfaces) return;
 
   double A, B, C, X;
-  static Vector t1(6);
-  static Vector t2(6);
-  static Vector center(6);
-  static Vector outcenter(6);
+  static thread_local Vector t1(6);
+  static thread_local Vector t2(6);
+  static thread_local Vector center(6);
+  static thread_local Vector outcenter(6);
   double conHeig = trialStress.volume() - residualPress;
   center = theSurfaces[activeSurfaceNum].center();
   double size = theSurfaces[activeSurfaceNum].size();
@@ -2589,8 +2589,8 @@ void PressureDependMultiYield02::updateInnerSurface(void)
     double residualPress = residualPressx[matN];
 
 	if (activeSurfaceNum <= 1) return;
-	static Vector devia(6);
-	static Vector center(6);
+	static thread_local Vector devia(6);
+	static thread_local Vector center(6);
 
 	double conHeig = currentStress.volume() - residualPress;
 	devia = currentStress.deviator();
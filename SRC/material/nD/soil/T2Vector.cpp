@@ -22,7 +22,7 @@ delta(int i,int j) {
 }
 
 
-Vector T2Vector::engrgStrain(6);
+thread_local Vector T2Vector::engrgStrain(6);
 
 double operator && (const Vector & a, const Vector & b)
 {
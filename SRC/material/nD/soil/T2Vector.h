@@ -80,7 +80,7 @@ private:
   Vector theT2Vector;
   Vector theDeviator;
   double theVolume;
-  static Vector engrgStrain;
+  static thread_local Vector engrgStrain;
 };
 
 
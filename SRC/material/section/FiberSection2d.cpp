@@ -38,6 +38,7 @@
 #include <SensitiveResponse.h>
 typedef SensitiveResponse<FrameSection> SectionResponse;
 #include <UniaxialMaterial.h>
+#include <UniaxialBatch.h>
 
 #include "FiberResponse.h"
 
@@ -47,7 +48,7 @@ ID FiberSection2d::code(2);
 // allocate memory for fibers
 FiberSection2d::FiberSection2d(int tag, int num, bool compCentroid): 
   FrameSection(tag, SEC_TAG_FiberSection2d),
-  numFibers(0), sizeFibers(num), theMaterials(0), matData(new double [num*2]{}),
+  numFibers(0), sizeFibers(num), theMaterials(0), batchFibers(false), matData(new double [num*2]{}),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(compCentroid),
   e(2), s(0), ks(0), dedh(2)
 {
@@ -76,7 +77,7 @@ FiberSection2d::FiberSection2d(int tag, int num, bool compCentroid):
 // constructor for blank object that recvSelf needs to be invoked upon
 FiberSection2d::FiberSection2d():
   FrameSection(0, SEC_TAG_FiberSection2d),
-  numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
+  numFibers(0), sizeFibers(0), theMaterials(0), batchFibers(false), matData(0),
   QzBar(0.0), ABar(0.0), yBar(0.0), computeCentroid(true),
   e(2), s(0), ks(0), dedh(2)
 {
@@ -143,6 +144,7 @@ FiberSection2d::addFiber(UniaxialMaterial &theMat, const double Area, const doub
     return -1;
   }
 
+  OpenSees::setBatchRuns(theMaterials, numFibers, numFibers+1, sameClass);
   numFibers++;
 
   // Recompute centroid
@@ -155,6 +157,13 @@ FiberSection2d::addFiber(UniaxialMaterial &theMat, const double Area, const doub
   return 0;
 }
 
+void
+FiberSection2d::setBatchUpdate(bool batch)
+{
+  batchFibers = batch;
+  OpenSees::setBatchRuns(theMaterials, 0, numFibers, sameClass);
+}
+
 
 // destructor:
 FiberSection2d::~FiberSection2d()
@@ -234,17 +243,14 @@ FiberSection2d::setTrialSectionDeformation (const Vector &deforms)
                d1 = deforms(1);
 
   
-  int res = 0;
-  for (int i = 0; i < numFibers; i++) {
-    UniaxialMaterial *theMat = theMaterials[i];
+  // determine material strains and set them
+  auto strain = [&](int i) {
+    return d0 - (matData[2*i] - yBar)*d1;
+  };
+  auto accumulate = [&](int i, double stress, double tangent) {
     const double y = matData[2*i] - yBar;
     const double A = matData[2*i+1];
 
-    // determine material strain and set it
-    double strain = d0 - y*d1;
-    double tangent, stress;
-    res += theMat->setTrial(strain, stress, tangent);
-
     double ks0 = tangent * A;
     double ks1 = ks0 * -y;
     kData[0]  += ks0;
@@ -254,7 +260,13 @@ FiberSection2d::setTrialSectionDeformation (const Vector &deforms)
     double fs0 = stress * A;
     sData[0] += fs0;
     sData[1] += fs0 * -y;
-  }
+  };
+
+  int res;
+  if (batchFibers)
+    res = OpenSees::setTrialBatch(theMaterials, sameClass, 0, numFibers, strain, accumulate);
+  else
+    res = OpenSees::setTrialEach(theMaterials, 0, numFibers, strain, accumulate);
 
   kData[2] = kData[1];
 
@@ -329,7 +341,9 @@ FiberSection2d::getFrameCopy(void)
         return nullptr;
       }
     }  
+    theCopy->sameClass = sameClass;
   }
+  theCopy->batchFibers = batchFibers;
 
   theCopy->e = e;
   theCopy->QzBar = QzBar;
@@ -586,6 +600,7 @@ FiberSection2d::recvSelf(int commitTag, Channel &theChannel,
       theMaterials[i]->setDbTag(dbTag);
       res += theMaterials[i]->recvSelf(commitTag, theChannel, theBroker);
     }
+    OpenSees::setBatchRuns(theMaterials, 0, numFibers, sameClass);
 
     QzBar = 0.0;
     ABar  = 0.0;
@@ -33,6 +33,7 @@
 #include <Vector.h>
 #include <Matrix.h>
 #include <memory>
+#include <vector>
 
 class UniaxialMaterial;
 class Response;
@@ -77,6 +78,10 @@ class FiberSection2d : public FrameSection
 
     int addFiber(UniaxialMaterial &theMat, const double area, const double yLoc);
 
+    // Update runs of fibers of the same material class with one call
+    // to UniaxialMaterial::setTrialBatch; off by default
+    void setBatchUpdate(bool batch);
+
     // AddingSensitivity:BEGIN //////////////////////////////////////////
     int setParameter(const char **argv, int argc, Parameter &param);
     const Vector& getStressResultantSensitivity(int gradIndex,
@@ -95,6 +100,8 @@ class FiberSection2d : public FrameSection
     //  private:
     int numFibers, sizeFibers;         // number of fibers in the section
     UniaxialMaterial **theMaterials;   // array of pointers to materials
+    std::vector<char> sameClass;       // runs of fibers of the same material class
+    bool batchFibers;                  // update the runs in sameClass together
     std::shared_ptr<double[]> matData; // data for the materials [yloc and area]
     double   kData[4];                 // data for ks matrix 
     double   sData[2];                 // data for s vector 
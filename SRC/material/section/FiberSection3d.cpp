@@ -39,12 +39,19 @@
 #include <SensitiveResponse.h>
 typedef SensitiveResponse<FrameSection> SectionResponse;
 #include <UniaxialMaterial.h>
+#include <UniaxialBatch.h>
 #include <ElasticMaterial.h>
 
 #include "FiberResponse.h"
 
-// #include <threads/thread_pool.hpp>
 // #define N_FIBER_THREADS 6
+#ifdef N_FIBER_THREADS
+#  include <threads/shared_pool.hpp>
+#  ifndef N_FIBER_THREAD_MIN
+     // sections with fewer fibers than this are always integrated serially
+#    define N_FIBER_THREAD_MIN 64
+#  endif
+#endif
 
 ID FiberSection3d::code(4);
 
@@ -54,11 +61,8 @@ ID FiberSection3d::code(4);
 FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers,
                          UniaxialMaterial &torsion, bool compCentroid): 
   FrameSection(tag, SEC_TAG_FiberSection3d),
-  numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
+  numFibers(num), sizeFibers(num), theMaterials(0), batchFibers(false), matData(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
-#ifdef N_FIBER_THREADS
-    pool((void*)new OpenSees::thread_pool{N_FIBER_THREADS}),
-#endif
   e(eData), s(sData), ks(kData,4,4), theTorsion(0)
 {
   if (numFibers != 0) {
@@ -112,12 +116,9 @@ FiberSection3d::FiberSection3d(int tag, int num, Fiber **fibers,
 
 FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial &torsion, bool compCentroid): 
     FrameSection(tag, SEC_TAG_FiberSection3d),
-    numFibers(0), sizeFibers(num), theMaterials(nullptr), matData(new double [num*3]{}),
+    numFibers(0), sizeFibers(num), theMaterials(nullptr), batchFibers(false), matData(new double [num*3]{}),
     QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
     theTorsion(0),
-#ifdef N_FIBER_THREADS
-    pool((void*)new OpenSees::thread_pool{N_FIBER_THREADS}),
-#endif
     e(eData), s(sData), ks(kData, 4, 4)
 {
     if (sizeFibers != 0) {
@@ -144,7 +145,7 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
                          SectionIntegration &si, UniaxialMaterial &torsion,
                          bool compCentroid):
   FrameSection(tag, SEC_TAG_FiberSection3d),
-  numFibers(num), sizeFibers(num), theMaterials(0), matData(0),
+  numFibers(num), sizeFibers(num), theMaterials(0), batchFibers(false), matData(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(compCentroid),
   e(4), s(0), ks(0), theTorsion(0)
 {
@@ -205,11 +206,8 @@ FiberSection3d::FiberSection3d(int tag, int num, UniaxialMaterial **mats,
 // constructor for blank object that recvSelf needs to be invoked upon
 FiberSection3d::FiberSection3d():
   FrameSection(0, SEC_TAG_FiberSection3d),
-  numFibers(0), sizeFibers(0), theMaterials(0), matData(0),
+  numFibers(0), sizeFibers(0), theMaterials(0), batchFibers(false), matData(0),
   QzBar(0.0), QyBar(0.0), Abar(0.0), yBar(0.0), zBar(0.0), computeCentroid(true), 
-#ifdef N_FIBER_THREADS
-  pool((void*)new OpenSees::thread_pool{N_FIBER_THREADS}),
-#endif
   e(eData), s(sData), ks(kData, 4,4), theTorsion(0)
 {
 //   s = new Vector(sData, 4);
@@ -337,6 +335,7 @@ FiberSection3d::addFiber(UniaxialMaterial &theMat, const double Area, const doub
     return -1;
   }
 
+  OpenSees::setBatchRuns(theMaterials, numFibers, numFibers+1, sameClass);
   numFibers++;
 
   // Recompute centroid
@@ -352,73 +351,23 @@ FiberSection3d::addFiber(UniaxialMaterial &theMat, const double Area, const doub
   return 0;
 }
 
-
-#ifdef N_FIBER_THREADS
-#include <mutex>
-int
-FiberSection3d::setTrialSectionDeformation(const Vector &deforms)
+void
+FiberSection3d::setBatchUpdate(bool batch)
 {
-  e = deforms;
- 
-  sData.zero();
-  ks.Zero();
-
-  const double e0 = deforms(0), // u'
-               e1 = deforms(1),
-               e2 = deforms(2),
-               e3 = deforms(3);
-
-  int res = 0;
-  std::mutex resp_mutex;
-
-  ((OpenSees::thread_pool*)pool)->submit_loop<unsigned int>(0, numFibers,
-  [&,e0,e1,e2](int i){
-    int res = 0;
-
-    const double y  = matData[3*i]   - yBar;
-    const double z  = matData[3*i+1] - zBar;
-    const double A  = matData[3*i+2];
-
-    // determine material strain and set it
-    const double strain = e0 - y*e1 + z*e2;
-    double tangent, stress;
-    res += theMaterials[i]->setTrial(strain, stress, tangent);
-
-    const double EA = tangent * A;
-
-    const std::lock_guard<std::mutex> lock(resp_mutex);
-    kData[ 0] +=     EA;
-    kData[ 1] +=  -y*EA;
-    kData[ 2] +=   z*EA;
-
-    kData[ 5] +=  y*y*EA;
-    kData[10] +=  z*z*EA; 
-    kData[ 6] += -y*z*EA;
-
-    double fs0 = stress * A;
-    sData[ 0] +=    fs0;  // N
-    sData[ 1] += -y*fs0;  // Mz
-    sData[ 2] +=  z*fs0;  // My
+  batchFibers = batch;
+  OpenSees::setBatchRuns(theMaterials, 0, numFibers, sameClass);
+}
 
-    return res;
-  }).wait();
 
-  kData[4] = kData[1];
-  kData[8] = kData[2];
-  kData[9] = kData[6];
- 
-  if (theTorsion != nullptr) {
-    double stress, tangent;
-    res += theTorsion->setTrial(e3, stress, tangent);
-    sData[ 3] = stress;
-    kData[15] = tangent;
-  }
-
-  return res;
+namespace {
+// Partial stress resultants and stiffness of a block of fibers
+struct FiberBlock3d {
+  double k[6];  // k00, k01, k02, k11, k12, k22
+  double s[3];  // N, Mz, My
+  int    res;
+};
 }
 
-#else
-
 int
 FiberSection3d::setTrialSectionDeformation(const Vector &deforms)
 {
@@ -432,37 +381,64 @@ FiberSection3d::setTrialSectionDeformation(const Vector &deforms)
                e2 = deforms(2),
                e3 = deforms(3);
 
-  int res = 0;
-  for (int i = 0; i < numFibers; i++) {
-
-    const double y  = matData[3*i]   - yBar;
-    const double z  = matData[3*i+1] - zBar;
-    const double A  = matData[3*i+2];
-
-    // determine material strain and set it
-    double strain = e0 - y*e1 + z*e2;
-    double tangent, stress;
-    res += theMaterials[i]->setTrial(strain, stress, tangent);
-
-    double EA     = tangent * A;
+  // Integrate fibers [first, last) into a block-local sum; blocks
+  // never write to shared data, so no lock is needed when threaded
+  auto block = [&,e0,e1,e2](unsigned int first, unsigned int last) {
+    FiberBlock3d sum{};
+    // determine material strains and set them
+    auto strain = [&](int i) {
+      return e0 - (matData[3*i] - yBar)*e1 + (matData[3*i+1] - zBar)*e2;
+    };
+    auto accumulate = [&](int i, double stress, double tangent) {
+      const double y  = matData[3*i]   - yBar;
+      const double z  = matData[3*i+1] - zBar;
+      const double A  = matData[3*i+2];
+
+      const double EA = tangent * A;
+
+      sum.k[0] +=     EA;
+      sum.k[1] +=  -y*EA;
+      sum.k[2] +=   z*EA;
+      sum.k[3] +=  y*y*EA;
+      sum.k[4] += -y*z*EA;
+      sum.k[5] +=  z*z*EA;
+
+      const double fs0 = stress * A;
+      sum.s[0] +=    fs0;  // N
+      sum.s[1] += -y*fs0;  // Mz
+      sum.s[2] +=  z*fs0;  // My
+    };
+    if (batchFibers)
+      sum.res = OpenSees::setTrialBatch(theMaterials, sameClass, first, last, strain, accumulate);
+    else
+      sum.res = OpenSees::setTrialEach(theMaterials, first, last, strain, accumulate);
+    return sum;
+  };
 
-    kData[0] +=     EA;
-    kData[1] +=  -y*EA;
-    kData[2] +=   z*EA;
+#ifdef N_FIBER_THREADS
+  const FiberBlock3d sum = OpenSees::reduce_blocks<FiberBlock3d>(numFibers, 
+      N_FIBER_THREAD_MIN, N_FIBER_THREADS, block,
+      [](FiberBlock3d& total, const FiberBlock3d& part) {
+        for (int j=0; j<6; j++) total.k[j] += part.k[j];
+        for (int j=0; j<3; j++) total.s[j] += part.s[j];
+        total.res += part.res;
+  });
+#else
+  const FiberBlock3d sum = block(0, numFibers);
+#endif
 
-    kData[ 5] +=  y*y*EA;
-    kData[10] +=  z*z*EA; 
-    kData[ 6] += -y*z*EA;
+  int res = sum.res;
 
-    double fs0 = stress * A;
-    sData[0] +=    fs0;  // N
-    sData[1] += -y*fs0;  // Mz
-    sData[2] +=  z*fs0;  // My
-  }
+  kData[ 0] = sum.k[0];
+  kData[ 1] = kData[4] = sum.k[1];
+  kData[ 2] = kData[8] = sum.k[2];
+  kData[ 5] = sum.k[3];
+  kData[ 6] = kData[9] = sum.k[4];
+  kData[10] = sum.k[5];
 
-  kData[4] = kData[1];
-  kData[8] = kData[2];
-  kData[9] = kData[6];
+  sData[0] = sum.s[0];
+  sData[1] = sum.s[1];
+  sData[2] = sum.s[2];
  
   if (theTorsion != nullptr) {
     double stress, tangent;
@@ -473,7 +449,6 @@ FiberSection3d::setTrialSectionDeformation(const Vector &deforms)
 
   return res;
 }
-#endif
 
 
 
@@ -542,7 +517,6 @@ FiberSection3d::getFrameCopy(void)
   theCopy->setTag(this->getTag());
   theCopy->numFibers  = numFibers;
   theCopy->sizeFibers = numFibers;
-  theCopy->pool       = pool;
 
   if (numFibers != 0) {
     theCopy->theMaterials = new UniaxialMaterial *[numFibers];
@@ -557,7 +531,9 @@ FiberSection3d::getFrameCopy(void)
         return nullptr;
       }
     }    
+    theCopy->sameClass = sameClass;
   }
+  theCopy->batchFibers = batchFibers;
 
   theCopy->e = e;
   theCopy->QzBar = QzBar;
@@ -883,6 +859,7 @@ FiberSection3d::recvSelf(int commitTag, Channel &theChannel,
       theMaterials[i]->setDbTag(dbTag);
       res += theMaterials[i]->recvSelf(commitTag, theChannel, theBroker);
     }
+    OpenSees::setBatchRuns(theMaterials, 0, numFibers, sameClass);
 
     QzBar = 0.0;
     QyBar = 0.0;
@@ -34,6 +34,7 @@
 #include <Matrix.h>
 #include <VectorND.h>
 #include <memory>
+#include <vector>
 
 class Response;
 class UniaxialMaterial;
@@ -80,6 +81,10 @@ class FiberSection3d : public FrameSection
 
     int addFiber(UniaxialMaterial &theMat, const double area, const double y, const double z);
 
+    // Update runs of fibers of the same material class with one call
+    // to UniaxialMaterial::setTrialBatch; off by default
+    void setBatchUpdate(bool batch);
+
     // AddingSensitivity:BEGIN //////////////////////////////////////////
     int setParameter(const char **argv, int argc, Parameter &param);
 
@@ -99,6 +104,8 @@ class FiberSection3d : public FrameSection
   private:
     int numFibers, sizeFibers;         // number of fibers in the section
     UniaxialMaterial **theMaterials;   // array of pointers to materials
+    std::vector<char> sameClass;       // runs of fibers of the same material class
+    bool batchFibers;                  // update the runs in sameClass together
     std::shared_ptr<double[]> matData; // data for the materials [yloc, zloc, and area]
     double   kData[16];                // data for ks matrix 
 
@@ -115,7 +122,6 @@ class FiberSection3d : public FrameSection
 
     OpenSees::VectorND<4> eData, sData;
     UniaxialMaterial *theTorsion;
-    void *pool;        // thread pool
 };
 
 #endif
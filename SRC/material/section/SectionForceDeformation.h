@@ -99,6 +99,10 @@ class SectionForceDeformation : public TaggedObject, public MovableObject
   virtual const ID &getType(void) = 0;
   virtual int getOrder (void) const = 0;
 
+  // true if different sections of this class, and their materials, may
+  // be updated on different threads at once
+  virtual bool isReentrant(void) const {return false;}
+
   virtual Response *setResponse(const char **argv, int argc, OPS_Stream &s);
   virtual int getResponse(int responseID, Information &info);
 
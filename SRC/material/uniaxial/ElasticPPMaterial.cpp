@@ -26,6 +26,7 @@
 // Revision: A
 //
 #include <ElasticPPMaterial.h>
+#include <typeinfo>
 #include <Vector.h>
 #include <Channel.h>
 #include <Parameter.h>
@@ -188,6 +189,25 @@ ElasticPPMaterial::getTangent(void)
   return trialTangent;
 }
 
+int
+ElasticPPMaterial::setTrialBatch(UniaxialMaterial **materials, const double *strain,
+                                 double *stress, double *tangent, int n)
+{
+  // Subclasses that do not override this keep the virtual path
+  if (typeid(*this) != typeid(ElasticPPMaterial))
+    return UniaxialMaterial::setTrialBatch(materials, strain, stress, tangent, n);
+
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    ElasticPPMaterial *theMat = static_cast<ElasticPPMaterial *>(materials[i]);
+    res += theMat->ElasticPPMaterial::setTrialStrain(strain[i]);
+    stress[i]  = theMat->trialStress;
+    tangent[i] = theMat->trialTangent;
+  }
+
+  return res;
+}
+
 int 
 ElasticPPMaterial::commitState(void)
 {
@@ -49,6 +49,8 @@ class ElasticPPMaterial : public UniaxialMaterial
     const char *getClassType(void) const {return "ElasticPPMaterial";};
 
     int setTrialStrain(double strain, double strainRate = 0.0); 
+    int setTrialBatch(UniaxialMaterial **materials, const double *strain,
+                      double *stress, double *tangent, int n);
     double getStrain(void);          
     double getStress(void);
     double getTangent(void);
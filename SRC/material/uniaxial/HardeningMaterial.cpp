@@ -26,6 +26,7 @@
 // HardeningMaterial. 
 //
 #include <HardeningMaterial.h>
+#include <typeinfo>
 #include <Vector.h>
 #include <Channel.h>
 #include <Matrix.h>
@@ -128,6 +129,25 @@ HardeningMaterial::getTangent()
     return Ttangent;
 }
 
+int
+HardeningMaterial::setTrialBatch(UniaxialMaterial **materials, const double *strain,
+                                 double *stress, double *tangent, int n)
+{
+  // Subclasses that do not override this keep the virtual path
+  if (typeid(*this) != typeid(HardeningMaterial))
+    return UniaxialMaterial::setTrialBatch(materials, strain, stress, tangent, n);
+
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    HardeningMaterial *theMat = static_cast<HardeningMaterial *>(materials[i]);
+    res += theMat->HardeningMaterial::setTrialStrain(strain[i]);
+    stress[i]  = theMat->Tstress;
+    tangent[i] = theMat->Ttangent;
+  }
+
+  return res;
+}
+
 double 
 HardeningMaterial::getStrain()
 {
@@ -43,6 +43,8 @@ class HardeningMaterial : public UniaxialMaterial
     const char *getClassType(void) const {return "HardeningMaterial";};
 
     int setTrialStrain(double strain, double strainRate = 0.0); 
+    int setTrialBatch(UniaxialMaterial **materials, const double *strain,
+                      double *stress, double *tangent, int n);
     double getStrain(void);          
     double getStress(void);
     double getTangent(void);
@@ -105,6 +105,18 @@ UniaxialMaterial::setTrial(double strain, double temperature, double &stress, do
 }
 
 
+int
+UniaxialMaterial::setTrialBatch(UniaxialMaterial **materials, const double *strain,
+                                double *stress, double *tangent, int n)
+{
+  int res = 0;
+  for (int i = 0; i < n; i++)
+    res += materials[i]->setTrial(strain[i], stress[i], tangent[i]);
+
+  return res;
+}
+
+
 // default operation for strain rate is zero
 double
 UniaxialMaterial::getStrainRate()
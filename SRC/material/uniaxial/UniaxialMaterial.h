@@ -58,6 +58,12 @@ class UniaxialMaterial : // public Material
     virtual int setTrial(double strain, double &stress, double &tangent, double strainRate = 0.0);
     virtual int setTrial(double strain, double temperature, double &stress, double &tangent, double &thermalElongation, double strainRate = 0.0);
 
+    // Batched form of setTrial for materials[0..n), which must all be of
+    // the same class as this material (called on materials[0]). Classes
+    // override it to update the group without a virtual call per material.
+    virtual int setTrialBatch(UniaxialMaterial **materials, const double *strain,
+                              double *stress, double *tangent, int n);
+
     virtual double getStrain() = 0;
     virtual double getStrainRate();
     virtual double getStress() = 0;
@@ -73,6 +79,10 @@ class UniaxialMaterial : // public Material
     virtual UniaxialMaterial *getCopy() = 0;
     virtual UniaxialMaterial *getCopy(SectionForceDeformation *s);
 
+    // true if different instances may be updated on different threads at
+    // once; the default assumes storage shared by the class
+    virtual bool isReentrant(void) const {return false;}
+
 
     // method for this material to update itself according to its new parameters
     virtual void update() {return;}
@@ -41,6 +41,7 @@
 #include <math.h>
 
 #include <Concrete02.h>
+#include <typeinfo>
 #include <OPS_Globals.h>
 #include <float.h>
 #include <Channel.h>
@@ -288,6 +289,25 @@ Concrete02::getTangent(void)
   return e;
 }
 
+int
+Concrete02::setTrialBatch(UniaxialMaterial **materials, const double *strain,
+                          double *stress, double *tangent, int n)
+{
+  // Subclasses that do not override this keep the virtual path
+  if (typeid(*this) != typeid(Concrete02))
+    return UniaxialMaterial::setTrialBatch(materials, strain, stress, tangent, n);
+
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    Concrete02 *theMat = static_cast<Concrete02 *>(materials[i]);
+    res += theMat->Concrete02::setTrialStrain(strain[i]);
+    stress[i]  = theMat->sig;
+    tangent[i] = theMat->e;
+  }
+
+  return res;
+}
+
 int 
 Concrete02::commitState(void)
 {
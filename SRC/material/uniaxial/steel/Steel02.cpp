@@ -35,6 +35,7 @@
 
 #include <stdlib.h>
 #include <Steel02.h>
+#include <typeinfo>
 #include <float.h>
 #include <Channel.h>
 #include <Information.h>
@@ -382,6 +383,25 @@ Steel02::getTangent(void)
   return e;
 }
 
+int
+Steel02::setTrialBatch(UniaxialMaterial **materials, const double *strain,
+                       double *stress, double *tangent, int n)
+{
+  // Subclasses that do not override this keep the virtual path
+  if (typeid(*this) != typeid(Steel02))
+    return UniaxialMaterial::setTrialBatch(materials, strain, stress, tangent, n);
+
+  int res = 0;
+  for (int i = 0; i < n; i++) {
+    Steel02 *theMat = static_cast<Steel02 *>(materials[i]);
+    res += theMat->Steel02::setTrialStrain(strain[i]);
+    stress[i]  = theMat->sig;
+    tangent[i] = theMat->e;
+  }
+
+  return res;
+}
+
 int 
 Steel02::commitState(void)
 {
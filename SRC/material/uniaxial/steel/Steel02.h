@@ -68,6 +68,8 @@ class Steel02 : public UniaxialMaterial
     UniaxialMaterial *getCopy(void);
 
     int setTrialStrain(double strain, double strainRate = 0.0); 
+    int setTrialBatch(UniaxialMaterial **materials, const double *strain,
+                      double *stress, double *tangent, int n);
     double getStrain(void);      
     double getStress(void);
     double getTangent(void);
@@ -108,7 +108,9 @@ class Cell {
   void activate_nodes();
 
   //! Return a pointer to element type of a cell
-  std::shared_ptr<Element<Tdim>> element_ptr() { return element_; }
+  const std::shared_ptr<Element<Tdim>>& element_ptr() const {
+    return element_;
+  }
 
   //! Return the number of shape functions, returns zero if the element type is
   //! not set.
@@ -167,7 +169,9 @@ class Cell {
   double mean_length() const { return mean_length_; }
 
   //! Return nodal coordinates
-  Eigen::MatrixXd nodal_coordinates() const { return nodal_coordinates_; }
+  const Eigen::MatrixXd& nodal_coordinates() const {
+    return nodal_coordinates_;
+  }
 
   //! Check if a point is in a cartesian cell by checking the domain ranges
   //! \param[in] point Coordinates of point
@@ -41,6 +41,7 @@ using Json = nlohmann::json;
 #include "node.h"
 #include "particle.h"
 #include "particle_base.h"
+#include "particle_soa.h"
 #include "pod_particle.h"
 #include "radial_basis_function.h"
 #include "traction.h"
@@ -266,6 +267,31 @@ class Mesh {
   //! \retval particles Particles which cannot be located in the mesh
   std::vector<std::shared_ptr<mpm::ParticleBase<Tdim>>> locate_particles_mesh();
 
+  //! Sort particles in Morton order of their cells
+  //! \details Particles in the same cell, and in cells close in space, are
+  //! made neighbours in the particle traversal, so each pass over the
+  //! particles reads nodes and cells with good locality and the threads of
+  //! a pass touch mostly disjoint nodes. Particles without a cell are
+  //! placed last. Within a cell particles are ordered by id.
+  void sort_particles();
+
+  //! Compute particle strains with the structure-of-arrays kernel
+  //! \param[in] status Use the kernel in compute_particles_strain
+  void use_particle_soa(bool status) { use_particle_soa_ = status; }
+
+  //! Compute strain of the particles
+  //! \param[in] dt Analysis time step
+  void compute_particles_strain(double dt);
+
+  //! Map mass and momentum by cell colour instead of through node locks
+  //! \param[in] status Use the coloured transfer in
+  //! map_particles_mass_momentum
+  void use_coloured_transfer(bool status) { use_coloured_transfer_ = status; }
+
+  //! Map mass and momentum of the particles to the nodes
+  //! \param[in] velocity_update Method to update nodal velocity
+  void map_particles_mass_momentum(mpm::VelocityUpdate velocity_update);
+
   //! Iterate over particles
   //! \tparam Toper Callable object typically a baseclass functor
   template <typename Toper>
@@ -676,6 +702,9 @@ class Mesh {
   bool locate_particle_cells(
       const std::shared_ptr<mpm::ParticleBase<Tdim>>& particle);
 
+  // Bring the nodes and cells of the structure-of-arrays kernels up to date
+  void update_particle_soa();
+
  private:
   //! mesh id
   unsigned id_{std::numeric_limits<unsigned>::max()};
@@ -691,6 +720,16 @@ class Mesh {
   tsl::robin_map<unsigned, std::vector<mpm::Index>> particle_sets_;
   //! Map of particles for fast retrieval
   Map<ParticleBase<Tdim>> map_particles_;
+  //! Structure-of-arrays kernel for particle strains
+  ParticleSoA<Tdim> particle_soa_;
+  //! Use the structure-of-arrays kernel
+  bool use_particle_soa_{false};
+  //! Map mass and momentum by cell colour
+  bool use_coloured_transfer_{false};
+  //! Nodes of the structure-of-arrays kernel are current
+  bool particle_soa_nodes_{false};
+  //! Cell colours of the structure-of-arrays kernel are current
+  bool particle_soa_cells_{false};
   //! Vector of nodes
   Vector<NodeBase<Tdim>> nodes_;
   //! Vector of domain shared nodes
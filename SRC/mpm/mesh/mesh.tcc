@@ -53,6 +53,7 @@ bool mpm::Mesh<Tdim>::add_node(const std::shared_ptr<mpm::NodeBase<Tdim>>& node,
   bool insertion_status = nodes_.add(node, check_duplicates);
   // Add node to map
   if (insertion_status) map_nodes_.insert(node->id(), node);
+  particle_soa_nodes_ = false;
   return insertion_status;
 }
 
@@ -61,6 +62,7 @@ template <unsigned Tdim>
 bool mpm::Mesh<Tdim>::remove_node(
     const std::shared_ptr<mpm::NodeBase<Tdim>>& node) {
   const mpm::Index id = node->id();
+  particle_soa_nodes_ = false;
   // Remove a node if found in the container
   return (nodes_.remove(node) && map_nodes_.remove(id));
 }
@@ -261,6 +263,7 @@ bool mpm::Mesh<Tdim>::add_cell(const std::shared_ptr<mpm::Cell<Tdim>>& cell,
   bool insertion_status = cells_.add(cell, check_duplicates);
   // Add cell to map
   if (insertion_status) map_cells_.insert(cell->id(), cell);
+  particle_soa_cells_ = false;
   return insertion_status;
 }
 
@@ -269,6 +272,7 @@ template <unsigned Tdim>
 bool mpm::Mesh<Tdim>::remove_cell(
     const std::shared_ptr<mpm::Cell<Tdim>>& cell) {
   const mpm::Index id = cell->id();
+  particle_soa_cells_ = false;
   // Remove a cell if found in the container
   return (cells_.remove(cell) && map_cells_.remove(id));
 }
@@ -1149,6 +1153,99 @@ bool mpm::Mesh<Tdim>::locate_particle_cells(
   return status;
 }
 
+//! Sort particles in Morton order of their cells
+template <unsigned Tdim>
+void mpm::Mesh<Tdim>::sort_particles() {
+  if (particles_.size() == 0 || cells_.size() == 0) return;
+
+  // Bounding box of the cell centroids
+  VectorDim min = (*cells_.cbegin())->centroid();
+  VectorDim max = min;
+  for (auto citr = cells_.cbegin(); citr != cells_.cend(); ++citr) {
+    min = min.cwiseMin((*citr)->centroid());
+    max = max.cwiseMax((*citr)->centroid());
+  }
+
+  // Morton code of each cell on a grid over the bounding box
+  const unsigned nbits = (Tdim == 1) ? 32 : 64 / Tdim;
+  const double ngrid = std::ldexp(1., nbits) - 1.;
+  tsl::robin_map<mpm::Index, std::uint64_t> cell_codes;
+  cell_codes.reserve(cells_.size());
+  for (auto citr = cells_.cbegin(); citr != cells_.cend(); ++citr) {
+    const VectorDim centroid = (*citr)->centroid();
+    std::array<std::uint32_t, Tdim> index;
+    for (unsigned i = 0; i < Tdim; ++i) {
+      const double range = max(i) - min(i);
+      index[i] = (range > 0.) ? static_cast<std::uint32_t>(
+                                    (centroid(i) - min(i)) / range * ngrid)
+                              : 0;
+    }
+    cell_codes.insert({(*citr)->id(), mpm::math::morton_code<Tdim>(index)});
+  }
+
+  // Sort key of each particle
+  std::vector<std::pair<std::array<std::uint64_t, 2>,
+                        std::shared_ptr<mpm::ParticleBase<Tdim>>>>
+      keys;
+  keys.reserve(particles_.size());
+  for (auto pitr = particles_.cbegin(); pitr != particles_.cend(); ++pitr) {
+    const auto citr = cell_codes.find((*pitr)->cell_id());
+    const std::uint64_t code = (citr != cell_codes.end())
+                                   ? citr->second
+                                   : std::numeric_limits<std::uint64_t>::max();
+    keys.emplace_back(std::array<std::uint64_t, 2>{code, (*pitr)->id()},
+                      *pitr);
+  }
+  std::sort(keys.begin(), keys.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  // Particles are already unique
+  particles_.clear();
+  for (const auto& key : keys) particles_.add(key.second, false);
+}
+
+//! Compute strain of the particles
+template <unsigned Tdim>
+void mpm::Mesh<Tdim>::compute_particles_strain(double dt) {
+  if (!use_particle_soa_) {
+    this->iterate_over_particles(
+        std::bind(&mpm::ParticleBase<Tdim>::compute_strain,
+                  std::placeholders::_1, dt));
+    return;
+  }
+
+  this->update_particle_soa();
+  particle_soa_.compute_strain(particles_, dt);
+}
+
+//! Map mass and momentum of the particles to the nodes
+template <unsigned Tdim>
+void mpm::Mesh<Tdim>::map_particles_mass_momentum(
+    mpm::VelocityUpdate velocity_update) {
+  if (!use_coloured_transfer_) {
+    this->iterate_over_particles(
+        std::bind(&mpm::ParticleBase<Tdim>::map_mass_momentum_to_nodes,
+                  std::placeholders::_1, velocity_update));
+    return;
+  }
+
+  this->update_particle_soa();
+  particle_soa_.map_mass_momentum_to_nodes(particles_, velocity_update);
+}
+
+//! Bring the nodes and cells of the structure-of-arrays kernels up to date
+template <unsigned Tdim>
+void mpm::Mesh<Tdim>::update_particle_soa() {
+  if (!particle_soa_nodes_) {
+    particle_soa_.assign_nodes(nodes_);
+    particle_soa_nodes_ = true;
+  }
+  if (!particle_soa_cells_) {
+    particle_soa_.assign_cells(cells_);
+    particle_soa_cells_ = true;
+  }
+}
+
 //! Iterate over particles
 template <unsigned Tdim>
 template <typename Toper>
@@ -2282,6 +2379,9 @@ bool mpm::Mesh<Tdim>::upgrade_cells_to_nonlocal(
       }
     }
 
+    // Cells now share nodes with more neighbours
+    particle_soa_cells_ = false;
+
   } catch (std::exception& exception) {
     console_->error("{} #{}: {}\n", __FILE__, __LINE__, exception.what());
     status = false;
@@ -45,6 +45,12 @@ class ParticleBbar : public mpm::Particle<Tdim> {
   //! Map internal force
   inline void map_internal_force() noexcept override;
 
+  //! The B-bar strain rate is not computed by the batched strain kernel
+  bool strain_gradients(unsigned stride, double* dn_dx,
+                        double* dn_dx_centroid) const noexcept override {
+    return false;
+  }
+
   //! Type of particle
   std::string type() const override {
     return (Tdim == 2) ? "P2DBBAR" : "P3DBBAR";
@@ -137,6 +137,14 @@ class Particle : public ParticleBase<Tdim> {
       mpm::VelocityUpdate velocity_update =
           mpm::VelocityUpdate::FLIP) noexcept override;
 
+  //! Nodal mass and momentum contributions of the particle
+  //! \param[in] velocity_update Method to update nodal velocity
+  //! \param[out] mass Mass mapped to each node of the cell
+  //! \param[out] momentum Momentum mapped, momentum[n * Tdim + i]
+  bool mass_momentum_weights(mpm::VelocityUpdate velocity_update,
+                             double* mass,
+                             double* momentum) const noexcept override;
+
   //! Map multimaterial properties to nodes
   void map_multimaterial_mass_momentum_to_nodes() noexcept override;
 
@@ -167,6 +175,21 @@ class Particle : public ParticleBase<Tdim> {
   //! \param[in] dt Analysis time step
   void compute_strain(double dt) noexcept override;
 
+  //! Copy the shape function gradients used to compute the strain rate
+  //! \param[in] stride Leading dimension of the output arrays
+  //! \param[out] dn_dx dN/dx at the particle
+  //! \param[out] dn_dx_centroid dN/dx at the cell centroid
+  bool strain_gradients(unsigned stride, double* dn_dx,
+                        double* dn_dx_centroid) const noexcept override;
+
+  //! Assign a strain rate computed by the batched strain kernel
+  //! \param[in] strain_rate Strain rate at the particle
+  //! \param[in] dvolumetric_strain Volumetric strain increment at centroid
+  //! \param[in] dt Analysis time step
+  void assign_strain_rate(const Eigen::Matrix<double, 6, 1>& strain_rate,
+                          double dvolumetric_strain,
+                          double dt) noexcept override;
+
   //! Return strain of the particle
   Eigen::Matrix<double, 6, 1> strain() const override { return strain_; }
 
@@ -533,7 +533,7 @@ void mpm::Particle<Tdim>::compute_shapefn() noexcept {
   // Check if particle has a valid cell ptr
   assert(cell_ != nullptr);
   // Get element ptr of a cell
-  const auto element = cell_->element_ptr();
+  const auto& element = cell_->element_ptr();
 
   // Deformation Gradient
   const Eigen::Matrix<double, Tdim, Tdim> def_grad =
@@ -651,6 +651,26 @@ void mpm::Particle<Tdim>::map_mass_momentum_to_nodes(
   }
 }
 
+//! Nodal mass and momentum contributions of the particle
+template <unsigned Tdim>
+bool mpm::Particle<Tdim>::mass_momentum_weights(
+    mpm::VelocityUpdate velocity_update, double* mass,
+    double* momentum) const noexcept {
+  // Affine and Taylor updates map a velocity that varies over the cell
+  if (velocity_update != mpm::VelocityUpdate::FLIP &&
+      velocity_update != mpm::VelocityUpdate::PIC)
+    return false;
+  if (shapefn_.size() != nodes_.size()) return false;
+
+  // Same contributions as map_mass_momentum_to_nodes
+  for (unsigned i = 0; i < nodes_.size(); ++i) {
+    mass[i] = mass_ * shapefn_[i];
+    for (unsigned j = 0; j < Tdim; ++j)
+      momentum[i * Tdim + j] = mass[i] * velocity_[j];
+  }
+  return true;
+}
+
 //! Map particle mass and momentum to nodes for affine transformation
 template <unsigned Tdim>
 void mpm::Particle<Tdim>::map_mass_momentum_to_nodes_affine() noexcept {
@@ -870,6 +890,35 @@ void mpm::Particle<Tdim>::compute_strain(double dt) noexcept {
   dvolumetric_strain_ = dt * strain_rate_centroid.head(Tdim).sum();
 }
 
+// Copy the shape function gradients used to compute the strain rate
+template <unsigned Tdim>
+bool mpm::Particle<Tdim>::strain_gradients(
+    unsigned stride, double* dn_dx, double* dn_dx_centroid) const noexcept {
+  const unsigned nnodes = nodes_.size();
+  if (nnodes > stride || dn_dx_.rows() != nnodes ||
+      dn_dx_centroid_.rows() != nnodes)
+    return false;
+
+  for (unsigned i = 0; i < Tdim; ++i)
+    for (unsigned n = 0; n < nnodes; ++n) {
+      dn_dx[i * stride + n] = dn_dx_(n, i);
+      dn_dx_centroid[i * stride + n] = dn_dx_centroid_(n, i);
+    }
+  return true;
+}
+
+// Assign a strain rate computed by the batched strain kernel
+template <unsigned Tdim>
+void mpm::Particle<Tdim>::assign_strain_rate(
+    const Eigen::Matrix<double, 6, 1>& strain_rate, double dvolumetric_strain,
+    double dt) noexcept {
+  // Same update as compute_strain
+  strain_rate_ = strain_rate;
+  dstrain_ = strain_rate_ * dt;
+  strain_.noalias() += dstrain_;
+  dvolumetric_strain_ = dvolumetric_strain;
+}
+
 // Compute stress
 template <unsigned Tdim>
 void mpm::Particle<Tdim>::compute_stress(double dt,
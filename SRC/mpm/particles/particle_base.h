@@ -119,6 +119,11 @@ class ParticleBase {
   //! Return cell ptr status
   virtual bool cell_ptr() const = 0;
 
+  //! Return nodes of the cell the particle is in
+  const std::vector<std::shared_ptr<NodeBase<Tdim>>>& nodes() const {
+    return nodes_;
+  }
+
   //! Remove cell
   virtual void remove_cell() = 0;
 
@@ -155,6 +160,20 @@ class ParticleBase {
       mpm::VelocityUpdate velocity_update =
           mpm::VelocityUpdate::FLIP) noexcept = 0;
 
+  //! Nodal mass and momentum contributions of the particle
+  //! \details Used by the particle-to-grid transfer of ParticleSoA, which
+  //! adds the contributions to the nodes itself
+  //! \param[in] velocity_update Method to update nodal velocity
+  //! \param[out] mass Mass mapped to each node of the cell
+  //! \param[out] momentum Momentum mapped, momentum[n * Tdim + i]
+  //! \retval status False if the particle maps through
+  //! map_mass_momentum_to_nodes
+  virtual bool mass_momentum_weights(mpm::VelocityUpdate velocity_update,
+                                     double* mass,
+                                     double* momentum) const noexcept {
+    return false;
+  }
+
   //! Map multimaterial properties to nodes
   virtual void map_multimaterial_mass_momentum_to_nodes() noexcept = 0;
 
@@ -242,6 +261,26 @@ class ParticleBase {
   //! dvolumetric strain
   virtual double dvolumetric_strain() const = 0;
 
+  //! Copy the shape function gradients used to compute the strain rate
+  //! \details Used by the batched strain kernel of ParticleSoA. Gradients
+  //! are written component-major, dn_dx[i * stride + n] = dN_n/dx_i
+  //! \param[in] stride Leading dimension of the output arrays
+  //! \param[out] dn_dx dN/dx at the particle
+  //! \param[out] dn_dx_centroid dN/dx at the cell centroid
+  //! \retval status False if the particle computes its own strain
+  virtual bool strain_gradients(unsigned stride, double* dn_dx,
+                                double* dn_dx_centroid) const noexcept {
+    return false;
+  }
+
+  //! Assign a strain rate computed by the batched strain kernel
+  //! \param[in] strain_rate Strain rate at the particle
+  //! \param[in] dvolumetric_strain Volumetric strain increment at centroid
+  //! \param[in] dt Analysis time step
+  virtual void assign_strain_rate(const Eigen::Matrix<double, 6, 1>& strain_rate,
+                                  double dvolumetric_strain,
+                                  double dt) noexcept {}
+
   //! Deformation gradient
   virtual Eigen::Matrix<double, 3, 3> deformation_gradient() const = 0;
 
@@ -77,6 +77,13 @@ class ParticleFiniteStrain : public mpm::Particle<Tdim> {
   //! \param[in] dt Analysis time step
   void compute_strain(double dt) noexcept override;
 
+  //! Strain is computed from the deformation gradient, not by the batched
+  //! strain kernel
+  bool strain_gradients(unsigned stride, double* dn_dx,
+                        double* dn_dx_centroid) const noexcept override {
+    return false;
+  }
+
   //! Compute stress and update deformation gradient
   //! \param[in] dt Analysis time step
   //! \param[in] stress_rate Use Cauchy or Jaumann rate of stress
@@ -0,0 +1,138 @@
+#ifndef MPM_PARTICLE_SOA_H_
+#define MPM_PARTICLE_SOA_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Dense>
+// OpenMP
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+// TSL Maps
+#include <tsl/robin_map.h>
+
+#include "cell.h"
+#include "colouring.h"
+#include "data_types.h"
+#include "math_utility.h"
+#include "node_base.h"
+#include "particle_base.h"
+#include "vector.h"
+
+namespace mpm {
+
+//! ParticleSoA class
+//! \brief Structure-of-arrays view of the particles for the strain kernel
+//! and the particle-to-grid transfer
+//! \details Holds, contiguous and in particle traversal order, the cell
+//! connectivity of each particle as indices into dense arrays of nodal
+//! quantities. The strain pass then reads nodal velocities from a dense
+//! array instead of calling through every particle's node pointers, and
+//! computes the strain rate at the particle and the volumetric strain rate
+//! at the cell centroid in one sweep over the nodes. Particles keep their
+//! own state: shape function gradients are read from, and strains written
+//! back to, each particle. A row is rebuilt only when its particle or cell
+//! changes, so the connectivity is reused between relocations.
+//!
+//! Mass and momentum are mapped to the nodes without taking the node locks:
+//! cells are coloured so that no two cells of a colour share a node, the
+//! cells of one colour are processed in parallel, each by one thread, into
+//! dense nodal arrays, and the sums are added to each node once at the end.
+//! \tparam Tdim Dimension
+template <unsigned Tdim>
+class ParticleSoA {
+ public:
+  //! Default constructor
+  ParticleSoA() = default;
+
+  //! Assign the nodes of the dense nodal arrays
+  //! \param[in] nodes Nodes of the mesh
+  void assign_nodes(const Vector<NodeBase<Tdim>>& nodes);
+
+  //! Colour the cells so that cells of a colour share no node
+  //! \param[in] cells Cells of the mesh
+  void assign_cells(const Vector<Cell<Tdim>>& cells);
+
+  //! Number of nodes
+  mpm::Index nnodes() const { return nodes_.size(); }
+
+  //! Number of cell colours
+  unsigned ncolours() const { return ncolours_; }
+
+  //! Clear the connectivity, so every row is rebuilt on the next pass
+  void clear();
+
+  //! Compute strain of the particles
+  //! \details Particles that do not provide their shape function gradients
+  //! (finite strain, B-bar) compute their own strain in the same pass
+  //! \param[in] particles Particles in traversal order
+  //! \param[in] dt Analysis time step
+  void compute_strain(const Vector<ParticleBase<Tdim>>& particles, double dt);
+
+  //! Map mass and momentum of the particles to the nodes
+  //! \details Particles that do not provide their nodal contributions (two
+  //! phase, affine and Taylor velocity updates) map through the node locks
+  //! \param[in] particles Particles in traversal order
+  //! \param[in] velocity_update Method to update nodal velocity
+  void map_mass_momentum_to_nodes(const Vector<ParticleBase<Tdim>>& particles,
+                                  mpm::VelocityUpdate velocity_update);
+
+ private:
+  //! Follow the particles, rebuilding the rows that changed
+  //! \param[in] particles Particles in traversal order
+  void update_rows(const Vector<ParticleBase<Tdim>>& particles);
+
+  //! Rebuild the rows whose particle or cell has changed
+  //! \retval nnodes Largest number of nodes of a row that did not fit
+  unsigned update_connectivity();
+
+  //! Group the rows by colour and cell
+  void update_colour_groups();
+
+  //! Gather the nodal velocities into a dense array
+  void gather_velocities();
+
+  //! Nodes, in the order of the dense nodal arrays
+  std::vector<NodeBase<Tdim>*> nodes_;
+  //! Position of each node (by id) in the dense nodal arrays
+  tsl::robin_map<mpm::Index, mpm::Index> node_index_;
+  //! Nodal velocities (nnodes x Tdim)
+  std::vector<double> velocity_;
+  //! Nodal mass accumulated by the transfer
+  std::vector<double> mass_;
+  //! Nodal momentum accumulated by the transfer (nnodes x Tdim)
+  std::vector<double> momentum_;
+  //! Particle in each row
+  std::vector<ParticleBase<Tdim>*> particles_;
+  //! Cell of each row when its connectivity was built
+  std::vector<mpm::Index> cells_;
+  //! Number of nodes of each row, zero if not computed in batch
+  std::vector<unsigned> nrow_nodes_;
+  //! Node indices of each row (nparticles x stride)
+  std::vector<mpm::Index> node_ids_;
+  //! Leading dimension of a row
+  unsigned stride_{0};
+  //! Colour of each cell (by id)
+  tsl::robin_map<mpm::Index, unsigned> cell_colours_;
+  //! Number of cell colours
+  unsigned ncolours_{0};
+  //! Rows grouped by colour, then by cell
+  std::vector<mpm::Index> colour_rows_;
+  //! Start of each cell group in colour_rows_
+  std::vector<mpm::Index> cell_groups_;
+  //! Start of each colour in cell_groups_
+  std::vector<mpm::Index> colour_groups_;
+  //! Rows that are not in a colour group
+  std::vector<mpm::Index> other_rows_;
+  //! Colour groups follow the rows
+  bool colour_groups_current_{false};
+};  // ParticleSoA class
+}  // namespace mpm
+
+#include "particle_soa.tcc"
+
+#endif  // MPM_PARTICLE_SOA_H_
@@ -0,0 +1,308 @@
+//! Assign the nodes of the dense nodal arrays
+template <unsigned Tdim>
+void mpm::ParticleSoA<Tdim>::assign_nodes(
+    const Vector<NodeBase<Tdim>>& nodes) {
+  nodes_.clear();
+  node_index_.clear();
+  for (auto nitr = nodes.cbegin(); nitr != nodes.cend(); ++nitr) {
+    node_index_.insert({(*nitr)->id(), nodes_.size()});
+    nodes_.emplace_back(nitr->get());
+  }
+  velocity_.assign(nodes_.size() * Tdim, 0.);
+  mass_.assign(nodes_.size(), 0.);
+  momentum_.assign(nodes_.size() * Tdim, 0.);
+
+  // Node indices are no longer valid
+  this->clear();
+}
+
+//! Colour the cells so that cells of a colour share no node
+template <unsigned Tdim>
+void mpm::ParticleSoA<Tdim>::assign_cells(const Vector<Cell<Tdim>>& cells) {
+  // Nodes of each cell
+  std::vector<std::shared_ptr<Cell<Tdim>>> cell_list;
+  std::vector<std::vector<mpm::Index>> cell_nodes;
+  for (auto citr = cells.cbegin(); citr != cells.cend(); ++citr) {
+    cell_nodes.emplace_back();
+    for (const auto& node : (*citr)->nodes())
+      cell_nodes.back().emplace_back(node->id());
+    cell_list.emplace_back(*citr);
+  }
+
+  std::vector<unsigned> colours;
+  ncolours_ = mpm::greedy_colouring(cell_nodes, colours);
+
+  cell_colours_.clear();
+  for (unsigned c = 0; c < cell_list.size(); ++c)
+    cell_colours_.insert({cell_list[c]->id(), colours[c]});
+
+  // Connectivity may refer to the previous cells
+  this->clear();
+}
+
+//! Clear the connectivity
+template <unsigned Tdim>
+void mpm::ParticleSoA<Tdim>::clear() {
+  particles_.clear();
+  cells_.clear();
+  nrow_nodes_.clear();
+  node_ids_.clear();
+  colour_groups_current_ = false;
+}
+
+//! Follow the particles, rebuilding the rows that changed
+template <unsigned Tdim>
+void mpm::ParticleSoA<Tdim>::update_rows(
+    const Vector<ParticleBase<Tdim>>& particles) {
+  // Rows follow the order of the particles; a row whose particle changed
+  // is rebuilt
+  const mpm::Index nparticles = particles.size();
+  if (particles_.size() != nparticles) {
+    particles_.assign(nparticles, nullptr);
+    cells_.assign(nparticles, std::numeric_limits<mpm::Index>::max());
+    nrow_nodes_.assign(nparticles, 0);
+    node_ids_.resize(nparticles * stride_);
+  }
+  mpm::Index row = 0;
+  for (auto pitr = particles.cbegin(); pitr != particles.cend();
+       ++pitr, ++row) {
+    if (particles_[row] == pitr->get()) continue;
+    particles_[row] = pitr->get();
+    cells_[row] = std::numeric_limits<mpm::Index>::max();
+  }
+
+  // Widen the rows when a cell has more nodes than fit
+  const unsigned nmax = this->update_connectivity();
+  if (nmax > stride_) {
+    stride_ = nmax;
+    cells_.assign(nparticles, std::numeric_limits<mpm::Index>::max());
+    node_ids_.assign(nparticles * stride_, 0);
+    this->update_connectivity();
+  }
+}
+
+//! Rebuild the rows whose particle or cell has changed
+template <unsigned Tdim>
+unsigned mpm::ParticleSoA<Tdim>::update_connectivity() {
+  const long nparticles = particles_.size();
+  unsigned nmax = 0;
+  bool changed = false;
+#pragma omp parallel for schedule(runtime) reduction(max : nmax) \
+    reduction(|| : changed)
+  for (long p = 0; p < nparticles; ++p) {
+    const auto particle = particles_[p];
+    if (cells_[p] == particle->cell_id()) continue;
+
+    changed = true;
+    cells_[p] = particle->cell_id();
+    nrow_nodes_[p] = 0;
+
+    const auto& nodes = particle->nodes();
+    if (nodes.size() > stride_) {
+      nmax = std::max(nmax, static_cast<unsigned>(nodes.size()));
+      cells_[p] = std::numeric_limits<mpm::Index>::max();
+      continue;
+    }
+
+    // Rows with a node unknown to the kernel are computed by the particle
+    bool status = !nodes.empty();
+    for (unsigned n = 0; n < nodes.size() && status; ++n) {
+      const auto itr = node_index_.find(nodes[n]->id());
+      if (itr == node_index_.end())
+        status = false;
+      else
+        node_ids_[p * stride_ + n] = itr->second;
+    }
+    if (status) nrow_nodes_[p] = nodes.size();
+  }
+  if (changed) colour_groups_current_ = false;
+  return nmax;
+}
+
+//! Group the rows by colour and cell
+template <unsigned Tdim>
+void mpm::ParticleSoA<Tdim>::update_colour_groups() {
+  const mpm::Index nrows = particles_.size();
+  const unsigned uncoloured = std::numeric_limits<unsigned>::max();
+
+  // Colour of each row
+  std::vector<unsigned> row_colours(nrows, uncoloured);
+  colour_rows_.clear();
+  other_rows_.clear();
+  for (mpm::Index p = 0; p < nrows; ++p) {
+    const auto itr = cell_colours_.find(cells_[p]);
+    if (nrow_nodes_[p] > 0 && itr != cell_colours_.end()) {
+      row_colours[p] = itr->second;
+      colour_rows_.emplace_back(p);
+    } else
+      other_rows_.emplace_back(p);
+  }
+  std::stable_sort(colour_rows_.begin(), colour_rows_.end(),
+                   [&](mpm::Index a, mpm::Index b) {
+                     return (row_colours[a] != row_colours[b])
+                                ? row_colours[a] < row_colours[b]
+                                : cells_[a] < cells_[b];
+                   });
+
+  // Ranges of cells, and of colours over the cells
+  cell_groups_.clear();
+  colour_groups_.clear();
+  for (mpm::Index i = 0; i < colour_rows_.size(); ++i) {
+    const mpm::Index p = colour_rows_[i];
+    const bool new_colour =
+        (i == 0 || row_colours[colour_rows_[i - 1]] != row_colours[p]);
+    if (new_colour) colour_groups_.emplace_back(cell_groups_.size());
+    if (new_colour || cells_[colour_rows_[i - 1]] != cells_[p])
+      cell_groups_.emplace_back(i);
+  }
+  cell_groups_.emplace_back(colour_rows_.size());
+  colour_groups_.emplace_back(cell_groups_.size() - 1);
+
+  colour_groups_current_ = true;
+}
+
+//! Gather the nodal velocities into a dense array
+template <unsigned Tdim>
+void mpm::ParticleSoA<Tdim>::gather_velocities() {
+  const long nnodes = nodes_.size();
+#pragma omp parallel for schedule(runtime)
+  for (long n = 0; n < nnodes; ++n) {
+    const Eigen::Matrix<double, Tdim, 1> velocity =
+        nodes_[n]->velocity(mpm::ParticlePhase::Solid);
+    for (unsigned i = 0; i < Tdim; ++i) velocity_[n * Tdim + i] = velocity(i);
+  }
+}
+
+//! Compute strain of the particles
+template <unsigned Tdim>
+void mpm::ParticleSoA<Tdim>::compute_strain(
+    const Vector<ParticleBase<Tdim>>& particles, double dt) {
+  this->update_rows(particles);
+  this->gather_velocities();
+
+  const long nrows = particles_.size();
+  const unsigned stride = stride_;
+#pragma omp parallel
+  {
+    // Shape function gradients of the current particle, component-major
+    std::vector<double> dn_dx(Tdim * stride), dn_dx_centroid(Tdim * stride);
+
+#pragma omp for schedule(runtime)
+    for (long p = 0; p < nrows; ++p) {
+      const auto particle = particles_[p];
+      const unsigned nnodes = nrow_nodes_[p];
+      if (nnodes == 0 || !particle->strain_gradients(stride, dn_dx.data(),
+                                                     dn_dx_centroid.data())) {
+        particle->compute_strain(dt);
+        continue;
+      }
+
+      const mpm::Index* ids = &node_ids_[p * stride];
+
+      // Velocity gradient at the particle, grad(i, j) = dv_i/dx_j
+      Eigen::Matrix<double, Tdim, Tdim> grad;
+      for (unsigned i = 0; i < Tdim; ++i)
+        for (unsigned j = 0; j < Tdim; ++j) {
+          const double* dn = &dn_dx[j * stride];
+          double sum = 0.;
+#pragma omp simd reduction(+ : sum)
+          for (unsigned n = 0; n < nnodes; ++n)
+            sum += dn[n] * velocity_[ids[n] * Tdim + i];
+          grad(i, j) = sum;
+        }
+
+      // Volumetric strain rate at the cell centroid
+      double dvolumetric_strain = 0.;
+      for (unsigned i = 0; i < Tdim; ++i) {
+        const double* dn = &dn_dx_centroid[i * stride];
+        double sum = 0.;
+#pragma omp simd reduction(+ : sum)
+        for (unsigned n = 0; n < nnodes; ++n)
+          sum += dn[n] * velocity_[ids[n] * Tdim + i];
+        if (std::fabs(sum) >= 1.E-15) dvolumetric_strain += sum;
+      }
+
+      // Engineering strain rate in Voigt notation
+      const Eigen::Matrix<double, Tdim, Tdim> rate = grad + grad.transpose();
+      Eigen::Matrix<double, 6, 1> strain_rate =
+          mpm::math::voigt_form<Tdim>(rate);
+      strain_rate.head(Tdim) *= 0.5;
+      for (unsigned i = 0; i < strain_rate.size(); ++i)
+        if (std::fabs(strain_rate[i]) < 1.E-15) strain_rate[i] = 0.;
+
+      particle->assign_strain_rate(strain_rate, dt * dvolumetric_strain, dt);
+    }
+  }
+}
+
+//! Map mass and momentum of the particles to the nodes
+template <unsigned Tdim>
+void mpm::ParticleSoA<Tdim>::map_mass_momentum_to_nodes(
+    const Vector<ParticleBase<Tdim>>& particles,
+    mpm::VelocityUpdate velocity_update) {
+  this->update_rows(particles);
+  if (!colour_groups_current_) this->update_colour_groups();
+
+  std::fill(mass_.begin(), mass_.end(), 0.);
+  std::fill(momentum_.begin(), momentum_.end(), 0.);
+
+  const unsigned stride = stride_;
+  // Particles mapped through the node locks
+  std::vector<char> locked(particles_.size(), 0);
+
+#pragma omp parallel
+  {
+    // Nodal contributions of the current particle
+    std::vector<double> mass(stride), momentum(stride * Tdim);
+
+    // Cells of a colour share no node, so each node is written by one
+    // thread at a time
+    for (unsigned colour = 0; colour + 1 < colour_groups_.size(); ++colour) {
+      const long begin = colour_groups_[colour];
+      const long end = colour_groups_[colour + 1];
+#pragma omp for schedule(runtime)
+      for (long group = begin; group < end; ++group) {
+        for (mpm::Index i = cell_groups_[group]; i < cell_groups_[group + 1];
+             ++i) {
+          const mpm::Index p = colour_rows_[i];
+          const auto particle = particles_[p];
+          if (!particle->mass_momentum_weights(velocity_update, mass.data(),
+                                               momentum.data())) {
+            locked[p] = 1;
+            continue;
+          }
+
+          const unsigned nnodes = nrow_nodes_[p];
+          const mpm::Index* ids = &node_ids_[p * stride];
+          for (unsigned n = 0; n < nnodes; ++n) {
+            mass_[ids[n]] += mass[n];
+            for (unsigned j = 0; j < Tdim; ++j)
+              momentum_[ids[n] * Tdim + j] += momentum[n * Tdim + j];
+          }
+        }
+      }
+    }
+  }
+
+  // Add the sums to the nodes; each node is updated by a single thread
+  const long nnodes = nodes_.size();
+#pragma omp parallel for schedule(runtime)
+  for (long n = 0; n < nnodes; ++n) {
+    const Eigen::Map<const Eigen::Matrix<double, Tdim, 1>> momentum(
+        &momentum_[n * Tdim]);
+    if (mass_[n] == 0. && momentum.isZero(0.)) continue;
+    nodes_[n]->update_mass(true, mpm::ParticlePhase::Solid, mass_[n]);
+    nodes_[n]->update_momentum(true, mpm::ParticlePhase::Solid, momentum);
+  }
+
+  // Remaining particles map through the node locks
+  const long nother = other_rows_.size();
+#pragma omp parallel for schedule(runtime)
+  for (long i = 0; i < nother; ++i)
+    particles_[other_rows_[i]]->map_mass_momentum_to_nodes(velocity_update);
+
+  const long nrows = particles_.size();
+#pragma omp parallel for schedule(runtime)
+  for (long p = 0; p < nrows; ++p)
+    if (locked[p]) particles_[p]->map_mass_momentum_to_nodes(velocity_update);
+}
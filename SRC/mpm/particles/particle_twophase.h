@@ -75,6 +75,13 @@ class TwoPhaseParticle : public mpm::Particle<Tdim> {
       mpm::VelocityUpdate velocity_update =
           mpm::VelocityUpdate::FLIP) noexcept override;
 
+  //! Both phases are mapped through map_mass_momentum_to_nodes
+  bool mass_momentum_weights(mpm::VelocityUpdate velocity_update,
+                             double* mass,
+                             double* momentum) const noexcept override {
+    return false;
+  }
+
   //! Map body force
   //! \param[in] pgravity Gravity of a particle
   void map_body_force(const VectorDim& pgravity) noexcept override;
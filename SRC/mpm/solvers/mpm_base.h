@@ -290,6 +290,8 @@ class MPMBase : public MPM {
   double damping_factor_{0.};
   //! Locate particles
   bool locate_particles_{true};
+  //! Number of steps between sorting particles in cell order (0: never)
+  mpm::Index nsort_particles_steps_{0};
   //! Absorbing Boundary Variables
   bool absorbing_boundary_{false};
   //! Boolean to update deformation gradient
@@ -51,6 +51,27 @@ mpm::MPMBase<Tdim>::MPMBase(const std::shared_ptr<IO>& io) : mpm::MPM(io) {
     if (analysis_.find("locate_particles") != analysis_.end())
       locate_particles_ = analysis_["locate_particles"].template get<bool>();
 
+    // Sort particles in cell order
+    if (analysis_.find("nsort_particles_steps") != analysis_.end())
+      nsort_particles_steps_ =
+          analysis_["nsort_particles_steps"].template get<mpm::Index>();
+
+    // Structure-of-arrays strain kernel
+    if (analysis_.find("particle_soa") != analysis_.end())
+      mesh_->use_particle_soa(analysis_["particle_soa"].template get<bool>());
+
+    // Particle-to-grid transfer (lock/colour)
+    if (analysis_.find("p2g_transfer") != analysis_.end()) {
+      const std::string transfer =
+          analysis_["p2g_transfer"].template get<std::string>();
+      if (transfer == "colour")
+        mesh_->use_coloured_transfer(true);
+      else if (transfer != "lock")
+        console_->warn(
+            "{} #{}: P2G transfer \'{}\' is not supported, using \'lock\'",
+            __FILE__, __LINE__, transfer);
+    }
+
     // Stress rate method (None/Jaumann)
     try {
       if (analysis_.find("stress_rate") != analysis_.end()) {
@@ -75,6 +75,8 @@ class MPMExplicit : public MPMBase<Tdim> {
   using mpm::MPMBase<Tdim>::damping_factor_;
   //! Locate particles
   using mpm::MPMBase<Tdim>::locate_particles_;
+  //! Sort particles
+  using mpm::MPMBase<Tdim>::nsort_particles_steps_;
   //! Constraints Pointer
   using mpm::MPMBase<Tdim>::constraints_;
   //! Absorbing Boundary
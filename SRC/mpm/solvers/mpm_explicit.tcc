@@ -107,6 +107,9 @@ bool mpm::MPMExplicit<Tdim>::solve() {
   // Write initial outputs
   if (!resume) this->write_outputs(this->step_);
 
+  // Order particles by cell
+  if (nsort_particles_steps_ > 0) mesh_->sort_particles();
+
   auto solver_begin = std::chrono::steady_clock::now();
   // Main loop
   for (; step_ < nsteps_; ++step_) {
@@ -165,6 +168,10 @@ bool mpm::MPMExplicit<Tdim>::solve() {
     // Locate particles
     mpm_scheme_->locate_particles(this->locate_particles_);
 
+    // Restore cell order of the particles
+    if (nsort_particles_steps_ > 0 && (step_ + 1) % nsort_particles_steps_ == 0)
+      mesh_->sort_particles();
+
 #ifdef USE_MPI
 #ifdef USE_GRAPH_PARTITIONING
     mesh_->transfer_halo_particles();
@@ -44,9 +44,7 @@ template <unsigned Tdim>
 inline void mpm::MPMScheme<Tdim>::compute_nodal_kinematics(
     mpm::VelocityUpdate velocity_update, unsigned phase) {
   // Assign mass and momentum to nodes
-  mesh_->iterate_over_particles(
-      std::bind(&mpm::ParticleBase<Tdim>::map_mass_momentum_to_nodes,
-                std::placeholders::_1, velocity_update));
+  mesh_->map_particles_mass_momentum(velocity_update);
 
 #ifdef USE_MPI
   // Run if there is more than a single MPI task
@@ -76,8 +74,7 @@ inline void mpm::MPMScheme<Tdim>::compute_stress_strain(
     unsigned phase, bool pressure_smoothing, mpm::StressRate stress_rate) {
 
   // Iterate over each particle to calculate strain
-  mesh_->iterate_over_particles(std::bind(
-      &mpm::ParticleBase<Tdim>::compute_strain, std::placeholders::_1, dt_));
+  mesh_->compute_particles_strain(dt_);
 
   // Iterate over each particle to update particle volume
   mesh_->iterate_over_particles(std::bind(
@@ -0,0 +1,28 @@
+#ifndef MPM_COLOURING_H_
+#define MPM_COLOURING_H_
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <unordered_map>
+
+#include "data_types.h"
+
+namespace mpm {
+//! Colour items that share nodes, such as cells, so that no two items of a
+//! colour share a node
+//! \details Greedy colouring in the order of the items: each item takes the
+//! smallest colour that none of its neighbours has taken. A structured
+//! quadrilateral/hexahedral grid gets 4/8 colours.
+//! \param[in] item_nodes Node ids of each item
+//! \param[out] colours Colour of each item
+//! \retval ncolours Number of colours
+inline unsigned greedy_colouring(
+    const std::vector<std::vector<mpm::Index>>& item_nodes,
+    std::vector<unsigned>& colours);
+}  // namespace mpm
+
+#include "colouring.tcc"
+
+#endif  // MPM_COLOURING_H_
@@ -0,0 +1,30 @@
+//! Colour items that share nodes so that no two items of a colour share a node
+inline unsigned mpm::greedy_colouring(
+    const std::vector<std::vector<mpm::Index>>& item_nodes,
+    std::vector<unsigned>& colours) {
+  // Items connected to each node
+  std::unordered_map<mpm::Index, std::vector<unsigned>> node_items;
+  for (unsigned c = 0; c < item_nodes.size(); ++c)
+    for (const auto node : item_nodes[c]) node_items[node].emplace_back(c);
+
+  // The smallest colour no neighbour has taken
+  const unsigned uncoloured = std::numeric_limits<unsigned>::max();
+  colours.assign(item_nodes.size(), uncoloured);
+  std::vector<unsigned> taken;
+  unsigned ncolours = 0;
+  for (unsigned c = 0; c < item_nodes.size(); ++c) {
+    for (const auto node : item_nodes[c])
+      for (const unsigned neighbour : node_items[node])
+        if (colours[neighbour] != uncoloured) {
+          if (colours[neighbour] >= taken.size())
+            taken.resize(colours[neighbour] + 1, uncoloured);
+          taken[colours[neighbour]] = c;
+        }
+
+    unsigned colour = 0;
+    while (colour < taken.size() && taken[colour] == c) ++colour;
+    colours[c] = colour;
+    ncolours = std::max(ncolours, colour + 1);
+  }
+  return ncolours;
+}
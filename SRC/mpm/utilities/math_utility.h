@@ -1,7 +1,9 @@
 #ifndef MPM_MATH_UTILITY_H_
 #define MPM_MATH_UTILITY_H_
 
+#include <array>
 #include <cmath>
+#include <cstdint>
 
 #include "data_types.h"
 
@@ -61,6 +63,15 @@ inline const Eigen::Matrix<double, 3, 1> principal_tensor(
     const Eigen::Matrix<double, 6, 1>& voigt_tensor,
     Eigen::Matrix<double, 3, 3>& directors);
 
+//! Compute the Morton (Z-order) code of a point on an integer grid
+//! \details Interleaves the bits of the grid coordinates, so points close in
+//! space are mostly close in the ordering. Uses the low 64/Tdim bits of each
+//! coordinate (all 32 bits in 1D).
+//! \param[in] index Grid coordinates of the point
+//! \retval code Morton code
+template <unsigned Tdim>
+inline std::uint64_t morton_code(const std::array<std::uint32_t, Tdim>& index);
+
 }  // namespace math
 }  // namespace mpm
 
@@ -134,4 +134,17 @@ inline const Eigen::Matrix<double, 3, 1> mpm::math::principal_tensor(
   const auto& principal_tensor =
       mpm::math::principal_tensor(matrix_tensor, directors);
   return principal_tensor;
-}
\ No newline at end of file
+}
+
+//! Compute the Morton (Z-order) code of a point on an integer grid
+template <unsigned Tdim>
+inline std::uint64_t mpm::math::morton_code(
+    const std::array<std::uint32_t, Tdim>& index) {
+  const unsigned nbits = (Tdim == 1) ? 32 : 64 / Tdim;
+  std::uint64_t code = 0;
+  for (unsigned bit = 0; bit < nbits; ++bit)
+    for (unsigned i = 0; i < Tdim; ++i)
+      code |= static_cast<std::uint64_t>((index[i] >> bit) & 1u)
+              << (bit * Tdim + i);
+  return code;
+}
@@ -35,6 +35,7 @@
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <Logging.h>
+#include <Profiler.h>
 
 DriftRecorder::DriftRecorder()
   :Recorder(RECORDER_TAGS_DriftRecorder),
@@ -117,6 +118,7 @@ DriftRecorder::~DriftRecorder()
 int 
 DriftRecorder::record(int commitTag, double timeStamp)
 {
+  Profiler::ClassScope scope("DriftRecorder");
 
   if (theDomain == 0 || ndI == 0 || ndJ == 0) {
     return 0;
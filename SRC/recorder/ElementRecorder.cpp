@@ -53,6 +53,7 @@
 #include <elementAPI.h>
 
 #include <string.h>
+#include <Profiler.h>
 
 void *
 OPS_ADD_RUNTIME_VPV(OPS_ElementRecorder)
@@ -397,6 +398,7 @@ ElementRecorder::~ElementRecorder()
 int 
 ElementRecorder::record(int commitTag, double timeStamp)
 {
+  Profiler::ClassScope scope("ElementRecorder");
   // 
   // check that initialization has been done
   //
@@ -53,6 +53,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
+#include <Profiler.h>
 
 void *
 OPS_ADD_RUNTIME_VPV(OPS_EnvelopeElementRecorder)
@@ -417,6 +418,7 @@ EnvelopeElementRecorder::~EnvelopeElementRecorder()
 int 
 EnvelopeElementRecorder::record(int commitTag, double timeStamp)
 {
+  Profiler::ClassScope scope("EnvelopeElementRecorder");
   // 
   // check that initialization has been done
   //
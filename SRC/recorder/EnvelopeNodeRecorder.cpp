@@ -53,6 +53,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
+#include <Profiler.h>
 #if 0
 #include <elementAPI.h>
 void *
@@ -441,6 +442,7 @@ EnvelopeNodeRecorder::~EnvelopeNodeRecorder()
 int 
 EnvelopeNodeRecorder::record(int commitTag, double timeStamp)
 {
+  Profiler::ClassScope scope("EnvelopeNodeRecorder");
   if (theDomain == 0 || theDofs == 0) {
     return 0;
   }
@@ -50,6 +50,7 @@
 #include <string.h>
 #include <assert.h>
 #include <math.h>
+#include <Profiler.h>
 
 NodeRecorder::NodeRecorder()
 : Recorder(RECORDER_TAGS_NodeRecorder),
@@ -179,6 +180,7 @@ NodeRecorder::~NodeRecorder()
 int
 NodeRecorder::record(int commitTag, double timeStamp)
 {
+  Profiler::ClassScope scope("NodeRecorder");
   if (theDomain == nullptr || theDofs == nullptr)
     return 0;
 
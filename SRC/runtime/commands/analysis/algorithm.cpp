@@ -22,6 +22,7 @@
 #include <Linear.h>
 #include <NewtonRaphson.h>
 #include <ModifiedNewton.h>
+#include <AdaptiveNewton.h>
 #include <NewtonHallM.h>
 #include <Broyden.h>
 #include <BFGS.h>
@@ -70,6 +71,7 @@ static Tcl_CmdProc TclCommand_newKrylovNewton;
 Tcl_CmdProc TclCommand_newLinearAlgorithm;
 Tcl_CmdProc TclCommand_newNewtonRaphson;
 Tcl_CmdProc TclCommand_newModifiedNewton;
+Tcl_CmdProc TclCommand_newAdaptiveNewton;
 Tcl_CmdProc TclCommand_newNewtonHallM;
 
 namespace  OpenSees {
@@ -78,6 +80,7 @@ std::unordered_map<std::string, Tcl_CmdProc*> Algorithms {
   {"Newton",         TclCommand_newNewtonRaphson},
   {"NewtonHall",     TclCommand_newNewtonHallM},
   {"ModifiedNewton", TclCommand_newModifiedNewton},
+  {"AdaptiveNewton", TclCommand_newAdaptiveNewton},
   {"KrylovNewton",   TclCommand_newKrylovNewton}
 };
 }
@@ -301,6 +304,41 @@ TclCommand_newModifiedNewton(ClientData clientData, Tcl_Interp* interp, int argc
   return TCL_OK;
 }
 
+//
+// algorithm AdaptiveNewton <-maxRate $rate> <-maxStepIter $n>
+//
+int
+TclCommand_newAdaptiveNewton(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char**const argv)
+{
+  BasicAnalysisBuilder *builder = (BasicAnalysisBuilder *)clientData;
+  assert(builder != nullptr);
+
+  double maxRate = 0.5;
+  int maxStepIter = 4;
+
+  for (int i=2; i<argc; i++) {
+    if (strcmp(argv[i], "-maxRate") == 0) {
+      if (++i >= argc || Tcl_GetDouble(interp, argv[i], &maxRate) != TCL_OK || maxRate < 0.0) {
+        opserr << G3_ERROR_PROMPT << "-maxRate expects a non-negative number\n";
+        return TCL_ERROR;
+      }
+
+    } else if (strcmp(argv[i], "-maxStepIter") == 0) {
+      if (++i >= argc || Tcl_GetInt(interp, argv[i], &maxStepIter) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "-maxStepIter expects an integer\n";
+        return TCL_ERROR;
+      }
+
+    } else {
+      opserr << G3_ERROR_PROMPT << "unknown option '" << argv[i] << "' for AdaptiveNewton\n";
+      return TCL_ERROR;
+    }
+  }
+
+  builder->set(new AdaptiveNewton(maxRate, maxStepIter));
+  return TCL_OK;
+}
+
 int
 TclCommand_newNewtonHallM(ClientData clientData, Tcl_Interp* interp, int argc, TCL_Char**const argv)
 {
@@ -9,6 +9,7 @@
 //
 #include <tcl.h>
 #include <assert.h>
+#include <vector>
 #include <runtimeAPI.h>
 #include <G3_Logging.h>
 #include <StandardStream.h>
@@ -77,6 +78,13 @@ G3_AddTclAnalysisAPI(Tcl_Interp *interp, Domain* domain)
         tcl_analysis_cmds[i].func, 
         (ClientData) builder, nullptr);
 
+  static int nobj = sizeof(tcl_analysis_obj_cmds)/sizeof(obj_cmd);
+  for (int i = 0; i < nobj; ++i)
+    Tcl_CreateObjCommand(interp, 
+        tcl_analysis_obj_cmds[i].name, 
+        tcl_analysis_obj_cmds[i].func, 
+        (ClientData) builder, nullptr);
+
   return TCL_OK;
 }
 
@@ -723,6 +731,56 @@ printB(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const ar
   return res;
 }
 
+//
+// equationNodes eqn? ...
+//
+// Return the node and dof (from 1) of each equation, from the numbering of
+// the last analysis, as a flat list {node dof node dof ...}. Equations may
+// be given as separate arguments or as lists, and those that do not belong
+// to a node give {-1 -1}.
+//
+static int
+equationNodes(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj *const *objv)
+{
+  assert(clientData != nullptr);
+  BasicAnalysisBuilder *builder = (BasicAnalysisBuilder*)clientData;
+
+  const std::vector<BasicAnalysisBuilder::NodeDOF> &map = builder->getEquationMap();
+
+  Tcl_Obj *result = Tcl_NewListObj(0, nullptr);
+  for (int i = 1; i < objc; i++) {
+    int numEqn;
+    Tcl_Obj **eqns;
+    if (Tcl_ListObjGetElements(interp, objv[i], &numEqn, &eqns) != TCL_OK) {
+      Tcl_DecrRefCount(result);
+      return TCL_ERROR;
+    }
+
+    for (int j = 0; j < numEqn; j++) {
+      int eqn;
+      if (Tcl_GetIntFromObj(interp, eqns[j], &eqn) != TCL_OK) {
+        opserr << OpenSees::PromptValueError 
+               << "could not read equation number " << Tcl_GetString(eqns[j]) << "\n";
+        Tcl_DecrRefCount(result);
+        return TCL_ERROR;
+      }
+      if (eqn < 0 || eqn >= (int)map.size()) {
+        opserr << OpenSees::PromptValueError 
+               << "equation " << eqn << " out of range\n";
+        Tcl_DecrRefCount(result);
+        return TCL_ERROR;
+      }
+
+      const BasicAnalysisBuilder::NodeDOF &entry = map[eqn];
+      Tcl_ListObjAppendElement(interp, result, Tcl_NewIntObj(entry.node));
+      Tcl_ListObjAppendElement(interp, result, Tcl_NewIntObj(entry.node == -1 ? -1 : entry.dof + 1));
+    }
+  }
+
+  Tcl_SetObjResult(interp, result);
+  return TCL_OK;
+}
+
 // This is removed from the Tcl_Interp in model.cpp
 extern int
 TclCommand_clearAnalysis(ClientData cd, Tcl_Interp *interp, int argc, TCL_Char ** const argv)
@@ -737,6 +795,10 @@ TclCommand_clearAnalysis(ClientData cd, Tcl_Interp *interp, int argc, TCL_Char *
     for (int i = 0; i < ncmd; ++i)
       Tcl_DeleteCommand(interp, tcl_analysis_cmds[i].name);
 
+    static int nobj = sizeof(tcl_analysis_obj_cmds)/sizeof(obj_cmd);
+    for (int i = 0; i < nobj; ++i)
+      Tcl_DeleteCommand(interp, tcl_analysis_obj_cmds[i].name);
+
     Tcl_CreateCommand(interp, "wipeAnalysis",  &wipeAnalysis, nullptr, nullptr);
     Tcl_CreateCommand(interp, "_clearAnalysis", &TclCommand_clearAnalysis, nullptr, nullptr);
   }
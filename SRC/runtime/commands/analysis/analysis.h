@@ -17,6 +17,7 @@ static Tcl_CmdProc modalProperties;
 static Tcl_CmdProc responseSpectrum;
 static Tcl_CmdProc printA;
 static Tcl_CmdProc printB;
+static Tcl_ObjCmdProc equationNodes;
 static Tcl_CmdProc initializeAnalysis;
 static Tcl_CmdProc resetModel;
 static Tcl_CmdProc analyzeModel;
@@ -30,6 +31,7 @@ extern Tcl_CmdProc specifyIntegrator;
 extern Tcl_CmdProc specifySOE;
 extern Tcl_CmdProc specifySysOfEqnTable;
 extern Tcl_CmdProc TclCommand_systemSize;
+extern Tcl_CmdProc TclCommand_systemStats;
 
 // commands/analysis/algorithm.cpp
 extern Tcl_CmdProc TclCommand_specifyAlgorithm;
@@ -55,6 +57,7 @@ struct char_cmd {
 } const tcl_analysis_cmds[] =  {
     {"system",              &specifySysOfEqnTable},
     {"systemSize",          &TclCommand_systemSize},
+    {"systemStats",         &TclCommand_systemStats},
 
     {"test",                &specifyCTest},
     {"testIter",            &getCTestIter},
@@ -90,3 +93,9 @@ struct char_cmd {
     {"sensLambda",           TclCommand_sensLambda},
 };
 
+struct obj_cmd {
+  const char* name;
+  Tcl_ObjCmdProc*  func;
+} const tcl_analysis_obj_cmds[] =  {
+    {"equationNodes",       &equationNodes},
+};
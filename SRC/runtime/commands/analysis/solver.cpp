@@ -32,6 +32,8 @@
 #include <SparseGenRowLinSOE.h>
 #include <SymSparseLinSOE.h>
 #include <SymSparseLinSolver.h>
+#include <KrylovSolver.h>
+#include <MatrixFreeLinSOE.h>
 
 #ifdef _CUDA
 #  include <BandGenLinSOE_Single.h>
@@ -108,6 +110,27 @@ specifySysOfEqnTable(ClientData clientData, Tcl_Interp *interp, int argc, G3_Cha
   if (theSOE == nullptr)
     return TCL_ERROR;
 
+  // Threaded assembly, for the systems that accept concurrent calls
+  // to addA; the MatrixFree system parses -threads itself
+  if (dynamic_cast<MatrixFreeLinSOE*>(theSOE) == nullptr) {
+    for (int i=2; i<argc; i++) {
+      if (strcmp(argv[i], "-threads") == 0) {
+        int numThreads;
+        if (i+1 == argc || Tcl_GetInt(interp, argv[i+1], &numThreads) != TCL_OK) {
+          opserr << G3_ERROR_PROMPT << "-threads requires an integer number of threads\n";
+          delete theSOE;
+          return TCL_ERROR;
+        }
+        if (theSOE->setNumThreads(numThreads) < 0) {
+          opserr << G3_ERROR_PROMPT << "system " << argv[1] << " does not support -threads\n";
+          delete theSOE;
+          return TCL_ERROR;
+        }
+        i++;
+      }
+    }
+  }
+
   BasicAnalysisBuilder* builder = (BasicAnalysisBuilder*)clientData;
 
   builder->set(theSOE);
@@ -134,21 +157,6 @@ G3Parse_newLinearSOE(ClientData clientData, Tcl_Interp* interp, int argc, G3_Cha
     // TODO: if "umfpack" is in solver.hpp, this wont be reached
     return TclDispatch_newUmfpackLinearSOE(clientData, interp, argc, argv);
   } 
-#if 0
-  else if (strcmp(argv[2],"Thread") == 0) {  
-      int blockSize = 4;
-      int numThreads = 1;
-      if (argc == 5) {
-	if (Tcl_GetInt(interp, argv[3], &blockSize) != TCL_OK)
-	  return nullptr; //TCL_ERROR;
-	if (Tcl_GetInt(interp, argv[4], &numThreads) != TCL_OK)
-	  return nullptr; //TCL_ERROR;
-      }
-      return new ProfileSPDLinSOE(
-          *new ProfileSPDLinDirectThreadSolver(numThreads,blockSize,1.0e-12)
-      );
-  } 
-#endif
 
 #if defined(OPS_PETSC)
   else if (strcmp(argv[1], "petsc")==0 ||
@@ -197,7 +205,7 @@ specify_SparseSPD(G3_Runtime *rt, int argc, G3_Char ** const argv)
     //   3 -- RCM
 
     int lSparse = 1;
-    if (argc == 3) {
+    if (argc >= 3 && argv[2][0] != '-') {
       if (Tcl_GetInt(interp, argv[2], &lSparse) != TCL_OK)
         return nullptr;
     }
@@ -206,6 +214,252 @@ specify_SparseSPD(G3_Runtime *rt, int argc, G3_Char ** const argv)
 }
 
 
+//
+// Parse -reorder $method, where method is one of none, RCM, Sloan or auto.
+// Returns the index of the last argument consumed, or -1 on error.
+//
+static int
+parseOrdering(int count, int argc, G3_Char ** const argv, EquationOrdering::Method &method)
+{
+  if (count+1 >= argc) {
+    opserr << G3_ERROR_PROMPT << "-reorder requires one of none, RCM, Sloan or auto\n";
+    return -1;
+  }
+  count++;
+  if (strcasecmp(argv[count], "none") == 0)
+    method = EquationOrdering::None;
+  else if (strcasecmp(argv[count], "RCM") == 0)
+    method = EquationOrdering::RCM;
+  else if (strcasecmp(argv[count], "Sloan") == 0)
+    method = EquationOrdering::Sloan;
+  else if (strcasecmp(argv[count], "auto") == 0)
+    method = EquationOrdering::Automatic;
+  else {
+    opserr << G3_ERROR_PROMPT << "unknown ordering '" << argv[count] << "'\n";
+    return -1;
+  }
+  return count;
+}
+
+
+LinearSOE*
+specify_ProfileSPD(G3_Runtime *rt, int argc, G3_Char ** const argv)
+{
+  // system ProfileSPD <-Thread <$numThreads>> <-blockSize $blockSize> <-reorder $method>
+  Tcl_Interp *interp = G3_getInterpreter(rt);
+
+  bool threaded = false;
+  int numThreads = 0;
+  int blockSize = 64;
+  EquationOrdering::Method ordering = EquationOrdering::Automatic;
+  int count = 2;
+  while (count < argc) {
+    if ((strcmp(argv[count], "-Thread") == 0) ||
+        (strcmp(argv[count], "-thread") == 0)) {
+      threaded = true;
+      // number of threads is optional
+      if (count+1 < argc && argv[count+1][0] != '-') {
+        count++;
+        if (Tcl_GetInt(interp, argv[count], &numThreads) != TCL_OK)
+          return nullptr;
+      }
+    } else if (strcmp(argv[count], "-blockSize") == 0) {
+      count++;
+      if (count >= argc || Tcl_GetInt(interp, argv[count], &blockSize) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "-blockSize requires an integer\n";
+        return nullptr;
+      }
+    } else if (strcmp(argv[count], "-reorder") == 0) {
+      if ((count = parseOrdering(count, argc, argv, ordering)) < 0)
+        return nullptr;
+    } else {
+      opserr << G3_ERROR_PROMPT << "unknown option '" << argv[count] << "' for system ProfileSPD\n";
+      return nullptr;
+    }
+    count++;
+  }
+
+  ProfileSPDLinSOE *theSOE;
+  if (threaded)
+    theSOE = new ProfileSPDLinSOE(
+        *new ProfileSPDLinDirectThreadSolver(numThreads, blockSize, 1.0e-12));
+  else
+    theSOE = new ProfileSPDLinSOE(*new ProfileSPDLinDirectSolver());
+
+  theSOE->setOrdering(ordering);
+  return theSOE;
+}
+
+
+LinearSOE*
+specify_BandSPD(G3_Runtime *rt, int argc, G3_Char ** const argv)
+{
+  // system BandSPD <-reorder $method>
+  EquationOrdering::Method ordering = EquationOrdering::Automatic;
+  for (int count = 2; count < argc; count++) {
+    if (strcmp(argv[count], "-reorder") == 0) {
+      if ((count = parseOrdering(count, argc, argv, ordering)) < 0)
+        return nullptr;
+    } else {
+      opserr << G3_ERROR_PROMPT << "unknown option '" << argv[count] << "' for system BandSPD\n";
+      return nullptr;
+    }
+  }
+
+  BandSPDLinSOE *theSOE = new BandSPDLinSOE(*new BandSPDLinLapackSolver());
+  theSOE->setOrdering(ordering);
+  return theSOE;
+}
+
+
+//
+// Parse the options shared by the Krylov and MatrixFree systems. The
+// matrix-free system only stores the diagonal blocks of A, so it is
+// limited to the preconditioners built from them.
+//
+static KrylovSolver *
+parseKrylovSolver(G3_Runtime *rt, int argc, G3_Char ** const argv, bool matrixFree, int &blockSize)
+{
+  Tcl_Interp *interp = G3_getInterpreter(rt);
+
+  KrylovSolver::Method method = KrylovSolver::CG;
+  KrylovSolver::Preconditioning pre = KrylovSolver::Jacobi;
+  double tol = 1.0e-8;
+  double rebuild = 0.1;
+  int maxIter = 1000;
+  int restart = 50;
+  blockSize = 1;
+
+  for (int count = 2; count < argc; count++) {
+    if (strcmp(argv[count], "-solver") == 0) {
+      if (++count >= argc) {
+        opserr << G3_ERROR_PROMPT << "-solver requires one of cg, minres, gmres or bicgstab\n";
+        return nullptr;
+      }
+      if (strcasecmp(argv[count], "cg") == 0 || strcasecmp(argv[count], "pcg") == 0)
+        method = KrylovSolver::CG;
+      else if (strcasecmp(argv[count], "minres") == 0)
+        method = KrylovSolver::MINRES;
+      else if (strcasecmp(argv[count], "gmres") == 0)
+        method = KrylovSolver::GMRES;
+      else if (strcasecmp(argv[count], "bicgstab") == 0)
+        method = KrylovSolver::BiCGStab;
+      else {
+        opserr << G3_ERROR_PROMPT << "unknown Krylov method '" << argv[count] << "'\n";
+        return nullptr;
+      }
+    } else if (strcmp(argv[count], "-pre") == 0) {
+      if (++count >= argc) {
+        opserr << G3_ERROR_PROMPT << "-pre requires one of none, jacobi, blockjacobi, ic0, ilu0 or amg\n";
+        return nullptr;
+      }
+      if (strcasecmp(argv[count], "none") == 0)
+        pre = KrylovSolver::None;
+      else if (strcasecmp(argv[count], "jacobi") == 0)
+        pre = KrylovSolver::Jacobi;
+      else if (strcasecmp(argv[count], "blockjacobi") == 0)
+        pre = KrylovSolver::BlockJacobi;
+      else if (strcasecmp(argv[count], "ic0") == 0)
+        pre = KrylovSolver::IC0;
+      else if (strcasecmp(argv[count], "ilu0") == 0)
+        pre = KrylovSolver::ILU0;
+      else if (strcasecmp(argv[count], "amg") == 0)
+        pre = KrylovSolver::AMG;
+      else {
+        opserr << G3_ERROR_PROMPT << "unknown preconditioner '" << argv[count] << "'\n";
+        return nullptr;
+      }
+      if (matrixFree && pre != KrylovSolver::None && pre != KrylovSolver::Jacobi
+                     && pre != KrylovSolver::BlockJacobi) {
+        opserr << G3_ERROR_PROMPT << "the matrix-free system only supports "
+               << "none, jacobi or blockjacobi preconditioners\n";
+        return nullptr;
+      }
+    } else if (strcmp(argv[count], "-tol") == 0) {
+      if (++count >= argc || Tcl_GetDouble(interp, argv[count], &tol) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "-tol requires a tolerance\n";
+        return nullptr;
+      }
+    } else if (strcmp(argv[count], "-maxIter") == 0) {
+      if (++count >= argc || Tcl_GetInt(interp, argv[count], &maxIter) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "-maxIter requires an integer\n";
+        return nullptr;
+      }
+    } else if (strcmp(argv[count], "-blockSize") == 0) {
+      if (++count >= argc || Tcl_GetInt(interp, argv[count], &blockSize) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "-blockSize requires an integer\n";
+        return nullptr;
+      }
+    } else if (strcmp(argv[count], "-restart") == 0) {
+      if (++count >= argc || Tcl_GetInt(interp, argv[count], &restart) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "-restart requires an integer\n";
+        return nullptr;
+      }
+    } else if (strcmp(argv[count], "-rebuild") == 0) {
+      if (++count >= argc || Tcl_GetDouble(interp, argv[count], &rebuild) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "-rebuild requires a tolerance\n";
+        return nullptr;
+      }
+    } else if (strcmp(argv[count], "-threads") == 0) {
+      // the number of threads is read by the caller
+      count++;
+    } else {
+      opserr << G3_ERROR_PROMPT << "unknown option '" << argv[count] << "' for system " << argv[1] << "\n";
+      return nullptr;
+    }
+  }
+
+  KrylovSolver *theSolver = new KrylovSolver(method, pre, tol, maxIter);
+  theSolver->setBlockSize(blockSize);
+  theSolver->setRestart(restart);
+  theSolver->setRebuildTolerance(rebuild);
+  return theSolver;
+}
+
+
+LinearSOE*
+specify_Krylov(G3_Runtime *rt, int argc, G3_Char ** const argv)
+{
+  // system Krylov <-solver $method> <-pre $preconditioner> <-tol $tol> <-maxIter $n>
+  //               <-blockSize $ndf> <-restart $m> <-rebuild $tol>
+  int blockSize;
+  KrylovSolver *theSolver = parseKrylovSolver(rt, argc, argv, false, blockSize);
+  if (theSolver == nullptr)
+    return nullptr;
+
+  return new SparseGenRowLinSOE(*theSolver);
+}
+
+
+LinearSOE*
+specify_MatrixFree(G3_Runtime *rt, int argc, G3_Char ** const argv)
+{
+  // system MatrixFree <-solver $method> <-pre none|jacobi|blockjacobi> <-tol $tol>
+  //                   <-maxIter $n> <-blockSize $ndf> <-restart $m> <-rebuild $tol>
+  //                   <-threads $n>
+  Tcl_Interp *interp = G3_getInterpreter(rt);
+
+  int numThreads = 1;
+  for (int count = 2; count < argc; count++) {
+    if (strcmp(argv[count], "-threads") == 0) {
+      if (++count >= argc || Tcl_GetInt(interp, argv[count], &numThreads) != TCL_OK) {
+        opserr << G3_ERROR_PROMPT << "-threads requires an integer number of threads\n";
+        return nullptr;
+      }
+    }
+  }
+
+  int blockSize;
+  KrylovSolver *theSolver = parseKrylovSolver(rt, argc, argv, true, blockSize);
+  if (theSolver == nullptr)
+    return nullptr;
+
+  MatrixFreeLinSOE *theSOE = new MatrixFreeLinSOE(*theSolver, blockSize);
+  theSOE->setNumThreads(numThreads);
+  return theSOE;
+}
+
+
 #ifdef _THREADS
 #  include "contrib/sys_of_eqn/ThreadedSuperLU/ThreadedSuperLU.h"
 #else
@@ -228,6 +482,9 @@ specifySparseGen(G3_Runtime* rt, int argc, G3_Char ** const argv)
     int npRow = 1;
     int npCol = 1;
     int np = 1;
+    bool mixed = false;
+    double refineTol = 1.0e-10;
+    int maxRefine = 10;
 
     // defaults for threaded SuperLU
     while (count < argc) {
@@ -253,6 +510,20 @@ specifySparseGen(G3_Runtime* rt, int argc, G3_Char ** const argv)
         if (count < argc)
           if (Tcl_GetInt(interp, argv[count], &npCol) != TCL_OK)
             return nullptr;
+      } else if (strcmp(argv[count], "-mixed") == 0) {
+        mixed = true;
+      } else if (strcmp(argv[count], "-refineTol") == 0) {
+        count++;
+        if (count >= argc || Tcl_GetDouble(interp, argv[count], &refineTol) != TCL_OK) {
+          opserr << G3_ERROR_PROMPT << "-refineTol requires a tolerance\n";
+          return nullptr;
+        }
+      } else if (strcmp(argv[count], "-maxRefine") == 0) {
+        count++;
+        if (count >= argc || Tcl_GetInt(interp, argv[count], &maxRefine) != TCL_OK) {
+          opserr << G3_ERROR_PROMPT << "-maxRefine requires an integer\n";
+          return nullptr;
+        }
       }
       count++;
     }
@@ -287,7 +558,10 @@ specifySparseGen(G3_Runtime* rt, int argc, G3_Char ** const argv)
       count++;
     }
     // TODO(cmp) : SuperLU
-    theSolver = new SuperLU(permSpec, drop_tol, panelSize, relax, symmetric);
+    SuperLU *theSuperLU = new SuperLU(permSpec, drop_tol, panelSize, relax, symmetric);
+    if (mixed)
+      theSuperLU->setMixedPrecision(refineTol, maxRefine);
+    theSolver = theSuperLU;
 #endif
 
 #ifdef _PARALLEL_PROCESSING
@@ -297,6 +571,72 @@ specifySparseGen(G3_Runtime* rt, int argc, G3_Char ** const argv)
 #endif
 }
 
+//
+// systemStats
+//
+// Return a dictionary with the number of times the solver took each
+// path, e.g. symbolic vs. numerical factorization. Profile and band
+// systems report the ordering applied and the number of entries of A
+// stored before and after it; the Krylov solver reports iterations and
+// how often its preconditioner was built or reused. Solvers that do not keep statistics give
+// an empty dictionary.
+//
+int
+TclCommand_systemStats(ClientData clientData, Tcl_Interp *interp, int argc, TCL_Char ** const argv)
+{
+  assert(clientData != nullptr);
+  LinearSOE *theSOE = ((BasicAnalysisBuilder *)clientData)->getLinearSOE();
+
+  Tcl_Obj *dict = Tcl_NewDictObj();
+  if (theSOE == nullptr) {
+    Tcl_SetObjResult(interp, dict);
+    return TCL_OK;
+  }
+
+  // storage of the profile and band systems before and after reordering
+  const EquationOrdering *ordering = nullptr;
+  if (ProfileSPDLinSOE *theProfileSOE = dynamic_cast<ProfileSPDLinSOE*>(theSOE))
+    ordering = &theProfileSOE->getOrdering();
+  else if (BandSPDLinSOE *theBandSOE = dynamic_cast<BandSPDLinSOE*>(theSOE))
+    ordering = &theBandSOE->getOrdering();
+  if (ordering != nullptr) {
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("ordering", -1),
+                   Tcl_NewStringObj(EquationOrdering::name(ordering->getApplied()), -1));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("originalSize", -1),
+                   Tcl_NewWideIntObj(ordering->getOriginalSize()));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("storedSize", -1),
+                   Tcl_NewWideIntObj(ordering->getReorderedSize()));
+  }
+
+  if (KrylovSolver *theSolver = dynamic_cast<KrylovSolver*>(theSOE->getSolver())) {
+    const KrylovSolver::Statistics &stats = theSolver->getStatistics();
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("solve",      -1), Tcl_NewIntObj(stats.solve));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("iterations", -1), Tcl_NewIntObj(stats.iterations));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("last",       -1), Tcl_NewIntObj(stats.last));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("build",      -1), Tcl_NewIntObj(stats.build));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("reuse",      -1), Tcl_NewIntObj(stats.reuse));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("failed",     -1), Tcl_NewIntObj(stats.failed));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("residual",   -1), Tcl_NewDoubleObj(stats.residual));
+  }
+
+#ifndef _THREADS
+  if (SuperLU *theSolver = dynamic_cast<SuperLU*>(theSOE->getSolver())) {
+    const SuperLU::Statistics &stats = theSolver->getStatistics();
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("symbolic", -1), Tcl_NewIntObj(stats.symbolic));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("reused",   -1), Tcl_NewIntObj(stats.reused));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("factor",   -1), Tcl_NewIntObj(stats.factor));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("refactor", -1), Tcl_NewIntObj(stats.refactor));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("solve",    -1), Tcl_NewIntObj(stats.solve));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("single",   -1), Tcl_NewIntObj(stats.single));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("refine",   -1), Tcl_NewIntObj(stats.refine));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("fallback", -1), Tcl_NewIntObj(stats.fallback));
+  }
+#endif
+
+  Tcl_SetObjResult(interp, dict);
+  return TCL_OK;
+}
+
 
 #if 0 // Some misc solvers i play with
 
@@ -92,6 +92,10 @@ typedef LinearSOE*(G3_SysOfEqnSpecifier)(G3_Runtime*, int, G3_Char**);
 // Specifiers defined in solver.cpp
 G3_SysOfEqnSpecifier specify_SparseSPD;
 G3_SysOfEqnSpecifier specifySparseGen;
+G3_SysOfEqnSpecifier specify_ProfileSPD;
+G3_SysOfEqnSpecifier specify_BandSPD;
+G3_SysOfEqnSpecifier specify_Krylov;
+G3_SysOfEqnSpecifier specify_MatrixFree;
 TclDispatch<LinearSOE*> TclDispatch_newMumpsLinearSOE;
 // TclDispatch<LinearSOE*> TclDispatch_newUmfpackLinearSOE;
 LinearSOE* TclDispatch_newUmfpackLinearSOE(ClientData, Tcl_Interp*, int, const char** const);
@@ -110,7 +114,7 @@ struct soefps {fn ss, sp, mp;};
 
 std::unordered_map<std::string, struct soefps> soe_table = {
   {"bandspd", {
-     G3_SOE(BandSPDLinLapackSolver,      BandSPDLinSOE),
+     specify_BandSPD,
      SP_SOE(BandSPDLinLapackSolver,      DistributedBandSPDLinSOE),
      MP_SOE(BandSPDLinLapackSolver,      DistributedBandSPDLinSOE)}},
 
@@ -134,6 +138,9 @@ std::unordered_map<std::string, struct soefps> soe_table = {
   {"sparsegeneral", {specifySparseGen, nullptr, nullptr}},
   {"superlu",       {specifySparseGen, nullptr, nullptr}},
 
+  {"krylov",        {specify_Krylov, nullptr, nullptr}},
+  {"matrixfree",    {specify_MatrixFree, nullptr, nullptr}},
+
   {"sparsesym", {
      specify_SparseSPD, nullptr, nullptr}},
 
@@ -157,7 +164,7 @@ std::unordered_map<std::string, struct soefps> soe_table = {
      MP_SOE(SProfileSPDLinSolver,        SProfileSPDLinSOE)}},
 
   {"profilespd", {
-     G3_SOE(ProfileSPDLinDirectSolver,   ProfileSPDLinSOE),
+     specify_ProfileSPD,
      SP_SOE(ProfileSPDLinDirectSolver,   DistributedProfileSPDLinSOE),
      MP_SOE(ProfileSPDLinDirectSolver,   DistributedProfileSPDLinSOE)}},
 
@@ -148,6 +148,8 @@ G3_AddTclDomainCommands(Tcl_Interp *interp, Domain* the_domain)
   Tcl_CreateObjCommand(interp, "constrainedNodes",    &constrainedNodes,    domain, nullptr);
   Tcl_CreateObjCommand(interp, "constrainedDOFs",     &constrainedDOFs,     domain, nullptr);
   Tcl_CreateObjCommand(interp, "domainChange",        &domainChange,        domain, nullptr);
+  Tcl_CreateObjCommand(interp, "nodeResponses",       &nodeResponses,       domain, nullptr);
+  Tcl_CreateObjCommand(interp, "eleResponses",        &eleResponses,        domain, nullptr);
   Tcl_CreateObjCommand(interp, "remove",              &removeObject,        domain, nullptr);
   Tcl_CreateCommand(interp,    "retainedNodes",       &retainedNodes,       domain, nullptr);
   Tcl_CreateCommand(interp,    "retainedDOFs",        &retainedDOFs,        domain, nullptr);
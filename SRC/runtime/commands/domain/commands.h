@@ -106,6 +106,10 @@ Tcl_ObjCmdProc constrainedNodes;
 Tcl_ObjCmdProc fixedDOFs;
 Tcl_ObjCmdProc constrainedDOFs;
 Tcl_ObjCmdProc domainChange;
+
+// response.cpp
+Tcl_ObjCmdProc nodeResponses;
+Tcl_ObjCmdProc eleResponses;
 Tcl_CmdProc retainedDOFs;
 Tcl_CmdProc updateElementDomain;
 
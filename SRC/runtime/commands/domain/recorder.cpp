@@ -41,6 +41,8 @@
 #include <DataFileStreamAdd.h>
 #include <XmlFileStream.h>
 #include <BinaryFileStream.h>
+#include <ColumnarFileStream.h>
+#include <AsyncStream.h>
 #include <DatabaseStream.h>
 #include <DummyStream.h>
 #include <TCP_Stream.h>
@@ -98,6 +100,10 @@ struct OutputOptions {
   int writeBufferSize   = 0;
   bool doScientific     = false;
   bool closeOnWrite     = false;
+  int  bytesPerValue    = 8;      // columnar output only
+  bool writerThread     = false;  // columnar output only
+  bool async            = false;
+  int  asyncRows        = 256;
 
   FE_Datastore *theDatabase = nullptr;
 
@@ -110,6 +116,7 @@ struct OutputOptions {
     DATA_STREAM_CSV,
     TCP_STREAM,
     DATA_STREAM_ADD,
+    COLUMNAR_STREAM,
     MODE_UNSPECIFIED
   } eMode = STANDARD_STREAM;
 };
@@ -124,6 +131,18 @@ createOutputStream(OutputOptions &options)
 {
   OPS_Stream *theOutputStream = nullptr;
 
+  // options that only the columnar stream understands
+  if (options.eMode != OutputOptions::COLUMNAR_STREAM || options.filename == nullptr) {
+    if (options.bytesPerValue != 8) {
+      opserr << G3_ERROR_PROMPT << "-float32 requires -columnar output\n";
+      return nullptr;
+    }
+    if (options.writerThread) {
+      opserr << G3_ERROR_PROMPT << "-writerThread requires -columnar output\n";
+      return nullptr;
+    }
+  }
+
   // construct the DataHandler
   if (options.filename != nullptr) {
     if (options.eMode == OutputOptions::DATA_STREAM) {
@@ -155,6 +174,15 @@ createOutputStream(OutputOptions &options)
 
     } else if (options.eMode == OutputOptions::BINARY_STREAM) {
       theOutputStream = new BinaryFileStream(options.filename);
+
+    } else if (options.eMode == OutputOptions::COLUMNAR_STREAM) {
+      // the write buffer size is the number of rows in a chunk
+      theOutputStream = new ColumnarFileStream(
+          options.filename,
+          openMode::OVERWRITE,
+          options.bytesPerValue,
+          options.writeBufferSize,
+          options.writerThread);
     }
 
   } else if (options.eMode == OutputOptions::TCP_STREAM && options.inetAddr != 0) {
@@ -169,6 +197,10 @@ createOutputStream(OutputOptions &options)
 
   theOutputStream->setPrecision(options.precision);
 
+  // write rows from a background thread
+  if (options.async)
+    theOutputStream = new AsyncStream(theOutputStream, options.asyncRows);
+
   return theOutputStream;
 }
 
@@ -295,6 +327,31 @@ parseOutputOption(OutputOptions *options, Tcl_Interp* interp, int argc, TCL_Char
       loc++;
     }
 
+    else if (strcmp(argv[loc], "-float32") == 0) {
+      options->bytesPerValue = 4;
+      loc++;
+    }
+
+    else if (strcmp(argv[loc], "-writerThread") == 0) {
+      options->writerThread = true;
+      loc++;
+    }
+
+    else if (strcmp(argv[loc], "-async") == 0) {
+      options->async = true;
+      loc++;
+    }
+
+    else if (strcmp(argv[loc], "-asyncRows") == 0) {
+      options->async = true;
+      if (++loc >= argc || Tcl_GetInt(interp, argv[loc], &options->asyncRows) != TCL_OK
+          || options->asyncRows < 1) {
+        opserr << G3_ERROR_PROMPT << "flag -asyncRows expects a positive integer\n";
+        return -1;
+      }
+      loc++;
+    }
+
     else if (strcmp(argv[loc], "-buffer") == 0 ||
              strcmp(argv[loc], "-bufferSize") == 0) {
       loc++;
@@ -323,6 +380,9 @@ parseOutputOption(OutputOptions *options, Tcl_Interp* interp, int argc, TCL_Char
       else if ((strcmp(argv[loc], "-binary") == 0)) {
         eMode = OutputOptions::BINARY_STREAM;
       }
+      else if ((strcmp(argv[loc], "-columnar") == 0)) {
+        eMode = OutputOptions::COLUMNAR_STREAM;
+      }
       else if ((strcmp(argv[loc], "-TCP") == 0) ||
                (strcmp(argv[loc], "-tcp") == 0)) {
         options->inetAddr = argv[loc + 1];
@@ -580,6 +640,10 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
 
     // construct the DataHandler
     theOutputStream = createOutputStream(options);
+    if (theOutputStream == nullptr) {
+      delete [] data;
+      return TCL_ERROR;
+    }
 
     if (strcmp(argv[1], "Element") == 0)
       (*theRecorder) = new ElementRecorder(eleIDs, data, unused.size(), echoTime, *domain,
@@ -1266,7 +1330,8 @@ TclCreateRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
 
     // construct the DataHandler
     theOutputStream = createOutputStream(options);
-
+    if (theOutputStream == nullptr)
+      return TCL_ERROR;
 
     // Subtract one from dof and perpDirn for C indexing
     if (strcmp(argv[1], "Drift") == 0)
@@ -1783,6 +1848,8 @@ createNodeRecorder(ClientData clientData, Tcl_Interp *interp, int argc,
   }
 
   theOutputStream = createOutputStream(options);
+  if (theOutputStream == nullptr)
+    return TCL_ERROR;
 
   if (theTimeSeries != nullptr && theTimeSeriesID.Size() < theDofs.Size()) {
     opserr << G3_ERROR_PROMPT << "recorder Node/EnvelopNode # TimeSeries must equal # "
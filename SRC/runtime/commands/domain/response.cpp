@@ -5,6 +5,8 @@
 //===----------------------------------------------------------------------===//
 //
 #include <tcl.h>
+#include <string.h>
+#include <vector>
 #include <Matrix.h>
 #include <Domain.h>
 #include <Logging.h>
@@ -736,3 +738,171 @@ sectionDisplacement(ClientData clientData, Tcl_Interp *interp, int argc,
 
     return TCL_OK;
 }
+
+
+//
+// Bulk queries
+//
+//   nodeResponses $tags disp|vel|accel|reaction|unbalance <-dof $dof> <-binary>
+//   eleResponses  $tags <-binary> args...
+//
+// These return the responses of a set of nodes or elements in one packed
+// result, instead of one formatted string per call. The values of each
+// object follow one another, so n objects with m values each give a
+// row-major n-by-m array. With -binary the result is a ByteArray of native
+// doubles (e.g., for binary scan, or numpy.frombuffer on the Python side);
+// otherwise it is a list of doubles.
+//
+static int
+getTagList(Tcl_Interp *interp, Tcl_Obj *listObj, std::vector<int> &tags)
+{
+  int numTags;
+  Tcl_Obj **tagObjs;
+  if (Tcl_ListObjGetElements(interp, listObj, &numTags, &tagObjs) != TCL_OK)
+    return TCL_ERROR;
+
+  tags.resize(numTags);
+  for (int i = 0; i < numTags; i++)
+    if (Tcl_GetIntFromObj(interp, tagObjs[i], &tags[i]) != TCL_OK)
+      return TCL_ERROR;
+
+  return TCL_OK;
+}
+
+static void
+setPackedResult(Tcl_Interp *interp, const std::vector<double> &values, bool binary)
+{
+  if (binary) {
+    Tcl_Obj *bytes = Tcl_NewByteArrayObj(nullptr, 0);
+    unsigned char *data = Tcl_SetByteArrayLength(bytes, values.size()*sizeof(double));
+    if (!values.empty())
+      memcpy(data, values.data(), values.size()*sizeof(double));
+    Tcl_SetObjResult(interp, bytes);
+
+  } else {
+    std::vector<Tcl_Obj*> objs(values.size());
+    for (std::size_t i = 0; i < values.size(); i++)
+      objs[i] = Tcl_NewDoubleObj(values[i]);
+    Tcl_SetObjResult(interp, Tcl_NewListObj(objs.size(), objs.data()));
+  }
+}
+
+int
+nodeResponses(ClientData clientData, Tcl_Interp *interp, int argc, Tcl_Obj *const *objv)
+{
+  assert(clientData != nullptr);
+  Domain *theDomain = (Domain*)clientData;
+
+  if (argc < 3) {
+    opserr << G3_ERROR_PROMPT << "want - nodeResponses tags? response? <-dof dof?> <-binary>\n";
+    return TCL_ERROR;
+  }
+
+  std::vector<int> tags;
+  if (getTagList(interp, objv[1], tags) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "nodeResponses - could not read node tags\n";
+    return TCL_ERROR;
+  }
+
+  NodeData response;
+  const char *name = Tcl_GetString(objv[2]);
+  if (strcmp(name, "disp") == 0 || strcmp(name, "displacement") == 0)
+    response = NodeData::Disp;
+  else if (strcmp(name, "vel") == 0 || strcmp(name, "velocity") == 0)
+    response = NodeData::Vel;
+  else if (strcmp(name, "accel") == 0 || strcmp(name, "acceleration") == 0)
+    response = NodeData::Accel;
+  else if (strcmp(name, "reaction") == 0)
+    response = NodeData::Reaction;
+  else if (strcmp(name, "unbalance") == 0)
+    response = NodeData::UnbalancedLoad;
+  else {
+    opserr << G3_ERROR_PROMPT << "nodeResponses - unknown response " << name << "\n";
+    return TCL_ERROR;
+  }
+
+  int dof = -1;
+  bool binary = false;
+  for (int i = 3; i < argc; i++) {
+    const char *arg = Tcl_GetString(objv[i]);
+    if (strcmp(arg, "-binary") == 0)
+      binary = true;
+    else if (strcmp(arg, "-dof") == 0 && i+1 < argc) {
+      if (Tcl_GetIntFromObj(interp, objv[++i], &dof) != TCL_OK || dof < 1) {
+        opserr << G3_ERROR_PROMPT << "nodeResponses - invalid dof\n";
+        return TCL_ERROR;
+      }
+    }
+    else {
+      opserr << G3_ERROR_PROMPT << "nodeResponses - unknown option " << arg << "\n";
+      return TCL_ERROR;
+    }
+  }
+
+  std::vector<double> values;
+  values.reserve(tags.size()*(dof > 0 ? 1 : 6));
+  for (int tag : tags) {
+    const Vector *data = theDomain->getNodeResponse(tag, response);
+    if (data == nullptr) {
+      opserr << G3_ERROR_PROMPT << "nodeResponses - no response for node " << tag << "\n";
+      return TCL_ERROR;
+    }
+
+    if (dof > 0) {
+      if (dof > data->Size()) {
+        opserr << G3_ERROR_PROMPT << "nodeResponses - dof " << dof
+               << " too large for node " << tag << "\n";
+        return TCL_ERROR;
+      }
+      values.push_back((*data)(dof-1));
+    } else
+      for (int i = 0; i < data->Size(); i++)
+        values.push_back((*data)(i));
+  }
+
+  setPackedResult(interp, values, binary);
+  return TCL_OK;
+}
+
+int
+eleResponses(ClientData clientData, Tcl_Interp *interp, int argc, Tcl_Obj *const *objv)
+{
+  assert(clientData != nullptr);
+  Domain *theDomain = (Domain*)clientData;
+
+  if (argc < 3) {
+    opserr << G3_ERROR_PROMPT << "want - eleResponses tags? <-binary> eleArgs...\n";
+    return TCL_ERROR;
+  }
+
+  std::vector<int> tags;
+  if (getTagList(interp, objv[1], tags) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "eleResponses - could not read element tags\n";
+    return TCL_ERROR;
+  }
+
+  int argi = 2;
+  bool binary = false;
+  if (strcmp(Tcl_GetString(objv[argi]), "-binary") == 0) {
+    binary = true;
+    argi++;
+  }
+
+  std::vector<const char *> args;
+  for (int i = argi; i < argc; i++)
+    args.push_back(Tcl_GetString(objv[i]));
+
+  std::vector<double> values;
+  for (int tag : tags) {
+    const Vector *data = theDomain->getElementResponse(tag, args.data(), args.size());
+    if (data == nullptr) {
+      opserr << G3_ERROR_PROMPT << "eleResponses - no response for element " << tag << "\n";
+      return TCL_ERROR;
+    }
+    for (int i = 0; i < data->Size(); i++)
+      values.push_back((*data)(i));
+  }
+
+  setPackedResult(interp, values, binary);
+  return TCL_OK;
+}
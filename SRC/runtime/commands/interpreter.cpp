@@ -22,6 +22,7 @@ static Timer *theTimer = nullptr;
 class ProgressBar;
 Tcl_ObjCmdProc TclObjCommand_progress;
 extern ProgressBar* progress_bar_ptr;
+Tcl_ObjCmdProc TclObjCommand_profile;
 
 
 const char *getInterpPWD(Tcl_Interp *interp);
@@ -398,6 +399,7 @@ Init_OpenSees(Tcl_Interp *interp)
   Tcl_CreateObjCommand(interp, "source",           OPS_SourceCmd, nullptr, nullptr);
   Tcl_CreateObjCommand(interp, "pragma",           TclObjCommand_pragma, nullptr, nullptr);
   Tcl_CreateObjCommand(interp, "progress",         TclObjCommand_progress, (ClientData)&progress_bar_ptr, nullptr);
+  Tcl_CreateObjCommand(interp, "profile",          TclObjCommand_profile, nullptr, nullptr);
 
   //
   static int ncmd = sizeof(InterpreterCommands)/sizeof(char_cmd);
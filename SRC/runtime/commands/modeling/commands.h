@@ -15,8 +15,8 @@ extern Tcl_CmdProc  buildModel;
 // modeling/nodes.cpp
 extern Tcl_CmdProc  TclCommand_getNDM;
 extern Tcl_CmdProc  TclCommand_getNDF;
-extern Tcl_CmdProc  TclCommand_addNode;
-extern Tcl_CmdProc  TclCommand_addNodalMass;
+extern Tcl_ObjCmdProc  TclCommand_addNode;
+extern Tcl_ObjCmdProc  TclCommand_addNodalMass;
 extern Tcl_CmdProc  TclCommand_addNodalLoad;
 // 
 extern Tcl_CmdProc  TclCommand_addSeries;
@@ -39,17 +39,17 @@ extern Tcl_CmdProc  TclCommand_addSection;
 extern Tcl_CmdProc  TclCommand_addPatch;
 extern Tcl_CmdProc  TclCommand_addReinfLayer;
 // extern Tcl_CmdProc  TclCommand_addRemoFiber;
-extern Tcl_CmdProc  TclCommand_addFiber;
+extern Tcl_ObjCmdProc  TclCommand_addFiber;
 extern Tcl_CmdProc  TclCommand_addHFiber;
 
 // Constraints
 extern Tcl_CmdProc TclCommand_addMP;
 extern Tcl_CmdProc TclCommand_addSP;
-extern Tcl_CmdProc TclCommand_addHomogeneousBC;
+extern Tcl_ObjCmdProc TclCommand_addHomogeneousBC;
 extern Tcl_CmdProc TclCommand_addHomogeneousBC_X;
 extern Tcl_CmdProc TclCommand_addHomogeneousBC_Y; 
 extern Tcl_CmdProc TclCommand_addHomogeneousBC_Z;
-extern Tcl_CmdProc TclCommand_addEqualDOF_MP;
+extern Tcl_ObjCmdProc TclCommand_addEqualDOF_MP;
 extern Tcl_CmdProc TclCommand_addEqualDOF_MP_Mixed;
 extern Tcl_CmdProc TclCommand_RigidLink;
 extern Tcl_CmdProc TclCommand_RigidDiaphragm;
@@ -95,15 +95,12 @@ struct char_cmd {
 
   {"getNDM",               TclCommand_getNDM},
   {"getNDF",               TclCommand_getNDF},
-  {"node",                 TclCommand_addNode},
-  {"mass",                 TclCommand_addNodalMass},
   {"element",              TclCommand_addElement},
 
   {"print",                TclCommand_print},
   {"classType",            TclCommand_classType},
   {"printModel",           TclCommand_print},
 
-  {"fix",                  TclCommand_addHomogeneousBC},
   {"fixX",                 TclCommand_addHomogeneousBC_X},
   {"fixY",                 TclCommand_addHomogeneousBC_Y},
   {"fixZ",                 TclCommand_addHomogeneousBC_Z},
@@ -119,7 +116,6 @@ struct char_cmd {
 
   {"section",              TclCommand_addSection},
   {"patch",                TclCommand_addPatch},
-  {"fiber",                TclCommand_addFiber},
   {"layer",                TclCommand_addReinfLayer},
   {"Hfiber",               TclCommand_addHFiber},
 
@@ -131,7 +127,6 @@ struct char_cmd {
   {"nodalLoad",            TclCommand_addNodalLoad},
   {"timeSeries",           TclCommand_addTimeSeries},
 
-  {"equalDOF",             TclCommand_addEqualDOF_MP},
   {"rigidLink",            TclCommand_RigidLink},
   
   {"sp",                   TclCommand_addSP},
@@ -187,6 +182,24 @@ struct char_cmd {
 
 };
 
+//
+// Commands issued once per object of large models take their arguments as
+// Tcl_Obj so numbers keep their cached internal representation. element
+// stays in tcl_char_cmds: every element type is parsed from argv, either
+// by its own Tcl_CmdProc or through OPS_ResetInputNoBuilder, so an object
+// entry point would only have to convert the arguments back to strings.
+//
+struct obj_cmd {
+  const char* name;
+  Tcl_ObjCmdProc*  func;
+}  const tcl_obj_cmds[] =  {
+  {"node",                 TclCommand_addNode},
+  {"mass",                 TclCommand_addNodalMass},
+  {"fix",                  TclCommand_addHomogeneousBC},
+  {"equalDOF",             TclCommand_addEqualDOF_MP},
+  {"fiber",                TclCommand_addFiber},
+};
+
 Tcl_CmdProc TclCommand_Package;
 
 // Added by Scott J. Brandenberg
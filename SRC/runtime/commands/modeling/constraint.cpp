@@ -28,7 +28,7 @@
 
 int
 TclCommand_addHomogeneousBC(ClientData clientData, Tcl_Interp *interp, int argc,
-                            TCL_Char ** const argv)
+                            Tcl_Obj *const *objv)
 {
   assert(clientData != nullptr);
   Domain *theTclDomain = ((BasicModelBuilder*)clientData)->getDomain();
@@ -42,7 +42,7 @@ TclCommand_addHomogeneousBC(ClientData clientData, Tcl_Interp *interp, int argc,
 
   // get the tag of the node
   int nodeId;
-  if (Tcl_GetInt(interp, argv[1], &nodeId) != TCL_OK) {
+  if (Tcl_GetIntFromObj(interp, objv[1], &nodeId) != TCL_OK) {
     opserr << OpenSees::PromptValueError << "invalid tag\n";
     return TCL_ERROR;
   }
@@ -51,13 +51,13 @@ TclCommand_addHomogeneousBC(ClientData clientData, Tcl_Interp *interp, int argc,
   // 
   // fix $node -dof $dof <-value $value>
   //
-  if (strcmp(argv[2], "-dof") == 0) {
+  if (strcmp(Tcl_GetString(objv[2]), "-dof") == 0) {
     if (argc < 4) {
       opserr << OpenSees::PromptValueError << "missing required argument for -dof $dof\n";
       return TCL_ERROR;
     }
     int dof;
-    if (Tcl_GetInt(interp, argv[3], &dof) != TCL_OK) {
+    if (Tcl_GetIntFromObj(interp, objv[3], &dof) != TCL_OK) {
       opserr << OpenSees::PromptValueError << "invalid dof\n";
       return TCL_ERROR;
     }
@@ -89,7 +89,7 @@ TclCommand_addHomogeneousBC(ClientData clientData, Tcl_Interp *interp, int argc,
   Tcl_Obj* list = Tcl_NewListObj(ndf, nullptr);
   for (int i = 0; i < ndf; ++i) {
     int theFixity;
-    if (Tcl_GetInt(interp, argv[2 + i], &theFixity) != TCL_OK) {
+    if (Tcl_GetIntFromObj(interp, objv[2 + i], &theFixity) != TCL_OK) {
       opserr << OpenSees::PromptValueError << "invalid fixity " << i + 1 << " - load " << nodeId;
       opserr << " " << ndf << " fixities\n";
       return TCL_ERROR;
@@ -414,7 +414,7 @@ TclCommand_addSP(ClientData clientData, Tcl_Interp *interp, int argc,
 
 int
 TclCommand_addEqualDOF_MP(ClientData clientData, Tcl_Interp *interp,
-                                int argc, TCL_Char ** const argv)
+                                int argc, Tcl_Obj *const *objv)
 {
     BasicModelBuilder *builder = static_cast<BasicModelBuilder*>(clientData);
     Domain     *theTclDomain   = builder->getDomain();
@@ -429,13 +429,13 @@ TclCommand_addEqualDOF_MP(ClientData clientData, Tcl_Interp *interp,
     // Read in the node IDs and the DOF
     int RnodeID, CnodeID, dofID;
 
-    if (Tcl_GetInt(interp, argv[1], &RnodeID) != TCL_OK) {
-      opserr << OpenSees::PromptValueError << "invalid RnodeID: " << argv[1]
+    if (Tcl_GetIntFromObj(interp, objv[1], &RnodeID) != TCL_OK) {
+      opserr << OpenSees::PromptValueError << "invalid RnodeID: " << Tcl_GetString(objv[1])
              << " equalDOF RnodeID? CnodeID? DOF1? DOF2? ...";
       return TCL_ERROR;
     }
-    if (Tcl_GetInt(interp, argv[2], &CnodeID) != TCL_OK) {
-      opserr << OpenSees::PromptValueError << "invalid CnodeID: " << argv[2]
+    if (Tcl_GetIntFromObj(interp, objv[2], &CnodeID) != TCL_OK) {
+      opserr << OpenSees::PromptValueError << "invalid CnodeID: " << Tcl_GetString(objv[2])
              << " equalDOF RnodeID? CnodeID? DOF1? DOF2? ...";
       return TCL_ERROR;
     }
@@ -453,15 +453,15 @@ TclCommand_addEqualDOF_MP(ClientData clientData, Tcl_Interp *interp,
     int i, j;
     // Read the degrees of freedom which are to be coupled
     for (i = 3, j = 0; i < argc; i++, j++) {
-      if (Tcl_GetInt(interp, argv[i], &dofID) != TCL_OK) {
-        opserr << OpenSees::PromptValueError << "invalid dofID: " << argv[3]
+      if (Tcl_GetIntFromObj(interp, objv[i], &dofID) != TCL_OK) {
+        opserr << OpenSees::PromptValueError << "invalid dofID: " << Tcl_GetString(objv[3])
                << " equalDOF RnodeID? CnodeID? DOF1? DOF2? ...";
         return TCL_ERROR;
       }
 
       dofID -= 1; // Decrement for C++ indexing
       if (dofID < 0) {
-        opserr << OpenSees::PromptValueError << "invalid dofID: " << argv[i]
+        opserr << OpenSees::PromptValueError << "invalid dofID: " << Tcl_GetString(objv[i])
                << " must be >= 1";
         return TCL_ERROR;
       }
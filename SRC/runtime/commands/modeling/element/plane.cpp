@@ -192,6 +192,7 @@ TclBasicBuilder_addFourNodeQuad(ClientData clientData, Tcl_Interp *interp, int a
   double b1 = 0.0;
   double b2 = 0.0;
   TCL_Char *type = nullptr;
+  bool cacheGeometry = false;
   if (true) {
     enum class Position : int {
       Thickness, Type, Material, Pressure, Density, B1, B2, End
@@ -203,7 +204,16 @@ TclBasicBuilder_addFourNodeQuad(ClientData clientData, Tcl_Interp *interp, int a
     // Keywords
     //
     for (int i=argi; i<argc; i++) {
-      if (strcmp(argv[i], "-section") == 0) {
+      if (strcmp(argv[i], "-cache") == 0) {
+        if (strcasecmp(argv[1], "LagrangeQuad") != 0) {
+          opserr << OpenSees::PromptValueError
+                 << "-cache is only supported by LagrangeQuad"
+                 << "\n";
+          return TCL_ERROR;
+        }
+        cacheGeometry = true;
+      }
+      else if (strcmp(argv[i], "-section") == 0) {
         i++;
         if (i== argc) {
           opserr << OpenSees::PromptValueError 
@@ -372,9 +382,11 @@ TclBasicBuilder_addFourNodeQuad(ClientData clientData, Tcl_Interp *interp, int a
       if (mat_2d == nullptr)
         return TCL_ERROR;
 
-      theElement =
+      LagrangeQuad<4> *theQuad =
           new LagrangeQuad<4>(tag, nodes, *mat_2d,
                               thickness, p, rho, b1, b2);
+      theQuad->setGeometryCache(cacheGeometry);
+      theElement = theQuad;
 
     } else {
       if (nd_mat == nullptr) {
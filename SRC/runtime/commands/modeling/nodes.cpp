@@ -27,7 +27,7 @@
 
 int
 TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
-                   TCL_Char ** const argv)
+                   Tcl_Obj *const *objv)
 {
   assert(clientData != nullptr);
 
@@ -49,7 +49,7 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
 
   // read the node id
   int nodeId;
-  if (Tcl_GetInt(interp, argv[1], &nodeId) != TCL_OK) {
+  if (Tcl_GetIntFromObj(interp, objv[1], &nodeId) != TCL_OK) {
     opserr << G3_ERROR_PROMPT << "invalid nodeTag\n";
     opserr << "        Want: node nodeTag? [ndm coordinates?] <-mass [ndf values?]>\n";
     return TCL_ERROR;
@@ -59,7 +59,7 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
   double xLoc, yLoc, zLoc;
   if (ndm == 1) {
     // create a node in 1d space
-    if (Tcl_GetDouble(interp, argv[2], &xLoc) != TCL_OK) {
+    if (Tcl_GetDoubleFromObj(interp, objv[2], &xLoc) != TCL_OK) {
       opserr << G3_ERROR_PROMPT << "invalid coordinate\n";
       return TCL_ERROR;
     }
@@ -67,12 +67,12 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
 
   else if (ndm == 2) {
     // create a node in 2d space
-    if (Tcl_GetDouble(interp, argv[2], &xLoc) != TCL_OK) {
+    if (Tcl_GetDoubleFromObj(interp, objv[2], &xLoc) != TCL_OK) {
       opserr << G3_ERROR_PROMPT << "invalid 1st coordinate\n";
       opserr << "node: " << nodeId << "\n";
       return TCL_ERROR;
     }
-    if (Tcl_GetDouble(interp, argv[3], &yLoc) != TCL_OK) {
+    if (Tcl_GetDoubleFromObj(interp, objv[3], &yLoc) != TCL_OK) {
       opserr << G3_ERROR_PROMPT << "invalid 2nd coordinate\n";
       opserr << "node: " << nodeId << "\n";
       return TCL_ERROR;
@@ -81,15 +81,15 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
 
   else if (ndm == 3) {
     // create a node in 3d space
-    if (Tcl_GetDouble(interp, argv[2], &xLoc) != TCL_OK) {
+    if (Tcl_GetDoubleFromObj(interp, objv[2], &xLoc) != TCL_OK) {
       opserr << G3_ERROR_PROMPT << "invalid 1st coordinate\n";
       return TCL_ERROR;
     }
-    if (Tcl_GetDouble(interp, argv[3], &yLoc) != TCL_OK) {
+    if (Tcl_GetDoubleFromObj(interp, objv[3], &yLoc) != TCL_OK) {
       opserr << G3_ERROR_PROMPT << "invalid 2nd coordinate\n";
       return TCL_ERROR;
     }
-    if (Tcl_GetDouble(interp, argv[4], &zLoc) != TCL_OK) {
+    if (Tcl_GetDoubleFromObj(interp, objv[4], &zLoc) != TCL_OK) {
       opserr << G3_ERROR_PROMPT << "invalid 3rd coordinate\n";
       return TCL_ERROR;
     }
@@ -101,8 +101,8 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
 
   // check for -ndf override option
   int currentArg = 2 + ndm;
-  if (currentArg < argc && strcmp(argv[currentArg], "-ndf") == 0) {
-    if (Tcl_GetInt(interp, argv[currentArg + 1], &ndf) != TCL_OK) {
+  if (currentArg + 1 < argc && strcmp(Tcl_GetString(objv[currentArg]), "-ndf") == 0) {
+    if (Tcl_GetIntFromObj(interp, objv[currentArg + 1], &ndf) != TCL_OK) {
       opserr << G3_ERROR_PROMPT << "invalid nodal ndf given for node " << nodeId << "\n";
       return TCL_ERROR;
     }
@@ -140,7 +140,7 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
   }
 
   while (currentArg < argc) {
-    if (strcmp(argv[currentArg], "-mass") == 0) {
+    if (strcmp(Tcl_GetString(objv[currentArg]), "-mass") == 0) {
       currentArg++;
       if (argc < currentArg + ndf) {
         opserr << G3_ERROR_PROMPT << "incorrect number of nodal mass terms\n";
@@ -151,7 +151,7 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
       double theMass;
       Matrix mass(ndf, ndf);
       for (int i = 0; i < ndf; ++i) {
-        if (Tcl_GetDouble(interp, argv[currentArg++], &theMass) != TCL_OK) {
+        if (Tcl_GetDoubleFromObj(interp, objv[currentArg++], &theMass) != TCL_OK) {
           opserr << G3_ERROR_PROMPT << "invalid nodal mass term";
           opserr << " at dof " << i + 1 << "\n";
           return TCL_ERROR;
@@ -160,7 +160,7 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
       }
       theNode->setMass(mass);
 
-    } else if (strcmp(argv[currentArg], "-dispLoc") == 0) {
+    } else if (strcmp(Tcl_GetString(objv[currentArg]), "-dispLoc") == 0) {
       currentArg++;
       if (argc < currentArg + ndm) {
         opserr << G3_ERROR_PROMPT << "incorrect number of nodal display location terms, "
@@ -170,7 +170,7 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
       Vector displayLoc(ndm);
       double theCrd;
       for (int i = 0; i < ndm; ++i) {
-        if (Tcl_GetDouble(interp, argv[currentArg++], &theCrd) != TCL_OK) {
+        if (Tcl_GetDoubleFromObj(interp, objv[currentArg++], &theCrd) != TCL_OK) {
           opserr << G3_ERROR_PROMPT << "invalid nodal mass term\n";
           opserr << "node: " << nodeId << ", dof: " << i + 1 << "\n";
           return TCL_ERROR;
@@ -179,7 +179,7 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
       }
       theNode->setDisplayCrds(displayLoc);
 
-    } else if (strcmp(argv[currentArg], "-disp") == 0) {
+    } else if (strcmp(Tcl_GetString(objv[currentArg]), "-disp") == 0) {
       currentArg++;
       if (argc < currentArg + ndf) {
         opserr << G3_ERROR_PROMPT << "incorrect number of nodal disp terms\n";
@@ -189,7 +189,7 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
       Vector disp(ndf);
       double theDisp;
       for (int i = 0; i < ndf; ++i) {
-        if (Tcl_GetDouble(interp, argv[currentArg++], &theDisp) != TCL_OK) {
+        if (Tcl_GetDoubleFromObj(interp, objv[currentArg++], &theDisp) != TCL_OK) {
           opserr << G3_ERROR_PROMPT << "invalid nodal disp term\n";
           opserr << "node: " << nodeId << ", dof: " << i + 1 << "\n";
           return TCL_ERROR;
@@ -199,7 +199,7 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
       theNode->setTrialDisp(disp);
       theNode->commitState();
 
-    } else if (strcmp(argv[currentArg], "-vel") == 0) {
+    } else if (strcmp(Tcl_GetString(objv[currentArg]), "-vel") == 0) {
       currentArg++;
       if (argc < currentArg + ndf) {
         opserr << G3_ERROR_PROMPT << "incorrect number of nodal vel terms, ";
@@ -210,7 +210,7 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
       double theDisp;
       Vector disp(ndf);
       for (int i = 0; i < ndf; ++i) {
-        if (Tcl_GetDouble(interp, argv[currentArg++], &theDisp) != TCL_OK) {
+        if (Tcl_GetDoubleFromObj(interp, objv[currentArg++], &theDisp) != TCL_OK) {
           opserr << G3_ERROR_PROMPT << "invalid nodal vel term at ";
           opserr << " dof " << i + 1 << "\n";
           return TCL_ERROR;
@@ -238,7 +238,7 @@ TclCommand_addNode(ClientData clientData, Tcl_Interp *interp, int argc,
 
 int
 TclCommand_addNodalMass(ClientData clientData, Tcl_Interp *interp, int argc,
-                        TCL_Char ** const argv)
+                        Tcl_Obj *const *objv)
 {
   assert(clientData != nullptr);
   BasicModelBuilder *builder = static_cast<BasicModelBuilder*>(clientData);
@@ -255,8 +255,8 @@ TclCommand_addNodalMass(ClientData clientData, Tcl_Interp *interp, int argc,
 
   // get the id of the node
   int nodeId;
-  if (Tcl_GetInt(interp, argv[1], &nodeId) != TCL_OK) {
-    opserr << G3_ERROR_PROMPT << "invalid nodeId: " << argv[1];
+  if (Tcl_GetIntFromObj(interp, objv[1], &nodeId) != TCL_OK) {
+    opserr << G3_ERROR_PROMPT << "invalid nodeId: " << Tcl_GetString(objv[1]);
     opserr << " - mass nodeId " << ndf << " forces\n";
     return TCL_ERROR;
   }
@@ -265,7 +265,7 @@ TclCommand_addNodalMass(ClientData clientData, Tcl_Interp *interp, int argc,
   Matrix mass(ndf,ndf);
   for (int i=0; i<ndf; ++i) {
      double theMass;
-     if (Tcl_GetDouble(interp, argv[i+2], &theMass) != TCL_OK) {
+     if (Tcl_GetDoubleFromObj(interp, objv[i+2], &theMass) != TCL_OK) {
           opserr << G3_ERROR_PROMPT << "invalid nodal mass term\n";
           opserr << "node: " << nodeId << ", dof: " << i+1 << "\n";
           return TCL_ERROR;
@@ -361,21 +361,50 @@ struct FiberSectionConfig {
    bool isThermal       = false;
    bool isNew           = false; // use new FrameFiberSection class
    bool computeCentroid = true;
+   bool batchFibers     = false; // update runs of fibers of the same class together
    double xz[2];
    double alpha;
    double density;
    bool use_density = false;
 };
 
-static SectionBuilder* 
-findSectionBuilder(BasicModelBuilder* builder, Tcl_Interp *interp, int argc, const char** const argv)
+// The commands that add to a section (patch, layer, fiber) take strings
+// or Tcl_Objs; these read the -section option of either
+static const char*
+argString(const char *arg)
 {
-  int tag;
+  return arg;
+}
+
+static const char*
+argString(Tcl_Obj *arg)
+{
+  return Tcl_GetString(arg);
+}
+
+static int
+getSectionTag(Tcl_Interp *interp, const char *arg, int *tag)
+{
+  return Tcl_GetInt(interp, arg, tag);
+}
+
+static int
+getSectionTag(Tcl_Interp *interp, Tcl_Obj *arg, int *tag)
+{
+  return Tcl_GetIntFromObj(interp, arg, tag);
+}
+
+// The section named by -section, or else the one being defined
+template <typename Arg>
+static SectionBuilder*
+findSectionBuilder(BasicModelBuilder* builder, Tcl_Interp *interp, int argc, Arg const *argv)
+{
+  int tag = -1;
   bool section_passed = false;
-  for (int i = 0; i<argc; ++i) {
-    if (strcmp(argv[i], "-section") == 0) {
-      if (Tcl_GetInt(interp, argv[i+1], &tag) != TCL_OK) {
-        opserr << OpenSees::PromptValueError << "failed to parse section tag \"" << argv[i+1] << "\"\n";
+  for (int i = 1; i<argc-1; ++i) {
+    if (strcmp(argString(argv[i]), "-section") == 0) {
+      if (getSectionTag(interp, argv[i+1], &tag) != TCL_OK) {
+        opserr << OpenSees::PromptValueError << "failed to parse section tag \"" << argString(argv[i+1]) << "\"\n";
         return nullptr;
       } else {
         section_passed = true;
@@ -393,7 +422,6 @@ findSectionBuilder(BasicModelBuilder* builder, Tcl_Interp *interp, int argc, con
     return nullptr;
 
   return builder->getTypedObject<SectionBuilder>(tag);
-
 }
 
 
@@ -434,6 +462,7 @@ initSectionCommands(ClientData clientData, Tcl_Interp *interp,
         section = sec;
       } else {
         auto sec = new FiberSection2d(secTag, options.computeCentroid);
+        sec->setBatchUpdate(options.batchFibers);
         sbuilder = new FiberSectionBuilder<2, UniaxialMaterial, FiberSection2d>(*builder, *sec);
         section = sec;
       }
@@ -472,10 +501,12 @@ initSectionCommands(ClientData clientData, Tcl_Interp *interp,
         if (options.isNew) {
           auto sec = new FrameFiberSection3d(secTag, 30,  theTorsion, options.computeCentroid, 
                                              options.density, options.use_density);
+          sec->setBatchUpdate(options.batchFibers);
           sbuilder = new FiberSectionBuilder<3, UniaxialMaterial, FrameFiberSection3d>(*builder, *sec);
           section = sec;
         } else {
           auto sec = new FiberSection3d(secTag, 30, *theTorsion, options.computeCentroid);
+          sec->setBatchUpdate(options.batchFibers);
           sbuilder = new FiberSectionBuilder<3, UniaxialMaterial, FiberSection3d>(*builder, *sec);
           section = sec;
         }
@@ -586,6 +617,11 @@ TclCommand_addFiberSection(ClientData clientData, Tcl_Interp *interp, int argc,
       iarg += 1;
     }
 
+    else if (strcmp(argv[iarg], "-batch") == 0) {
+      options.batchFibers = true;
+      iarg += 1;
+    }
+
     else if (strcmp(argv[iarg], "-mass") == 0 && iarg + 1 < argc) {
       if (argc < iarg + 2) {
         opserr << OpenSees::PromptValueError << "not enough -mass args need -mass mass?\n";
@@ -652,6 +688,14 @@ TclCommand_addFiberSection(ClientData clientData, Tcl_Interp *interp, int argc,
     }
   }
 
+  if (options.batchFibers && (options.isND || options.isThermal || options.isAsym)) {
+    opserr << OpenSees::PromptValueError
+           << "-batch is only supported by the uniaxial Fiber and FrameFiber sections\n";
+    if (deleteTorsion)
+      delete torsion;
+    return TCL_ERROR;
+  }
+
   if (torsion == nullptr && ndm == 3 && !options.isND) {
     opserr << OpenSees::PromptValueError
            << "- no torsion specified for 3D fiber section, use -GJ or "
@@ -1051,7 +1095,7 @@ TclCommand_addPatch(ClientData clientData,
 // Add a fiber to a fiber section
 int
 TclCommand_addFiber(ClientData clientData, Tcl_Interp *interp, int argc,
-                    TCL_Char ** const argv)
+                    Tcl_Obj *const *objv)
 {
   enum class Position : int {
     Y, Z, Area, Material, End
@@ -1062,7 +1106,7 @@ TclCommand_addFiber(ClientData clientData, Tcl_Interp *interp, int argc,
   assert(clientData != nullptr);
   BasicModelBuilder* builder = static_cast<BasicModelBuilder*>(clientData);
 
-  SectionBuilder* fiberSectionRepr = findSectionBuilder(builder, interp, argc, argv);
+  SectionBuilder* fiberSectionRepr = findSectionBuilder(builder, interp, argc, objv);
   if (fiberSectionRepr == nullptr) {
     opserr << OpenSees::PromptValueError << "cannot retrieve a section builder\n";
     return TCL_ERROR;
@@ -1074,10 +1118,10 @@ TclCommand_addFiber(ClientData clientData, Tcl_Interp *interp, int argc,
   double warp[WarpModeCount][3]{};
   int warp_arg = -1;
   for (int i=1; i<argc; i++) {
-    if (strcmp(argv[i], "-section") == 0) {
+    if (strcmp(Tcl_GetString(objv[i]), "-section") == 0) {
       ++i;
     }
-    else if (strcmp(argv[i], "-warp") == 0) {
+    else if (strcmp(Tcl_GetString(objv[i]), "-warp") == 0) {
       if (i + 1 >= argc) {
         opserr << OpenSees::PromptValueError << "missing warp argument\n";
         return TCL_ERROR;
@@ -1085,29 +1129,29 @@ TclCommand_addFiber(ClientData clientData, Tcl_Interp *interp, int argc,
       warp_arg = i+1;
       i++;
     }
-    else if (strcmp(argv[i], "-material") == 0) {
-      if (argc == ++i || Tcl_GetInt(interp, argv[i], &matTag) != TCL_OK) {
+    else if (strcmp(Tcl_GetString(objv[i]), "-material") == 0) {
+      if (argc == ++i || Tcl_GetIntFromObj(interp, objv[i], &matTag) != TCL_OK) {
         opserr << OpenSees::PromptValueError << "invalid material tag\n";
         return TCL_ERROR;
       }
       tracker.consume(Position::Material);
     }
-    else if (strcmp(argv[i], "-area") == 0) {
-      if (argc == ++i || Tcl_GetDouble(interp, argv[i], &area) != TCL_OK) {
+    else if (strcmp(Tcl_GetString(objv[i]), "-area") == 0) {
+      if (argc == ++i || Tcl_GetDoubleFromObj(interp, objv[i], &area) != TCL_OK) {
         opserr << OpenSees::PromptValueError << "invalid area\n";
         return TCL_ERROR;
       }
       tracker.consume(Position::Area);
     }
-    else if (strcmp(argv[i], "-y") == 0) {
-      if (argc == ++i || Tcl_GetDouble(interp, argv[i], &yLoc) != TCL_OK) {
+    else if (strcmp(Tcl_GetString(objv[i]), "-y") == 0) {
+      if (argc == ++i || Tcl_GetDoubleFromObj(interp, objv[i], &yLoc) != TCL_OK) {
         opserr << OpenSees::PromptValueError << "invalid y coordinate\n";
         return TCL_ERROR;
       }
       tracker.consume(Position::Y);
     }
-    else if (strcmp(argv[i], "-z") == 0) {
-      if (argc == ++i || Tcl_GetDouble(interp, argv[i], &zLoc) != TCL_OK) {
+    else if (strcmp(Tcl_GetString(objv[i]), "-z") == 0) {
+      if (argc == ++i || Tcl_GetDoubleFromObj(interp, objv[i], &zLoc) != TCL_OK) {
         opserr << OpenSees::PromptValueError << "invalid z coordinate\n";
         return TCL_ERROR;
       }
@@ -1121,28 +1165,28 @@ TclCommand_addFiber(ClientData clientData, Tcl_Interp *interp, int argc,
   for (int i: positional) {
     switch (tracker.current()) {
       case Position::Y:
-        if (Tcl_GetDouble(interp, argv[i], &yLoc) != TCL_OK) {
+        if (Tcl_GetDoubleFromObj(interp, objv[i], &yLoc) != TCL_OK) {
           opserr << OpenSees::PromptValueError << "invalid y coordinate\n";
           return TCL_ERROR;
         }
         tracker.consume(Position::Y);
         break;
       case Position::Z:
-        if (Tcl_GetDouble(interp, argv[i], &zLoc) != TCL_OK) {
+        if (Tcl_GetDoubleFromObj(interp, objv[i], &zLoc) != TCL_OK) {
           opserr << OpenSees::PromptValueError << "invalid z coordinate\n";
           return TCL_ERROR;
         }
         tracker.consume(Position::Z);
         break;
       case Position::Area:
-        if (Tcl_GetDouble(interp, argv[i], &area) != TCL_OK) {
+        if (Tcl_GetDoubleFromObj(interp, objv[i], &area) != TCL_OK) {
           opserr << OpenSees::PromptValueError << "invalid area\n";
           return TCL_ERROR;
         }
         tracker.consume(Position::Area);
         break;
       case Position::Material:
-        if (Tcl_GetInt(interp, argv[i], &matTag) != TCL_OK) {
+        if (Tcl_GetIntFromObj(interp, objv[i], &matTag) != TCL_OK) {
           opserr << OpenSees::PromptValueError << "invalid material tag\n";
           return TCL_ERROR;
         }
@@ -1185,41 +1229,30 @@ TclCommand_addFiber(ClientData clientData, Tcl_Interp *interp, int argc,
   // process warping
   //
   int i_warp = 0;
-  int          split_1_argc;
-  const char **split_1_argv;
-  if (warp_arg >= 0 && Tcl_SplitList(interp, argv[warp_arg], &split_1_argc, &split_1_argv) == TCL_OK) {
-    int argi = 0;
-    for (; i_warp<WarpModeCount; i_warp++) {
-      if (argi >= split_1_argc)
-        break;
-
-      //
-      int          split_argc;
-      const char **split_argv;
-      if (Tcl_SplitList(interp, split_1_argv[argi], &split_argc, &split_argv) != TCL_OK) {
+  int       modec;
+  Tcl_Obj **modev;
+  if (warp_arg >= 0 && Tcl_ListObjGetElements(interp, objv[warp_arg], &modec, &modev) == TCL_OK) {
+    for (; i_warp<WarpModeCount && i_warp<modec; i_warp++) {
+      int       valuec;
+      Tcl_Obj **valuev;
+      if (Tcl_ListObjGetElements(interp, modev[i_warp], &valuec, &valuev) != TCL_OK) {
         opserr << OpenSees::PromptValueError << "invalid warp\n";
         return TCL_ERROR;
       }
 
-      if (split_argc != 3) {
+      if (valuec != 3) {
         opserr << "WARNING warp parameter expected list of 3 floats\n";
-          Tcl_Free((char *) split_argv);
-          return TCL_ERROR;
+        return TCL_ERROR;
       }
 
       for (int j = 0; j < 3; j++) {
-        if (Tcl_GetDouble(interp, split_argv[j], &warp[i_warp][j]) != TCL_OK) {
+        if (Tcl_GetDoubleFromObj(interp, valuev[j], &warp[i_warp][j]) != TCL_OK) {
           opserr << OpenSees::PromptValueError << "invalid warp\n";
-          Tcl_Free((char *) split_argv);
           return TCL_ERROR;
         }
       }
-
-      // Free memory allocated by Tcl_SplitList.
-      Tcl_Free((char *) split_argv);
-      argi++;
     }
-}
+  }
   //
   // Add fiber to section builder
   //
@@ -0,0 +1,121 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file provides the profile command, which controls the
+// analysis profiler and reports the time spent in each phase.
+//
+//   profile start
+//   profile stop
+//   profile reset
+//   profile dump ?-file $path? ?-dict?
+//
+// With -dict, dump returns a dictionary instead of printing a table; each
+// phase maps to a dictionary of count, total, min, max and children, and
+// each class to one of count, total, min and max.
+//
+// Written: cmp
+//
+#include <string.h>
+#include <fstream>
+#include <tcl.h>
+#include <Profiler.h>
+#include <Logging.h>
+
+
+static Tcl_Obj *
+statsObj(Tcl_Interp *interp, const Profiler::Stats &stats)
+{
+  Tcl_Obj *dict = Tcl_NewDictObj();
+  Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("count", -1), Tcl_NewLongObj(stats.count));
+  Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("total", -1), Tcl_NewDoubleObj(stats.total));
+  Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("min",   -1), Tcl_NewDoubleObj(stats.min));
+  Tcl_DictObjPut(interp, dict, Tcl_NewStringObj("max",   -1), Tcl_NewDoubleObj(stats.max));
+  return dict;
+}
+
+static Tcl_Obj *
+phasesObj(Tcl_Interp *interp, const std::vector<Profiler::Phase> &phases, int parent)
+{
+  Tcl_Obj *dict = Tcl_NewDictObj();
+  for (int child : phases[parent].children) {
+    Tcl_Obj *phase = statsObj(interp, phases[child].stats);
+    Tcl_DictObjPut(interp, phase, Tcl_NewStringObj("children", -1),
+                   phasesObj(interp, phases, child));
+    Tcl_DictObjPut(interp, dict, Tcl_NewStringObj(phases[child].name, -1), phase);
+  }
+  return dict;
+}
+
+
+int
+TclObjCommand_profile(ClientData clientData, Tcl_Interp *interp, int objc, Tcl_Obj* const*objv)
+{
+  if (objc < 2) {
+    Tcl_WrongNumArgs(interp, 1, objv, "start|stop|reset|dump ?options?");
+    return TCL_ERROR;
+  }
+
+  Profiler &profiler = Profiler::get();
+  const char *action = Tcl_GetString(objv[1]);
+
+  if (strcmp(action, "start") == 0) {
+    profiler.start();
+    return TCL_OK;
+
+  } else if (strcmp(action, "stop") == 0) {
+    profiler.stop();
+    return TCL_OK;
+
+  } else if (strcmp(action, "reset") == 0) {
+    profiler.reset();
+    return TCL_OK;
+
+  } else if (strcmp(action, "dump") == 0) {
+    const char *path = nullptr;
+    bool asDict = false;
+    for (int i=2; i<objc; i++) {
+      const char *arg = Tcl_GetString(objv[i]);
+      if (strcmp(arg, "-dict") == 0)
+        asDict = true;
+      else if (strcmp(arg, "-file") == 0 && i+1 < objc)
+        path = Tcl_GetString(objv[++i]);
+      else {
+        opserr << OpenSees::PromptValueError << "unexpected argument '" << arg << "'\n";
+        return TCL_ERROR;
+      }
+    }
+
+    if (asDict) {
+      Tcl_Obj *classes = Tcl_NewDictObj();
+      for (const auto &entry : profiler.getClassStats())
+        Tcl_DictObjPut(interp, classes, Tcl_NewStringObj(entry.first.c_str(), -1),
+                       statsObj(interp, entry.second));
+
+      Tcl_Obj *result = Tcl_NewDictObj();
+      Tcl_DictObjPut(interp, result, Tcl_NewStringObj("phases", -1),
+                     phasesObj(interp, profiler.getPhases(), 0));
+      Tcl_DictObjPut(interp, result, Tcl_NewStringObj("classes", -1), classes);
+      Tcl_SetObjResult(interp, result);
+      return TCL_OK;
+    }
+
+    const std::string report = profiler.report();
+    if (path != nullptr) {
+      std::ofstream file(path);
+      if (!file) {
+        opserr << OpenSees::PromptValueError << "failed to open file " << path << "\n";
+        return TCL_ERROR;
+      }
+      file << report;
+    } else
+      opserr << report.c_str();
+
+    return TCL_OK;
+  }
+
+  opserr << OpenSees::PromptValueError << "unknown action '" << action << "'\n";
+  return TCL_ERROR;
+}
@@ -185,7 +185,7 @@ public:
 
 
 static py::array_t<double>
-copy_vector(Vector vector)
+copy_vector(const Vector &vector)
 {
   py::array_t<double> array(vector.Size());
   double *ptr = static_cast<double*>(array.request().ptr);
@@ -202,7 +202,7 @@ new_vector(py::array_t<double> array)
 }
 
 py::array_t<double>
-copy_matrix(Matrix matrix)
+copy_matrix(const Matrix &matrix)
 {
   int nr = matrix.noRows();
   int nc = matrix.noCols();
@@ -216,6 +216,53 @@ copy_matrix(Matrix matrix)
 }
 
 
+static NodeData
+node_data(const std::string &type)
+{
+  if (type == "displ") return NodeData::Disp;
+  if (type == "accel") return NodeData::Accel;
+  if (type == "veloc") return NodeData::Vel;
+  if (type == "react") return NodeData::Reaction;
+  throw py::value_error("unknown node response " + type);
+}
+
+//
+// Gather the responses of a set of nodes or elements directly into one
+// (n, m) array, without an intermediate Vector or Python object per value.
+// Every node or element must return m values.
+//
+template <typename Response>
+static py::array_t<double>
+gather_responses(py::array_t<int, ARRAY_FLAGS> tags, Response response)
+{
+  const int *tag = tags.data();
+  const py::ssize_t n = tags.size();
+
+  py::array_t<double> array;
+  double *ptr = nullptr;
+  py::ssize_t m = 0;
+  for (py::ssize_t i=0; i<n; i++) {
+    const Vector *data = response(tag[i]);
+    if (data == nullptr)
+      throw py::key_error("no response for tag " + std::to_string(tag[i]));
+
+    if (ptr == nullptr) {
+      m = data->Size();
+      array = py::array_t<double>({n, m});
+      ptr = array.mutable_data();
+    } else if (data->Size() != m)
+      throw py::value_error("responses differ in size at tag " + std::to_string(tag[i]));
+
+    for (py::ssize_t j=0; j<m; j++)
+      ptr[i*m+j] = (*data)(j);
+  }
+
+  if (ptr == nullptr)
+    array = py::array_t<double>({n, m});
+  return array;
+}
+
+
 GroundMotion*
 quake2sees_motion(
     py::array_t<double,ARRAY_FLAGS> quake_array, 
@@ -491,12 +538,21 @@ init_obj_module(py::module &m)
   py::class_<Domain>(m, "_Domain")
     // .def ("getElementResponse", &Domain::getElementResponse)
     .def ("getNodeResponse", [](Domain& domain, int node, std::string type) {
-        NodeData typ;
-        if (type == "displ") typ = NodeData::Disp;
-        if (type == "accel") typ = NodeData::Accel;
-        if (type == "veloc") typ = NodeData::Vel;
-        if (type == "react") typ = NodeData::Reaction;
-      return copy_vector(*domain.getNodeResponse(node, typ));
+      return copy_vector(*domain.getNodeResponse(node, node_data(type)));
+    })
+    .def ("getNodeResponses", [](Domain& domain, py::array_t<int, ARRAY_FLAGS> nodes, std::string type) {
+      const NodeData typ = node_data(type);
+      return gather_responses(nodes, [&](int tag) {
+        return domain.getNodeResponse(tag, typ);
+      });
+    })
+    .def ("getElementResponses", [](Domain& domain, py::array_t<int, ARRAY_FLAGS> elements, std::vector<std::string> args) {
+      std::vector<const char *> argv;
+      for (const std::string &arg : args)
+        argv.push_back(arg.c_str());
+      return gather_responses(elements, [&](int tag) {
+        return domain.getElementResponse(tag, argv.data(), (int)argv.size());
+      });
     })
     .def ("getTime", &Domain::getCurrentTime)
   ;
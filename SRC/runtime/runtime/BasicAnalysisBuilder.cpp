@@ -13,6 +13,7 @@
 #include "BasicAnalysisBuilder.h"
 #include <Domain.h>
 #include <G3_Logging.h>
+#include <Profiler.h>
 // Abstract classes
 #include <EquiSolnAlgo.h>
 #include <StaticIntegrator.h>
@@ -31,6 +32,7 @@
 #include <FE_Element.h>
 #include <DOF_Group.h>
 #include <DOF_GrpIter.h>
+#include <ID.h>
 
 // Default concrete analysis classes
 #include <Newmark.h>
@@ -41,6 +43,7 @@
 #include <FullGenEigenSOE.h>
 #include <ArpackSOE.h>
 #include <ProfileSPDLinSOE.h>
+#include <MatrixFreeLinSOE.h>
 #include <NewtonRaphson.h>
 #include <RCM.h>
 #include <LoadControl.h>
@@ -127,6 +130,7 @@ BasicAnalysisBuilder::wipe()
     delete theAnalysisModel;
     theAnalysisModel = new AnalysisModel();
   }
+  numberingStamp++;
 }
 
 void
@@ -144,6 +148,11 @@ BasicAnalysisBuilder::setLinks(CurrentAnalysis flag)
   if (theTest && theAlgorithm)
     theAlgorithm->setConvergenceTest(theTest);
 
+  // the matrix-free system forms its products with the factors of the
+  // current integrator
+  MatrixFreeLinSOE *theMatrixFree = dynamic_cast<MatrixFreeLinSOE*>(theSOE);
+  if (theMatrixFree != nullptr)
+    theMatrixFree->setIntegrator(nullptr);
 
   switch (flag) {
   case EMPTY_ANALYSIS:
@@ -159,6 +168,9 @@ BasicAnalysisBuilder::setLinks(CurrentAnalysis flag)
     if (theAnalysisModel && theSOE && theTest && theTransientIntegrator) {
       theTransientIntegrator->setLinks(*theAnalysisModel, *theSOE, theTest);
     }
+
+    if (theMatrixFree != nullptr)
+      theMatrixFree->setIntegrator(theTransientIntegrator);
     // if (theTransientIntegrator && domainStamp != 0)
     //   theTransientIntegrator->domainChanged();
       // this->domainChanged();
@@ -174,6 +186,9 @@ BasicAnalysisBuilder::setLinks(CurrentAnalysis flag)
     if (theAnalysisModel && theSOE && theTest && theStaticIntegrator)
       theStaticIntegrator->setLinks(*theAnalysisModel, *theSOE, theTest);
 
+    if (theMatrixFree != nullptr)
+      theMatrixFree->setIntegrator(theStaticIntegrator);
+
     if (theAnalysisModel && theStaticIntegrator && theSOE && theTest && theAlgorithm)
       theAlgorithm->setLinks(*theAnalysisModel, *theStaticIntegrator, *theSOE, theTest);
 
@@ -243,6 +258,7 @@ BasicAnalysisBuilder::domainChanged(void)
     // Invoke number() on the numberer which causes
     // equation numbers to be assigned to all the DOFs in the
     // AnalysisModel.
+    numberingStamp++;
     if (theNumberer != nullptr && theNumberer->numberDOF() < 0) {
       opserr << "BasicAnalysisBuilder::domainChange() - DOF_Numberer::numberDOF() failed\n";
       return -2;
@@ -333,6 +349,8 @@ BasicAnalysisBuilder::analyzeStatic(int numSteps, int flag)
   int result = 0;
 
   for (int i=0; i<numSteps; i++) {
+      Profiler::Scope step("step");
+
       // This is used for parallelization
       result = theAnalysisModel->analysisStep(0.0);
       if (result < 0) {
@@ -349,6 +367,7 @@ BasicAnalysisBuilder::analyzeStatic(int numSteps, int flag)
       int stamp = theDomain->hasDomainChanged();
 
       if (stamp != domainStamp) {
+        Profiler::Scope scope("domainChanged");
         domainStamp = stamp;
         result = this->domainChanged();
         if (result < 0) {
@@ -359,6 +378,7 @@ BasicAnalysisBuilder::analyzeStatic(int numSteps, int flag)
       }
 
       if (flag & Increment) {
+        Profiler::Scope scope("newStep");
         result = theStaticIntegrator->newStep();
         if (result < 0) {
           opserr << "The Integrator failed at step: " << i
@@ -370,6 +390,7 @@ BasicAnalysisBuilder::analyzeStatic(int numSteps, int flag)
       }
 
       if (flag & Iterate) {
+        Profiler::Scope scope("solveCurrentStep");
         result = theAlgorithm->solveCurrentStep();
         if (result < 0) {
           // Print error message if we have one
@@ -383,6 +404,7 @@ BasicAnalysisBuilder::analyzeStatic(int numSteps, int flag)
       }
 
       if (theStaticIntegrator->shouldComputeAtEachStep()) {
+        Profiler::Scope scope("computeSensitivities");
         result = theStaticIntegrator->computeSensitivities();
         if (result < 0) {
           opserr << "StaticAnalysis::analyze() - the SensitivityAlgorithm failed";
@@ -395,6 +417,7 @@ BasicAnalysisBuilder::analyzeStatic(int numSteps, int flag)
       }
 
       if (flag & Commit) {
+        Profiler::Scope scope("commit");
         result = theStaticIntegrator->commit();
         if (result < 0) {
           opserr << "StaticAnalysis::analyze - ";
@@ -457,6 +480,8 @@ BasicAnalysisBuilder::analyzeSubLevel(int level, double dT)
 int
 BasicAnalysisBuilder::analyzeStep(double dT)
 {
+  Profiler::Scope step("step");
+
   int result = 0;
   if (theAnalysisModel->analysisStep(dT) < 0) {
     opserr << "DirectIntegrationAnalysis::analyze() - the AnalysisModel failed";
@@ -468,6 +493,7 @@ BasicAnalysisBuilder::analyzeStep(double dT)
   // check if domain has undergone change
   int stamp = theDomain->hasDomainChanged();
   if (stamp != domainStamp) {
+    Profiler::Scope scope("domainChanged");
     domainStamp = stamp;
     if (this->domainChanged() < 0) {
       opserr << "DirectIntegrationAnalysis::analyze() - domainChanged() failed\n";
@@ -475,7 +501,11 @@ BasicAnalysisBuilder::analyzeStep(double dT)
     }
   }
 
-  if (theTransientIntegrator->newStep(dT) < 0) {
+  {
+    Profiler::Scope scope("newStep");
+    result = theTransientIntegrator->newStep(dT);
+  }
+  if (result < 0) {
     opserr << "DirectIntegrationAnalysis::analyze() - the Integrator failed";
     opserr << " at time " << theDomain->getCurrentTime() << "\n";
     theDomain->revertToLastCommit();
@@ -483,7 +513,10 @@ BasicAnalysisBuilder::analyzeStep(double dT)
     return -2;
   }
 
-  result = theAlgorithm->solveCurrentStep();
+  {
+    Profiler::Scope scope("solveCurrentStep");
+    result = theAlgorithm->solveCurrentStep();
+  }
   if (result < 0) {
     if (AnalyzeFailedMessage.find(result) != AnalyzeFailedMessage.end()) {
         opserr << OpenSees::PromptAnalysisFailure << AnalyzeFailedMessage[result];
@@ -494,6 +527,7 @@ BasicAnalysisBuilder::analyzeStep(double dT)
   }
 
   if (theTransientIntegrator->shouldComputeAtEachStep()) {
+    Profiler::Scope scope("computeSensitivities");
     result = theTransientIntegrator->computeSensitivities();
     if (result < 0) {
       opserr << "TransientAnalysis::analyze() - the SensitivityAlgorithm failed";
@@ -504,7 +538,10 @@ BasicAnalysisBuilder::analyzeStep(double dT)
     }    
   }
 
-  result = theTransientIntegrator->commit();
+  {
+    Profiler::Scope scope("commit");
+    result = theTransientIntegrator->commit();
+  }
   if (result < 0) {
     opserr << "DirectIntegrationAnalysis::analyze() - ";
     opserr << "the Integrator failed to commit";
@@ -642,6 +679,30 @@ BasicAnalysisBuilder::set(ConstraintHandler* obj)
   theHandler = obj;
 }
 
+const std::vector<BasicAnalysisBuilder::NodeDOF> &
+BasicAnalysisBuilder::getEquationMap()
+{
+  if (equationMapStamp == numberingStamp)
+    return equationMap;
+
+  const int numEqn = theAnalysisModel->getNumEqn();
+  equationMap.assign(numEqn > 0 ? numEqn : 0, NodeDOF{-1, -1});
+
+  DOF_GrpIter &theDOFs = theAnalysisModel->getDOFs();
+  DOF_Group *dofPtr;
+  while ((dofPtr = theDOFs()) != nullptr) {
+    const ID &id = dofPtr->getID();
+    for (int i = 0; i < id.Size(); i++) {
+      const int eqn = id(i);
+      if (eqn >= 0 && eqn < numEqn && equationMap[eqn].node == -1)
+        equationMap[eqn] = NodeDOF{dofPtr->getNodeTag(), i};
+    }
+  }
+
+  equationMapStamp = numberingStamp;
+  return equationMap;
+}
+
 void
 BasicAnalysisBuilder::set(DOF_Numberer* obj)
 {
@@ -927,6 +988,7 @@ BasicAnalysisBuilder::eigen(int numMode, bool generalized, bool findSmallest)
     // Now invoke number() on the numberer which causes
     // equation numbers to be assigned to all the DOFs in the
     // AnalysisModel.
+    numberingStamp++;
     result = theNumberer->numberDOF();
 
     result = theHandler->doneNumberingDOF();
@@ -27,6 +27,8 @@
 #ifndef BasicAnalysisBulider_h
 #define BasicAnalysisBulider_h
 
+#include <vector>
+
 class Domain;
 class G3_Table;
 class ConstraintHandler;
@@ -89,6 +91,14 @@ public:
 
     int domainChanged();
 
+    // Node and DOF (from 0) of each equation of the current numbering.
+    // Equations without a node map to {-1, -1}. The map is formed on the
+    // first call after the equations are numbered.
+    struct NodeDOF {
+      int node, dof;
+    };
+    const std::vector<NodeDOF> &getEquationMap();
+
     // Performing analysis
     int analyze(int num_steps, double size_steps, int flag=Increment|Iterate|Commit);
     int analyzeStatic(int num_steps, int flag);
@@ -119,6 +129,11 @@ private:
     ConvergenceTest           *theTest;
 
     int domainStamp;
+
+    // incremented whenever the equations are renumbered
+    int numberingStamp = 0;
+    int equationMapStamp = -1;
+    std::vector<NodeDOF> equationMap;
     int numEigen = 0;
 
     int numSubLevels = 0;
@@ -43,6 +43,7 @@ BasicModelBuilder::BasicModelBuilder(Domain &domain, Tcl_Interp *interp,
       next_node_load(0)// , next_elem_load(0)
 {
   static int ncmd = sizeof(tcl_char_cmds)/sizeof(char_cmd);
+  static int nobj = sizeof(tcl_obj_cmds)/sizeof(obj_cmd);
 
   Tcl_CreateCommand(interp, "wipe", TclCommand_wipeModel, (ClientData)this, nullptr);
 
@@ -51,6 +52,12 @@ BasicModelBuilder::BasicModelBuilder(Domain &domain, Tcl_Interp *interp,
         tcl_char_cmds[i].name, 
         tcl_char_cmds[i].func, 
         (ClientData) this, nullptr);
+
+  for (int i = 0; i < nobj; i++)
+    Tcl_CreateObjCommand(interp, 
+        tcl_obj_cmds[i].name, 
+        tcl_obj_cmds[i].func, 
+        (ClientData) this, nullptr);
  
   tclEnclosingPattern = nullptr;
 
@@ -75,6 +82,10 @@ BasicModelBuilder::~BasicModelBuilder()
   static int ncmd = sizeof(tcl_char_cmds)/sizeof(char_cmd);
   for (int i = 0; i < ncmd; i++)
     Tcl_DeleteCommand(theInterp, tcl_char_cmds[i].name);
+
+  static int nobj = sizeof(tcl_obj_cmds)/sizeof(obj_cmd);
+  for (int i = 0; i < nobj; i++)
+    Tcl_DeleteCommand(theInterp, tcl_obj_cmds[i].name);
 }
 
 
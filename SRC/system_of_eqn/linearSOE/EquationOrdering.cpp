@@ -0,0 +1,362 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Implementation of EquationOrdering. The reverse
+// Cuthill-McKee ordering follows George and Liu (1981); the profile
+// reduction follows Sloan (1986), with the weights W1 = 2, W2 = 1 he
+// recommends. Both start each connected component from a
+// pseudo-peripheral vertex.
+//
+// Written: cmp
+//
+#include <EquationOrdering.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <VertexIter.h>
+#include <ID.h>
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+namespace {
+
+// Breadth first search from root over the vertices not yet done. The
+// vertices are returned by level in nodes, with level l in
+// nodes[start[l]] ... nodes[start[l+1]-1]; depth is stored for every
+// vertex reached.
+struct LevelStructure {
+  std::vector<int> nodes, start, depth;
+
+  void build(int root, const std::vector<int> &xadj, const std::vector<int> &adj,
+             const std::vector<char> &done)
+  {
+    const int n = (int)xadj.size() - 1;
+    if ((int)depth.size() != n)
+      depth.assign(n, -1);
+    for (int v : nodes)
+      depth[v] = -1;
+    nodes.clear();
+    start.clear();
+
+    nodes.push_back(root);
+    depth[root] = 0;
+    start.push_back(0);
+    std::size_t begin = 0;
+    while (begin < nodes.size()) {
+      std::size_t end = nodes.size();
+      for (std::size_t k = begin; k < end; k++) {
+        int v = nodes[k];
+        for (int l = xadj[v]; l < xadj[v+1]; l++) {
+          int w = adj[l];
+          if (depth[w] < 0 && !done[w]) {
+            depth[w] = depth[v] + 1;
+            nodes.push_back(w);
+          }
+        }
+      }
+      start.push_back((int)end);
+      begin = end;
+    }
+  }
+
+  int levels() const {return (int)start.size() - 1;}
+};
+
+// Find a pseudo-peripheral vertex in the component of root; other is
+// set to a vertex of minimum degree in the last level of its level
+// structure, i.e. one that is far from it. The level structures are
+// passed in so their storage is reused across components.
+int
+peripheral(int root, const std::vector<int> &xadj, const std::vector<int> &adj,
+           const std::vector<char> &done, LevelStructure &levels, LevelStructure &next,
+           int *other)
+{
+  levels.build(root, xadj, adj, done);
+
+  int x = root;
+  while (true) {
+    // vertex of minimum degree in the last level
+    int last = levels.levels() - 1;
+    int y = levels.nodes[levels.start[last]];
+    for (int k = levels.start[last]; k < levels.start[last+1]; k++) {
+      int w = levels.nodes[k];
+      if (xadj[w+1]-xadj[w] < xadj[y+1]-xadj[y])
+        y = w;
+    }
+
+    next.build(y, xadj, adj, done);
+    if (next.levels() > levels.levels()) {
+      x = y;
+      std::swap(levels, next);
+      continue;
+    }
+
+    *other = y;
+    return x;
+  }
+}
+
+} // namespace
+
+
+EquationOrdering::EquationOrdering(Method m, Measure s)
+ : method(m), applied(None), measure(s), originalSize(0), reorderedSize(0)
+{
+
+}
+
+
+const char *
+EquationOrdering::name(Method m)
+{
+  switch (m) {
+    case RCM:       return "RCM";
+    case Sloan:     return "Sloan";
+    case Automatic: return "Automatic";
+    default:        return "None";
+  }
+}
+
+
+int
+EquationOrdering::setGraph(Graph &theGraph)
+{
+  const int n = theGraph.getNumVertex();
+
+  perm.clear();
+  iperm.clear();
+  applied = None;
+
+  // gather the adjacency in compressed rows; vertices are tagged by
+  // their equation number
+  std::vector<int> degree(n+1, 0);
+  Vertex *vertexPtr;
+  VertexIter &countVertices = theGraph.getVertices();
+  while ((vertexPtr = countVertices()) != nullptr) {
+    int v = vertexPtr->getTag();
+    if (v < 0 || v >= n)
+      continue;
+    const ID &theAdjacency = vertexPtr->getAdjacency();
+    for (int i=0; i<theAdjacency.Size(); i++) {
+      int w = theAdjacency(i);
+      if (w >= 0 && w < n && w != v)
+        degree[v]++;
+    }
+  }
+
+  xadj.assign(n+1, 0);
+  for (int v=0; v<n; v++)
+    xadj[v+1] = xadj[v] + degree[v];
+  adj.resize(xadj[n]);
+
+  VertexIter &theVertices = theGraph.getVertices();
+  while ((vertexPtr = theVertices()) != nullptr) {
+    int v = vertexPtr->getTag();
+    if (v < 0 || v >= n)
+      continue;
+    const ID &theAdjacency = vertexPtr->getAdjacency();
+    int k = xadj[v];
+    for (int i=0; i<theAdjacency.Size(); i++) {
+      int w = theAdjacency(i);
+      if (w >= 0 && w < n && w != v)
+        adj[k++] = w;
+    }
+  }
+
+  std::vector<int> identity(n);
+  for (int i=0; i<n; i++)
+    identity[i] = i;
+  originalSize  = this->storage(identity);
+  reorderedSize = originalSize;
+
+  if (method == None || n < 3)
+    return 0;
+
+  std::vector<int> best;
+  long bestSize = originalSize;
+
+  if (method == RCM || method == Automatic) {
+    std::vector<int> order;
+    this->cuthillMcKee(order);
+    long size = this->storage(order);
+    if (method == RCM || size < bestSize) {
+      best.swap(order);
+      bestSize = size;
+      applied  = RCM;
+    }
+  }
+
+  if (method == Sloan || method == Automatic) {
+    std::vector<int> order;
+    this->sloan(order);
+    long size = this->storage(order);
+    if (method == Sloan || size < bestSize) {
+      best.swap(order);
+      bestSize = size;
+      applied  = Sloan;
+    }
+  }
+
+  if (best.empty())
+    return 0;
+
+  iperm.swap(best);
+  perm.resize(n);
+  for (int i=0; i<n; i++)
+    perm[iperm[i]] = i;
+  reorderedSize = bestSize;
+
+  return 0;
+}
+
+
+//
+// Number of entries of A stored when equation order[i] is placed at i
+//
+long
+EquationOrdering::storage(const std::vector<int> &order) const
+{
+  const int n = (int)order.size();
+  std::vector<int> position(n);
+  for (int i=0; i<n; i++)
+    position[order[i]] = i;
+
+  long total = 0;
+  int band = 0;
+  for (int i=0; i<n; i++) {
+    int v = order[i];
+    int top = i;
+    for (int k = xadj[v]; k < xadj[v+1]; k++)
+      top = std::min(top, position[adj[k]]);
+    total += i - top + 1;
+    band = std::max(band, i - top);
+  }
+
+  if (measure == Bandwidth)
+    return (long)(band + 1) * n;
+
+  return total;
+}
+
+
+void
+EquationOrdering::cuthillMcKee(std::vector<int> &order)
+{
+  const int n = (int)xadj.size() - 1;
+  order.clear();
+  order.reserve(n);
+  std::vector<char> done(n, 0);
+  LevelStructure levels, scratch;
+
+  auto degree = [&](int v) {return xadj[v+1] - xadj[v];};
+
+  for (int root=0; root<n; root++) {
+    if (done[root])
+      continue;
+
+    int other;
+    int start = peripheral(root, xadj, adj, done, levels, scratch, &other);
+
+    std::size_t head = order.size();
+    order.push_back(start);
+    done[start] = 1;
+    std::vector<int> neighbors;
+    while (head < order.size()) {
+      int v = order[head++];
+      neighbors.clear();
+      for (int k = xadj[v]; k < xadj[v+1]; k++)
+        if (!done[adj[k]]) {
+          neighbors.push_back(adj[k]);
+          done[adj[k]] = 1;
+        }
+      std::stable_sort(neighbors.begin(), neighbors.end(),
+                       [&](int a, int b) {return degree(a) < degree(b);});
+      order.insert(order.end(), neighbors.begin(), neighbors.end());
+    }
+  }
+
+  std::reverse(order.begin(), order.end());
+}
+
+
+void
+EquationOrdering::sloan(std::vector<int> &order)
+{
+  const int n = (int)xadj.size() - 1;
+  const int W1 = 2, W2 = 1;
+
+  enum Status : char {Inactive, Preactive, Active, Postactive};
+
+  order.clear();
+  order.reserve(n);
+  std::vector<char> done(n, 0);
+  std::vector<char> status(n, Inactive);
+  std::vector<int>  priority(n, 0);
+  LevelStructure fromEnd, scratch;
+
+  // entries are (priority, vertex); stale entries are skipped on pop
+  typedef std::pair<int,int> Entry;
+  std::priority_queue<Entry> queue;
+
+  for (int root=0; root<n; root++) {
+    if (done[root])
+      continue;
+
+    int end;
+    int start = peripheral(root, xadj, adj, done, fromEnd, scratch, &end);
+
+    // distance to the end vertex gives the global part of the priority
+    fromEnd.build(end, xadj, adj, done);
+    for (int v : fromEnd.nodes)
+      priority[v] = W1*fromEnd.depth[v] - W2*(xadj[v+1] - xadj[v] + 1);
+
+    status[start] = Preactive;
+    queue.push(Entry(priority[start], start));
+
+    while (!queue.empty()) {
+      Entry top = queue.top();
+      queue.pop();
+      int i = top.second;
+      if (status[i] == Postactive || top.first != priority[i])
+        continue;
+
+      if (status[i] == Preactive) {
+        for (int k = xadj[i]; k < xadj[i+1]; k++) {
+          int j = adj[k];
+          priority[j] += W2;
+          if (status[j] == Inactive)
+            status[j] = Preactive;
+          if (status[j] != Postactive)
+            queue.push(Entry(priority[j], j));
+        }
+      }
+
+      order.push_back(i);
+      status[i] = Postactive;
+
+      for (int k = xadj[i]; k < xadj[i+1]; k++) {
+        int j = adj[k];
+        if (status[j] != Preactive)
+          continue;
+        status[j] = Active;
+        priority[j] += W2;
+        queue.push(Entry(priority[j], j));
+        for (int l = xadj[j]; l < xadj[j+1]; l++) {
+          int m = adj[l];
+          if (status[m] == Postactive)
+            continue;
+          priority[m] += W2;
+          if (status[m] == Inactive)
+            status[m] = Preactive;
+          queue.push(Entry(priority[m], m));
+        }
+      }
+    }
+
+    for (int v : fromEnd.nodes)
+      done[v] = 1;
+  }
+}
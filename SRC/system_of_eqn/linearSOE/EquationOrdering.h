@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: EquationOrdering is a permutation of the equations that a
+// profile or band LinearSOE applies internally, so that the storage of A
+// does not depend on the numberer chosen for the analysis. It is computed
+// in setSize from the adjacency of the DOF graph with the reverse
+// Cuthill-McKee or the Sloan algorithm. With Automatic, both are tried
+// and the one giving the least storage is kept, but only if it improves
+// on the numbering given by the analysis.
+//
+// The owning SOE maps every equation number it receives through
+// operator() before it addresses A, B or X; equation numbers outside
+// [0, n), e.g. -1 for constrained DOFs, are returned unchanged.
+//
+// Written: cmp
+//
+#ifndef EquationOrdering_h
+#define EquationOrdering_h
+
+#include <vector>
+
+class Graph;
+
+class EquationOrdering
+{
+  public:
+    enum Method {
+      None,
+      RCM,
+      Sloan,
+      Automatic
+    };
+
+    // storage scheme whose size is minimized
+    enum Measure {
+      Profile,      // sum of column heights
+      Bandwidth     // half band times number of equations
+    };
+
+    EquationOrdering(Method method=None, Measure measure=Profile);
+
+    int setGraph(Graph &theGraph);
+
+    void   setMethod(Method method) {this->method = method;}
+    Method getMethod() const {return method;}
+    // the method that produced the current permutation (None if identity)
+    Method getApplied() const {return applied;}
+
+    bool isIdentity() const {return perm.empty();}
+
+    // internal equation of equation eqn of the analysis
+    int operator()(int eqn) const {
+      return (perm.empty() || eqn < 0 || eqn >= (int)perm.size()) ? eqn : perm[eqn];
+    }
+    // equation of the analysis stored in internal equation i
+    int original(int i) const {
+      return (perm.empty() || i < 0 || i >= (int)perm.size()) ? i : iperm[i];
+    }
+
+    // entries of A stored with the numbering of the analysis and with
+    // the numbering actually used
+    long getOriginalSize() const  {return originalSize;}
+    long getReorderedSize() const {return reorderedSize;}
+
+    static const char *name(Method method);
+
+  private:
+    long storage(const std::vector<int> &order) const;
+    void cuthillMcKee(std::vector<int> &order);
+    void sloan(std::vector<int> &order);
+
+    Method  method, applied;
+    Measure measure;
+
+    // adjacency of the graph in compressed rows
+    std::vector<int> xadj, adj;
+
+    std::vector<int> perm;     // perm[eqn]  = internal equation
+    std::vector<int> iperm;    // iperm[i]   = eqn
+    long originalSize, reorderedSize;
+};
+
+#endif
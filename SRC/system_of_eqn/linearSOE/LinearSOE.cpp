@@ -30,17 +30,29 @@
 //
 // What: "@(#) LinearSOE.C, revA"
 
-#include<LinearSOE.h>
-#include<LinearSOESolver.h>
+#include <stdint.h>
+#include <atomic>
+#include <LinearSOE.h>
+#include <LinearSOESolver.h>
+#include <AnalysisModel.h>
+#include <FE_EleIter.h>
+#include <FE_Element.h>
+#include <Element.h>
+#include <Matrix.h>
+#include <ID.h>
+#include <OPS_Stream.h>
+#include <threads/shared_pool.hpp>
+#include <Profiler.h>
 
 LinearSOE::LinearSOE(LinearSOESolver &theLinearSOESolver, int classtag)
-    :MovableObject(classtag), theModel(0), theSolver(&theLinearSOESolver)
+    :MovableObject(classtag), theModel(0), theSolver(&theLinearSOESolver),
+     numThreads(1)
 {
 
 }
 
 LinearSOE::LinearSOE(int classtag)
-:MovableObject(classtag), theModel(0), theSolver(0)
+:MovableObject(classtag), theModel(0), theSolver(0), numThreads(1)
 {
 
 }
@@ -55,6 +67,7 @@ LinearSOE::~LinearSOE()
 int 
 LinearSOE::solve(void)
 {
+  Profiler::Scope scope("solve");
   if (theSolver != 0)
     return (theSolver->solve());
   else 
@@ -95,10 +108,162 @@ int
 LinearSOE::setLinks(AnalysisModel &theModel)
 {
     this->theModel = &theModel;
+    this->clearColors();
     return 0;
 }
 
 
+bool
+LinearSOE::hasConcurrentAddA(void) const
+{
+  return false;
+}
+
+int
+LinearSOE::setNumThreads(int n)
+{
+  if (n > 1 && !this->hasConcurrentAddA()) {
+    opserr << "WARNING LinearSOE::setNumThreads - this system does not support "
+           << "threaded assembly; using 1 thread\n";
+    numThreads = 1;
+    return -1;
+  }
+
+  numThreads = n > 1 ? n : 1;
+  return 0;
+}
+
+int
+LinearSOE::getNumThreads(void) const
+{
+  return numThreads;
+}
+
+void
+LinearSOE::clearColors(void)
+{
+  colors.clear();
+}
+
+//
+// Greedy coloring of the FE_Elements. Each equation keeps a bit mask of
+// the colors of the elements that have been placed on it, and an element
+// takes the first color absent from all of its equations. Elements that 
+// find all 64 colors taken go in a final group that is assembled serially.
+//
+int
+LinearSOE::colorElements(void)
+{
+  colors.clear();
+  if (theModel == nullptr)
+    return -1;
+
+  const int numEqn = this->getNumEqn();
+  std::vector<uint64_t> used(numEqn, 0);
+  std::vector<FE_Element*> serial;
+
+  FE_EleIter &theEles = theModel->getFEs();
+  FE_Element *elePtr;
+  while ((elePtr = theEles()) != nullptr) {
+    const ID &id = elePtr->getID();
+
+    uint64_t taken = 0;
+    for (int i=0; i<id.Size(); i++)
+      if (id(i) >= 0 && id(i) < numEqn)
+        taken |= used[id(i)];
+
+    if (~taken == 0) {
+      serial.push_back(elePtr);
+      continue;
+    }
+
+    int color = 0;
+    while (taken & (uint64_t(1) << color))
+      color++;
+
+    for (int i=0; i<id.Size(); i++)
+      if (id(i) >= 0 && id(i) < numEqn)
+        used[id(i)] |= uint64_t(1) << color;
+
+    if (color >= (int)colors.size())
+      colors.resize(color+1);
+    colors[color].push_back(elePtr);
+  }
+
+  if (!serial.empty())
+    colors.push_back(serial);
+
+  return colors.size();
+}
+
+const std::vector<std::vector<FE_Element*>> &
+LinearSOE::getColors(void)
+{
+  if (colors.empty())
+    this->colorElements();
+  return colors;
+}
+
+const char *
+LinearSOE::profileClass(FE_Element &theFE)
+{
+  if (!Profiler::active())
+    return nullptr;
+  Element *theEle = theFE.getElement();
+  return theEle != nullptr ? theEle->getClassType() : "FE_Element";
+}
+
+int
+LinearSOE::assembleA(const std::function<const Matrix&(FE_Element&)> &form, double fact)
+{
+  if (theModel == nullptr)
+    return -1;
+
+  Profiler::Scope scope("assemble");
+  int result = 0;
+
+  if (numThreads < 2 || OpenSees::in_pool_worker()) {
+    FE_EleIter &theEles = theModel->getFEs();
+    FE_Element *elePtr;
+    while ((elePtr = theEles()) != nullptr) {
+      const Matrix *ke;
+      {
+        Profiler::ClassScope eleScope(profileClass(*elePtr));
+        ke = &form(*elePtr);
+      }
+      if (this->addA(*ke, elePtr->getID(), fact) < 0)
+        result = -1;
+    }
+    return result;
+  }
+
+  if (colors.empty() && this->colorElements() < 0)
+    return -1;
+
+  std::atomic<int> failed{0};
+  OpenSees::thread_pool &pool = OpenSees::shared_pool();
+  for (std::size_t c = 0; c < colors.size(); c++) {
+    std::vector<FE_Element*> &color = colors[c];
+
+    // the overflow group (if any) may share equations
+    if (c == 64) {
+      for (FE_Element *elePtr : color)
+        if (this->addA(form(*elePtr), elePtr->getID(), fact) < 0)
+          failed = 1;
+      continue;
+    }
+
+    pool.submit_loop<std::size_t>(0, color.size(), [&](std::size_t i) {
+      FE_Element &ele = *color[i];
+      if (this->addA(form(ele), ele.getID(), fact) < 0)
+        failed = 1;
+    }, numThreads).wait();
+  }
+
+  return failed ? -1 : result;
+}
+
+
 int
 LinearSOE::addA(const Matrix &) {
   return -1;
@@ -34,6 +34,8 @@
 //
 // What: "@(#) LinearSOE.h, revA"
 
+#include <vector>
+#include <functional>
 #include <MovableObject.h>
 
 class LinearSOESolver;
@@ -42,6 +44,7 @@ class Matrix;
 class Vector;
 class ID;
 class AnalysisModel;
+class FE_Element;
 
 class LinearSOE : public MovableObject
 {
@@ -79,13 +82,45 @@ class LinearSOE : public MovableObject
     virtual void setX(const Vector &X) =0;
     
     LinearSOESolver *getSolver(void);
+
+    // Threaded assembly. With more than one thread, the FE_Elements of
+    // the model are colored so that no two elements of a color share
+    // an equation, and form/addA run concurrently within each color.
+    // form must therefore be safe to call concurrently for different
+    // FE_Elements. assembleA replaces the loop over the FE_Elements in
+    // the formTangent of an integrator; the system command accepts
+    // -threads for the systems with hasConcurrentAddA.
+    int setNumThreads(int numThreads);
+    int getNumThreads(void) const;
+    int assembleA(const std::function<const Matrix&(FE_Element&)> &form, 
+                  double fact = 1.0);
     
   protected:
     int setSolver(LinearSOESolver &newSolver);	        
     AnalysisModel* theModel;
+
+    // Subclasses return true if addA may be called concurrently for
+    // IDs with no equations in common, i.e. if addA does not modify
+    // anything but the entries of A, and must call clearColors()
+    // from setSize.
+    virtual bool hasConcurrentAddA(void) const;
+    void clearColors(void);
+
+    // The colors used by assembleA, formed on first use after setSize.
+    // Elements in group 64, if present, may share equations.
+    const std::vector<std::vector<FE_Element*>> &getColors(void);
+
+    // Name under which the profiler sums the time spent forming the
+    // contribution of an FE_Element; null when the profiler is not
+    // recording.
+    static const char *profileClass(FE_Element &theFE);
     
   private:
+    int colorElements(void);
+
     LinearSOESolver *theSolver;    
+    int numThreads;
+    std::vector<std::vector<FE_Element*>> colors;
 };
 
 
@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: ScatterMap caches, for each ID passed to a LinearSOE's
+// addA, the storage location of every entry (i,j) of the local matrix
+// in the global coefficient array. For a cached ID, assembly is a
+// direct indexed accumulation rather than a search of the sparse
+// structure. The map is keyed on the address of the ID, which is
+// stable for the IDs of the FE_Elements and DOF_Groups; the contents
+// of the ID are kept with each entry and checked on lookup.
+//
+// The map is filled only by the owner's setSize, with the IDs of the
+// FE_Elements and DOF_Groups of the model, and is not modified by
+// assembly. Any other ID (a temporary, or one whose equations have
+// changed since setSize) is located entry by entry on every call, so
+// that addA may be called concurrently.
+//
+// The Slot type is whatever the owning SOE uses to address its storage,
+// an offset into a single array (int) or a pointer (double*), and None
+// is the value marking an entry that is not assembled (e.g., -1 or
+// nullptr). The owner must call clear() whenever its storage is
+// rebuilt, i.e. from setSize, before adding the IDs again.
+//
+// Written: cmp
+//
+#ifndef ScatterMap_h
+#define ScatterMap_h
+
+#include <vector>
+#include <unordered_map>
+#include <ID.h>
+
+template <typename Slot, Slot None>
+class ScatterMap
+{
+  public:
+    struct Entry {
+      std::vector<int>  dofs;
+      std::vector<Slot> slots;  // column-major over the local matrix
+    };
+
+    // Build the entry for id with locate(row, col, i, j), which returns
+    // the Slot for local entry (i,j) with global equations (row, col),
+    // or None when that entry is not assembled. Only called from setSize.
+    template <typename Locate>
+    void add(const ID &id, Locate &&locate);
+
+    // Call assemble(slot, i, j) for each assembled entry (i,j) of the
+    // local matrix of id, taking the slots from the entry of id if it
+    // is current and from locate otherwise. The map is not modified.
+    template <typename Locate, typename Assemble>
+    void scatter(const ID &id, Locate &&locate, Assemble &&assemble) const;
+
+    static constexpr Slot none = None;
+
+    void clear() {entries.clear();}
+    std::size_t size() const {return entries.size();}
+
+  private:
+    static bool same(const Entry &entry, const ID &id);
+    std::unordered_map<const ID*, Entry> entries;
+};
+
+
+template <typename Slot, Slot None>
+inline bool
+ScatterMap<Slot,None>::same(const Entry &entry, const ID &id)
+{
+  const int n = id.Size();
+  if ((int)entry.dofs.size() != n)
+    return false;
+  for (int i=0; i<n; i++)
+    if (entry.dofs[i] != id(i))
+      return false;
+  return true;
+}
+
+
+template <typename Slot, Slot None>
+template <typename Locate>
+inline void
+ScatterMap<Slot,None>::add(const ID &id, Locate &&locate)
+{
+  Entry &entry = entries[&id];
+
+  const int n = id.Size();
+  entry.dofs.resize(n);
+  for (int i=0; i<n; i++)
+    entry.dofs[i] = id(i);
+
+  entry.slots.resize(n*n);
+  for (int j=0; j<n; j++)
+    for (int i=0; i<n; i++)
+      entry.slots[j*n + i] = locate(id(i), id(j), i, j);
+}
+
+
+template <typename Slot, Slot None>
+template <typename Locate, typename Assemble>
+inline void
+ScatterMap<Slot,None>::scatter(const ID &id, Locate &&locate, Assemble &&assemble) const
+{
+  const int n = id.Size();
+
+  auto found = entries.find(&id);
+  if (found != entries.end() && same(found->second, id)) {
+    const Slot *slot = found->second.slots.data();
+    for (int j=0; j<n; j++)
+      for (int i=0; i<n; i++, slot++)
+        if (*slot != None)
+          assemble(*slot, i, j);
+    return;
+  }
+
+  for (int j=0; j<n; j++)
+    for (int i=0; i<n; i++) {
+      Slot slot = locate(id(i), id(j), i, j);
+      if (slot != None)
+        assemble(slot, i, j);
+    }
+}
+
+#endif
@@ -28,6 +28,7 @@
 #include <BandSPDLinLapackSolver.h>
 #include <BandSPDLinSOE.h>
 #include <blasdecl.h>
+#include <Profiler.h>
 
 
 BandSPDLinLapackSolver::BandSPDLinLapackSolver()
@@ -68,6 +69,7 @@ BandSPDLinLapackSolver::solve(void)
     char tflag[] = "U";
     if (theSOE->factored == false) {
       // factor and solve
+      Profiler::Scope scope("factor");
       DPBSV(tflag, &n,&kd,&nrhs,Aptr,&ldA,Xptr,&ldB,&info);
 
     } else {
@@ -75,6 +77,7 @@ BandSPDLinLapackSolver::solve(void)
       // unsigned int sizeC = 1;
       // DPBTRS("U", sizeC, &n,&kd,&nrhs,Aptr,&ldA,Xptr,&ldB,&info);
 
+        Profiler::Scope scope("substitute");
         DPBTRS(tflag, &n,&kd,&nrhs,Aptr,&ldA,Xptr,&ldB,&info);
     }
 
@@ -42,7 +42,7 @@ BandSPDLinSOE::BandSPDLinSOE(BandSPDLinSolver &the_Solver)
 :LinearSOE(the_Solver, LinSOE_TAGS_BandSPDLinSOE),
  size(0), half_band(0), A(0), B(0), X(0), vectX(0), vectB(0),
  Asize(0), Bsize(0),
- factored(false)
+ factored(false), theOrdering(EquationOrdering::None, EquationOrdering::Bandwidth)
 {
     the_Solver.setLinearSOE(*this);
 }
@@ -52,7 +52,7 @@ BandSPDLinSOE::BandSPDLinSOE(BandSPDLinSolver &the_Solver, int classTag)
 :LinearSOE(the_Solver, classTag),
  size(0), half_band(0), A(0), B(0), X(0), vectX(0), vectB(0),
  Asize(0), Bsize(0),
- factored(false)
+ factored(false), theOrdering(EquationOrdering::None, EquationOrdering::Bandwidth)
 {
 
 }
@@ -62,7 +62,7 @@ BandSPDLinSOE::BandSPDLinSOE(int classTag)
 :LinearSOE(classTag),
  size(0), half_band(0), A(0), B(0), X(0), vectX(0), vectB(0),
  Asize(0), Bsize(0),
- factored(false)
+ factored(false), theOrdering(EquationOrdering::None, EquationOrdering::Bandwidth)
 {
 
 }
@@ -73,7 +73,7 @@ BandSPDLinSOE::BandSPDLinSOE(int N, int numSuper,
 :LinearSOE(the_Solver, LinSOE_TAGS_BandSPDLinSOE),
  size(0), half_band(0), A(0), B(0), X(0), vectX(0), vectB(0),
  Asize(0), Bsize(0),
- factored(false)
+ factored(false), theOrdering(EquationOrdering::None, EquationOrdering::Bandwidth)
 {
     size = N;
     half_band = numSuper+1;
@@ -121,18 +121,25 @@ int
 BandSPDLinSOE::setSize(Graph &theGraph)
 {
     int result = 0;
-    int oldSize = size;
     size = theGraph.getNumVertex();
     half_band = 0;
     
+    // find the internal numbering of the equations
+    theOrdering.setGraph(theGraph);
+    if (theOrdering.getApplied() != EquationOrdering::None)
+      opsdbg << G3_DEBUG_PROMPT << "BandSPDLinSOE - "
+             << EquationOrdering::name(theOrdering.getApplied())
+             << " ordering changed the band storage from " << (double)theOrdering.getOriginalSize()
+             << " to " << (double)theOrdering.getReorderedSize() << "\n";
+
     Vertex *vertexPtr;
     VertexIter &theVertices = theGraph.getVertices();
     
     while ((vertexPtr = theVertices()) != nullptr) {
-        int vertexNum = vertexPtr->getTag();
+        int vertexNum = theOrdering(vertexPtr->getTag());
         const ID &theAdjacency = vertexPtr->getAdjacency();
         for (int i=0; i<theAdjacency.Size(); i++) {
-            int otherNum = theAdjacency(i);
+            int otherNum = theOrdering(theAdjacency(i));
             int diff = vertexNum-otherNum;
             if (half_band < diff)
                 half_band = diff;
@@ -172,19 +179,23 @@ BandSPDLinSOE::setSize(Graph &theGraph)
 	X[j] = 0;
     }
 
-    if (size != oldSize) {
-
-        if (vectX != 0)
-            delete vectX;
-        if (vectB != 0)
-            delete vectB;
+    // when the equations are renumbered, vectX and vectB hold copies of
+    // X and B in the numbering of the analysis
+    if (vectX != 0)
+        delete vectX;
+    if (vectB != 0)
+        delete vectB;
 
+    if (theOrdering.isIdentity()) {
         vectX = new Vector(X,size);
         vectB = new Vector(B,size);
-
-        if (size > Bsize)
-            Bsize = size;
+    } else {
+        vectX = new Vector(size);
+        vectB = new Vector(size);
     }
+
+    if (size > Bsize)
+        Bsize = size;
     
     // invoke setSize() on the Solver
     LinearSOESolver *the_Solver = this->getSolver();
@@ -211,12 +222,12 @@ BandSPDLinSOE::addA(const Matrix &m, const ID &id, double fact)
 
     if (fact == 1.0) { // do not need to multiply 
         for (int i=0; i<idSize; i++) {
-            int col = id(i);
+            int col = theOrdering(id(i));
             if (col < size && col >= 0) {
                 double *coliiPtr = A +(col+1)*half_band -1;
                 int minColRow = col - half_band + 1;
                 for (int j=0; j<idSize; j++) {
-                    int row = id(j);
+                    int row = theOrdering(id(j));
                     if (row <size && row >= 0 && 
                         row <= col && row >= minColRow) { // only add upper
                          double *APtr = coliiPtr + (row-col);
@@ -227,12 +238,12 @@ BandSPDLinSOE::addA(const Matrix &m, const ID &id, double fact)
         }  // for i
     } else {
         for (int i=0; i<idSize; i++) {
-            int col = id(i);
+            int col = theOrdering(id(i));
             if (col < size && col >= 0) {
                 double *coliiPtr = A +(col+1)*half_band -1;
                 int minColRow = col - half_band +1;
                 for (int j=0; j<idSize; j++) {
-                    int row = id(j);
+                    int row = theOrdering(id(j));
                     if (row <size && row >= 0 && 
                         row <= col && row >= minColRow) { // only add upper
                          double *APtr = coliiPtr + (row-col);
@@ -257,30 +268,16 @@ BandSPDLinSOE::addColA(const Vector &colData, int col, double fact)
     return 0;
   
   
-  if (fact == 1.0) { // do not need to multiply 
-    
-    double *coliiPtr = A +(col+1)*half_band -1;
-    int minColRow = col - half_band + 1;
-    for (int row=0; row<size; row++) {
-      if (row <size && row >= 0 && 
-          row <= col && row >= minColRow) { // only add upper
-        double *APtr = coliiPtr + (row-col);
-        *APtr += colData(row);
-      }
-    }  
-
-  } else {
-
-    double *coliiPtr = A +(col+1)*half_band -1;
-    int minColRow = col - half_band + 1;
-    for (int row=0; row<size; row++) {
-      if (row <size && row >= 0 && 
-          row <= col && row >= minColRow) { // only add upper
-        double *APtr = coliiPtr + (row-col);
-        *APtr += colData(row) * fact;
-      }
-    }  
-  }
+  // colData is in the numbering of the analysis
+  const int icol = theOrdering(col);
+  double *coliiPtr = A +(icol+1)*half_band -1;
+  int minColRow = icol - half_band + 1;
+  if (minColRow < 0)
+    minColRow = 0;
+
+  // only add upper
+  for (int row=minColRow; row<=icol; row++)
+    coliiPtr[row-icol] += colData(theOrdering.original(row)) * fact;
 
   return 0;
 }
@@ -300,19 +297,19 @@ BandSPDLinSOE::addB(const Vector &v, const ID &id, double fact)
 
     if (fact == 1.0) { // do not need to multiply if fact == 1.0
         for (int i=0; i<idSize; i++) {
-            int pos = id(i);
+            int pos = theOrdering(id(i));
             if (pos <size && pos >= 0)
                 B[pos] += v(i);
         }
     } else if (fact == -1.0) {
         for (int i=0; i<idSize; i++) {
-            int pos = id(i);
+            int pos = theOrdering(id(i));
             if (pos <size && pos >= 0)
                 B[pos] -= v(i);
         }
     } else {
         for (int i=0; i<idSize; i++) {
-            int pos = id(i);
+            int pos = theOrdering(id(i));
             if (pos <size && pos >= 0)
                 B[pos] += v(i) * fact;
         }
@@ -331,15 +328,15 @@ BandSPDLinSOE::setB(const Vector &v, double fact)
 
     if (fact == 1.0) { // do not need to multiply if fact == 1.0
         for (int i=0; i<size; i++) {
-            B[i] = v(i);
+            B[theOrdering(i)] = v(i);
         }
     } else if (fact == -1.0) {
         for (int i=0; i<size; i++) {
-            B[i] = -v(i);
+            B[theOrdering(i)] = -v(i);
         }
     } else {
         for (int i=0; i<size; i++) {
-            B[i] = v(i) * fact;
+            B[theOrdering(i)] = v(i) * fact;
         }
     }        
     return 0;
@@ -369,23 +366,30 @@ void
 BandSPDLinSOE::setX(int loc, double value)
 {
     if (loc < size && loc >= 0)
-        X[loc] = value;
+        X[theOrdering(loc)] = value;
 }
 
 void 
 BandSPDLinSOE::setX(const Vector &x)
 {
-    if (x.Size() == size && vectX != 0)
+    if (x.Size() != size || vectX == 0)
+      return;
+
+    if (theOrdering.isIdentity())
       *vectX = x;
+    else
+      for (int i=0; i<size; i++)
+        X[theOrdering(i)] = x(i);
 }
 
 
-
-
 const Vector &
 BandSPDLinSOE::getX(void)
 {
   assert(vectX != nullptr);
+  if (!theOrdering.isIdentity())
+    for (int i=0; i<size; i++)
+      (*vectX)(i) = X[theOrdering(i)];
   return *vectX;
 }
 
@@ -393,6 +397,9 @@ const Vector &
 BandSPDLinSOE::getB(void)
 {
   assert(vectB != nullptr);
+  if (!theOrdering.isIdentity())
+    for (int i=0; i<size; i++)
+      (*vectB)(i) = B[theOrdering(i)];
   return *vectB;
 }
 
@@ -408,6 +415,14 @@ BandSPDLinSOE::normRHS(void)
 }    
 
 
+void
+BandSPDLinSOE::setOrdering(EquationOrdering::Method method)
+{
+    // takes effect the next time setSize is called
+    theOrdering.setMethod(method);
+}
+
+
 int
 BandSPDLinSOE::setBandSPDSolver(BandSPDLinSolver &newSolver)
 {
@@ -33,12 +33,18 @@
 // BandSPDLinSOE is a subclass of LinearSOE. It uses the LAPACK Upper storage
 // scheme to store the components of the A matrix.
 //
+// The equations may be renumbered internally to reduce the bandwidth (see
+// EquationOrdering); A, B and X are then stored in that order, while
+// every method taking or returning equation numbers uses the numbering
+// of the analysis.
+//
 // What: "@(#) BandSPDLinSOE.h, revA"
 
 
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <EquationOrdering.h>
 
 class BandSPDLinSolver;
 
@@ -73,6 +79,9 @@ class BandSPDLinSOE : public LinearSOE
     virtual void setX(int loc, double value);    
     virtual void setX(const Vector &x);    
     virtual int setBandSPDSolver(BandSPDLinSolver &newSolver);    
+    void setOrdering(EquationOrdering::Method method);
+    const EquationOrdering &getOrdering(void) const {return theOrdering;}
+
 
     virtual int sendSelf(int commitTag, Channel &theChannel);
     virtual int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
@@ -89,6 +98,7 @@ class BandSPDLinSOE : public LinearSOE
     int Asize, Bsize;
     int aFactored;
     bool factored;
+    EquationOrdering theOrdering;
     
   private:
 };
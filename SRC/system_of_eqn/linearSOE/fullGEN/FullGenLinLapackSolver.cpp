@@ -28,6 +28,7 @@
 #include <math.h>
 #include <assert.h>
 #include <blasdecl.h>
+#include <Profiler.h>
 #include <FullGenLinLapackSolver.h>
 #include <FullGenLinSOE.h>
 #include <Matrix.h>
@@ -103,11 +104,13 @@ FullGenLinLapackSolver::solve(void)
     // now solve AX = Y
     //
     char tran[] = "N";
-    if (theSOE->factored == false)  
+    if (theSOE->factored == false) {
      // factor and solve 
+      Profiler::Scope scope("factor");
       DGESV(&n,&nrhs,Aptr,&ldA,iPIV,Xptr,&ldB,&info);
-    else {
+    } else {
      // solve only using factored matrix      
+      Profiler::Scope scope("substitute");
       DGETRS(tran, &n,&nrhs,Aptr,&ldA,iPIV,Xptr,&ldB,&info);      
     }
 
@@ -0,0 +1,466 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Implementation of AggregationPreconditioner. The three
+// aggregation phases and the prolongator smoothing follow Vanek, Mandel
+// and Brezina, "Algebraic multigrid by smoothed aggregation for second
+// and fourth order elliptic problems", Computing 56 (1996). The damping
+// is 4/3 over an estimate of the spectral radius of D^{-1} A.
+//
+// Written: cmp
+//
+#include <AggregationPreconditioner.h>
+#include <Logging.h>
+#include <algorithm>
+#include <cmath>
+
+// coarsening that keeps more than this fraction of the equations
+// is not worth another level
+#define AMG_MIN_REDUCTION     0.9
+// largest coarsest system that is factored; larger ones are smoothed
+#define AMG_MAX_DIRECT        2000
+#define AMG_COARSE_SWEEPS     4
+#define AMG_POWER_ITERATIONS  10
+
+typedef AggregationPreconditioner::SparseRows SparseRows;
+
+namespace {
+
+// C = X Y by rows (Gustavson); the columns of each row of C are in the
+// order they are first reached
+void
+multiply(const CsrMatrix &X, const SparseRows &Y, SparseRows &C)
+{
+  C.n = X.n;
+  C.m = Y.m;
+  C.start.assign(C.n+1, 0);
+  C.col.clear();
+  C.val.clear();
+
+  std::vector<int> position(Y.m, -1);
+  for (int i=0; i<X.n; i++) {
+    const int rowBegin = (int)C.col.size();
+    for (int l = X.rowStart[i]; l < X.rowStart[i+1]; l++) {
+      const int k = X.col[l];
+      const double x = X.val[l];
+      for (int q = Y.start[k]; q < Y.start[k+1]; q++) {
+        const int j = Y.col[q];
+        if (position[j] < 0) {
+          position[j] = (int)C.col.size();
+          C.col.push_back(j);
+          C.val.push_back(x*Y.val[q]);
+        } else
+          C.val[position[j]] += x*Y.val[q];
+      }
+    }
+    for (std::size_t p = rowBegin; p < C.col.size(); p++)
+      position[C.col[p]] = -1;
+    C.start[i+1] = (int)C.col.size();
+  }
+}
+
+void
+transpose(const SparseRows &X, SparseRows &T)
+{
+  T.n = X.m;
+  T.m = X.n;
+  T.start.assign(T.n+1, 0);
+  for (int j : X.col)
+    T.start[j+1]++;
+  for (int i=0; i<T.n; i++)
+    T.start[i+1] += T.start[i];
+
+  T.col.resize(X.col.size());
+  T.val.resize(X.val.size());
+  std::vector<int> next(T.start.begin(), T.start.end()-1);
+  for (int i=0; i<X.n; i++)
+    for (int l = X.start[i]; l < X.start[i+1]; l++) {
+      const int p = next[X.col[l]]++;
+      T.col[p] = i;
+      T.val[p] = X.val[l];
+    }
+}
+
+// y = A x
+void
+product(const CsrMatrix &A, const double *x, double *y)
+{
+  for (int i=0; i<A.n; i++) {
+    double sum = 0.0;
+    for (int l = A.rowStart[i]; l < A.rowStart[i+1]; l++)
+      sum += A.val[l]*x[A.col[l]];
+    y[i] = sum;
+  }
+}
+
+// one Gauss-Seidel sweep on A x = b, forward or backward
+void
+relax(const CsrMatrix &A, const std::vector<double> &invDiag,
+      const double *b, double *x, bool forward)
+{
+  const int n = A.n;
+  for (int k=0; k<n; k++) {
+    const int i = forward ? k : n-1-k;
+    double sum = b[i];
+    for (int l = A.rowStart[i]; l < A.rowStart[i+1]; l++)
+      sum -= A.val[l]*x[A.col[l]];
+    x[i] += sum*invDiag[i];
+  }
+}
+
+} // namespace
+
+
+AggregationPreconditioner::AggregationPreconditioner(int b, double t, int coarse, int maxLev)
+ : blockSize(b > 0 ? b : 1), theta(t),
+   coarseSize(coarse > 0 ? coarse : 1), maxLevels(maxLev > 1 ? maxLev : 1)
+{
+
+}
+
+
+double
+AggregationPreconditioner::getComplexity() const
+{
+  if (levels.empty())
+    return 0.0;
+
+  double total = 0.0;
+  for (const Level &level : levels)
+    total += level.A.rowStart[level.A.n];
+  return total/levels[0].A.rowStart[levels[0].A.n];
+}
+
+
+//
+// Group the nodes of A, i.e. the blocks of b consecutive equations,
+// into aggregates; aggregates[I] is set to the aggregate of node I and
+// the number of aggregates is returned.
+//
+int
+AggregationPreconditioner::aggregate(const CsrMatrix &A, int b, double threshold,
+                                     std::vector<int> &aggregates) const
+{
+  const int N = A.n/b;
+
+  // Frobenius norms of the diagonal node blocks
+  std::vector<double> diag(N, 0.0);
+  for (int i=0; i<A.n; i++)
+    for (int l = A.rowStart[i]; l < A.rowStart[i+1]; l++)
+      if (A.col[l]/b == i/b)
+        diag[i/b] += A.val[l]*A.val[l];
+  for (double &d : diag)
+    d = std::sqrt(d);
+
+  // strong couplings: |A_IJ| > theta sqrt(|A_II| |A_JJ|)
+  std::vector<int> strongStart(N+1, 0), strong;
+  std::vector<double> norm(N, 0.0);
+  std::vector<char> touched(N, 0);
+  std::vector<int> neighbors;
+  for (int I=0; I<N; I++) {
+    neighbors.clear();
+    for (int i = I*b; i < (I+1)*b; i++)
+      for (int l = A.rowStart[i]; l < A.rowStart[i+1]; l++) {
+        const int J = A.col[l]/b;
+        if (J == I)
+          continue;
+        if (!touched[J]) {
+          touched[J] = 1;
+          neighbors.push_back(J);
+        }
+        norm[J] += A.val[l]*A.val[l];
+      }
+    for (int J : neighbors) {
+      if (std::sqrt(norm[J]) > threshold*std::sqrt(diag[I]*diag[J]))
+        strong.push_back(J);
+      norm[J] = 0.0;
+      touched[J] = 0;
+    }
+    strongStart[I+1] = (int)strong.size();
+  }
+
+  aggregates.assign(N, -1);
+  int numAggregates = 0;
+
+  // 1: nodes whose strong neighbors are all free start an aggregate
+  for (int I=0; I<N; I++) {
+    if (aggregates[I] >= 0)
+      continue;
+    bool free = true;
+    for (int l = strongStart[I]; l < strongStart[I+1] && free; l++)
+      free = aggregates[strong[l]] < 0;
+    if (!free)
+      continue;
+    aggregates[I] = numAggregates;
+    for (int l = strongStart[I]; l < strongStart[I+1]; l++)
+      aggregates[strong[l]] = numAggregates;
+    numAggregates++;
+  }
+
+  // 2: remaining nodes join an aggregate of a strong neighbor
+  std::vector<int> phase1(aggregates);
+  for (int I=0; I<N; I++) {
+    if (aggregates[I] >= 0)
+      continue;
+    for (int l = strongStart[I]; l < strongStart[I+1]; l++)
+      if (phase1[strong[l]] >= 0) {
+        aggregates[I] = phase1[strong[l]];
+        break;
+      }
+  }
+
+  // 3: what is left is aggregated with its free strong neighbors
+  for (int I=0; I<N; I++) {
+    if (aggregates[I] >= 0)
+      continue;
+    aggregates[I] = numAggregates;
+    for (int l = strongStart[I]; l < strongStart[I+1]; l++)
+      if (aggregates[strong[l]] < 0)
+        aggregates[strong[l]] = numAggregates;
+    numAggregates++;
+  }
+
+  return numAggregates;
+}
+
+
+int
+AggregationPreconditioner::build(const CsrMatrix &A)
+{
+  // the coarse levels hold views of their own matrices, so the levels
+  // must not be moved once they are formed
+  levels.clear();
+  levels.reserve(maxLevels);
+  levels.emplace_back();
+  levels[0].A = A;
+
+  // the tentative prolongator needs whole nodes
+  const int b = (A.n % blockSize == 0) ? blockSize : 1;
+
+  double threshold = theta;
+  for (int l=0; ; l++) {
+    Level &fine = levels[l];
+    const CsrMatrix &Af = fine.A;
+    const int n = Af.n;
+
+    fine.invDiag.assign(n, 0.0);
+    for (int i=0; i<n; i++)
+      for (int k = Af.rowStart[i]; k < Af.rowStart[i+1]; k++)
+        if (Af.col[k] == i)
+          fine.invDiag[i] = Af.val[k];
+    for (int i=0; i<n; i++) {
+      if (fine.invDiag[i] == 0.0) {
+        opserr << "AggregationPreconditioner::build() - zero diagonal in row " << i
+               << " of level " << l << "\n";
+        levels.clear();
+        return -1;
+      }
+      fine.invDiag[i] = 1.0/fine.invDiag[i];
+    }
+    fine.x.resize(n);
+    fine.b.resize(n);
+    fine.r.resize(n);
+
+    if (n <= coarseSize || l+1 >= maxLevels)
+      break;
+
+    std::vector<int> aggregates;
+    const int numAggregates = this->aggregate(Af, b, threshold, aggregates);
+    const int nc = numAggregates*b;
+    if (nc > AMG_MIN_REDUCTION*n || nc == 0)
+      break;
+
+    // tentative prolongator, with unit columns
+    std::vector<int> aggregateSize(numAggregates, 0);
+    for (int a : aggregates)
+      aggregateSize[a]++;
+
+    SparseRows T;
+    T.n = n;
+    T.m = nc;
+    T.start.resize(n+1);
+    T.col.resize(n);
+    T.val.resize(n);
+    for (int i=0; i<n; i++) {
+      const int a = aggregates[i/b];
+      T.start[i] = i;
+      T.col[i] = a*b + i%b;
+      T.val[i] = 1.0/std::sqrt((double)aggregateSize[a]);
+    }
+    T.start[n] = n;
+
+    // spectral radius of D^{-1} A by power iteration
+    std::vector<double> v(n), w(n);
+    for (int i=0; i<n; i++)
+      v[i] = 1.0 + (i % 7)*0.1;
+    double rho = 1.0;
+    for (int k=0; k<AMG_POWER_ITERATIONS; k++) {
+      double vNorm = 0.0;
+      for (double vi : v)
+        vNorm += vi*vi;
+      vNorm = std::sqrt(vNorm);
+      if (vNorm == 0.0)
+        break;
+      for (double &vi : v)
+        vi /= vNorm;
+      product(Af, v.data(), w.data());
+      double wNorm = 0.0;
+      for (int i=0; i<n; i++) {
+        w[i] *= fine.invDiag[i];
+        wNorm += w[i]*w[i];
+      }
+      rho = std::sqrt(wNorm);
+      v.swap(w);
+    }
+    const double omega = 4.0/(3.0*rho);
+
+    // P = (I - omega D^{-1} A) T; the pattern of A T contains that of
+    // T since the diagonal of A is present
+    levels.emplace_back();
+    Level &coarse = levels[l+1];
+    const CsrMatrix &Afine = levels[l].A;
+    multiply(Afine, T, coarse.P);
+    for (int i=0; i<n; i++) {
+      const double scale = -omega*levels[l].invDiag[i];
+      for (int k = coarse.P.start[i]; k < coarse.P.start[i+1]; k++) {
+        coarse.P.val[k] *= scale;
+        if (coarse.P.col[k] == T.col[i])
+          coarse.P.val[k] += T.val[i];
+      }
+    }
+    transpose(coarse.P, coarse.R);
+
+    // Galerkin coarse matrix R A P
+    SparseRows AP;
+    multiply(Afine, coarse.P, AP);
+    multiply(coarse.R.view(), AP, coarse.ownA);
+    coarse.A = coarse.ownA.view();
+
+    threshold *= 0.5;
+  }
+
+  const CsrMatrix &Ac = levels.back().A;
+  coarseLU.clear();
+  coarsePivot.clear();
+  if (Ac.n <= AMG_MAX_DIRECT && this->factorCoarse(Ac) < 0) {
+    levels.clear();
+    return -1;
+  }
+
+  opsdbg << G3_DEBUG_PROMPT << "AMG - " << (int)levels.size() << " levels, coarsest "
+         << Ac.n << " equations, operator complexity " << this->getComplexity() << "\n";
+  return 0;
+}
+
+
+int
+AggregationPreconditioner::factorCoarse(const CsrMatrix &A)
+{
+  const int n = A.n;
+  coarseLU.assign((std::size_t)n*n, 0.0);
+  coarsePivot.resize(n);
+  double *LU = coarseLU.data();
+
+  for (int i=0; i<n; i++)
+    for (int l = A.rowStart[i]; l < A.rowStart[i+1]; l++)
+      LU[(std::size_t)i*n + A.col[l]] += A.val[l];
+
+  for (int c=0; c<n; c++) {
+    int p = c;
+    for (int i=c+1; i<n; i++)
+      if (std::fabs(LU[(std::size_t)i*n + c]) > std::fabs(LU[(std::size_t)p*n + c]))
+        p = i;
+    coarsePivot[c] = p;
+    if (LU[(std::size_t)p*n + c] == 0.0) {
+      opserr << "AggregationPreconditioner::build() - singular coarse matrix\n";
+      return -1;
+    }
+    if (p != c)
+      for (int j=0; j<n; j++)
+        std::swap(LU[(std::size_t)p*n + j], LU[(std::size_t)c*n + j]);
+
+    const double pivot = LU[(std::size_t)c*n + c];
+    for (int i=c+1; i<n; i++) {
+      double &f = LU[(std::size_t)i*n + c];
+      if (f == 0.0)
+        continue;
+      f /= pivot;
+      for (int j=c+1; j<n; j++)
+        LU[(std::size_t)i*n + j] -= f*LU[(std::size_t)c*n + j];
+    }
+  }
+  return 0;
+}
+
+
+void
+AggregationPreconditioner::cycle(int l) const
+{
+  const Level &level = levels[l];
+  const CsrMatrix &A = level.A;
+  const int n = A.n;
+  double *x = level.x.data();
+  const double *b = level.b.data();
+
+  std::fill(level.x.begin(), level.x.end(), 0.0);
+
+  if (l+1 == (int)levels.size()) {
+    if (coarseLU.empty()) {
+      for (int k=0; k<AMG_COARSE_SWEEPS; k++) {
+        relax(A, level.invDiag, b, x, true);
+        relax(A, level.invDiag, b, x, false);
+      }
+      return;
+    }
+    const double *LU = coarseLU.data();
+    for (int i=0; i<n; i++)
+      x[i] = b[i];
+    for (int c=0; c<n; c++)
+      if (coarsePivot[c] != c)
+        std::swap(x[c], x[coarsePivot[c]]);
+    for (int i=0; i<n; i++)
+      for (int j=0; j<i; j++)
+        x[i] -= LU[(std::size_t)i*n + j]*x[j];
+    for (int i=n-1; i>=0; i--) {
+      for (int j=i+1; j<n; j++)
+        x[i] -= LU[(std::size_t)i*n + j]*x[j];
+      x[i] /= LU[(std::size_t)i*n + i];
+    }
+    return;
+  }
+
+  relax(A, level.invDiag, b, x, true);
+
+  double *r = level.r.data();
+  product(A, x, r);
+  for (int i=0; i<n; i++)
+    r[i] = b[i] - r[i];
+
+  const Level &coarse = levels[l+1];
+  product(coarse.R.view(), r, coarse.b.data());
+  this->cycle(l+1);
+
+  // x += P xc
+  const SparseRows &P = coarse.P;
+  for (int i=0; i<n; i++) {
+    double sum = 0.0;
+    for (int k = P.start[i]; k < P.start[i+1]; k++)
+      sum += P.val[k]*coarse.x[P.col[k]];
+    x[i] += sum;
+  }
+
+  relax(A, level.invDiag, b, x, false);
+}
+
+
+void
+AggregationPreconditioner::apply(const double *r, double *z) const
+{
+  const Level &top = levels[0];
+  std::copy(r, r + top.A.n, top.b.begin());
+  this->cycle(0);
+  std::copy(top.x.begin(), top.x.end(), z);
+}
@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: AggregationPreconditioner is a smoothed aggregation
+// algebraic multigrid preconditioner (Vanek, Mandel and Brezina, 1996)
+// applied as one V-cycle. The equations are grouped into nodes of
+// blockSize consecutive equations; nodes are aggregated over the graph
+// of strong couplings, and the tentative prolongator interpolates each
+// equation of a node from the equation of the same component of its
+// aggregate, so the translations of the aggregate are represented
+// exactly on the coarse grid. The prolongator is smoothed with one
+// damped Jacobi step and the coarse matrices are formed by the Galerkin
+// product P^T A P. Gauss-Seidel sweeps smooth forward before and
+// backward after the coarse correction, which keeps the cycle symmetric;
+// the coarsest system is solved by dense LU.
+//
+// The arrays of A passed to build() are used by the finest level of the
+// cycle and must remain valid until the next build().
+//
+// Written: cmp
+//
+#ifndef AggregationPreconditioner_h
+#define AggregationPreconditioner_h
+
+#include <Preconditioner.h>
+#include <vector>
+
+class AggregationPreconditioner : public Preconditioner
+{
+  public:
+    AggregationPreconditioner(int blockSize = 1, double theta = 0.08,
+                              int coarseSize = 500, int maxLevels = 10);
+
+    int  build(const CsrMatrix &A);
+    void apply(const double *r, double *z) const;
+    const char *getName() const {return "AMG";}
+
+    int getNumLevels() const {return (int)levels.size();}
+    // sum of the nonzeros of all levels over the nonzeros of A
+    double getComplexity() const;
+
+    // a matrix in compressed rows owned by the hierarchy
+    struct SparseRows {
+      int n = 0, m = 0;   // rows and columns
+      std::vector<int>    start, col;
+      std::vector<double> val;
+      CsrMatrix view() const {return CsrMatrix{n, start.data(), col.data(), val.data()};}
+    };
+
+  private:
+    struct Level {
+      CsrMatrix   A;          // view of A, or of ownA on coarse levels
+      SparseRows  ownA;
+      SparseRows  P, R;       // prolongation to this level, R = P^T
+      std::vector<double> invDiag;
+      mutable std::vector<double> x, b, r;
+    };
+
+    int  aggregate(const CsrMatrix &A, int block, double theta, std::vector<int> &aggregates) const;
+    void cycle(int level) const;
+    int  factorCoarse(const CsrMatrix &A);
+
+    int    blockSize;
+    double theta;
+    int    coarseSize, maxLevels;
+
+    std::vector<Level> levels;
+
+    // LU factors of the coarsest matrix, with row pivots
+    std::vector<double> coarseLU;
+    std::vector<int>    coarsePivot;
+};
+
+#endif
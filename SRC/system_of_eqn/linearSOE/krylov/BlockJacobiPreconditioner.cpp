@@ -0,0 +1,112 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Implementation of BlockJacobiPreconditioner. Each block
+// is inverted by Gauss-Jordan elimination with partial pivoting.
+//
+// Written: cmp
+//
+#include <BlockJacobiPreconditioner.h>
+#include <Logging.h>
+#include <algorithm>
+#include <cmath>
+
+BlockJacobiPreconditioner::BlockJacobiPreconditioner(int b)
+ : blockSize(b > 0 ? b : 1), n(0)
+{
+
+}
+
+
+int
+BlockJacobiPreconditioner::build(const CsrMatrix &A)
+{
+  n = A.n;
+  const int b  = blockSize;
+  const int bb = b*b;
+  const int numBlocks = (n + b - 1)/b;
+  inverse.assign((std::size_t)numBlocks*bb, 0.0);
+
+  std::vector<double> block(bb);
+  for (int k=0; k<numBlocks; k++) {
+    const int first = k*b;
+    const int m = std::min(b, n - first);
+
+    // gather the diagonal block
+    std::fill(block.begin(), block.end(), 0.0);
+    for (int i=0; i<m; i++) {
+      const int row = first + i;
+      for (int l = A.rowStart[row]; l < A.rowStart[row+1]; l++) {
+        const int j = A.col[l] - first;
+        if (j >= 0 && j < m)
+          block[i*b + j] = A.val[l];
+      }
+    }
+
+    double *inv = &inverse[(std::size_t)k*bb];
+    for (int i=0; i<m; i++)
+      inv[i*b + i] = 1.0;
+
+    // Gauss-Jordan elimination of block into inv
+    for (int c=0; c<m; c++) {
+      int p = c;
+      for (int i=c+1; i<m; i++)
+        if (std::fabs(block[i*b + c]) > std::fabs(block[p*b + c]))
+          p = i;
+      if (block[p*b + c] == 0.0) {
+        opserr << "BlockJacobiPreconditioner::build() - singular block at equation "
+               << first + c << "\n";
+        return -1;
+      }
+      if (p != c)
+        for (int j=0; j<m; j++) {
+          std::swap(block[p*b + j], block[c*b + j]);
+          std::swap(inv[p*b + j],   inv[c*b + j]);
+        }
+
+      const double pivot = 1.0/block[c*b + c];
+      for (int j=0; j<m; j++) {
+        block[c*b + j] *= pivot;
+        inv[c*b + j]   *= pivot;
+      }
+      for (int i=0; i<m; i++) {
+        if (i == c || block[i*b + c] == 0.0)
+          continue;
+        const double f = block[i*b + c];
+        for (int j=0; j<m; j++) {
+          block[i*b + j] -= f*block[c*b + j];
+          inv[i*b + j]   -= f*inv[c*b + j];
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+
+void
+BlockJacobiPreconditioner::apply(const double *r, double *z) const
+{
+  const int b  = blockSize;
+  const int bb = b*b;
+
+  if (b == 1) {
+    for (int i=0; i<n; i++)
+      z[i] = inverse[i]*r[i];
+    return;
+  }
+
+  for (int first=0, k=0; first<n; first += b, k++) {
+    const int m = std::min(b, n - first);
+    const double *inv = &inverse[(std::size_t)k*bb];
+    for (int i=0; i<m; i++) {
+      double sum = 0.0;
+      for (int j=0; j<m; j++)
+        sum += inv[i*b + j]*r[first + j];
+      z[first + i] = sum;
+    }
+  }
+}
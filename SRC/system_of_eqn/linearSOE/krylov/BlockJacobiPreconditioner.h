@@ -0,0 +1,37 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: BlockJacobiPreconditioner inverts the diagonal blocks of
+// A formed by consecutive groups of blockSize equations. With a block
+// size equal to the number of DOFs per node, and a numberer that keeps
+// the DOFs of a node together, the blocks are the nodal blocks of A.
+// A block size of 1 gives the Jacobi (diagonal) preconditioner.
+//
+// Written: cmp
+//
+#ifndef BlockJacobiPreconditioner_h
+#define BlockJacobiPreconditioner_h
+
+#include <Preconditioner.h>
+#include <vector>
+
+class BlockJacobiPreconditioner : public Preconditioner
+{
+  public:
+    BlockJacobiPreconditioner(int blockSize = 1);
+
+    int  build(const CsrMatrix &A);
+    void apply(const double *r, double *z) const;
+    const char *getName() const {return blockSize == 1 ? "Jacobi" : "BlockJacobi";}
+
+  private:
+    int blockSize;
+    int n;
+    // inverse of block k, stored by rows at k*blockSize*blockSize
+    std::vector<double> inverse;
+};
+
+#endif
@@ -0,0 +1,192 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Implementation of IncompleteFactorPreconditioner. ILU(0)
+// follows the row-wise IKJ algorithm of Saad, Iterative Methods for
+// Sparse Linear Systems, Sec. 10.3. IC(0) uses the same row-wise
+// order; the entries of row i of L are found by merging the sorted
+// rows i and k of L.
+//
+// Written: cmp
+//
+#include <IncompleteFactorPreconditioner.h>
+#include <Logging.h>
+#include <cmath>
+
+#define IC0_INITIAL_SHIFT 1.0e-3
+#define IC0_MAX_SHIFTS    12
+
+IncompleteFactorPreconditioner::IncompleteFactorPreconditioner(bool sym)
+ : symmetric(sym), n(0), shift(0.0)
+{
+
+}
+
+
+int
+IncompleteFactorPreconditioner::build(const CsrMatrix &A)
+{
+  n = A.n;
+  if (!symmetric)
+    return this->factorLU(A);
+
+  // strictly lower pattern of A
+  start.assign(n+1, 0);
+  for (int i=0; i<n; i++) {
+    int count = 0;
+    for (int l = A.rowStart[i]; l < A.rowStart[i+1] && A.col[l] < i; l++)
+      count++;
+    start[i+1] = start[i] + count;
+  }
+  col.resize(start[n]);
+  val.resize(start[n]);
+  D.resize(n);
+  for (int i=0; i<n; i++) {
+    int p = start[i];
+    for (int l = A.rowStart[i]; l < A.rowStart[i+1] && A.col[l] < i; l++)
+      col[p++] = A.col[l];
+  }
+
+  shift = 0.0;
+  for (int attempt = 0; attempt <= IC0_MAX_SHIFTS; attempt++) {
+    if (this->factorCholesky(A, shift) == 0) {
+      if (shift != 0.0)
+        opsdbg << G3_DEBUG_PROMPT << "IC(0) needed a diagonal shift of " << shift << "\n";
+      return 0;
+    }
+    shift = (shift == 0.0) ? IC0_INITIAL_SHIFT : 2.0*shift;
+  }
+
+  opserr << "IncompleteFactorPreconditioner::build() - IC(0) broke down; "
+         << "the matrix is not positive definite\n";
+  return -1;
+}
+
+
+int
+IncompleteFactorPreconditioner::factorCholesky(const CsrMatrix &A, double alpha)
+{
+  for (int i=0; i<n; i++) {
+    // A(i,k) for the lower entries, and A(i,i)
+    double aii = 0.0;
+    {
+      int p = start[i];
+      for (int l = A.rowStart[i]; l < A.rowStart[i+1]; l++) {
+        if (A.col[l] < i)
+          val[p++] = A.val[l];
+        else if (A.col[l] == i)
+          aii = A.val[l];
+      }
+    }
+
+    double d = (1.0 + alpha)*aii;
+    for (int p = start[i]; p < start[i+1]; p++) {
+      const int k = col[p];
+      // L(i,k) = (A(i,k) - sum_m L(i,m) D(m) L(k,m)) / D(k)
+      double s = val[p];
+      int q1 = start[i], q2 = start[k];
+      while (q1 < p && q2 < start[k+1]) {
+        if (col[q1] < col[q2])
+          q1++;
+        else if (col[q1] > col[q2])
+          q2++;
+        else {
+          s -= val[q1]*D[col[q1]]*val[q2];
+          q1++;
+          q2++;
+        }
+      }
+      val[p] = s/D[k];
+      d -= val[p]*val[p]*D[k];
+    }
+
+    if (!(d > 1.0e-12*std::fabs(aii)) || aii <= 0.0)
+      return -1;
+    D[i] = d;
+  }
+  return 0;
+}
+
+
+int
+IncompleteFactorPreconditioner::factorLU(const CsrMatrix &A)
+{
+  start.assign(A.rowStart, A.rowStart + n + 1);
+  col.assign(A.col, A.col + start[n]);
+  val.assign(A.val, A.val + start[n]);
+  diag.assign(n, -1);
+
+  for (int i=0; i<n; i++)
+    for (int l = start[i]; l < start[i+1]; l++)
+      if (col[l] == i)
+        diag[i] = l;
+
+  std::vector<int> position(n, -1);
+  for (int i=0; i<n; i++) {
+    if (diag[i] < 0) {
+      opserr << "IncompleteFactorPreconditioner::build() - no diagonal in row " << i << "\n";
+      return -1;
+    }
+    for (int l = start[i]; l < start[i+1]; l++)
+      position[col[l]] = l;
+
+    for (int l = start[i]; l < diag[i]; l++) {
+      const int k = col[l];
+      val[l] /= val[diag[k]];
+      for (int m = diag[k]+1; m < start[k+1]; m++) {
+        const int target = position[col[m]];
+        if (target >= 0)
+          val[target] -= val[l]*val[m];
+      }
+    }
+
+    for (int l = start[i]; l < start[i+1]; l++)
+      position[col[l]] = -1;
+
+    if (val[diag[i]] == 0.0) {
+      opserr << "IncompleteFactorPreconditioner::build() - ILU(0) zero pivot in row " << i << "\n";
+      return -1;
+    }
+  }
+  return 0;
+}
+
+
+void
+IncompleteFactorPreconditioner::apply(const double *r, double *z) const
+{
+  if (symmetric) {
+    // L y = r, D w = y, L^T z = w
+    for (int i=0; i<n; i++) {
+      double s = r[i];
+      for (int p = start[i]; p < start[i+1]; p++)
+        s -= val[p]*z[col[p]];
+      z[i] = s;
+    }
+    for (int i=0; i<n; i++)
+      z[i] /= D[i];
+    for (int i=n-1; i>=0; i--) {
+      const double zi = z[i];
+      for (int p = start[i]; p < start[i+1]; p++)
+        z[col[p]] -= val[p]*zi;
+    }
+    return;
+  }
+
+  // L y = r with unit diagonal, then U z = y
+  for (int i=0; i<n; i++) {
+    double s = r[i];
+    for (int l = start[i]; l < diag[i]; l++)
+      s -= val[l]*z[col[l]];
+    z[i] = s;
+  }
+  for (int i=n-1; i>=0; i--) {
+    double s = z[i];
+    for (int l = diag[i]+1; l < start[i+1]; l++)
+      s -= val[l]*z[col[l]];
+    z[i] = s/val[diag[i]];
+  }
+}
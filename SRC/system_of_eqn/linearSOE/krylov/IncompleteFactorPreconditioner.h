@@ -0,0 +1,51 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: IncompleteFactorPreconditioner computes a factorization
+// of A restricted to the sparsity pattern of A, i.e. with no fill-in.
+// For symmetric systems this is the incomplete Cholesky factorization
+// IC(0), held as L D L^T; should a pivot not be positive, the
+// factorization is repeated on A plus a growing multiple of its
+// diagonal (Manteuffel's shift). Otherwise it is the incomplete LU
+// factorization ILU(0) with a unit lower triangle.
+//
+// Written: cmp
+//
+#ifndef IncompleteFactorPreconditioner_h
+#define IncompleteFactorPreconditioner_h
+
+#include <Preconditioner.h>
+#include <vector>
+
+class IncompleteFactorPreconditioner : public Preconditioner
+{
+  public:
+    IncompleteFactorPreconditioner(bool symmetric = true);
+
+    int  build(const CsrMatrix &A);
+    void apply(const double *r, double *z) const;
+    bool isSymmetric() const {return symmetric;}
+    const char *getName() const {return symmetric ? "IC0" : "ILU0";}
+
+    // diagonal shift that was needed by the last IC(0) factorization
+    double getShift() const {return shift;}
+
+  private:
+    int factorCholesky(const CsrMatrix &A, double alpha);
+    int factorLU(const CsrMatrix &A);
+
+    bool symmetric;
+    int n;
+    double shift;
+
+    // IC(0): strictly lower rows of L and the pivots D
+    // ILU(0): all rows of L and U in the pattern of A, with the
+    //         offset of the diagonal of each row in diag
+    std::vector<int>    start, col, diag;
+    std::vector<double> val, D;
+};
+
+#endif
@@ -0,0 +1,592 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Implementation of KrylovSolver. The iterations start from
+// x = 0 and stop when the relative residual |b - Ax|/|b| is below the
+// tolerance; MINRES measures it in the norm of the preconditioner. The
+// preconditioned MINRES recurrences follow Paige and Saunders (1975),
+// GMRES those of Saad and Schultz (1986) with modified Gram-Schmidt,
+// and BiCGStab van der Vorst (1992).
+//
+// Written: cmp
+//
+#include <KrylovSolver.h>
+#include <SparseGenRowLinSOE.h>
+#include <BlockJacobiPreconditioner.h>
+#include <IncompleteFactorPreconditioner.h>
+#include <AggregationPreconditioner.h>
+#include <Vector.h>
+#include <Logging.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+double
+dot(const std::vector<double> &x, const std::vector<double> &y)
+{
+  double sum = 0.0;
+  for (std::size_t i=0; i<x.size(); i++)
+    sum += x[i]*y[i];
+  return sum;
+}
+
+double
+norm(const double *x, int n)
+{
+  double sum = 0.0;
+  for (int i=0; i<n; i++)
+    sum += x[i]*x[i];
+  return std::sqrt(sum);
+}
+
+// y += a x
+void
+axpy(double a, const std::vector<double> &x, std::vector<double> &y)
+{
+  for (std::size_t i=0; i<x.size(); i++)
+    y[i] += a*x[i];
+}
+
+} // namespace
+
+
+KrylovSolver::KrylovSolver(Method m, Preconditioning pre, double tol, int maxIter)
+ : SparseGenRowLinSolver(SOLVER_TAGS_KrylovSolver),
+   method(m), preconditioning(pre), tolerance(tol), maxIterations(maxIter),
+   blockSize(1), restart(50), rebuildTolerance(0.1),
+   thePreconditioner(nullptr), patternChanged(true), builtIterations(0)
+{
+  if (preconditioning == ILU0 && (method == CG || method == MINRES)) {
+    opserr << "WARNING KrylovSolver - " << name(method)
+           << " needs a symmetric preconditioner; using IC0 instead of ILU0\n";
+    preconditioning = IC0;
+  }
+}
+
+
+KrylovSolver::~KrylovSolver()
+{
+  if (thePreconditioner != nullptr)
+    delete thePreconditioner;
+}
+
+
+const char *
+KrylovSolver::name(Method m)
+{
+  switch (m) {
+    case MINRES:   return "MINRES";
+    case GMRES:    return "GMRES";
+    case BiCGStab: return "BiCGStab";
+    default:       return "CG";
+  }
+}
+
+
+const char *
+KrylovSolver::name(Preconditioning pre)
+{
+  switch (pre) {
+    case Jacobi:      return "Jacobi";
+    case BlockJacobi: return "BlockJacobi";
+    case IC0:         return "IC0";
+    case ILU0:        return "ILU0";
+    case AMG:         return "AMG";
+    default:          return "None";
+  }
+}
+
+
+void
+KrylovSolver::setBlockSize(int b)
+{
+  blockSize = b > 0 ? b : 1;
+  patternChanged = true;
+}
+
+
+void
+KrylovSolver::setRestart(int m)
+{
+  restart = m > 0 ? m : 1;
+  this->setSize();
+}
+
+
+void
+KrylovSolver::setRebuildTolerance(double tol)
+{
+  rebuildTolerance = tol;
+}
+
+
+int
+KrylovSolver::setSize(void)
+{
+  patternChanged = true;
+
+  if (theSOE == nullptr)
+    return 0;
+
+  int numVectors;
+  switch (method) {
+    case MINRES:   numVectors = 7; break;
+    case GMRES:    numVectors = restart + 3; break;
+    case BiCGStab: numVectors = 8; break;
+    default:       numVectors = 4; break;
+  }
+
+  const int n = theSOE->size;
+  work.resize(numVectors);
+  for (std::vector<double> &v : work)
+    v.assign(n, 0.0);
+
+  return 0;
+}
+
+
+//
+// The preconditioner is rebuilt when the pattern changed, when A moved
+// away from the A it was built from by more than rebuildTolerance, or
+// when the last solve needed more than twice the iterations of the
+// first solve after the build.
+//
+bool
+KrylovSolver::needsBuild()
+{
+  if (preconditioning == None)
+    return false;
+
+  if (thePreconditioner == nullptr || patternChanged)
+    return true;
+
+  const int nnz = theSOE->nnz;
+  const double *A = theSOE->A;
+  double change = 0.0, size = 0.0;
+  for (int k=0; k<nnz; k++) {
+    const double d = A[k] - builtA[k];
+    change += d*d;
+    size   += builtA[k]*builtA[k];
+  }
+  if (change > rebuildTolerance*rebuildTolerance*size)
+    return true;
+
+  if (builtIterations > 0 && stats.last > 2*builtIterations)
+    return true;
+
+  return false;
+}
+
+
+int
+KrylovSolver::buildPreconditioner()
+{
+  if (thePreconditioner == nullptr) {
+    switch (preconditioning) {
+      case Jacobi:
+        thePreconditioner = new BlockJacobiPreconditioner(1);
+        break;
+      case BlockJacobi:
+        thePreconditioner = new BlockJacobiPreconditioner(blockSize);
+        break;
+      case IC0:
+        thePreconditioner = new IncompleteFactorPreconditioner(true);
+        break;
+      case ILU0:
+        thePreconditioner = new IncompleteFactorPreconditioner(false);
+        break;
+      case AMG:
+        thePreconditioner = new AggregationPreconditioner(blockSize);
+        break;
+      default:
+        return 0;
+    }
+  }
+
+  const CsrMatrix A{theSOE->size, theSOE->rowStartA, theSOE->colA, theSOE->A};
+  if (thePreconditioner->build(A) < 0) {
+    opserr << "WARNING KrylovSolver::solve() - could not build the "
+           << thePreconditioner->getName() << " preconditioner\n";
+    delete thePreconditioner;
+    thePreconditioner = nullptr;
+    return -1;
+  }
+
+  builtA.assign(theSOE->A, theSOE->A + theSOE->nnz);
+  builtIterations = 0;
+  patternChanged = false;
+  stats.build++;
+  return 0;
+}
+
+
+void
+KrylovSolver::multiply(const double *p, double *Ap)
+{
+  const int n = theSOE->size;
+  Vector pVector(const_cast<double*>(p), n);
+  Vector ApVector(Ap, n);
+  theSOE->formAp(pVector, ApVector);
+}
+
+
+void
+KrylovSolver::precondition(const double *r, double *z)
+{
+  if (thePreconditioner != nullptr)
+    thePreconditioner->apply(r, z);
+  else
+    std::copy(r, r + theSOE->size, z);
+}
+
+
+int
+KrylovSolver::solve(void)
+{
+  const int n = theSOE->size;
+  if (n == 0)
+    return 0;
+
+  double *x = theSOE->X;
+  const double *b = theSOE->B;
+  stats.solve++;
+
+  bool built = false;
+  if (theSOE->factored == false) {
+    if (this->needsBuild()) {
+      if (this->buildPreconditioner() < 0)
+        return -1;
+      built = true;
+    } else if (thePreconditioner != nullptr)
+      stats.reuse++;
+    theSOE->factored = true;
+  }
+
+  std::fill(x, x + n, 0.0);
+  const double bNorm = norm(b, n);
+  if (bNorm == 0.0) {
+    stats.last = 0;
+    stats.residual = 0.0;
+    return 0;
+  }
+
+  int its = 0;
+  int result = this->iterate(b, x, bNorm, its);
+
+  // a preconditioner from an earlier tangent may no longer do
+  if (result < 0 && !built && thePreconditioner != nullptr) {
+    opsdbg << G3_DEBUG_PROMPT << "KrylovSolver - no convergence in " << its
+           << " iterations, rebuilding the preconditioner\n";
+    stats.iterations += its;
+    if (this->buildPreconditioner() < 0)
+      return -1;
+    built = true;
+    std::fill(x, x + n, 0.0);
+    result = this->iterate(b, x, bNorm, its);
+  }
+
+  stats.iterations += its;
+  stats.last = its;
+  if (built)
+    builtIterations = its;
+
+  // report the true residual
+  std::vector<double> &r = work[0];
+  this->multiply(x, r.data());
+  for (int i=0; i<n; i++)
+    r[i] = b[i] - r[i];
+  stats.residual = norm(r.data(), n)/bNorm;
+
+  if (result < 0) {
+    stats.failed++;
+    opserr << "WARNING KrylovSolver::solve() - " << name(method) << " did not converge in "
+           << its << " iterations, relative residual " << stats.residual << "\n";
+    return -1;
+  }
+  return 0;
+}
+
+
+int
+KrylovSolver::iterate(const double *b, double *x, double bNorm, int &its)
+{
+  its = 0;
+  switch (method) {
+    case MINRES:   return this->minres(b, x, bNorm, its);
+    case GMRES:    return this->gmres(b, x, bNorm, its);
+    case BiCGStab: return this->bicgstab(b, x, bNorm, its);
+    default:       return this->cg(b, x, bNorm, its);
+  }
+}
+
+
+int
+KrylovSolver::cg(const double *b, double *x, double bNorm, int &its)
+{
+  const int n = theSOE->size;
+  std::vector<double> &r = work[0], &z = work[1], &p = work[2], &Ap = work[3];
+
+  std::copy(b, b + n, r.begin());
+  this->precondition(r.data(), z.data());
+  p = z;
+  double rz = dot(r, z);
+
+  while (its < maxIterations) {
+    its++;
+    this->multiply(p.data(), Ap.data());
+    const double pAp = dot(p, Ap);
+    if (!(pAp > 0.0)) {
+      opserr << "WARNING KrylovSolver - CG breakdown, A is not positive definite\n";
+      return -1;
+    }
+
+    const double alpha = rz/pAp;
+    for (int i=0; i<n; i++) {
+      x[i] += alpha*p[i];
+      r[i] -= alpha*Ap[i];
+    }
+    if (norm(r.data(), n) <= tolerance*bNorm)
+      return 0;
+
+    this->precondition(r.data(), z.data());
+    const double rzNew = dot(r, z);
+    const double beta = rzNew/rz;
+    rz = rzNew;
+    for (int i=0; i<n; i++)
+      p[i] = z[i] + beta*p[i];
+  }
+  return -1;
+}
+
+
+int
+KrylovSolver::minres(const double *b, double *x, double bNorm, int &its)
+{
+  const int n = theSOE->size;
+  std::vector<double> &v = work[0], &y = work[1], &r1 = work[2], &r2 = work[3],
+                      &w = work[4], &w1 = work[5], &w2 = work[6];
+
+  std::copy(b, b + n, r1.begin());
+  r2 = r1;
+  this->precondition(r1.data(), y.data());
+  double beta1 = dot(r1, y);
+  if (!(beta1 > 0.0)) {
+    opserr << "WARNING KrylovSolver - MINRES needs a positive definite preconditioner\n";
+    return -1;
+  }
+  beta1 = std::sqrt(beta1);
+
+  std::fill(w.begin(), w.end(), 0.0);
+  std::fill(w2.begin(), w2.end(), 0.0);
+  double oldb = 0.0, beta = beta1, dbar = 0.0, epsln = 0.0;
+  double phibar = beta1, cs = -1.0, sn = 0.0;
+  const double eps = std::numeric_limits<double>::epsilon();
+
+  while (its < maxIterations) {
+    its++;
+
+    // Lanczos step
+    const double s = 1.0/beta;
+    for (int i=0; i<n; i++)
+      v[i] = s*y[i];
+    this->multiply(v.data(), y.data());
+    if (its >= 2)
+      axpy(-beta/oldb, r1, y);
+    const double alpha = dot(v, y);
+    axpy(-alpha/beta, r2, y);
+    r1.swap(r2);
+    r2 = y;
+    this->precondition(r2.data(), y.data());
+    oldb = beta;
+    beta = dot(r2, y);
+    if (beta < 0.0) {
+      opserr << "WARNING KrylovSolver - MINRES needs a positive definite preconditioner\n";
+      return -1;
+    }
+    beta = std::sqrt(beta);
+
+    // apply the previous rotation and form the next one
+    const double oldeps = epsln;
+    const double delta = cs*dbar + sn*alpha;
+    const double gbar  = sn*dbar - cs*alpha;
+    epsln = sn*beta;
+    dbar  = -cs*beta;
+    const double gamma = std::max(std::hypot(gbar, beta), eps);
+    cs = gbar/gamma;
+    sn = beta/gamma;
+    const double phi = cs*phibar;
+    phibar = sn*phibar;
+
+    // update the search direction and x
+    w1.swap(w2);
+    w2.swap(w);
+    for (int i=0; i<n; i++) {
+      w[i] = (v[i] - oldeps*w1[i] - delta*w2[i])/gamma;
+      x[i] += phi*w[i];
+    }
+
+    if (phibar <= tolerance*beta1)
+      return 0;
+    if (beta == 0.0)
+      return 0;
+  }
+  return -1;
+}
+
+
+int
+KrylovSolver::gmres(const double *b, double *x, double bNorm, int &its)
+{
+  const int n = theSOE->size;
+  const int m = restart;
+  std::vector<double> &w = work[m+1], &z = work[m+2];
+  std::vector<std::vector<double>> H(m+1, std::vector<double>(m, 0.0));
+  std::vector<double> cs(m), sn(m), g(m+1), y(m);
+
+  while (its < maxIterations) {
+    // r = b - A x
+    std::vector<double> &v0 = work[0];
+    this->multiply(x, v0.data());
+    for (int i=0; i<n; i++)
+      v0[i] = b[i] - v0[i];
+    const double beta = norm(v0.data(), n);
+    if (beta <= tolerance*bNorm)
+      return 0;
+    for (double &vi : v0)
+      vi /= beta;
+    std::fill(g.begin(), g.end(), 0.0);
+    g[0] = beta;
+
+    int k = 0;
+    bool converged = false;
+    while (k < m && its < maxIterations) {
+      its++;
+      this->precondition(work[k].data(), z.data());
+      this->multiply(z.data(), w.data());
+
+      // modified Gram-Schmidt
+      for (int i=0; i<=k; i++) {
+        H[i][k] = dot(w, work[i]);
+        axpy(-H[i][k], work[i], w);
+      }
+      H[k+1][k] = norm(w.data(), n);
+      if (H[k+1][k] != 0.0)
+        for (int i=0; i<n; i++)
+          work[k+1][i] = w[i]/H[k+1][k];
+
+      // rotate the new column of H
+      for (int i=0; i<k; i++) {
+        const double t = cs[i]*H[i][k] + sn[i]*H[i+1][k];
+        H[i+1][k] = -sn[i]*H[i][k] + cs[i]*H[i+1][k];
+        H[i][k] = t;
+      }
+      const double h = std::hypot(H[k][k], H[k+1][k]);
+      if (h == 0.0) {
+        opserr << "WARNING KrylovSolver - GMRES breakdown\n";
+        return -1;
+      }
+      cs[k] = H[k][k]/h;
+      sn[k] = H[k+1][k]/h;
+      H[k][k] = h;
+      H[k+1][k] = 0.0;
+      g[k+1] = -sn[k]*g[k];
+      g[k]   =  cs[k]*g[k];
+
+      k++;
+      if (std::fabs(g[k]) <= tolerance*bNorm) {
+        converged = true;
+        break;
+      }
+    }
+
+    // x += M^{-1} V y, with H y = g
+    for (int i=k-1; i>=0; i--) {
+      double sum = g[i];
+      for (int j=i+1; j<k; j++)
+        sum -= H[i][j]*y[j];
+      y[i] = sum/H[i][i];
+    }
+    std::fill(w.begin(), w.end(), 0.0);
+    for (int j=0; j<k; j++)
+      axpy(y[j], work[j], w);
+    this->precondition(w.data(), z.data());
+    for (int i=0; i<n; i++)
+      x[i] += z[i];
+
+    if (converged)
+      return 0;
+  }
+  return -1;
+}
+
+
+int
+KrylovSolver::bicgstab(const double *b, double *x, double bNorm, int &its)
+{
+  const int n = theSOE->size;
+  std::vector<double> &r = work[0], &rhat = work[1], &p = work[2], &v = work[3],
+                      &phat = work[4], &s = work[5], &shat = work[6], &t = work[7];
+
+  std::copy(b, b + n, r.begin());
+  rhat = r;
+  std::fill(p.begin(), p.end(), 0.0);
+  std::fill(v.begin(), v.end(), 0.0);
+  double rho = 1.0, alpha = 1.0, omega = 1.0;
+
+  while (its < maxIterations) {
+    its++;
+    const double rhoNew = dot(rhat, r);
+    if (rhoNew == 0.0 || omega == 0.0) {
+      opserr << "WARNING KrylovSolver - BiCGStab breakdown\n";
+      return -1;
+    }
+    const double beta = (rhoNew/rho)*(alpha/omega);
+    rho = rhoNew;
+    for (int i=0; i<n; i++)
+      p[i] = r[i] + beta*(p[i] - omega*v[i]);
+
+    this->precondition(p.data(), phat.data());
+    this->multiply(phat.data(), v.data());
+    alpha = rho/dot(rhat, v);
+    for (int i=0; i<n; i++)
+      s[i] = r[i] - alpha*v[i];
+    if (norm(s.data(), n) <= tolerance*bNorm) {
+      for (int i=0; i<n; i++)
+        x[i] += alpha*phat[i];
+      return 0;
+    }
+
+    this->precondition(s.data(), shat.data());
+    this->multiply(shat.data(), t.data());
+    const double tt = dot(t, t);
+    omega = tt > 0.0 ? dot(t, s)/tt : 0.0;
+    for (int i=0; i<n; i++) {
+      x[i] += alpha*phat[i] + omega*shat[i];
+      r[i] = s[i] - omega*t[i];
+    }
+    if (norm(r.data(), n) <= tolerance*bNorm)
+      return 0;
+  }
+  return -1;
+}
+
+
+int
+KrylovSolver::sendSelf(int cTag, Channel &theChannel)
+{
+  // nothing to do
+  return 0;
+}
+
+
+int
+KrylovSolver::recvSelf(int ctag, Channel &theChannel, FEM_ObjectBroker &theBroker)
+{
+  // nothing to do
+  return 0;
+}
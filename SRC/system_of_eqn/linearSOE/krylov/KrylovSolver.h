@@ -0,0 +1,122 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: KrylovSolver solves a SparseGenRowLinSOE iteratively, for
+// systems too large to factor. The iteration is one of
+//
+//   CG        preconditioned conjugate gradients, for SPD systems
+//   MINRES    for symmetric indefinite systems, with an SPD preconditioner
+//   GMRES     restarted GMRES(m), right preconditioned
+//   BiCGStab  right preconditioned
+//
+// and the preconditioner one of Jacobi, block Jacobi, IC(0), ILU(0) or
+// smoothed aggregation AMG, built from the compressed rows of A. The
+// products with A go through LinearSOE::formAp, so an SOE that can form
+// them from the elements without assembling A is used as such.
+//
+// The preconditioner is only rebuilt when the sparsity pattern changes
+// or A has changed materially since it was built: by more than a
+// relative tolerance in the Frobenius norm, or enough for the iteration
+// count to double. Otherwise the one built for an earlier tangent is
+// reused. If a solve with a reused preconditioner does not converge, it
+// is rebuilt and the solve repeated.
+//
+// Written: cmp
+//
+#ifndef KrylovSolver_h
+#define KrylovSolver_h
+
+#include <SparseGenRowLinSolver.h>
+#include <vector>
+
+#ifndef SOLVER_TAGS_KrylovSolver
+#define SOLVER_TAGS_KrylovSolver 1001
+#endif
+
+class Preconditioner;
+
+class KrylovSolver : public SparseGenRowLinSolver
+{
+  public:
+    enum Method {
+      CG,
+      MINRES,
+      GMRES,
+      BiCGStab
+    };
+
+    enum Preconditioning {
+      None,
+      Jacobi,
+      BlockJacobi,
+      IC0,
+      ILU0,
+      AMG
+    };
+
+    KrylovSolver(Method method = CG, Preconditioning pre = Jacobi,
+                 double tol = 1.0e-8, int maxIter = 1000);
+    ~KrylovSolver();
+
+    int solve(void);
+    int setSize(void);
+
+    // equations per node, used by the block Jacobi and AMG preconditioners
+    void setBlockSize(int blockSize);
+    // number of Krylov vectors GMRES keeps before it restarts
+    void setRestart(int restart);
+    // relative change of A beyond which the preconditioner is rebuilt
+    void setRebuildTolerance(double tol);
+
+    struct Statistics {
+      int solve      = 0;   // calls to solve
+      int iterations = 0;   // iterations over all solves
+      int last       = 0;   // iterations of the last solve
+      int build      = 0;   // preconditioner built
+      int reuse      = 0;   // preconditioner kept for a changed A
+      int failed     = 0;   // solves that did not converge
+      double residual = 0;  // relative residual |b - Ax|/|b| of the last solve
+    };
+    const Statistics &getStatistics() const {return stats;}
+
+    static const char *name(Method method);
+    static const char *name(Preconditioning pre);
+
+    int sendSelf(int commitTag, Channel &theChannel);
+    int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
+
+  private:
+    bool needsBuild();
+    int  buildPreconditioner();
+    int  iterate(const double *b, double *x, double bNorm, int &its);
+
+    void multiply(const double *p, double *Ap);
+    void precondition(const double *r, double *z);
+
+    int cg(const double *b, double *x, double bNorm, int &its);
+    int minres(const double *b, double *x, double bNorm, int &its);
+    int gmres(const double *b, double *x, double bNorm, int &its);
+    int bicgstab(const double *b, double *x, double bNorm, int &its);
+
+    Method method;
+    Preconditioning preconditioning;
+    double tolerance;
+    int maxIterations;
+    int blockSize, restart;
+    double rebuildTolerance;
+
+    Preconditioner *thePreconditioner;
+    bool patternChanged;
+    std::vector<double> builtA;   // A when the preconditioner was built
+    int builtIterations;          // iterations of the first solve after a build
+
+    // work vectors, each of size n
+    std::vector<std::vector<double>> work;
+
+    Statistics stats;
+};
+
+#endif
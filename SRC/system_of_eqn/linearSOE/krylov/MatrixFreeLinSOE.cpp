@@ -0,0 +1,326 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Implementation of MatrixFreeLinSOE.
+//
+// Written: cmp
+//
+#include <MatrixFreeLinSOE.h>
+#include <SparseGenRowLinSolver.h>
+#include <TangentProduct.h>
+#include <BufferedElement.h>
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Graph.h>
+#include <AnalysisModel.h>
+#include <FE_EleIter.h>
+#include <FE_Element.h>
+#include <DOF_GrpIter.h>
+#include <DOF_Group.h>
+#include <Element.h>
+#include <IncrementalIntegrator.h>
+#include <Profiler.h>
+#include <threads/shared_pool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <assert.h>
+
+
+namespace {
+//
+// Records the factors an integrator applies to the matrices of an
+// FE_Element in formEleTangent, without forming them
+//
+class TangentFactors : public FE_Element
+{
+  public:
+    TangentFactors() : FE_Element(0, 0, 0) {}
+
+    void zeroTangent(void)            {cK = cC = cM = 0.0; other = false;}
+    void addKtToTang(double fact)     {cK += fact;}
+    void addCtoTang(double fact)      {cC += fact;}
+    void addMtoTang(double fact)      {cM += fact;}
+    void addKiToTang(double fact)     {other = other || fact != 0.0;}
+    void addKgToTang(double fact)     {other = other || fact != 0.0;}
+    void addKpToTang(double fact, int){other = other || fact != 0.0;}
+
+    double cK = 0.0, cC = 0.0, cM = 0.0;
+    bool other = false;
+};
+}
+
+
+MatrixFreeLinSOE::MatrixFreeLinSOE(SparseGenRowLinSolver &theSolver, int blockSize)
+:SparseGenRowLinSOE(theSolver),
+ blockSize(blockSize > 0 ? blockSize : 1),
+ theIntegrator(nullptr),
+ cK(1.0), cC(0.0), cM(0.0), otherTangent(false)
+{
+
+}
+
+
+void
+MatrixFreeLinSOE::setIntegrator(IncrementalIntegrator *integrator)
+{
+  theIntegrator = integrator;
+  if (theIntegrator == nullptr) {
+    cK = 1.0;
+    cC = cM = 0.0;
+    otherTangent = false;
+  }
+}
+
+
+//
+// The integrators zero A in formTangent before forming the element
+// tangents, so the factors they apply to this tangent are read here.
+//
+void
+MatrixFreeLinSOE::zeroA(void)
+{
+  this->SparseGenRowLinSOE::zeroA();
+
+  if (theIntegrator == nullptr)
+    return;
+
+  TangentFactors factors;
+  if (theIntegrator->formEleTangent(&factors) < 0) {
+    // let the integrator form every tangent
+    otherTangent = true;
+    return;
+  }
+  cK = factors.cK;
+  cC = factors.cC;
+  cM = factors.cM;
+  otherTangent = factors.other;
+}
+
+
+//
+// The pattern only holds the diagonal blocks, whatever the graph
+//
+int
+MatrixFreeLinSOE::setSize(Graph &theGraph)
+{
+  const int oldSize = size;
+  size = theGraph.getNumVertex();
+  scatter.clear();
+  this->clearColors();
+
+  int newNNZ = 0;
+  for (int first=0; first<size; first+=blockSize) {
+    const int nb = std::min(blockSize, size-first);
+    newNNZ += nb*nb;
+  }
+  nnz = newNNZ;
+
+  if (nnz > Asize) {
+    delete [] A;
+    delete [] colA;
+    A = new double[nnz];
+    colA = new int[nnz];
+    Asize = nnz;
+  }
+  for (int i=0; i<Asize; i++)
+    A[i] = 0.0;
+
+  factored = false;
+
+  if (size > Bsize) {
+    delete [] B;
+    delete [] X;
+    delete [] rowStartA;
+    B = new double[size];
+    X = new double[size];
+    rowStartA = new int[size+1];
+    Bsize = size;
+  }
+  for (int j=0; j<size; j++) {
+    B[j] = 0.0;
+    X[j] = 0.0;
+  }
+
+  if (size != oldSize) {
+    delete vectX;
+    delete vectB;
+    vectX = new Vector(X, size);
+    vectB = new Vector(B, size);
+  }
+
+  if (size != 0) {
+    rowStartA[0] = 0;
+    int k = 0;
+    for (int row=0; row<size; row++) {
+      const int first = row - row%blockSize;
+      const int last  = std::min(first+blockSize, size);
+      for (int col=first; col<last; col++)
+        colA[k++] = col;
+      rowStartA[row+1] = k;
+    }
+  }
+
+  return this->getSolver()->setSize();
+}
+
+
+//
+// The element of an FE_Element, if it can be multiplied on any thread.
+// The damping and the matrices other than Kt and M are only available
+// through the FE_Element, and an FE_Element with a different number of
+// equations than its element transforms them (e.g., for constraints),
+// so these use the tangent of the FE_Element. So do elements whose
+// materials keep storage shared by their class.
+//
+Element *
+MatrixFreeLinSOE::concurrentElement(FE_Element &theFE) const
+{
+  if (cC != 0.0 || otherTangent)
+    return nullptr;
+
+  Element *theEle = theFE.getElement();
+  if (theEle == nullptr || theFE.getID().Size() != theEle->getNumDOF())
+    return nullptr;
+
+  BufferedElement *theBuffered = dynamic_cast<BufferedElement *>(theEle);
+  if (theBuffered == nullptr || !theBuffered->isReentrant())
+    return nullptr;
+
+  return theEle;
+}
+
+
+int
+MatrixFreeLinSOE::addProduct(FE_Element &theFE, const Vector &p, Vector &Ap) const
+{
+  const ID &id = theFE.getID();
+  const int n = id.Size();
+
+  thread_local std::vector<double> x, y;
+  x.assign(n, 0.0);
+  y.assign(n, 0.0);
+  for (int i=0; i<n; i++)
+    if (id(i) >= 0 && id(i) < size)
+      x[i] = p(id(i));
+
+  Element *theEle = this->concurrentElement(theFE);
+
+  if (TangentProduct *theProduct = dynamic_cast<TangentProduct *>(theEle)) {
+    if (theProduct->addTangentProduct(x.data(), y.data(), cK, cM) < 0)
+      return -1;
+
+  } else if (BufferedElement *theBuffered = dynamic_cast<BufferedElement *>(theEle)) {
+    thread_local Matrix k, m;
+    if (k.noRows() != n) {
+      k.resize(n, n);
+      m.resize(n, n);
+    }
+    if (theBuffered->formTangentStiff(k) < 0)
+      return -1;
+    if (cM != 0.0) {
+      if (theBuffered->formMass(m) < 0)
+        return -1;
+      k.addMatrix(cK, m, cM);
+    } else if (cK != 1.0)
+      k *= cK;
+    for (int j=0; j<n; j++)
+      if (x[j] != 0.0)
+        for (int i=0; i<n; i++)
+          y[i] += k(i,j)*x[j];
+
+  } else {
+    if (theIntegrator == nullptr) {
+      theFE.zeroTangent();
+      theFE.addKtToTang(cK);
+    }
+    const Matrix &k = theFE.getTangent(theIntegrator);
+    for (int j=0; j<n; j++)
+      if (x[j] != 0.0)
+        for (int i=0; i<n; i++)
+          y[i] += k(i,j)*x[j];
+  }
+
+  for (int i=0; i<n; i++)
+    if (id(i) >= 0 && id(i) < size)
+      Ap(id(i)) += y[i];
+
+  return 0;
+}
+
+
+int
+MatrixFreeLinSOE::formAp(const Vector &p, Vector &Ap)
+{
+  assert(p.Size() == size && Ap.Size() == size);
+
+  Ap.Zero();
+  if (theModel == nullptr)
+    return -1;
+
+  int result = 0;
+  const int numThreads = this->getNumThreads();
+
+  if (numThreads < 2 || OpenSees::in_pool_worker()) {
+    FE_EleIter &theEles = theModel->getFEs();
+    FE_Element *elePtr;
+    while ((elePtr = theEles()) != nullptr) {
+      Profiler::ClassScope eleScope(profileClass(*elePtr));
+      if (this->addProduct(*elePtr, p, Ap) < 0)
+        result = -1;
+    }
+
+  } else {
+    // the elements of a color share no equations, so their products
+    // are added to Ap concurrently
+    const std::vector<std::vector<FE_Element*>> &colors = this->getColors();
+    std::atomic<int> failed{0};
+    OpenSees::thread_pool &pool = OpenSees::shared_pool();
+    for (std::size_t c = 0; c < colors.size(); c++) {
+      if (c == 64)
+        continue;
+      const std::vector<FE_Element*> &color = colors[c];
+      pool.submit_loop<std::size_t>(0, color.size(), [&](std::size_t i) {
+        FE_Element &theFE = *color[i];
+        if (this->concurrentElement(theFE) != nullptr && this->addProduct(theFE, p, Ap) < 0)
+          failed = 1;
+      }, numThreads).wait();
+    }
+
+    // the tangent of an FE_Element may live in storage shared by all
+    // FE_Elements of the same size, so the rest are done here
+    for (std::size_t c = 0; c < colors.size(); c++)
+      for (FE_Element *elePtr : colors[c])
+        if ((c == 64 || this->concurrentElement(*elePtr) == nullptr)
+            && this->addProduct(*elePtr, p, Ap) < 0)
+          failed = 1;
+
+    if (failed)
+      result = -1;
+  }
+
+  // nodal mass and damping
+  if (theIntegrator != nullptr && (cC != 0.0 || cM != 0.0)) {
+    DOF_GrpIter &theDOFs = theModel->getDOFs();
+    DOF_Group *dofPtr;
+    while ((dofPtr = theDOFs()) != nullptr) {
+      const Matrix &m = dofPtr->getTangent(theIntegrator);
+      const ID &id = dofPtr->getID();
+      for (int i=0; i<id.Size(); i++) {
+        if (id(i) < 0 || id(i) >= size)
+          continue;
+        double sum = 0.0;
+        for (int j=0; j<id.Size(); j++)
+          if (id(j) >= 0 && id(j) < size)
+            sum += m(i,j)*p(id(j));
+        Ap(id(i)) += sum;
+      }
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: MatrixFreeLinSOE is a SparseGenRowLinSOE that does not
+// assemble the global tangent. Only the diagonal blocks of blockSize
+// consecutive equations are stored, for the preconditioner, and the
+// products A*p needed by a KrylovSolver are formed element by element:
+//
+//   A*p = sum_e  L_e^T (cK K_e + cC C_e + cM M_e) L_e p
+//
+// Elements that implement TangentProduct apply K_e and M_e themselves,
+// and those that implement BufferedElement form them in storage of the
+// calling thread. When the element is a reentrant BufferedElement, both
+// are run concurrently over the colors of the model if the system has
+// more than one thread; the others are multiplied with the tangent the
+// integrator forms for their FE_Element, on the calling thread.
+//
+// The factors are taken from the integrator each time it forms the
+// tangent, since they change with the time step. Without an integrator
+// they are those of a static analysis, (1, 0, 0).
+//
+// Written: cmp
+//
+#ifndef MatrixFreeLinSOE_h
+#define MatrixFreeLinSOE_h
+
+#include <SparseGenRowLinSOE.h>
+
+class FE_Element;
+class Element;
+class IncrementalIntegrator;
+
+class MatrixFreeLinSOE : public SparseGenRowLinSOE
+{
+  public:
+    MatrixFreeLinSOE(SparseGenRowLinSolver &theSolver, int blockSize = 1);
+
+    int setSize(Graph &theGraph);
+    void zeroA(void);
+    int formAp(const Vector &p, Vector &Ap);
+
+    // the integrator whose formTangent the products must reproduce
+    void setIntegrator(IncrementalIntegrator *theIntegrator);
+
+  private:
+    Element *concurrentElement(FE_Element &theFE) const;
+    int addProduct(FE_Element &theFE, const Vector &p, Vector &Ap) const;
+
+    int blockSize;
+    IncrementalIntegrator *theIntegrator;
+
+    // factors of the stiffness, damping and mass in A, and whether the
+    // integrator also adds other matrices (e.g., the initial stiffness)
+    double cK, cC, cM;
+    bool otherTangent;
+};
+
+#endif
@@ -0,0 +1,44 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Preconditioner is the abstract base class of the
+// preconditioners used by KrylovSolver. A preconditioner is built from
+// a matrix held in compressed rows, with the columns of each row sorted
+// and the diagonal present, and afterwards applies z = M^{-1} r.
+//
+// Written: cmp
+//
+#ifndef Preconditioner_h
+#define Preconditioner_h
+
+// A view of a matrix stored in compressed rows; the arrays are not owned.
+struct CsrMatrix {
+  int n;
+  const int    *rowStart;   // n+1 offsets into col and val
+  const int    *col;
+  const double *val;
+};
+
+class Preconditioner
+{
+  public:
+    virtual ~Preconditioner() {}
+
+    // Compute the preconditioner from A; returns < 0 if it cannot be
+    // formed, in which case apply() must not be called.
+    virtual int  build(const CsrMatrix &A) = 0;
+
+    // z = M^{-1} r; r and z hold n values and do not overlap
+    virtual void apply(const double *r, double *z) const = 0;
+
+    // true if M is symmetric positive definite whenever A is, as
+    // required by the CG and MINRES iterations
+    virtual bool isSymmetric() const {return true;}
+
+    virtual const char *getName() const = 0;
+};
+
+#endif
@@ -31,6 +31,7 @@
 #include <ProfileSPDLinDirectSolver.h>
 #include <ProfileSPDLinSOE.h>
 #include <math.h>
+#include <Profiler.h>
 #include <assert.h>
 
 #include <Channel.h>
@@ -125,7 +126,10 @@ ProfileSPDLinDirectSolver::solve(void)
     if (theSOE->isAfactored == false)  {
 
 	// FACTOR & SOLVE
-	double *ajiPtr, *akjPtr, *akiPtr, *bjPtr;    
+      {
+	// the forward substitution is done with the factorization
+	Profiler::Scope scope("factor");
+	double *ajiPtr, *akjPtr, *akiPtr;
 	
 	// if the matrix has not been factored already factor it into U^t D U
 	// storing D^-1 in invD as we go
@@ -203,10 +207,12 @@ ProfileSPDLinDirectSolver::solve(void)
 
 	theSOE->isAfactored = true;
 	theSOE->numInt = 0;
+      }
 	
-	
+	Profiler::Scope scope("substitute");
+
 	// divide by diag term 
-	bjPtr = X; 
+	double *bjPtr = X; 
 	double *aiiPtr = invD;
 	for (int j=0; j<theSize; j++) 
 	    *bjPtr++ = *aiiPtr++ * X[j];
@@ -227,6 +233,7 @@ ProfileSPDLinDirectSolver::solve(void)
     else {
 
 	// JUST DO SOLVE
+	Profiler::Scope scope("substitute");
 
 	// do forward substitution 
 	for (int i=1; i<theSize; i++) {
@@ -27,7 +27,9 @@
 // Description: This file contains the class definition for 
 // ProfileSPDLinDirectThreadSolver. ProfileSPDLinDirectThreadSolver is a subclass 
 // of LinearSOESOlver. It solves a ProfileSPDLinSOE object using
-// the LDL^t factorization.
+// the LDL^t factorization. The columns are factored a panel of blockSize
+// columns at a time; once a panel is factored, the rows of the panel in
+// all later columns are updated in parallel on the shared thread pool.
 
 // What: "@(#) ProfileSPDLinDirectThreadSolver.h, revA"
 
@@ -36,16 +38,17 @@
 
 #include <ProfileSPDLinSolver.h>
 class  ProfileSPDLinSOE;
-struct ProfileTCB;
 
 class ProfileSPDLinDirectThreadSolver : public ProfileSPDLinSolver
 {
   public:
-    ProfileSPDLinDirectThreadSolver(int numProcessors, int blockSize, double tol);    
+    // numThreads = 0 uses every thread of the shared pool
+    ProfileSPDLinDirectThreadSolver(int numThreads=0, int blockSize=64, double tol=1.0e-12);
     virtual ~ProfileSPDLinDirectThreadSolver();
 
     virtual int solve(void);        
     virtual int setSize(void);    
+    double getDeterminant(void);
 
     virtual int setProfileSOE(ProfileSPDLinSOE &theSOE);
 
@@ -54,8 +57,11 @@ class ProfileSPDLinDirectThreadSolver : public ProfileSPDLinSolver
 		 FEM_ObjectBroker &theBroker);
 
   protected:
-    int NP;
-    int running;
+    int factor(void);
+    int factorPanel(int first, int last);
+    void updateColumns(int first, int last, int panelFirst, int panelLast);
+
+    int numThreads;
     
     double minDiagTol;
     int blockSize;
@@ -63,11 +69,6 @@ class ProfileSPDLinDirectThreadSolver : public ProfileSPDLinSolver
     int size;
     int *RowTop;
     double **topRowPtr, *invD;
-    
-  private:
-    struct ProfileTCB* tcb;
-
 };
 
 #endif
-
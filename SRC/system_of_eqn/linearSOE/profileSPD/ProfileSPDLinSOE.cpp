@@ -122,7 +122,6 @@ ProfileSPDLinSOE::getNumEqn(void) const
 int 
 ProfileSPDLinSOE::setSize(Graph &theGraph)
 {
-    int oldSize = size;
     int result = 0;
     size = theGraph.getNumVertex();
 
@@ -142,17 +141,25 @@ ProfileSPDLinSOE::setSize(Graph &theGraph)
     // now we go through the vertices to find the height of each col and
     // width of each row from the connectivity information.
     
+    // find the internal numbering of the equations
+    theOrdering.setGraph(theGraph);
+    if (theOrdering.getApplied() != EquationOrdering::None)
+      opsdbg << G3_DEBUG_PROMPT << "ProfileSPDLinSOE - "
+             << EquationOrdering::name(theOrdering.getApplied())
+             << " ordering changed the profile from " << (double)theOrdering.getOriginalSize()
+             << " to " << (double)theOrdering.getReorderedSize() << "\n";
+
     Vertex *vertexPtr;
     VertexIter &theVertices = theGraph.getVertices();
 
     while ((vertexPtr = theVertices()) != 0) {
-	int vertexNum = vertexPtr->getTag();
+	int vertexNum = theOrdering(vertexPtr->getTag());
 	const ID &theAdjacency = vertexPtr->getAdjacency();
 	int iiDiagLoc = iDiagLoc[vertexNum];
 	int *iiDiagLocPtr = &(iDiagLoc[vertexNum]);
 
 	for (int i=0; i<theAdjacency.Size(); i++) {
-	    int otherNum = theAdjacency(i);
+	    int otherNum = theOrdering(theAdjacency(i));
 	    int diff = vertexNum-otherNum;
 	    if (diff > 0) {
 		if (iiDiagLoc < diff) {
@@ -214,18 +221,23 @@ ProfileSPDLinSOE::setSize(Graph &theGraph)
       }
     }
     
-    if (size != oldSize) {
-	if (vectX != 0)
-	    delete vectX;
-	if (vectB != 0)
-	    delete vectB;
-	
+    // when the equations are renumbered, vectX and vectB hold copies of
+    // X and B in the numbering of the analysis
+    if (vectX != 0)
+	delete vectX;
+    if (vectB != 0)
+	delete vectB;
+
+    if (theOrdering.isIdentity()) {
 	vectX = new Vector(X,size);
 	vectB = new Vector(B,size);
-	
-	if (size > Bsize)
-	    Bsize = size;
+    } else {
+	vectX = new Vector(size);
+	vectB = new Vector(size);
     }
+
+    if (size > Bsize)
+	Bsize = size;
     
     // invoke setSize() on the Solver
     LinearSOESolver *the_Solver = this->getSolver();
@@ -252,7 +264,7 @@ ProfileSPDLinSOE::addA(const Matrix &m, const ID &id, double fact)
 
     if (fact == 1.0) { // do not need to multiply 
 	for (int i=0; i<idSize; i++) {
-	    int col = id(i);
+	    int col = theOrdering(id(i));
 	    if (col < size && col >= 0) {
 		double *coliiPtr = &A[iDiagLoc[col] -1]; // -1 as fortran indexing 
 		int minColRow;
@@ -261,7 +273,7 @@ ProfileSPDLinSOE::addA(const Matrix &m, const ID &id, double fact)
 		else
 		    minColRow = col - (iDiagLoc[col] - iDiagLoc[col-1]) +1;
 		for (int j=0; j<idSize; j++) {
-		    int row = id(j);
+		    int row = theOrdering(id(j));
 		    if (row <size && row >= 0 && 
 			row <= col && row >= minColRow) { 
 
@@ -274,7 +286,7 @@ ProfileSPDLinSOE::addA(const Matrix &m, const ID &id, double fact)
 	}  // for i
     } else {
 	for (int i=0; i<idSize; i++) {
-	    int col = id(i);
+	    int col = theOrdering(id(i));
 	    if (col < size && col >= 0) {
 		double *coliiPtr = &A[iDiagLoc[col] -1]; // -1 as fortran indexing 		
 		int minColRow;
@@ -284,7 +296,7 @@ ProfileSPDLinSOE::addA(const Matrix &m, const ID &id, double fact)
 		    minColRow = col - (iDiagLoc[col] - iDiagLoc[col-1]) +1;
 
 		for (int j=0; j<idSize; j++) {
-		    int row = id(j);
+		    int row = theOrdering(id(j));
 		    if (row < size && row >= 0 && 
 			row <= col && row >= minColRow) { 
 
@@ -318,48 +330,20 @@ ProfileSPDLinSOE::addColA(const Vector &colData, int col, double fact)
   }
 
   
-  if (fact == 1.0) { // do not need to multiply 
-
-    double *coliiPtr = &A[iDiagLoc[col] -1]; // -1 as fortran indexing 
-    int minColRow;
-    if (col == 0)
-      minColRow = 0;
-    else
-      minColRow = col - (iDiagLoc[col] - iDiagLoc[col-1]) +1;
-    for (int row=0; row<size; row++) {
-      double data = colData(row);
-      if (data != 0) {
-	if (row < size && row >= 0 && 
-	    row <= col && row >= minColRow) { 
-	  
-	  // we only add upper and inside profile
-	  double *APtr = coliiPtr + (row-col);
-	  *APtr += data;
-	}
-      }
-    }
-
-  } else {
-
-    double *coliiPtr = &A[iDiagLoc[col] -1]; // -1 as fortran indexing 
-    int minColRow;
-    if (col == 0)
-      minColRow = 0;
-    else
-      minColRow = col - (iDiagLoc[col] - iDiagLoc[col-1]) +1;
-
-    for (int row=0; row<size; row++) {
-      double data = colData(row);
-      if (data != 0) {
-	if (row <size && row >= 0 && 
-	    row <= col && row >= minColRow) { 
-	  
-	  // we only add upper and inside profile
-	  double *APtr = coliiPtr + (row-col);
-	  *APtr += data * fact;
-	}
-      }
-    }
+  // colData is in the numbering of the analysis
+  const int icol = theOrdering(col);
+  double *coliiPtr = &A[iDiagLoc[icol] -1]; // -1 as fortran indexing 
+  int minColRow;
+  if (icol == 0)
+    minColRow = 0;
+  else
+    minColRow = icol - (iDiagLoc[icol] - iDiagLoc[icol-1]) +1;
+
+  // we only add upper and inside profile
+  for (int row=minColRow; row<=icol; row++) {
+    double data = colData(theOrdering.original(row));
+    if (data != 0)
+      coliiPtr[row-icol] += data * fact;
   }
   return 0;
 }
@@ -382,19 +366,19 @@ ProfileSPDLinSOE::addB(const Vector &v, const ID &id, double fact)
     
     if (fact == 1.0) { // do not need to multiply if fact == 1.0
 	for (int i=0; i<id.Size(); i++) {
-	    int pos = id(i);
+	    int pos = theOrdering(id(i));
 	    if (pos <size && pos >= 0)
 		B[pos] += v(i);
 	}
     } else if (fact == -1.0) { // do not need to multiply if fact == -1.0
 	for (int i=0; i<id.Size(); i++) {
-	    int pos = id(i);
+	    int pos = theOrdering(id(i));
 	    if (pos <size && pos >= 0)
 		B[pos] -= v(i);
 	}
     } else {
 	for (int i=0; i<id.Size(); i++) {
-	    int pos = id(i);
+	    int pos = theOrdering(id(i));
 	    if (pos <size && pos >= 0)
 		B[pos] += v(i) * fact;
 	}
@@ -418,15 +402,15 @@ ProfileSPDLinSOE::setB(const Vector &v, double fact)
     
     if (fact == 1.0) { // do not need to multiply if fact == 1.0
 	for (int i=0; i<size; i++) {
-	    B[i] = v(i);
+	    B[theOrdering(i)] = v(i);
 	}
     } else if (fact == -1.0) {
 	for (int i=0; i<size; i++) {
-	    B[i] = -v(i);
+	    B[theOrdering(i)] = -v(i);
 	}
     } else {
 	for (int i=0; i<size; i++) {
-	    B[i] = v(i) * fact;
+	    B[theOrdering(i)] = v(i) * fact;
 	}
     }	
     return 0;
@@ -455,20 +439,29 @@ void
 ProfileSPDLinSOE::setX(int loc, double value)
 {
     if (loc < size && loc >=0)
-	X[loc] = value;
+	X[theOrdering(loc)] = value;
 }
 
 void 
 ProfileSPDLinSOE::setX(const Vector &x)
 {
-  if (x.Size() == size && vectX != 0)
+  if (x.Size() != size || vectX == 0)
+    return;
+
+  if (theOrdering.isIdentity())
     *vectX = x;
+  else
+    for (int i=0; i<size; i++)
+      X[theOrdering(i)] = x(i);
 }
 
 const Vector &
 ProfileSPDLinSOE::getX(void)
 {
   assert(vectX != nullptr);
+  if (!theOrdering.isIdentity())
+    for (int i=0; i<size; i++)
+      (*vectX)(i) = X[theOrdering(i)];
   return *vectX;
 }
 
@@ -476,6 +469,9 @@ const Vector &
 ProfileSPDLinSOE::getB(void)
 {
   assert(vectB != nullptr);
+  if (!theOrdering.isIdentity())
+    for (int i=0; i<size; i++)
+      (*vectB)(i) = B[theOrdering(i)];
   return *vectB;
 }
 
@@ -492,6 +488,14 @@ ProfileSPDLinSOE::normRHS(void)
 }    
 
 
+void
+ProfileSPDLinSOE::setOrdering(EquationOrdering::Method method)
+{
+    // takes effect the next time setSize is called
+    theOrdering.setMethod(method);
+}
+
+
 int
 ProfileSPDLinSOE::setProfileSPDSolver(ProfileSPDLinSolver &newSolver)
 {
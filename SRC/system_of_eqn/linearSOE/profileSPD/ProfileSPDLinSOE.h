@@ -24,6 +24,11 @@
 // Description: This file contains the class definition for ProfileSPDLinSOE
 // ProfileSPDLinSOE is a subclass of LinearSOE. It uses the LAPACK Upper storage
 // scheme to store the components of the A matrix.
+//
+// The equations may be renumbered internally to reduce the profile (see
+// EquationOrdering); A, B and X are then stored in that order, while
+// every method taking or returning equation numbers uses the numbering
+// of the analysis.
 
 // What: "@(#) ProfileSPDLinSOE.h, revA"
 
@@ -32,6 +37,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <EquationOrdering.h>
 class ProfileSPDLinSolver;
 
 class ProfileSPDLinSOE : public LinearSOE
@@ -63,6 +69,9 @@ class ProfileSPDLinSOE : public LinearSOE
     virtual double normRHS(void);
 
     virtual int setProfileSPDSolver(ProfileSPDLinSolver &newSolver);    
+    void setOrdering(EquationOrdering::Method method);
+    const EquationOrdering &getOrdering(void) const {return theOrdering;}
+
     virtual int sendSelf(int commitTag, Channel &theChannel);
     virtual int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);
 
@@ -83,6 +92,7 @@ class ProfileSPDLinSOE : public LinearSOE
     int Asize, Bsize;
     bool isAfactored, isAcondensed;
     int numInt;
+    EquationOrdering theOrdering;
     
   private:
 };
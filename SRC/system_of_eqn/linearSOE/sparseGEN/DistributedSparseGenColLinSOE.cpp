@@ -82,6 +82,10 @@ DistributedSparseGenColLinSOE::setSize(Graph &theGraph)
   int oldSize = size;
   int maxNumSubVertex = 0;
 
+  // rowA and colStartA are rebuilt below; addA will relocate its entries
+  scatter.clear();
+  this->clearColors();
+
   // if subprocess, collect graph, send it off, 
   // vector back containing size of system, etc.
   if (processID != 0) {
@@ -41,6 +41,11 @@
 
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
+#include <AnalysisModel.h>
+#include <FE_EleIter.h>
+#include <FE_Element.h>
+#include <DOF_GrpIter.h>
+#include <DOF_Group.h>
 #include <iostream>
 using std::nothrow;
 
@@ -149,6 +154,8 @@ SparseGenColLinSOE::setSize(Graph &theGraph)
     int result = 0;
     int oldSize = size;
     size = theGraph.getNumVertex();
+    scatter.clear();
+    this->clearColors();
 
     // fist itearte through the vertices of the graph to get nnz
     Vertex *theVertex;
@@ -247,6 +254,21 @@ SparseGenColLinSOE::setSize(Graph &theGraph)
       }
     }
 
+    // the sparsity has changed; rebuild the scatter offsets
+    // for the FE_Elements and DOF_Groups of the model
+    if (theModel != nullptr) {
+      auto locate = [this](int row, int col, int, int) {
+        return this->locateA(row, col);
+      };
+      FE_EleIter &theEles = theModel->getFEs();
+      FE_Element *elePtr;
+      while ((elePtr = theEles()) != nullptr)
+        scatter.add(elePtr->getID(), locate);
+      DOF_GrpIter &theDOFs = theModel->getDOFs();
+      DOF_Group *dofPtr;
+      while ((dofPtr = theDOFs()) != nullptr)
+        scatter.add(dofPtr->getID(), locate);
+    }
     
     // invoke setSize() on the Solver    
     LinearSOESolver *the_Solver = this->getSolver();
@@ -260,6 +282,20 @@ SparseGenColLinSOE::setSize(Graph &theGraph)
     return result;
 }
 
+int
+SparseGenColLinSOE::locateA(int row, int col) const
+{
+    if (row < 0 || row >= size || col < 0 || col >= size)
+      return -1;
+
+    // find place in A using rowA
+    for (int k=colStartA[col]; k<colStartA[col+1]; k++)
+      if (rowA[k] == row)
+        return k;
+
+    return -1;
+}
+
 int 
 SparseGenColLinSOE::addA(const Matrix &m, const ID &id, double fact)
 {
@@ -271,46 +307,23 @@ SparseGenColLinSOE::addA(const Matrix &m, const ID &id, double fact)
     if (fact == 0.0)  
         return 0;
 
-    int idSize = id.Size();
- 
+    const int idSize = id.Size();
+    if (idSize == 0)
+        return 0;
+
+    // offsets in A of the entries of m; only searched for
+    // IDs that were not seen by setSize
+    auto locate = [this](int row, int col, int, int) {
+      return this->locateA(row, col);
+    };
     if (fact == 1.0) { // do not need to multiply 
-      for (int i=0; i<idSize; i++) {
-        int col = id(i);
-        if (col < size && col >= 0) {
-          int startColLoc = colStartA[col];
-          int endColLoc = colStartA[col+1];
-          for (int j=0; j<idSize; j++) {
-            int row = id(j);
-            if (row <size && row >= 0) {
-              // find place in A using rowA
-              for (int k=startColLoc; k<endColLoc; k++)
-                if (rowA[k] == row) {
-                  A[k] += m(j,i);
-                  k = endColLoc;
-                }
-            }
-          }  // for j                
-        } 
-      }  // for i
+      scatter.scatter(id, locate, [&](int k, int i, int j) {
+        A[k] += m(i,j);
+      });
     } else {
-      for (int i=0; i<idSize; i++) {
-        int col = id(i);
-        if (col < size && col >= 0) {
-          int startColLoc = colStartA[col];
-          int endColLoc = colStartA[col+1];
-          for (int j=0; j<idSize; j++) {
-            int row = id(j);
-            if (row <size && row >= 0) {
-              // find place in A using rowA
-              for (int k=startColLoc; k<endColLoc; k++)
-                if (rowA[k] == row) {
-                  A[k] += fact * m(j,i);
-                  k = endColLoc;
-                }
-            }
-          }  // for j                
-        } 
-      }  // for i
+      scatter.scatter(id, locate, [&](int k, int i, int j) {
+        A[k] += fact * m(i,j);
+      });
     }
     return 0;
 }
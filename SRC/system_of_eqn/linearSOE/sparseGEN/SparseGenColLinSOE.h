@@ -38,6 +38,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <ScatterMap.h>
 
 class SparseGenColLinSolver;
 
@@ -70,6 +71,8 @@ class SparseGenColLinSOE : public LinearSOE
     virtual void setX(const Vector &x);        
     virtual int setSparseGenColSolver(SparseGenColLinSolver &newSolver);    
 
+    int locateA(int row, int col) const; // offset of (row,col) in A, or -1
+
     virtual int sendSelf(int commitTag, Channel &theChannel);
     virtual int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);    
 #ifdef _PARALLEL_PROCESSING
@@ -96,6 +99,10 @@ class SparseGenColLinSOE : public LinearSOE
     Vector *vectB;    
     int Asize, Bsize;    // size of the 1d array holding A
     bool factored;
+
+    ScatterMap<int,-1> scatter;          // cached offsets used by addA
+    // addA only reads the offsets built in setSize
+    bool hasConcurrentAddA(void) const {return true;}
     
   private:
 
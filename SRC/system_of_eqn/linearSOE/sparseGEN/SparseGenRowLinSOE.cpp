@@ -34,6 +34,11 @@
 
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
+#include <AnalysisModel.h>
+#include <FE_EleIter.h>
+#include <FE_Element.h>
+#include <DOF_GrpIter.h>
+#include <DOF_Group.h>
 
 SparseGenRowLinSOE::SparseGenRowLinSOE(SparseGenRowLinSolver &the_Solver)
 :LinearSOE(the_Solver, LinSOE_TAGS_SparseGenRowLinSOE),
@@ -127,6 +132,8 @@ SparseGenRowLinSOE::setSize(Graph &theGraph)
     int result = 0;
     int oldSize = size;
     size = theGraph.getNumVertex();
+    scatter.clear();
+    this->clearColors();
 
     // fist itearte through the vertices of the graph to get nnz
     Vertex *theVertex;
@@ -234,6 +241,22 @@ SparseGenRowLinSOE::setSize(Graph &theGraph)
       }
     }
 
+    // the sparsity has changed; rebuild the scatter offsets
+    // for the FE_Elements and DOF_Groups of the model
+    if (theModel != nullptr) {
+      auto locate = [this](int row, int col, int, int) {
+        return this->locateA(row, col);
+      };
+      FE_EleIter &theEles = theModel->getFEs();
+      FE_Element *elePtr;
+      while ((elePtr = theEles()) != nullptr)
+        scatter.add(elePtr->getID(), locate);
+      DOF_GrpIter &theDOFs = theModel->getDOFs();
+      DOF_Group *dofPtr;
+      while ((dofPtr = theDOFs()) != nullptr)
+        scatter.add(dofPtr->getID(), locate);
+    }
+
     // invoke setSize() on the Solver   
      LinearSOESolver *the_Solver = this->getSolver();
     int solverOK = the_Solver->setSize();
@@ -245,6 +268,20 @@ SparseGenRowLinSOE::setSize(Graph &theGraph)
     return result;
 }
 
+int
+SparseGenRowLinSOE::locateA(int row, int col) const
+{
+    if (row < 0 || row >= size || col < 0 || col >= size)
+	return -1;
+
+    // find place in A using colA
+    for (int k=rowStartA[row]; k<rowStartA[row+1]; k++)
+	if (colA[k] == col)
+	    return k;
+
+    return -1;
+}
+
 int 
 SparseGenRowLinSOE::addA(const Matrix &m, const ID &id, double fact)
 {
@@ -255,47 +292,22 @@ SparseGenRowLinSOE::addA(const Matrix &m, const ID &id, double fact)
 	return 0;
 
     const int idSize = id.Size();
-    
-    // check that m and id are of similar size
+    if (idSize == 0)
+	return 0;
 
+    // offsets in A of the entries of m; only searched for
+    // IDs that were not seen by setSize
+    auto locate = [this](int row, int col, int, int) {
+      return this->locateA(row, col);
+    };
     if (fact == 1.0) { // do not need to multiply 
-	for (int i=0; i<idSize; i++) {
-	    int row = id(i);
-	    if (row < size && row >= 0) {
-		int startRowLoc = rowStartA[row];
-		int endRowLoc = rowStartA[row+1];
-		for (int j=0; j<idSize; j++) {
-		    int col = id(j);
-		    if (col <size && col >= 0) {
-			// find place in A using colA
-			for (int k=startRowLoc; k<endRowLoc; k++)
-			    if (colA[k] == col) {
-				A[k] += m(i,j);
-				k = endRowLoc;
-			    }
-		     }
-		}  // for j		
-	    } 
-	}  // for i
+      scatter.scatter(id, locate, [&](int k, int i, int j) {
+        A[k] += m(i,j);
+      });
     } else {
-	for (int i=0; i<idSize; i++) {
-	    int row = id(i);
-	    if (row < size && row >= 0) {
-		int startRowLoc = rowStartA[row];
-		int endRowLoc = rowStartA[row+1];
-		for (int j=0; j<idSize; j++) {
-		    int col = id(j);
-		    if (col <size && col >= 0) {
-			// find place in A using colA
-			for (int k=startRowLoc; k<endRowLoc; k++)
-			    if (colA[k] == col) {
-				A[k] += fact * m(i,j);
-				k = endRowLoc;
-			    }
-		     }
-		}  // for j		
-	    } 
-	}  // for i
+      scatter.scatter(id, locate, [&](int k, int i, int j) {
+        A[k] += fact * m(i,j);
+      });
     }
     return 0;
 }
@@ -433,6 +445,21 @@ SparseGenRowLinSOE::normRHS(void)
 }    
 
 
+int
+SparseGenRowLinSOE::formAp(const Vector &p, Vector &Ap)
+{
+    assert(p.Size() == size && Ap.Size() == size);
+
+    for (int row=0; row<size; row++) {
+	double sum = 0.0;
+	for (int k=rowStartA[row]; k<rowStartA[row+1]; k++)
+	    sum += A[k] * p(colA[k]);
+	Ap(row) = sum;
+    }
+    return 0;
+}
+
+
 int
 SparseGenRowLinSOE::setSparseGenRowSolver(SparseGenRowLinSolver &newSolver)
 {
@@ -38,6 +38,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <ScatterMap.h>
 
 class SparseGenRowLinSolver;
 
@@ -60,21 +61,23 @@ class SparseGenRowLinSOE : public LinearSOE
     const Vector &getX(void);
     const Vector &getB(void);    
     double normRHS(void);
+    int formAp(const Vector &p, Vector &Ap);
 
     void setX(int loc, double value);        
     void setX(const Vector &x);        
     int setSparseGenRowSolver(SparseGenRowLinSolver &newSolver);    
 
+    int locateA(int row, int col) const; // offset of (row,col) in A, or -1
+
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);    
     friend class PetscSparseSeqSolver;    
     friend class CulaSparseSolverS4;    
     friend class CulaSparseSolverS5;    
 	friend class CuSPSolver;
+    friend class KrylovSolver;
 
   protected:
-    
-  private:
     int size;            // order of A
     int nnz;             // number of non-zeros in A
     double *A, *B, *X;   // 1d arrays containing coefficients of A, B and X
@@ -83,6 +86,12 @@ class SparseGenRowLinSOE : public LinearSOE
     Vector *vectB;    
     int Asize, Bsize;    // size of the 1d array holding A
     bool factored;
+
+    ScatterMap<int,-1> scatter;          // cached offsets used by addA
+
+  private:
+    // addA only reads the offsets built in setSize
+    bool hasConcurrentAddA(void) const {return true;}
 };
 
 
@@ -27,14 +27,17 @@
 // What: "@(#) SuperLU.h, revA"
 
 #include <SuperLU.h>
+#include <SuperLUSingle.h>
 #include <SparseGenColLinSOE.h>
 #include <math.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
 #include <DataFileStream.h>
+#include <Profiler.h>
 #include <iostream>
 #include <elementAPI.h>
 #include <string>
+#include <algorithm>
 using std::nothrow;
 
 void* OPS_SuperLUSolver()
@@ -51,6 +54,9 @@ void* OPS_SuperLUSolver()
     double drop_tol = 0.0;
     
     int numData = 1;
+    bool mixed = false;
+    double refineTol = 1.0e-10;
+    int maxRefine = 10;
 
     while (OPS_GetNumRemainingInputArgs() > 1) {
 	std::string type = OPS_GetString();
@@ -64,14 +70,22 @@ void* OPS_SuperLUSolver()
 	    if(OPS_GetIntInput(&numData,&npCol)<0) return 0;
 	} else if(type=="s"||type=="symmetric"||type=="-symm") {
 	    symmetric = 'Y';
+	} else if(type=="-mixed") {
+	    mixed = true;
+	} else if(type=="-refineTol") {
+	    if(OPS_GetDoubleInput(&numData,&refineTol)<0) return 0;
+	} else if(type=="-maxRefine") {
+	    if(OPS_GetIntInput(&numData,&maxRefine)<0) return 0;
 	}
     }
 
-    SparseGenColLinSolver *theSolver = new SuperLU(permSpec,drop_tol,panelSize,relax,symmetric);
+    SuperLU *theSolver = new SuperLU(permSpec,drop_tol,panelSize,relax,symmetric);
     if(theSolver == 0) {
 	opserr<<"run out of memory in creating SuperLU\n";
 	return 0;
     }
+    if (mixed)
+      theSolver->setMixedPrecision(refineTol, maxRefine);
     return new SparseGenColLinSOE(*theSolver);
 }
 
@@ -83,7 +97,10 @@ SuperLU::SuperLU(int perm,
 :SparseGenColLinSolver(SOLVER_TAGS_SuperLU),
  perm_r(0),perm_c(0), etree(0), sizePerm(0),
  relax(relx), permSpec(perm), panelSize(panel), 
- drop_tol(drop_tolerance), symmetric(symm)
+ drop_tol(drop_tolerance), symmetric(symm),
+ statistics{0, 0, 0, 0, 0, 0, 0, 0},
+ mixed(false), useDouble(false), refineTol(1.0e-10), maxRefine(10),
+ factSingle(DOFACT), perm_rs(0)
 {
   // set_default_options(&options);
   options.Fact = DOFACT;
@@ -105,6 +122,12 @@ SuperLU::SuperLU(int perm,
   A.ncol = 0;
   B.ncol = 0;
   AC.ncol = 0;
+
+  As.ncol  = 0;
+  ACs.ncol = 0;
+  Ls.ncol  = 0;
+  Us.ncol  = 0;
+  Bs.ncol  = 0;
 }
 
 
@@ -112,6 +135,8 @@ SuperLU::~SuperLU()
 {
   if (perm_r != 0)
     delete [] perm_r;
+  if (perm_rs != 0)
+    delete [] perm_rs;
   if (perm_c != 0)
     delete [] perm_c;
   if (etree != 0) {
@@ -119,6 +144,12 @@ SuperLU::~SuperLU()
     StatFree(&stat);
   }
 
+  this->freeMatrices();
+}
+
+void
+SuperLU::freeMatrices()
+{
   if (L.ncol != 0)
     Destroy_SuperNode_Matrix(&L);
   if (U.ncol != 0)
@@ -135,6 +166,213 @@ SuperLU::~SuperLU()
   if (B.ncol != 0) {
     SUPERLU_FREE(B.Store);
   }
+  L.ncol = 0;
+  U.ncol = 0;
+  A.ncol = 0;
+  B.ncol = 0;
+  AC.ncol = 0;
+
+  this->freeSingle();
+}
+
+
+void
+SuperLU::freeSingle()
+{
+  if (Ls.ncol != 0)
+    Destroy_SuperNode_Matrix(&Ls);
+  if (Us.ncol != 0)
+    Destroy_CompCol_Matrix(&Us);
+  if (ACs.ncol != 0) {
+    NCPformat *ACstore = (NCPformat *)ACs.Store;
+    SUPERLU_FREE(ACstore->colbeg);
+    SUPERLU_FREE(ACstore->colend);
+    SUPERLU_FREE(ACstore);
+  }
+  if (As.ncol != 0)
+    SUPERLU_FREE(As.Store);
+  if (Bs.ncol != 0)
+    SUPERLU_FREE(Bs.Store);
+  Ls.ncol  = 0;
+  Us.ncol  = 0;
+  ACs.ncol = 0;
+  As.ncol  = 0;
+  Bs.ncol  = 0;
+  factSingle = DOFACT;
+}
+
+
+void
+SuperLU::setMixedPrecision(double tol, int maxIter)
+{
+  mixed = true;
+  useDouble = false;
+  refineTol = tol;
+  maxRefine = maxIter > 0 ? maxIter : 1;
+}
+
+
+//
+// Create the single precision copies of A and AC. AC must already be
+// the preordered double matrix; its column pointers are copied rather
+// than calling sp_preorder again, which would permute perm_c a second
+// time.
+//
+int
+SuperLU::buildSingle()
+{
+  int n = theSOE->size;
+  int nnz = theSOE->nnz;
+
+  this->freeSingle();
+
+  Asingle.resize(nnz);
+  Xsingle.resize(n);
+  residual.resize(n);
+
+  if (perm_rs != 0)
+    delete [] perm_rs;
+  perm_rs = new (nothrow) int[n];
+  if (perm_rs == 0) {
+    opserr << "WARNING SuperLU::setSize()";
+    opserr << " - ran out of memory\n";
+    return -1;
+  }
+
+  SuperLUSingle::createCompCol(&As, n, nnz, Asingle.data(),
+                               theSOE->rowA, theSOE->colStartA);
+  SuperLUSingle::createDense(&Bs, n, Xsingle.data());
+
+  NCPformat *ACstore  = (NCPformat *)AC.Store;
+  NCPformat *ACsstore = (NCPformat *)SUPERLU_MALLOC(sizeof(NCPformat));
+  ACsstore->nnz    = ACstore->nnz;
+  ACsstore->nzval  = Asingle.data();
+  ACsstore->rowind = theSOE->rowA;
+  ACsstore->colbeg = (int *)SUPERLU_MALLOC(n*sizeof(int));
+  ACsstore->colend = (int *)SUPERLU_MALLOC(n*sizeof(int));
+  for (int i=0; i<n; i++) {
+    ACsstore->colbeg[i] = ACstore->colbeg[i];
+    ACsstore->colend[i] = ACstore->colend[i];
+  }
+  ACs.Stype = SLU_NCP;
+  ACs.Dtype = SLU_S;
+  ACs.Mtype = AC.Mtype;
+  ACs.nrow  = n;
+  ACs.ncol  = n;
+  ACs.Store = ACsstore;
+
+  factSingle = DOFACT;
+  return 0;
+}
+
+
+//
+// Factor A in single precision if needed and refine the solution in
+// theSOE->X. Returns 0 on convergence and -1 if the factorization
+// failed or the refinement stalled.
+//
+int
+SuperLU::solveMixed()
+{
+  int n = theSOE->size;
+  int info;
+
+  if (theSOE->factored == false) {
+
+    for (int i=0; i<theSOE->nnz; i++)
+      Asingle[i] = (float)theSOE->A[i];
+
+    if (Ls.ncol != 0 && symmetric == 'N') {
+      Destroy_SuperNode_Matrix(&Ls);
+      Destroy_CompCol_Matrix(&Us);
+    }
+
+    fact_t fact = options.Fact;
+    options.Fact = factSingle;
+    {
+      Profiler::Scope scope("factor");
+      info = SuperLUSingle::factor(&options, &ACs, relax, panelSize,
+                                   etree, perm_c, perm_rs, &Ls, &Us, &stat);
+    }
+    options.Fact = fact;
+    statistics.single++;
+
+    if (info != 0) {
+      Ls.ncol = 0;
+      Us.ncol = 0;
+      factSingle = DOFACT;
+      return -1;
+    }
+
+    factSingle = (symmetric == 'Y') ? SamePattern_SameRowPerm : SamePattern;
+    theSOE->factored = true;
+  }
+
+  // refine x from x = 0, with r = b - A x in double precision
+  const double *b = theSOE->B;
+  double *x = theSOE->X;
+  double normB = 0.0;
+  for (int i=0; i<n; i++) {
+    x[i] = 0.0;
+    residual[i] = b[i];
+    normB += b[i]*b[i];
+  }
+  normB = sqrt(normB);
+  if (normB == 0.0)
+    return 0;
+
+  double normR = normB;
+  for (int k=0; k<maxRefine; k++) {
+    for (int i=0; i<n; i++)
+      Xsingle[i] = (float)residual[i];
+
+    {
+      Profiler::Scope scope("substitute");
+      info = SuperLUSingle::solve(&Ls, &Us, perm_c, perm_rs, &Bs, &stat);
+    }
+    statistics.solve++;
+    statistics.refine++;
+    if (info != 0)
+      return -1;
+
+    for (int i=0; i<n; i++) {
+      x[i] += Xsingle[i];
+      residual[i] = b[i];
+    }
+    for (int j=0; j<n; j++) {
+      double xj = x[j];
+      for (int l=theSOE->colStartA[j]; l<theSOE->colStartA[j+1]; l++)
+        residual[theSOE->rowA[l]] -= theSOE->A[l]*xj;
+    }
+
+    double norm = 0.0;
+    for (int i=0; i<n; i++)
+      norm += residual[i]*residual[i];
+    norm = sqrt(norm);
+
+    if (norm <= refineTol*normB)
+      return 0;
+
+    // stalled; each step should at least halve the residual
+    if (norm > 0.5*normR)
+      return -1;
+    normR = norm;
+  }
+
+  return -1;
+}
+
+//
+// True if the compressed column structure is the one AC was built for
+//
+bool
+SuperLU::samePattern(int n, int nnz, const int *colStart, const int *row) const
+{
+  if ((int)patternColStart.size() != n+1 || (int)patternRow.size() != nnz)
+    return false;
+
+  return std::equal(colStart, colStart+n+1, patternColStart.begin())
+      && std::equal(row, row+nnz, patternRow.begin());
 }
 
 /*
@@ -217,6 +455,21 @@ SuperLU::solve(void)
     for (int i=0; i<n; i++)
 	*(Xptr++) = *(Bptr++);
 
+    if (mixed && !useDouble) {
+      if (this->solveMixed() == 0)
+	return 0;
+
+      // fall back to a double precision factorization of this pattern
+      opserr << "WARNING SuperLU::solve(void)- ";
+      opserr << " iterative refinement stalled; factoring in double precision\n";
+      statistics.fallback++;
+      useDouble = true;
+      this->freeSingle();
+      theSOE->factored = false;
+      for (int i=0; i<n; i++)
+	theSOE->X[i] = theSOE->B[i];
+    }
+
     GlobalLU_t Glu; /* Not needed on return. */
 
     if (theSOE->factored == false) {
@@ -228,8 +481,16 @@ SuperLU::solve(void)
 	  Destroy_CompCol_Matrix(&U);	  
 	}
 
-	dgstrf(&options, &AC, relax, panelSize,
-	       etree, NULL, 0, perm_c, perm_r, &L, &U, &Glu, &stat, &info);
+	if (options.Fact == DOFACT)
+	  statistics.factor++;
+	else
+	  statistics.refactor++;
+
+	{
+	  Profiler::Scope scope("factor");
+	  dgstrf(&options, &AC, relax, panelSize,
+	         etree, NULL, 0, perm_c, perm_r, &L, &U, &Glu, &stat, &info);
+	}
 
 
 	if (info != 0) {	
@@ -249,7 +510,11 @@ SuperLU::solve(void)
     // do forward and backward substitution
     trans_t trans = NOTRANS;
     int info;
-    dgstrs (trans, &L, &U, perm_c, perm_r, &B, &stat, &info);    
+    {
+      Profiler::Scope scope("substitute");
+      dgstrs (trans, &L, &U, perm_c, perm_r, &B, &stat, &info);
+    }
+    statistics.solve++;
 
     if (info != 0) {	
        opserr << "WARNING SuperLU::solve(void)- ";
@@ -269,6 +534,8 @@ SuperLU::setSize()
     int n = theSOE->size;
     if (n > 0) {
 
+      const bool haveStat = (etree != 0);
+
       // create space for the permutation vectors 
       // and the elimination tree
       if (sizePerm < n) {
@@ -295,24 +562,92 @@ SuperLU::setSize()
       }
 
       // initialisation
-      StatInit(&stat);
+      if (!haveStat)
+	StatInit(&stat);
+
+      // the SOE may have reallocated its arrays, so A and B are
+      // always recreated around the current ones
+      if (A.ncol != 0)
+	SUPERLU_FREE(A.Store);
+      if (B.ncol != 0)
+	SUPERLU_FREE(B.Store);
 
       // create the SuperMatrix A	
       dCreate_CompCol_Matrix(&A, n, n, theSOE->nnz, theSOE->A, 
 			     theSOE->rowA, theSOE->colStartA, 
 			     SLU_NC, SLU_D, SLU_GE);
 
-      // obtain and apply column permutation to give SuperMatrix AC
-      get_perm_c(permSpec, &A, perm_c);
-
-      sp_preorder(&options, &A, perm_c, etree, &AC);
-
       // create the rhs SuperMatrix B 
       dCreate_Dense_Matrix(&B, n, 1, theSOE->X, n, SLU_DN, SLU_D, SLU_GE);
-	
-      // set the refact variable to 'N' after first factorization with new size 
-      // can set to 'Y'.
-      options.Fact = DOFACT;
+
+      if (AC.ncol != 0 && this->samePattern(n, theSOE->nnz, theSOE->colStartA, theSOE->rowA)) {
+	// same pattern; keep perm_c, etree and the column pointers of
+	// AC, which only need to refer to the new values
+	NCPformat *ACstore = (NCPformat *)AC.Store;
+	ACstore->nzval  = theSOE->A;
+	ACstore->rowind = theSOE->rowA;
+
+	// refactor as solve() would after a first factorization
+	if (L.ncol == 0)
+	  options.Fact = DOFACT;
+	else if (symmetric == 'Y')
+	  options.Fact = SamePattern_SameRowPerm;
+	else
+	  options.Fact = SamePattern;
+
+	statistics.reused++;
+
+	if (mixed && !useDouble) {
+	  if (ACs.ncol == 0 || (int)Asingle.size() != theSOE->nnz) {
+	    if (this->buildSingle() < 0)
+	      return -1;
+	  } else {
+	    // the row indices may have been reallocated with A
+	    ((NCformat *)As.Store)->rowind  = theSOE->rowA;
+	    ((NCformat *)As.Store)->colptr  = theSOE->colStartA;
+	    ((NCPformat *)ACs.Store)->rowind = theSOE->rowA;
+	    if (Ls.ncol == 0)
+	      factSingle = DOFACT;
+	  }
+	}
+
+      } else {
+	// new pattern; the old factors and AC do not apply
+	if (L.ncol != 0) {
+	  Destroy_SuperNode_Matrix(&L);
+	  L.ncol = 0;
+	}
+	if (U.ncol != 0) {
+	  Destroy_CompCol_Matrix(&U);
+	  U.ncol = 0;
+	}
+	if (AC.ncol != 0) {
+	  NCPformat *ACstore = (NCPformat *)AC.Store;
+	  SUPERLU_FREE(ACstore->colbeg);
+	  SUPERLU_FREE(ACstore->colend);
+	  SUPERLU_FREE(ACstore);
+	  AC.ncol = 0;
+	}
+
+	// obtain and apply column permutation to give SuperMatrix AC
+	get_perm_c(permSpec, &A, perm_c);
+
+	sp_preorder(&options, &A, perm_c, etree, &AC);
+
+	patternColStart.assign(theSOE->colStartA, theSOE->colStartA + n+1);
+	patternRow.assign(theSOE->rowA, theSOE->rowA + theSOE->nnz);
+
+	// set the refact variable to 'N' after first factorization with new size 
+	// can set to 'Y'.
+	options.Fact = DOFACT;
+
+	statistics.symbolic++;
+
+	// a new pattern gets another chance in single precision
+	useDouble = false;
+	if (mixed && this->buildSingle() < 0)
+	  return -1;
+      }
 
       if (symmetric == 'Y')
 	options.SymmetricMode=YES;
@@ -42,11 +42,23 @@
 // factorization; the preordering for sparsity is completely separate
 // from the factorization and a number of ordering schemes are provided. 
 //
+// The column permutation and elimination tree are kept with a copy of
+// the sparsity pattern of A, so a call to setSize() that does not
+// change the pattern (e.g. after a domain change that leaves the
+// connectivity alone) only leads to a numerical refactorization.
+//
+// In mixed precision mode A is factored in single precision and the
+// solution is improved by iterative refinement against the double
+// precision A of the SOE until the relative residual is below a
+// tolerance. If the refinement stalls the solver factors A in double
+// precision instead, and keeps doing so until the pattern changes.
+//
 // What: "@(#) SuperLU.h, revA"
 
 #include <SparseGenColLinSolver.h>
 #include <slu_ddefs.h>
 #include <supermatrix.h>
+#include <vector>
 
 class SuperLU : public SparseGenColLinSolver
 {
@@ -61,12 +73,34 @@ class SuperLU : public SparseGenColLinSolver
     int solve(void);
     int setSize(void);
 
+    // factor in single precision and refine to a relative residual of tol
+    void setMixedPrecision(double tol=1.0e-10, int maxIter=10);
+
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, FEM_ObjectBroker &theBroker);    
-    
+
+    // Number of times each path through setSize() and solve() is taken
+    struct Statistics {
+      int symbolic;     // setSize() computed a new ordering
+      int reused;       // setSize() kept the ordering of an unchanged pattern
+      int factor;       // full factorization, including the row permutation
+      int refactor;     // numerical factorization reusing the structure
+      int solve;        // triangular solves
+      int single;       // single precision factorizations (mixed mode)
+      int refine;       // refinement iterations (mixed mode)
+      int fallback;     // refinement stalled; A was factored in double
+    };
+    const Statistics &getStatistics() const {return statistics;}
+
   protected:
 
   private:
+    bool samePattern(int n, int nnz, const int *colStart, const int *row) const;
+    void freeMatrices();
+    void freeSingle();
+    int  buildSingle();
+    int  solveMixed();
+
     SuperMatrix A,L,U,B,AC;
     int *perm_r;
     int *perm_c;
@@ -77,6 +111,21 @@ class SuperLU : public SparseGenColLinSolver
     char symmetric;
     superlu_options_t options;
     SuperLUStat_t stat;
+
+    std::vector<int> patternColStart;  // pattern that AC was built for
+    std::vector<int> patternRow;
+    Statistics statistics;
+
+    // mixed precision
+    bool   mixed;         // factor in single precision
+    bool   useDouble;     // refinement stalled on the current pattern
+    double refineTol;
+    int    maxRefine;
+    fact_t factSingle;    // options.Fact for the next single factorization
+    SuperMatrix As,ACs,Ls,Us,Bs;
+    int *perm_rs;
+    std::vector<float>  Asingle, Xsingle;
+    std::vector<double> residual;
 };
 
 #endif
@@ -0,0 +1,52 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Single precision SuperLU routines for the mixed precision
+// mode of SuperLU; see SuperLUSingle.h.
+//
+// Written: cmp
+//
+#include <slu_sdefs.h>
+#include <SuperLUSingle.h>
+
+namespace SuperLUSingle {
+
+void
+createCompCol(SuperMatrix *A, int n, int nnz, float *nzval,
+              int *rowind, int *colptr)
+{
+  sCreate_CompCol_Matrix(A, n, n, nnz, nzval, rowind, colptr,
+                         SLU_NC, SLU_S, SLU_GE);
+}
+
+void
+createDense(SuperMatrix *B, int n, float *x)
+{
+  sCreate_Dense_Matrix(B, n, 1, x, n, SLU_DN, SLU_S, SLU_GE);
+}
+
+int
+factor(superlu_options_t *options, SuperMatrix *AC, int relax,
+       int panelSize, int *etree, int *perm_c, int *perm_r,
+       SuperMatrix *L, SuperMatrix *U, SuperLUStat_t *stat)
+{
+  GlobalLU_t Glu; // not needed on return
+  int info;
+  sgstrf(options, AC, relax, panelSize, etree, NULL, 0,
+         perm_c, perm_r, L, U, &Glu, stat, &info);
+  return info;
+}
+
+int
+solve(SuperMatrix *L, SuperMatrix *U, int *perm_c, int *perm_r,
+      SuperMatrix *B, SuperLUStat_t *stat)
+{
+  int info;
+  sgstrs(NOTRANS, L, U, perm_c, perm_r, B, stat, &info);
+  return info;
+}
+
+} // namespace SuperLUSingle
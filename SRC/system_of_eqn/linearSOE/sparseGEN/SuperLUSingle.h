@@ -0,0 +1,41 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: The single precision routines of the SuperLU library used
+// by the mixed precision mode of SuperLU. They are called through this
+// file because slu_sdefs.h and slu_ddefs.h both define GlobalLU_t and
+// cannot be included in the same translation unit; the arguments are the
+// precision independent types of supermatrix.h and slu_util.h.
+//
+// Written: cmp
+//
+#ifndef SuperLUSingle_h
+#define SuperLUSingle_h
+
+#include <supermatrix.h>
+#include <slu_util.h>
+
+namespace SuperLUSingle {
+
+// n x n compressed column matrix of nnz single precision values
+void createCompCol(SuperMatrix *A, int n, int nnz, float *nzval,
+                   int *rowind, int *colptr);
+
+// n x 1 dense matrix over x
+void createDense(SuperMatrix *B, int n, float *x);
+
+// sgstrf of the preordered matrix AC; returns its info
+int factor(superlu_options_t *options, SuperMatrix *AC, int relax,
+           int panelSize, int *etree, int *perm_c, int *perm_r,
+           SuperMatrix *L, SuperMatrix *U, SuperLUStat_t *stat);
+
+// sgstrs, overwriting B with the solution; returns its info
+int solve(SuperMatrix *L, SuperMatrix *U, int *perm_c, int *perm_r,
+          SuperMatrix *B, SuperLUStat_t *stat);
+
+} // namespace SuperLUSingle
+
+#endif
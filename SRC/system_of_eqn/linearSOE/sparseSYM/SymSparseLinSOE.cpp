@@ -25,6 +25,11 @@
 #include <math.h>
 #include <Channel.h>
 #include <FEM_ObjectBroker.h>
+#include <AnalysisModel.h>
+#include <FE_EleIter.h>
+#include <FE_Element.h>
+#include <DOF_GrpIter.h>
+#include <DOF_Group.h>
 
 extern "C" {
 #include "symbolic.h"
@@ -121,6 +126,8 @@ int SymSparseLinSOE::setSize(Graph &theGraph)
     int result = 0;
     int oldSize = size;
     size = theGraph.getNumVertex();
+    scatter.clear();
+    this->clearColors();
 
     // first itearte through the vertices of the graph to get nnz
     Vertex *theVertex;
@@ -216,160 +223,106 @@ int SymSparseLinSOE::setSize(Graph &theGraph)
     nblks = symFactorization(rowStartA, colA, size, this->LSPARSE,
 			     &xblk, &invp, &rowblks, &begblk, &first, &penv, &diag);
 
+    // the storage has been rebuilt; find the locations of the
+    // entries assembled by the FE_Elements and DOF_Groups of the model
+    if (theModel != nullptr) {
+      auto locate = [this](int row, int col, int i, int j) {
+        return this->locateA(row, col, i, j);
+      };
+      FE_EleIter &theEles = theModel->getFEs();
+      FE_Element *elePtr;
+      while ((elePtr = theEles()) != nullptr)
+        scatter.add(elePtr->getID(), locate);
+      DOF_GrpIter &theDOFs = theModel->getDOFs();
+      DOF_Group *dofPtr;
+      while ((dofPtr = theDOFs()) != nullptr)
+        scatter.add(dofPtr->getID(), locate);
+    }
+
     return result;
 }
 
 
-/* Perform the element stiffness assembly here.
+/* Find where the entry (row, col) of A is stored. Only the lower
+ * triangle is stored, so of the two local entries (i,j) and (j,i)
+ * that map to the same location, the one with i < j is assembled.
  */
-int SymSparseLinSOE::addA(const Matrix &in_m, const ID &in_id, double fact)
+double *
+SymSparseLinSOE::locateA(int row, int col, int i, int j) const
 {
-   // check for a quick return
-   if (fact == 0.0)  
-       return 0;
+   if (row < 0 || row >= size || col < 0 || col >= size || i > j)
+       return nullptr;
 
-   int idSize = in_id.Size();
-   if (idSize == 0)  return 0;
+   if (i == j)
+       return &diag[invp[row]];
 
-   // check that m and id are of similar size
-   if (idSize != in_m.noRows() && idSize != in_m.noCols()) {
-       // opserr << "SymSparseLinSOE::addA() ";
-       // opserr << " - Matrix and ID not of similar sizes\n";
-       return -1;
+   int i_eq = invp[row];
+   int j_eq = invp[col];
+   if (i_eq == j_eq)
+       return nullptr;
+
+   if (j_eq > i_eq) {
+       int tmp = i_eq;
+       i_eq = j_eq;
+       j_eq = tmp;
    }
 
-   // construct m and id based on non-negative id values.
-   int newPt = 0;
-   int *id = new int[idSize];
-   
-   for (int jj = 0; jj < idSize; jj++) {
-       if (in_id(jj) >= 0 && in_id(jj) < size) {
-	   id[newPt] = in_id(jj);
-	   newPt++;
-       }
+   int iblk = rowblks[i_eq];
+   if (j_eq >= xblk[iblk]) { /* diagonal block (profile) */
+       if (i_eq - j_eq > penv[i_eq +1] - penv[i_eq])
+           return nullptr;
+       return penv[i_eq +1] - i_eq + j_eq;
    }
 
-   idSize = newPt;
-   if (idSize == 0)  return 0;
-   double *m = new double[idSize*idSize];
+   /* row segment; find the segment of row i_eq in the column block
+    * holding j_eq. The list of segments ends in one starting at size,
+    * so stop there if the row has no segment in this block. */
+   const int jblk = rowblks[j_eq];
+   OFFDBLK *ptr = begblk[jblk];
+   while (ptr != nullptr && ptr->beg != size && ptr->row != i_eq) {
+       if (ptr->bnext == ptr)
+           return nullptr;
+       ptr = ptr->bnext;
+   }
+   if (ptr == nullptr || ptr->beg == size)
+       return nullptr;
 
-   int newII = 0;
-   for (int ii = 0; ii < in_id.Size(); ii++) {
-       if (in_id(ii) >= 0 && in_id(ii) < size) {
+   /* the segment holds columns beg up to the end of the block */
+   if (j_eq < ptr->beg || j_eq >= xblk[jblk+1])
+       return nullptr;
 
-	   int newJJ = 0;
-	   for (int jj = 0; jj < in_id.Size(); jj++) {
-	       if (in_id(jj) >= 0 && in_id(jj) < size) {
-		   m[newII*idSize + newJJ] = in_m(ii, jj);
-		   newJJ++;
-	       }
-	   }
-	   newII++;
-       }
-   }
+   return ptr->nz + (j_eq - ptr->beg);
+}
 
-   // forming the new id based on invp.
 
-   int *newID = new  int[idSize];
-   int *isort = new  int[idSize];
+/* Perform the element stiffness assembly here. The location of
+ * each entry is searched for only for IDs that were not seen by
+ * setSize.
+ */
+int SymSparseLinSOE::addA(const Matrix &m, const ID &id, double fact)
+{
+   // check for a quick return
+   if (fact == 0.0)  
+       return 0;
 
-   for (int kk=0; kk<idSize; kk++) {
-       newID[kk] = id[kk];
-       if (newID[kk] >= 0)
-	   newID[kk] = invp[newID[kk]];
-   }
-   
-   long int  i_eq, j_eq;
-   int  j;
-   int  k, ipos, jpos;
-   int  it, jt;
-   int  iblk;
-   OFFDBLK  *ptr;
-   OFFDBLK  *saveblk;
-   double  *fpt, *iloc, *loc;
-
-   int nee = idSize;
-   int lnee = nee;
-   
-   /* initialize isort */
-   for(int i = 0, k = 0; i < lnee ; i++ )
-   {
-       if( newID[i] >= 0 ) {
-	   isort[k] = i;
-	   k++;
-       }
+   const int idSize = id.Size();
+   if (idSize == 0)  return 0;
+
+   // check that m and id are of similar size
+   if (idSize != m.noRows() && idSize != m.noCols()) {
+       // opserr << "SymSparseLinSOE::addA() ";
+       // opserr << " - Matrix and ID not of similar sizes\n";
+       return -1;
    }
 
-   lnee = k;
-
-   /* perform the sorting of isort here */
-   int i = k - 1;
-   do
-   {
-       k = 0 ;
-       for (j = 0 ; j < i ; j++)
-       {  
-	   if ( newID[isort[j]] > newID[isort[j+1]]) {  
-	       isort[j] ^= isort[j+1] ;
-	       isort[j+1] ^= isort[j] ;
-	       isort[j] ^= isort[j+1] ;
-	       k = j ;
-	   }
-      }
-      i = k ;
-   }  while ( k > 0) ;
-
-      i = 0 ;
-      ipos = isort[i] ;
-      k = rowblks[newID[ipos]] ;
-      saveblk  = begblk[k] ;
-
-      /* iterate through the element stiffness matrix, assemble each entry */
-      for (i=0; i<lnee; i++)
-      { 
-	 ipos = isort[i] ;
-         i_eq = newID[ipos] ;
-	 iblk = rowblks[i_eq] ;
-	 iloc = penv[i_eq +1] - i_eq ;
-	 if (k < iblk)
-	    while (saveblk->row != i_eq) saveblk = saveblk->bnext ;
-	 
-	 ptr = saveblk ;
-	 for (j=0; j< i ; j++)
-	 {   
-	    jpos = isort[j] ;
-	    j_eq = newID[jpos] ;
-
-	    if (ipos > jpos) {
-	        jt = ipos;
-		it = jpos;
-	    } else {
-	        it = ipos;
-		jt = jpos;
-	    }
-
-	    if (j_eq >= xblk[iblk]) /* diagonal block (profile) */
-	    {  
-	        loc = iloc + j_eq ;
-		*loc += m[it*idSize + jt] * fact;
-            } 
-	    else /* row segment */
-	    { 
-	        while((j_eq >= (ptr->next)->beg) && ((ptr->next)->row == i_eq))
-		    ptr = ptr->next ;
-		fpt = ptr->nz ;
-		fpt[j_eq - ptr->beg] += m[it*idSize + jt] * fact;
-            }
-         }
-	 diag[i_eq] += m[ipos*idSize + ipos] * fact; /* diagonal element */
-      }
-  	  
-    delete [] newID;
-    delete [] isort;
-    delete [] m;
-    delete [] id;
+   auto locate = [this](int row, int col, int i, int j) {
+       return this->locateA(row, col, i, j);
+   };
+   scatter.scatter(id, locate, [&](double *loc, int i, int j) {
+       *loc += m(i,j) * fact;
+   });
 
-    return 0;
+   return 0;
 }
 
     
@@ -21,6 +21,7 @@
 
 #include <LinearSOE.h>
 #include <Vector.h>
+#include <ScatterMap.h>
 
 extern "C" {
    #include <FeStructs.h>
@@ -54,6 +55,9 @@ class SymSparseLinSOE : public LinearSOE
     void setX(const Vector &x);        
     int setSymSparseLinSolver(SymSparseLinSolver &newSolver);    
 
+    // location of (row,col) in diag, penv or a row segment, or nullptr
+    double *locateA(int row, int col, int i, int j) const;
+
     int sendSelf(int commitTag, Channel &theChannel);
     int recvSelf(int commitTag, Channel &theChannel, 
 		 FEM_ObjectBroker &theBroker);
@@ -81,6 +85,10 @@ class SymSparseLinSOE : public LinearSOE
     OFFDBLK  **begblk;
     OFFDBLK  *first;
 
+    ScatterMap<double*,nullptr> scatter; // cached locations used by addA
+    // addA only reads the locations built in setSize
+    bool hasConcurrentAddA(void) const {return true;}
+
 };
 
 #endif
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Process-wide thread pool shared by all objects that
+// parallelize their inner loops (e.g., fiber sections). Objects must not
+// own a pool; creating one per instance oversubscribes the machine
+// when a model contains thousands of them.
+//
+// Written: cmp
+//
+#pragma once
+#include <threads/thread_pool.hpp>
+
+namespace OpenSees {
+
+/**
+ * @brief Return the pool shared by the whole process. It is created with
+ * one thread per hardware thread the first time it is requested.
+ */
+inline thread_pool&
+shared_pool()
+{
+  static thread_pool pool{};
+  return pool;
+}
+
+/**
+ * @brief Return true if the calling thread is itself a worker of a pool.
+ * Work submitted from inside a task must run serially, otherwise
+ * a task waiting on its own children can starve the pool.
+ */
+inline bool
+in_pool_worker()
+{
+  return this_thread::get_pool().has_value();
+}
+
+/**
+ * @brief Evaluate `block(first, last)` over [0, n) and combine the
+ * partial results with `reduce(total, partial)`. The loop runs serially
+ * on the calling thread when n is below `threshold` or when called from
+ * a pool worker, so there is no locking on either path.
+ *
+ * @param n          Number of loop iterations
+ * @param threshold  Minimum value of n for which the loop is split
+ * @param max_blocks Maximum number of blocks; 0 means one per thread
+ */
+template <typename R, typename B, typename C>
+inline R
+reduce_blocks(unsigned int n, unsigned int threshold, unsigned int max_blocks,
+              B&& block, C&& reduce)
+{
+  if (n < threshold || in_pool_worker())
+    return block(0u, n);
+
+  thread_pool& pool = shared_pool();
+  unsigned int nb = max_blocks == 0 ? pool.get_thread_count() : max_blocks;
+  // Never split into blocks smaller than half the threshold
+  if (threshold > 1 && nb > 2*n/threshold)
+    nb = 2*n/threshold;
+  if (nb < 2)
+    return block(0u, n);
+
+  std::vector<R> partials = pool.submit_blocks<unsigned int>(0u, n, block, nb).get();
+  R total = partials[0];
+  for (std::size_t i = 1; i < partials.size(); i++)
+    reduce(total, partials[i]);
+  return total;
+}
+
+} // namespace OpenSees
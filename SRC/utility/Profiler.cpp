@@ -0,0 +1,179 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Implementation of Profiler.
+//
+// Written: cmp
+//
+#include <Profiler.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+std::atomic<bool> Profiler::enabled{false};
+std::atomic<std::thread::id> Profiler::owner;
+
+
+void
+Profiler::Stats::add(double seconds)
+{
+  if (count == 0 || seconds < min)
+    min = seconds;
+  if (count == 0 || seconds > max)
+    max = seconds;
+  total += seconds;
+  count++;
+}
+
+
+Profiler &
+Profiler::get(void)
+{
+  // never destroyed, so scopes in static destructors remain safe
+  static Profiler *theProfiler = new Profiler();
+  return *theProfiler;
+}
+
+Profiler::Profiler()
+: current(0), generation(0)
+{
+  phases.push_back(Phase{"analysis", -1, {}, {}});
+}
+
+
+void
+Profiler::start(void)
+{
+  owner.store(std::this_thread::get_id());
+  enabled = true;
+}
+
+void
+Profiler::stop(void)
+{
+  enabled = false;
+}
+
+void
+Profiler::reset(void)
+{
+  phases.clear();
+  phases.push_back(Phase{"analysis", -1, {}, {}});
+  classes.clear();
+  current = 0;
+  generation++;
+}
+
+
+int
+Profiler::enter(const char *name)
+{
+  for (int child : phases[current].children)
+    if (phases[child].name == name || strcmp(phases[child].name, name) == 0) {
+      current = child;
+      return child;
+    }
+
+  const int phase = phases.size();
+  phases.push_back(Phase{name, current, {}, {}});
+  phases[current].children.push_back(phase);
+  current = phase;
+  return phase;
+}
+
+void
+Profiler::leave(int phase, int gen, double seconds)
+{
+  if (gen != generation)
+    return;
+
+  phases[phase].stats.add(seconds);
+  current = phases[phase].parent >= 0 ? phases[phase].parent : 0;
+}
+
+void
+Profiler::addClass(const char *name, int gen, double seconds)
+{
+  if (gen != generation)
+    return;
+
+  classes[name].add(seconds);
+}
+
+
+std::vector<std::pair<std::string, Profiler::Stats>>
+Profiler::getClassStats(void) const
+{
+  // the same name may arrive through several pointers
+  std::unordered_map<std::string, Stats> merged;
+  for (const auto &entry : classes) {
+    Stats &stats = merged[entry.first];
+    const Stats &other = entry.second;
+    if (stats.count == 0 || other.min < stats.min)
+      stats.min = other.min;
+    if (stats.count == 0 || other.max > stats.max)
+      stats.max = other.max;
+    stats.total += other.total;
+    stats.count += other.count;
+  }
+
+  std::vector<std::pair<std::string, Stats>> sorted(merged.begin(), merged.end());
+  std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+    return a.second.total > b.second.total;
+  });
+  return sorted;
+}
+
+
+static void
+reportPhase(const std::vector<Profiler::Phase> &phases, int phase, int depth,
+            double parentTotal, std::string &out)
+{
+  const Profiler::Phase &p = phases[phase];
+  char line[256];
+  std::string name = std::string(2*depth, ' ') + p.name;
+  const double share = parentTotal > 0.0 ? 100.0*p.stats.total/parentTotal : 0.0;
+  std::snprintf(line, sizeof(line), "%-32s %10ld %12.6f %12.6f %12.6f %12.6f %6.1f\n",
+                name.c_str(), p.stats.count, p.stats.total,
+                p.stats.count > 0 ? p.stats.total/p.stats.count : 0.0,
+                p.stats.min, p.stats.max, share);
+  out += line;
+
+  for (int child : p.children)
+    reportPhase(phases, child, depth+1, p.stats.total, out);
+}
+
+std::string
+Profiler::report(void) const
+{
+  char line[256];
+  std::string out;
+  std::snprintf(line, sizeof(line), "%-32s %10s %12s %12s %12s %12s %6s\n",
+                "phase", "count", "total [s]", "mean [s]", "min [s]", "max [s]", "%");
+  out += line;
+
+  // the root is not timed itself; its children are the top-level phases
+  double total = 0.0;
+  for (int child : phases[0].children)
+    total += phases[child].stats.total;
+  for (int child : phases[0].children)
+    reportPhase(phases, child, 0, total, out);
+
+  std::vector<std::pair<std::string, Stats>> byClass = this->getClassStats();
+  if (!byClass.empty()) {
+    out += "\n";
+    std::snprintf(line, sizeof(line), "%-32s %10s %12s %12s %12s %12s\n",
+                  "class", "count", "total [s]", "mean [s]", "min [s]", "max [s]");
+    out += line;
+    for (const auto &entry : byClass) {
+      const Stats &s = entry.second;
+      std::snprintf(line, sizeof(line), "%-32s %10ld %12.6f %12.6f %12.6f %12.6f\n",
+                    entry.first.c_str(), s.count, s.total, s.total/s.count, s.min, s.max);
+      out += line;
+    }
+  }
+  return out;
+}
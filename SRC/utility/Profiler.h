@@ -0,0 +1,155 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: Profiler accumulates the wall-clock time spent in the
+// phases of an analysis. A phase is timed by a Profiler::Scope placed
+// around the code of interest; scopes opened inside another scope become
+// its children, so the report shows, e.g., the time in solve() within
+// solveCurrentStep() within a step. Each phase keeps the number of calls
+// and the total, minimum and maximum time of a call.
+//
+// A Profiler::ClassScope times work done on behalf of a class (an element
+// forming its tangent, a recorder writing its output); these are summed
+// by class name across the whole analysis rather than placed in the tree.
+//
+// Only the thread that started the profiler records. While the profiler
+// is stopped, and on any other thread, a scope costs a single test.
+//
+// Scopes read std::chrono::steady_clock rather than using a Timer: Timer
+// counts times() clock ticks (commonly 10 ms), calls getrusage on every
+// start and pause, and reads zero on Windows, while most phases here
+// last microseconds.
+//
+// Within solveCurrentStep(), AdaptiveNewton times formTangent, update
+// (element state determination), formUnbalance and test (the convergence
+// test); within solve(), the direct solvers time factor and substitute
+// (the triangular solves; a LAPACK driver that factors and solves in one
+// call is timed as factor). Element classes are timed in the serial
+// element loops of LinearSOE::assembleA and MatrixFreeLinSOE::formAp.
+//
+// Written: cmp
+//
+#ifndef Profiler_h
+#define Profiler_h
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class Profiler
+{
+  public:
+    struct Stats {
+      long   count = 0;
+      double total = 0.0;
+      double min   = 0.0;
+      double max   = 0.0;
+      void add(double seconds);
+    };
+
+    struct Phase {
+      const char      *name;
+      int              parent;
+      std::vector<int> children;
+      Stats            stats;
+    };
+
+    // the profiler of the process
+    static Profiler &get(void);
+
+    // true when the calling thread should record
+    static bool active(void) {
+      return enabled.load(std::memory_order_relaxed)
+          && std::this_thread::get_id() == owner.load(std::memory_order_relaxed);
+    }
+
+    void start(void);
+    void stop(void);
+    void reset(void);
+    bool isRunning(void) const {return enabled.load();}
+
+    // phases in the order first entered; phase 0 is the root
+    const std::vector<Phase> &getPhases(void) const {return phases;}
+    // per-class totals, sorted by decreasing total time
+    std::vector<std::pair<std::string, Stats>> getClassStats(void) const;
+
+    // a table of the phase tree followed by the per-class totals
+    std::string report(void) const;
+
+    class Scope {
+      public:
+        explicit Scope(const char *name)
+        : phase(-1) {
+          if (Profiler::active()) {
+            Profiler &p = Profiler::get();
+            phase = p.enter(name);
+            generation = p.generation;
+            begin = std::chrono::steady_clock::now();
+          }
+        }
+        ~Scope() {
+          if (phase >= 0)
+            Profiler::get().leave(phase, generation, seconds(begin));
+        }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+      private:
+        int phase;
+        int generation;
+        std::chrono::steady_clock::time_point begin;
+    };
+
+    class ClassScope {
+      public:
+        // className must outlive the profiler (a literal); nothing is
+        // recorded when it is null
+        explicit ClassScope(const char *className)
+        : name(nullptr) {
+          if (className != nullptr && Profiler::active()) {
+            name = className;
+            generation = Profiler::get().generation;
+            begin = std::chrono::steady_clock::now();
+          }
+        }
+        ~ClassScope() {
+          if (name != nullptr)
+            Profiler::get().addClass(name, generation, seconds(begin));
+        }
+        ClassScope(const ClassScope &) = delete;
+        ClassScope &operator=(const ClassScope &) = delete;
+      private:
+        const char *name;
+        int generation;
+        std::chrono::steady_clock::time_point begin;
+    };
+
+  private:
+    Profiler();
+
+    static double seconds(std::chrono::steady_clock::time_point begin) {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    int  enter(const char *name);
+    void leave(int phase, int generation, double seconds);
+    void addClass(const char *name, int generation, double seconds);
+
+    static std::atomic<bool> enabled;
+    // set by start(); read by every thread that opens a scope
+    static std::atomic<std::thread::id> owner;
+
+    std::vector<Phase> phases;
+    int current;
+    // bumped by reset() so that scopes open across it are dropped
+    int generation;
+    // keyed by the name pointer; names are merged when reported
+    std::unordered_map<const char*, Stats> classes;
+};
+
+#endif
@@ -0,0 +1,47 @@
+"""
+Reader for the files written by recorders with the ``-columnar`` option.
+
+    >>> import xara.columnar
+    >>> columns, data = xara.columnar.read("node.col")
+
+``columns`` is the schema, a list with one dict per column holding the
+response ``name``, the ``path`` of output tags that enclose it and
+their ``attrs`` (e.g., ``nodeTag``); ``data`` is a 2D numpy array with
+one row per recorded step and one column per entry of ``columns``.
+"""
+import json
+import struct
+
+import numpy as np
+
+MAGIC = b"XARACOL\0"
+
+
+def read(filename):
+    with open(filename, "rb") as f:
+        content = f.read()
+
+    if content[:8] != MAGIC:
+        raise ValueError(f"{filename} is not a columnar recorder file")
+
+    version, width, ncol, _, length = struct.unpack_from("=IIIIQ", content, 8)
+    if version != 1 or width not in (4, 8):
+        raise ValueError(f"{filename}: unsupported version {version} or width {width}")
+
+    pos = 32
+    columns = json.loads(content[pos:pos+length].decode())
+    pos += length
+
+    dtype = np.float32 if width == 4 else np.float64
+    chunks = []
+    while pos < len(content):
+        (nrow,) = struct.unpack_from("=I", content, pos)
+        pos += 4
+        values = np.frombuffer(content, dtype=dtype, count=nrow*ncol, offset=pos)
+        chunks.append(values.reshape(ncol, nrow).T)
+        pos += nrow*ncol*width
+
+    if not chunks:
+        return columns, np.zeros((0, ncol))
+
+    return columns, np.vstack(chunks).astype(np.float64)
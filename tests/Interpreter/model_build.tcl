@@ -0,0 +1,61 @@
+#
+# Measure how quickly the modeling commands are processed when building a
+# large generated model. The number of nodes may be given on the command
+# line, e.g.
+#
+#   opensees model_build.tcl 100000
+#
+# Coordinates and properties are computed with expr, so the arguments
+# reach the commands as numbers rather than strings.
+#
+set n [expr {$argc > 0 ? [lindex $argv 0] : 20000}]
+
+proc report {name count usec} {
+  puts [format "%-10s %10d commands %14.0f commands/s" \
+               $name $count [expr {$count/(max($usec,1)*1.0e-6)}]]
+}
+
+wipe
+model basic -ndm 2 -ndf 3
+
+set t [clock microseconds]
+for {set i 1} {$i <= $n} {incr i} {
+  node $i [expr {12.0*$i}] [expr {0.5*($i%2)}]
+}
+report node $n [expr {[clock microseconds] - $t}]
+
+set t [clock microseconds]
+for {set i 1} {$i <= $n} {incr i} {
+  mass $i [expr {0.1*$i}] 0.1 0.0
+}
+report mass $n [expr {[clock microseconds] - $t}]
+
+set t [clock microseconds]
+for {set i 1} {$i <= $n} {incr i} {
+  fix $i 0 1 0
+}
+report fix $n [expr {[clock microseconds] - $t}]
+
+set t [clock microseconds]
+for {set i 2} {$i <= $n} {incr i 2} {
+  equalDOF [expr {$i-1}] $i 1
+}
+report equalDOF [expr {$n/2}] [expr {[clock microseconds] - $t}]
+
+geomTransf Linear 1
+set t [clock microseconds]
+for {set i 1} {$i < $n} {incr i} {
+  element elasticBeamColumn $i $i [expr {$i+1}] 20.0 29000.0 [expr {1400.0+$i}] 1
+}
+report element [expr {$n-1}] [expr {[clock microseconds] - $t}]
+
+uniaxialMaterial Elastic 1 29000.0
+set t [clock microseconds]
+section Fiber 1 {
+  for {set i 1} {$i <= $n} {incr i} {
+    fiber [expr {1.0e-3*$i}] 0.0 [expr {1.0/$n}] 1
+  }
+}
+report fiber $n [expr {[clock microseconds] - $t}]
+
+wipe
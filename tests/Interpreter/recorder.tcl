@@ -205,11 +205,18 @@ recorder Node  -file out/node32.out -time -node 3 4 -dof 1 2 3 disp
 recorder Node  -txt  out/node32.txt -time -node 3 4 -dof 1 2 3 disp
 recorder Node  -xml  out/node32.xml -time -node 3 4 -dof 1 2 3 disp
 recorder Node  -csv  out/node32.csv -time -node 3 4 -dof 1 2 3 disp
+recorder Node  -columnar out/node32.col -time -node 3 4 -dof 1 2 3 disp
+recorder Node  -columnar out/node32f.col -float32 -writerThread -buffer 16 -time -node 3 4 -dof 1 2 3 disp
 
 recorder EnvelopeElement -file out/ele32.out -time -ele 1 2 localForce
 recorder EnvelopeElement -txt  out/ele32.txt -time -ele 1 2 localForce
 recorder EnvelopeElement -csv  out/ele32.csv -time -ele 1 2 localForce
 recorder EnvelopeElement -xml  out/ele32.xml -time -ele 1 2 localForce
+recorder Element -columnar out/ele32.col -time -ele 1 2 localForce
+recorder Node            -async -file out/node32-async.out -time -node 3 4 -dof 1 2 3 disp
+recorder EnvelopeNode    -asyncRows 8 -file out/env32-async.out -time -node 3 4 -dof 1 2 3 disp
+recorder Element         -async -file out/ele32-async.out -time -ele 1 2 localForce
+recorder Drift           -async -file out/drift32-async.out -time -iNode 1 -jNode 3 -dof 1 -perpDirn 2
 
 #
 # Finally perform the analysis
@@ -0,0 +1,219 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file contains a test of the backward Euler return
+// mapping of ASDPlasticMaterial.
+//
+// A von Mises material with linear kinematic and isotropic hardening, and
+// one with Armstrong-Frederick kinematic hardening, are driven through a
+// non-proportional cycle of axial and shear strain. The stress of the
+// Backward_Euler and Full_Backward_Euler methods must match, to within
+// the first-order error of the implicit step, the stress of the explicit
+// Forward_Euler integrator driven through many sub-steps of each step.
+// The algorithmic tangent of Full_Backward_Euler must match the forward
+// difference of the stress it returns. Two instances driven to different
+// states must each return their own tangent.
+//
+// Written: cmp
+//
+#include <stdio.h>
+#include <math.h>
+
+#include <Vector.h>
+#include <Matrix.h>
+#include <AllASDPlasticMaterials.h>
+#include <classTags.h>
+
+using namespace ASDPlasticMaterialGlobals;
+
+using Method = ASDPlasticMaterial_Constitutive_Integration_Method;
+using Tangent = ASDPlasticMaterial_Tangent_Operator_Type;
+
+using VonMisesLinear = ASDPlasticMaterial<LinearIsotropic3D_EL,
+      VonMises_YF<BackStress<TensorLinearHardeningFunction>, VonMisesRadius<ScalarLinearHardeningFunction>>,
+      VonMises_PF<BackStress<TensorLinearHardeningFunction>>,
+      ND_TAG_ASDPlasticMaterial>;
+
+using VonMisesAF = ASDPlasticMaterial<LinearIsotropic3D_EL,
+      VonMises_YF<BackStress<ArmstrongFrederickHardeningFunction>, VonMisesRadius<ScalarLinearHardeningFunction>>,
+      VonMises_PF<BackStress<ArmstrongFrederickHardeningFunction>>,
+      ND_TAG_ASDPlasticMaterial>;
+
+static const int    numSteps    = 400;
+static const int    numSubSteps = 50;     // of the explicit reference
+static const double epsYield    = 1.0e-3;
+static const double stressTol   = 2.0e-2; // relative to the yield stress
+static const double tangentTol  = 1.0e-4; // relative to Young's modulus
+
+static const double E  = 200.0e3;
+static const double nu = 0.3;
+static const double k0 = 200.0;
+
+static int failures = 0;
+
+template <class MaterialType>
+static void
+setup(MaterialType &material, Method method, Tangent tangent)
+{
+  double radius = k0;
+  double backStress[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  material.setInternalVariableByName("VonMisesRadius", 1, &radius);
+  material.setInternalVariableByName("BackStress", 6, backStress);
+
+  material.setParameterByName("YoungsModulus", E);
+  material.setParameterByName("PoissonsRatio", nu);
+  material.setParameterByName("MassDensity", 0.0);
+  material.setParameterByName("InitialP0", 0.0);
+  material.setParameterByName("ScalarLinearHardeningParameter", 0.01*E);
+  material.setParameterByName("TensorLinearHardeningParameter", 0.02*E);
+  material.setParameterByName("AF_ha", 0.05*E);
+  material.setParameterByName("AF_cr", 100.0);
+
+  material.set_constitutive_integration_method((int)method, (int)tangent,
+                                               1.0e-10, 1.0e-10, 100, 1);
+}
+
+// the strain at time t in [0,1] of a cycle of axial strain with a shear
+// strain out of phase, reaching several times the yield strain
+static void
+strainAt(double t, Vector &strain)
+{
+  t *= 2.0*M_PI;
+  strain.Zero();
+  strain(0) =  4.0*epsYield*sin(t);
+  strain(1) = -nu*strain(0);
+  strain(2) = -nu*strain(0);
+  strain(3) =  3.0*epsYield*(1.0 - cos(t));
+}
+
+template <class MaterialType>
+static void
+compare(const char *name)
+{
+  MaterialType reference(1), backward(2), full(3);
+  setup(reference, Method::Forward_Euler, Tangent::Continuum);
+  setup(backward, Method::Backward_Euler, Tangent::Continuum);
+  setup(full, Method::Full_Backward_Euler, Tangent::Algorithmic);
+
+  Vector strain(6), perturbed(6), stress(6);
+  double maxError[2] = {0.0, 0.0};
+  double maxTangentError = 0.0;
+
+  for (int i = 1; i <= numSteps; i++) {
+    for (int j = 1; j <= numSubSteps; j++) {
+      strainAt((i - 1.0 + (double)j/numSubSteps)/numSteps, strain);
+      reference.setTrialStrain(strain);
+      reference.commitState();
+    }
+    stress = reference.getStress();
+
+    MaterialType *implicit[2] = {&backward, &full};
+    for (int m = 0; m < 2; m++) {
+      if (implicit[m]->setTrialStrain(strain) != 0) {
+        fprintf(stderr, "FAILED %s step %d: method %d did not converge\n", name, i, m);
+        failures++;
+      }
+      const Vector &s = implicit[m]->getStress();
+      for (int j = 0; j < 6; j++)
+        maxError[m] = fmax(maxError[m], fabs(s(j) - stress(j))/k0);
+    }
+
+    // the algorithmic tangent against the forward difference of the
+    // stress; each trial strain is integrated from the committed state
+    if (i % 20 == 0) {
+      Matrix tangent(full.getTangent());
+      Vector sigma(full.getStress());
+      for (int k = 0; k < 6; k++) {
+        const double h = 1.0e-8;
+        perturbed = strain;
+        perturbed(k) += h;
+        full.setTrialStrain(perturbed);
+        const Vector &sp = full.getStress();
+        for (int j = 0; j < 6; j++)
+          maxTangentError = fmax(maxTangentError, fabs((sp(j) - sigma(j))/h - tangent(j,k))/E);
+      }
+      full.setTrialStrain(strain);
+    }
+
+    backward.commitState();
+    full.commitState();
+  }
+
+  printf("    %-28s Backward_Euler %10.3e  Full_Backward_Euler %10.3e  tangent %10.3e\n",
+         name, maxError[0], maxError[1], maxTangentError);
+
+  for (int m = 0; m < 2; m++) {
+    if (maxError[m] > stressTol) {
+      fprintf(stderr, "FAILED %s: stress error %g of method %d\n", name, maxError[m], m);
+      failures++;
+    }
+  }
+  if (maxTangentError > tangentTol) {
+    fprintf(stderr, "FAILED %s: algorithmic tangent error %g\n", name, maxTangentError);
+    failures++;
+  }
+}
+
+// one instance is left elastic and the other is driven into yield; the
+// tangent of each must not change when the other is updated
+template <class MaterialType>
+static void
+separate(const char *name)
+{
+  MaterialType elastic(1), plastic(2);
+  setup(elastic, Method::Full_Backward_Euler, Tangent::Algorithmic);
+  setup(plastic, Method::Full_Backward_Euler, Tangent::Algorithmic);
+
+  Vector strain(6);
+  strainAt(0.01, strain);
+  elastic.setTrialStrain(strain);
+  Matrix Ke(elastic.getTangent());
+
+  strainAt(0.2, strain);
+  plastic.setTrialStrain(strain);
+  Matrix Kp(plastic.getTangent());
+
+  double diffElastic = 0.0, diffPlastic = 0.0, diffBetween = 0.0;
+  const Matrix &Ke_later = elastic.getTangent();
+  for (int i = 0; i < 6; i++)
+    for (int j = 0; j < 6; j++) {
+      diffElastic = fmax(diffElastic, fabs(Ke_later(i,j) - Ke(i,j))/E);
+      diffBetween = fmax(diffBetween, fabs(Kp(i,j) - Ke(i,j))/E);
+    }
+  const Matrix &Kp_later = plastic.getTangent();
+  for (int i = 0; i < 6; i++)
+    for (int j = 0; j < 6; j++)
+      diffPlastic = fmax(diffPlastic, fabs(Kp_later(i,j) - Kp(i,j))/E);
+
+  if (diffElastic > 1.0e-14 || diffPlastic > 1.0e-14) {
+    fprintf(stderr, "FAILED %s: tangent changed by another instance (%g, %g)\n",
+            name, diffElastic, diffPlastic);
+    failures++;
+  }
+  // the elastic and the elastoplastic tangent must differ
+  if (diffBetween < 1.0e-3) {
+    fprintf(stderr, "FAILED %s: the elastoplastic tangent equals the elastic one\n", name);
+    failures++;
+  }
+}
+
+
+int
+main(int argc, char **argv)
+{
+  compare<VonMisesLinear>("VonMises linear hardening");
+  compare<VonMisesAF>("VonMises Armstrong-Frederick");
+  separate<VonMisesLinear>("VonMises linear hardening");
+  separate<VonMisesAF>("VonMises Armstrong-Frederick");
+
+  if (failures != 0) {
+    fprintf(stderr, "%d checks failed\n", failures);
+    return 1;
+  }
+
+  fprintf(stdout, "PASSED\n");
+  return 0;
+}
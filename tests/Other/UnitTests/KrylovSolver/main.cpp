@@ -0,0 +1,220 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file contains a test of KrylovSolver. The tangent of a
+// grid of quadrilaterals is assembled into a SparseGenRowLinSOE and solved
+// with each of CG, MINRES, GMRES and BiCGStab, each with a different
+// preconditioner. The solutions are compared with that of the dense
+// system.
+//
+// The tangent is then formed again, scaled by a small and by a large
+// factor. The preconditioner must be kept when A is unchanged or changed
+// by less than the rebuild tolerance, and rebuilt when the change is
+// larger.
+//
+// Written: cmp
+//
+#include <stdio.h>
+#include <math.h>
+#include <array>
+
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Domain.h>
+#include <Node.h>
+#include <SP_Constraint.h>
+#include <LagrangeQuad.h>
+#include <ElasticIsotropic.h>
+
+#include <AnalysisModel.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <PlainHandler.h>
+#include <PlainNumberer.h>
+#include <LoadControl.h>
+#include <Linear.h>
+#include <StaticAnalysis.h>
+#include <KrylovSolver.h>
+#include <SparseGenRowLinSOE.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+using namespace OpenSees;
+
+static const int nx = 12;
+static const int ny = 12;
+
+static int
+nodeTag(int i, int j)
+{
+  return 1 + j*(nx+1) + i;
+}
+
+static void
+buildModel(Domain &theDomain, Mate<2> &material)
+{
+  for (int j=0; j<=ny; j++)
+    for (int i=0; i<=nx; i++)
+      theDomain.addNode(new Node(nodeTag(i,j), 2, 1.0*i, 0.5*j));
+
+  int tag = 1;
+  for (int j=0; j<ny; j++)
+    for (int i=0; i<nx; i++) {
+      std::array<int,4> nodes {nodeTag(i,j),   nodeTag(i+1,j),
+                               nodeTag(i+1,j+1), nodeTag(i,j+1)};
+      theDomain.addElement(new LagrangeQuad<4>(tag++, nodes, material, 1.0));
+    }
+
+  for (int i=0; i<=nx; i++)
+    for (int dof=0; dof<2; dof++)
+      theDomain.addSP_Constraint(new SP_Constraint(nodeTag(i,0), dof, 0.0, true));
+}
+
+// assemble the element tangents into the system, and into A when given
+static void
+formTangent(AnalysisModel &theModel, IncrementalIntegrator &theIntegrator,
+            SparseGenRowLinSOE &theSOE, double fact, Matrix *A = nullptr)
+{
+  theSOE.zeroA();
+  FE_EleIter &theEles = theModel.getFEs();
+  FE_Element *theFE;
+  while ((theFE = theEles()) != nullptr) {
+    const Matrix &k = theFE->getTangent(&theIntegrator);
+    const ID &id = theFE->getID();
+    theSOE.addA(k, id, fact);
+    if (A != nullptr)
+      for (int i=0; i<id.Size(); i++)
+        for (int j=0; j<id.Size(); j++)
+          if (id(i) >= 0 && id(j) >= 0)
+            (*A)(id(i), id(j)) += fact*k(i,j);
+  }
+}
+
+static double
+difference(const Vector &a, const Vector &b)
+{
+  double diff = 0.0, size = 0.0;
+  for (int i=0; i<a.Size(); i++) {
+    diff = fmax(diff, fabs(a(i) - b(i)));
+    size = fmax(size, fabs(b(i)));
+  }
+  return size > 0.0 ? diff/size : diff;
+}
+
+int
+main(int argc, char **argv)
+{
+  Domain theDomain;
+  ElasticIsotropic<2,PlaneType::Strain> material(1, 30000.0, 0.25, 0.0);
+  buildModel(theDomain, material);
+
+  AnalysisModel     *theModel      = new AnalysisModel();
+  EquiSolnAlgo      *theAlgorithm  = new Linear();
+  StaticIntegrator  *theIntegrator = new LoadControl(1.0, 1, 1.0, 1.0);
+  ConstraintHandler *theHandler    = new PlainHandler();
+  DOF_Numberer      *theNumberer   = new PlainNumberer();
+  KrylovSolver      *theSolver     = new KrylovSolver(KrylovSolver::CG, KrylovSolver::Jacobi, 1.0e-12);
+  SparseGenRowLinSOE *theSOE       = new SparseGenRowLinSOE(*theSolver);
+
+  StaticAnalysis theAnalysis(theDomain, *theHandler, *theNumberer, *theModel,
+                             *theAlgorithm, *theSOE, *theIntegrator);
+  if (theAnalysis.domainChanged() < 0) {
+    fprintf(stderr, "FAILED: domainChanged\n");
+    return 1;
+  }
+
+  const int n = theSOE->getNumEqn();
+  Matrix A(n, n);
+  formTangent(*theModel, *theIntegrator, *theSOE, 1.0, &A);
+
+  Vector b(n), x_ref(n);
+  for (int i=0; i<n; i++)
+    b(i) = sin(1.0 + i) + 1.0;
+  if (A.Solve(b, x_ref) < 0) {
+    fprintf(stderr, "FAILED: dense solve\n");
+    return 1;
+  }
+  theSOE->setB(b);
+
+  int failures = 0;
+
+  struct {
+    KrylovSolver::Method method;
+    KrylovSolver::Preconditioning pre;
+  } cases[] = {
+    {KrylovSolver::CG,       KrylovSolver::IC0},
+    {KrylovSolver::MINRES,   KrylovSolver::Jacobi},
+    {KrylovSolver::GMRES,    KrylovSolver::ILU0},
+    {KrylovSolver::BiCGStab, KrylovSolver::BlockJacobi},
+  };
+
+  for (auto &c : cases) {
+    KrylovSolver *theCase = new KrylovSolver(c.method, c.pre, 1.0e-12, 5000);
+    theCase->setBlockSize(2);
+    if (theSOE->setSparseGenRowSolver(*theCase) < 0) {
+      fprintf(stderr, "FAILED: %s setSize\n", KrylovSolver::name(c.method));
+      failures++;
+      continue;
+    }
+    formTangent(*theModel, *theIntegrator, *theSOE, 1.0);
+    if (theSOE->solve() < 0) {
+      fprintf(stderr, "FAILED: %s with %s did not converge\n",
+              KrylovSolver::name(c.method), KrylovSolver::name(c.pre));
+      failures++;
+      continue;
+    }
+    double diff = difference(theSOE->getX(), x_ref);
+    if (diff > 1.0e-6) {
+      fprintf(stderr, "FAILED: %s with %s, relative difference %g\n",
+              KrylovSolver::name(c.method), KrylovSolver::name(c.pre), diff);
+      failures++;
+    }
+  }
+
+  // the rebuild heuristic, with the default tolerance of 0.1 on the
+  // relative change of A
+  theSOE->setSparseGenRowSolver(*theSolver);
+  struct {
+    double fact;          // scale of the tangent
+    int build, reuse;     // statistics expected after the solve
+  } steps[] = {
+    {1.00, 1, 0},         // first solve builds
+    {1.00, 1, 1},         // same A
+    {1.01, 1, 2},         // A changed by 1%
+    {1.50, 2, 2},         // A changed by about 50%
+  };
+
+  for (auto &s : steps) {
+    formTangent(*theModel, *theIntegrator, *theSOE, s.fact);
+    if (theSOE->solve() < 0) {
+      fprintf(stderr, "FAILED: solve with the tangent scaled by %g\n", s.fact);
+      failures++;
+      continue;
+    }
+    const KrylovSolver::Statistics &stats = theSolver->getStatistics();
+    if (stats.build != s.build || stats.reuse != s.reuse) {
+      fprintf(stderr, "FAILED: tangent scaled by %g, %d builds and %d reuses, expected %d and %d\n",
+              s.fact, stats.build, stats.reuse, s.build, s.reuse);
+      failures++;
+    }
+    double diff = difference(theSOE->getX(), x_ref/s.fact);
+    if (diff > 1.0e-6) {
+      fprintf(stderr, "FAILED: tangent scaled by %g, relative difference %g\n", s.fact, diff);
+      failures++;
+    }
+  }
+
+  if (failures != 0)
+    return 1;
+
+  fprintf(stdout, "PASSED\n");
+  return 0;
+}
@@ -0,0 +1,144 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file contains a test of the geometry cache of
+// LagrangeQuad. Two elements on the same distorted quadrilateral, one
+// with the cache and one without, are given the same nodal displacements
+// and must return the same tangent, resisting force, mass and tangent
+// product. The comparison is repeated after a node has been moved and
+// after the cache has been turned on once the element is in the domain.
+//
+// Written: cmp
+//
+#include <stdio.h>
+#include <math.h>
+#include <array>
+
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <Matrix.h>
+#include <Vector.h>
+#include <Domain.h>
+#include <Node.h>
+#include <LagrangeQuad.h>
+#include <ElasticIsotropic.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+using namespace OpenSees;
+
+static double
+difference(const Matrix &a, const Matrix &b)
+{
+  double diff = 0.0, size = 0.0;
+  for (int i=0; i<a.noRows(); i++)
+    for (int j=0; j<a.noCols(); j++) {
+      diff = fmax(diff, fabs(a(i,j) - b(i,j)));
+      size = fmax(size, fabs(a(i,j)));
+    }
+  return size > 0.0 ? diff/size : diff;
+}
+
+static double
+difference(const Vector &a, const Vector &b)
+{
+  double diff = 0.0, size = 0.0;
+  for (int i=0; i<a.Size(); i++) {
+    diff = fmax(diff, fabs(a(i) - b(i)));
+    size = fmax(size, fabs(a(i)));
+  }
+  return size > 0.0 ? diff/size : diff;
+}
+
+// the largest difference between the responses of the two elements
+static double
+compare(LagrangeQuad<4> &cached, LagrangeQuad<4> &uncached)
+{
+  if (cached.update() != 0 || uncached.update() != 0)
+    return 1.0;
+
+  // the responses may be returned in storage shared by the class, so
+  // the first is copied before the second is formed
+  double diff = 0.0;
+  Matrix K(cached.getTangentStiff());
+  diff = fmax(diff, difference(K, uncached.getTangentStiff()));
+  Vector P(cached.getResistingForce());
+  diff = fmax(diff, difference(P, uncached.getResistingForce()));
+  Matrix M(cached.getMass());
+  diff = fmax(diff, difference(M, uncached.getMass()));
+
+  double x[8], y[8] = {0.0}, y_ref[8] = {0.0};
+  for (int i=0; i<8; i++)
+    x[i] = sin(1.0 + i);
+  cached.addTangentProduct(x, y, 1.0, 0.5);
+  uncached.addTangentProduct(x, y_ref, 1.0, 0.5);
+  diff = fmax(diff, difference(Vector(y, 8), Vector(y_ref, 8)));
+
+  return diff;
+}
+
+int
+main(int argc, char **argv)
+{
+  ElasticIsotropic<2,PlaneType::Strain> material(1, 30000.0, 0.25, 0.0);
+
+  Domain theDomain;
+  theDomain.addNode(new Node(1, 2, 0.0, 0.0));
+  theDomain.addNode(new Node(2, 2, 2.0, 0.2));
+  theDomain.addNode(new Node(3, 2, 2.3, 1.5));
+  theDomain.addNode(new Node(4, 2, 0.1, 1.1));
+
+  std::array<int,4> nodes {1, 2, 3, 4};
+  LagrangeQuad<4> *cached   = new LagrangeQuad<4>(1, nodes, material, 1.0, 0.0, 2.0);
+  LagrangeQuad<4> *uncached = new LagrangeQuad<4>(2, nodes, material, 1.0, 0.0, 2.0);
+  LagrangeQuad<4> *late     = new LagrangeQuad<4>(3, nodes, material, 1.0, 0.0, 2.0);
+  cached->setGeometryCache(true);
+  theDomain.addElement(cached);
+  theDomain.addElement(uncached);
+  theDomain.addElement(late);
+
+  for (int tag=1; tag<=4; tag++) {
+    Vector u(2);
+    u(0) =  1.0e-3*tag;
+    u(1) = -2.0e-3*tag*tag;
+    theDomain.getNode(tag)->setTrialDisp(u);
+  }
+
+  int failures = 0;
+  const double tol = 1.0e-14;
+
+  double diff = compare(*cached, *uncached);
+  if (diff > tol) {
+    fprintf(stderr, "FAILED: cached and uncached differ by %g\n", diff);
+    failures++;
+  }
+
+  // the cache must follow the node, as for setNodeCoord
+  Vector crds(2);
+  crds(0) = 2.6;
+  crds(1) = 1.9;
+  theDomain.getNode(3)->setCrds(crds);
+  diff = compare(*cached, *uncached);
+  if (diff > tol) {
+    fprintf(stderr, "FAILED: after moving a node, cached and uncached differ by %g\n", diff);
+    failures++;
+  }
+
+  late->setGeometryCache(true);
+  diff = compare(*late, *uncached);
+  if (diff > tol) {
+    fprintf(stderr, "FAILED: cache formed in the domain differs by %g\n", diff);
+    failures++;
+  }
+
+  if (failures != 0)
+    return 1;
+
+  fprintf(stdout, "PASSED\n");
+  return 0;
+}
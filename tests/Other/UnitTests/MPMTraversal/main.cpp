@@ -0,0 +1,152 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file contains a test of the ordering and colouring
+// used by the MPM particle traversal (Mesh::sort_particles) and the
+// lock-free particle-to-grid transfer (ParticleSoA::assign_cells).
+//
+// The Morton code must interleave the bits of the grid coordinates, so
+// that the cells of each 2x2 (2x2x2) block of a structured grid are
+// consecutive in the ordering. The greedy colouring of a structured
+// grid must use 4 (8) colours, and no two cells of a colour may share
+// a node, also for a grid with irregular connectivity.
+//
+// Written: cmp
+//
+#include <stdio.h>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+
+#include "math_utility.h"
+#include "colouring.h"
+
+static int numFailed = 0;
+
+static void
+check(bool ok, const char *what)
+{
+  if (!ok) {
+    fprintf(stderr, "FAILED: %s\n", what);
+    numFailed++;
+  }
+}
+
+// Node ids of the cells of an n^Tdim structured grid, cell (i,j,k) having
+// the nodes of its corners
+template <unsigned Tdim>
+static std::vector<std::vector<mpm::Index>>
+gridCells(unsigned n)
+{
+  std::vector<std::vector<mpm::Index>> cells;
+  const unsigned ncells = Tdim == 2 ? n*n : n*n*n;
+  for (unsigned c = 0; c < ncells; c++) {
+    std::array<unsigned, 3> index {c % n, (c / n) % n, c / (n*n)};
+    std::vector<mpm::Index> nodes;
+    for (unsigned corner = 0; corner < (1u << Tdim); corner++) {
+      mpm::Index id = 0;
+      for (int i = Tdim-1; i >= 0; i--)
+        id = id*(n+1) + index[i] + ((corner >> i) & 1u);
+      nodes.push_back(id);
+    }
+    cells.push_back(nodes);
+  }
+  return cells;
+}
+
+// No two cells of a colour share a node
+static bool
+validColouring(const std::vector<std::vector<mpm::Index>> &cells,
+               const std::vector<unsigned> &colours)
+{
+  for (unsigned a = 0; a < cells.size(); a++)
+    for (unsigned b = a+1; b < cells.size(); b++)
+      if (colours[a] == colours[b])
+        for (mpm::Index node : cells[a])
+          if (std::find(cells[b].begin(), cells[b].end(), node) != cells[b].end())
+            return false;
+  return true;
+}
+
+template <unsigned Tdim>
+static void
+testMortonOrder(unsigned n)
+{
+  // order the cells of the grid by their code
+  const unsigned ncells = Tdim == 2 ? n*n : n*n*n;
+  std::vector<std::uint64_t> codes(ncells);
+  for (unsigned c = 0; c < ncells; c++) {
+    std::array<std::uint32_t, Tdim> index;
+    for (unsigned i = 0; i < Tdim; i++)
+      index[i] = (i == 0 ? c : i == 1 ? c / n : c / (n*n)) % n;
+    codes[c] = mpm::math::morton_code<Tdim>(index);
+  }
+  std::vector<unsigned> order(ncells);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&](unsigned a, unsigned b) { return codes[a] < codes[b]; });
+
+  // codes are unique, and each block of 2^Tdim cells is consecutive
+  bool ok = true;
+  for (unsigned k = 1; k < ncells; k++)
+    ok = ok && codes[order[k-1]] < codes[order[k]];
+  check(ok, "Morton codes are not unique");
+
+  ok = true;
+  for (unsigned k = 0; k < ncells; k += (1u << Tdim)) {
+    for (unsigned m = 1; m < (1u << Tdim); m++)
+      for (unsigned i = 0; i < Tdim; i++) {
+        const unsigned stride = i == 0 ? 1 : i == 1 ? n : n*n;
+        ok = ok && (order[k+m] / stride % n) / 2 == (order[k] / stride % n) / 2;
+      }
+  }
+  check(ok, "Morton order does not keep blocks of cells together");
+}
+
+int main(int argc, char **argv)
+{
+  // bits of the coordinates are interleaved, x in the lowest bit
+  check(mpm::math::morton_code<2>({1, 0}) == 1, "morton_code<2>({1,0})");
+  check(mpm::math::morton_code<2>({0, 1}) == 2, "morton_code<2>({0,1})");
+  check(mpm::math::morton_code<2>({3, 5}) == 0x27, "morton_code<2>({3,5})");
+  check(mpm::math::morton_code<3>({1, 1, 1}) == 7, "morton_code<3>({1,1,1})");
+  check(mpm::math::morton_code<3>({2, 0, 1}) == 0x0c, "morton_code<3>({2,0,1})");
+
+  testMortonOrder<2>(8);
+  testMortonOrder<3>(4);
+
+  // structured grids
+  std::vector<unsigned> colours;
+  auto quads = gridCells<2>(6);
+  unsigned ncolours = mpm::greedy_colouring(quads, colours);
+  check(ncolours == 4, "quadrilateral grid does not have 4 colours");
+  check(validColouring(quads, colours), "quadrilateral cells of a colour share a node");
+
+  auto hexes = gridCells<3>(4);
+  ncolours = mpm::greedy_colouring(hexes, colours);
+  check(ncolours == 8, "hexahedral grid does not have 8 colours");
+  check(validColouring(hexes, colours), "hexahedral cells of a colour share a node");
+
+  // cells in Morton order, and a cell sharing nodes with many others,
+  // as the nonlocal cells do
+  std::vector<std::vector<mpm::Index>> cells;
+  std::vector<unsigned> order(quads.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::reverse(order.begin(), order.end());
+  for (unsigned c : order)
+    cells.push_back(quads[c]);
+  cells.push_back({0, 8, 16, 24, 32, 40, 48});
+  ncolours = mpm::greedy_colouring(cells, colours);
+  check(ncolours > 4, "nonlocal cell does not take a new colour");
+  check(validColouring(cells, colours), "irregular cells of a colour share a node");
+
+  if (numFailed == 0) {
+    printf("PASSED\n");
+    return 0;
+  }
+  return 1;
+}
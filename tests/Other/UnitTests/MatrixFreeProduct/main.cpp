@@ -0,0 +1,225 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file contains a test of MatrixFreeLinSOE::formAp. The
+// products of the matrix-free system are compared with those of the
+// tangent that the integrator forms for a grid of quadrilaterals:
+//
+// - with LoadControl, whose products are formed by the elements, on one
+//   and on several threads;
+//
+// - with Newmark, whose factors change with the time step, for two
+//   steps formed one after the other.
+//
+// Written: cmp
+//
+#include <stdio.h>
+#include <math.h>
+#include <array>
+
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Domain.h>
+#include <Node.h>
+#include <SP_Constraint.h>
+#include <LagrangeQuad.h>
+#include <ElasticIsotropic.h>
+
+#include <AnalysisModel.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <DOF_Group.h>
+#include <DOF_GrpIter.h>
+#include <PlainHandler.h>
+#include <PlainNumberer.h>
+#include <LoadControl.h>
+#include <Newmark.h>
+#include <Linear.h>
+#include <StaticAnalysis.h>
+#include <DirectIntegrationAnalysis.h>
+#include <KrylovSolver.h>
+#include <MatrixFreeLinSOE.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+using namespace OpenSees;
+
+static const int nx = 12;
+static const int ny = 12;
+
+static int
+nodeTag(int i, int j)
+{
+  return 1 + j*(nx+1) + i;
+}
+
+static void
+buildModel(Domain &theDomain, Mate<2> &material)
+{
+  for (int j=0; j<=ny; j++)
+    for (int i=0; i<=nx; i++)
+      theDomain.addNode(new Node(nodeTag(i,j), 2, 1.0*i, 0.5*j));
+
+  int tag = 1;
+  for (int j=0; j<ny; j++)
+    for (int i=0; i<nx; i++) {
+      std::array<int,4> nodes {nodeTag(i,j),   nodeTag(i+1,j),
+                               nodeTag(i+1,j+1), nodeTag(i,j+1)};
+      theDomain.addElement(new LagrangeQuad<4>(tag++, nodes, material, 1.0, 0.0, 2.0));
+    }
+
+  for (int i=0; i<=nx; i++)
+    for (int dof=0; dof<2; dof++)
+      theDomain.addSP_Constraint(new SP_Constraint(nodeTag(i,0), dof, 0.0, true));
+}
+
+static void
+assemble(Matrix &A, const Matrix &k, const ID &id)
+{
+  for (int i=0; i<id.Size(); i++)
+    for (int j=0; j<id.Size(); j++)
+      if (id(i) >= 0 && id(j) >= 0)
+        A(id(i), id(j)) += k(i,j);
+}
+
+// the tangent as the integrator forms it
+static Matrix
+tangent(AnalysisModel &theModel, IncrementalIntegrator &theIntegrator, int n)
+{
+  Matrix A(n, n);
+
+  FE_EleIter &theEles = theModel.getFEs();
+  FE_Element *theFE;
+  while ((theFE = theEles()) != nullptr)
+    assemble(A, theFE->getTangent(&theIntegrator), theFE->getID());
+
+  DOF_GrpIter &theDOFs = theModel.getDOFs();
+  DOF_Group *theDOF;
+  while ((theDOF = theDOFs()) != nullptr)
+    assemble(A, theDOF->getTangent(&theIntegrator), theDOF->getID());
+
+  return A;
+}
+
+// the largest difference between the products of the system and of A
+// with a few vectors, relative to the largest product
+static double
+difference(MatrixFreeLinSOE &theSOE, const Matrix &A)
+{
+  const int n = theSOE.getNumEqn();
+  Vector p(n), Ap(n), Ap_ref(n);
+  double diff = 0.0, size = 0.0;
+  for (int k=0; k<3; k++) {
+    for (int i=0; i<n; i++)
+      p(i) = sin(1.0 + i*(k+1)) + (k == 0 ? 1.0 : 0.0);
+    if (theSOE.formAp(p, Ap) < 0)
+      return 1.0;
+    Ap_ref.addMatrixVector(0.0, A, p, 1.0);
+    for (int i=0; i<n; i++) {
+      diff = fmax(diff, fabs(Ap(i) - Ap_ref(i)));
+      size = fmax(size, fabs(Ap_ref(i)));
+    }
+  }
+  return size > 0.0 ? diff/size : diff;
+}
+
+static int
+testStatic(Mate<2> &material)
+{
+  Domain theDomain;
+  buildModel(theDomain, material);
+
+  AnalysisModel     *theModel      = new AnalysisModel();
+  EquiSolnAlgo      *theAlgorithm  = new Linear();
+  StaticIntegrator  *theIntegrator = new LoadControl(1.0, 1, 1.0, 1.0);
+  ConstraintHandler *theHandler    = new PlainHandler();
+  DOF_Numberer      *theNumberer   = new PlainNumberer();
+  KrylovSolver      *theSolver     = new KrylovSolver();
+  MatrixFreeLinSOE  *theSOE        = new MatrixFreeLinSOE(*theSolver, 2);
+
+  StaticAnalysis theAnalysis(theDomain, *theHandler, *theNumberer, *theModel,
+                             *theAlgorithm, *theSOE, *theIntegrator);
+  if (theAnalysis.domainChanged() < 0) {
+    fprintf(stderr, "FAILED: static domainChanged\n");
+    return 1;
+  }
+  theSOE->setIntegrator(theIntegrator);
+
+  theIntegrator->formTangent();
+  const Matrix A = tangent(*theModel, *theIntegrator, theSOE->getNumEqn());
+
+  int failures = 0;
+  for (int numThreads : {1, 2, 4}) {
+    theSOE->setNumThreads(numThreads);
+    double diff = difference(*theSOE, A);
+    if (diff > 1.0e-12) {
+      fprintf(stderr, "FAILED: static, %d threads, relative difference %g\n", numThreads, diff);
+      failures++;
+    }
+  }
+  return failures;
+}
+
+static int
+testTransient(Mate<2> &material)
+{
+  Domain theDomain;
+  buildModel(theDomain, material);
+
+  AnalysisModel       *theModel      = new AnalysisModel();
+  EquiSolnAlgo        *theAlgorithm  = new Linear();
+  TransientIntegrator *theIntegrator = new Newmark(0.5, 0.25);
+  ConstraintHandler   *theHandler    = new PlainHandler();
+  DOF_Numberer        *theNumberer   = new PlainNumberer();
+  KrylovSolver        *theSolver     = new KrylovSolver();
+  MatrixFreeLinSOE    *theSOE        = new MatrixFreeLinSOE(*theSolver, 2);
+
+  DirectIntegrationAnalysis theAnalysis(theDomain, *theHandler, *theNumberer, *theModel,
+                                        *theAlgorithm, *theSOE, *theIntegrator);
+  if (theAnalysis.domainChanged() < 0) {
+    fprintf(stderr, "FAILED: transient domainChanged\n");
+    return 1;
+  }
+  theSOE->setIntegrator(theIntegrator);
+  theSOE->setNumThreads(4);
+
+  // the mass term grows by 16 from one step to the next, so factors
+  // kept from the first would not reproduce the second
+  int failures = 0;
+  for (double dt : {0.02, 0.005}) {
+    if (theIntegrator->newStep(dt) < 0 || theIntegrator->formTangent() < 0) {
+      fprintf(stderr, "FAILED: transient step of %g\n", dt);
+      failures++;
+      continue;
+    }
+    const Matrix A = tangent(*theModel, *theIntegrator, theSOE->getNumEqn());
+    double diff = difference(*theSOE, A);
+    if (diff > 1.0e-12) {
+      fprintf(stderr, "FAILED: transient, dt = %g, relative difference %g\n", dt, diff);
+      failures++;
+    }
+    theIntegrator->revertToLastStep();
+  }
+  return failures;
+}
+
+int
+main(int argc, char **argv)
+{
+  ElasticIsotropic<2,PlaneType::Strain> material(1, 30000.0, 0.25, 0.0);
+
+  int failures = testStatic(material) + testTransient(material);
+  if (failures != 0)
+    return 1;
+
+  fprintf(stdout, "PASSED\n");
+  return 0;
+}
@@ -0,0 +1,239 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file contains a test of the scatter locations used
+// by addA in SparseGenColLinSOE, SparseGenRowLinSOE and SymSparseLinSOE.
+//
+// For a small graph, locateA must find every entry coupled by an edge
+// and every diagonal entry, and must report entries that are not in the
+// graph as absent rather than follow the sparse structure past its end.
+// The same element matrices, one of them with a constrained (-1)
+// equation, are then assembled into each SOE and the solution compared
+// with that of the dense system.
+//
+// Written: cmp
+//
+#include <stdio.h>
+#include <math.h>
+#include <set>
+#include <stdint.h>
+#include <algorithm>
+
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Graph.h>
+#include <Vertex.h>
+#include <SuperLU.h>
+#include <SparseGenColLinSOE.h>
+#include <KrylovSolver.h>
+#include <SparseGenRowLinSOE.h>
+#include <SymSparseLinSolver.h>
+#include <SymSparseLinSOE.h>
+
+static const int numEqn = 6;
+
+static int failures = 0;
+
+static void
+check(bool ok, const char *soe, const char *what, int row, int col)
+{
+  if (!ok) {
+    fprintf(stderr, "FAILED %s: %s (%d,%d)\n", soe, what, row, col);
+    failures++;
+  }
+}
+
+// 0-1-2 chain, 1-3, 3-4-5 chain
+static void
+formGraph(Graph &theGraph)
+{
+  // the Graph deletes its vertices
+  for (int i=0; i<numEqn; i++)
+    theGraph.addVertex(new Vertex(i, i));
+
+  theGraph.addEdge(0,1);
+  theGraph.addEdge(2,1);
+  theGraph.addEdge(1,3);
+  theGraph.addEdge(5,4);
+  theGraph.addEdge(4,3);
+}
+
+static bool
+coupled(int row, int col)
+{
+  static const int edges[][2] = {{0,1},{2,1},{1,3},{5,4},{4,3}};
+  if (row == col)
+    return true;
+  for (auto &e : edges)
+    if ((e[0] == row && e[1] == col) || (e[1] == row && e[0] == col))
+      return true;
+  return false;
+}
+
+// locate returns a key for the storage of (row,col), or -1 when the
+// entry is not stored. Where the storage holds fill (the factor of
+// SymSparseLinSOE), an entry not in the graph may be stored, but must
+// not share its location with an entry that is.
+template <typename SOE, typename Locate>
+static void
+checkLocations(const char *name, SOE &theSOE, bool fill, Locate &&locate)
+{
+  std::set<long> used;
+  for (int row=0; row<numEqn; row++)
+    for (int col=0; col<numEqn; col++)
+      if (coupled(row, col)) {
+        long key = locate(theSOE, row, col);
+        check(key != -1, name, "present entry not found", row, col);
+        used.insert(key);
+      }
+
+  for (int row=0; row<numEqn; row++)
+    for (int col=0; col<numEqn; col++)
+      if (!coupled(row, col)) {
+        long key = locate(theSOE, row, col);
+        if (fill)
+          check(key == -1 || used.count(key) == 0, name,
+                "absent entry shares a location", row, col);
+        else
+          check(key == -1, name, "absent entry found", row, col);
+      }
+
+  // out of range equations are never located
+  check(locate(theSOE, -1, 0) == -1, name, "constrained entry found", -1, 0);
+  check(locate(theSOE, 0, numEqn) == -1, name, "out of range entry found", 0, numEqn);
+}
+
+// assemble the same system into an SOE and the dense matrix
+template <typename SOE>
+static void
+assemble(SOE &theSOE, Matrix *dense, Vector *rhs)
+{
+  Matrix a(2,2);
+  a(0,0) = 4.0; a(0,1) = 1.0;
+  a(1,0) = 1.0; a(1,1) = 4.0;
+
+  Matrix c(3,3);
+  c(0,0) = 9.0; c(0,1) = 2.0; c(0,2) = 2.0;
+  c(1,0) = 2.0; c(1,1) = 9.0; c(1,2) = 2.0;
+  c(2,0) = 2.0; c(2,1) = 2.0; c(2,2) = 9.0;
+
+  ID f(2);   f(0) =  1;  f(1) = 0;
+  ID g(2);   g(0) = -1;  g(1) = 2;
+  ID h(2);   h(0) =  3;  h(1) = 1;
+  ID m(3);   m(0) =  5;  m(1) = 4; m(2) = 3;
+
+  Vector x(3); x(0) = 2; x(1) = 3; x(2) = 4.5;
+
+  struct {const Matrix &k; const ID &id; double fact;} elements[] = {
+    {a, f, 1.0}, {a, g, 1.0}, {a, h, 1.0}, {c, m, 2.0}
+  };
+
+  theSOE.zeroA();
+  theSOE.zeroB();
+  // assemble twice so that the second pass uses the cached locations
+  for (int pass=0; pass<2; pass++)
+    for (auto &e : elements)
+      theSOE.addA(e.k, e.id, 0.5*e.fact);
+  theSOE.addB(x, m);
+
+  if (dense != nullptr) {
+    dense->Zero();
+    rhs->Zero();
+    for (auto &e : elements)
+      for (int i=0; i<e.id.Size(); i++)
+        for (int j=0; j<e.id.Size(); j++)
+          if (e.id(i) >= 0 && e.id(j) >= 0)
+            (*dense)(e.id(i), e.id(j)) += e.fact*e.k(i,j);
+    for (int i=0; i<m.Size(); i++)
+      (*rhs)(m(i)) += x(i);
+  }
+}
+
+static void
+checkSolution(const char *name, const Vector &x, const Vector &ref)
+{
+  for (int i=0; i<numEqn; i++)
+    check(fabs(x(i) - ref(i)) <= 1.0e-8*(1.0 + fabs(ref(i))),
+          name, "solution differs from dense solve", i, i);
+}
+
+int
+main(int argc, char **argv)
+{
+  Graph theGraph(numEqn);
+  formGraph(theGraph);
+
+  Matrix dense(numEqn, numEqn);
+  Vector rhs(numEqn), ref(numEqn);
+
+  //
+  // SparseGenColLinSOE
+  //
+  {
+    SuperLU *theSolver = new SuperLU();
+    SparseGenColLinSOE theSOE(*theSolver);
+    theSOE.setSize(theGraph);
+    checkLocations("SparseGenColLinSOE", theSOE, false,
+      [](SparseGenColLinSOE &soe, int row, int col) -> long {
+        return soe.locateA(row, col);
+      });
+
+    assemble(theSOE, &dense, &rhs);
+    dense.Solve(rhs, ref);
+    theSOE.solve();
+    checkSolution("SparseGenColLinSOE", theSOE.getX(), ref);
+  }
+
+  //
+  // SparseGenRowLinSOE
+  //
+  {
+    KrylovSolver *theSolver = new KrylovSolver(KrylovSolver::CG,
+                                               KrylovSolver::Jacobi, 1.0e-14);
+    SparseGenRowLinSOE theSOE(*theSolver);
+    theSOE.setSize(theGraph);
+    checkLocations("SparseGenRowLinSOE", theSOE, false,
+      [](SparseGenRowLinSOE &soe, int row, int col) -> long {
+        return soe.locateA(row, col);
+      });
+
+    assemble(theSOE, nullptr, nullptr);
+    theSOE.solve();
+    checkSolution("SparseGenRowLinSOE", theSOE.getX(), ref);
+  }
+
+  //
+  // SymSparseLinSOE
+  //
+  for (int lSparse = 1; lSparse <= 3; lSparse++) {
+    SymSparseLinSolver *theSolver = new SymSparseLinSolver();
+    SymSparseLinSOE theSOE(*theSolver, lSparse);
+    theSOE.setSize(theGraph);
+    // only the upper local entries (i < j) of a symmetric pair are
+    // located; (row,col) and (col,row) share the same location
+    checkLocations("SymSparseLinSOE", theSOE, true,
+      [](SymSparseLinSOE &soe, int row, int col) -> long {
+        const double *loc = soe.locateA(std::min(row,col), std::max(row,col),
+                                        0, row == col ? 0 : 1);
+        return loc == nullptr ? -1 : (long)(intptr_t)loc;
+      });
+    check(theSOE.locateA(1, 0, 1, 0) == nullptr, "SymSparseLinSOE",
+          "lower local entry located", 1, 0);
+
+    assemble(theSOE, nullptr, nullptr);
+    theSOE.solve();
+    checkSolution("SymSparseLinSOE", theSOE.getX(), ref);
+  }
+
+  if (failures != 0) {
+    fprintf(stderr, "%d checks failed\n", failures);
+    return 1;
+  }
+
+  fprintf(stdout, "PASSED\n");
+  return 0;
+}
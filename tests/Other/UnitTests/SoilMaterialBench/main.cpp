@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file contains a driver that measures the cost of one
+// Gauss-point update, a call to setTrialStrain followed by commitState, of
+// the ManzariDafalias, PM4Sand and PM4Silt materials.
+//
+// Each material is consolidated in its elastic stage, switched to its
+// plastic stage and then driven through constant-volume cyclic simple
+// shear. The mean time per update is printed with the final stress, so
+// that builds before and after a change to the integration can be
+// compared both for speed and for the response they produce.
+//
+//   soilMaterialBench ?cycles?
+//
+// Written: cmp
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+#include <Vector.h>
+#include <Matrix.h>
+#include <Information.h>
+#include <NDMaterial.h>
+#include <ManzariDafalias3D.h>
+#include <ManzariDafaliasPlaneStrain.h>
+#include <PM4Sand.h>
+#include <PM4Silt.h>
+
+static const int    stepsPerCycle = 200;
+static const double shearAmplitude = 0.0005;
+
+static void
+update(NDMaterial &material, int responseID, int value)
+{
+  Information info;
+  info.theInt = value;
+  material.updateParameter(responseID, info);
+}
+
+// Drive the material from its elastic stage through consolidation to the
+// normal strain eps, then through the given number of shear cycles; the
+// PM4 materials take their initial state from the consolidated stress
+// (updateParameter 8). Returns the mean time per update in microseconds.
+static double
+run(const char *name, NDMaterial &material, int order, double eps, int cycles, bool isPM4)
+{
+  Vector strain(order);
+  const int shear = order == 6 ? 3 : 2;
+
+  update(material, 1, 0);
+  for (int i = 1; i <= 100; i++) {
+    strain(0) = strain(1) = eps*i/100.0;
+    if (order == 6)
+      strain(2) = eps*i/100.0;
+    material.setTrialStrain(strain);
+    material.commitState();
+  }
+  if (isPM4)
+    update(material, 8, 1);
+  update(material, 1, 1);
+
+  const int steps = cycles*stepsPerCycle;
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 1; i <= steps; i++) {
+    strain(shear) = shearAmplitude*sin(2.0*M_PI*i/stepsPerCycle);
+    material.setTrialStrain(strain);
+    material.commitState();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  const double micro = std::chrono::duration<double, std::micro>(end - begin).count()/steps;
+  const Vector &stress = material.getStress();
+  printf("%-28s %10d %12.3f   ", name, steps, micro);
+  for (int i = 0; i < stress.Size(); i++)
+    printf(" %14.8e", stress(i));
+  printf("\n");
+  return micro;
+}
+
+
+int
+main(int argc, char **argv)
+{
+  int cycles = argc > 1 ? atoi(argv[1]) : 20;
+  if (cycles < 1)
+    cycles = 1;
+
+  printf("%-28s %10s %12s    %s\n", "material", "updates", "us/update", "final stress");
+
+  // Dafalias and Manzari (2004), Toyoura sand
+  {
+    ManzariDafalias3D material(1, 125.0, 0.05, 0.7, 1.25, 0.712, 0.019, 0.934, 0.7,
+                               100.0, 0.01, 7.05, 0.968, 1.1, 0.704, 3.5, 4.0, 600.0, 1.42,
+                               1, 2);
+    run("ManzariDafalias3D", material, 6, -0.0005, cycles, false);
+  }
+  {
+    ManzariDafaliasPlaneStrain material(2, 125.0, 0.05, 0.7, 1.25, 0.712, 0.019, 0.934, 0.7,
+                                        100.0, 0.01, 7.05, 0.968, 1.1, 0.704, 3.5, 4.0, 600.0, 1.42,
+                                        1, 2);
+    run("ManzariDafaliasPlaneStrain", material, 3, -0.0007, cycles, false);
+  }
+  {
+    PM4Sand material(3, 0.5, 476.0, 0.53, 1.7);
+    run("PM4Sand", material, 3, -0.0007, cycles, true);
+  }
+  {
+    PM4Silt material(4, 0.0, 0.3, 476.0, 0.53, 1.7);
+    run("PM4Silt", material, 3, -0.0007, cycles, true);
+  }
+
+  return 0;
+}
@@ -0,0 +1,211 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file contains a regression test of the explicit
+// integrators of PM4Sand and PM4Silt, which work on fixed-size stack
+// tensors.
+//
+// Each material is consolidated in its elastic stage, switched to its
+// plastic stage with its initial state taken from the consolidated
+// stress, and then driven through growing cyclic shear with a small
+// oscillation of the normal strain until it liquefies. The stress and
+// tangent are compared at intervals with the response produced by the
+// earlier Vector/Matrix form of the integrators for every scheme:
+// 1 ModifiedEuler, 2 ForwardEuler, 3 RungeKutta4, 4 MAXSTR_FE and
+// 5 MAXSTR_ME. The history reaches the dilatancy surface, so that the
+// fabric terms, which depend on the initial fabric, enter the response.
+//
+// Written: cmp
+//
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include <Vector.h>
+#include <Matrix.h>
+#include <Information.h>
+#include <NDMaterial.h>
+#include <PM4Sand.h>
+#include <PM4Silt.h>
+
+static const int    numSteps = 1200;
+static const int    interval = 150;
+static const double tol      = 1.0e-6;
+
+struct Sample {
+  const char *material;
+  int scheme;
+  int step;
+  double stress[3];
+  double tangent[2]; // C(0,0), C(2,2)
+};
+
+// response of the Vector/Matrix integrators
+static const Sample reference[] = {
+  {"PM4Sand", 1, 150, {-157.64735780477076, -159.56258005624875, -35.434003419883481}, {209183.09364202057, 59766.598183434449}},
+  {"PM4Sand", 1, 300, {-146.35022259570857, -145.33498024287326, -21.096363160627632}, {202167.01333387176, 57762.003809677648}},
+  {"PM4Sand", 1, 450, {-66.459585507567908, -66.86967842294915, 31.158514508440973}, {114363.43016833597, 32675.26576238171}},
+  {"PM4Sand", 1, 600, {-16.95987288998262, -16.876238937617618, 7.9527504983529882}, {55376.09069566441, 15821.740198761261}},
+  {"PM4Sand", 1, 750, {-9.5795021000644685, -9.618613949388207, -6.1178860315342014}, {14988.789499777944, 4282.5112856508413}},
+  {"PM4Sand", 1, 900, {-1.8782332828755122, -1.8818815678564553, -0.98715720024894005}, {10029.423290186223, 2865.5495114817786}},
+  {"PM4Sand", 1, 1050, {-5.0541005353038368, -5.0255198083583696, 3.2358579415271245}, {10197.881017068754, 2913.6802905910731}},
+  {"PM4Sand", 1, 1200, {-2.0751396567953551, -2.0805076154795947, 1.2093634528296862}, {8727.0448874813046, 2493.4413964232299}},
+  {"PM4Silt", 1, 150, {-118.83899627574594, -118.81423822126308, -22.199429141911349}, {139993.13910805844, 39998.039745159556}},
+  {"PM4Silt", 1, 300, {-30.133183244327927, -29.923919963233672, -8.2307579401837732}, {65953.437823079323, 18843.839378022665}},
+  {"PM4Silt", 1, 450, {-17.758083963462404, -17.889410447417884, 9.3061658058428325}, {23348.024412549254, 6670.864117871216}},
+  {"PM4Silt", 1, 600, {-11.315511987468076, -11.269238270552686, 3.3291170046381331}, {17324.544428648449, 4949.8698367567004}},
+  {"PM4Silt", 1, 750, {-12.565512067401686, -12.553006580444791, -6.4468349490850718}, {13303.367286854576, 3800.9620819584511}},
+  {"PM4Silt", 1, 900, {-10.07715691424173, -10.11102877056266, -2.9983305837107337}, {12418.189366146318, 3548.0541046132339}},
+  {"PM4Silt", 1, 1050, {-12.909464376559427, -12.869584265207529, 6.9775912297438163}, {11521.235489705148, 3291.7815684871857}},
+  {"PM4Silt", 1, 1200, {-9.8470806744326396, -9.8703247985929394, 3.2935673743797809}, {11102.849605238487, 3172.2427443538541}},
+  {"PM4Sand", 2, 150, {-157.64414391046071, -159.5670687098891, -35.616787218599903}, {209142.0914118849, 59754.883260538547}},
+  {"PM4Sand", 2, 300, {-146.44075802233644, -145.41920425083725, -21.689340851554384}, {202189.38163039216, 57768.394751540618}},
+  {"PM4Sand", 2, 450, {-68.899730266592812, -69.314447577066446, 31.470962509611024}, {118640.58665599723, 33897.310473142068}},
+  {"PM4Sand", 2, 600, {-27.250932696916781, -27.118368309218521, 10.236726661722702}, {81762.056166210794, 23360.587476060227}},
+  {"PM4Sand", 2, 750, {-22.30009563067998, -22.297993499850655, -14.045261959394564}, {27093.689475292889, 7741.0541357979682}},
+  {"PM4Sand", 2, 900, {-2.0634626279631894, -2.0746735225145438, -0.82453215155541781}, {13575.474960185156, 3878.7071314814734}},
+  {"PM4Sand", 2, 1050, {-5.694480742110005, -5.6794472913751486, 3.6458683688258691}, {11260.328161268975, 3217.2366175054217}},
+  {"PM4Sand", 2, 1200, {-2.1372610069609514, -2.1437411524919101, 0.83754846108391523}, {12676.552487843364, 3621.8721393838182}},
+  {"PM4Silt", 2, 150, {-123.10290775018592, -123.15775848323852, -22.175555018682477}, {145057.31314183184, 41444.946611951957}},
+  {"PM4Silt", 2, 300, {-35.53423062751186, -35.320001548153449, -9.9306172710059695}, {73872.925433961005, 21106.550123988862}},
+  {"PM4Silt", 2, 450, {-18.139910883191703, -18.276931785380331, 9.5787541613593756}, {24599.94560806029, 7028.5558880172257}},
+  {"PM4Silt", 2, 600, {-11.402545246480683, -11.355400822108649, 3.3646988231429189}, {18027.615695941648, 5150.7473416976136}},
+  {"PM4Silt", 2, 750, {-13.50264183069817, -13.488384222947028, -7.1119663700708999}, {14051.788639195263, 4014.7967540557897}},
+  {"PM4Silt", 2, 900, {-10.039197288484369, -10.073546712756551, -3.1537548897575247}, {12602.328020548564, 3600.665148728162}},
+  {"PM4Silt", 2, 1050, {-11.911563258581978, -11.874224436096368, 6.3876014287368053}, {11195.077799739131, 3198.5936570683234}},
+  {"PM4Silt", 2, 1200, {-9.738745648477579, -9.761620263236205, 3.3416537540910269}, {11119.217780473316, 3176.9193658495192}},
+  {"PM4Sand", 3, 150, {-157.64128900854385, -159.56428281711135, -35.515801546327062}, {209163.09898884769, 59760.885425385051}},
+  {"PM4Sand", 3, 300, {-145.31533018106106, -144.61995769701281, -24.874203238822162}, {201236.77283043429, 57496.220808695514}},
+  {"PM4Sand", 3, 450, {-100.96750511983966, -101.09399015348166, 61.199813407468106}, {69145.994579724371, 19755.99845134982}},
+  {"PM4Sand", 3, 600, {-13.482681737150843, -12.086389792745146, 8.0495945577936769}, {19409.539363470849, 5545.5826752773855}},
+  {"PM4Sand", 3, 750, {-23.55592126928045, -22.363891386586435, -14.426321245948817}, {23371.669685015317, 6677.6199100043768}},
+  {"PM4Sand", 3, 900, {-14.707435283343678, -13.195400301196688, -8.765998649116634}, {17911.203605063012, 5117.4867443037174}},
+  {"PM4Sand", 3, 1050, {-31.136253749464711, -30.813295593335337, 19.293914321181511}, {26164.94152508257, 7475.6975785950199}},
+  {"PM4Sand", 3, 1200, {-19.246886430606875, -22.135422147043212, 12.889548672560874}, {21150.561719498386, 6043.0176341423967}},
+  {"PM4Silt", 3, 150, {-118.76480667895422, -118.8387362186909, -22.444358108124472}, {137708.54381596064, 39345.298233131609}},
+  {"PM4Silt", 3, 300, {-30.249908424767586, -29.969901440012503, -13.331635237681834}, {55302.911528479599, 15800.831865279886}},
+  {"PM4Silt", 3, 450, {-25.209590227668606, -25.62341166602118, 15.540841965355037}, {18217.319589967581, 5204.9484542764521}},
+  {"PM4Silt", 3, 600, {-14.467380476810906, -12.887490146081049, 6.1084130238408454}, {18037.567234263261, 5153.5906383609317}},
+  {"PM4Silt", 3, 750, {-21.700129081225786, -20.757647790626137, -14.847178894223093}, {11648.190867398454, 3328.0545335424158}},
+  {"PM4Silt", 3, 900, {-12.617401409060946, -12.233448764914968, -7.2688378395507032}, {10979.288067696838, 3136.9394479133825}},
+  {"PM4Silt", 3, 1050, {-21.090022426062664, -20.795309760764447, 13.727713001533669}, {10256.612733986758, 2930.4607811390738}},
+  {"PM4Silt", 3, 1200, {-14.184254554514103, -13.138469472653515, 9.3903692493945385}, {7265.244478440999, 2075.7841366974285}},
+  {"PM4Sand", 4, 150, {-157.6429277951521, -159.56226672691835, -35.440531400771995}, {209179.96020769121, 59765.702916483206}},
+  {"PM4Sand", 4, 300, {-146.34929628203028, -145.3387089941273, -21.13325741461113}, {202165.66644808961, 57761.618985168468}},
+  {"PM4Sand", 4, 450, {-66.756802124756106, -67.167890628458423, 31.238774216593001}, {114779.15256605635, 32794.043590301815}},
+  {"PM4Sand", 4, 600, {-18.768666684250796, -18.668212653174159, 8.6396876270270493}, {59856.984170410913, 17101.995477260261}},
+  {"PM4Sand", 4, 750, {-19.12963566104894, -19.15270087659805, -12.084699503568258}, {22458.147372978827, 6416.6135351368084}},
+  {"PM4Sand", 4, 900, {-4.2458109492556648, -4.2475511173274567, -2.6833428643733455}, {10340.854525101429, 2954.5298643146939}},
+  {"PM4Sand", 4, 1050, {-10.245389429485682, -10.181169733570959, 6.5018628540952887}, {14602.361833389856, 4172.1033809685305}},
+  {"PM4Sand", 4, 1200, {-3.9595853701385173, -3.9660145526047965, 2.5378324056289943}, {9104.0450266733278, 2601.1557219066653}},
+  {"PM4Silt", 4, 150, {-119.73505522618183, -119.711670268571, -22.303425071961989}, {139968.52009498945, 39991.005741425557}},
+  {"PM4Silt", 4, 300, {-30.71217291113534, -30.503832337589035, -8.4277674753272631}, {66826.018567790641, 19093.148162225898}},
+  {"PM4Silt", 4, 450, {-17.976404542373611, -18.1092468340205, 9.4638641229349716}, {23695.91791004972, 6770.2622600142058}},
+  {"PM4Silt", 4, 600, {-11.482024406646346, -11.434272585573622, 3.4240723594441436}, {17866.172708768569, 5104.620773933877}},
+  {"PM4Silt", 4, 750, {-13.591277212070423, -13.579223448564235, -7.0776595031190439}, {14134.849642163284, 4038.5284691895104}},
+  {"PM4Silt", 4, 900, {-10.161268642773484, -10.195362701303569, -3.0620761519446207}, {12683.023674338148, 3623.7210498108998}},
+  {"PM4Silt", 4, 1050, {-12.525177335498233, -12.486166763264528, 6.8324021957562167}, {11343.422545013374, 3240.9778700038219}},
+  {"PM4Silt", 4, 1200, {-9.7379279322973549, -9.7611193274065329, 3.3071468949538612}, {11118.326052453949, 3176.6645864154143}},
+  {"PM4Sand", 5, 150, {-157.64872705184513, -159.56389628965573, -35.433048602722067}, {209184.25807386075, 59766.930878245934}},
+  {"PM4Sand", 5, 300, {-146.36625166119487, -145.35116535997716, -21.103019481915915}, {202177.90082863244, 57765.114522466414}},
+  {"PM4Sand", 5, 450, {-66.621729220897109, -67.032380133248765, 31.192504078962699}, {114618.74767942444, 32748.2136226927}},
+  {"PM4Sand", 5, 600, {-18.688454470734392, -18.596612864336592, 8.4740095167147498}, {60527.563612539874, 17293.589603582823}},
+  {"PM4Sand", 5, 750, {-13.36481775778455, -13.424110414478534, -8.4998328984603813}, {18881.016142993019, 5394.5760408551487}},
+  {"PM4Sand", 5, 900, {-2.0959753886262922, -2.0988274301284537, -1.1985610903994639}, {9650.8117537294893, 2757.3747867798543}},
+  {"PM4Sand", 5, 1050, {-7.2730815897559546, -7.230957280571265, 4.6376325022627842}, {12360.209951126548, 3531.4885574647278}},
+  {"PM4Sand", 5, 1200, {-2.4482733414281976, -2.4540039458857863, 1.4765546776900487}, {8821.5483090930866, 2520.4423740265966}},
+  {"PM4Silt", 5, 150, {-119.03626506730113, -119.01383481540748, -22.200649608315619}, {140224.21364560717, 40064.06104160205}},
+  {"PM4Silt", 5, 300, {-30.385260318521858, -30.174994256542632, -8.2783752399149702}, {66368.829394059765, 18962.522684017076}},
+  {"PM4Silt", 5, 450, {-17.968777840550811, -18.101385258005923, 9.4397211016685425}, {23736.725649270877, 6781.9216140773942}},
+  {"PM4Silt", 5, 600, {-11.481393560394785, -11.433748706246574, 3.4208140491099703}, {17860.149817025114, 5102.899947721462}},
+  {"PM4Silt", 5, 750, {-13.582422283368203, -13.570210841615696, -7.0626283846273026}, {14145.054793746614, 4041.4442267847471}},
+  {"PM4Silt", 5, 900, {-10.163446076367553, -10.197613646603752, -3.0583734874097539}, {12685.786885417743, 3624.510538690784}},
+  {"PM4Silt", 5, 1050, {-12.532702194655625, -12.493707978468839, 6.8303761190283341}, {11356.306970052967, 3244.6591343008481}},
+  {"PM4Silt", 5, 1200, {-9.7365237554963358, -9.7597327901699789, 3.3053049239386305}, {11117.787956716802, 3176.5108447762295}}
+};
+
+static int failures = 0;
+
+static void
+update(NDMaterial &material, int responseID, int value)
+{
+  Information info;
+  info.theInt = value;
+  material.updateParameter(responseID, info);
+}
+
+static void
+check(const char *name, int scheme, int step, const char *what, double value, double exact)
+{
+  if (fabs(value - exact) > tol*(1.0 + fabs(exact))) {
+    fprintf(stderr, "FAILED %s scheme %d step %d: %s %.17g != %.17g\n",
+            name, scheme, step, what, value, exact);
+    failures++;
+  }
+}
+
+static void
+run(const char *name, int scheme, NDMaterial &material, const Sample *&sample)
+{
+  Vector strain(3);
+
+  update(material, 1, 0);
+  for (int i = 1; i <= 50; i++) {
+    strain(0) = strain(1) = -0.0007*i/50.0;
+    material.setTrialStrain(strain);
+    material.commitState();
+  }
+  update(material, 8, 1);
+  update(material, 1, 1);
+
+  for (int i = 1; i <= numSteps; i++) {
+    double t = (double)i/numSteps;
+    strain(2) = 0.02*t*sin(2.0*M_PI*6.0*t);
+    strain(0) = -0.0007 + 0.00005*sin(2.0*M_PI*3.0*t);
+    material.setTrialStrain(strain);
+    material.commitState();
+    if (i % interval != 0)
+      continue;
+
+    if (strcmp(sample->material, name) != 0 || sample->scheme != scheme || sample->step != i) {
+      fprintf(stderr, "FAILED %s scheme %d step %d: no reference\n", name, scheme, i);
+      failures++;
+      continue;
+    }
+    const Vector &stress = material.getStress();
+    const Matrix &tangent = material.getTangent();
+    for (int j = 0; j < 3; j++)
+      check(name, scheme, i, "stress", stress(j), sample->stress[j]);
+    check(name, scheme, i, "C(0,0)", tangent(0,0), sample->tangent[0]);
+    check(name, scheme, i, "C(2,2)", tangent(2,2), sample->tangent[1]);
+    sample++;
+  }
+}
+
+
+int
+main(int argc, char **argv)
+{
+  const Sample *sample = reference;
+
+  for (int scheme = 1; scheme <= 5; scheme++) {
+    PM4Sand sand(1, 0.5, 476.0, 0.53, 1.7, 101.3, -1, 0.8, 0.5, 0.5, 0.1, -1, -1, 250, -1,
+                 33.0, 0.3, 2.0, -1, -1, 10, 1.5, 0.01, -1, -1, scheme);
+    run("PM4Sand", scheme, sand, sample);
+
+    PM4Silt silt(2, 20.0, 0.0, 476.0, 0.53, 1.7, 1.0, 101.3, 0.3, 0.75, 0.5, 0.9, 0.06, 32.0,
+                 0.8, 0.5, 0.3, 0.8, -1, -1, 100.0, -1, 3.0, 4.0, 0.01, 2.0, scheme);
+    run("PM4Silt", scheme, silt, sample);
+  }
+
+  if (failures != 0) {
+    fprintf(stderr, "%d checks failed\n", failures);
+    return 1;
+  }
+
+  fprintf(stdout, "PASSED\n");
+  return 0;
+}
@@ -0,0 +1,187 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file contains a test of LinearSOE::assembleA. The
+// stiffness of a grid of quadrilaterals is assembled into a
+// SparseGenRowLinSOE element by element through addA, and then through
+// assembleA with one and with several threads. The three matrices are
+// compared through their product with a set of vectors. Last, the
+// elements are assembled through copies of their IDs, which setSize has
+// not seen, so that addA must locate each entry itself.
+//
+// The elements are formed through the BufferedElement interface into
+// one buffer per thread, so the form callback is safe to call
+// concurrently.
+//
+// Written: cmp
+//
+#include <stdio.h>
+#include <math.h>
+#include <array>
+
+#include <OPS_Globals.h>
+#include <StandardStream.h>
+
+#include <Matrix.h>
+#include <Vector.h>
+#include <ID.h>
+#include <Domain.h>
+#include <Node.h>
+#include <SP_Constraint.h>
+#include <LagrangeQuad.h>
+#include <ElasticIsotropic.h>
+#include <BufferedElement.h>
+
+#include <AnalysisModel.h>
+#include <FE_Element.h>
+#include <FE_EleIter.h>
+#include <PlainHandler.h>
+#include <PlainNumberer.h>
+#include <LoadControl.h>
+#include <Linear.h>
+#include <StaticAnalysis.h>
+#include <KrylovSolver.h>
+#include <SparseGenRowLinSOE.h>
+
+StandardStream sserr;
+OPS_Stream *opserrPtr = &sserr;
+
+using namespace OpenSees;
+
+static const int nx = 12;
+static const int ny = 12;
+
+static int
+nodeTag(int i, int j)
+{
+  return 1 + j*(nx+1) + i;
+}
+
+static void
+buildModel(Domain &theDomain, Mate<2> &material)
+{
+  for (int j=0; j<=ny; j++)
+    for (int i=0; i<=nx; i++)
+      theDomain.addNode(new Node(nodeTag(i,j), 2, 1.0*i, 0.5*j));
+
+  int tag = 1;
+  for (int j=0; j<ny; j++)
+    for (int i=0; i<nx; i++) {
+      std::array<int,4> nodes {nodeTag(i,j),   nodeTag(i+1,j),
+                               nodeTag(i+1,j+1), nodeTag(i,j+1)};
+      theDomain.addElement(new LagrangeQuad<4>(tag++, nodes, material, 1.0));
+    }
+
+  for (int i=0; i<=nx; i++)
+    for (int dof=0; dof<2; dof++)
+      theDomain.addSP_Constraint(new SP_Constraint(nodeTag(i,0), dof, 0.0, true));
+}
+
+// the product of A with a few vectors
+static Matrix
+product(SparseGenRowLinSOE &theSOE)
+{
+  const int n = theSOE.getNumEqn();
+  const int numVectors = 3;
+  Matrix AP(n, numVectors);
+  Vector p(n), Ap(n);
+  for (int k=0; k<numVectors; k++) {
+    for (int i=0; i<n; i++)
+      p(i) = sin(1.0 + i*(k+1)) + (k == 0 ? 1.0 : 0.0);
+    theSOE.formAp(p, Ap);
+    for (int i=0; i<n; i++)
+      AP(i,k) = Ap(i);
+  }
+  return AP;
+}
+
+static double
+difference(const Matrix &a, const Matrix &b)
+{
+  double diff = 0.0, size = 0.0;
+  for (int i=0; i<a.noRows(); i++)
+    for (int j=0; j<a.noCols(); j++) {
+      diff = fmax(diff, fabs(a(i,j) - b(i,j)));
+      size = fmax(size, fabs(a(i,j)));
+    }
+  return size > 0.0 ? diff/size : diff;
+}
+
+int
+main(int argc, char **argv)
+{
+  Domain theDomain;
+  ElasticIsotropic<2,PlaneType::Strain> material(1, 30000.0, 0.25, 0.0);
+  buildModel(theDomain, material);
+
+  AnalysisModel     *theModel      = new AnalysisModel();
+  EquiSolnAlgo      *theAlgorithm  = new Linear();
+  StaticIntegrator  *theIntegrator = new LoadControl(1.0, 1, 1.0, 1.0);
+  ConstraintHandler *theHandler    = new PlainHandler();
+  DOF_Numberer      *theNumberer   = new PlainNumberer();
+  KrylovSolver      *theSolver     = new KrylovSolver();
+  SparseGenRowLinSOE *theSOE       = new SparseGenRowLinSOE(*theSolver);
+
+  StaticAnalysis theAnalysis(theDomain, *theHandler, *theNumberer, *theModel,
+                             *theAlgorithm, *theSOE, *theIntegrator);
+
+  // number the equations, size the system and link it to the model
+  if (theAnalysis.domainChanged() < 0) {
+    fprintf(stderr, "FAILED: domainChanged\n");
+    return 1;
+  }
+
+  auto form = [](FE_Element &theFE) -> const Matrix & {
+    thread_local Matrix K(8,8);
+    BufferedElement *theEle = dynamic_cast<BufferedElement*>(theFE.getElement());
+    theEle->formTangentStiff(K);
+    return K;
+  };
+
+  // element by element, as the integrators assemble
+  theSOE->zeroA();
+  FE_EleIter &theEles = theModel->getFEs();
+  FE_Element *theFE;
+  while ((theFE = theEles()) != nullptr)
+    theSOE->addA(form(*theFE), theFE->getID());
+  const Matrix reference = product(*theSOE);
+
+  int failures = 0;
+  for (int numThreads : {1, 2, 4}) {
+    theSOE->setNumThreads(numThreads);
+    theSOE->zeroA();
+    if (theSOE->assembleA(form) < 0) {
+      fprintf(stderr, "FAILED: assembleA with %d threads\n", numThreads);
+      failures++;
+      continue;
+    }
+
+    // the sums at each entry may be formed in a different order
+    double diff = difference(reference, product(*theSOE));
+    if (diff > 1.0e-12) {
+      fprintf(stderr, "FAILED: %d threads, relative difference %g\n", numThreads, diff);
+      failures++;
+    }
+  }
+
+  theSOE->zeroA();
+  FE_EleIter &theCopies = theModel->getFEs();
+  while ((theFE = theCopies()) != nullptr) {
+    const ID id(theFE->getID());
+    theSOE->addA(form(*theFE), id);
+  }
+  double diff = difference(reference, product(*theSOE));
+  if (diff > 1.0e-12) {
+    fprintf(stderr, "FAILED: copied IDs, relative difference %g\n", diff);
+    failures++;
+  }
+
+  if (failures != 0)
+    return 1;
+
+  fprintf(stdout, "PASSED\n");
+  return 0;
+}
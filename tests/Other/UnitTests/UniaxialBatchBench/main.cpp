@@ -0,0 +1,205 @@
+//===----------------------------------------------------------------------===//
+//
+//        OpenSees - Open System for Earthquake Engineering Simulation
+//
+//===----------------------------------------------------------------------===//
+//
+// Description: This file contains a driver that measures the cost of the
+// trial update of the fibers of a section, done one fiber at a time with
+// OpenSees::setTrialEach, as the fiber sections do by default, and in runs
+// of fibers of the same class with OpenSees::setTrialBatch, as they do
+// after setBatchUpdate (section Fiber ... -batch).
+//
+// Each section is driven through cycles of curvature under a constant
+// axial strain. The mean time per section update of both paths is
+// printed with the final axial force and moment, which must agree.
+//
+//   uniaxialBatchBench ?cycles?
+//
+// Written: cmp
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+
+#include <UniaxialMaterial.h>
+#include <UniaxialBatch.h>
+#include <Steel02.h>
+#include <Concrete02.h>
+#include <ElasticPPMaterial.h>
+#include <HardeningMaterial.h>
+
+static const int    stepsPerCycle = 200;
+static const double axialStrain   = -0.0005;
+
+// The fibers of a section in the order they were added
+struct Section {
+  const char *name;
+  double depth;
+  std::vector<UniaxialMaterial *> materials;
+  std::vector<double> y, A;
+
+  void add(UniaxialMaterial &material, double yLoc, double area, int n = 1) {
+    for (int i = 0; i < n; i++) {
+      materials.push_back(material.getCopy());
+      y.push_back(yLoc);
+      A.push_back(area);
+    }
+  }
+
+  ~Section() {
+    for (UniaxialMaterial *material : materials)
+      delete material;
+  }
+};
+
+// Drive the fibers through the curvature cycles, updating them one at a
+// time or in batches. Returns the mean time per update in microseconds.
+static double
+run(Section &section, bool batch, int cycles, double &N, double &M)
+{
+  const int numFibers = section.materials.size();
+  UniaxialMaterial **materials = section.materials.data();
+  const double *y = section.y.data();
+  const double *A = section.A.data();
+
+  std::vector<char> same;
+  OpenSees::setBatchRuns(materials, 0, numFibers, same);
+
+  const double kappa = 0.012/section.depth;
+  const int steps = cycles*stepsPerCycle;
+  double time = 0.0;
+
+  for (int i = 1; i <= steps; i++) {
+    const double e0 = axialStrain*fmin(1.0, 10.0*i/stepsPerCycle);
+    const double k  = kappa*sin(2.0*M_PI*i/stepsPerCycle);
+    double kData[3] = {0.0, 0.0, 0.0};
+    N = M = 0.0;
+
+    auto strain = [&](int j) {
+      return e0 - y[j]*k;
+    };
+    auto accumulate = [&](int j, double stress, double tangent) {
+      const double ks = tangent*A[j];
+      kData[0] += ks;
+      kData[1] -= ks*y[j];
+      kData[2] += ks*y[j]*y[j];
+      N += stress*A[j];
+      M -= stress*A[j]*y[j];
+    };
+
+    auto begin = std::chrono::steady_clock::now();
+    if (batch)
+      OpenSees::setTrialBatch(materials, same, 0, numFibers, strain, accumulate);
+    else
+      OpenSees::setTrialEach(materials, 0, numFibers, strain, accumulate);
+    auto end = std::chrono::steady_clock::now();
+    time += std::chrono::duration<double, std::micro>(end - begin).count();
+
+    for (int j = 0; j < numFibers; j++)
+      materials[j]->commitState();
+  }
+
+  return time/steps;
+}
+
+static void
+compare(Section &reference, Section &batched, int cycles)
+{
+  double N0, M0, N1, M1;
+  const double t0 = run(reference, false, cycles, N0, M0);
+  const double t1 = run(batched,   true,  cycles, N1, M1);
+  printf("%-24s %8d %12.3f %12.3f %8.2f   %14.8e %14.8e\n", reference.name,
+         (int)reference.materials.size(), t0, t1, t0/t1, N1 - N0, M1 - M0);
+}
+
+// Reinforced concrete section, 24 x 12 in: unconfined cover, confined core
+// and two layers of bars, added patch by patch as the section command does
+static void
+concreteSection(Section &section)
+{
+  Concrete02 cover(1, -4.0, -0.002, -0.8, -0.006, 0.1, 0.5, 200.0);
+  Concrete02 core(2, -6.0, -0.004, -5.0, -0.014, 0.1, 0.6, 300.0);
+  Steel02 bar(3, 60.0, 29000.0, 0.01, 18.0, 0.925, 0.15);
+
+  const int nCore = 80, nCover = 8;
+  const double h = 24.0, b = 12.0, c = 2.0;
+  section.depth = h;
+  for (int i = 0; i < nCover; i++)
+    section.add(cover, h/2 - c*(i + 0.5)/nCover, b*c/nCover);
+  for (int i = 0; i < nCore; i++)
+    section.add(core, h/2 - c - (h - 2*c)*(i + 0.5)/nCore, (b - 2*c)*(h - 2*c)/nCore);
+  for (int i = 0; i < nCover; i++)
+    section.add(cover, -h/2 + c*(i + 0.5)/nCover, b*c/nCover);
+  section.add(bar,  h/2 - c, 0.79, 4);
+  section.add(bar, -h/2 + c, 0.79, 4);
+}
+
+// W-shape, 20 in deep, with flanges and web of a single steel
+static void
+steelSection(Section &section)
+{
+  Steel02 steel(4, 50.0, 29000.0, 0.003, 20.0, 0.925, 0.15);
+
+  const int nFlange = 8, nWeb = 64;
+  const double d = 20.0, bf = 8.0, tf = 0.8, tw = 0.45;
+  section.depth = d;
+  for (int i = 0; i < nFlange; i++)
+    section.add(steel, d/2 - tf*(i + 0.5)/nFlange, bf*tf/nFlange);
+  for (int i = 0; i < nWeb; i++)
+    section.add(steel, d/2 - tf - (d - 2*tf)*(i + 0.5)/nWeb, tw*(d - 2*tf)/nWeb);
+  for (int i = 0; i < nFlange; i++)
+    section.add(steel, -d/2 + tf*(i + 0.5)/nFlange, bf*tf/nFlange);
+}
+
+// Fibers alternating between two classes, so that every run holds one
+// fiber: the worst case of the batched update
+static void
+alternatingSection(Section &section)
+{
+  ElasticPPMaterial pp(5, 29000.0, 0.002);
+  HardeningMaterial hardening(6, 29000.0, 50.0, 0.0, 290.0);
+
+  const int n = 96;
+  const double d = 20.0;
+  section.depth = d;
+  for (int i = 0; i < n; i++) {
+    UniaxialMaterial &material = i % 2 ? (UniaxialMaterial &)hardening : (UniaxialMaterial &)pp;
+    section.add(material, d/2 - d*(i + 0.5)/n, 0.25);
+  }
+}
+
+
+int
+main(int argc, char **argv)
+{
+  int cycles = argc > 1 ? atoi(argv[1]) : 50;
+  if (cycles < 1)
+    cycles = 1;
+
+  printf("%-24s %8s %12s %12s %8s   %s\n", "section", "fibers",
+         "us/setTrial", "us/batch", "speedup", "final N and M, batch - setTrial");
+
+  {
+    Section reference{"Concrete02+Steel02"}, batched{"Concrete02+Steel02"};
+    concreteSection(reference);
+    concreteSection(batched);
+    compare(reference, batched, cycles);
+  }
+  {
+    Section reference{"Steel02"}, batched{"Steel02"};
+    steelSection(reference);
+    steelSection(batched);
+    compare(reference, batched, cycles);
+  }
+  {
+    Section reference{"ElasticPP/Hardening"}, batched{"ElasticPP/Hardening"};
+    alternatingSection(reference);
+    alternatingSection(batched);
+    compare(reference, batched, cycles);
+  }
+
+  return 0;
+}
@@ -0,0 +1,86 @@
+# Asynchronous Recorder Output - Planar Truss
+
+# The 3 bar truss of Truss/PlanarTruss.tcl, with a hardening material,
+# is loaded over a number of steps with the node, envelope, element and
+# drift recorders each writing the same output twice: directly, and
+# through -async with a ring small enough that the analysis has to wait
+# for the writer. The files written each way must be identical.
+
+puts "AsyncRecorder.tcl: Verification of the asynchronous recorder output"
+
+set testOK 0;    # variable used to keep track of SUCCESS or FAILURE
+set numSteps 40
+
+wipe
+model Basic -ndm 2 -ndf 2
+
+node 1    0.0    0.0
+node 2  115.47   0.0
+node 3  230.94   0.0
+node 4  115.47 -200.0
+
+fix 1 1 1
+fix 2 1 1
+fix 3 1 1
+
+uniaxialMaterial Hardening 1 3000.0 60.0 0.0 100.0
+element Truss 1 1 4 10.0 1
+element Truss 2 2 4 10.0 1
+element Truss 3 3 4 10.0 1
+
+timeSeries Linear 1
+pattern Plain 1 1 {
+    load 4 400.0 -800.0
+}
+
+numberer Plain
+constraints Plain
+algorithm Newton
+test NormDispIncr 1.0e-12 20
+system ProfileSPD
+integrator LoadControl [expr 1.0/$numSteps]
+analysis Static
+
+file mkdir async
+foreach {mode options} {sync {} async {-asyncRows 4}} {
+    recorder Node            {*}$options -file async/node.$mode    -time -node 4 -dof 1 2 disp
+    recorder Node            {*}$options -xml  async/node.xml.$mode -time -node 4 -dof 1 2 disp
+    recorder EnvelopeNode    {*}$options -file async/env.$mode     -time -node 4 -dof 1 2 disp
+    recorder Element         {*}$options -file async/ele.$mode     -time -ele 1 2 3 axialForce
+    recorder EnvelopeElement {*}$options -file async/envEle.$mode  -time -ele 1 2 3 axialForce
+    recorder Drift           {*}$options -file async/drift.$mode   -time -iNode 1 -jNode 4 -dof 1 -perpDirn 2
+}
+
+analyze $numSteps
+
+# destroy the recorders so that the files are flushed and closed
+remove recorders
+
+foreach name {node node.xml env ele envEle drift} {
+    foreach mode {sync async} {
+        set f [open async/$name.$mode r]
+        set content($mode) [read $f]
+        close $f
+    }
+    if {$content(sync) == ""} {
+        set testOK -1
+        puts "failed $name -> no output"
+    } elseif {$content(sync) != $content(async)} {
+        set testOK -1
+        puts "failed $name -> asynchronous output differs"
+    }
+    puts "    [format %-50s $name] [string length $content(async)] bytes"
+}
+
+file delete -force async
+wipe
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test AsyncRecorder.tcl \n\n"
+    puts $results "| PASSED |  AsyncRecorder.tcl"
+} else {
+    puts "\nFAILED Verification Test AsyncRecorder.tcl \n\n"
+    puts $results "FAILED : AsyncRecorder.tcl"
+}
+close $results
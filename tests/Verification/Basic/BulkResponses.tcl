@@ -0,0 +1,106 @@
+
+# Bulk Response Queries - Planar Truss
+
+# The responses of all nodes and elements of the 3 bar truss of
+# Truss/PlanarTruss.tcl, queried at once with nodeResponses and
+# eleResponses, are compared with those of nodeDisp and eleResponse.
+
+puts "BulkResponses.tcl: Verification of the bulk node and element response queries"
+
+set testOK 0;    # variable used to keep track of SUCCESS or FAILURE
+set tol 1.0e-12
+
+wipe
+model Basic -ndm 2 -ndf 2
+
+node 1    0.0    0.0
+node 2  115.47   0.0
+node 3  230.94   0.0
+node 4  115.47 -200.0
+
+fix 1 1 1
+fix 2 1 1
+fix 3 1 1
+
+uniaxialMaterial Elastic 1 3000.0
+element Truss 1 1 4 10.0 1
+element Truss 2 2 4 10.0 1
+element Truss 3 3 4 10.0 1
+
+timeSeries Linear 1
+pattern Plain 1 1 {
+    load 4 0. -200.0
+}
+
+numberer Plain
+constraints Plain
+algorithm Linear
+system ProfileSPD
+integrator LoadControl 1.0
+analysis Static
+analyze 1
+
+# procedure to compare two lists of values
+proc compareValues {name values expected} {
+    global tol testOK
+    if {[llength $values] != [llength $expected]} {
+        set testOK -1
+        puts "failed $name -> [llength $values] values, expected [llength $expected]"
+        return
+    }
+    foreach value $values exact $expected {
+        if {abs($value-$exact) > $tol*(1.0+abs($exact))} {
+            set testOK -1
+            puts "failed $name -> $value != $exact"
+        }
+    }
+    puts "    [format %-50s $name] [llength $values] values"
+}
+
+set nodes {1 2 3 4}
+set elements {1 2 3}
+
+set disp {}
+set dispY {}
+foreach node $nodes {
+    lappend disp {*}[nodeDisp $node]
+    lappend dispY [nodeDisp $node 2]
+}
+
+reactions
+set react {}
+foreach node $nodes {
+    lappend react {*}[nodeReaction $node]
+}
+
+set forces {}
+foreach ele $elements {
+    lappend forces {*}[eleResponse $ele axialForce]
+}
+
+compareValues "nodeResponses disp"           [nodeResponses $nodes disp] $disp
+compareValues "nodeResponses disp -dof 2"    [nodeResponses $nodes disp -dof 2] $dispY
+compareValues "nodeResponses reaction"       [nodeResponses $nodes reaction] $react
+compareValues "eleResponses axialForce"      [eleResponses $elements axialForce] $forces
+
+binary scan [nodeResponses $nodes disp -binary] d* values
+compareValues "nodeResponses disp -binary"   $values $disp
+binary scan [eleResponses $elements -binary axialForce] d* values
+compareValues "eleResponses -binary axialForce" $values $forces
+
+if {![catch {nodeResponses {1 99} disp}]} {
+    set testOK -1
+    puts "failed nodeResponses -> missing node not reported"
+}
+
+wipe
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test BulkResponses.tcl \n\n"
+    puts $results "| PASSED |  BulkResponses.tcl"
+} else {
+    puts "\nFAILED Verification Test BulkResponses.tcl \n\n"
+    puts $results "FAILED : BulkResponses.tcl"
+}
+close $results
@@ -0,0 +1,154 @@
+# Columnar Recorder Output - Planar Truss
+
+# The displacements of the loaded node of the 3 bar truss of
+# Truss/PlanarTruss.tcl are recorded over a number of load steps both
+# as text and with -columnar, in double and single precision and with
+# chunks written directly and by a writer thread. The columnar files
+# are read back and compared, value by value, with the text output.
+
+puts "ColumnarRecorder.tcl: Verification of the columnar recorder output"
+
+set testOK 0;    # variable used to keep track of SUCCESS or FAILURE
+set numSteps 25
+
+wipe
+model Basic -ndm 2 -ndf 2
+
+node 1    0.0    0.0
+node 2  115.47   0.0
+node 3  230.94   0.0
+node 4  115.47 -200.0
+
+fix 1 1 1
+fix 2 1 1
+fix 3 1 1
+
+uniaxialMaterial Elastic 1 3000.0
+element Truss 1 1 4 10.0 1
+element Truss 2 2 4 10.0 1
+element Truss 3 3 4 10.0 1
+
+timeSeries Linear 1
+pattern Plain 1 1 {
+    load 4 100.0 -200.0
+}
+
+numberer Plain
+constraints Plain
+algorithm Linear
+system ProfileSPD
+integrator LoadControl [expr 1.0/$numSteps]
+analysis Static
+
+file mkdir columnar
+recorder Node -file     columnar/node.out   -precision 17 -time -node 4 -dof 1 2 disp
+recorder Node -columnar columnar/node64.col -buffer 4 -time -node 4 -dof 1 2 disp
+recorder Node -columnar columnar/node32.col -buffer 3 -float32 -writerThread -time -node 4 -dof 1 2 disp
+
+# options of the columnar stream are rejected for other streams
+foreach option {-float32 -writerThread} {
+    if {![catch {recorder Node -file columnar/bad.out $option -node 4 -dof 1 disp}]} {
+        set testOK -1
+        puts "failed recorder -file $option -> not reported"
+    }
+}
+
+analyze $numSteps
+
+# destroy the recorders so that the files are flushed and closed
+remove recorders
+
+# read a columnar file; returns the schema and a list of columns
+proc readColumnar {fileName} {
+    set f [open $fileName rb]
+    set data [read $f]
+    close $f
+
+    binary scan $data A8nnnnm magic version width numColumns chunkRows length
+    if {$magic != "XARACOL" || $version != 1} {
+        error "$fileName is not a columnar file"
+    }
+    set pos 32
+    set schema [string range $data $pos [expr {$pos+$length-1}]]
+    incr pos $length
+
+    set format [expr {$width == 4 ? "r" : "q"}]
+    for {set j 0} {$j < $numColumns} {incr j} {
+        set column($j) {}
+    }
+    while {$pos < [string length $data]} {
+        binary scan $data @${pos}n numRows
+        incr pos 4
+        for {set j 0} {$j < $numColumns} {incr j} {
+            binary scan $data @${pos}${format}${numRows} values
+            lappend column($j) {*}$values
+            incr pos [expr {$numRows*$width}]
+        }
+    }
+
+    set columns {}
+    for {set j 0} {$j < $numColumns} {incr j} {
+        lappend columns $column($j)
+    }
+    return [list $schema $columns]
+}
+
+# the text output, as a list of columns
+set f [open columnar/node.out r]
+set rows [split [string trim [read $f]] "\n"]
+close $f
+set expected {{} {} {}}
+foreach row $rows {
+    foreach j {0 1 2} value $row {
+        lset expected $j [concat [lindex $expected $j] $value]
+    }
+}
+if {[llength $rows] != $numSteps} {
+    set testOK -1
+    puts "failed node.out -> [llength $rows] rows, expected $numSteps"
+}
+
+foreach {file tol} {node64.col 1.0e-15 node32.col 1.0e-6} {
+    lassign [readColumnar columnar/$file] schema columns
+
+    # one column for the time and one for each dof of node 4
+    foreach pattern {{*"name":"time"*} {*"nodeTag":4*}} {
+        if {![string match $pattern $schema]} {
+            set testOK -1
+            puts "failed $file -> schema does not match $pattern"
+        }
+    }
+
+    if {[llength $columns] != 3} {
+        set testOK -1
+        puts "failed $file -> [llength $columns] columns, expected 3"
+        continue
+    }
+    foreach column $columns exact $expected {
+        if {[llength $column] != [llength $exact]} {
+            set testOK -1
+            puts "failed $file -> [llength $column] rows, expected [llength $exact]"
+            continue
+        }
+        foreach value $column ref $exact {
+            if {abs($value-$ref) > $tol*(1.0+abs($ref))} {
+                set testOK -1
+                puts "failed $file -> $value != $ref"
+            }
+        }
+    }
+    puts "    [format %-50s $file] [llength [lindex $columns 0]] rows"
+}
+
+file delete -force columnar
+wipe
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test ColumnarRecorder.tcl \n\n"
+    puts $results "| PASSED |  ColumnarRecorder.tcl"
+} else {
+    puts "\nFAILED Verification Test ColumnarRecorder.tcl \n\n"
+    puts $results "FAILED : ColumnarRecorder.tcl"
+}
+close $results
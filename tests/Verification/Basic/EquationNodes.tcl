@@ -0,0 +1,101 @@
+
+# Equation to Node Map - Portal Frame
+
+# The nodes and dofs returned by equationNodes for every equation of a
+# portal frame are compared with the equation numbers reported by
+# nodeDOFs, once with the Plain numberer and again after renumbering
+# with RCM.
+
+puts "EquationNodes.tcl: Verification of the equation to node map"
+
+set testOK 0;    # variable used to keep track of SUCCESS or FAILURE
+
+wipe
+model Basic -ndm 2 -ndf 3
+
+node 1   0.0   0.0
+node 2 360.0   0.0
+node 3   0.0 144.0
+node 4 360.0 144.0
+node 5 180.0 144.0
+
+fix 1 1 1 1
+fix 2 1 1 0
+
+geomTransf Linear 1
+element elasticBeamColumn 1 1 3 20.0 29000.0 1400.0 1
+element elasticBeamColumn 2 2 4 20.0 29000.0 1400.0 1
+element elasticBeamColumn 3 3 5 20.0 29000.0 1400.0 1
+element elasticBeamColumn 4 5 4 20.0 29000.0 1400.0 1
+
+timeSeries Linear 1
+pattern Plain 1 1 {
+    load 3 10.0 0.0 0.0
+    load 5 0.0 -20.0 0.0
+}
+
+constraints Plain
+algorithm Linear
+system ProfileSPD
+integrator LoadControl 1.0
+analysis Static
+
+# procedure to check equationNodes against nodeDOFs for all equations
+proc checkEquations {numberer} {
+    global testOK
+
+    set map [dict create]
+    foreach node [getNodeTags] {
+        set dof 1
+        foreach eqn [nodeDOFs $node] {
+            if {$eqn >= 0} {
+                dict set map $eqn [list $node $dof]
+            }
+            incr dof
+        }
+    }
+
+    set numEqn [systemSize]
+    set eqns {}
+    set pairs {}
+    for {set eqn 0} {$eqn < $numEqn} {incr eqn} {
+        lappend eqns $eqn
+        lappend pairs {*}[dict get $map $eqn]
+    }
+
+    set result [equationNodes $eqns]
+    if {$result != $pairs} {
+        set testOK -1
+        puts "failed $numberer -> $result != $pairs"
+    }
+    if {[equationNodes {*}$eqns] != $result} {
+        set testOK -1
+        puts "failed $numberer -> separate arguments differ from a list"
+    }
+    puts "    [format %-10s $numberer] $numEqn equations"
+}
+
+numberer Plain
+analyze 1
+checkEquations Plain
+
+numberer RCM
+analyze 1
+checkEquations RCM
+
+if {![catch {equationNodes [systemSize]}]} {
+    set testOK -1
+    puts "failed equationNodes -> equation out of range not reported"
+}
+
+wipe
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test EquationNodes.tcl \n\n"
+    puts $results "| PASSED |  EquationNodes.tcl"
+} else {
+    puts "\nFAILED Verification Test EquationNodes.tcl \n\n"
+    puts $results "FAILED : EquationNodes.tcl"
+}
+close $results
@@ -0,0 +1,104 @@
+# Equation Ordering - Plane Strain Strip
+
+# A strip of 40 x 4 plane strain quads, fixed at one end, is loaded at
+# the other. Its nodes are numbered along the strip, so with the plain
+# numberer the profile and band of A span a whole row of nodes. The
+# ProfileSPD and BandSPD systems reorder their equations with reverse
+# Cuthill-McKee, Sloan and the automatic choice between them. Each must
+# give the displacements of the unordered system, and systemStats must
+# report the ordering applied and a stored size of A below the original.
+# The automatic choice must store no more than either ordering.
+
+puts "EquationOrdering.tcl: Verification of the profile and band equation ordering"
+
+set testOK 0;    # variable used to keep track of SUCCESS or FAILURE
+set tol 1.0e-10
+
+# build and analyze the strip with the given system; returns the
+# displacements of all the nodes and the systemStats
+proc runStrip {system} {
+    wipe
+    model Basic -ndm 2 -ndf 2
+
+    nDMaterial ElasticIsotropic 1 1000.0 0.25
+
+    set nx 40
+    set ny 4
+    block2D $nx $ny 1 1 quad "1 PlaneStrain2D 1" {
+        1   0.0   0.0
+        2  40.0   0.0
+        3  40.0   4.0
+        4   0.0   4.0
+    }
+    fixX 0.0 1 1
+
+    timeSeries Linear 1
+    pattern Plain 1 1 {
+        load [expr $nx+1]            0.0  -1.0
+        load [expr ($nx+1)*($ny+1)]  0.0  -1.0
+    }
+
+    numberer Plain
+    constraints Plain
+    algorithm Linear
+    system {*}$system
+    integrator LoadControl 1.0
+    analysis Static
+    analyze 1
+
+    set disp {}
+    foreach node [getNodeTags] {
+        lappend disp {*}[nodeDisp $node]
+    }
+    return [list $disp [systemStats]]
+}
+
+foreach type {ProfileSPD BandSPD} {
+    lassign [runStrip [list $type -reorder none]] reference stats
+    if {[dict get $stats ordering] != "None" ||
+        [dict get $stats storedSize] != [dict get $stats originalSize]} {
+        set testOK -1
+        puts "failed $type -reorder none -> $stats"
+    }
+    set original [dict get $stats originalSize]
+
+    set sizes {}
+    foreach {method applied} {RCM RCM Sloan Sloan auto {RCM Sloan}} {
+        lassign [runStrip [list $type -reorder $method]] disp stats
+        set stored [dict get $stats storedSize]
+        dict set sizes $method $stored
+        puts "    [format %-50s "$type -reorder $method"] $original -> $stored"
+
+        foreach value $disp exact $reference {
+            if {abs($value-$exact) > $tol*(1.0+abs($exact))} {
+                set testOK -1
+                puts "failed $type -reorder $method -> displacement $value != $exact"
+                break
+            }
+        }
+        if {[lsearch -exact $applied [dict get $stats ordering]] < 0} {
+            set testOK -1
+            puts "failed $type -reorder $method -> ordering [dict get $stats ordering] applied"
+        }
+        if {[dict get $stats originalSize] != $original || $stored >= $original} {
+            set testOK -1
+            puts "failed $type -reorder $method -> stored size $stored of $original"
+        }
+    }
+    if {[dict get $sizes auto] > min([dict get $sizes RCM], [dict get $sizes Sloan])} {
+        set testOK -1
+        puts "failed $type -reorder auto -> $sizes"
+    }
+}
+
+wipe
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test EquationOrdering.tcl \n\n"
+    puts $results "| PASSED |  EquationOrdering.tcl"
+} else {
+    puts "\nFAILED Verification Test EquationOrdering.tcl \n\n"
+    puts $results "FAILED : EquationOrdering.tcl"
+}
+close $results
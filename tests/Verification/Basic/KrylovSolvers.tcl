@@ -0,0 +1,83 @@
+
+# Krylov Solvers - Linear Brick Cantilever
+
+# The tip displacement of a cantilever of stdBrick elements found with
+# each iterative solver and preconditioner is compared with the one found
+# by the direct ProfileSPD solver.
+
+puts "KrylovSolvers.tcl: Verification of the iterative solvers on a brick cantilever"
+
+set testOK 0;    # variable used to keep track of SUCCESS or FAILURE
+set tol 1.0e-6
+
+set systems {
+  {Krylov -solver cg       -pre jacobi}
+  {Krylov -solver cg       -pre blockjacobi -blockSize 3}
+  {Krylov -solver cg       -pre ic0}
+  {Krylov -solver cg       -pre amg         -blockSize 3}
+  {Krylov -solver minres   -pre amg         -blockSize 3}
+  {Krylov -solver gmres    -pre ilu0        -restart 30}
+  {Krylov -solver bicgstab -pre ilu0}
+}
+
+# procedure to build and analyze the cantilever, returning the
+# displacement of the tip node along x
+proc solveCantilever {system} {
+    wipe
+    model basic -ndm 3 -ndf 3
+
+    nDMaterial ElasticIsotropic 1 1000.0 0.3
+
+    block3D 2 2 12 1 1 stdBrick 1 {
+        1  0.0 0.0 0.0
+        2  1.0 0.0 0.0
+        3  1.0 1.0 0.0
+        4  0.0 1.0 0.0
+        5  0.0 0.0 6.0
+        6  1.0 0.0 6.0
+        7  1.0 1.0 6.0
+        8  0.0 1.0 6.0
+    }
+    fixZ 0.0 1 1 1
+
+    set tip [expr 3*3*13]
+    pattern Plain 1 Linear {
+        load $tip 1.0 0.0 0.0
+    }
+
+    numberer RCM
+    constraints Plain
+    algorithm Linear
+    system {*}$system -tol 1.0e-12
+    integrator LoadControl 1.0
+    analysis Static
+    analyze 1
+
+    return [nodeDisp $tip 1]
+}
+
+set exact [solveCantilever ProfileSPD]
+
+set formatString {%45s%15s%15s}
+puts "    [format $formatString System OpenSees ProfileSPD]"
+set formatString {%45s%15.8f%15.8f}
+foreach system $systems {
+    set disp [solveCantilever $system]
+    puts "    [format $formatString $system $disp $exact]"
+    if {[expr abs($disp-$exact)] > $tol*abs($exact)} {
+        set testOK -1;
+        puts "failed $system -> [expr abs($disp-$exact)] > [expr $tol*abs($exact)]"
+    }
+}
+
+wipe
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test KrylovSolvers.tcl \n\n"
+    puts $results "| PASSED |  KrylovSolvers.tcl"
+} else {
+    puts "\nFAILED Verification Test KrylovSolvers.tcl \n\n"
+    puts $results "FAILED : KrylovSolvers.tcl"
+}
+close $results
@@ -0,0 +1,92 @@
+# Matrix-Free System - Transient Shell Plate
+
+# A cantilever plate of ASDShellQ4 elements is loaded suddenly at its tip
+# and analyzed with the Newmark integrator, first with one time step and
+# then with another. The matrix-free system must follow the factors of
+# the integrator when the step changes, and must fall back to the serial
+# products for the shells since ElasticMembranePlateSection is not
+# reentrant. The tip history is compared with the one found by the direct
+# ProfileSPD solver.
+
+puts "MatrixFreeSystem.tcl: Verification of the matrix-free system in a transient analysis"
+
+set testOK 0;    # variable used to keep track of SUCCESS or FAILURE
+set tol 1.0e-6
+
+# procedure to build and analyze the plate, returning the deflection of
+# the tip node after each step
+proc runPlate {system} {
+    wipe
+    model basic -ndm 3 -ndf 6
+
+    section ElasticMembranePlateSection 1 1000.0 0.3 0.1 1.0
+
+    block2D 8 2 1 1 ASDShellQ4 1 {
+        1  0.0 0.0 0.0
+        2  6.0 0.0 0.0
+        3  6.0 1.0 0.0
+        4  0.0 1.0 0.0
+    }
+    fixX 0.0 1 1 1 1 1 1
+
+    set tip 9
+    pattern Plain 1 "Constant" {
+        load $tip 0.0 0.0 1.0e-3 0.0 0.0 0.0
+    }
+
+    numberer RCM
+    constraints Plain
+    algorithm Linear
+    system {*}$system
+    integrator Newmark 0.5 0.25
+    analysis Transient
+
+    set history {}
+    foreach dt {2.0 0.5} {
+        for {set i 0} {$i < 10} {incr i} {
+            if {[analyze 1 $dt] != 0} {
+                return {}
+            }
+            lappend history [nodeDisp $tip 3]
+        }
+    }
+    return $history
+}
+
+set exact [runPlate ProfileSPD]
+set found [runPlate {MatrixFree -solver cg -pre blockjacobi -blockSize 6 -threads 4 -tol 1.0e-12 -maxIter 5000}]
+
+set scale 0.0
+foreach u $exact {
+    set scale [expr max($scale, abs($u))]
+}
+
+set formatString {%10s%15s%15s}
+puts "    [format $formatString Step MatrixFree ProfileSPD]"
+set formatString {%10d%15.8f%15.8f}
+if {[llength $found] != [llength $exact]} {
+    set testOK -1;
+    puts "failed MatrixFree -> analysis failed after [llength $found] steps"
+} else {
+    set step 0
+    foreach u $found ue $exact {
+        incr step
+        puts "    [format $formatString $step $u $ue]"
+        if {[expr abs($u-$ue)] > $tol*$scale} {
+            set testOK -1;
+            puts "failed step $step -> [expr abs($u-$ue)] > [expr $tol*$scale]"
+        }
+    }
+}
+
+wipe
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test MatrixFreeSystem.tcl \n\n"
+    puts $results "| PASSED |  MatrixFreeSystem.tcl"
+} else {
+    puts "\nFAILED Verification Test MatrixFreeSystem.tcl \n\n"
+    puts $results "FAILED : MatrixFreeSystem.tcl"
+}
+close $results
@@ -142,17 +142,21 @@ set integratorCmd "integrator Newmark 0.5 0.25"
 
 set algorithmCmds {
     "Newton" "algorithm Newton" 
-    "Modified Newton"     "algorithm ModifiedNewton"}
+    "Modified Newton"     "algorithm ModifiedNewton"
+    "Adaptive Newton"     "algorithm AdaptiveNewton"}
 
 set resultsD {
     {0.0437 0.2326 0.6121 1.1143 1.6214 1.9891 2.0951 1.9240 1.5602 1.415}
-    {0.0437 0.2326 0.6121 1.1143 1.6214 1.9891 2.0951 1.9240 1.5602 1.414}}
+    {0.0437 0.2326 0.6121 1.1143 1.6214 1.9891 2.0951 1.9240 1.5602 1.414}
+    {0.0437 0.2326 0.6121 1.1143 1.6214 1.9891 2.0951 1.9240 1.5602 1.415}}
 set resultsV {
     {0.8733 2.9057 4.6833 5.3624 4.7792 2.5742 -0.4534 -2.960 -4.3075 -4.0668}
-    {0.8733 2.9057 4.6833 5.3623 4.7791 2.5741 -0.4534 -2.960 -4.3076 -4.0668}}
+    {0.8733 2.9057 4.6833 5.3623 4.7791 2.5741 -0.4534 -2.960 -4.3076 -4.0668}
+    {0.8733 2.9057 4.6833 5.3624 4.7792 2.5742 -0.4534 -2.960 -4.3075 -4.0668}}
 set resultsA {
     {17.4666 23.1801 12.3719 1.2103 -12.8735 -31.2270 -29.3242 -20.9876 -5.7830 10.5962}
-    {17.4666 23.1801 12.3719 1.2095 -12.8734 -31.2270 -29.3242 -20.9879 -5.7824 10.5969}}
+    {17.4666 23.1801 12.3719 1.2095 -12.8734 -31.2270 -29.3242 -20.9879 -5.7824 10.5969}
+    {17.4666 23.1801 12.3719 1.2103 -12.8735 -31.2270 -29.3242 -20.9876 -5.7830 10.5962}}
 
 
 set count 0
@@ -183,8 +187,10 @@ foreach {algoName algoCmd} $algorithmCmds {
     buildAnalysis $integratorCmd $algoCmd
 
     # perform analysis, checking at every step
+    set numIterations 0
     for {set i 0} {$i< 9} {incr i 1} {
         analyze 1 0.1
+        incr numIterations [testIter]
         set tCurrent [getTime]
         set uOpenSees [nodeDisp 2 0]
         set uComputed [lindex $resultD $i]
@@ -201,9 +207,24 @@ foreach {algoName algoCmd} $algorithmCmds {
             puts [ format $formatString $uOpenSees $uComputed $vOpenSees $vComputed $aOpenSees $aComputed]
         }
     }
+    set iterations([lindex $algoCmd 1]) $numIterations
+    if {[lindex $algoCmd 1] == "AdaptiveNewton"} {
+        set factorizations [numFact]
+    }
     incr count
 }
 
+# Newton factors the tangent once in every iteration, while AdaptiveNewton
+# keeps it across iterations and steps while the system stays elastic
+puts "\n - tangent reuse"
+puts "    Newton: $iterations(Newton) factorizations"
+puts "    AdaptiveNewton: $factorizations factorizations in $iterations(AdaptiveNewton) iterations"
+if {$factorizations < 1 || $factorizations > $iterations(AdaptiveNewton)
+    || $factorizations >= $iterations(Newton)} {
+    set testOK -1;
+    puts "failed  AdaptiveNewton formed $factorizations tangents, Newton formed $iterations(Newton)"
+}
+
 set results [open README.md a+]
 if {$testOK == 0} {
     puts "\nPASSED Verification Test NewmarkIntegrator.tcl \n\n"
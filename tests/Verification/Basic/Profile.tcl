@@ -0,0 +1,145 @@
+# Analysis Profiler - Planar Truss
+
+# The 3 bar truss of Truss/PlanarTruss.tcl, with a hardening material,
+# is loaded over a number of steps with AdaptiveNewton while the
+# profiler is running. The dictionary returned by "profile dump -dict"
+# must hold the phases of each step: the algorithm's tangent, state
+# determination, unbalance and convergence test, and the factorization
+# and triangular solves of the direct solver, with consistent counts.
+# The matrix-free system, which applies the tangent element by element,
+# must report the time of each element class. Nothing may be recorded
+# while the profiler is stopped, and reset must clear the phases.
+
+puts "Profile.tcl: Verification of the profile command"
+
+set testOK 0;    # variable used to keep track of SUCCESS or FAILURE
+set numSteps 10
+
+# build the truss for the given system and algorithm
+proc buildTruss {system algorithm} {
+    wipe
+    model Basic -ndm 2 -ndf 2
+
+    node 1    0.0    0.0
+    node 2  115.47   0.0
+    node 3  230.94   0.0
+    node 4  115.47 -200.0
+
+    fix 1 1 1
+    fix 2 1 1
+    fix 3 1 1
+
+    uniaxialMaterial Hardening 1 3000.0 60.0 0.0 100.0
+    element Truss 1 1 4 10.0 1
+    element Truss 2 2 4 10.0 1
+    element Truss 3 3 4 10.0 1
+
+    timeSeries Linear 1
+    pattern Plain 1 1 {
+        load 4 400.0 -800.0
+    }
+
+    numberer Plain
+    constraints Plain
+    algorithm {*}$algorithm
+    test NormDispIncr 1.0e-10 50
+    system {*}$system
+    integrator LoadControl [expr 1.0/$::numSteps]
+    analysis Static
+}
+
+# the count of the phase at the given path, 0 if it was not entered
+proc phaseCount {profile path} {
+    set phases [dict get $profile phases]
+    foreach name $path {
+        if {![dict exists $phases $name]} {
+            return 0
+        }
+        set phase [dict get $phases $name]
+        set phases [dict get $phase children]
+    }
+    return [dict get $phase count]
+}
+
+proc check {condition message} {
+    if {![uplevel 1 [list expr $condition]]} {
+        set ::testOK -1
+        puts "failed $message"
+    }
+}
+
+profile reset
+profile start
+buildTruss ProfileSPD {AdaptiveNewton -maxRate 0.5}
+analyze $numSteps
+profile stop
+
+set profile [profile dump -dict]
+set step {step solveCurrentStep}
+set counts {}
+foreach path [list {step} \
+                   [concat $step formTangent] \
+                   [concat $step update] \
+                   [concat $step formUnbalance] \
+                   [concat $step test] \
+                   [concat $step solve] \
+                   [concat $step solve factor] \
+                   [concat $step solve substitute]] {
+    set count [phaseCount $profile $path]
+    dict set counts [lindex $path end] $count
+    puts "    [format %-50s [join $path /]] $count"
+}
+
+check {[dict get $counts step] == $numSteps} "step count"
+foreach phase {formTangent update formUnbalance test factor substitute} {
+    check {[dict get $counts $phase] > 0} "$phase -> not timed"
+}
+# one state determination, unbalance and test per solve
+foreach phase {update formUnbalance test} {
+    check {[dict get $counts $phase] == [dict get $counts solve]} "$phase count"
+}
+# the tangent is factored once after each time it is formed
+check {[dict get $counts factor] == [dict get $counts formTangent]} "factor count"
+check {[dict get $counts factor] + [dict get $counts substitute] >= [dict get $counts solve]} "substitute count"
+
+# a stopped profiler records nothing
+analyze 1
+set after [profile dump -dict]
+check {[phaseCount $after step] == $numSteps} "stop -> step recorded after stop"
+
+# the table names the phases
+file mkdir profile
+profile dump -file profile/table.txt
+set f [open profile/table.txt r]
+set table [read $f]
+close $f
+file delete -force profile
+foreach phase {step solveCurrentStep test factor} {
+    check {[string first $phase $table] >= 0} "dump -file -> no $phase in the table"
+}
+
+# element classes are timed by the matrix-free system
+profile reset
+check {[dict size [dict get [profile dump -dict] phases]] == 0} "reset -> phases remain"
+profile start
+buildTruss {MatrixFree -solver cg -pre jacobi -tol 1.0e-12} Newton
+analyze $numSteps
+profile stop
+set classes [dict get [profile dump -dict] classes]
+check {[dict size $classes] > 0} "classes -> no element class timed"
+dict for {name stats} $classes {
+    puts "    [format %-50s $name] [dict get $stats count]"
+}
+
+profile reset
+wipe
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test Profile.tcl \n\n"
+    puts $results "| PASSED |  Profile.tcl"
+} else {
+    puts "\nFAILED Verification Test Profile.tcl \n\n"
+    puts $results "FAILED : Profile.tcl"
+}
+close $results
@@ -0,0 +1,97 @@
+# Threaded Profile Solver - Plane Strain Wall
+
+# A wall of 60 x 30 plane strain quads, fixed at its base, is pushed
+# laterally and vertically at its top corners. The nodes are numbered row
+# by row and not reordered, so the columns of the profile are over 120
+# terms high. That is more than the 64 columns below which the threaded
+# solver updates a panel serially, so its pooled path is taken. The
+# displacements of every node must match those of the serial
+# ProfileSPDLinDirectSolver, with the whole pool, with two threads and
+# with a small block size.
+
+puts "ProfileThread.tcl: Verification of the threaded ProfileSPD solver"
+
+set testOK 0;    # variable used to keep track of SUCCESS or FAILURE
+set tol 1.0e-10
+
+# build and analyze the wall with the given system; returns the
+# displacements of all the nodes
+proc runWall {system} {
+    wipe
+    model Basic -ndm 2 -ndf 2
+
+    nDMaterial ElasticIsotropic 1 1000.0 0.25
+
+    set nx 60
+    set ny 30
+    block2D $nx $ny 1 1 quad "1 PlaneStrain2D 1" {
+        1   0.0   0.0
+        2  60.0   0.0
+        3  60.0  30.0
+        4   0.0  30.0
+    }
+    fixY 0.0 1 1
+
+    set top [expr ($nx+1)*($ny+1)]
+    timeSeries Linear 1
+    pattern Plain 1 1 {
+        load $top               10.0  -5.0
+        load [expr $top - $nx]  10.0  -5.0
+    }
+
+    numberer Plain
+    constraints Plain
+    algorithm Linear
+    system {*}$system
+    integrator LoadControl 0.5
+    analysis Static
+    analyze 2
+
+    set disp {}
+    foreach node [getNodeTags] {
+        lappend disp {*}[nodeDisp $node]
+    }
+    return $disp
+}
+
+set reference [runWall {ProfileSPD -reorder none}]
+
+foreach system {
+    {ProfileSPD -Thread -reorder none}
+    {ProfileSPD -Thread 2 -reorder none}
+    {ProfileSPD -Thread -blockSize 16 -reorder none}
+} {
+    set disp [runWall $system]
+    set maxError 0.0
+    foreach value $disp exact $reference {
+        set error [expr abs($value-$exact)/(1.0+abs($exact))]
+        if {$error > $maxError} {
+            set maxError $error
+        }
+    }
+    puts "    [format %-50s $system] [format %.3e $maxError]"
+    if {[llength $disp] != [llength $reference] || $maxError > $tol} {
+        set testOK -1
+        puts "failed $system -> displacements differ from the serial solver"
+    }
+}
+
+# unknown options are rejected
+wipe
+model Basic -ndm 2 -ndf 2
+if {![catch {system ProfileSPD -Thread -blocksize 16}]} {
+    set testOK -1
+    puts "failed unknown option -> accepted"
+}
+
+wipe
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test ProfileThread.tcl \n\n"
+    puts $results "| PASSED |  ProfileThread.tcl"
+} else {
+    puts "\nFAILED Verification Test ProfileThread.tcl \n\n"
+    puts $results "FAILED : ProfileThread.tcl"
+}
+close $results
@@ -0,0 +1,141 @@
+# SuperLU Pattern Reuse - Planar Truss
+
+# Two free nodes, each supported by 3 bars, are loaded over a number of
+# steps while elements are added to the model. An element parallel to
+# an existing one changes the domain but not the sparsity pattern of A,
+# so SuperLU must keep its ordering; an element joining the two free
+# nodes changes the pattern, so SuperLU must order A again. The
+# counters reported by systemStats are checked after each step and the
+# displacements are compared with those of the ProfileSPD system. In
+# mixed precision mode A is factored in single precision and the solution
+# refined against the double precision A; it must match the double
+# precision displacements to the refinement tolerance, without falling
+# back to a double precision factorization.
+
+puts "SuperLU.tcl: Verification of the SuperLU ordering reuse"
+
+set testOK 0;    # variable used to keep track of SUCCESS or FAILURE
+set tol 1.0e-10
+
+# build and analyze the model with the given system; returns the
+# displacements and systemStats after each step
+proc runTruss {system} {
+    wipe
+    model Basic -ndm 2 -ndf 2
+
+    node 1    0.0    0.0
+    node 2  115.47   0.0
+    node 3  230.94   0.0
+    node 4  115.47 -200.0
+    node 5  230.94 -200.0
+
+    fix 1 1 1
+    fix 2 1 1
+    fix 3 1 1
+
+    uniaxialMaterial Elastic 1 3000.0
+    element Truss 1 1 4 10.0 1
+    element Truss 2 2 4 10.0 1
+    element Truss 3 3 4 10.0 1
+    element Truss 4 1 5 10.0 1
+    element Truss 5 2 5 10.0 1
+    element Truss 6 3 5 10.0 1
+
+    timeSeries Linear 1
+    pattern Plain 1 1 {
+        load 4 100.0 -200.0
+        load 5 -50.0 -100.0
+    }
+
+    numberer Plain
+    constraints Plain
+    algorithm Linear
+    system {*}$system
+    integrator LoadControl 0.25
+    analysis Static
+
+    set steps {}
+    foreach change {
+        {}
+        {element Truss 7 1 4 5.0 1}
+        {}
+        {element Truss 8 4 5 5.0 1}
+        {}
+    } {
+        eval $change
+        analyze 1
+        lappend steps [list [concat [nodeDisp 4] [nodeDisp 5]] [systemStats]]
+    }
+    return $steps
+}
+
+set reference [runTruss ProfileSPD]
+set superlu   [runTruss SuperLU]
+
+# expected increase of {symbolic reused} at each step; the first
+# step orders A at least once
+set expected {{0 0} {0 1} {0 0} {1 0} {0 0}}
+set last {}
+
+foreach step $superlu ref $reference change $expected {
+    lassign $step disp stats
+    foreach value $disp exact [lindex $ref 0] {
+        if {abs($value-$exact) > $tol*(1.0+abs($exact))} {
+            set testOK -1
+            puts "failed displacement -> $value != $exact"
+        }
+    }
+    if {![dict exists $stats symbolic] || ![dict exists $stats reused]} {
+        set testOK -1
+        puts "failed systemStats -> no SuperLU statistics"
+        break
+    }
+    set counts [list [dict get $stats symbolic] [dict get $stats reused]]
+    if {$last == {}} {
+        if {[lindex $counts 0] < 1} {
+            set testOK -1
+            puts "failed systemStats -> A was not ordered"
+        }
+    } else {
+        foreach key {symbolic reused} count $counts previous $last increase $change {
+            if {$count - $previous != $increase} {
+                set testOK -1
+                puts "failed systemStats $key -> $previous to $count, expected +$increase"
+            }
+        }
+    }
+    set last $counts
+    puts "    [format %-50s $stats]"
+}
+
+# mixed precision with iterative refinement
+set mixedTol 1.0e-8
+set mixed [runTruss {SuperLU -mixed -refineTol 1.0e-12}]
+foreach step $mixed ref $reference {
+    lassign $step disp stats
+    foreach value $disp exact [lindex $ref 0] {
+        if {abs($value-$exact) > $mixedTol*(1.0+abs($exact))} {
+            set testOK -1
+            puts "failed -mixed displacement -> $value != $exact"
+        }
+    }
+}
+lassign [lindex $mixed end] disp stats
+if {![dict exists $stats single] || [dict get $stats single] < 1 ||
+    [dict get $stats refine] < 1 || [dict get $stats fallback] != 0} {
+    set testOK -1
+    puts "failed -mixed systemStats -> $stats"
+}
+puts "    [format %-50s $stats]"
+
+wipe
+
+set results [open README.md a+]
+if {$testOK == 0} {
+    puts "\nPASSED Verification Test SuperLU.tcl \n\n"
+    puts $results "| PASSED |  SuperLU.tcl"
+} else {
+    puts "\nFAILED Verification Test SuperLU.tcl \n\n"
+    puts $results "FAILED : SuperLU.tcl"
+}
+close $results
@@ -11,6 +11,16 @@ source sdofTransient.tcl
 source SmallEigen.tcl
 source NewmarkIntegrator.tcl
 source mdofModal.tcl
+source KrylovSolvers.tcl
+source MatrixFreeSystem.tcl
+source BulkResponses.tcl
+source EquationNodes.tcl
+source ColumnarRecorder.tcl
+source AsyncRecorder.tcl
+source SuperLU.tcl
+source ProfileThread.tcl
+source EquationOrdering.tcl
+source Profile.tcl
 cd ..
 
 source Truss/PlanarTruss.tcl